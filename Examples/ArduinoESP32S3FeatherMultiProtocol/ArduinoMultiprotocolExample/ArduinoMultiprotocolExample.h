@@ -59,8 +59,9 @@
 // #define TX_PIN 4
 // #define RX_PIN 5
 
-// LoRaWAN port number for sending uplink
-#define LORAWAN_PORT 152
+// LoRaWAN port number for sending uplink, the payload packs several sensor records as described in uplink_agg.h
+// (port 152 carried one raw uplink_data_t per uplink)
+#define LORAWAN_PORT 153
 
 // Interval in seconds for sending sensor data as uplink
 #define UPLINK_INTERVAL_SECONDS 60
@@ -68,6 +69,23 @@
 // Timeout in seconds for no response after last sent uplink
 #define UPLINK_NO_RESPONSE_TIMEOUT_SECONDS 60
 
+// Longest time in seconds a sensor record waits to be packed with the next ones in one uplink.
+// Checked at every reading, so a record is sent at most one UPLINK_INTERVAL_SECONDS later.
+#define UPLINK_AGG_DEADLINE_SECONDS 900
+
+// SPIFFS file keeping the uplinks packed while the device is offline, replayed oldest first once back online.
+// Every journal record is [port][reboot count, 2 bytes][uptime in seconds at pack, 4 bytes][container], big endian.
+#define UPLINK_JOURNAL_FILE "/uplink.jnl"
+#define UPLINK_JOURNAL_MAX_SIZE (64 * 1024)
+#define UPLINK_JOURNAL_RECORD_PREFIX_LEN 7
+
+// MTU used to pack the records while offline and the next uplink MTU is unknown, the smallest LoRaWAN one
+#define UPLINK_JOURNAL_OFFLINE_MTU 51
+
+// Automatic failover between LoRaWAN and the Sidewalk mode of the button on the link quality, off by default.
+// With 1 the sketch may leave the mode selected with the button or the CLI on its own, see set_link_failover()
+#define ENABLE_LINK_FAILOVER 0
+
 // I2C interface configuration
 #define I2C_POWER_PIN 7
 #define I2C_SDA_PIN 3
@@ -131,23 +149,19 @@ typedef struct {
 void switch_protocol_mode(ConnectionMode new_mode);
 
 /**
- * @brief Retrieves the current GPS timestamp in Unix format.
+ * @brief Requests the current GPS timestamp in Unix format.
  *
- * This function attempts to get the current GPS time from the modem.
- * If successful, it returns the timestamp in Unix format (seconds since Jan 1 1970).
- * If unsuccessful, it returns 0 and prints an error message.
+ * The timestamp (seconds since Jan 1 1970) is printed once the modem answers.
  *
- * @param gps_time Pointer to store the retrieved GPS timestamp
- * @return int 0 on success, non-zero on failure
+ * @return int 0 if the request is queued, non-zero on failure
  */
-int get_gps_timestamp(uint32_t *gps_time);
+int request_gps_time(void);
 
 /**
  * @brief Requests time synchronization with the LoRaWAN network
  *
- * This function sends a request to the MCM module to synchronize the device time
- * with the LoRaWAN network. It waits for the response and validates the synchronization
- * process.
+ * This function queues a request to the MCM module to synchronize the device time
+ * with the LoRaWAN network. A refused request is reported once the modem answers.
  *
  * @return int 0 on successful time sync request, non-zero on failure
  */
@@ -155,30 +169,28 @@ int request_lorawan_time_sync(void);
 
 
 /**
- * @brief Retrieves the last downlink statistics from the modem.
+ * @brief Requests the last downlink statistics from the modem.
  *
- * This function fetches the last downlink statistics including protocol type,
- * RSSI, SNR, and timestamp. It prints the statistics to the serial console.
+ * The protocol type, RSSI, SNR and timestamp are printed to the serial console
+ * once the modem answers.
  *
- * @param p_last_dl_stats Pointer to store the last downlink statistics
- * @return int 0 on success, non-zero on failure
+ * @return int 0 if the request is queued, non-zero on failure
  */
-int app_get_dl_stats(get_last_dl_stats_t *p_last_dl_stats);
+int app_request_dl_stats(void);
 
 /**
- * @brief query next uplink mtu from modem via a refresh command
+ * @brief query next uplink mtu from modem via a refresh command, the cached MTU is updated once the modem answers
  * 
- * @param mtu Pointer to store the retrieved MTU size
- * @return int 0 on success, non-zero on failure
+ * @return int 0 if the request is queued or already pending, non-zero on failure
  */
 
-int app_queryNextUplink_mtu(uint16_t *mtu);
+int app_requestNextUplink_mtu(void);
 
 /**
  * @brief Retrieves the cached next uplink MTU size from the modem. Only queries the modem if the cached value is altered.
  *
  * @param[out] mtu Pointer to store the retrieved MTU size
- * @return int 0 on success, non-zero on failure
+ * @return int 0 on success, non-zero while the MTU is not known yet, it is then asked in the background
  */
 int app_getCachedNextUplink_mtu(uint16_t *mtu);
 
@@ -190,4 +202,11 @@ int app_getCachedNextUplink_mtu(uint16_t *mtu);
  */
 int app_SwSetCssPwrProfile(mrover_css_pwr_profile_t profile) ;
 
+/**
+ * @brief Enables or disables the dump of every frame exchanged with the MCM module
+ * 
+ * @param enable true to print the frames, false to stop printing them
+ */
+void app_set_mcm_frame_dump(bool enable);
+
 #endif // LRWAN_SIDEWALK_EX_H
\ No newline at end of file
@@ -48,6 +48,7 @@
  ******************************************************************************/
 #include <Arduino.h>
 #include "mcm_rover.h"
+#include "mcm_rover_blocking.h"
 #include "oxit_cli_app.h"
 #include "oxit_nvs.h"
 #include <Adafruit_NeoPixel.h>
@@ -56,6 +57,8 @@
 #include "SPIFFS.h"
 #include "ArduinoMultiprotocolExample.h"
 #include "led_control.h"
+#include "uplink_agg.h"
+#include "uplink_journal.h"
 
 /******************************************************************************
  * EXTERN VARIABLES
@@ -66,6 +69,8 @@
  ******************************************************************************/
 
 MCM mcm(Serial1, TX_PIN, RX_PIN, RESET_PIN);
+// waits for the commands of setup(), loop() only uses the callbacks of mcm
+MCMBlocking mcm_blocking(mcm);
 
 Adafruit_SHT4x sht4 = Adafruit_SHT4x();
 
@@ -89,6 +94,41 @@ float hum  = 0.0;
 
 uplink_data_t uplink_data;
 
+/**
+ * @brief Sensor records waiting to be packed into the next uplink
+ */
+static uplink_agg_t uplink_aggregator;
+static uint8_t uplink_agg_buffer[LORAWAN_TX_MAX_PAYLOAD_SIZE];
+
+/**
+ * @brief Uplinks packed while offline, kept in SPIFFS across reboots
+ */
+static uplink_journal_t uplink_journal;
+
+/**
+ * @brief Set while a journaled uplink is in the scheduler, committed once its final result is known
+ */
+static bool is_journal_replay_pending = false;
+static uint32_t journal_replay_msg_id = 0;
+
+/**
+ * @brief Final result of the last sensor uplink, given by the mcm after its retries
+ */
+static uint32_t sensor_uplink_msg_id = 0;
+static bool is_sensor_uplink_result_pending = false;
+static MCM_TX_STATUS sensor_uplink_status = MCM_TX_STATUS::MCM_TX_NOT_SEND;
+
+/**
+ * @brief Connection mode asked by the link quality failover, switched to from the idle state
+ */
+static bool is_link_failover_requested = false;
+static ConnectionMode link_failover_mode = ConnectionMode::CONNECTION_MODE_NC;
+
+/**
+ * @brief Set by the cli to send the waiting records with the next reading
+ */
+static bool is_uplink_requested = false;
+
 static bool is_device_joined = false;
 
 /**
@@ -146,6 +186,36 @@ static void read_sensor(float *temperature, float *humidity);
  */
 static bool send_uplink(float temperature, float humidity);
 
+/**
+ * @brief Packs the oldest waiting records into one uplink and sends it.
+ *
+ * @param uplink_mtu The next uplink MTU.
+ *
+ * @return True if an uplink was sent, false otherwise.
+ */
+static bool flush_uplink_records(uint16_t uplink_mtu);
+
+/**
+ * @brief Sends the oldest journaled uplink once online, one at a time and behind the live uplinks.
+ */
+static void replay_uplink_journal();
+
+/**
+ * @brief Called by the mcm with the final result of every uplink of the scheduler.
+ *
+ * @param msg_id Identifier given by queue_uplink().
+ * @param status Tx status of the last attempt.
+ * @param attempts Number of attempts sent.
+ */
+static void on_uplink_result(uint32_t msg_id, MCM_TX_STATUS status, uint8_t attempts);
+
+/**
+ * @brief Called by the mcm when the link quality calls for another connection mode.
+ *
+ * @param mode Connection mode to switch to.
+ */
+static void on_link_failover(ConnectionMode mode);
+
 /**
  * @brief Handles the downlink data.
  */
@@ -252,89 +322,267 @@ static bool send_uplink(float temperature, float humidity)
 
     do
     {
-        if (mcm.is_connected() == false && (device_mode != ConnectionMode::CONNECTION_MODE_SIDEWALK_BLE))
-    {   
-        Serial.println("Device not connected to network.\n");
-            break;
+        // offline, the records are still packed and the uplinks go to the journal
+        bool is_online = mcm.is_connected() || (device_mode == ConnectionMode::CONNECTION_MODE_SIDEWALK_BLE);
+        if (false == is_online)
+        {
+            Serial.println("Device not connected to network, uplinks are journaled.\n");
+        }
+
+        uint16_t uplink_mtu = 0;
+        if (app_getCachedNextUplink_mtu(&uplink_mtu) != 0)
+        {
+            Serial.println("Failed to get uplink mtu");
+            if (is_online)
+            {
+                break;
+            }
+        }
+
+        if (uplink_mtu == 0)
+        {
+            if (is_online)
+            {
+                Serial.println("Invalid next uplink mtu");
+                break;
+            }
+            uplink_mtu = UPLINK_JOURNAL_OFFLINE_MTU;
+        }
+
+        Serial.printf("Sensor record: Temp = %.2f, Humidity = %.2f, Reboot counter = %d\r\n", temperature, humidity, uplink_data.reboot_count);
+
+        uplink_data_t record;
+        record.temp         = (uint16_t)(temperature * 100);
+        record.hum          = (uint16_t)(humidity * 100);
+        record.reboot_count = uplink_data.reboot_count; // assigned on bootup
+
+        // a record which does not fit with the waiting ones goes to the next uplink
+        if (false == uplink_agg_fits(&uplink_aggregator, sizeof(record), uplink_mtu, millis()))
+        {
+            uplink_done = flush_uplink_records(uplink_mtu);
+        }
+        uplink_agg_add(&uplink_aggregator, (uint8_t *)&record, sizeof(record), millis());
+
+        // one uplink at a time, the records are sent once the uplink is full or the oldest one is due
+        if ((false == uplink_done) &&
+            (is_uplink_requested || uplink_agg_is_due(&uplink_aggregator, millis()) ||
+             (false == uplink_agg_fits(&uplink_aggregator, sizeof(record), uplink_mtu, millis()))))
+        {
+            uplink_done = flush_uplink_records(uplink_mtu);
+        }
+        is_uplink_requested = false;
+
+    } while (0); // Loop only once
+
+    // Return true if an uplink was sent
+    return uplink_done;
+}
+
+static bool flush_uplink_records(uint16_t uplink_mtu)
+{
+    // the scheduler takes no more than the command encoder can frame
+    uint8_t payload[UPLINK_SCHED_MAX_PAYLOAD_SIZE];
+    if (uplink_mtu > sizeof(payload))
+    {
+        uplink_mtu = sizeof(payload);
     }
-    
-    uint16_t uplink_mtu = 0;
-    if(app_getCachedNextUplink_mtu(&uplink_mtu) != 0){
-        Serial.println("Failed to get uplink mtu");
-        break;
+    uint16_t len = uplink_agg_pack(&uplink_aggregator, payload, uplink_mtu, millis());
+
+    if (0 == len)
+    {
+        Serial.println("No waiting record fits in the next uplink");
+        return false;
     }
 
-    if (uplink_mtu == 0)
+    if ((false == mcm.is_connected()) && (device_mode != ConnectionMode::CONNECTION_MODE_SIDEWALK_BLE))
     {
-        Serial.println("Invalid next uplink mtu");
-        break;
+        uint8_t record[UPLINK_JOURNAL_RECORD_PREFIX_LEN + LORAWAN_TX_MAX_PAYLOAD_SIZE];
+        uint32_t uptime_s = millis() / 1000;
+
+        record[0] = LORAWAN_PORT;
+        record[1] = (uint8_t)(uplink_data.reboot_count >> 8);
+        record[2] = (uint8_t)uplink_data.reboot_count;
+        record[3] = (uint8_t)(uptime_s >> 24);
+        record[4] = (uint8_t)(uptime_s >> 16);
+        record[5] = (uint8_t)(uptime_s >> 8);
+        record[6] = (uint8_t)uptime_s;
+        memcpy(&record[UPLINK_JOURNAL_RECORD_PREFIX_LEN], payload, len);
+
+        if (false == uplink_journal_append(&uplink_journal, record, UPLINK_JOURNAL_RECORD_PREFIX_LEN + len))
+        {
+            Serial.printf("Journal full, uplink of %d bytes dropped\r\n", len);
+            return false;
+        }
+        Serial.printf("Offline, uplink of %d bytes journaled, %lu waiting\r\n", len,
+                      (unsigned long)uplink_journal_get_pending_count(&uplink_journal));
+        return false;
     }
 
     set_led_state(LED_SENDING_UPLINK);
-    // Code to send uplink with temperature and humidity data
-    Serial.printf("Sending uplink: Temp = %.2f, Humidity = %.2f, Reboot counter = %d\r\n", temperature, humidity, uplink_data.reboot_count);
-
-    uplink_data_t uplink_data;
-    uplink_data.temp = (uint16_t)(temperature * 100);
-        uplink_data.hum  = (uint16_t)(humidity * 100);
-    // reboot counter is already assigned on bootup
+    Serial.printf("Sending uplink: %d bytes, %d records still waiting, %lu dropped\r\n", len,
+                  uplink_agg_get_count(&uplink_aggregator), (unsigned long)uplink_agg_get_dropped_count(&uplink_aggregator));
     Serial.print("Uplink in hex: ");
-        helper_print_hex_array((uint8_t *)&uplink_data, sizeof(uplink_data));
-   
+    helper_print_hex_array(payload, len);
+
+    MCM_UPLINK_TYPE uplink_type = MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF;
+    if (device_mode == ConnectionMode::CONNECTION_MODE_LORAWAN)
+    {
+        uplink_type = MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_CONF;
+    }
+
+    // the scheduler sends it now when the link is idle and within its duty cycle, later otherwise
+    if (MCM_STATUS::MCM_OK != mcm.queue_uplink(payload, len, LORAWAN_PORT, uplink_type, UPLINK_SCHED_TELEMETRY, &sensor_uplink_msg_id))
+    {
+        return false;
+    }
+    is_sensor_uplink_result_pending = true;
+    return mcm.is_last_uplink_pending();
+}
+
+static void replay_uplink_journal()
+{
+    static uint8_t record[UPLINK_JOURNAL_RECORD_PREFIX_LEN + LORAWAN_TX_MAX_PAYLOAD_SIZE];
+    uint8_t payload[LORAWAN_TX_MAX_PAYLOAD_SIZE];
+    uint16_t record_len = 0;
+    uint16_t payload_len = 0;
+    uint16_t uplink_mtu = 0;
+
+    do
+    {
+        if ((false == mcm.is_connected()) && (device_mode != ConnectionMode::CONNECTION_MODE_SIDEWALK_BLE))
+        {
+            break;
+        }
+
+        // the live uplinks go first, the journal is replayed on an idle link
+        if ((0 != mcm.get_queued_uplink_count()) || mcm.is_last_uplink_pending())
+        {
+            break;
+        }
+
+        // idle without a result, the uplink was evicted from the queue, it is replayed again
+        is_journal_replay_pending = false;
+
+        if (false == uplink_journal_peek(&uplink_journal, record, sizeof(record), &record_len))
+        {
+            break;
+        }
+
+        if ((app_getCachedNextUplink_mtu(&uplink_mtu) != 0) || (0 == uplink_mtu))
+        {
+            break;
+        }
+
+        uint16_t reboot_count = ((uint16_t)record[1] << 8) | record[2];
+        uint32_t uptime_s = ((uint32_t)record[3] << 24) | ((uint32_t)record[4] << 16) | ((uint32_t)record[5] << 8) | record[6];
+        uint32_t offline_s = 0;
+
+        // the uptime is only comparable within the same boot, the ages of an older boot are left as packed
+        if ((reboot_count == uplink_data.reboot_count) && ((millis() / 1000) > uptime_s))
+        {
+            offline_s = (millis() / 1000) - uptime_s;
+        }
+
+        if (record_len > UPLINK_JOURNAL_RECORD_PREFIX_LEN)
+        {
+            payload_len = uplink_agg_add_age(&record[UPLINK_JOURNAL_RECORD_PREFIX_LEN], record_len - UPLINK_JOURNAL_RECORD_PREFIX_LEN, offline_s,
+                                             payload, sizeof(payload));
+        }
+        if (0 == payload_len)
+        {
+            Serial.println("Malformed journaled uplink dropped");
+            uplink_journal_commit(&uplink_journal);
+            break;
+        }
+
+        if (payload_len > uplink_mtu)
+        {
+            Serial.printf("Journaled uplink of %d bytes waits for a larger MTU than %d\r\n", payload_len, uplink_mtu);
+            break;
+        }
+
+        MCM_UPLINK_TYPE uplink_type = MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF;
         if (device_mode == ConnectionMode::CONNECTION_MODE_LORAWAN)
         {
-    mcm.send_uplink((uint8_t *)&uplink_data, sizeof(uplink_data), LORAWAN_PORT, MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_CONF);
+            uplink_type = MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_CONF;
         }
-        else
+
+        Serial.printf("Replaying journaled uplink: %d bytes, %lu s offline\r\n", payload_len, (unsigned long)offline_s);
+        if (MCM_STATUS::MCM_OK == mcm.queue_uplink(payload, payload_len, record[0], uplink_type, UPLINK_SCHED_BULK, &journal_replay_msg_id))
         {
-            mcm.send_uplink((uint8_t *)&uplink_data, sizeof(uplink_data), LORAWAN_PORT, MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF);
+            is_journal_replay_pending = true;
         }
+    } while (0);
+}
 
-        uplink_done = true; // Assume success if we reach this point
+static void on_uplink_result(uint32_t msg_id, MCM_TX_STATUS status, uint8_t attempts)
+{
+    if (is_journal_replay_pending && (msg_id == journal_replay_msg_id))
+    {
+        is_journal_replay_pending = false;
+        // not sent, the same uplink is replayed again
+        if (MCM_TX_STATUS::MCM_TX_NOT_SEND != status)
+        {
+            uplink_journal_commit(&uplink_journal);
+            Serial.printf("Journaled uplink forwarded, %lu waiting\r\n", (unsigned long)uplink_journal_get_pending_count(&uplink_journal));
+        }
+    }
 
-    } while (0); // Loop only once
+    if (msg_id == sensor_uplink_msg_id)
+    {
+        sensor_uplink_status = status;
+        is_sensor_uplink_result_pending = false;
+        Serial.printf("Uplink result after %d attempts\r\n", attempts);
+    }
+}
 
-    // Return true if uplink is successful
-    return uplink_done;
+static void on_link_failover(ConnectionMode mode)
+{
+    // switched from the state machine, not from the mcm event handling
+    link_failover_mode = mode;
+    is_link_failover_requested = true;
 }
 
 static void handle_downlink()
 {
-    // lets check if any download is available
-    if (mcm.is_downlink_available())
+    // drain every queued downlink, oldest first
+    const mcm_downlink_t *downlink;
+    while (NULL != (downlink = mcm.acquire_downlink()))
     {   
         set_led_state(LED_RECEIVED_DOWNLINK);
 
         Serial.println("--------------------Downlink available--------------------");
-        // retrieve the downlink and meta data
-        uint8_t received_data[BUFFER_SIZE];
-        uint16_t received_len;
-        int8_t rssi;
-        int8_t snr;
-        uint16_t seq_port;
-
-        mcm.get_downlink_data(received_data, &received_len, &rssi, &snr, &seq_port);
-
-        Serial.printf("Rssi: %d\r\n", rssi);
-        Serial.printf("Snr: %d\r\n", snr);
-        if (ConnectionMode::CONNECTION_MODE_LORAWAN == mcm.get_connect_mode())
+        Serial.printf("Received at: %lu ms\r\n", (unsigned long)downlink->timestamp);
+        Serial.printf("Rssi: %d\r\n", downlink->rssi);
+        Serial.printf("Snr: %d\r\n", downlink->snr);
+        if (COMMAND_TYPE_LORAWAN == downlink->protocol)
         {
             // if mode is lorawan then its port
-            Serial.printf("Lorawan port: %d\n", seq_port);
+            Serial.printf("Lorawan port: %d\n", downlink->seq_port);
         }
         else
         {
             // if mode is sidewalk then its sidewalk sequence
-            Serial.printf("Sidewalk sequence: %d\n", seq_port);
+            Serial.printf("Sidewalk sequence: %d\n", downlink->seq_port);
         }
 
-        Serial.printf("Receivced payload Size: %d\n", received_len);
+        Serial.printf("Receivced payload Size: %d\n", downlink->len);
         Serial.println("Received Downlink data: ");
-        helper_print_hex_array(received_data, received_len);
+        helper_print_hex_array(downlink->data, downlink->len);
         Serial.printf("\n");
 
+        // give the buffer back to the pool
+        mcm.release_downlink(downlink);
         Serial.println("----------------------------------------------------");
     }
+
+    // report new drops once
+    static uint32_t reported_overflow_count = 0;
+    if (mcm.get_downlink_overflow_count() != reported_overflow_count)
+    {
+        reported_overflow_count = mcm.get_downlink_overflow_count();
+        Serial.printf("Dropped downlinks: %lu\n", (unsigned long)reported_overflow_count);
+    }
 }
 
 bool is_all_ff(uint8_t *arr, uint8_t len)
@@ -462,6 +710,75 @@ void helper_print_hex_array(const uint8_t *arr, size_t len)
     Serial.println();
 }
 
+// kept open between the reads of a scan or a replay, closed before the file is changed
+static File journal_read_file;
+
+static uint16_t journal_file_read(void *p_context, uint32_t offset, uint8_t *buf, uint16_t len)
+{
+    uint16_t read_len = 0;
+    if (!journal_read_file)
+    {
+        journal_read_file = SPIFFS.open(UPLINK_JOURNAL_FILE, FILE_READ);
+    }
+    if (journal_read_file)
+    {
+        if (journal_read_file.seek(offset))
+        {
+            read_len = journal_read_file.read(buf, len);
+        }
+    }
+    return read_len;
+}
+
+static bool journal_file_append(void *p_context, const uint8_t *buf, uint16_t len)
+{
+    if (journal_read_file)
+    {
+        journal_read_file.close();
+    }
+    File file = SPIFFS.open(UPLINK_JOURNAL_FILE, FILE_APPEND);
+    if (!file)
+    {
+        return false;
+    }
+    size_t written = file.write(buf, len);
+    file.flush();
+    file.close();
+    return written == len;
+}
+
+static bool journal_file_erase(void *p_context)
+{
+    if (journal_read_file)
+    {
+        journal_read_file.close();
+    }
+    return (false == SPIFFS.exists(UPLINK_JOURNAL_FILE)) || SPIFFS.remove(UPLINK_JOURNAL_FILE);
+}
+
+static uint32_t journal_file_size(void *p_context)
+{
+    uint32_t size = 0;
+    if (SPIFFS.exists(UPLINK_JOURNAL_FILE))
+    {
+        File file = SPIFFS.open(UPLINK_JOURNAL_FILE, FILE_READ);
+        if (file)
+        {
+            size = file.size();
+            file.close();
+        }
+    }
+    return size;
+}
+
+static const uplink_journal_storage_t uplink_journal_storage = {
+    journal_file_read,
+    journal_file_append,
+    journal_file_erase,
+    journal_file_size,
+    NULL,
+};
+
 static void initSPIFFS() 
 {
     if (!SPIFFS.begin(true))
@@ -558,12 +875,17 @@ void setup()
     {
         Serial.println("mcm begin failed");
     }
+    // one final result per uplink, after the retries of its policy
+    mcm.set_on_uplink_result_callback(on_uplink_result);
+    mcm.set_on_link_failover_callback(on_link_failover);
     // Enable/disable debug serial logs (logs will be available on the default serial port of the Arduino board being used)
     // Caution: Turning debug logs on can flood the serial logs
     mcm.set_debug_enabled(false);
 
     // reboot the module
-    mcm.hw_reset();
+    mcm_blocking.hw_reset();
+
+    Serial.println("MCM link: " + String(mcm.get_baud_rate()) + " baud, " + String(mcm.get_link_throughput()) + " bytes/s");
 
     ver_type_1_t mcm_rover_lib_ver, c_lib_ver;
     mcm.retrieveLibraryVersions(&mcm_rover_lib_ver, &c_lib_ver);
@@ -582,6 +904,13 @@ void setup()
     uplink_data.reboot_count = nvs_storage_get_reboot_count();
     Serial.println("Reboot count: " + String(uplink_data.reboot_count));
 
+    // sensor records are packed together up to the next uplink MTU
+    uplink_agg_init(&uplink_aggregator, uplink_agg_buffer, sizeof(uplink_agg_buffer), UPLINK_AGG_DEADLINE_SECONDS * 1000UL);
+
+    // uplinks packed while offline before the reboot are replayed once online
+    uplink_journal_open(&uplink_journal, &uplink_journal_storage, UPLINK_JOURNAL_MAX_SIZE);
+    Serial.println("Journaled uplinks: " + String(uplink_journal_get_pending_count(&uplink_journal)));
+
     // Start in sidewalk BLE mode regardless of the validity of LoRaWAN credentials
     currentState                             = STATE_SET_CONNECT_MODE;                       // Set to sidewalk mode
     is_device_have_valid_lorawan_credentials = 0;                                            // No valid credentials initially
@@ -607,10 +936,18 @@ void setup()
     {   
         Serial.println("No valid credentials available, Please enter credentials manually for lorawan");
     }
+
+    // fail over between lorawan and the sidewalk link of the button when the link quality drops
+#ifdef EVK_TYPE_G2R1
+    ConnectionMode failover_modes[] = {ConnectionMode::CONNECTION_MODE_SIDEWALK_CSS, ConnectionMode::CONNECTION_MODE_LORAWAN};
+#else
+    ConnectionMode failover_modes[] = {ConnectionMode::CONNECTION_MODE_SIDEWALK_FSK, ConnectionMode::CONNECTION_MODE_LORAWAN};
+#endif
+    // lorawan is only a candidate with credentials, see switch_protocol_mode()
+    mcm.set_link_failover(ENABLE_LINK_FAILOVER, failover_modes, is_device_have_valid_lorawan_credentials ? 2 : 1);
     
-     get_seg_file_status_t file_status;
     // send get segment command
-    mcm.get_segmented_file_download_status(&file_status);
+    mcm.req_segmented_file_download_status();
   
 #endif
 }
@@ -738,7 +1075,7 @@ void run_state_machine()
         case STATE_UPLINK_STATUS: {
                 // check for the uplink status
                 // Check if the uplink is pending or transmitted
-            if (mcm.is_last_uplink_pending() && millis() - last_uplink_time < UPLINK_NO_RESPONSE_TIMEOUT_SECONDS * 1000)
+            if (is_sensor_uplink_result_pending && millis() - last_uplink_time < UPLINK_NO_RESPONSE_TIMEOUT_SECONDS * 1000)
                 {
                 if (currentState != STATE_UPLINK_STATUS)
                     {
@@ -748,7 +1085,7 @@ void run_state_machine()
                 }
                 else
                 {
-                    switch (mcm.get_last_tx_status())
+                    switch (sensor_uplink_status)
                     {
                         case MCM_TX_STATUS::MCM_TX_NOT_SEND:
                             
@@ -789,12 +1126,22 @@ void run_state_machine()
                 // Handle downlink if any
                 handle_downlink();
 
+                // Forward the uplinks journaled while offline
+                replay_uplink_journal();
+
+                // Move to the connection mode asked by the link quality failover
+                if (is_link_failover_requested)
+                {
+                    is_link_failover_requested = false;
+                    switch_protocol_mode(link_failover_mode);
+                    break;
+                }
+
                 // If MCM has been rebooted, set the connection mode again
                 if (mcm.get_context_mgr_is_mcm_reset()) 
                 {
-                    get_seg_file_status_t file_status;
                 // send get segment command
-                    mcm.get_segmented_file_download_status(&file_status);
+                    mcm.req_segmented_file_download_status();
                     // Serial.println("MCM reset detected, connecting again");
                     is_device_joined = false;
                 set_led_state(LED_DEVICE_NOT_CONNECTED); // Set LED state for not connected
@@ -853,14 +1200,14 @@ void run_state_machine()
 
 void send_uplink_now()
 {
+    is_uplink_requested = true;
     currentState = STATE_READ_SENSOR;
 }
 
 void send_fw_update_request()
 {
-    get_seg_file_status_t file_status;
     // send get segment command
-    mcm.get_segmented_file_download_status(&file_status);
+    mcm.req_segmented_file_download_status();
 }
 
 static void handleButtonPress()
@@ -880,7 +1227,8 @@ static void handleButtonPress()
         if (reading == LOW)
         {
             Serial.println("Switching Network");
-            // Toggle between LoRaWAN and Sidewalk CSS modes
+            // Toggle between LoRaWAN and Sidewalk CSS modes, from the mode in use as the link failover may have changed it
+            currentMode = device_mode;
             if (currentMode == ConnectionMode::CONNECTION_MODE_LORAWAN)
             {
                 currentMode = ConnectionMode::CONNECTION_MODE_SIDEWALK_CSS;
@@ -943,6 +1291,8 @@ static void check_device_connection()
     {   
             is_device_joined = true;
             Serial.println("Device joined successfully");
+            // the uplink MTU of the new link is known before the first uplink
+            app_requestNextUplink_mtu();
 
             switch (device_mode)
             {
@@ -981,12 +1331,19 @@ static void check_device_connection()
     }
 }
 
+static void on_lorawan_time_sync_complete(MCM_STATUS status, const api_processor_response_t *response, void *user_context)
+{
+    if (status != MCM_STATUS::MCM_OK)
+    {
+        Serial.println("Error: LoRaWAN time sync request not accepted by the modem");
+    }
+}
+
 /**
  * @brief Requests time synchronization with the LoRaWAN network
  *
- * This function sends a request to the MCM module to synchronize the device time
- * with the LoRaWAN network. It waits for the response and validates the synchronization
- * process.
+ * This function queues a request to the MCM module to synchronize the device time
+ * with the LoRaWAN network. A refused request is reported once the modem answers.
  *
  * @return int 0 on successful time sync request, non-zero on failure
  */
@@ -997,7 +1354,7 @@ int request_lorawan_time_sync()
     do
     {
         // Request LoRaWAN time synchronization
-        MCM_STATUS status = mcm.req_lorawan_dev_time();
+        MCM_STATUS status = mcm.req_lorawan_dev_time(on_lorawan_time_sync_complete);
 
         if (status != MCM_STATUS::MCM_OK)
         {
@@ -1011,100 +1368,98 @@ int request_lorawan_time_sync()
     return ret;
 }
 
-/**
- * @brief Retrieves the current GPS timestamp in Unix format.
- *
- * This function attempts to get the current GPS time from the modem.
- * If successful, it returns the timestamp in Unix format (seconds since Jan 1 1970).
- * If unsuccessful, it returns 0 and prints an error message.
- *
- * @param gps_time Pointer to store the retrieved GPS timestamp
- * @return int 0 on success, non-zero on failure
- */
-int get_gps_timestamp(uint32_t *gps_time)
+static void on_gps_time_received(MCM_STATUS status, const api_processor_response_t *response, void *user_context)
 {
-    int ret = 0;
-
-    do
+    if (status != MCM_STATUS::MCM_OK)
     {
-        if (gps_time == NULL)
-{ 
-            Serial.println("Error: Null pointer passed to get_gps_timestamp");
-            ret = -1;
-            break;
-        }
-
-        // Initialize the GPS time to 0
-        *gps_time = 0;
-
-        // Try to get GPS time from modem
-        mcm.get_gps_time(gps_time);
-
-        // Check if we got a valid timestamp
-        if (*gps_time == 0)
-        {
-            Serial.println("Warning: Received zero GPS timestamp");
-            ret = -1;
-            break;
-        }
+        Serial.println("Error: Failed to get GPS time");
+        return;
+    }
 
-    } while (0);
+    // Check if we got a valid timestamp
+    if (mcm.gps_timestamp == 0)
+    {
+        Serial.println("Warning: Received zero GPS timestamp");
+        return;
+    }
 
-    return ret;
+    // Print the GPS time in Unix timestamp format
+    Serial.print("Current GPS time: ");
+    Serial.println(mcm.gps_timestamp);
 }
 
-
 /**
- * @brief Retrieves the last downlink statistics from the modem.
+ * @brief Requests the current GPS timestamp in Unix format.
  *
- * This function fetches the last downlink statistics including protocol type,
- * RSSI, SNR, and timestamp. It prints the statistics to the serial console.
+ * The timestamp (seconds since Jan 1 1970) is printed once the modem answers.
  *
- * @param p_last_dl_stats Pointer to store the last downlink statistics
- * @return int 0 on success, non-zero on failure
+ * @return int 0 if the request is queued, non-zero on failure
  */
-int app_get_dl_stats(get_last_dl_stats_t *p_last_dl_stats)
+int request_gps_time(void)
 {
-    int ret = 0;
+    return (mcm.req_gps_time(on_gps_time_received) == MCM_STATUS::MCM_OK) ? 0 : -1;
+}
 
-    do
-    {
-        if (p_last_dl_stats == NULL)
+static void on_dl_stats_received(MCM_STATUS status, const api_processor_response_t *response, void *user_context)
 {
-            Serial.println("Error: Null pointer passed to get_dl_stats");
-            ret = -1;
-            break;
-        }
-
-        // Initialize the statistics structure
-        memset(p_last_dl_stats, 0, sizeof(get_last_dl_stats_t));
+    if (status != MCM_STATUS::MCM_OK)
+    {
+        Serial.println("Error: Failed to get last downlink statistics");
+        return;
+    }
 
-        // Get the last downlink statistics from modem
-        MCM_STATUS status = mcm.get_last_dl_stats(p_last_dl_stats);
-        if (status != MCM_STATUS::MCM_OK)
-        {
-            Serial.println("Error: Failed to get last downlink statistics");
-            ret = -1;
-            break;
-        }
+    // Print the statistics using printf with tabs
+    Serial.printf("Last Downlink Statistics:\n"
+                  "\tProtocol Type: %d\n"
+                  "\tRSSI: %d\n"
+                  "\tSNR: %d\n"
+                  "\tTimestamp: %lu\n",
+                  mcm.last_downlink_stats.protocol_type, mcm.last_downlink_stats.rssi, mcm.last_downlink_stats.snr,
+                  mcm.last_downlink_stats.timestamp);
+}
 
-        // Print the statistics using printf with tabs
-        Serial.printf("Last Downlink Statistics:\n"
-                      "\tProtocol Type: %d\n"
-                      "\tRSSI: %d\n"
-                      "\tSNR: %d\n"
-                      "\tTimestamp: %lu\n",
-                      p_last_dl_stats->protocol_type, p_last_dl_stats->rssi, p_last_dl_stats->snr, p_last_dl_stats->timestamp);
+/**
+ * @brief Requests the last downlink statistics from the modem.
+ *
+ * The protocol type, RSSI, SNR and timestamp are printed once the modem answers.
+ *
+ * @return int 0 if the request is queued, non-zero on failure
+ */
+int app_request_dl_stats(void)
+{
+    return (mcm.req_last_dl_stats(on_dl_stats_received) == MCM_STATUS::MCM_OK) ? 0 : -1;
+}
 
-    } while (0);
+static uint16_t next_uplink_mtu = 0;
+static ConnectionMode next_uplink_mtu_protocol = ConnectionMode::CONNECTION_MODE_NC;
+static bool is_next_uplink_mtu_requested = false;
 
-    return ret;
+static void on_next_uplink_mtu_received(MCM_STATUS status, const api_processor_response_t *response, void *user_context)
+{
+    is_next_uplink_mtu_requested = false;
+    if (status != MCM_STATUS::MCM_OK)
+    {
+        Serial.println("Error: Failed to get next uplink MTU");
+        return;
+    }
+    next_uplink_mtu = mcm.nextUplink_mtu;
+    next_uplink_mtu_protocol = device_mode;
+    Serial.print("Next Uplink MTU: ");
+    Serial.println(next_uplink_mtu);
 }
 
-int app_queryNextUplink_mtu(uint16_t *mtu)
+int app_requestNextUplink_mtu(void)
 {
-    MCM_STATUS status = mcm.get_next_uplink_mtu(mtu);
-    return status != MCM_STATUS::MCM_OK ? -1 : 0;
+    if (is_next_uplink_mtu_requested)
+    {
+        return 0;
+    }
+    if (mcm.req_next_uplink_mtu(on_next_uplink_mtu_received) != MCM_STATUS::MCM_OK)
+    {
+        return -1;
+    }
+    is_next_uplink_mtu_requested = true;
+    return 0;
 }
 
 int app_getCachedNextUplink_mtu(uint16_t *mtu) {
@@ -1113,34 +1468,35 @@ int app_getCachedNextUplink_mtu(uint16_t *mtu) {
         return -1; //early return
     }
 
-    int ret = 0;
-    
-    static uint16_t preNextUplink_mtu = 0;
-    static ConnectionMode preActiveProtocol = ConnectionMode::CONNECTION_MODE_NC;
-    if(preActiveProtocol != device_mode || preNextUplink_mtu == 0){
-        preActiveProtocol = device_mode;
-        do{
-            if(mtu == NULL) {
-                Serial.println("Error: Null pointer passed to get_next_uplink_mtu");
-                ret = -1;
-                break;
-            }
-            memset(mtu, 0, sizeof(uint16_t));
+    if(mtu == NULL) {
+        Serial.println("Error: Null pointer passed to get_next_uplink_mtu");
+        return -1;
+    }
 
-            int status = app_queryNextUplink_mtu(mtu);
-            if (status != 0) {
-                Serial.println("Error: Failed to get next uplink MTU");
-                ret = -1;
-                break;
-            }
+    *mtu = 0;
+    if(next_uplink_mtu_protocol != device_mode || next_uplink_mtu == 0){
+        // refreshed in the background, the cached value is used from the next call on
+        app_requestNextUplink_mtu();
+        return -1;
+    }
+    *mtu = next_uplink_mtu;
+    return 0;
+}
 
-        }while (0);
-        preNextUplink_mtu = *mtu;
+static mrover_css_pwr_profile_t SW_currentPwrProfile = (mrover_css_pwr_profile_t)0xFF;
 
-    }else{
-        *mtu = preNextUplink_mtu;
-    }
-    return ret; // or error code
+static void on_css_pwr_profile_complete(MCM_STATUS status, const api_processor_response_t *response, void *user_context)
+{
+  mrover_css_pwr_profile_t profile = (mrover_css_pwr_profile_t)(uintptr_t)user_context;
+
+  if (status != MCM_STATUS::MCM_OK) {
+    Serial.println("Error: Sidewalk CSS Power Profile not accepted by the modem");
+    return;
+  }
+  SW_currentPwrProfile = profile;
+  // Print the selected power profile
+  char prof_ch[MROVER_CSS_PWR_PROFILE_B + 1] = {'A', 'B'};
+  Serial.printf("Sidewalk CSS Power Profile set to: %c\n", prof_ch[profile]);
 }
 
 int app_SwSetCssPwrProfile(mrover_css_pwr_profile_t profile) {
@@ -1154,19 +1510,20 @@ int app_SwSetCssPwrProfile(mrover_css_pwr_profile_t profile) {
     return -1; // early return
   }
 
-  static mrover_css_pwr_profile_t SW_currentPwrProfile =
-      (mrover_css_pwr_profile_t)0xFF;
   if (SW_currentPwrProfile == profile) {
     Serial.printf("Sidewalk CSS Power Profile already set to: %d\n", profile);
     return 0; // No change needed
   }
 
-  // Set the power profile for the Sidewalk CSS connection
-  mcm.app_SWSetCSSPwrProfile(profile);
-  SW_currentPwrProfile = profile;
-  // Print the selected power profile
-  char prof_ch[MROVER_CSS_PWR_PROFILE_B + 1] = {'A', 'B'};
-  Serial.printf("Sidewalk CSS Power Profile set to: %c\n", prof_ch[profile]);
-
+  // Set the power profile for the Sidewalk CSS connection, recorded once the modem accepts it
+  if (mcm.app_SWSetCSSPwrProfile(profile, on_css_pwr_profile_complete, (void *)(uintptr_t)profile) != MCM_STATUS::MCM_OK) {
+    return -1;
+  }
   return 0;
 }
+
+void app_set_mcm_frame_dump(bool enable)
+{
+  mcm.set_debug_enabled(enable);
+  Serial.printf("MCM frame dump %s\n", enable ? "enabled" : "disabled");
+}
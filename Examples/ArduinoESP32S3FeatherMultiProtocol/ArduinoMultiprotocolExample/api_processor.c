@@ -58,7 +58,7 @@
 #define _ASSERT_PRINT(cond, msg)                                                                          \
     if (!(cond))                                                                                          \
     {                                                                                                      \
-        TRACE_INFO("[Function: %s, Line: %d]\tASSERT: %s\n", __func__, __LINE__, msg);         \
+        TRACE_ERROR("[Function: %s, Line: %d]\tASSERT: %s\n", __func__, __LINE__, msg);         \
         break;                                                                                           \
     }
 
@@ -66,20 +66,133 @@
 #define _ERROR_BREAK(err, msg)                                                                           \
     if (err != 0)                                                                                         \
     {                                                                                                      \
-        TRACE_INFO("[Function: %s, Line: %d]\tERROR: %d - %s\n", __func__, __LINE__, err, msg);  \
+        TRACE_ERROR("[Function: %s, Line: %d]\tERROR: %d - %s\n", __func__, __LINE__, err, msg);  \
         break;                                                                                           \
     }
+
+/**< Command type, command code and payload length bytes in front of the command payload */
+#define COMMAND_HEADER_LEN              5
+
+/**< Largest command payload that fits in the send buffer together with the header and the CRC */
+#define COMMAND_MAX_PAYLOAD_LEN         (MAX_SERIAL_SEND_PAYLOAD_SIZE - MIN_TX_PAYLOAD_LEN)
 /******************************************************************************
  * PRIVATE TYPEDEFS
  ******************************************************************************/
+/**
+ * @brief Index of every command in the command descriptor table.
+ */
+typedef enum
+{
+    API_CMD_NONE = 0,           // unknown command code
+    API_CMD_GET_EVENT,
+    API_CMD_GET_VERSION,
+    API_CMD_RESET,
+    API_CMD_FACTORY_RESET,
+    API_CMD_SWITCH_NETWORK,
+    API_CMD_GET_FILE_STATUS,
+    API_CMD_START_FILE_TRANSFER,
+    API_CMD_TRIGGER_FW_UPDATE,
+    API_CMD_GET_GPS_TIME,
+    API_CMD_GET_LAST_DL_STATS,
+    API_CMD_GET_NEXT_UPLINK_MTU,
+    API_CMD_SET_UART_BAUD,
+    API_CMD_INIT_LORAWAN,
+    API_CMD_SET_JOIN_EUI,
+    API_CMD_SET_DEV_EUI,
+    API_CMD_SET_NWK_KEY,
+    API_CMD_GET_DEV_EUI,
+    API_CMD_GET_JOIN_EUI,
+    API_CMD_JOIN_LORAWAN,
+    API_CMD_LORAWAN_REQUEST_UPLINK,
+    API_CMD_LEAVE_LORAWAN_NETWORK,
+    API_CMD_STOP_LORAWAN_NETWORK,
+    API_CMD_SET_LORAWAN_CLASS,
+    API_CMD_GET_LORAWAN_CLASS,
+    API_CMD_LORAWAN_TIME_REQUEST,
+    API_CMD_SID_BLE_LINK_REQUEST,
+    API_CMD_SID_BLE_CONN_REQUEST,
+    API_CMD_SID_FSK_LINK_REQUEST,
+    API_CMD_SID_CSS_LINK_REQUEST,
+    API_CMD_SID_SET_CSS_PROFILE,
+    API_CMD_SID_REQUEST_UPLINK,
+    API_CMD_SID_SET_DOWNLINK_FILTER,
+    API_CMD_SID_STOP,
+    API_CMD_MAX
+} api_processor_cmd_id_t;
 
-/******************************************************************************
- * STATIC VARIABLES
- ******************************************************************************/
+/**
+ * @brief Index of every event in the event descriptor table.
+ */
+typedef enum
+{
+    API_EVT_NONE = 0,           // unknown event code
+    API_EVT_RESET,
+    API_EVT_ALARM,
+    API_EVT_JOINED,
+    API_EVT_TXDONE,
+    API_EVT_DOWNDATA,
+    API_EVT_UPLOADDONE,
+    API_EVT_SETCONF,
+    API_EVT_MUTE,
+    API_EVT_STREAMDONE,
+    API_EVT_JOINFAIL,
+    API_EVT_TIME,
+    API_EVT_TIMEOUT_ADR_CHANGED,
+    API_EVT_NEW_LINK_ADR,
+    API_EVT_LINK_CHECK,
+    API_EVT_ALMANAC_UPDATE,
+    API_EVT_USER_RADIO_ACCESS,
+    API_EVT_CLASS_B_PING_SLOT_INFO,
+    API_EVT_CLASS_B_STATUS,
+    API_EVT_LORAWAN_MAC_TIME,
+    API_EVT_SEGMENTED_FILE_DOWNLOAD,
+    API_EVT_CLASS_SWITCHED,
+    API_EVT_NO_EVENT,
+    API_EVT_MAX
+} api_processor_evt_id_t;
 
-/******************************************************************************
- * GLOBAL VARIABLES
- ******************************************************************************/
+/**
+ * @brief Parses the payload of a response or of an event.
+ *
+ * @param[in] mcm_module Pointer to the MCM module structure.
+ * @param[in] data Pointer to the payload.
+ * @param[in] len Length of the payload.
+ * @param[out] p_response Pointer to the response to fill up.
+ *
+ * @return API_PROCESSOR_SUCCESS if the payload is parsed successfully, otherwise appropriate error code.
+ */
+typedef api_processor_status_t (*api_processor_parser_t)(mcm_module_hdl_t *mcm_module, uint8_t *data, uint16_t len, api_processor_response_t *p_response);
+
+/**
+ * @brief Describes how a response or an event payload is parsed.
+ */
+typedef struct
+{
+    api_processor_parser_t parse;   // payload parser, NULL if the payload is not used
+    const char *name;               // name used in the traces
+} api_processor_parser_desc_t;
+
+/**
+ * @brief Checks the content of an assembled command payload.
+ *
+ * @param[in] p_payload Pointer to the payload, right after the command header. Its first
+ *  u16_min_len bytes of the command descriptor are present, the length is checked before.
+ *
+ * @return true if the payload can be sent, false otherwise
+ */
+typedef bool (*api_processor_cmd_validator_t)(const uint8_t *p_payload);
+
+/**
+ * @brief Describes how a command frame is built.
+ */
+typedef struct
+{
+    uint8_t u8_cmd_type;                        // COMMAND_TYPE_GENERAL, COMMAND_TYPE_LORAWAN or COMMAND_TYPE_SIDEWALK
+    uint16_t u16_cmd_code;                      // MROVER_CC_* command code
+    uint16_t u16_min_len;                       // minimum payload length
+    uint16_t u16_max_len;                       // maximum payload length
+    api_processor_cmd_validator_t validator;    // payload content check, NULL if the length check is enough
+} api_processor_cmd_desc_t;
 
 /******************************************************************************
  * STATIC FUNCTION PROTOTYPES
@@ -92,9 +205,9 @@ static api_processor_status_t api_processor_get_event_down_data(mcm_module_hdl_t
 static api_processor_status_t api_processor_parse_lorawan_down_data(mcm_module_hdl_t *mcm_module, uint8_t *data, uint16_t len, api_processor_response_t *p_response);
 static api_processor_status_t api_processor_parse_sid_down_data(mcm_module_hdl_t *mcm_module, uint8_t *data, uint16_t len, api_processor_response_t *p_response);
 static api_processor_status_t api_processor_parse_get_version(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len, api_processor_response_t *p_response);
-static api_processor_status_t api_processor_parse_cmd_with_len_zero(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len, api_processor_response_t *p_response,const char* module);
-static api_processor_status_t api_processor_parse_eui_cmd(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len, api_processor_response_t *p_response,const char* eui_type);
-static api_processor_status_t api_processor_parse_get_class_cmd(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len, api_processor_response_t *p_response,const char* eui_type);
+static api_processor_status_t api_processor_parse_cmd_with_len_zero(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len, api_processor_response_t *p_response);
+static api_processor_status_t api_processor_parse_eui_cmd(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len, api_processor_response_t *p_response);
+static api_processor_status_t api_processor_parse_get_class_cmd(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len, api_processor_response_t *p_response);
 static api_processor_status_t api_procesor_parse_lorawan_class_switch(mcm_module_hdl_t *mcm_module, uint8_t *data, uint16_t len, api_processor_response_t *p_response);
 static api_processor_status_t api_processor_parse_get_event_seg(mcm_module_hdl_t *mcm_module, uint8_t *data, uint16_t len, api_processor_response_t *p_response);
 static api_processor_status_t api_processor_parse_get_file_status(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len, api_processor_response_t *p_response);
@@ -104,6 +217,204 @@ static api_processor_status_t api_procesor_parse_lorawan_mac_time(mcm_module_hdl
 static api_processor_status_t api_processor_parse_last_dl_stats(mcm_module_hdl_t *mcm_module, uint8_t *data, uint16_t len, api_processor_response_t *p_response);
 static api_processor_status_t api_processor_get_event_join_failure(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len, api_processor_response_t *p_response);
 static api_processor_status_t api_processor_parse_get_next_uplink_mtu(mcm_module_hdl_t *mcm_module, uint8_t *data, uint16_t len, api_processor_response_t *p_response);
+static void api_processor_on_rx_frame(uint8_t *frame, uint16_t len, void *user_context);
+static bool api_processor_validate_lorawan_uplink(const uint8_t *p_payload);
+static bool api_processor_validate_sid_uplink(const uint8_t *p_payload);
+static bool api_processor_validate_css_profile(const uint8_t *p_payload);
+static bool api_processor_validate_downlink_filter(const uint8_t *p_payload);
+static bool api_processor_validate_lorawan_class(const uint8_t *p_payload);
+static bool api_processor_validate_uart_baud(const uint8_t *p_payload);
+static api_processor_status_t api_processor_send_cmd(mcm_module_hdl_t *mcm_module, api_processor_cmd_id_t cmd_id,
+                                                     const uint8_t *p_prefix, uint8_t u8_prefix_len,
+                                                     const uint8_t *p_data, uint16_t u16_data_len);
+static const char *api_processor_get_cmd_name(uint16_t u16_cmd_code);
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+/**
+ * @brief Command descriptor table, indexed by api_processor_cmd_id_t.
+ *
+ * Adding a command only needs a new entry here and a builder calling api_processor_send_cmd().
+ */
+static const api_processor_cmd_desc_t s_cmd_desc_table[API_CMD_MAX] =
+{
+    [API_CMD_GET_EVENT]               = { COMMAND_TYPE_GENERAL,  MROVER_CC_GET_EVENT,                        0, 0, NULL },
+    [API_CMD_GET_VERSION]             = { COMMAND_TYPE_GENERAL,  MROVER_CC_GET_VERSION,                      0, 0, NULL },
+    [API_CMD_RESET]                   = { COMMAND_TYPE_GENERAL,  MROVER_CC_RESET,                            0, 0, NULL },
+    [API_CMD_FACTORY_RESET]           = { COMMAND_TYPE_GENERAL,  MROVER_CC_FACTORY_RESET,                    0, 0, NULL },
+    [API_CMD_SWITCH_NETWORK]          = { COMMAND_TYPE_GENERAL,  MROVER_CC_SWITCH_NETWORK,                   0, 0, NULL },
+    [API_CMD_GET_FILE_STATUS]         = { COMMAND_TYPE_GENERAL,  MROVER_CC_FILE_STATUS,                      0, 0, NULL },
+    [API_CMD_START_FILE_TRANSFER]     = { COMMAND_TYPE_GENERAL,  MROVER_CC_START_FILE_TRANSFER,              sizeof(ver_type_1_t), sizeof(ver_type_1_t), NULL },
+    [API_CMD_TRIGGER_FW_UPDATE]       = { COMMAND_TYPE_GENERAL,  MROVER_CC_TRIGGER_FW_UPDATE,                sizeof(ver_type_1_t), sizeof(ver_type_1_t), NULL },
+    [API_CMD_GET_GPS_TIME]            = { COMMAND_TYPE_GENERAL,  MROVER_CC_GET_GPS_TIME,                     0, 0, NULL },
+    [API_CMD_GET_LAST_DL_STATS]       = { COMMAND_TYPE_GENERAL,  MROVER_CC_GET_LAST_DL_STATS,                0, 0, NULL },
+    [API_CMD_GET_NEXT_UPLINK_MTU]     = { COMMAND_TYPE_GENERAL,  MROVER_CC_GET_NEXT_UPLINK_MTU,              0, 0, NULL },
+    [API_CMD_SET_UART_BAUD]           = { COMMAND_TYPE_GENERAL,  MROVER_CC_SET_UART_BAUD,                    SET_UART_BAUD_PAYLOAD_LEN, SET_UART_BAUD_PAYLOAD_LEN, api_processor_validate_uart_baud },
+    [API_CMD_INIT_LORAWAN]            = { COMMAND_TYPE_LORAWAN,  MROVER_CC_INIT_LORAWAN,                     0, 0, NULL },
+    [API_CMD_SET_JOIN_EUI]            = { COMMAND_TYPE_LORAWAN,  MROVER_CC_SET_JOIN_EUI,                     LORAWAN_DEV_EUI_JOIN_EUI_LEN, LORAWAN_DEV_EUI_JOIN_EUI_LEN, NULL },
+    [API_CMD_SET_DEV_EUI]             = { COMMAND_TYPE_LORAWAN,  MROVER_CC_SET_DEV_EUI,                      LORAWAN_DEV_EUI_JOIN_EUI_LEN, LORAWAN_DEV_EUI_JOIN_EUI_LEN, NULL },
+    [API_CMD_SET_NWK_KEY]             = { COMMAND_TYPE_LORAWAN,  MROVER_CC_SET_NW_KEY,                       LORAWAN_NETWORK_KEY_LEN, LORAWAN_NETWORK_KEY_LEN, NULL },
+    [API_CMD_GET_DEV_EUI]             = { COMMAND_TYPE_LORAWAN,  MROVER_CC_GET_DEV_EUI,                      0, 0, NULL },
+    [API_CMD_GET_JOIN_EUI]            = { COMMAND_TYPE_LORAWAN,  MROVER_CC_GET_JOIN_EUI,                     0, 0, NULL },
+    [API_CMD_JOIN_LORAWAN]            = { COMMAND_TYPE_LORAWAN,  MROVER_CC_JOIN_LORAWAN,                     0, 0, NULL },
+    [API_CMD_LORAWAN_REQUEST_UPLINK]  = { COMMAND_TYPE_LORAWAN,  MROVER_CC_REQUEST_UPLINK,                   2, COMMAND_MAX_PAYLOAD_LEN, api_processor_validate_lorawan_uplink },
+    [API_CMD_LEAVE_LORAWAN_NETWORK]   = { COMMAND_TYPE_LORAWAN,  MROVER_CC_LEAVE_LORAWAN_NETWORK,            0, 0, NULL },
+    [API_CMD_STOP_LORAWAN_NETWORK]    = { COMMAND_TYPE_LORAWAN,  MROVER_CC_STOP_SID_LORAWAN_NETWORK,         1, 1, NULL },
+    [API_CMD_SET_LORAWAN_CLASS]       = { COMMAND_TYPE_LORAWAN,  MROVER_CC_SET_LORAWAN_CLASS,                1, 1, api_processor_validate_lorawan_class },
+    [API_CMD_GET_LORAWAN_CLASS]       = { COMMAND_TYPE_LORAWAN,  MROVER_CC_GET_LORAWAN_CLASS,                0, 0, NULL },
+    [API_CMD_LORAWAN_TIME_REQUEST]    = { COMMAND_TYPE_LORAWAN,  MROVER_CC_LORAWAN_TIME_REQ,                 0, 0, NULL },
+    [API_CMD_SID_BLE_LINK_REQUEST]    = { COMMAND_TYPE_SIDEWALK, MROVER_CC_BLE_LINK_REQUEST,                 0, 0, NULL },
+    [API_CMD_SID_BLE_CONN_REQUEST]    = { COMMAND_TYPE_SIDEWALK, MROVER_CC_BLE_CONNECTION_REQUEST,           0, 0, NULL },
+    [API_CMD_SID_FSK_LINK_REQUEST]    = { COMMAND_TYPE_SIDEWALK, MROVER_CC_FSK_LINK_REQUEST,                 0, 0, NULL },
+    [API_CMD_SID_CSS_LINK_REQUEST]    = { COMMAND_TYPE_SIDEWALK, MROVER_CC_CSS_LINK_REQUEST,                 0, 0, NULL },
+    [API_CMD_SID_SET_CSS_PROFILE]     = { COMMAND_TYPE_SIDEWALK, MROVER_CC_SET_CSS_PWR_PROFILE,              1, 1, api_processor_validate_css_profile },
+    [API_CMD_SID_REQUEST_UPLINK]      = { COMMAND_TYPE_SIDEWALK, MROVER_CC_REQUEST_UPLINK,                   2, 1 + SIDEWALK_TX_MAX_BLE_PAYLOAD_SIZE, api_processor_validate_sid_uplink },
+    [API_CMD_SID_SET_DOWNLINK_FILTER] = { COMMAND_TYPE_SIDEWALK, MROVER_CC_SET_FILTERING_DOWNLINK_SIDEWALK,  1, 1, api_processor_validate_downlink_filter },
+    [API_CMD_SID_STOP]                = { COMMAND_TYPE_SIDEWALK, MROVER_CC_STOP_SID_LORAWAN_NETWORK,         1, 1, NULL },
+};
+
+/**
+ * @brief Maps a received command code to its command id, API_CMD_NONE for unknown codes.
+ *
+ * The uplink and stop commands share their code between LoRaWAN and Sidewalk, their
+ * responses are parsed the same way so the code maps to one of the two ids.
+ */
+static const uint8_t s_cmd_code_to_id[MROVER_CC_TABLE_SIZE] =
+{
+    [MROVER_CC_GET_EVENT]                       = API_CMD_GET_EVENT,
+    [MROVER_CC_GET_VERSION]                     = API_CMD_GET_VERSION,
+    [MROVER_CC_RESET]                           = API_CMD_RESET,
+    [MROVER_CC_FACTORY_RESET]                   = API_CMD_FACTORY_RESET,
+    [MROVER_CC_SWITCH_NETWORK]                  = API_CMD_SWITCH_NETWORK,
+    [MROVER_CC_FILE_STATUS]                     = API_CMD_GET_FILE_STATUS,
+    [MROVER_CC_START_FILE_TRANSFER]             = API_CMD_START_FILE_TRANSFER,
+    [MROVER_CC_TRIGGER_FW_UPDATE]               = API_CMD_TRIGGER_FW_UPDATE,
+    [MROVER_CC_GET_GPS_TIME]                    = API_CMD_GET_GPS_TIME,
+    [MROVER_CC_GET_LAST_DL_STATS]               = API_CMD_GET_LAST_DL_STATS,
+    [MROVER_CC_GET_NEXT_UPLINK_MTU]             = API_CMD_GET_NEXT_UPLINK_MTU,
+    [MROVER_CC_INIT_LORAWAN]                    = API_CMD_INIT_LORAWAN,
+    [MROVER_CC_SET_JOIN_EUI]                    = API_CMD_SET_JOIN_EUI,
+    [MROVER_CC_SET_DEV_EUI]                     = API_CMD_SET_DEV_EUI,
+    [MROVER_CC_SET_NW_KEY]                      = API_CMD_SET_NWK_KEY,
+    [MROVER_CC_GET_DEV_EUI]                     = API_CMD_GET_DEV_EUI,
+    [MROVER_CC_GET_JOIN_EUI]                    = API_CMD_GET_JOIN_EUI,
+    [MROVER_CC_JOIN_LORAWAN]                    = API_CMD_JOIN_LORAWAN,
+    [MROVER_CC_REQUEST_UPLINK]                  = API_CMD_LORAWAN_REQUEST_UPLINK,
+    [MROVER_CC_LEAVE_LORAWAN_NETWORK]           = API_CMD_LEAVE_LORAWAN_NETWORK,
+    [MROVER_CC_STOP_SID_LORAWAN_NETWORK]        = API_CMD_SID_STOP,
+    [MROVER_CC_SET_LORAWAN_CLASS]               = API_CMD_SET_LORAWAN_CLASS,
+    [MROVER_CC_GET_LORAWAN_CLASS]               = API_CMD_GET_LORAWAN_CLASS,
+    [MROVER_CC_LORAWAN_TIME_REQ]                = API_CMD_LORAWAN_TIME_REQUEST,
+    [MROVER_CC_BLE_LINK_REQUEST]                = API_CMD_SID_BLE_LINK_REQUEST,
+    [MROVER_CC_BLE_CONNECTION_REQUEST]          = API_CMD_SID_BLE_CONN_REQUEST,
+    [MROVER_CC_FSK_LINK_REQUEST]                = API_CMD_SID_FSK_LINK_REQUEST,
+    [MROVER_CC_CSS_LINK_REQUEST]                = API_CMD_SID_CSS_LINK_REQUEST,
+    [MROVER_CC_SET_CSS_PWR_PROFILE]             = API_CMD_SID_SET_CSS_PROFILE,
+    [MROVER_CC_SET_FILTERING_DOWNLINK_SIDEWALK] = API_CMD_SID_SET_DOWNLINK_FILTER,
+};
+
+/**
+ * @brief Response parser of every command, indexed by api_processor_cmd_id_t.
+ */
+static const api_processor_parser_desc_t s_rsp_parser_table[API_CMD_MAX] =
+{
+    [API_CMD_GET_EVENT]               = { api_processor_parse_get_event,            "Get Event" },
+    [API_CMD_GET_VERSION]             = { api_processor_parse_get_version,          "Get Version" },
+    [API_CMD_RESET]                   = { api_processor_parse_cmd_with_len_zero,    "reset" },
+    [API_CMD_FACTORY_RESET]           = { api_processor_parse_cmd_with_len_zero,    "Factory reset" },
+    [API_CMD_SWITCH_NETWORK]          = { api_processor_parse_cmd_with_len_zero,    "Switch network" },
+    [API_CMD_GET_FILE_STATUS]         = { api_processor_parse_get_file_status,      "File Status" },
+    [API_CMD_START_FILE_TRANSFER]     = { api_processor_parse_cmd_with_len_zero,    "Start File Transfer" },
+    [API_CMD_TRIGGER_FW_UPDATE]       = { api_processor_parse_cmd_with_len_zero,    "Trigger FW Update" },
+    [API_CMD_GET_GPS_TIME]            = { api_processor_parse_get_gps_time,         "Get GPS Time" },
+    [API_CMD_GET_LAST_DL_STATS]       = { api_processor_parse_last_dl_stats,        "Get Last Downlink Stats" },
+    [API_CMD_GET_NEXT_UPLINK_MTU]     = { api_processor_parse_get_next_uplink_mtu,  "Get Next Uplink MTU" },
+    [API_CMD_INIT_LORAWAN]            = { api_processor_parse_cmd_with_len_zero,    "Init Lorawan" },
+    [API_CMD_SET_JOIN_EUI]            = { api_processor_parse_cmd_with_len_zero,    "Set Join Eui" },
+    [API_CMD_SET_DEV_EUI]             = { api_processor_parse_cmd_with_len_zero,    "Set Dev Eui" },
+    [API_CMD_SET_NWK_KEY]             = { api_processor_parse_cmd_with_len_zero,    "Set Network key" },
+    [API_CMD_GET_DEV_EUI]             = { api_processor_parse_eui_cmd,              "Dev eui" },
+    [API_CMD_GET_JOIN_EUI]            = { api_processor_parse_eui_cmd,              "Join eui" },
+    [API_CMD_JOIN_LORAWAN]            = { api_processor_parse_cmd_with_len_zero,    "Join Lorawan" },
+    [API_CMD_LORAWAN_REQUEST_UPLINK]  = { api_processor_handle_request_uplink,      "Request Uplink" },
+    [API_CMD_LEAVE_LORAWAN_NETWORK]   = { api_processor_parse_cmd_with_len_zero,    "Leave Lorawan Network" },
+    [API_CMD_STOP_LORAWAN_NETWORK]    = { api_processor_parse_cmd_with_len_zero,    "Stop Lorawan Network" },
+    [API_CMD_SET_LORAWAN_CLASS]       = { api_processor_parse_cmd_with_len_zero,    "Set New class" },
+    [API_CMD_GET_LORAWAN_CLASS]       = { api_processor_parse_get_class_cmd,        "Get Class status" },
+    [API_CMD_LORAWAN_TIME_REQUEST]    = { api_processor_parse_cmd_with_len_zero,    "LoRaWAN Device Time Request" },
+    [API_CMD_SID_BLE_LINK_REQUEST]    = { api_processor_parse_cmd_with_len_zero,    "BLE Link Request" },
+    [API_CMD_SID_BLE_CONN_REQUEST]    = { api_processor_parse_cmd_with_len_zero,    "BLE Connection Request" },
+    [API_CMD_SID_FSK_LINK_REQUEST]    = { api_processor_parse_cmd_with_len_zero,    "BLE FSK Link Request" },
+    [API_CMD_SID_CSS_LINK_REQUEST]    = { api_processor_parse_cmd_with_len_zero,    "CSS Link Request" },
+    [API_CMD_SID_SET_CSS_PROFILE]     = { api_processor_parse_cmd_with_len_zero,    "Set CSS Power Profile" },
+    [API_CMD_SID_REQUEST_UPLINK]      = { api_processor_handle_request_uplink,      "Request Uplink" },
+    [API_CMD_SID_SET_DOWNLINK_FILTER] = { api_processor_parse_cmd_with_len_zero,    "Set downlink filtering command" },
+    [API_CMD_SID_STOP]                = { api_processor_parse_cmd_with_len_zero,    "Stop Sidewalk Network" },
+};
+
+/**
+ * @brief Maps a received event code to its event id, API_EVT_NONE for unknown codes.
+ */
+static const uint8_t s_evt_code_to_id[UINT8_MAX + 1] =
+{
+    [MODEM_EVENT_RESET]                     = API_EVT_RESET,
+    [MODEM_EVENT_ALARM]                     = API_EVT_ALARM,
+    [MODEM_EVENT_JOINED]                    = API_EVT_JOINED,
+    [MODEM_EVENT_TXDONE]                    = API_EVT_TXDONE,
+    [MODEM_EVENT_DOWNDATA]                  = API_EVT_DOWNDATA,
+    [MODEM_EVENT_UPLOADDONE]                = API_EVT_UPLOADDONE,
+    [MODEM_EVENT_SETCONF]                   = API_EVT_SETCONF,
+    [MODEM_EVENT_MUTE]                      = API_EVT_MUTE,
+    [MODEM_EVENT_STREAMDONE]                = API_EVT_STREAMDONE,
+    [MODEM_EVENT_JOINFAIL]                  = API_EVT_JOINFAIL,
+    [MODEM_EVENT_TIME]                      = API_EVT_TIME,
+    [MODEM_EVENT_TIMEOUT_ADR_CHANGED]       = API_EVT_TIMEOUT_ADR_CHANGED,
+    [MODEM_EVENT_NEW_LINK_ADR]              = API_EVT_NEW_LINK_ADR,
+    [MODEM_EVENT_LINK_CHECK]                = API_EVT_LINK_CHECK,
+    [MODEM_EVENT_ALMANAC_UPDATE]            = API_EVT_ALMANAC_UPDATE,
+    [MODEM_EVENT_USER_RADIO_ACCESS]         = API_EVT_USER_RADIO_ACCESS,
+    [MODEM_EVENT_CLASS_B_PING_SLOT_INFO]    = API_EVT_CLASS_B_PING_SLOT_INFO,
+    [MODEM_EVENT_CLASS_B_STATUS]            = API_EVT_CLASS_B_STATUS,
+    [MODEM_EVENT_LORAWAN_MAC_TIME]          = API_EVT_LORAWAN_MAC_TIME,
+    [MODEM_EVENT_SEGMENTED_FILE_DOWNLOAD]   = API_EVT_SEGMENTED_FILE_DOWNLOAD,
+    [MODEM_EVENT_CLASS_SWITCHED]            = API_EVT_CLASS_SWITCHED,
+    [MODEM_EVENT_NONE]                      = API_EVT_NO_EVENT,
+};
+
+/**
+ * @brief Event data parser of every event, indexed by api_processor_evt_id_t.
+ */
+static const api_processor_parser_desc_t s_evt_parser_table[API_EVT_MAX] =
+{
+    [API_EVT_RESET]                     = { api_processor_parse_get_event_reset,        "MODEM_EVENT_RESET" },
+    [API_EVT_ALARM]                     = { NULL,                                       "MODEM_EVENT_ALARM" },
+    [API_EVT_JOINED]                    = { NULL,                                       "MODEM_EVENT_JOINED" },
+    [API_EVT_TXDONE]                    = { api_processor_get_event_tx_status,          "MODEM_EVENT_TXDONE" },
+    [API_EVT_DOWNDATA]                  = { api_processor_get_event_down_data,          "MODEM_EVENT_DOWNDATA" },
+    [API_EVT_UPLOADDONE]                = { NULL,                                       "MODEM_EVENT_UPLOADDONE" },
+    [API_EVT_SETCONF]                   = { NULL,                                       "MODEM_EVENT_SETCONF" },
+    [API_EVT_MUTE]                      = { NULL,                                       "MODEM_EVENT_MUTE" },
+    [API_EVT_STREAMDONE]                = { NULL,                                       "MODEM_EVENT_STREAMDONE" },
+    [API_EVT_JOINFAIL]                  = { api_processor_get_event_join_failure,       "MODEM_EVENT_JOINFAIL" },
+    [API_EVT_TIME]                      = { NULL,                                       "MODEM_EVENT_TIME" },
+    [API_EVT_TIMEOUT_ADR_CHANGED]       = { NULL,                                       "MODEM_EVENT_TIMEOUT_ADR_CHANGED" },
+    [API_EVT_NEW_LINK_ADR]              = { NULL,                                       "MODEM_EVENT_NEW_LINK_ADR" },
+    [API_EVT_LINK_CHECK]                = { NULL,                                       "MODEM_EVENT_LINK_CHECK" },
+    [API_EVT_ALMANAC_UPDATE]            = { NULL,                                       "MODEM_EVENT_ALMANAC_UPDATE" },
+    [API_EVT_USER_RADIO_ACCESS]         = { NULL,                                       "MODEM_EVENT_USER_RADIO_ACCESS" },
+    [API_EVT_CLASS_B_PING_SLOT_INFO]    = { NULL,                                       "MODEM_EVENT_CLASS_B_PING_SLOT_INFO" },
+    [API_EVT_CLASS_B_STATUS]            = { NULL,                                       "MODEM_EVENT_CLASS_B_STATUS" },
+    [API_EVT_LORAWAN_MAC_TIME]          = { api_procesor_parse_lorawan_mac_time,        "MODEM_EVENT_LORAWAN_MAC_TIME" },
+    [API_EVT_SEGMENTED_FILE_DOWNLOAD]   = { api_processor_parse_get_event_seg,          "MODEM_EVENT_SEGMENTED_FILE_DOWNLOAD" },
+    [API_EVT_CLASS_SWITCHED]            = { api_procesor_parse_lorawan_class_switch,    "MODEM_EVENT_CLASS_SWITCHED" },
+    [API_EVT_NO_EVENT]                  = { NULL,                                       "MODEM_EVENT_NONE" },
+};
+
+/******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
 
 
 
@@ -126,6 +437,7 @@ static api_processor_status_t api_processor_parse_get_next_uplink_mtu(mcm_module
  */
 static api_processor_status_t api_processor_parse_response_frame(mcm_module_hdl_t *mcm_module, uint8_t *data, uint16_t len, api_processor_response_t *p_response)
 {
+    (void)len;
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
     p_response->return_code              = data[0];
     p_response->cmd_type                 = data[1];
@@ -142,104 +454,21 @@ static api_processor_status_t api_processor_parse_response_frame(mcm_module_hdl_
     //     return  return_status;
     // }
 
-    switch (p_response->cmd_code)
-    {   
-        case MROVER_CC_GET_EVENT:
-            return_status = api_processor_parse_get_event(mcm_module, &data[6], payload_len, p_response);
-        break;
-        case MROVER_CC_GET_VERSION:
-            return_status = api_processor_parse_get_version(mcm_module, &data[6], payload_len, p_response);
-        break;
-        case MROVER_CC_RESET:
-            return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "reset");
-        break;
-        case MROVER_CC_FACTORY_RESET:
-            return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "Factory reset");
-        break;
-        case MROVER_CC_SWITCH_NETWORK:
-            return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "Switch network");
-        break;
-        case MROVER_CC_INIT_LORAWAN:
-            return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "Init Lorawan");
-        break;
-        case MROVER_CC_SET_JOIN_EUI:
-            return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "Set Join Eui");
-        break;
-        case MROVER_CC_SET_DEV_EUI:
-            return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "Set Dev Eui");
-        break;
-        case MROVER_CC_SET_NW_KEY:
-            return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "Set Network key");
-        break;
-        case MROVER_CC_GET_DEV_EUI:
-            return_status = api_processor_parse_eui_cmd(mcm_module, &data[6], payload_len, p_response, "Dev eui");
-        break;
-        case MROVER_CC_GET_JOIN_EUI:
-            return_status = api_processor_parse_eui_cmd(mcm_module, &data[6], payload_len, p_response, "Join eui");
-        break;
-        case MROVER_CC_JOIN_LORAWAN:
-            return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "Join Lorawan");
-        break;
-        case MROVER_CC_REQUEST_UPLINK:
-            return_status = api_processor_handle_request_uplink(mcm_module, &data[6], payload_len, p_response);
-        break;
-        case MROVER_CC_LEAVE_LORAWAN_NETWORK:
-            return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "Leave Lorawan Network");
-        break;
-        case MROVER_CC_STOP_SID_LORAWAN_NETWORK:
-            return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "Stop Sidewalk Network");
-        break;
-        case MROVER_CC_BLE_LINK_REQUEST:
-            return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "BLE Link Request");
-        break;
-        case MROVER_CC_BLE_CONNECTION_REQUEST:
-            return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "BLE Connection Request");
-        break;
-        case MROVER_CC_FSK_LINK_REQUEST:
-            return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "BLE FSK Link Request");
-        break;
-        case MROVER_CC_CSS_LINK_REQUEST:
-            return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "CSS Link Request");
-        break;
-        case MROVER_CC_SET_CSS_PWR_PROFILE:
-            return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "Set CSS Power Profile");
-        break;
-        case MROVER_CC_SET_FILTERING_DOWNLINK_SIDEWALK:
-            return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "Set downlink filtering command");
-        break;
-        case MROVER_CC_SET_LORAWAN_CLASS:
-            return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "Set New class");
-        break;
-        case MROVER_CC_GET_LORAWAN_CLASS:
-            return_status = api_processor_parse_get_class_cmd(mcm_module, &data[6], payload_len, p_response, "Get Class status");
-        break;
-        case MROVER_CC_START_FILE_TRANSFER:
-            return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "Start File Transfer");
-        break;
-        case MROVER_CC_TRIGGER_FW_UPDATE:
-        return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "Trigger FW Update");
-        break;
-        case MROVER_CC_FILE_STATUS:
-        return_status = api_processor_parse_get_file_status(mcm_module, &data[6], payload_len, p_response);
-        break;
-        case MROVER_CC_GET_GPS_TIME:
-            return_status = api_processor_parse_get_gps_time(mcm_module, &data[6], payload_len, p_response);
-            break;
-        case MROVER_CC_LORAWAN_TIME_REQ:
-            return_status = api_processor_parse_cmd_with_len_zero(mcm_module, &data[6], payload_len, p_response, "LoRaWAN Device Time Request");
-            break; 
-        case MROVER_CC_GET_LAST_DL_STATS:
-            return_status = api_processor_parse_last_dl_stats(mcm_module, &data[6], payload_len, p_response);
-        break;
-        
-        case MROVER_CC_GET_NEXT_UPLINK_MTU:     
-            return_status = api_processor_parse_get_next_uplink_mtu(mcm_module, &data[6], payload_len, p_response);
-            break;
-
-        default:
-            TRACE_INFO("Wrong type of the command code received\n");
-            return_status = API_PROCESSOR_ERROR;
-        break;
+    const api_processor_parser_desc_t *p_parser = (MROVER_CC_TABLE_SIZE > p_response->cmd_code) ?
+                                                  &s_rsp_parser_table[s_cmd_code_to_id[p_response->cmd_code]] :
+                                                  &s_rsp_parser_table[API_CMD_NONE];
+    if (NULL == p_parser->parse)
+    {
+        TRACE_ERROR("Wrong type of the command code received\n");
+    }
+    else
+    {
+        return_status = p_parser->parse(mcm_module, &data[6], payload_len, p_response);
+        if ((API_PROCESSOR_SUCCESS != return_status) && (MROVER_RC_OK != p_response->return_code))
+        {
+            // the payload of a failed command is not used, the return code still completes the command
+            return_status = API_PROCESSOR_SUCCESS;
+        }
     }
 
     return return_status;
@@ -259,18 +488,19 @@ static api_processor_status_t api_processor_parse_response_frame(mcm_module_hdl_
  */
 static api_processor_status_t api_processor_parse_get_event_reset(mcm_module_hdl_t *mcm_module, uint8_t *data, uint16_t len, api_processor_response_t *p_response)
 {
+    (void)mcm_module;
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
 
     do
     {
         if (NULL == data)
         {
-            TRACE_INFO("In get event reset data is null\n");
+            TRACE_ERROR("In get event reset data is null\n");
             break;
         }
         if(2 != len)
         {
-            TRACE_INFO("In get event reset data length is not 2\n");
+            TRACE_ERROR("In get event reset data length is not 2\n");
             break;
         }
         p_response->cmd_response_data.get_event_data.get_event_data_value.reset_data.reset_count = (data[0] << 8 | data[1]);
@@ -295,112 +525,28 @@ static api_processor_status_t api_processor_parse_get_event_reset(mcm_module_hdl
 static api_processor_status_t api_processor_parse_get_event(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len,api_processor_response_t *p_response)
 {
     api_processor_status_t return_status = API_PROCESSOR_SUCCESS;
+
+    if (2 > len)
+    {
+        TRACE_ERROR("Get event payload too short: %d\n", len);
+        return API_PROCESSOR_ERROR;
+    }
+
     p_response->cmd_response_data.get_event_data.get_event_code = data[0];
     mcm_module->_no_of_curr_pen_evt = data[1];
     len = len - 2;
 
-    switch (p_response->cmd_response_data.get_event_data.get_event_code)
+    const api_processor_parser_desc_t *p_parser = &s_evt_parser_table[s_evt_code_to_id[data[0]]];
+    if (NULL == p_parser->name)
     {
-        case MODEM_EVENT_RESET:
-            TRACE_INFO("MODEM_EVENT_RESET\n");
-    return_status = api_processor_parse_get_event_reset(mcm_module,&data[2],len, p_response);
-    break;
-    
-        case MODEM_EVENT_ALARM:
-            TRACE_INFO("MODEM_EVENT_ALARM\n");
-            break;
-
-        case MODEM_EVENT_JOINED:
-            TRACE_INFO("MODEM_EVENT_JOINED\n");
-            break;
-
-        case MODEM_EVENT_TXDONE:
-            TRACE_INFO("MODEM_EVENT_TXDONE\n");
-    return_status = api_processor_get_event_tx_status(mcm_module,&data[2],len, p_response);
-    break;
-
-        case MODEM_EVENT_DOWNDATA:
-            TRACE_INFO("MODEM_EVENT_DOWNDATA\n");
-    return_status = api_processor_get_event_down_data(mcm_module,&data[2],len, p_response);
-    break;
-
-        case MODEM_EVENT_UPLOADDONE:
-            TRACE_INFO("MODEM_EVENT_UPLOADDONE\n");
-    break;
-
-        case MODEM_EVENT_SETCONF:
-            TRACE_INFO("MODEM_EVENT_SETCONF\n");
-    break;
-
-        case MODEM_EVENT_MUTE:
-            TRACE_INFO("MODEM_EVENT_MUTE\n");
-            break;
-
-        case MODEM_EVENT_STREAMDONE:
-            TRACE_INFO("MODEM_EVENT_STREAMDONE\n");
-            break;
-
-        case MODEM_EVENT_JOINFAIL:
-            TRACE_INFO("MODEM_EVENT_JOINFAIL\n");
-            return_status = api_processor_get_event_join_failure(mcm_module,&data[2],len, p_response);
-            break;
-
-        case MODEM_EVENT_TIME:
-            TRACE_INFO("MODEM_EVENT_TIME\n");
-            break;
-
-        case MODEM_EVENT_TIMEOUT_ADR_CHANGED:
-            TRACE_INFO("MODEM_EVENT_TIMEOUT_ADR_CHANGED\n");
-            break;
-
-        case MODEM_EVENT_NEW_LINK_ADR:
-            TRACE_INFO("MODEM_EVENT_NEW_LINK_ADR\n");
-            break;
-
-        case MODEM_EVENT_LINK_CHECK:
-            TRACE_INFO("MODEM_EVENT_LINK_CHECK\n");
-            break;
-
-        case MODEM_EVENT_ALMANAC_UPDATE:
-            TRACE_INFO("MODEM_EVENT_ALMANAC_UPDATE\n");
-            break;
-
-        case MODEM_EVENT_USER_RADIO_ACCESS:
-            TRACE_INFO("MODEM_EVENT_USER_RADIO_ACCESS\n");
-            break;
-
-        case MODEM_EVENT_CLASS_B_PING_SLOT_INFO:
-            TRACE_INFO("MODEM_EVENT_CLASS_B_PING_SLOT_INFO\n");
-            break;
-
-        case MODEM_EVENT_CLASS_B_STATUS:
-            TRACE_INFO("MODEM_EVENT_CLASS_B_STATUS\n");
-            break;
-
-        case MODEM_EVENT_LORAWAN_MAC_TIME:
-            TRACE_INFO("MODEM_EVENT_LORAWAN_MAC_TIME\n");
-            return_status = api_procesor_parse_lorawan_mac_time(mcm_module,&data[2],len, p_response);
-            break;
-
-        case MODEM_EVENT_SEGMENTED_FILE_DOWNLOAD:
-            TRACE_INFO("MODEM_EVENT_SEGMENTED_FILE_DOWNLOAD\n");
-    return_status = api_processor_parse_get_event_seg(mcm_module, &data[2], len, p_response);
-    break;
-
-        case MODEM_EVENT_CLASS_SWITCHED:
-            TRACE_INFO("MODEM_EVENT_CLASS_SWITCHED\n");
-            return_status = api_procesor_parse_lorawan_class_switch(mcm_module,&data[2],len, p_response);
-            break;
-
-        case MODEM_EVENT_NONE:
-            TRACE_INFO("MODEM_EVENT_NONE\n");
-            return_status = API_PROCESSOR_SUCCESS;
-    break;
+        TRACE_ERROR("Wrong type of the modem event code\n");
+        return API_PROCESSOR_ERROR;
+    }
 
-    default:
-            TRACE_INFO("Wrong type of the modem event code\n");
-    return_status = API_PROCESSOR_ERROR;
-    break;
+    TRACE_DEBUG("%s\n", p_parser->name);
+    if (NULL != p_parser->parse)
+    {
+        return_status = p_parser->parse(mcm_module, &data[2], len, p_response);
     }
 
     return return_status;
@@ -421,18 +567,19 @@ static api_processor_status_t api_processor_parse_get_event(mcm_module_hdl_t *mc
  */
 static api_processor_status_t api_processor_get_event_tx_status(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len, api_processor_response_t *p_response)
 {
+    (void)mcm_module;
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
 
     do
     {
         if (NULL == data || 1 != len)
         {
-            TRACE_INFO("Invalid data payload for get event tx status\n");
+            TRACE_ERROR("Invalid data payload for get event tx status\n");
             break;
         }
         if(MROVER_TX_DONE_WITH_ACK < data[0])
         {
-            TRACE_INFO("Got the invalid tx status value 0x%02x\n",data[0]);
+            TRACE_ERROR("Got the invalid tx status value 0x%02x\n",data[0]);
             break;
         }
         p_response->cmd_response_data.get_event_data.get_event_data_value.tx_status_data.tx_status = data[0];
@@ -464,7 +611,7 @@ static api_processor_status_t api_processor_get_event_down_data(mcm_module_hdl_t
     {
         if (NULL == data || MIN_DOWNLINK_PAYLOAD_LEN > len)
         {
-            TRACE_INFO("Invalid data payload for get event downlink\n");
+            TRACE_ERROR("Invalid data payload for get event downlink\n");
             break;
         }
         // parse according to the data type, either lorawan or sidewalk
@@ -501,6 +648,7 @@ static api_processor_status_t api_processor_get_event_down_data(mcm_module_hdl_t
  */
 static api_processor_status_t api_processor_parse_lorawan_down_data(mcm_module_hdl_t *mcm_module, uint8_t *data, uint16_t len, api_processor_response_t *p_response)
 {
+    (void)mcm_module;
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
 
     do
@@ -521,6 +669,8 @@ static api_processor_status_t api_processor_parse_lorawan_down_data(mcm_module_h
 
 static api_processor_status_t api_procesor_parse_lorawan_class_switch(mcm_module_hdl_t *mcm_module, uint8_t *data, uint16_t len, api_processor_response_t *p_response)
 {
+    (void)mcm_module;
+    (void)len;
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
 
     do 
@@ -535,6 +685,8 @@ static api_processor_status_t api_procesor_parse_lorawan_class_switch(mcm_module
 
 static api_processor_status_t api_procesor_parse_lorawan_mac_time(mcm_module_hdl_t *mcm_module, uint8_t *data, uint16_t len, api_processor_response_t *p_response)
 {
+    (void)mcm_module;
+    (void)len;
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
 
     do 
@@ -550,6 +702,7 @@ static api_processor_status_t api_procesor_parse_lorawan_mac_time(mcm_module_hdl
 
 static api_processor_status_t api_processor_parse_get_event_seg(mcm_module_hdl_t *mcm_module, uint8_t *data, uint16_t len, api_processor_response_t *p_response)
 {
+    (void)mcm_module;
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
 
     do
@@ -597,6 +750,7 @@ static api_processor_status_t api_processor_parse_get_event_seg(mcm_module_hdl_t
  */
 static api_processor_status_t api_processor_parse_sid_down_data(mcm_module_hdl_t *mcm_module, uint8_t *data, uint16_t len, api_processor_response_t *p_response)
 {
+    (void)mcm_module;
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
 
     do
@@ -631,13 +785,14 @@ static api_processor_status_t api_processor_parse_sid_down_data(mcm_module_hdl_t
  */
 static api_processor_status_t api_processor_parse_get_version(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len, api_processor_response_t *p_response)
 {
+    (void)mcm_module;
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
 
     do
     {
         if((NULL == data) || (GET_VERSION_RESPONSE_PAYLOAD_LEN != len) )
         {
-            TRACE_INFO("Invalid data payload for get version\n");
+            TRACE_ERROR("Invalid data payload for get version\n");
             break;
         }        
         p_response->cmd_response_data.ver_info.bootloader.major = data[0];
@@ -671,13 +826,14 @@ static api_processor_status_t api_processor_parse_get_version(mcm_module_hdl_t *
 
 static api_processor_status_t api_processor_parse_get_file_status(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len, api_processor_response_t *p_response)
 {
+    (void)mcm_module;
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
 
     do
     {
         if((NULL == data) || (sizeof(get_seg_file_status_t) != len) )
         {
-            TRACE_INFO("Invalid data payload for get file status\n");
+            TRACE_ERROR("Invalid data payload for get file status\n");
             break;
         }
         p_response->cmd_response_data.seg_file_status.cmd_type.bin_type = data[0] & 0x0F;
@@ -728,22 +884,22 @@ static api_processor_status_t api_processor_parse_last_dl_stats(mcm_module_hdl_t
 
         // Parse protocol type
         p_response->cmd_response_data.last_dl_stats.protocol_type = data[0];
-        TRACE_INFO("Parsed protocol type: %d\n", p_response->cmd_response_data.last_dl_stats.protocol_type);
+        TRACE_DEBUG("Parsed protocol type: %d\n", p_response->cmd_response_data.last_dl_stats.protocol_type);
 
         // Parse RSSI value
         p_response->cmd_response_data.last_dl_stats.rssi = data[1];
-        TRACE_INFO("Parsed RSSI: %d\n", p_response->cmd_response_data.last_dl_stats.rssi);
+        TRACE_DEBUG("Parsed RSSI: %d\n", p_response->cmd_response_data.last_dl_stats.rssi);
 
         // Parse SNR value
         p_response->cmd_response_data.last_dl_stats.snr = data[2];
-        TRACE_INFO("Parsed SNR: %d\n", p_response->cmd_response_data.last_dl_stats.snr);
+        TRACE_DEBUG("Parsed SNR: %d\n", p_response->cmd_response_data.last_dl_stats.snr);
 
         // Parse timestamp
         p_response->cmd_response_data.last_dl_stats.timestamp = (data[3] << 24);
         p_response->cmd_response_data.last_dl_stats.timestamp |= (data[4] << 16);
         p_response->cmd_response_data.last_dl_stats.timestamp |= (data[5] << 8);
         p_response->cmd_response_data.last_dl_stats.timestamp |= data[6];
-        TRACE_INFO("Parsed timestamp: %lu\n", p_response->cmd_response_data.last_dl_stats.timestamp);
+        TRACE_DEBUG("Parsed timestamp: %lu\n", p_response->cmd_response_data.last_dl_stats.timestamp);
 
         return_status = API_PROCESSOR_SUCCESS;
 
@@ -751,7 +907,7 @@ static api_processor_status_t api_processor_parse_last_dl_stats(mcm_module_hdl_t
 
     if (return_status != API_PROCESSOR_SUCCESS)
     {
-        TRACE_INFO("Failed to parse last downlink stats. Error code: %d\n", return_status);
+        TRACE_ERROR("Failed to parse last downlink stats. Error code: %d\n", return_status);
     }
 
     return return_status;
@@ -760,31 +916,32 @@ static api_processor_status_t api_processor_parse_last_dl_stats(mcm_module_hdl_t
 // New function to parse GPS time response
 static api_processor_status_t api_processor_parse_get_gps_time(mcm_module_hdl_t *mcm_module, uint8_t *data, uint16_t len, api_processor_response_t *p_response)
 {
+    (void)mcm_module;
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
 
-    TRACE_INFO("Starting GPS time parsing\n");
+    TRACE_DEBUG("Starting GPS time parsing\n");
 
     do
     {
         if (data == NULL)
         {
-            TRACE_INFO("Null data pointer received for GPS time parsing\n");
+            TRACE_ERROR("Null data pointer received for GPS time parsing\n");
             break;
         }
 
         if(p_response->return_code == MROVER_RC_GPS_TIME_NOT_AVAILABLE)
         {
-            TRACE_INFO("GPS Time is not available\n");
+            TRACE_WARN("GPS Time is not available\n");
             break;
         }
 
         if (len < sizeof(uint32_t)) // Assuming GPS time is a 4-byte value
         {
-            TRACE_INFO("Invalid data length for GPS time. Expected: %zu, Received: %u\n", sizeof(uint32_t), len);
+            TRACE_ERROR("Invalid data length for GPS time. Expected: %zu, Received: %u\n", sizeof(uint32_t), len);
             break;
         }
 
-        TRACE_INFO("Raw GPS time bytes: [0x%02X, 0x%02X, 0x%02X, 0x%02X]\n", 
+        TRACE_DEBUG("Raw GPS time bytes: [0x%02X, 0x%02X, 0x%02X, 0x%02X]\n", 
                   data[0], data[1], data[2], data[3]);
 
         // Parse the GPS time (assuming it's a 32-bit integer)
@@ -794,18 +951,18 @@ static api_processor_status_t api_processor_parse_get_gps_time(mcm_module_hdl_t
         gps_time |= (data[2] << 8);
         gps_time |= data[3];
 
-        TRACE_INFO("Parsed GPS timestamp: %lu (0x%08lX)\n", gps_time, gps_time);
+        TRACE_DEBUG("Parsed GPS timestamp: %lu (0x%08lX)\n", gps_time, gps_time);
 
         p_response->cmd_response_data.gps_timestamp = gps_time;
         return_status = API_PROCESSOR_SUCCESS;
 
-        TRACE_INFO("GPS time parsing completed successfully\n");
+        TRACE_DEBUG("GPS time parsing completed successfully\n");
 
     } while (0);
 
     if (return_status != API_PROCESSOR_SUCCESS)
     {
-        TRACE_INFO("GPS time parsing failed with error code: %d\n", return_status);
+        TRACE_ERROR("GPS time parsing failed with error code: %d\n", return_status);
     }
 
     return return_status;
@@ -829,14 +986,16 @@ static api_processor_status_t api_processor_parse_get_gps_time(mcm_module_hdl_t
  * @return API_PROCESSOR_SUCCESS if the parsing is successful. If any error
  *         in parsing, returns API_PROCESSOR_ERROR
  */
-static api_processor_status_t api_processor_parse_cmd_with_len_zero(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len, api_processor_response_t *p_response,const char* module)
+static api_processor_status_t api_processor_parse_cmd_with_len_zero(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len, api_processor_response_t *p_response)
 {
+    (void)mcm_module;
+    (void)data;
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
      do
     {
         if(0 != len)
         {
-            TRACE_INFO("Wrong payload length for %s command\n",module);
+            TRACE_ERROR("Wrong payload length for %s command\n", api_processor_get_cmd_name(p_response->cmd_code));
             break;
         }
         return_status = API_PROCESSOR_SUCCESS;
@@ -860,15 +1019,16 @@ static api_processor_status_t api_processor_parse_cmd_with_len_zero(mcm_module_h
  * @return API_PROCESSOR_SUCCESS if the parsing is successful. If any error
  *         in parsing, returns API_PROCESSOR_ERROR
  */
-static api_processor_status_t api_processor_parse_eui_cmd(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len, api_processor_response_t *p_response,const char* eui_type)
+static api_processor_status_t api_processor_parse_eui_cmd(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len, api_processor_response_t *p_response)
 {
+    (void)mcm_module;
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
 
     do
     {
         if(LORAWAN_DEV_EUI_JOIN_EUI_LEN != len)
         {
-            TRACE_INFO("Wrong payload length for %s command\n",eui_type);
+            TRACE_ERROR("Wrong payload length for %s command\n", api_processor_get_cmd_name(p_response->cmd_code));
             break;
         }
         if(MROVER_CC_GET_DEV_EUI == p_response->cmd_code)
@@ -890,15 +1050,16 @@ static api_processor_status_t api_processor_parse_eui_cmd(mcm_module_hdl_t *mcm_
     return  return_status;
 }
 
-static api_processor_status_t api_processor_parse_get_class_cmd(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len, api_processor_response_t *p_response,const char* eui_type)
+static api_processor_status_t api_processor_parse_get_class_cmd(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len, api_processor_response_t *p_response)
 {
+    (void)mcm_module;
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
 
     do
     {
         if(1 != len)
         {
-            TRACE_INFO("Wrong payload length for %s command\n",eui_type);
+            TRACE_ERROR("Wrong payload length for %s command\n", api_processor_get_cmd_name(p_response->cmd_code));
             break;
         }
 
@@ -912,36 +1073,6 @@ static api_processor_status_t api_processor_parse_get_class_cmd(mcm_module_hdl_t
     return  return_status;
 }
 
-static api_processor_status_t api_processor_parse_cmd(mcm_module_hdl_t *mcm_module,uint8_t *data, uint16_t len, api_processor_response_t *p_response,const char* eui_type)
-{
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-
-    do
-    {
-        if(LORAWAN_DEV_EUI_JOIN_EUI_LEN != len)
-        {
-            TRACE_INFO("Wrong payload length for %s command\n",eui_type);
-            break;
-        }
-        if(MROVER_CC_GET_DEV_EUI == p_response->cmd_code)
-        {
-            p_response->cmd_response_data.dev_eui = data;
-           
-        }
-        else
-        {
-            p_response->cmd_response_data.join_eui = data;
-            
-        }
-
-        return_status = API_PROCESSOR_SUCCESS;
-
-    } while (0);
-    
-
-    return  return_status;
-}
-
 /**
  * @brief This function parses the single frame that is received from the
  *        MCM module. It populates the api_processor_response_t structure with
@@ -962,19 +1093,19 @@ static api_processor_status_t api_processor_parse_single_frame(mcm_module_hdl_t
     {
         if (NULL == mcm_module)
         {
-            TRACE_INFO("MCM module is not initialized\n");
+            TRACE_ERROR("MCM module is not initialized\n");
             break;
         }
 
         if (NULL == data || MIN_RX_PAYLOAD_LEN > len)
         {   
-            TRACE_INFO("Serial data is not valid. Length: %d\n", len);
+            TRACE_ERROR("Serial data is not valid. Length: %d\n", len);
             return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
             break;
         }
         
         bool is_frame_notification = fp_is_frame_notification(data, len);
-        TRACE_INFO("Frame notification check: %s\n", is_frame_notification ? "True" : "False");
+        TRACE_DEBUG("Frame notification check: %s\n", is_frame_notification ? "True" : "False");
 
         if (is_frame_notification)
         {
@@ -982,12 +1113,12 @@ static api_processor_status_t api_processor_parse_single_frame(mcm_module_hdl_t
             fp_api_status_t status = fp_is_valid_notify_frame(data,len);
             if(FP_SUCCESS != status)
             {
-                TRACE_INFO("Failed to parse Notification\n");
+                TRACE_ERROR("Failed to parse Notification\n");
                 break;
             }
             // Get the value of the pending event
             mcm_module->_no_of_curr_pen_evt = fp_get_pending_event_count(data, len);
-            TRACE_INFO("Pending event count: %d\n", mcm_module->_no_of_curr_pen_evt);
+            TRACE_DEBUG("Pending event count: %d\n", mcm_module->_no_of_curr_pen_evt);
             mcm_module->handle_notification_cb(mcm_module->user_context);
             return_status = API_PROCESSOR_SUCCESS;
             break;
@@ -998,7 +1129,7 @@ static api_processor_status_t api_processor_parse_single_frame(mcm_module_hdl_t
             fp_api_status_t status = fp_is_valid_response_frame(data, len);
             if (FP_SUCCESS != status)
             {
-                TRACE_INFO("Failed to parse data\n");
+                TRACE_ERROR("Failed to parse data\n");
                 break;
             }
 
@@ -1009,12 +1140,12 @@ static api_processor_status_t api_processor_parse_single_frame(mcm_module_hdl_t
             // in case parsing error just return error
             if(API_PROCESSOR_SUCCESS != return_status)
             {
-                TRACE_INFO("Response parsing failed with status: %d\n", return_status);
+                TRACE_ERROR("Response parsing failed with status: %d\n", return_status);
                 break;
             }
 
             // Now call the callback function for response
-            TRACE_INFO("Calling response callback\n");
+            TRACE_DEBUG("Calling response callback\n");
             mcm_module->handle_response_cb(&response, mcm_module->user_context);
         }
 
@@ -1024,1618 +1155,745 @@ static api_processor_status_t api_processor_parse_single_frame(mcm_module_hdl_t
 }
 
 
-/******************************************************************************
- * GLOBAL FUNCTIONS
- ******************************************************************************/
-
-/******************************************************************************
- * Function Prototypes
- *******************************************************************************/
-
-/*******************************************************************************
-* Helper Functions
-********************************************************************************/
-
-inline mrover_return_code_t mcm_helper_get_response_code(const api_processor_response_t *res)
+/**
+ * @brief Callback of the stream decoder, called for every complete frame
+ *        received from the MCM module.
+ *
+ * @param frame Pointer to the complete frame.
+ * @param len Length of the frame.
+ * @param user_context Pointer to the MCM module structure.
+ */
+static void api_processor_on_rx_frame(uint8_t *frame, uint16_t len, void *user_context)
 {
-    return res->return_code;
-}
+    mcm_module_hdl_t *mcm_module = (mcm_module_hdl_t *)user_context;
 
-inline command_types_t mcm_helper_get_command_type(const api_processor_response_t *res)
-{
-    return res->cmd_type;
+    if (API_PROCESSOR_SUCCESS != api_processor_parse_single_frame(mcm_module, frame, len))
+    {
+        TRACE_ERROR("Failed to process the received frame\n");
+    }
 }
 
-inline mrover_cc_codes_t mcm_helper_get_command_code(const api_processor_response_t *res)
+/**
+ * @brief Checks the port and the uplink type of a LoRaWAN uplink request.
+ *
+ * The application shall not use port 0 or the ports from 225 to 255 since they are
+ * reserved for future standardized application extensions.
+ */
+static bool api_processor_validate_lorawan_uplink(const uint8_t *p_payload)
 {
-    return res->cmd_code;
-}
+    if ((0 == p_payload[0]) || (225 <= p_payload[0]))
+    {
+        TRACE_ERROR("Please provide a valid port number\n");
+        return false;
+    }
 
-inline const uint8_t* mcm_helper_get_dev_eui(const api_processor_response_t *res)
-{
-    return res->cmd_response_data.dev_eui;
-}
+    if (MROVER_CONFIRMED_UPLINK < p_payload[1])
+    {
+        TRACE_ERROR("Please provide a valid uplink type\n");
+        return false;
+    }
 
-inline const uint8_t* mcm_helper_get_join_eui(const api_processor_response_t *res)
-{
-   return res->cmd_response_data.join_eui;
+    return true;
 }
 
-inline mrover_lorawan_class_t mcm_helper_get_device_class(const api_processor_response_t *res)
+/**
+ * @brief Checks the uplink type of a Sidewalk uplink request.
+ */
+static bool api_processor_validate_sid_uplink(const uint8_t *p_payload)
 {
-    return res->cmd_response_data.get_event_data.get_event_data_value.class_switch_data.new_class;
-}
-
-inline uint16_t mcm_helper_get_next_uplink_mtu(const api_processor_response_t *res) {
-    return res->cmd_response_data.next_uplink_mtu;
-}
+    if (MROVER_CONFIRMED_UPLINK < p_payload[0])
+    {
+        TRACE_ERROR("Please provide a valid uplink type\n");
+        return false;
+    }
 
-void mcm_helper_get_version(const api_processor_response_t *res,ver_type_2_t *bootloader,ver_type_2_t* mdm_fw,\
-                            ver_type_1_t *mdm_hw,ver_type_1_t *sidwlk,ver_type_1_t *lrwan)
-{
-    *bootloader = res->cmd_response_data.ver_info.bootloader;
-    *mdm_fw = res->cmd_response_data.ver_info.modem_fw;
-    *mdm_hw = res->cmd_response_data.ver_info.modem_hw;
-    *sidwlk = res->cmd_response_data.ver_info.sidewalk;
-    *lrwan = res->cmd_response_data.ver_info.lorawan;
+    return true;
 }
 
-void mcm_helper_get_downlink_data(const api_processor_response_t *res,int8_t *rssi,int8_t *snr,uint8_t *payload,uint16_t *port_seq)
+/**
+ * @brief Checks the requested CSS power profile.
+ */
+static bool api_processor_validate_css_profile(const uint8_t *p_payload)
 {
-    *rssi = res->cmd_response_data.get_event_data.get_event_data_value.down_data.rssi;
-    *snr = res->cmd_response_data.get_event_data.get_event_data_value.down_data.snr;
-    *port_seq = res->cmd_response_data.get_event_data.get_event_data_value.down_data.lrwan_sid_seq_port;
-    if(NULL != payload)
+    if (MROVER_CSS_PWR_PROFILE_B < p_payload[0])
     {
-        memcpy(payload,res->cmd_response_data.get_event_data.get_event_data_value.down_data.payload,res->cmd_response_data.get_event_data.get_event_data_value.down_data.payload_len);   
+        TRACE_ERROR("Invalid CSS profile\n");
+        return false;
     }
-}
 
-inline uint16_t mcm_helper_get_downlink_len(const api_processor_response_t *res)
-{
-    return res->cmd_response_data.get_event_data.get_event_data_value.down_data.payload_len;
+    return true;
 }
 
-inline uint8_t mcm_helper_get_event_reset_count(const api_processor_response_t *res)
+/**
+ * @brief Checks the requested Sidewalk downlink filtering option.
+ */
+static bool api_processor_validate_downlink_filter(const uint8_t *p_payload)
 {
-    return res->cmd_response_data.get_event_data.get_event_data_value.reset_data.reset_count;
-}
-
+    if (MROVER_SID_DISABLE_FILTERING < p_payload[0])
+    {
+        TRACE_ERROR("Wrong filtering value\n");
+        return false;
+    }
 
-inline get_event_code_t mcm_helper_get_event_code(const api_processor_response_t *res)
-{
-    return res->cmd_response_data.get_event_data.get_event_code;
+    return true;
 }
 
-inline mrover_uplink_event_type_t mcm_helper_get_event_tx_status(const api_processor_response_t *res)
+/**
+ * @brief Checks the requested LoRaWAN class.
+ */
+static bool api_processor_validate_lorawan_class(const uint8_t *p_payload)
 {
-    return res->cmd_response_data.get_event_data.get_event_data_value.tx_status_data.tx_status;
-}
+    if (MROVER_LORAWAN_CLASS_C < p_payload[0])
+    {
+        TRACE_ERROR("Invalid LoRaWAN class\n");
+        return false;
+    }
 
-inline mrover_lorawan_class_t mcm_helper_get_event_new_class(const api_processor_response_t *res)
-{
-    return res->cmd_response_data.get_event_data.get_event_data_value.class_switch_data.new_class;
+    return true;
 }
 
-inline get_seg_file_status_t mcm_helper_get_event_seg_down(const api_processor_response_t *res)
+/**
+ * @brief Checks that the requested baud rate is one of the standard uart rates.
+ *
+ * @param[in] p_payload Pointer to the payload, the baud rate in big endian
+ *
+ * @return true if the rate is supported, false otherwise
+ */
+static bool api_processor_validate_uart_baud(const uint8_t *p_payload)
 {
-    return res->cmd_response_data.get_event_data.get_event_data_value.download_segment_data;
-}
+    static const uint32_t u32_baud_rates[] = { 9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600 };
+    const uint32_t u32_baud = ((uint32_t)p_payload[0] << 24) | ((uint32_t)p_payload[1] << 16) |
+                              ((uint32_t)p_payload[2] << 8) | (uint32_t)p_payload[3];
 
-void mcm_helper_get_seg_file_status(const api_processor_response_t *res, get_seg_file_status_t *seg_file_status)
-{
-    *seg_file_status = res->cmd_response_data.seg_file_status;
-}
+    for (uint8_t i = 0; i < (sizeof(u32_baud_rates) / sizeof(u32_baud_rates[0])); i++)
+    {
+        if (u32_baud == u32_baud_rates[i])
+        {
+            return true;
+        }
+    }
 
-uint32_t mcm_helper_get_gps_time(const api_processor_response_t *res)
-{
-    return res->cmd_response_data.gps_timestamp;
+    TRACE_ERROR("Unsupported baud rate %lu\n", (unsigned long)u32_baud);
+    return false;
 }
 
-mrover_lorawan_mac_event_t mcm_helper_get_mac_time_event(const api_processor_response_t *res)
-{
-    return res->cmd_response_data.get_event_data.get_event_data_value.mac_time.mac_event;
-}
-
-inline uint8_t mcm_helper_get_join_failure_reason(const api_processor_response_t *res)
-{
-    return res->cmd_response_data.get_event_data.get_event_data_value.failure_reason.failure_reason;
-}
-
-
-/******************************************************************************
- * Function Definitions
- *******************************************************************************/
-
-api_processor_status_t api_processor_init(mcm_module_hdl_t *mcm_module,serial_send_data_cb send_data_cb,mrover_notification_cb h_mrover_notification_cb,mrover_response_cb h_mrover_response_cb)
-{
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-    
-
-    do
-    {
-        if (NULL == mcm_module)
-        {
-            TRACE_INFO("mcm_module is NULL\n");
-            return_status = API_PROCESSOR_INVALID_PARAMETERS;
-            break;
-        }
-
-        if (NULL == send_data_cb)
-        {
-            TRACE_INFO("Please profile the callback function for serial send data\n");
-            return_status = API_PROCESSOR_INVALID_PARAMETERS;
-            break;
-        }
-        mcm_module->h_serial_device.send_data_cb = send_data_cb;
-
-        if(NULL == h_mrover_notification_cb)
-        {
-            TRACE_INFO("Warn, Notification callback not set\n");
-            break;
-        }
-
-        mcm_module->handle_notification_cb = h_mrover_notification_cb;
-        if(NULL == h_mrover_response_cb)
-        {
-            TRACE_INFO("MCM module response call back handle is not provided\n");
-            break;
-        }
-
-        mcm_module->handle_response_cb = h_mrover_response_cb;
-        return_status = API_PROCESSOR_SUCCESS;
-    } while (0);
-
-    return return_status;
-}
-
-
-
-void api_processor_get_lib_ver(ver_type_1_t *ver) {
-    if (ver != NULL) 
-    {
-        ver->major = API_PROCESSOR_LIB_MAJOR_VERSION; // Set major version
-        ver->minor = API_PROCESSOR_LIB_MINOR_VERSION; // Set minor version
-        ver->patch = API_PROCESSOR_LIB_PATCH_VERSION; // Set patch version
-    }
-}
-
-
-api_processor_status_t api_processor_cmd_get_event(mcm_module_hdl_t *mcm_module)
-{
-    const uint16_t max_payload_size = 6;
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_GENERAL;
-        mcm_module->u8_send_payload[1] = MROVER_CC_GET_EVENT >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_GET_EVENT & 0xFF;
-        mcm_module->u8_send_payload[3] = 0;
-        mcm_module->u8_send_payload[4] = 0;
-        mcm_module->u8_send_payload[5] = 0;
-
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
-
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
-    } while (0);
-
-    return return_status;
-}
-
-
-api_processor_status_t api_processor_cmd_get_version(mcm_module_hdl_t *mcm_module)
-{
-    const uint16_t max_payload_size = 6;
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_GENERAL;
-        mcm_module->u8_send_payload[1] = MROVER_CC_GET_VERSION >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_GET_VERSION & 0xFF;
-        mcm_module->u8_send_payload[3] = 0;
-        mcm_module->u8_send_payload[4] = 0;
-        mcm_module->u8_send_payload[5] = 0;
-
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
-
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
-    } while (0);
-
-    return return_status;
-}
-
-
-api_processor_status_t api_processor_cmd_reset(mcm_module_hdl_t *mcm_module)
-{
-
-    const uint16_t max_payload_size = 6;
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_GENERAL;
-        mcm_module->u8_send_payload[1] = MROVER_CC_RESET >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_RESET & 0xFF;
-        mcm_module->u8_send_payload[3] = 0;
-        mcm_module->u8_send_payload[4] = 0;
-        mcm_module->u8_send_payload[5] = 0;
-
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
-
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
-    } while (0);
-
-    return return_status;
-}
-
-
-api_processor_status_t api_processor_cmd_factory_reset(mcm_module_hdl_t *mcm_module)
-{
-    const uint16_t max_payload_size = 6;
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_GENERAL;
-        mcm_module->u8_send_payload[1] = MROVER_CC_FACTORY_RESET >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_FACTORY_RESET & 0xFF;
-        mcm_module->u8_send_payload[3] = 0;
-        mcm_module->u8_send_payload[4] = 0;
-        mcm_module->u8_send_payload[5] = 0;
-
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
-
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
-    } while (0);
-
-    return return_status;
-}
-
-
-api_processor_status_t api_processor_cmd_switch_network(mcm_module_hdl_t *mcm_module)
-{
-    const uint16_t max_payload_size = 6;
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_GENERAL;
-        mcm_module->u8_send_payload[1] = MROVER_CC_SWITCH_NETWORK >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_SWITCH_NETWORK & 0xFF;
-        mcm_module->u8_send_payload[3] = 0;
-        mcm_module->u8_send_payload[4] = 0;
-        mcm_module->u8_send_payload[5] = 0;
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
-
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
-    } while (0);
-
-    return return_status;
-}
-
-
-api_processor_status_t api_processor_cmd_init_lorawan(mcm_module_hdl_t *mcm_module)
-{
-    const uint16_t max_payload_size = 6;
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-
-    do
-    {
-
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_LORAWAN;
-        mcm_module->u8_send_payload[1] = MROVER_CC_INIT_LORAWAN >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_INIT_LORAWAN & 0xFF;
-        mcm_module->u8_send_payload[3] = 0;
-        mcm_module->u8_send_payload[4] = 0;
-        mcm_module->u8_send_payload[5] = 0;
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
-
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
-    } while (0);
-
-    return return_status;
-}
-
-
-api_processor_status_t api_processor_cmd_set_join_eui(mcm_module_hdl_t *mcm_module, uint8_t *p_join_eui, uint8_t u8_join_eui_len)
-{
-    const uint16_t max_payload_size = 14;
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-        if (u8_join_eui_len != 8 || p_join_eui == NULL)
-        {
-            TRACE_INFO("Join eui is not correct. Please provide a valid join eui\n");
-            return_status = API_PROCESSOR_INVALID_PARAMETERS;
-            break;
-        }
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_LORAWAN;
-        mcm_module->u8_send_payload[1] = MROVER_CC_SET_JOIN_EUI >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_SET_JOIN_EUI & 0xFF;
-        mcm_module->u8_send_payload[3] = 0x00;
-        mcm_module->u8_send_payload[4] = u8_join_eui_len;
-        memcpy(&mcm_module->u8_send_payload[5], p_join_eui, u8_join_eui_len);
-
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
-
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
-
-    } while (0);
-
-    return return_status;
-}
-
-
-api_processor_status_t api_processor_cmd_set_dev_eui(mcm_module_hdl_t *mcm_module, uint8_t *p_dev_eui, uint8_t u8_dev_eui_len)
-{
-    const uint16_t max_payload_size = 14;
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-
-        if (u8_dev_eui_len != 8 || p_dev_eui == NULL)
-        {
-            TRACE_INFO("Dev eui is not correct. Please provide a valid dev eui\n");
-            return_status = API_PROCESSOR_INVALID_PARAMETERS;
-            break;
-        }
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_LORAWAN;
-        mcm_module->u8_send_payload[1] = MROVER_CC_SET_DEV_EUI >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_SET_DEV_EUI & 0xFF;
-        mcm_module->u8_send_payload[3] = 0x00;
-        mcm_module->u8_send_payload[4] = u8_dev_eui_len;
-        memcpy(&mcm_module->u8_send_payload[5], p_dev_eui, u8_dev_eui_len);
-
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
-
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
-
-    } while (0);
-
-    return return_status;
-}
-
-
-api_processor_status_t api_processor_cmd_set_nwk_key(mcm_module_hdl_t *mcm_module, uint8_t *p_nwk_key, uint16_t u16_nwk_key_len)
-{
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-    const uint16_t max_payload_size = 22;
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-        if (p_nwk_key == NULL)
-        {
-            TRACE_INFO("Please provide a valid network key\n");
-            return_status = API_PROCESSOR_INVALID_PARAMETERS;
-            break;
-        }
-
-        if (16 != u16_nwk_key_len)
-        {
-            TRACE_INFO("Network key length must be 16 bytes\n");
-            return_status = API_PROCESSOR_INVALID_PARAMETERS;
-            break;
-        }
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_LORAWAN;
-        mcm_module->u8_send_payload[1] = MROVER_CC_SET_NW_KEY >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_SET_NW_KEY & 0xFF;
-        mcm_module->u8_send_payload[3] = 0x00;
-        mcm_module->u8_send_payload[4] = u16_nwk_key_len;
-        memcpy(&mcm_module->u8_send_payload[5], p_nwk_key, u16_nwk_key_len);
-
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
-
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
-    } while (0);
-
-    return return_status;
-}
-
-
-api_processor_status_t api_processor_cmd_get_dev_eui(mcm_module_hdl_t *mcm_module)
+/**
+ * @brief Builds a command frame in place in the send buffer and sends it.
+ *
+ * The frame is [type][code][length][prefix][data][crc], the header fields come from the
+ * command descriptor table. Only the bytes of the frame are written, the rest of the
+ * send buffer is left untouched.
+ *
+ * @param[in] mcm_module Pointer to the MCM module structure.
+ * @param[in] cmd_id Index of the command in the descriptor table.
+ * @param[in] p_prefix Fixed payload bytes sent before the data (port, uplink type), NULL if none.
+ * @param[in] u8_prefix_len Number of prefix bytes.
+ * @param[in] p_data Pointer to the user data, NULL if none.
+ * @param[in] u16_data_len Number of data bytes.
+ *
+ * @return API_PROCESSOR_SUCCESS if the frame was sent,
+ *         API_PROCESSOR_INVALID_PARAMETERS if the payload does not match the descriptor,
+ *         API_PROCESSOR_SERIAL_PORT_ERROR if the serial port did not take the whole frame,
+ *         API_PROCESSOR_ERROR otherwise.
+ */
+static api_processor_status_t api_processor_send_cmd(mcm_module_hdl_t *mcm_module, api_processor_cmd_id_t cmd_id,
+                                                     const uint8_t *p_prefix, uint8_t u8_prefix_len,
+                                                     const uint8_t *p_data, uint16_t u16_data_len)
 {
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
-    const uint16_t max_payload_size = 6;
 
     do
     {
         if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
         {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_LORAWAN;
-        mcm_module->u8_send_payload[1] = MROVER_CC_GET_DEV_EUI >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_GET_DEV_EUI & 0xFF;
-        mcm_module->u8_send_payload[3] = 0;
-        mcm_module->u8_send_payload[4] = 0;
-        mcm_module->u8_send_payload[5] = 0;
-
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
+            TRACE_ERROR("MCM module is not initialized\n");
             break;
         }
 
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
+        if ((API_CMD_NONE == cmd_id) || (API_CMD_MAX <= cmd_id))
         {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
+            TRACE_ERROR("Unknown command id %d\n", cmd_id);
             break;
         }
-        return_status = API_PROCESSOR_SUCCESS;
-
-    } while (0);
-
-    return return_status;
-}
 
-api_processor_status_t api_processor_cmd_get_join_eui(mcm_module_hdl_t *mcm_module)
-{
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-    const uint16_t max_payload_size = 6;
+        const api_processor_cmd_desc_t *p_desc = &s_cmd_desc_table[cmd_id];
+        const uint32_t u32_payload_len = (uint32_t)u8_prefix_len + u16_data_len;
 
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
+        if (((NULL == p_prefix) && (0 != u8_prefix_len)) || ((NULL == p_data) && (0 != u16_data_len)) ||
+            (p_desc->u16_min_len > u32_payload_len) || (p_desc->u16_max_len < u32_payload_len))
         {
-            TRACE_INFO("MCM module is not initialized\n");
+            TRACE_ERROR("Invalid payload for command 0x%04X, length: %lu\n", p_desc->u16_cmd_code, (unsigned long)u32_payload_len);
+            return_status = API_PROCESSOR_INVALID_PARAMETERS;
             break;
         }
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
 
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_LORAWAN;
-        mcm_module->u8_send_payload[1] = MROVER_CC_GET_JOIN_EUI >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_GET_JOIN_EUI & 0xFF;
-        mcm_module->u8_send_payload[3] = 0;
-        mcm_module->u8_send_payload[4] = 0;
-        mcm_module->u8_send_payload[5] = 0;
-
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
+        if ((API_PROCESSOR_SEND_HEADER_SIZE - COMMAND_HEADER_LEN) < u8_prefix_len)
         {
-            TRACE_INFO("Failed to append crc\n");
+            TRACE_ERROR("Prefix too long for command 0x%04X\n", p_desc->u16_cmd_code);
+            return_status = API_PROCESSOR_INVALID_PARAMETERS;
             break;
         }
 
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
+        // only the header and the prefix are staged, the user payload is sent from the caller buffer
+        uint8_t *p_header = mcm_module->u8_send_header;
+        p_header[0] = p_desc->u8_cmd_type;
+        p_header[1] = p_desc->u16_cmd_code >> 8;
+        p_header[2] = p_desc->u16_cmd_code & 0xFF;
+        p_header[3] = u32_payload_len >> 8;
+        p_header[4] = u32_payload_len & 0xFF;
+        if (0 != u8_prefix_len)
         {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
+            memcpy(&p_header[COMMAND_HEADER_LEN], p_prefix, u8_prefix_len);
         }
-        return_status = API_PROCESSOR_SUCCESS;
-
-    } while (0);
-
-    return return_status;
-}
-
-api_processor_status_t api_processor_cmd_join_lorawan(mcm_module_hdl_t *mcm_module)
-{
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-    const uint16_t max_payload_size = 6;
+        const uint16_t u16_header_len = COMMAND_HEADER_LEN + u8_prefix_len;
 
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
+        // the validators only look at the start of the payload, the prefix when the command has one
+        const uint8_t *p_payload_start = (0 != u8_prefix_len) ? &p_header[COMMAND_HEADER_LEN] : p_data;
+        if ((NULL != p_desc->validator) && !p_desc->validator(p_payload_start))
         {
-            TRACE_INFO("MCM module is not initialized\n");
+            return_status = API_PROCESSOR_INVALID_PARAMETERS;
             break;
         }
 
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_LORAWAN;
-        mcm_module->u8_send_payload[1] = MROVER_CC_JOIN_LORAWAN >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_JOIN_LORAWAN & 0xFF;
-        mcm_module->u8_send_payload[3] = 0;
-        mcm_module->u8_send_payload[4] = 0;
-        mcm_module->u8_send_payload[5] = 0;
+        const uint16_t u16_frame_len = MIN_TX_PAYLOAD_LEN + (uint16_t)u32_payload_len;
 
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
+        // send the data to the module for sending
+        uint16_t u16_sent_bytes;
+        if (NULL != mcm_module->h_serial_device.send_vector_cb)
         {
-            TRACE_INFO("Failed to append crc\n");
-            break;
+            // the CRC is chained over the segments, it equals the one of the contiguous frame
+            mcm_module->u8_send_crc = fp_update_crc(fp_update_crc(0, p_header, u16_header_len), p_data, u16_data_len);
+            const serial_tx_segment_t h_segments[API_PROCESSOR_TX_SEGMENT_COUNT] =
+            {
+                { p_header,                  u16_header_len },
+                { p_data,                    u16_data_len },
+                { &mcm_module->u8_send_crc,  1 },
+            };
+            u16_sent_bytes = mcm_module->h_serial_device.send_vector_cb(h_segments, API_PROCESSOR_TX_SEGMENT_COUNT, mcm_module->user_context);
         }
-
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
+        else
+        {
+            // the contiguous callback gets a frame assembled for the duration of the call
+            uint8_t u8_frame[MAX_SERIAL_SEND_PAYLOAD_SIZE];
+            memcpy(u8_frame, p_header, u16_header_len);
+            if (0 != u16_data_len)
+            {
+                memcpy(&u8_frame[u16_header_len], p_data, u16_data_len);
+            }
+            mcm_module->u8_send_crc = fp_update_crc(0, u8_frame, u16_frame_len - 1);
+            u8_frame[u16_frame_len - 1] = mcm_module->u8_send_crc;
+            u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(u8_frame, u16_frame_len, mcm_module->user_context);
+        }
+        if (u16_frame_len != u16_sent_bytes)
         {
-            TRACE_INFO("Failed to send data through serial port\n");
+            TRACE_ERROR("Failed to send data through serial port\n");
             return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
             break;
         }
         return_status = API_PROCESSOR_SUCCESS;
-
     } while (0);
 
     return return_status;
 }
 
 /**
- * @brief 'Request Uplink' command requests sending the given data on the specified port as an
-        unconfirmed or confirmed frame. The payload of the request uplink specifies the confirmed or
-        unconfirmed frame as below -
-        a. MROVER_UPLINK_UNCONFIRMED - unconfirmed data
-        b. MROVER_UPLINK_CONFIRMED - confirmed data
- * @note 1. The application shall not use port 0 or the ports from 225 to 255 since they are reserved
-            for future standardized application extensions.
- * @param mcm_module MCM module handle
- * @param u8_port Port number on which data needs to be sent
- * @param u8_payload Pointer to the payload to be sent
- * @param u16_payload_size Length of the payload to be sent
- * @param h_uplink_type Type of the uplink frame - unconfirmed or confirmed
- * @return API_PROCESSOR_SUCCESS on success, API_PROCESSOR_ERROR on error.
+ * @brief Returns the name of a received command code, used in the traces.
+ *
+ * @param[in] u16_cmd_code Command code of the response.
+ *
+ * @return Name of the command, "Unknown" for unknown codes.
  */
-api_processor_status_t api_processor_cmd_request_lorawan_uplink(mcm_module_hdl_t *mcm_module,uint8_t u8_port,uint8_t *u8_payload,uint16_t u16_payload_size,mrover_uplink_type_t h_uplink_type)
+static const char *api_processor_get_cmd_name(uint16_t u16_cmd_code)
 {
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-
-    //validation the input data 
-    do
+    if ((MROVER_CC_TABLE_SIZE <= u16_cmd_code) || (API_CMD_NONE == s_cmd_code_to_id[u16_cmd_code]))
     {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-
-        if(LORAWAN_TX_MAX_PAYLOAD_SIZE < u16_payload_size)
-        {
-            TRACE_INFO("Data payload cannot be exceeded more than 255 bytes\n");
-            return_status = API_PROCESSOR_INVALID_PARAMETERS;
-            break;
-        }
-
-        // The application shall not use port 0 or the ports from 225 to 255 since they are reserved
-        //for future standardized application extensions
-        if((0 == u8_port) || (225 <= u8_port))
-        {
-            TRACE_INFO("Please provide a valid port number\n");
-            return_status = API_PROCESSOR_INVALID_PARAMETERS;
-            break;
-        }
+        return "Unknown";
+    }
 
-        if((NULL != u8_payload) && (0 == u16_payload_size)) // if data is present but size is zero
-        {
-            TRACE_INFO("Please provide a valid payload\n");
-            return_status = API_PROCESSOR_INVALID_PARAMETERS;
-            break;
-        }
+    return s_rsp_parser_table[s_cmd_code_to_id[u16_cmd_code]].name;
+}
 
-        if((NULL == u8_payload) && (0 != u16_payload_size)) // if data is not present but size is not zero
-        {
-            TRACE_INFO("Please provide a valid payload\n");
-            return_status = API_PROCESSOR_INVALID_PARAMETERS;
-            break;
-        }
 
-        if(MROVER_CONFIRMED_UPLINK < h_uplink_type)
-        {
-            TRACE_INFO("Please provide a valid uplink type\n");
-            return_status = API_PROCESSOR_INVALID_PARAMETERS;
-            break;
-        }
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
 
-        uint16_t u16_payload_len = u16_payload_size + 2; // 1 bytes for port number and 1 byte for uplink type
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_LORAWAN;
-        mcm_module->u8_send_payload[1] = MROVER_CC_REQUEST_UPLINK >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_REQUEST_UPLINK & 0xFF;
-        mcm_module->u8_send_payload[3] = u16_payload_len >> 8;
-        mcm_module->u8_send_payload[4] = u16_payload_len & 0xFF;
-        mcm_module->u8_send_payload[5] = u8_port;
-        mcm_module->u8_send_payload[6] = h_uplink_type;
-        memcpy(&mcm_module->u8_send_payload[7],u8_payload,u16_payload_size);
-
-        const uint16_t max_payload_size = MIN_TX_PAYLOAD_LEN + u16_payload_len;
-
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
 
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
+/*******************************************************************************
+* Helper Functions
+********************************************************************************/
 
-    } while (0);
-    
-    return return_status;
+inline mrover_return_code_t mcm_helper_get_response_code(const api_processor_response_t *res)
+{
+    return res->return_code;
 }
 
-
-api_processor_status_t api_processor_cmd_leave_lorawan_network(mcm_module_hdl_t* mcm_module)
+inline command_types_t mcm_helper_get_command_type(const api_processor_response_t *res)
 {
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-     const uint16_t max_payload_size = MIN_TX_PAYLOAD_LEN;
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_LORAWAN;
-        mcm_module->u8_send_payload[1] = MROVER_CC_LEAVE_LORAWAN_NETWORK >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_LEAVE_LORAWAN_NETWORK & 0xFF;
-        mcm_module->u8_send_payload[3] = 0;
-        mcm_module->u8_send_payload[4] = 0;
-        mcm_module->u8_send_payload[5] = 0;
-
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
-
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
-    } while (0);
-
-    return return_status;
+    return res->cmd_type;
 }
 
-api_processor_status_t api_processor_cmd_stop_lorawan_network(mcm_module_hdl_t* mcm_module)
+inline mrover_cc_codes_t mcm_helper_get_command_code(const api_processor_response_t *res)
 {
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-    const uint16_t max_payload_size = MIN_TX_PAYLOAD_LEN + 1; // extra byte for the payload
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_LORAWAN;
-        mcm_module->u8_send_payload[1] = MROVER_CC_STOP_SID_LORAWAN_NETWORK >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_STOP_SID_LORAWAN_NETWORK & 0xFF;
-        mcm_module->u8_send_payload[3] = 0;
-        mcm_module->u8_send_payload[4] = 0x01;
-        mcm_module->u8_send_payload[5] = 0x01;
-
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
-
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
-    } while (0);
-
-    return return_status;
+    return res->cmd_code;
 }
 
-
-api_processor_status_t api_processor_cmd_sid_ble_link_request(mcm_module_hdl_t* mcm_module)
+inline const uint8_t* mcm_helper_get_dev_eui(const api_processor_response_t *res)
 {
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-    const uint16_t max_payload_size = MIN_TX_PAYLOAD_LEN; // extra byte for the payload
-
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_SIDEWALK;
-        mcm_module->u8_send_payload[1] = MROVER_CC_BLE_LINK_REQUEST >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_BLE_LINK_REQUEST & 0xFF;
-        mcm_module->u8_send_payload[3] = 0;
-        mcm_module->u8_send_payload[4] = 0;
-        mcm_module->u8_send_payload[5] = 0;
-
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
+    return res->cmd_response_data.dev_eui;
+}
 
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
-    } while (0);
+inline const uint8_t* mcm_helper_get_join_eui(const api_processor_response_t *res)
+{
+   return res->cmd_response_data.join_eui;
+}
 
-    return return_status;
+inline mrover_lorawan_class_t mcm_helper_get_device_class(const api_processor_response_t *res)
+{
+    return res->cmd_response_data.get_event_data.get_event_data_value.class_switch_data.new_class;
 }
 
+inline uint16_t mcm_helper_get_next_uplink_mtu(const api_processor_response_t *res) {
+    return res->cmd_response_data.next_uplink_mtu;
+}
 
-api_processor_status_t api_processor_cmd_sid_ble_conn_request(mcm_module_hdl_t* mcm_module)
+void mcm_helper_get_version(const api_processor_response_t *res,ver_type_2_t *bootloader,ver_type_2_t* mdm_fw,\
+                            ver_type_1_t *mdm_hw,ver_type_1_t *sidwlk,ver_type_1_t *lrwan)
 {
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-    const uint16_t max_payload_size = MIN_TX_PAYLOAD_LEN; // extra byte for the payload
+    *bootloader = res->cmd_response_data.ver_info.bootloader;
+    *mdm_fw = res->cmd_response_data.ver_info.modem_fw;
+    *mdm_hw = res->cmd_response_data.ver_info.modem_hw;
+    *sidwlk = res->cmd_response_data.ver_info.sidewalk;
+    *lrwan = res->cmd_response_data.ver_info.lorawan;
+}
 
-    do
+void mcm_helper_get_downlink_data(const api_processor_response_t *res,int8_t *rssi,int8_t *snr,uint8_t *payload,uint16_t *port_seq)
+{
+    *rssi = res->cmd_response_data.get_event_data.get_event_data_value.down_data.rssi;
+    *snr = res->cmd_response_data.get_event_data.get_event_data_value.down_data.snr;
+    *port_seq = res->cmd_response_data.get_event_data.get_event_data_value.down_data.lrwan_sid_seq_port;
+    if(NULL != payload)
     {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_SIDEWALK;
-        mcm_module->u8_send_payload[1] = MROVER_CC_BLE_CONNECTION_REQUEST >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_BLE_CONNECTION_REQUEST & 0xFF;
-        mcm_module->u8_send_payload[3] = 0;
-        mcm_module->u8_send_payload[4] = 0;
-        mcm_module->u8_send_payload[5] = 0;
-
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
-
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
-    } while (0);
+        memcpy(payload,res->cmd_response_data.get_event_data.get_event_data_value.down_data.payload,res->cmd_response_data.get_event_data.get_event_data_value.down_data.payload_len);   
+    }
+}
 
-    return return_status;
+inline uint16_t mcm_helper_get_downlink_len(const api_processor_response_t *res)
+{
+    return res->cmd_response_data.get_event_data.get_event_data_value.down_data.payload_len;
+}
+
+inline uint8_t mcm_helper_get_event_reset_count(const api_processor_response_t *res)
+{
+    return res->cmd_response_data.get_event_data.get_event_data_value.reset_data.reset_count;
 }
 
 
-api_processor_status_t api_processor_cmd_sid_fsk_link_request(mcm_module_hdl_t* mcm_module)
+inline get_event_code_t mcm_helper_get_event_code(const api_processor_response_t *res)
 {
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-    const uint16_t max_payload_size = MIN_TX_PAYLOAD_LEN; // extra byte for the payload
+    return res->cmd_response_data.get_event_data.get_event_code;
+}
 
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_SIDEWALK;
-        mcm_module->u8_send_payload[1] = MROVER_CC_FSK_LINK_REQUEST >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_FSK_LINK_REQUEST & 0xFF;
-        mcm_module->u8_send_payload[3] = 0;
-        mcm_module->u8_send_payload[4] = 0;
-        mcm_module->u8_send_payload[5] = 0;
-
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
+inline mrover_uplink_event_type_t mcm_helper_get_event_tx_status(const api_processor_response_t *res)
+{
+    return res->cmd_response_data.get_event_data.get_event_data_value.tx_status_data.tx_status;
+}
 
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
-    } while (0);
+inline mrover_lorawan_class_t mcm_helper_get_event_new_class(const api_processor_response_t *res)
+{
+    return res->cmd_response_data.get_event_data.get_event_data_value.class_switch_data.new_class;
+}
 
-    return return_status;
+inline get_seg_file_status_t mcm_helper_get_event_seg_down(const api_processor_response_t *res)
+{
+    return res->cmd_response_data.get_event_data.get_event_data_value.download_segment_data;
 }
 
-api_processor_status_t api_processor_cmd_sid_css_link_request(mcm_module_hdl_t* mcm_module)
+void mcm_helper_get_seg_file_status(const api_processor_response_t *res, get_seg_file_status_t *seg_file_status)
 {
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-    const uint16_t max_payload_size = MIN_TX_PAYLOAD_LEN; // extra byte for the payload
+    *seg_file_status = res->cmd_response_data.seg_file_status;
+}
 
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_SIDEWALK;
-        mcm_module->u8_send_payload[1] = MROVER_CC_CSS_LINK_REQUEST >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_CSS_LINK_REQUEST & 0xFF;
-        mcm_module->u8_send_payload[3] = 0;
-        mcm_module->u8_send_payload[4] = 0;
-        mcm_module->u8_send_payload[5] = 0;
-
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
+uint32_t mcm_helper_get_gps_time(const api_processor_response_t *res)
+{
+    return res->cmd_response_data.gps_timestamp;
+}
 
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
-    } while (0);
+mrover_lorawan_mac_event_t mcm_helper_get_mac_time_event(const api_processor_response_t *res)
+{
+    return res->cmd_response_data.get_event_data.get_event_data_value.mac_time.mac_event;
+}
 
-    return return_status;
+inline uint8_t mcm_helper_get_join_failure_reason(const api_processor_response_t *res)
+{
+    return res->cmd_response_data.get_event_data.get_event_data_value.failure_reason.failure_reason;
 }
 
 
-api_processor_status_t api_processor_cmd_sid_set_css_profile(mcm_module_hdl_t* mcm_module,mrover_css_pwr_profile_t h_profile)
+/******************************************************************************
+ * Function Definitions
+ *******************************************************************************/
+
+api_processor_status_t api_processor_init(mcm_module_hdl_t *mcm_module,serial_send_data_cb send_data_cb,mrover_notification_cb h_mrover_notification_cb,mrover_response_cb h_mrover_response_cb)
 {
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
-    const uint16_t max_payload_size = MIN_TX_PAYLOAD_LEN + 1; // extra byte for the payload
+    
 
     do
     {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
+        if (NULL == mcm_module)
         {
-            TRACE_INFO("MCM module is not initialized\n");
+            TRACE_ERROR("mcm_module is NULL\n");
+            return_status = API_PROCESSOR_INVALID_PARAMETERS;
             break;
         }
 
-        if(MROVER_CC_SET_CSS_PWR_PROFILE < h_profile){
-            TRACE_INFO("Invalid CSS profile\n");
+        if (NULL == send_data_cb)
+        {
+            TRACE_ERROR("Please profile the callback function for serial send data\n");
             return_status = API_PROCESSOR_INVALID_PARAMETERS;
             break;
         }
+        mcm_module->h_serial_device.send_data_cb = send_data_cb;
+        mcm_module->h_serial_device.send_vector_cb = NULL;
+        fp_decoder_init(&mcm_module->h_rx_decoder);
 
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_SIDEWALK;
-        mcm_module->u8_send_payload[1] = MROVER_CC_SET_CSS_PWR_PROFILE >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_SET_CSS_PWR_PROFILE & 0xFF;
-        mcm_module->u8_send_payload[3] = 0;
-        mcm_module->u8_send_payload[4] = 1;
-        mcm_module->u8_send_payload[5] = h_profile;
-
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
+        if(NULL == h_mrover_notification_cb)
         {
-            TRACE_INFO("Failed to append crc\n");
+            TRACE_WARN("Warn, Notification callback not set\n");
             break;
         }
 
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
+        mcm_module->handle_notification_cb = h_mrover_notification_cb;
+        if(NULL == h_mrover_response_cb)
         {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
+            TRACE_ERROR("MCM module response call back handle is not provided\n");
             break;
         }
+
+        mcm_module->handle_response_cb = h_mrover_response_cb;
         return_status = API_PROCESSOR_SUCCESS;
     } while (0);
 
     return return_status;
 }
 
-
-api_processor_status_t api_processor_cmd_sid_send_uplink(mcm_module_hdl_t* mcm_module, uint8_t *u8_payload, uint16_t u16_payload_size, mrover_uplink_type_t h_uplink_type)
+api_processor_status_t api_processor_set_send_vector_cb(mcm_module_hdl_t *mcm_module, serial_send_vector_cb send_vector_cb)
 {
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-
-    do
+    if (NULL == mcm_module)
     {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
+        TRACE_ERROR("mcm_module is NULL\n");
+        return API_PROCESSOR_INVALID_PARAMETERS;
+    }
 
-        // Validate payload size based on link type
-        if (SIDEWALK_TX_MAX_BLE_PAYLOAD_SIZE < u16_payload_size)
-        {
-            TRACE_INFO("Data payload cannot be exceed more than 255 bytes\n");
-            return_status = API_PROCESSOR_INVALID_PARAMETERS;
-            break;
-        }
+    mcm_module->h_serial_device.send_vector_cb = send_vector_cb;
+    return API_PROCESSOR_SUCCESS;
+}
 
-        if((NULL == u8_payload) || (0 == u16_payload_size))
-        {
-            TRACE_INFO("Data payload cannot be empty\n");
-            return_status = API_PROCESSOR_INVALID_PARAMETERS;
-            break;
-        }
 
-        if(MROVER_CONFIRMED_UPLINK < h_uplink_type)
-        {
-            TRACE_INFO("Please provide a valid uplink type\n");
-            return_status = API_PROCESSOR_INVALID_PARAMETERS;
-            break;
-        }
+void api_processor_reset_rx(mcm_module_hdl_t *mcm_module)
+{
+    if (NULL != mcm_module)
+    {
+        fp_decoder_init(&mcm_module->h_rx_decoder);
+    }
+}
 
-        uint16_t u16_payload_len = u16_payload_size + 1; // 1 byte for uplink type
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_SIDEWALK;
-        mcm_module->u8_send_payload[1] = MROVER_CC_REQUEST_UPLINK >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_REQUEST_UPLINK & 0xFF;
-        mcm_module->u8_send_payload[3] = u16_payload_len >> 8;
-        mcm_module->u8_send_payload[4] = u16_payload_len & 0xFF;
-        mcm_module->u8_send_payload[5] = h_uplink_type;
-        memcpy(&mcm_module->u8_send_payload[6], u8_payload, u16_payload_size);
 
-        const uint16_t max_payload_size = MIN_TX_PAYLOAD_LEN + u16_payload_len;
 
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
+void api_processor_get_lib_ver(ver_type_1_t *ver) {
+    if (ver != NULL) 
+    {
+        ver->major = API_PROCESSOR_LIB_MAJOR_VERSION; // Set major version
+        ver->minor = API_PROCESSOR_LIB_MINOR_VERSION; // Set minor version
+        ver->patch = API_PROCESSOR_LIB_PATCH_VERSION; // Set patch version
+    }
+}
 
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
 
-    } while (0);
-    
-    return return_status;
+api_processor_status_t api_processor_cmd_get_event(mcm_module_hdl_t *mcm_module)
+{
+    return api_processor_send_cmd(mcm_module, API_CMD_GET_EVENT, NULL, 0, NULL, 0);
 }
 
 
-api_processor_status_t api_processor_cmd_set_sid_downlink_filter(mcm_module_hdl_t* mcm_module, mrover_sid_downlink_filter_t h_filtering)
+
+api_processor_status_t api_processor_cmd_get_version(mcm_module_hdl_t *mcm_module)
 {
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
+    return api_processor_send_cmd(mcm_module, API_CMD_GET_VERSION, NULL, 0, NULL, 0);
+}
 
-    do
-    {
-         if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
 
-        if(MROVER_SID_DISABLE_FILTERING < h_filtering)
-        {
-            TRACE_INFO("Wrong filtering value\n");
-            return_status = API_PROCESSOR_INVALID_PARAMETERS;
-            break; 
-        }
 
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        const uint16_t max_payload_size = MIN_TX_PAYLOAD_LEN + 1; // extra byte for the payload
+api_processor_status_t api_processor_cmd_reset(mcm_module_hdl_t *mcm_module)
+{
+    return api_processor_send_cmd(mcm_module, API_CMD_RESET, NULL, 0, NULL, 0);
+}
 
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_SIDEWALK;
-        mcm_module->u8_send_payload[1] = MROVER_CC_SET_FILTERING_DOWNLINK_SIDEWALK >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_SET_FILTERING_DOWNLINK_SIDEWALK & 0xFF;
-        mcm_module->u8_send_payload[3] = 0x00;
-        mcm_module->u8_send_payload[4] = 0x01;
-        mcm_module->u8_send_payload[5] = h_filtering;
 
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
 
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
+api_processor_status_t api_processor_cmd_factory_reset(mcm_module_hdl_t *mcm_module)
+{
+    return api_processor_send_cmd(mcm_module, API_CMD_FACTORY_RESET, NULL, 0, NULL, 0);
+}
 
-    } while (0);
-    
-    return return_status;
+
+
+api_processor_status_t api_processor_cmd_switch_network(mcm_module_hdl_t *mcm_module)
+{
+    return api_processor_send_cmd(mcm_module, API_CMD_SWITCH_NETWORK, NULL, 0, NULL, 0);
 }
 
 
-api_processor_status_t api_processor_cmd_sid_stop(mcm_module_hdl_t* mcm_module)
+
+api_processor_status_t api_processor_cmd_init_lorawan(mcm_module_hdl_t *mcm_module)
 {
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
+    return api_processor_send_cmd(mcm_module, API_CMD_INIT_LORAWAN, NULL, 0, NULL, 0);
+}
 
-     do
-    {
-         if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
 
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        const uint16_t max_payload_size = MIN_TX_PAYLOAD_LEN + 1; // extra byte for the payload
 
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_SIDEWALK;
-        mcm_module->u8_send_payload[1] = MROVER_CC_STOP_SID_LORAWAN_NETWORK >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_STOP_SID_LORAWAN_NETWORK & 0xFF;
-        mcm_module->u8_send_payload[3] = 0x00;
-        mcm_module->u8_send_payload[4] = 0x01;
-        mcm_module->u8_send_payload[5] = SIDEWALK_STOP_DATA_PAYLOAD;
+api_processor_status_t api_processor_cmd_set_join_eui(mcm_module_hdl_t *mcm_module, uint8_t *p_join_eui, uint8_t u8_join_eui_len)
+{
+    return api_processor_send_cmd(mcm_module, API_CMD_SET_JOIN_EUI, NULL, 0, p_join_eui, u8_join_eui_len);
+}
 
-        // send the payload to the frame parser for crc check and other validation
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
 
-        // send the data to the module for sending
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size,mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
 
-    } while (0);
-    
-    return return_status;
+api_processor_status_t api_processor_cmd_set_dev_eui(mcm_module_hdl_t *mcm_module, uint8_t *p_dev_eui, uint8_t u8_dev_eui_len)
+{
+    return api_processor_send_cmd(mcm_module, API_CMD_SET_DEV_EUI, NULL, 0, p_dev_eui, u8_dev_eui_len);
+}
 
+
+
+api_processor_status_t api_processor_cmd_set_nwk_key(mcm_module_hdl_t *mcm_module, uint8_t *p_nwk_key, uint16_t u16_nwk_key_len)
+{
+    return api_processor_send_cmd(mcm_module, API_CMD_SET_NWK_KEY, NULL, 0, p_nwk_key, u16_nwk_key_len);
 }
 
-//TODO Oxit: Paresh: Rename file to something more relevant
 
-api_processor_status_t api_processor_parse_rx_data(mcm_module_hdl_t *mcm_module,uint8_t* data,uint16_t len)
-{   
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-    TRACE_INFO("Parsing RX data: length = %d\n", len); // Debug print for data length
 
-    // TODO: currently we are only handling for 2 concurrent frame, can be done for the multiple frame also 
-    // check if frame is single or multiple
-    if(fp_is_single_frame(data,len))
-    {
-        TRACE_INFO("Single frame detected\n"); // Debug print for single frame
-       return_status = api_processor_parse_single_frame(mcm_module,data,len);
-    }
-    else
-    {
-        TRACE_INFO("Multiple frame detected\n"); // Debug print for multiple frame
-        // if frame is notification, then just parse first MIN_RX_PAYLOAD_LEN, as notification, rest as the response
-        if(MROVER_RC_NOTIFY_EVENTS == data[0])
-        {   
-            TRACE_INFO("Notification frame detected\n"); // Debug print for notification
-            // parser for notification
-            return_status = api_processor_parse_single_frame(mcm_module,data,MIN_RX_PAYLOAD_LEN);
+api_processor_status_t api_processor_cmd_get_dev_eui(mcm_module_hdl_t *mcm_module)
+{
+    return api_processor_send_cmd(mcm_module, API_CMD_GET_DEV_EUI, NULL, 0, NULL, 0);
+}
 
-            if((len-MIN_RX_PAYLOAD_LEN) > MIN_RX_PAYLOAD_LEN) // if response is available
-            {
-                TRACE_INFO("Parsing response frame\n"); // Debug print for response
-                // parser for response
-               return_status = api_processor_parse_single_frame(mcm_module, data + MIN_RX_PAYLOAD_LEN, len - MIN_RX_PAYLOAD_LEN);
-            }
-        }
-        else
-        {
-            TRACE_INFO("Response frame detected\n"); // Debug print for response frame
-            // response frame first
-            return_status = api_processor_parse_single_frame(mcm_module,data,(len-MIN_RX_PAYLOAD_LEN));
 
-            if((len-MIN_RX_PAYLOAD_LEN) >= MIN_RX_PAYLOAD_LEN)
-            {
-                TRACE_INFO("Parsing notification after response\n"); // Debug print for notification after response
-                // then notification
-                data = data + (len-MIN_RX_PAYLOAD_LEN); // move the data pointer to the start of the notification
-               return_status = api_processor_parse_single_frame(mcm_module, data, MIN_RX_PAYLOAD_LEN);
-            }
-        }
-    }
-    TRACE_INFO("Finished parsing RX data with status: %d\n", return_status); // Debug print for return status
-    return return_status;
+api_processor_status_t api_processor_cmd_get_join_eui(mcm_module_hdl_t *mcm_module)
+{
+    return api_processor_send_cmd(mcm_module, API_CMD_GET_JOIN_EUI, NULL, 0, NULL, 0);
 }
 
 
-inline uint8_t api_processor_get_pending_events(mcm_module_hdl_t *mcm_module)
+api_processor_status_t api_processor_cmd_join_lorawan(mcm_module_hdl_t *mcm_module)
 {
-    return mcm_module->_no_of_curr_pen_evt;
+    return api_processor_send_cmd(mcm_module, API_CMD_JOIN_LORAWAN, NULL, 0, NULL, 0);
 }
 
-api_processor_status_t api_processor_cmd_set_lorawan_class(mcm_module_hdl_t *mcm_module, 
-                                                           mrover_lorawan_class_t lorawan_class)
+
+/**
+ * @brief 'Request Uplink' command requests sending the given data on the specified port as an
+        unconfirmed or confirmed frame. The payload of the request uplink specifies the confirmed or
+        unconfirmed frame as below -
+        a. MROVER_UPLINK_UNCONFIRMED - unconfirmed data
+        b. MROVER_UPLINK_CONFIRMED - confirmed data
+ * @note 1. The application shall not use port 0 or the ports from 225 to 255 since they are reserved
+            for future standardized application extensions.
+ * @param mcm_module MCM module handle
+ * @param u8_port Port number on which data needs to be sent
+ * @param u8_payload Pointer to the payload to be sent
+ * @param u16_payload_size Length of the payload to be sent
+ * @param h_uplink_type Type of the uplink frame - unconfirmed or confirmed
+ * @return API_PROCESSOR_SUCCESS on success, API_PROCESSOR_ERROR on error.
+ */
+api_processor_status_t api_processor_cmd_request_lorawan_uplink(mcm_module_hdl_t *mcm_module,uint8_t u8_port,uint8_t *u8_payload,uint16_t u16_payload_size,mrover_uplink_type_t h_uplink_type)
 {
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
+    api_processor_status_t return_status = API_PROCESSOR_INVALID_PARAMETERS;
 
     do
     {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-
-        // Clear the payload buffer
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        const uint16_t max_payload_size = MIN_TX_PAYLOAD_LEN + 1; // 1 byte for class payload
-
-        // Construct the payload
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_LORAWAN;                  // Command type
-        mcm_module->u8_send_payload[1] = MROVER_CC_SET_LORAWAN_CLASS >> 8;     // Command code MSB
-        mcm_module->u8_send_payload[2] = MROVER_CC_SET_LORAWAN_CLASS & 0xFF;   // Command code LSB
-        mcm_module->u8_send_payload[3] = 0x00;                                 
-        mcm_module->u8_send_payload[4] = 0x01;                                 
-        mcm_module->u8_send_payload[5] = (uint8_t)lorawan_class;               // LoRaWAN class
-
-        // Append CRC
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
+        if(LORAWAN_TX_MAX_FRAME_PAYLOAD_SIZE < u16_payload_size)
         {
-            TRACE_INFO("Failed to append CRC\n");
+            TRACE_ERROR("Data payload cannot exceed %d bytes\n", LORAWAN_TX_MAX_FRAME_PAYLOAD_SIZE);
             break;
         }
 
-        // Send the payload
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(
-            mcm_module->u8_send_payload, max_payload_size, mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
+        if((NULL != u8_payload) && (0 == u16_payload_size)) // if data is present but size is zero
         {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
+            TRACE_ERROR("Please provide a valid payload\n");
             break;
         }
 
-        return_status = API_PROCESSOR_SUCCESS;
-
+        const uint8_t u8_prefix[] = { u8_port, (uint8_t)h_uplink_type };
+        return_status = api_processor_send_cmd(mcm_module, API_CMD_LORAWAN_REQUEST_UPLINK, u8_prefix, sizeof(u8_prefix),
+                                               u8_payload, u16_payload_size);
     } while (0);
 
     return return_status;
 }
 
-api_processor_status_t api_processor_cmd_get_lorawan_class(mcm_module_hdl_t *mcm_module)
+
+
+api_processor_status_t api_processor_cmd_leave_lorawan_network(mcm_module_hdl_t* mcm_module)
 {
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
+    return api_processor_send_cmd(mcm_module, API_CMD_LEAVE_LORAWAN_NETWORK, NULL, 0, NULL, 0);
+}
 
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
 
-        // Clear the payload buffer
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        const uint16_t max_payload_size = MIN_TX_PAYLOAD_LEN;
+api_processor_status_t api_processor_cmd_stop_lorawan_network(mcm_module_hdl_t* mcm_module)
+{
+    const uint8_t u8_stop = 0x01;
+    return api_processor_send_cmd(mcm_module, API_CMD_STOP_LORAWAN_NETWORK, NULL, 0, &u8_stop, sizeof(u8_stop));
+}
 
-        // Construct the payload
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_LORAWAN;                  // Command type
-        mcm_module->u8_send_payload[1] = MROVER_CC_GET_LORAWAN_CLASS >> 8;     // Command code MSB
-        mcm_module->u8_send_payload[2] = MROVER_CC_GET_LORAWAN_CLASS & 0xFF;   // Command code LSB
-        mcm_module->u8_send_payload[3] = 0x00;                                 // Reserved
-        mcm_module->u8_send_payload[4] = 0x00;                                 // Payload length
-        mcm_module->u8_send_payload[5] = 0x00;                                 // Placeholder for optional data
 
-        // Append CRC
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append CRC\n");
-            break;
-        }
 
-        // Send the payload
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(
-            mcm_module->u8_send_payload, max_payload_size, mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
+api_processor_status_t api_processor_cmd_sid_ble_link_request(mcm_module_hdl_t* mcm_module)
+{
+    return api_processor_send_cmd(mcm_module, API_CMD_SID_BLE_LINK_REQUEST, NULL, 0, NULL, 0);
+}
 
-        return_status = API_PROCESSOR_SUCCESS;
 
-    } while (0);
 
-    return return_status;
+api_processor_status_t api_processor_cmd_sid_ble_conn_request(mcm_module_hdl_t* mcm_module)
+{
+    return api_processor_send_cmd(mcm_module, API_CMD_SID_BLE_CONN_REQUEST, NULL, 0, NULL, 0);
 }
 
-api_processor_status_t api_processor_cmd_start_file_transfer(mcm_module_hdl_t *mcm_module,ver_type_1_t version)
+
+
+api_processor_status_t api_processor_cmd_sid_fsk_link_request(mcm_module_hdl_t* mcm_module)
 {
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
+    return api_processor_send_cmd(mcm_module, API_CMD_SID_FSK_LINK_REQUEST, NULL, 0, NULL, 0);
+}
 
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
 
-        // Clear the payload buffer
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        const uint16_t max_payload_size = MIN_TX_PAYLOAD_LEN + sizeof(ver_type_1_t);
-
-        // Construct the payload
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_GENERAL;                  // Command type
-        mcm_module->u8_send_payload[1] = MROVER_CC_START_FILE_TRANSFER >> 8;     // Command code MSB
-        mcm_module->u8_send_payload[2] = MROVER_CC_START_FILE_TRANSFER & 0xFF;   // Command code LSB
-        mcm_module->u8_send_payload[3] = 0x00;                                 // Reserved
-        mcm_module->u8_send_payload[4] = sizeof(ver_type_1_t);                 // Payload length
-        mcm_module->u8_send_payload[5] = version.major;                      
-        mcm_module->u8_send_payload[6] = version.minor;
-        mcm_module->u8_send_payload[7] = version.patch;
-
-        // Append CRC
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append CRC\n");
-            break;
-        }
+api_processor_status_t api_processor_cmd_sid_css_link_request(mcm_module_hdl_t* mcm_module)
+{
+    return api_processor_send_cmd(mcm_module, API_CMD_SID_CSS_LINK_REQUEST, NULL, 0, NULL, 0);
+}
 
-        // Send the payload
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(
-            mcm_module->u8_send_payload, max_payload_size, mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
 
-        return_status = API_PROCESSOR_SUCCESS;
+
+api_processor_status_t api_processor_cmd_sid_set_css_profile(mcm_module_hdl_t* mcm_module,mrover_css_pwr_profile_t h_profile)
+{
+    const uint8_t u8_profile = (uint8_t)h_profile;
+    return api_processor_send_cmd(mcm_module, API_CMD_SID_SET_CSS_PROFILE, NULL, 0, &u8_profile, sizeof(u8_profile));
+}
 
 
-    } while (0);
 
-    return return_status;
+api_processor_status_t api_processor_cmd_sid_send_uplink(mcm_module_hdl_t* mcm_module, uint8_t *u8_payload, uint16_t u16_payload_size, mrover_uplink_type_t h_uplink_type)
+{
+    if((NULL == u8_payload) || (0 == u16_payload_size))
+    {
+        TRACE_ERROR("Data payload cannot be empty\n");
+        return API_PROCESSOR_INVALID_PARAMETERS;
+    }
+
+    const uint8_t u8_prefix = (uint8_t)h_uplink_type;
+    return api_processor_send_cmd(mcm_module, API_CMD_SID_REQUEST_UPLINK, &u8_prefix, sizeof(u8_prefix),
+                                  u8_payload, u16_payload_size);
 }
 
-api_processor_status_t api_processor_cmd_get_seg_file_transfer_status(mcm_module_hdl_t *mcm_module)
+
+
+api_processor_status_t api_processor_cmd_set_sid_downlink_filter(mcm_module_hdl_t* mcm_module, mrover_sid_downlink_filter_t h_filtering)
+{
+    const uint8_t u8_filtering = (uint8_t)h_filtering;
+    return api_processor_send_cmd(mcm_module, API_CMD_SID_SET_DOWNLINK_FILTER, NULL, 0, &u8_filtering, sizeof(u8_filtering));
+}
+
+
+
+api_processor_status_t api_processor_cmd_sid_stop(mcm_module_hdl_t* mcm_module)
 {
+    const uint8_t u8_stop = SIDEWALK_STOP_DATA_PAYLOAD;
+    return api_processor_send_cmd(mcm_module, API_CMD_SID_STOP, NULL, 0, &u8_stop, sizeof(u8_stop));
+}
+
+
+//TODO Oxit: Paresh: Rename file to something more relevant
+
+api_processor_status_t api_processor_parse_rx_data(mcm_module_hdl_t *mcm_module,uint8_t* data,uint16_t len)
+{   
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
+    TRACE_DEBUG("Parsing RX data: length = %d\n", len); // Debug print for data length
 
     do
     {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
+        if (NULL == mcm_module)
         {
-            TRACE_INFO("MCM module is not initialized\n");
+            TRACE_ERROR("MCM module is not initialized\n");
             break;
         }
 
-        // Clear the payload buffer
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        const uint16_t max_payload_size = MIN_TX_PAYLOAD_LEN;
-
-        // Construct the payload
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_GENERAL;                  // Command type
-        mcm_module->u8_send_payload[1] = MROVER_CC_FILE_STATUS >> 8;     // Command code MSB
-        mcm_module->u8_send_payload[2] = MROVER_CC_FILE_STATUS & 0xFF;   // Command code LSB
-        mcm_module->u8_send_payload[3] = 0x00;                                 // Reserved
-        mcm_module->u8_send_payload[4] = 0x00;                 // Payload length
-        mcm_module->u8_send_payload[5] = 0x00;                      
-
-        // Append CRC
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
+        // the decoder calls api_processor_on_rx_frame for every complete frame in the data
+        fp_api_status_t status = fp_decoder_feed(&mcm_module->h_rx_decoder, data, len, api_processor_on_rx_frame, mcm_module);
+        if (FP_INVALID_PARAMETERS == status)
         {
-            TRACE_INFO("Failed to append CRC\n");
+            return_status = API_PROCESSOR_INVALID_PARAMETERS;
             break;
         }
 
-        // Send the payload
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(
-            mcm_module->u8_send_payload, max_payload_size, mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
+        if (FP_SUCCESS != status)
         {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
+            TRACE_ERROR("Corrupted bytes dropped from the received data, status: %d\n", status);
+            return_status = API_PROCESSOR_INVALID_SERIAL_DATA;
             break;
         }
 
         return_status = API_PROCESSOR_SUCCESS;
-
-
     } while (0);
 
+    TRACE_DEBUG("Finished parsing RX data with status: %d\n", return_status); // Debug print for return status
     return return_status;
+}
+
 
+inline uint8_t api_processor_get_pending_events(mcm_module_hdl_t *mcm_module)
+{
+    return mcm_module->_no_of_curr_pen_evt;
 }
 
-api_processor_status_t api_processor_cmd_trigger_fw_update(mcm_module_hdl_t *mcm_module, ver_type_1_t version)
+api_processor_status_t api_processor_cmd_set_lorawan_class(mcm_module_hdl_t *mcm_module, 
+                                                           mrover_lorawan_class_t lorawan_class)
 {
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
+    const uint8_t u8_class = (uint8_t)lorawan_class;
+    return api_processor_send_cmd(mcm_module, API_CMD_SET_LORAWAN_CLASS, NULL, 0, &u8_class, sizeof(u8_class));
+}
 
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
 
-        // Clear the payload buffer
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        const uint16_t max_payload_size = MIN_TX_PAYLOAD_LEN + sizeof(ver_type_1_t);
-
-        // Construct the payload
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_GENERAL;                  // Command type
-        mcm_module->u8_send_payload[1] = MROVER_CC_TRIGGER_FW_UPDATE >> 8;     // Command code MSB
-        mcm_module->u8_send_payload[2] = MROVER_CC_TRIGGER_FW_UPDATE & 0xFF;   // Command code LSB
-        mcm_module->u8_send_payload[3] = 0x00;                                 // Reserved
-        mcm_module->u8_send_payload[4] = sizeof(ver_type_1_t);                 // Payload length
-        mcm_module->u8_send_payload[5] = version.major;                      
-        mcm_module->u8_send_payload[6] = version.minor;
-        mcm_module->u8_send_payload[7] = version.patch;                    
-
-        // Append CRC
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append CRC\n");
-            break;
-        }
+api_processor_status_t api_processor_cmd_get_lorawan_class(mcm_module_hdl_t *mcm_module)
+{
+    return api_processor_send_cmd(mcm_module, API_CMD_GET_LORAWAN_CLASS, NULL, 0, NULL, 0);
+}
 
-        // Send the payload
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(
-            mcm_module->u8_send_payload, max_payload_size, mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
 
-        return_status = API_PROCESSOR_SUCCESS;
+api_processor_status_t api_processor_cmd_start_file_transfer(mcm_module_hdl_t *mcm_module,ver_type_1_t version)
+{
+    const uint8_t u8_version[] = { version.major, version.minor, version.patch };
+    return api_processor_send_cmd(mcm_module, API_CMD_START_FILE_TRANSFER, NULL, 0, u8_version, sizeof(u8_version));
+}
 
 
-    } while (0);
+api_processor_status_t api_processor_cmd_get_seg_file_transfer_status(mcm_module_hdl_t *mcm_module)
+{
+    return api_processor_send_cmd(mcm_module, API_CMD_GET_FILE_STATUS, NULL, 0, NULL, 0);
+}
 
-    return return_status;
 
+api_processor_status_t api_processor_cmd_trigger_fw_update(mcm_module_hdl_t *mcm_module, ver_type_1_t version)
+{
+    const uint8_t u8_version[] = { version.major, version.minor, version.patch };
+    return api_processor_send_cmd(mcm_module, API_CMD_TRIGGER_FW_UPDATE, NULL, 0, u8_version, sizeof(u8_version));
 }
 
+
 /**
  * @brief This function handles the uplink request from the MCM module.
  *
@@ -2649,11 +1907,12 @@ api_processor_status_t api_processor_cmd_trigger_fw_update(mcm_module_hdl_t *mcm
  *         otherwise appropriate error code.
  */
 static api_processor_status_t api_processor_handle_request_uplink(mcm_module_hdl_t *mcm_module, uint8_t *data, uint16_t len, api_processor_response_t *p_response) {
+    (void)mcm_module;
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
 
     // Basic sanity checks
     if (data == NULL || len < 2) {
-        TRACE_INFO("Invalid data for uplink request\n");
+        TRACE_ERROR("Invalid data for uplink request\n");
         return API_PROCESSOR_INVALID_PARAMETERS;
     }
 
@@ -2677,56 +1936,10 @@ static api_processor_status_t api_processor_handle_request_uplink(mcm_module_hdl
  */
 api_processor_status_t api_processor_cmd_get_gps_time(mcm_module_hdl_t *mcm_module)
 {
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-    TRACE_INFO("Starting GPS time retrieval process\n");
-
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module or send callback is NULL. Module not properly initialized\n");
-            break;
-        }
-
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        const uint16_t max_payload_size = MIN_TX_PAYLOAD_LEN;
-        TRACE_INFO("Using max payload size: %d\n", max_payload_size);
-
-        // Construct the payload
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_GENERAL;          // Command type
-        mcm_module->u8_send_payload[1] = MROVER_CC_GET_GPS_TIME >> 8;   // Command code MSB
-        mcm_module->u8_send_payload[2] = MROVER_CC_GET_GPS_TIME & 0xFF; // Command code LSB
-        mcm_module->u8_send_payload[3] = 0x00;                          // Payload length MSB
-        mcm_module->u8_send_payload[4] = 0x00;                          // Payload length LSB
-
-        // Append CRC
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append CRC to payload. Status: %d\n", status);
-            break;
-        }
-
-        // Send the payload
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size, mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Serial port send failed. Expected: %d bytes, Sent: %d bytes\n", max_payload_size, u16_sent_bytes);
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-
-        return_status = API_PROCESSOR_SUCCESS;
-
-    } while (0);
-
-    if (return_status != API_PROCESSOR_SUCCESS) {
-        TRACE_INFO("GPS time retrieval failed with status: %d\n", return_status);
-    }
-
-    return return_status;
+    return api_processor_send_cmd(mcm_module, API_CMD_GET_GPS_TIME, NULL, 0, NULL, 0);
 }
 
+
 /**
  * @brief Send the MROVER_CC_LORAWAN_TIME_REQ command to retrieve the LoRaWAN device time.
  *
@@ -2735,51 +1948,11 @@ api_processor_status_t api_processor_cmd_get_gps_time(mcm_module_hdl_t *mcm_modu
  */
 api_processor_status_t api_processor_cmd_request_lorawan_dev_time(mcm_module_hdl_t *mcm_module)
 {
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        const uint16_t max_payload_size = MIN_TX_PAYLOAD_LEN;
-
-        // Construct the payload
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_LORAWAN;          // Command type
-        mcm_module->u8_send_payload[1] = MROVER_CC_LORAWAN_TIME_REQ >> 8;   // Command code MSB
-        mcm_module->u8_send_payload[2] = MROVER_CC_LORAWAN_TIME_REQ & 0xFF; // Command code LSB
-        mcm_module->u8_send_payload[3] = 0x00;                          // Payload length MSB
-        mcm_module->u8_send_payload[4] = 0x00;                          // Payload length LSB
-
-        // Append CRC
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append CRC\n");
-            break;
-        }
-
-        // Send the payload
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size, mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-
-        return_status = API_PROCESSOR_SUCCESS;
-
-    } while (0);
-
-    return return_status;
+    return api_processor_send_cmd(mcm_module, API_CMD_LORAWAN_TIME_REQUEST, NULL, 0, NULL, 0);
 }
 
 
+
 /**
  * @brief This function sends a command to get the last downlink statistics
  * 
@@ -2788,65 +1961,24 @@ api_processor_status_t api_processor_cmd_request_lorawan_dev_time(mcm_module_hdl
  */
 api_processor_status_t api_processor_cmd_get_last_dl_stats(mcm_module_hdl_t *mcm_module)
 {
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-
-    do
-    {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb)
-        {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-
-        // Clear the payload buffer
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        const uint16_t max_payload_size = MIN_TX_PAYLOAD_LEN;
-
-        // Construct the payload
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_GENERAL;                  // Command type
-        mcm_module->u8_send_payload[1] = MROVER_CC_GET_LAST_DL_STATS >> 8;     // Command code MSB
-        mcm_module->u8_send_payload[2] = MROVER_CC_GET_LAST_DL_STATS & 0xFF;   // Command code LSB
-        mcm_module->u8_send_payload[3] = 0x00;                                 // Payload length MSB
-        mcm_module->u8_send_payload[4] = 0x00;                                 // Payload length LSB
-
-        // Append CRC
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status)
-        {
-            TRACE_INFO("Failed to append CRC\n");
-            break;
-        }
-
-        // Send the payload
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(
-            mcm_module->u8_send_payload, max_payload_size, mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes)
-        {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-
-        return_status = API_PROCESSOR_SUCCESS;
-
-    } while (0);
-
-    return return_status;
+    return api_processor_send_cmd(mcm_module, API_CMD_GET_LAST_DL_STATS, NULL, 0, NULL, 0);
 }
 
+
 static api_processor_status_t api_processor_get_event_join_failure(mcm_module_hdl_t *mcm_module, uint8_t *data, uint16_t len, api_processor_response_t *p_response)
 {
+    (void)mcm_module;
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
     do
     {
         if (data == NULL || p_response == NULL)
         {
-            TRACE_INFO("In get event join failure data or response is null\n");
+            TRACE_ERROR("In get event join failure data or response is null\n");
             break;
         }
         if (len != 1)
         {
-            TRACE_INFO("In get event join failure data length is not 1\n");
+            TRACE_ERROR("In get event join failure data length is not 1\n");
             break;
         }
 
@@ -2855,13 +1987,13 @@ static api_processor_status_t api_processor_get_event_join_failure(mcm_module_hd
 
         // Log the failure reasons based on the bitmask
         if (data[0] & JOIN_FAIL_REG) {
-            TRACE_INFO("Join failure: Registration failed\n");
+            TRACE_ERROR("Join failure: Registration failed\n");
         }
         if (data[0] & JOIN_FAIL_TIME_SYNC) {
-            TRACE_INFO("Join failure: Time sync failed\n");
+            TRACE_ERROR("Join failure: Time sync failed\n");
         }
         if (data[0] & JOIN_FAIL_LINK) {
-            TRACE_INFO("Join failure: Link failed\n");
+            TRACE_ERROR("Join failure: Link failed\n");
         }
         if (data[0] == JOIN_FAIL_NONE) {
             TRACE_INFO("Join failure: No specific reason\n");
@@ -2876,10 +2008,11 @@ static api_processor_status_t api_processor_get_event_join_failure(mcm_module_hd
 
 static api_processor_status_t api_processor_parse_get_next_uplink_mtu(mcm_module_hdl_t *mcm_module, uint8_t *data, uint16_t len, api_processor_response_t *p_response)
 {
+    (void)mcm_module;
     api_processor_status_t return_status = API_PROCESSOR_ERROR;
     do {
         if (len < 3) { // 1 byte protocol + 2 bytes MTU
-            TRACE_INFO("Invalid payload length for GET_NEXT_UPLINK_MTU\n");
+            TRACE_ERROR("Invalid payload length for GET_NEXT_UPLINK_MTU\n");
             break;
         }
         p_response->cmd_response_data.next_uplink_mtu_protocol = data[0];
@@ -2891,32 +2024,13 @@ static api_processor_status_t api_processor_parse_get_next_uplink_mtu(mcm_module
 
 api_processor_status_t api_processor_cmd_get_next_uplink_mtu(mcm_module_hdl_t *mcm_module)
 {
-    api_processor_status_t return_status = API_PROCESSOR_ERROR;
-    const uint16_t max_payload_size = 6;
-    do {
-        if (NULL == mcm_module || NULL == mcm_module->h_serial_device.send_data_cb) {
-            TRACE_INFO("MCM module is not initialized\n");
-            break;
-        }
-        memset(mcm_module->u8_send_payload, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
-        mcm_module->u8_send_payload[0] = COMMAND_TYPE_GENERAL;
-        mcm_module->u8_send_payload[1] = MROVER_CC_GET_NEXT_UPLINK_MTU >> 8;
-        mcm_module->u8_send_payload[2] = MROVER_CC_GET_NEXT_UPLINK_MTU & 0xFF;
-        mcm_module->u8_send_payload[3] = 0x00;
-        mcm_module->u8_send_payload[4] = 0x00;
-        mcm_module->u8_send_payload[5] = 0x00;
-        fp_api_status_t status = fp_append_crc(mcm_module->u8_send_payload, max_payload_size);
-        if (FP_SUCCESS != status) {
-            TRACE_INFO("Failed to append crc\n");
-            break;
-        }
-        uint16_t u16_sent_bytes = mcm_module->h_serial_device.send_data_cb(mcm_module->u8_send_payload, max_payload_size, mcm_module->user_context);
-        if (max_payload_size != u16_sent_bytes) {
-            TRACE_INFO("Failed to send data through serial port\n");
-            return_status = API_PROCESSOR_SERIAL_PORT_ERROR;
-            break;
-        }
-        return_status = API_PROCESSOR_SUCCESS;
-    } while (0);
-    return return_status;
+    return api_processor_send_cmd(mcm_module, API_CMD_GET_NEXT_UPLINK_MTU, NULL, 0, NULL, 0);
+}
+
+
+api_processor_status_t api_processor_cmd_set_uart_baud(mcm_module_hdl_t *mcm_module, uint32_t u32_baud_rate)
+{
+    const uint8_t u8_baud[SET_UART_BAUD_PAYLOAD_LEN] = { (uint8_t)(u32_baud_rate >> 24), (uint8_t)(u32_baud_rate >> 16),
+                                                         (uint8_t)(u32_baud_rate >> 8), (uint8_t)u32_baud_rate };
+    return api_processor_send_cmd(mcm_module, API_CMD_SET_UART_BAUD, NULL, 0, u8_baud, sizeof(u8_baud));
 }
\ No newline at end of file
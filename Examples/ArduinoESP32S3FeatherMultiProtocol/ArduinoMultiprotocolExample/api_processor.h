@@ -50,6 +50,7 @@ extern "C" {
  **********************************************************************************************************/
 #include <stdint.h>
 #include "commands_defs.h"
+#include "frame_parse.h"
 
 
 /**********************************************************************************************************
@@ -68,6 +69,18 @@ extern "C" {
 #define API_PROCESSOR_LIB_MINOR_VERSION 5
 #define API_PROCESSOR_LIB_PATCH_VERSION 0
 
+/**
+ * @brief Size of the command header staging buffer: type, command code and
+ *        length (5 bytes) followed by the longest fixed prefix of a command (2 bytes).
+ *        The user payload and the CRC are never copied into it.
+ */
+#define API_PROCESSOR_SEND_HEADER_SIZE  7
+
+/**
+ * @brief Number of segments of a vectored command: header, user payload and CRC.
+ */
+#define API_PROCESSOR_TX_SEGMENT_COUNT  3
+
 /**********************************************************************************************************
  * TYPEDEFS
  **********************************************************************************************************/
@@ -296,6 +309,23 @@ typedef struct
 } api_processor_response_t;
 
 typedef uint16_t (*serial_send_data_cb)(uint8_t *data, uint16_t size,void* user_context);
+
+/**
+ * @brief One piece of a command frame, see serial_send_vector_cb.
+ */
+typedef struct
+{
+    const uint8_t *p_data;
+    uint16_t u16_len;
+} serial_tx_segment_t;
+
+/**
+ * @brief Optional vectored send callback. The frame is passed as consecutive segments
+ *        (header, user payload, CRC) which have to be sent in order, the user payload
+ *        is not copied by the api processor. Empty segments are skipped.
+ *        Returns the number of bytes sent, the whole frame length on success.
+ */
+typedef uint16_t (*serial_send_vector_cb)(const serial_tx_segment_t *p_segments, uint8_t u8_count, void *user_context);
 typedef void (*serial_receive_data_cb)(uint8_t *data,uint16_t size,void* user_context);
 typedef void (*mrover_notification_cb)(void *user_context);
 typedef void(*mrover_response_cb)(const api_processor_response_t *response,void* user_context);
@@ -303,6 +333,7 @@ typedef void(*mrover_response_cb)(const api_processor_response_t *response,void*
 typedef struct
 {
     serial_send_data_cb send_data_cb;
+    serial_send_vector_cb send_vector_cb;                       // used instead of send_data_cb when set
 } serial_module_hdl_t;  
 
 
@@ -310,8 +341,9 @@ typedef struct {
     serial_module_hdl_t h_serial_device;
     mrover_notification_cb handle_notification_cb;              // callback function for notification 
     mrover_response_cb handle_response_cb;                        // callback for response 
-    uint8_t u8_send_payload[MAX_SERIAL_SEND_PAYLOAD_SIZE];
-    uint8_t u8_received_payload[MAX_SERIAL_RECEIVE_PAYLOAD_SIZE];
+    uint8_t u8_send_header[API_PROCESSOR_SEND_HEADER_SIZE];     // header and prefix of the command being sent
+    uint8_t u8_send_crc;                                         // CRC trailer of the command being sent
+    fp_decoder_t h_rx_decoder;                                   // stream decoder for the received bytes, holds at most one frame
     uint8_t _no_of_curr_pen_evt;                             // keep the context for number of current pending events, private variable need not to be access directly
     void *user_context;
 }mcm_module_hdl_t; 
@@ -340,6 +372,27 @@ api_processor_status_t api_processor_init(
                         mrover_response_cb h_mrover_response_cb
 );
 
+/**
+ * @brief Registers the optional vectored send callback, to be called after api_processor_init()
+ *
+ * Once set, the commands are handed over as header, user payload and CRC segments
+ * instead of a single contiguous frame, so the uplink payloads are not copied.
+ *
+ * @param[in,out] mcm_module Pointer to the MCM module handle
+ * @param[in] send_vector_cb Vectored send callback, NULL to go back to send_data_cb
+ * @return API_PROCESSOR_SUCCESS if the callback is registered otherwise error code
+ */
+api_processor_status_t api_processor_set_send_vector_cb(mcm_module_hdl_t *mcm_module, serial_send_vector_cb send_vector_cb);
+
+/**
+ * @brief Drops the partially received frame held by the decoder
+ *
+ * To be called when the received stream cannot be trusted anymore, e.g. after a baud rate change.
+ *
+ * @param[in,out] mcm_module Pointer to the MCM module handle
+ */
+void api_processor_reset_rx(mcm_module_hdl_t *mcm_module);
+
 /**
  * @brief Retrieves the library version
  *
@@ -351,6 +404,10 @@ void api_processor_get_lib_ver(ver_type_1_t *ver);
 /**
  * @brief Parses the received serial data and processes it
  *
+ * The data can be any chunk of the serial stream, frames may be split across calls
+ * or several frames may be received in one call. Every complete frame is passed to the
+ * notification or response callback in the order it was received.
+ *
  * @param[in] mcm_module Pointer to the MCM module handle
  * @param[in] data Pointer to the received data
  * @param[in] len Length of the received data
@@ -915,6 +972,21 @@ api_processor_status_t api_processor_cmd_get_last_dl_stats(mcm_module_hdl_t *mcm
  */
 api_processor_status_t api_processor_cmd_get_next_uplink_mtu(mcm_module_hdl_t *mcm_module);
 
+/**
+ * @brief Constructs and sends a command to change the uart baud rate of the mcm
+ *
+ * @note The mcm answers at the current rate and switches once the response is sent,
+ *       it falls back to the previous rate if no valid frame is received within
+ *       MROVER_BAUD_VERIFY_WINDOW_MS.
+ * @note The command code is provisional and not in the receive tables, its response
+ *       is dropped as an unknown command until a released mcm firmware documents it.
+ *
+ * @param mcm_module Pointer to the MCM module structure
+ * @param u32_baud_rate New baud rate, one of the standard rates from 9600 to 921600
+ * @return api_processor_status_t Returns API_PROCESSOR_SUCCESS on success, or an error code on failure
+ */
+api_processor_status_t api_processor_cmd_set_uart_baud(mcm_module_hdl_t *mcm_module, uint32_t u32_baud_rate);
+
 /***********************************Helper Functions Prototypes *********************************/
 
 
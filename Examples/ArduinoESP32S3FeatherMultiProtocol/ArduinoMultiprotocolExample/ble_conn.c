@@ -0,0 +1,218 @@
+/**
+ * @file ble_conn.c
+ * @author OXIT embedded firmware team
+ * @brief State of the sidewalk ble connection, requested on demand and kept open for the bursts of uplinks.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "ble_conn.h"
+#include <stddef.h>
+#include <string.h>
+
+/******************************************************************************
+ * EXTERN VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ ******************************************************************************/
+/**
+ * @brief Doublings of the delay between failed requests, keeps the shift in range
+ */
+#define BLE_CONN_MAX_BACKOFF_SHIFT          (16)
+
+/******************************************************************************
+ * PRIVATE TYPEDEFS
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ ******************************************************************************/
+static void ble_conn_fail_request(ble_conn_t *p_conn, uint32_t u32_now_ms);
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+/**
+ * @brief The request failed, the next one waits for the backoff
+ */
+static void ble_conn_fail_request(ble_conn_t *p_conn, uint32_t u32_now_ms)
+{
+    uint32_t u32_delay_ms = p_conn->config.u32_retry_base_ms;
+    uint8_t u8_shift = p_conn->u8_failures;
+
+    if (BLE_CONN_MAX_BACKOFF_SHIFT < u8_shift)
+    {
+        u8_shift = BLE_CONN_MAX_BACKOFF_SHIFT;
+    }
+    if (0 != u8_shift)
+    {
+        u32_delay_ms = ((p_conn->config.u32_retry_max_ms >> u8_shift) < u32_delay_ms) ? p_conn->config.u32_retry_max_ms : (u32_delay_ms << u8_shift);
+    }
+    if (u32_delay_ms > p_conn->config.u32_retry_max_ms)
+    {
+        u32_delay_ms = p_conn->config.u32_retry_max_ms;
+    }
+
+    if (UINT8_MAX > p_conn->u8_failures)
+    {
+        p_conn->u8_failures++;
+    }
+    p_conn->stats.u32_failures++;
+    p_conn->u32_retry_ms = u32_now_ms + u32_delay_ms;
+    p_conn->state = BLE_CONN_DOWN;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+void ble_conn_init(ble_conn_t *p_conn, const ble_conn_config_t *p_config)
+{
+    if ((NULL == p_conn) || (NULL == p_config))
+    {
+        return;
+    }
+    memset(p_conn, 0, sizeof(ble_conn_t));
+    p_conn->config = *p_config;
+    p_conn->state = BLE_CONN_DOWN;
+}
+
+void ble_conn_reset(ble_conn_t *p_conn)
+{
+    p_conn->state = BLE_CONN_DOWN;
+    p_conn->u8_failures = 0;
+    p_conn->u32_retry_ms = 0;
+}
+
+bool ble_conn_poll(ble_conn_t *p_conn, uint32_t u32_now_ms)
+{
+    if ((BLE_CONN_CONNECTING == p_conn->state) && ((u32_now_ms - p_conn->u32_state_ms) >= p_conn->config.u32_setup_timeout_ms))
+    {
+        ble_conn_fail_request(p_conn, u32_now_ms);
+    }
+    else if ((BLE_CONN_ACKED == p_conn->state) && ((u32_now_ms - p_conn->u32_state_ms) >= p_conn->config.u32_link_setup_ms))
+    {
+        p_conn->stats.u32_connections++;
+        p_conn->u8_failures = 0;
+        p_conn->u32_state_ms = u32_now_ms;
+        p_conn->state = BLE_CONN_UP;
+    }
+    else if ((BLE_CONN_UP == p_conn->state) && ((u32_now_ms - p_conn->u32_state_ms) >= p_conn->config.u32_idle_timeout_ms))
+    {
+        // closed by the peer meanwhile, the next uplink requests a new connection
+        p_conn->state = BLE_CONN_DOWN;
+        p_conn->u32_retry_ms = u32_now_ms;
+    }
+    return (BLE_CONN_UP == p_conn->state);
+}
+
+bool ble_conn_should_request(const ble_conn_t *p_conn, uint32_t u32_now_ms)
+{
+    // wrap safe, the delay is far below half the range of the timer
+    return (BLE_CONN_DOWN == p_conn->state) && ((int32_t)(u32_now_ms - p_conn->u32_retry_ms) >= 0);
+}
+
+void ble_conn_on_request(ble_conn_t *p_conn, uint32_t u32_now_ms)
+{
+    p_conn->stats.u32_requests++;
+    p_conn->u32_state_ms = u32_now_ms;
+    p_conn->state = BLE_CONN_CONNECTING;
+}
+
+void ble_conn_on_ack(ble_conn_t *p_conn, uint32_t u32_now_ms)
+{
+    if (BLE_CONN_CONNECTING == p_conn->state)
+    {
+        p_conn->u32_state_ms = u32_now_ms;
+        p_conn->state = BLE_CONN_ACKED;
+    }
+}
+
+void ble_conn_on_result(ble_conn_t *p_conn, bool b_connected, uint32_t u32_now_ms)
+{
+    if (b_connected)
+    {
+        if (BLE_CONN_UP != p_conn->state)
+        {
+            p_conn->stats.u32_connections++;
+        }
+        p_conn->u8_failures = 0;
+        p_conn->u32_state_ms = u32_now_ms;
+        p_conn->state = BLE_CONN_UP;
+    }
+    else if ((BLE_CONN_CONNECTING == p_conn->state) || (BLE_CONN_ACKED == p_conn->state))
+    {
+        ble_conn_fail_request(p_conn, u32_now_ms);
+    }
+    else if (BLE_CONN_UP == p_conn->state)
+    {
+        p_conn->stats.u32_drops++;
+        p_conn->u32_retry_ms = u32_now_ms;
+        p_conn->state = BLE_CONN_DOWN;
+    }
+}
+
+void ble_conn_on_uplink(ble_conn_t *p_conn, uint32_t u32_now_ms)
+{
+    if (BLE_CONN_UP == p_conn->state)
+    {
+        p_conn->stats.u32_uplinks++;
+        p_conn->u32_state_ms = u32_now_ms;
+    }
+}
+
+ble_conn_state_t ble_conn_get_state(const ble_conn_t *p_conn)
+{
+    return p_conn->state;
+}
+
+const ble_conn_stats_t *ble_conn_get_stats(const ble_conn_t *p_conn)
+{
+    return &p_conn->stats;
+}
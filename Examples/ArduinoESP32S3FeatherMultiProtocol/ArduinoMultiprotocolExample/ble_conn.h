@@ -0,0 +1,195 @@
+/**
+ * @file ble_conn.h
+ * @author OXIT embedded firmware team
+ * @brief State of the sidewalk ble connection, requested on demand and kept open for the bursts of uplinks.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+#ifndef __BLE_CONN_H__
+#define __BLE_CONN_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+/**
+ * @brief State of the ble connection
+ */
+typedef enum
+{
+    BLE_CONN_DOWN,                                      // no connection, requested when an uplink waits
+    BLE_CONN_CONNECTING,                                // connection requested, its result is awaited
+    BLE_CONN_ACKED,                                     // request acknowledged, the link is being set up
+    BLE_CONN_UP                                         // uplinks are sent back to back
+} ble_conn_state_t;
+
+/**
+ * @brief Timing of the ble connection.
+ *  A failed request is requested again after u32_retry_base_ms * 2^(n-1), at most u32_retry_max_ms.
+ */
+typedef struct
+{
+    uint32_t u32_setup_timeout_ms;                      // a request without result has failed
+    uint32_t u32_link_setup_ms;                         // the link is taken as up this long after the ack
+    uint32_t u32_idle_timeout_ms;                       // the connection is taken as closed without traffic
+    uint32_t u32_retry_base_ms;
+    uint32_t u32_retry_max_ms;
+} ble_conn_config_t;
+
+/**
+ * @brief Counters of the ble connection
+ */
+typedef struct
+{
+    uint32_t u32_requests;                              // connection requests sent
+    uint32_t u32_connections;                           // connections established
+    uint32_t u32_failures;                              // requests failed or timed out
+    uint32_t u32_drops;                                 // connections lost while up
+    uint32_t u32_uplinks;                               // uplinks sent on a connection
+} ble_conn_stats_t;
+
+/**
+ * @brief Context of the ble connection.
+ *
+ * The members are private, use the ble_conn_* functions to access them.
+ */
+typedef struct
+{
+    ble_conn_config_t config;
+    ble_conn_state_t state;
+    uint32_t u32_state_ms;                              // request time in BLE_CONN_CONNECTING, ack time in BLE_CONN_ACKED,
+                                                        // last traffic in BLE_CONN_UP
+    uint32_t u32_retry_ms;                              // earliest next request in BLE_CONN_DOWN
+    uint8_t u8_failures;                                // consecutive failed requests
+    ble_conn_stats_t stats;
+} ble_conn_t;
+
+/**********************************************************************************************************
+ * EXPORTED VARIABLES
+ **********************************************************************************************************/
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTION PROTOTYPES
+ **********************************************************************************************************/
+/**
+ * @brief Initializes the ble connection, down afterwards.
+ *
+ * @param[in,out] p_conn Pointer to the ble connection context
+ * @param[in] p_config Timing of the connection, copied
+ */
+void ble_conn_init(ble_conn_t *p_conn, const ble_conn_config_t *p_config);
+
+/**
+ * @brief Forgets the connection, when the network is stopped or the connection mode changes.
+ *  A request can be sent right away afterwards.
+ */
+void ble_conn_reset(ble_conn_t *p_conn);
+
+/**
+ * @brief Applies the setup and idle timeouts, an acknowledged request is taken as up after the link setup time.
+ *
+ * @param[in,out] p_conn Pointer to the ble connection context
+ * @param[in] u32_now_ms Current time
+ *
+ * @retval true The connection is up, an uplink can be sent
+ * @retval false The connection is down or being established
+ */
+bool ble_conn_poll(ble_conn_t *p_conn, uint32_t u32_now_ms);
+
+/**
+ * @brief Tells whether a connection request should be sent, the connection being down and
+ *  the delay after a failed request over. Call ble_conn_on_request() once it is sent.
+ */
+bool ble_conn_should_request(const ble_conn_t *p_conn, uint32_t u32_now_ms);
+
+/**
+ * @brief Marks the connection request as sent, its result is awaited.
+ */
+void ble_conn_on_request(ble_conn_t *p_conn, uint32_t u32_now_ms);
+
+/**
+ * @brief Marks the connection request as acknowledged by the modem. The ack only tells the request is accepted,
+ *  the protocol has no link up event, so the connection is taken as up u32_link_setup_ms later by ble_conn_poll()
+ *  or earlier by a successful ble_conn_on_result().
+ */
+void ble_conn_on_ack(ble_conn_t *p_conn, uint32_t u32_now_ms);
+
+/**
+ * @brief Gives the result of the connection, from the modem events which need a link: a time sync, an uplink done or a downlink.
+ *  A failure while connecting delays the next request, a failure while up drops the connection.
+ *  A success refreshes the idle timeout.
+ *
+ * @param[in,out] p_conn Pointer to the ble connection context
+ * @param[in] b_connected The connection is up
+ * @param[in] u32_now_ms Current time
+ */
+void ble_conn_on_result(ble_conn_t *p_conn, bool b_connected, uint32_t u32_now_ms);
+
+/**
+ * @brief Counts an uplink sent on the connection and refreshes its idle timeout.
+ */
+void ble_conn_on_uplink(ble_conn_t *p_conn, uint32_t u32_now_ms);
+
+/**
+ * @brief Returns the state of the connection, as of the last ble_conn_poll().
+ */
+ble_conn_state_t ble_conn_get_state(const ble_conn_t *p_conn);
+
+/**
+ * @brief Returns the counters of the connection.
+ */
+const ble_conn_stats_t *ble_conn_get_stats(const ble_conn_t *p_conn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __BLE_CONN_H__
@@ -0,0 +1,120 @@
+/**
+ * @file checksum.h
+ * @author OXIT embedded firmware team
+ * @brief Checksums shared by the frame parser, the uplink journal and the ymodem receiver.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+#ifndef __CHECKSUM_H__
+#define __CHECKSUM_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+/**
+ * @brief Use the crc16 routine of the ESP32 ROM when it gives the same result as the tables, 0 to disable
+ */
+#ifndef CHECKSUM_USE_ROM_CRC16
+#define CHECKSUM_USE_ROM_CRC16              (1)
+#endif
+
+/**
+ * @brief Initial value of the crc16 CCITT of ymodem (XMODEM), and of the CCITT-FALSE variant
+ */
+#define CHECKSUM_CRC16_XMODEM_INIT          (0x0000)
+#define CHECKSUM_CRC16_CCITT_INIT           (0xFFFF)
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+
+/**********************************************************************************************************
+ * EXPORTED VARIABLES
+ **********************************************************************************************************/
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTION PROTOTYPES
+ **********************************************************************************************************/
+/**
+ * @brief Updates a crc16 CCITT, polynomial 0x1021, most significant bit first, no final xor.
+ *  The data can be given in pieces as it streams in, the result does not depend on how it is split.
+ *
+ * @param[in] u16_crc Initial value, or the result of the previous piece
+ * @param[in] p_data Data
+ * @param[in] u32_len Length of the data
+ *
+ * @return The crc after the data
+ */
+uint16_t checksum_crc16_ccitt(uint16_t u16_crc, const uint8_t *p_data, uint32_t u32_len);
+
+/**
+ * @brief Updates the crc16 CCITT with the tables only, slice by 4, whatever the platform.
+ */
+uint16_t checksum_crc16_ccitt_table(uint16_t u16_crc, const uint8_t *p_data, uint32_t u32_len);
+
+/**
+ * @brief Updates the xor of all the bytes, the checksum of the mcm frames.
+ *
+ * @param[in] u8_xor Initial value, or the result of the previous piece
+ * @param[in] p_data Data
+ * @param[in] u32_len Length of the data
+ *
+ * @return The xor after the data
+ */
+uint8_t checksum_xor8(uint8_t u8_xor, const uint8_t *p_data, uint32_t u32_len);
+
+/**
+ * @brief Tells whether checksum_crc16_ccitt() runs the ROM routine.
+ */
+bool checksum_is_rom_crc16(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __CHECKSUM_H__
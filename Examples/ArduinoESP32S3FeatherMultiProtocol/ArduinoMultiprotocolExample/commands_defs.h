@@ -76,6 +76,31 @@ extern "C" {
 #define LENGTH_IN_NOTIFICATION_PAYLOAD               0x0001
 
 #define MAX_PENDING_MESSAGES                        0x0A
+
+/**
+ * @brief Number of entries of a table indexed by command code, the command
+ *        codes go from MROVER_CC_GET_EVENT to MROVER_CC_GET_NEXT_UPLINK_MTU.
+ *        The provisional MROVER_CC_SET_UART_BAUD is left out of the receive
+ *        tables until a released mcm firmware documents it.
+ */
+#define MROVER_CC_TABLE_SIZE                        (MROVER_CC_GET_NEXT_UPLINK_MTU + 1)
+
+/**
+ * @brief Baud rate of the mcm uart after a reset, 8N1
+ */
+#define MROVER_DEFAULT_BAUD_RATE                    9600
+
+/**
+ * @brief Payload of the set uart baud command, the baud rate as a big endian 32 bit value.
+ * The mcm answers at the current rate and switches once the response is sent. It goes
+ * back to the previous rate if no valid frame is received within MROVER_BAUD_VERIFY_WINDOW_MS.
+ */
+#define SET_UART_BAUD_PAYLOAD_LEN                   4
+
+/**
+ * @brief Time given to the host to verify the new baud rate before the mcm falls back
+ */
+#define MROVER_BAUD_VERIFY_WINDOW_MS                1000
 /**
  * Oxtech mcm user guide 4.4.2
 */
@@ -107,6 +132,12 @@ extern "C" {
  */
 #define LORAWAN_TX_MAX_PAYLOAD_SIZE                 350
 
+/**
+ * @brief Largest user data of a lorawan uplink that fits in one command frame.
+ *  The command header, the port, the uplink type and the crc take the rest of MAX_SERIAL_SEND_PAYLOAD_SIZE.
+ */
+#define LORAWAN_TX_MAX_FRAME_PAYLOAD_SIZE           (MAX_SERIAL_SEND_PAYLOAD_SIZE - MIN_TX_PAYLOAD_LEN - 2)
+
 #define SIDEWALK_TX_MAX_BLE_PAYLOAD_SIZE            255
 #define SIDEWALK_TX_MAX_FSK_PAYLOAD_SIZE            200
 #define SIDEWALK_TX_MAX_CSS_PAYLOAD_SIZE            19
@@ -124,15 +155,21 @@ extern "C" {
 /**
  * @brief set the value 
  *  0 to disable the trace buffer and 1 to enable the trace buffer
+ *  Can be overridden from the compiler flags (-DENABLE_TRACE_BUFFER=0),
+ *  e.g. when the protocol files are compiled outside the Arduino IDE
+ *  The traces are logged in the binary ring of trace_log.h, TRACE_LEVEL selects
+ *  which of them are compiled in.
  * 
  */
+#ifndef ENABLE_TRACE_BUFFER
 #define ENABLE_TRACE_BUFFER                         1
+#endif
+
+#if (0 == ENABLE_TRACE_BUFFER) && !defined(TRACE_LEVEL)
+#define TRACE_LEVEL                                 TRACE_LEVEL_NONE
+#endif
 
-#define TRACE_INFO(...)                             do                              \
-                                                    {                               \
-                                                        if (ENABLE_TRACE_BUFFER)    \
-                                                            printf(__VA_ARGS__);    \
-                                                    } while (0);
+#include "trace_log.h"
 
 
 
@@ -202,6 +239,7 @@ typedef enum{
     MROVER_CC_INIT_LORAWAN                         = 0x00FF,   // initialize lorawan
     MROVER_CC_SWITCH_NETWORK                       = 0x0100,   // switch network between sidewalk and lorawan
     MROVER_CC_GET_NEXT_UPLINK_MTU                  = 0x0101,  // get the next maximum allowed uplink payload
+    MROVER_CC_SET_UART_BAUD                        = 0x0102,  // change the uart baud rate, provisional code not in the released mcm firmware
 
 }mrover_cc_codes_t;
 
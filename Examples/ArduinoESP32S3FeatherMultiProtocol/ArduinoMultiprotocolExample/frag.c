@@ -0,0 +1,355 @@
+/**
+ * @file frag.c
+ * @author OXIT embedded firmware team
+ * @brief Splits payloads larger than the link MTU into fragments and reassembles them.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "frag.h"
+#include <stddef.h>
+#include <string.h>
+
+/******************************************************************************
+ * EXTERN VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ ******************************************************************************/
+
+/******************************************************************************
+ * PRIVATE TYPEDEFS
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ ******************************************************************************/
+static void frag_rx_start(frag_rx_t *p_rx, uint8_t u8_msg_id);
+static void frag_rx_drop(frag_rx_t *p_rx);
+static bool frag_rx_is_received(const frag_rx_t *p_rx, uint8_t u8_index);
+static bool frag_rx_is_any_received_after(const frag_rx_t *p_rx, uint8_t u8_index);
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+/**
+ * @brief Starts the reassembly of a new message
+ */
+static void frag_rx_start(frag_rx_t *p_rx, uint8_t u8_msg_id)
+{
+    p_rx->b_active = true;
+    p_rx->u8_msg_id = u8_msg_id;
+    p_rx->u16_frag_size = 0;
+    p_rx->b_last_received = false;
+    p_rx->u8_last_index = 0;
+    p_rx->u16_last_len = 0;
+    p_rx->u8_received = 0;
+    memset(p_rx->au32_bitmap, 0, sizeof(p_rx->au32_bitmap));
+}
+
+/**
+ * @brief Drops the partial message
+ */
+static void frag_rx_drop(frag_rx_t *p_rx)
+{
+    if (p_rx->b_active)
+    {
+        p_rx->b_active = false;
+        p_rx->u32_dropped_count++;
+    }
+}
+
+static bool frag_rx_is_received(const frag_rx_t *p_rx, uint8_t u8_index)
+{
+    return 0 != (p_rx->au32_bitmap[u8_index / 32] & (1UL << (u8_index % 32)));
+}
+
+static bool frag_rx_is_any_received_after(const frag_rx_t *p_rx, uint8_t u8_index)
+{
+    for (uint8_t i = u8_index + 1; i < FRAG_MAX_FRAGMENTS; i++)
+    {
+        if (frag_rx_is_received(p_rx, i))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+uint16_t frag_get_count(uint16_t u16_len, uint16_t u16_mtu)
+{
+    if ((0 == u16_len) || (u16_mtu <= FRAG_HEADER_LEN))
+    {
+        return 0;
+    }
+    return (u16_len + (u16_mtu - FRAG_HEADER_LEN) - 1) / (u16_mtu - FRAG_HEADER_LEN);
+}
+
+bool frag_tx_init(frag_tx_t *p_tx, const uint8_t *p_data, uint16_t u16_len, uint16_t u16_mtu, uint8_t u8_msg_id)
+{
+    uint16_t u16_count = frag_get_count(u16_len, u16_mtu);
+
+    if ((NULL == p_tx) || (NULL == p_data) || (0 == u16_count) || (FRAG_MAX_FRAGMENTS < u16_count))
+    {
+        return false;
+    }
+
+    p_tx->p_data = p_data;
+    p_tx->u16_len = u16_len;
+    p_tx->u16_frag_size = u16_mtu - FRAG_HEADER_LEN;
+    p_tx->u8_count = (uint8_t)u16_count;
+    p_tx->u8_msg_id = u8_msg_id;
+    return true;
+}
+
+uint8_t frag_tx_get_count(const frag_tx_t *p_tx)
+{
+    return p_tx->u8_count;
+}
+
+uint16_t frag_tx_build(const frag_tx_t *p_tx, uint8_t u8_index, uint8_t *p_out)
+{
+    uint16_t u16_offset = 0;
+    uint16_t u16_len = 0;
+
+    if ((NULL == p_tx) || (NULL == p_out) || (u8_index >= p_tx->u8_count))
+    {
+        return 0;
+    }
+
+    u16_offset = u8_index * p_tx->u16_frag_size;
+    u16_len = p_tx->u16_len - u16_offset;
+    if (u16_len > p_tx->u16_frag_size)
+    {
+        u16_len = p_tx->u16_frag_size;
+    }
+
+    p_out[0] = p_tx->u8_msg_id;
+    p_out[1] = u8_index | (((u8_index + 1) == p_tx->u8_count) ? FRAG_LAST_FLAG : 0);
+    memcpy(&p_out[FRAG_HEADER_LEN], &p_tx->p_data[u16_offset], u16_len);
+    return FRAG_HEADER_LEN + u16_len;
+}
+
+bool frag_rx_init(frag_rx_t *p_rx, uint8_t *p_buffer, uint16_t u16_size, uint32_t u32_timeout_ms)
+{
+    if ((NULL == p_rx) || (NULL == p_buffer) || (0 == u16_size))
+    {
+        return false;
+    }
+
+    memset(p_rx, 0, sizeof(frag_rx_t));
+    p_rx->p_buffer = p_buffer;
+    p_rx->u16_size = u16_size;
+    p_rx->u32_timeout_ms = u32_timeout_ms;
+    return true;
+}
+
+frag_rx_status_t frag_rx_push(frag_rx_t *p_rx, const uint8_t *p_frag, uint16_t u16_len, uint32_t u32_now_ms, uint16_t *p_msg_len)
+{
+    uint8_t u8_msg_id = 0;
+    uint8_t u8_index = 0;
+    bool b_last = false;
+    const uint8_t *p_data = NULL;
+    uint16_t u16_data_len = 0;
+
+    if ((NULL == p_rx) || (NULL == p_frag) || (NULL == p_msg_len) || (u16_len <= FRAG_HEADER_LEN))
+    {
+        return FRAG_RX_ERROR;
+    }
+
+    u8_msg_id = p_frag[0];
+    u8_index = p_frag[1] & FRAG_INDEX_MASK;
+    b_last = (0 != (p_frag[1] & FRAG_LAST_FLAG));
+    p_data = &p_frag[FRAG_HEADER_LEN];
+    u16_data_len = u16_len - FRAG_HEADER_LEN;
+
+    frag_rx_check_timeout(p_rx, u32_now_ms);
+
+    // fragments of the message just completed are retransmissions
+    if (p_rx->b_completed && (u8_msg_id == p_rx->u8_completed_id))
+    {
+        p_rx->u32_last_ms = u32_now_ms;
+        return FRAG_RX_DUPLICATE;
+    }
+
+    if (p_rx->b_active && (u8_msg_id != p_rx->u8_msg_id))
+    {
+        frag_rx_drop(p_rx);
+    }
+    if (false == p_rx->b_active)
+    {
+        frag_rx_start(p_rx, u8_msg_id);
+    }
+    p_rx->b_completed = false;
+    p_rx->u32_last_ms = u32_now_ms;
+
+    if (frag_rx_is_received(p_rx, u8_index))
+    {
+        return FRAG_RX_DUPLICATE;
+    }
+
+    do
+    {
+        if (b_last)
+        {
+            // a single last fragment, and no fragment after it
+            if (p_rx->b_last_received || frag_rx_is_any_received_after(p_rx, u8_index) ||
+                ((0 != p_rx->u16_frag_size) && (u16_data_len > p_rx->u16_frag_size)))
+            {
+                break;
+            }
+
+            if ((0 == u8_index) || (0 != p_rx->u16_frag_size))
+            {
+                uint32_t u32_offset = (uint32_t)u8_index * p_rx->u16_frag_size;
+                if ((u32_offset + u16_data_len) > p_rx->u16_size)
+                {
+                    break;
+                }
+                memcpy(&p_rx->p_buffer[u32_offset], p_data, u16_data_len);
+            }
+            else
+            {
+                // the position is known once another fragment gives the fragment size
+                if (u16_data_len > p_rx->u16_size)
+                {
+                    break;
+                }
+                memcpy(&p_rx->p_buffer[p_rx->u16_size - u16_data_len], p_data, u16_data_len);
+            }
+            p_rx->b_last_received = true;
+            p_rx->u8_last_index = u8_index;
+            p_rx->u16_last_len = u16_data_len;
+        }
+        else
+        {
+            if (p_rx->b_last_received && (u8_index > p_rx->u8_last_index))
+            {
+                break;
+            }
+
+            if (0 == p_rx->u16_frag_size)
+            {
+                if (p_rx->b_last_received)
+                {
+                    uint32_t u32_offset = (uint32_t)p_rx->u8_last_index * u16_data_len;
+                    if ((p_rx->u16_last_len > u16_data_len) || ((u32_offset + p_rx->u16_last_len) > p_rx->u16_size))
+                    {
+                        break;
+                    }
+                    memmove(&p_rx->p_buffer[u32_offset], &p_rx->p_buffer[p_rx->u16_size - p_rx->u16_last_len], p_rx->u16_last_len);
+                }
+                p_rx->u16_frag_size = u16_data_len;
+            }
+            else if (u16_data_len != p_rx->u16_frag_size)
+            {
+                break;
+            }
+
+            if (((uint32_t)(u8_index + 1) * p_rx->u16_frag_size) > p_rx->u16_size)
+            {
+                break;
+            }
+            memcpy(&p_rx->p_buffer[u8_index * p_rx->u16_frag_size], p_data, u16_data_len);
+        }
+
+        p_rx->au32_bitmap[u8_index / 32] |= (1UL << (u8_index % 32));
+        p_rx->u8_received++;
+
+        if ((false == p_rx->b_last_received) || (p_rx->u8_received != (p_rx->u8_last_index + 1)))
+        {
+            return FRAG_RX_PENDING;
+        }
+
+        *p_msg_len = (p_rx->u8_last_index * p_rx->u16_frag_size) + p_rx->u16_last_len;
+        p_rx->b_active = false;
+        p_rx->b_completed = true;
+        p_rx->u8_completed_id = u8_msg_id;
+        p_rx->u32_completed_count++;
+        return FRAG_RX_COMPLETE;
+    } while (0);
+
+    frag_rx_drop(p_rx);
+    return FRAG_RX_ERROR;
+}
+
+bool frag_rx_check_timeout(frag_rx_t *p_rx, uint32_t u32_now_ms)
+{
+    if ((u32_now_ms - p_rx->u32_last_ms) < p_rx->u32_timeout_ms)
+    {
+        return false;
+    }
+
+    // past the timeout the id of the completed message can be reused
+    p_rx->b_completed = false;
+    if (false == p_rx->b_active)
+    {
+        return false;
+    }
+    frag_rx_drop(p_rx);
+    return true;
+}
+
+uint8_t frag_rx_get_received_count(const frag_rx_t *p_rx)
+{
+    return p_rx->b_active ? p_rx->u8_received : 0;
+}
+
+uint32_t frag_rx_get_completed_count(const frag_rx_t *p_rx)
+{
+    return p_rx->u32_completed_count;
+}
+
+uint32_t frag_rx_get_dropped_count(const frag_rx_t *p_rx)
+{
+    return p_rx->u32_dropped_count;
+}
@@ -0,0 +1,243 @@
+/**
+ * @file frag.h
+ * @author OXIT embedded firmware team
+ * @brief Splits payloads larger than the link MTU into fragments and reassembles them.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+#ifndef __FRAG_H__
+#define __FRAG_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+/**
+ * @brief Size of the header in front of every fragment.
+ *
+ * Fragment layout:
+ *  [message id][last flag | fragment index][data]
+ *  The message id changes for every message. Fragment indexes start at 0, bit 7 of the
+ *  second byte is set in the last fragment of the message. All fragments except the last
+ *  carry the same amount of data, so the receiver places every fragment at index times
+ *  that size whatever the order of reception.
+ */
+#define FRAG_HEADER_LEN         (2)
+
+/**
+ * @brief Set in the second header byte of the last fragment
+ */
+#define FRAG_LAST_FLAG          (0x80)
+
+/**
+ * @brief Fragment index in the second header byte
+ */
+#define FRAG_INDEX_MASK         (0x7F)
+
+/**
+ * @brief Largest number of fragments of a message
+ */
+#define FRAG_MAX_FRAGMENTS      (128)
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+/**
+ * @brief Message being split, the members are private.
+ */
+typedef struct
+{
+    const uint8_t *p_data;                              // message, kept by the caller until the last fragment is built
+    uint16_t u16_len;
+    uint16_t u16_frag_size;                             // data bytes of every fragment except the last
+    uint8_t u8_count;                                   // number of fragments
+    uint8_t u8_msg_id;
+} frag_tx_t;
+
+/**
+ * @brief Result of frag_rx_push()
+ */
+typedef enum
+{
+    FRAG_RX_PENDING,                                    // fragment stored, the message is not complete yet
+    FRAG_RX_COMPLETE,                                   // message complete in the reassembly storage
+    FRAG_RX_DUPLICATE,                                  // fragment already received, ignored
+    FRAG_RX_ERROR                                       // malformed or inconsistent fragment, the partial message is dropped
+} frag_rx_status_t;
+
+/**
+ * @brief Context of the reassembler.
+ *
+ * One message is reassembled at a time in the storage given at init, a fragment of
+ * another message drops the partial one. The members are private, use the frag_rx_*
+ * functions to access them.
+ * The module has no arduino dependency, the cloud side builds it as the reference reassembler.
+ */
+typedef struct
+{
+    uint8_t *p_buffer;                                  // reassembly storage, u16_size bytes
+    uint16_t u16_size;
+    uint32_t u32_timeout_ms;                            // longest gap between two fragments of a message
+    uint32_t u32_last_ms;                               // time of the last fragment received
+    bool b_active;                                      // a message is being reassembled
+    uint8_t u8_msg_id;
+    uint16_t u16_frag_size;                             // 0 until a fragment other than the last is received
+    bool b_last_received;
+    uint8_t u8_last_index;
+    uint16_t u16_last_len;                              // kept at the end of the storage until u16_frag_size is known
+    uint8_t u8_received;                                // number of bits set in au32_bitmap
+    uint32_t au32_bitmap[FRAG_MAX_FRAGMENTS / 32];      // fragments received
+    bool b_completed;                                   // u8_completed_id holds the last completed message
+    uint8_t u8_completed_id;
+    uint32_t u32_completed_count;
+    uint32_t u32_dropped_count;                         // partial messages dropped by a timeout, an error or another message
+} frag_rx_t;
+
+/**********************************************************************************************************
+ * EXPORTED VARIABLES
+ **********************************************************************************************************/
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTION PROTOTYPES
+ **********************************************************************************************************/
+/**
+ * @brief Number of fragments needed for a message.
+ *
+ * @param[in] u16_len Length of the message
+ * @param[in] u16_mtu Largest uplink, header included
+ *
+ * @return Number of fragments, 0 if the message can not be sent with this MTU
+ */
+uint16_t frag_get_count(uint16_t u16_len, uint16_t u16_mtu);
+
+/**
+ * @brief Prepares the split of a message, the fragments are then built one by one.
+ *
+ * @param[in,out] p_tx Pointer to the split context
+ * @param[in] p_data Message, must stay valid until the last fragment is built
+ * @param[in] u16_len Length of the message, at least 1
+ * @param[in] u16_mtu Largest uplink, header included
+ * @param[in] u8_msg_id Id of the message, should differ from the previous message
+ *
+ * @retval true The message can be sent, see frag_tx_get_count()
+ * @retval false Invalid parameters or more than FRAG_MAX_FRAGMENTS fragments needed
+ */
+bool frag_tx_init(frag_tx_t *p_tx, const uint8_t *p_data, uint16_t u16_len, uint16_t u16_mtu, uint8_t u8_msg_id);
+
+/**
+ * @brief Number of fragments of the message
+ */
+uint8_t frag_tx_get_count(const frag_tx_t *p_tx);
+
+/**
+ * @brief Builds a fragment.
+ *
+ * @param[in] p_tx Pointer to the split context
+ * @param[in] u8_index Index of the fragment
+ * @param[out] p_out Destination of the fragment, at least FRAG_HEADER_LEN plus the fragment size
+ *
+ * @return Length of the fragment, header included, 0 if the index is out of range
+ */
+uint16_t frag_tx_build(const frag_tx_t *p_tx, uint8_t u8_index, uint8_t *p_out);
+
+/**
+ * @brief Initializes the reassembler on the given storage.
+ *
+ * @param[in,out] p_rx Pointer to the reassembler context
+ * @param[in] p_buffer Reassembly storage, sets the largest message
+ * @param[in] u16_size Size of the storage
+ * @param[in] u32_timeout_ms Partial message dropped when no fragment is received for this long
+ *
+ * @retval true The reassembler is initialized
+ * @retval false Invalid parameters
+ */
+bool frag_rx_init(frag_rx_t *p_rx, uint8_t *p_buffer, uint16_t u16_size, uint32_t u32_timeout_ms);
+
+/**
+ * @brief Stores a received fragment.
+ *
+ * @param[in,out] p_rx Pointer to the reassembler context
+ * @param[in] p_frag Fragment, header included
+ * @param[in] u16_len Length of the fragment
+ * @param[in] u32_now_ms Current time
+ * @param[out] p_msg_len Length of the message, set when FRAG_RX_COMPLETE is returned.
+ *  The message stays in the storage until the next call to frag_rx_push().
+ *
+ * @return Status of the message, see frag_rx_status_t
+ */
+frag_rx_status_t frag_rx_push(frag_rx_t *p_rx, const uint8_t *p_frag, uint16_t u16_len, uint32_t u32_now_ms, uint16_t *p_msg_len);
+
+/**
+ * @brief Drops the partial message when no fragment has been received within the timeout.
+ *
+ * @param[in,out] p_rx Pointer to the reassembler context
+ * @param[in] u32_now_ms Current time
+ *
+ * @return true if a partial message has been dropped
+ */
+bool frag_rx_check_timeout(frag_rx_t *p_rx, uint32_t u32_now_ms);
+
+/**
+ * @brief Number of fragments received of the partial message, 0 when none is in progress
+ */
+uint8_t frag_rx_get_received_count(const frag_rx_t *p_rx);
+
+/**
+ * @brief Number of messages reassembled since init
+ */
+uint32_t frag_rx_get_completed_count(const frag_rx_t *p_rx);
+
+/**
+ * @brief Number of partial messages dropped since init
+ */
+uint32_t frag_rx_get_dropped_count(const frag_rx_t *p_rx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __FRAG_H__
@@ -71,6 +71,33 @@ typedef enum {
 
 }fp_api_status_t;
 
+/**
+ * @brief Callback invoked by the stream decoder for every complete and CRC valid frame.
+ *
+ * @param[in] frame Pointer to the frame, valid only for the duration of the callback
+ * @param[in] len Length of the frame including the CRC byte
+ * @param[in] user_context User context passed to fp_decoder_feed()
+ */
+typedef void (*fp_frame_cb)(uint8_t *frame, uint16_t len, void *user_context);
+
+/**
+ * @brief Context of the byte fed stream decoder.
+ *
+ * The decoder keeps at most one frame in u8_frame. The UART may split or
+ * concatenate frames at any byte boundary, the decoder emits every complete
+ * frame in order and resynchronizes on the next plausible header if a frame
+ * fails the header, length or CRC checks.
+ * The members are private, use the fp_decoder_* functions to access them.
+ */
+typedef struct
+{
+    uint8_t u8_frame[MAX_SERIAL_RECEIVE_PAYLOAD_SIZE];  // bytes of the frame being assembled
+    uint16_t u16_index;                                 // number of valid bytes in u8_frame
+    uint16_t u16_expected_len;                          // total frame length, 0 until the header is complete
+    uint32_t u32_discarded_bytes;                       // bytes dropped while resynchronizing
+    uint32_t u32_crc_errors;                            // frames dropped because of a CRC mismatch
+} fp_decoder_t;
+
 /**********************************************************************************************************
  * EXPORTED VARIABLES
  **********************************************************************************************************/
@@ -88,6 +115,20 @@ typedef enum {
  */
 fp_api_status_t fp_append_crc(uint8_t *data,uint16_t len);
 
+/**
+ * @brief Continues a frame CRC over the next bytes of the frame.
+ *
+ * The CRC of a frame sent in several pieces is the CRC of every piece chained
+ * together, starting from 0. The result equals the one of fp_append_crc().
+ *
+ * @param[in] u8_crc CRC of the bytes before p_data, 0 for the first piece
+ * @param[in] p_data Pointer to the next bytes of the frame
+ * @param[in] u16_len Number of bytes
+ *
+ * @return CRC including the new bytes
+ */
+uint8_t fp_update_crc(uint8_t u8_crc, const uint8_t *p_data, uint16_t u16_len);
+
 /**
  * @brief Check if the frame is valid
  *
@@ -163,6 +204,34 @@ uint8_t fp_get_pending_event_count(uint8_t *data, uint16_t len);
  */
 bool fp_is_single_frame(uint8_t *p_data,uint16_t u16_len);
 
+/**
+ * @brief Resets the stream decoder, any partially received frame is dropped.
+ *
+ * @param[in,out] p_decoder Pointer to the decoder context
+ */
+void fp_decoder_init(fp_decoder_t *p_decoder);
+
+/**
+ * @brief Feeds the received bytes to the stream decoder.
+ *
+ * The bytes can be any chunk of the UART stream. For every complete and valid
+ * frame found, frame_cb is called in the order of reception. Incomplete frames
+ * are kept in the decoder until the next call.
+ *
+ * @param[in,out] p_decoder Pointer to the decoder context
+ * @param[in] p_data Pointer to the received bytes
+ * @param[in] u16_len Number of received bytes
+ * @param[in] frame_cb Callback for every decoded frame
+ * @param[in] user_context User context passed to the callback
+ *
+ * @retval FP_SUCCESS All the bytes were consumed without errors
+ * @retval FP_INVALID_PARAMETERS Invalid decoder, data pointer or callback
+ * @retval FP_INVALID_CRC At least one frame was dropped due to a CRC mismatch
+ * @retval FP_ERROR At least one byte was dropped while resynchronizing
+ */
+fp_api_status_t fp_decoder_feed(fp_decoder_t *p_decoder, const uint8_t *p_data, uint16_t u16_len,
+                                fp_frame_cb frame_cb, void *user_context);
+
 
 
 #ifdef __cplusplus
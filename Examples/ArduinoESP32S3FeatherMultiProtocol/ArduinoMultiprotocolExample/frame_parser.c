@@ -44,7 +44,9 @@
  * INCLUDES
  ******************************************************************************/
 #include "frame_parse.h"
+#include "checksum.h"
 #include <stdbool.h>
+#include <string.h>
 
 /******************************************************************************
  * EXTERN VARIABLES
@@ -53,14 +55,76 @@
 /******************************************************************************
  * PRIVATE MACROS AND DEFINES
  ******************************************************************************/
+/**
+ * @brief 1 byte return code, 1 byte command type, 2 byte command code and 2 byte length
+ */
+#define RESPONSE_HEADER_LEN                         6
 
 /******************************************************************************
  * PRIVATE TYPEDEFS
  ******************************************************************************/
+typedef enum
+{
+    FP_PREFIX_NEED_MORE = 0,    // bytes so far are a plausible frame start
+    FP_PREFIX_COMPLETE,         // a complete frame with valid CRC is available
+    FP_PREFIX_INVALID,          // bytes so far cannot be a valid frame
+    FP_PREFIX_BAD_CRC           // the frame is complete but the CRC does not match
+} fp_prefix_status_t;
 
 /******************************************************************************
  * STATIC VARIABLES
  ******************************************************************************/
+/**
+ * @brief Response codes the MCM module can return, indexed by response code
+ */
+static const bool s_valid_response_code[MROVER_RC_NOTIFY_EVENTS + 1] =
+{
+    [MROVER_RC_OK]                      = true,
+    [MROVER_RC_UNKNOWN]                 = true,
+    [MROVER_RC_NOT_IMPLEMENTED]         = true,
+    [MROVER_RC_FAIL]                    = true,
+    [MROVER_RC_BAD_CRC]                 = true,
+    [MROVER_RC_BAD_SIZE]                = true,
+    [MROVER_RC_GPS_TIME_NOT_AVAILABLE]  = true,
+    [MROVER_RC_NOTIFY_EVENTS]           = true,
+};
+
+/**
+ * @brief Command codes the host can receive a response for, indexed by command code
+ */
+static const bool s_valid_command_code[MROVER_CC_TABLE_SIZE] =
+{
+    [MROVER_CC_GET_EVENT]                       = true,
+    [MROVER_CC_GET_VERSION]                     = true,
+    [MROVER_CC_RESET]                           = true,
+    [MROVER_CC_FACTORY_RESET]                   = true,
+    [MROVER_CC_SWITCH_NETWORK]                  = true,
+    [MROVER_CC_INIT_LORAWAN]                    = true,
+    [MROVER_CC_SET_JOIN_EUI]                    = true,
+    [MROVER_CC_GET_GPS_TIME]                    = true,
+    [MROVER_CC_LORAWAN_TIME_REQ]                = true,
+    [MROVER_CC_SET_DEV_EUI]                     = true,
+    [MROVER_CC_SET_NW_KEY]                      = true,
+    [MROVER_CC_GET_DEV_EUI]                     = true,
+    [MROVER_CC_GET_JOIN_EUI]                    = true,
+    [MROVER_CC_JOIN_LORAWAN]                    = true,
+    [MROVER_CC_REQUEST_UPLINK]                  = true,
+    [MROVER_CC_LEAVE_LORAWAN_NETWORK]           = true,
+    [MROVER_CC_STOP_SID_LORAWAN_NETWORK]        = true,
+    [MROVER_CC_BLE_LINK_REQUEST]                = true,
+    [MROVER_CC_BLE_CONNECTION_REQUEST]          = true,
+    [MROVER_CC_FSK_LINK_REQUEST]                = true,
+    [MROVER_CC_CSS_LINK_REQUEST]                = true,
+    [MROVER_CC_SET_CSS_PWR_PROFILE]             = true,
+    [MROVER_CC_SET_FILTERING_DOWNLINK_SIDEWALK] = true,
+    [MROVER_CC_GET_LORAWAN_CLASS]               = true,
+    [MROVER_CC_SET_LORAWAN_CLASS]               = true,
+    [MROVER_CC_START_FILE_TRANSFER]             = true,
+    [MROVER_CC_FILE_STATUS]                     = true,
+    [MROVER_CC_TRIGGER_FW_UPDATE]               = true,
+    [MROVER_CC_GET_LAST_DL_STATS]               = true,
+    [MROVER_CC_GET_NEXT_UPLINK_MTU]             = true,
+};
 
 /******************************************************************************
  * GLOBAL VARIABLES
@@ -84,13 +148,7 @@
  */
 static uint8_t fp_calculate_crc(uint8_t *u8_data, uint16_t u16_len)
 {
-    uint8_t u8_crc = 0;
-    for (uint16_t u16_index = 0; u16_index < u16_len; u16_index++)
-    {
-        u8_crc ^= u8_data[u16_index];
-    }
-
-    return u8_crc;
+    return checksum_xor8(0, u8_data, u16_len);
 }
 
 /**
@@ -99,28 +157,9 @@ static uint8_t fp_calculate_crc(uint8_t *u8_data, uint16_t u16_len)
  * @param[in] u8_response_code Response code of the frame received
  * @return true if the response code is a valid one, false otherwise
  */
-static bool is_valid_response_code(uint8_t u8_response_code)
+static inline bool is_valid_response_code(uint8_t u8_response_code)
 {
-    bool b_is_valid_repose_code = false;
-
-    switch (u8_response_code)
-    {   
-        // intentional fall through for the cases
-        case MROVER_RC_OK:
-        case MROVER_RC_UNKNOWN:
-        case MROVER_RC_NOT_IMPLEMENTED:
-        case MROVER_RC_FAIL:
-        case MROVER_RC_BAD_CRC:
-        case MROVER_RC_BAD_SIZE:
-        case MROVER_RC_NOTIFY_EVENTS:
-        case MROVER_RC_GPS_TIME_NOT_AVAILABLE:
-            b_is_valid_repose_code = true;
-        break;
-
-        default:
-            break;
-    }
-    return b_is_valid_repose_code;
+    return (MROVER_RC_NOTIFY_EVENTS >= u8_response_code) && s_valid_response_code[u8_response_code];
 }
 
 /**
@@ -129,24 +168,9 @@ static bool is_valid_response_code(uint8_t u8_response_code)
  * @param[in] u8_command_type Command type received
  * @return true if the command type is valid, false otherwise
  */
-static bool is_valid_command_type(uint8_t u8_command_type)
+static inline bool is_valid_command_type(uint8_t u8_command_type)
 {
-    bool b_is_valid_command_type = false;
-
-    switch (u8_command_type)
-    {
-            // intentional fall through for the cases
-        case COMMAND_TYPE_GENERAL:
-        case COMMAND_TYPE_LORAWAN:
-        case COMMAND_TYPE_SIDEWALK:
-            b_is_valid_command_type = true;
-            break;
-
-        default:
-            break;
-    }
-
-    return b_is_valid_command_type;
+    return (COMMAND_TYPE_GENERAL <= u8_command_type) && (COMMAND_TYPE_SIDEWALK >= u8_command_type);
 }
 
 /**
@@ -155,57 +179,106 @@ static bool is_valid_command_type(uint8_t u8_command_type)
  * @param[in] u16_command_code Command code received
  * @return true if the command code is valid, false otherwise
  */
-static bool is_valid_command_code(uint16_t u16_command_code)
+static inline bool is_valid_command_code(uint16_t u16_command_code)
 {
-    bool b_is_valid_command_code = false;
+    return (MROVER_CC_TABLE_SIZE > u16_command_code) && s_valid_command_code[u16_command_code];
+}
 
-    switch (u16_command_code)
+/**
+ * @brief This function checks the bytes collected so far by the stream decoder
+ *
+ * Only the bytes available are checked, so the function can be called after
+ * each received byte. Once the header is complete the total frame length is
+ * stored in the decoder.
+ *
+ * @param[in,out] p_decoder Pointer to the decoder context
+ * @return Status of the bytes collected so far
+ */
+static fp_prefix_status_t fp_decoder_check_prefix(fp_decoder_t *p_decoder)
+{
+    const uint8_t *data = p_decoder->u8_frame;
+    uint16_t idx = p_decoder->u16_index;
+
+    p_decoder->u16_expected_len = 0;
+    if (0 == idx)
     {
-        // intentional fall through for the cases
-    case MROVER_CC_GET_EVENT:
-    case MROVER_CC_GET_VERSION:
-    case MROVER_CC_RESET:
-    case MROVER_CC_FACTORY_RESET:
-    case MROVER_CC_SWITCH_NETWORK:
-    case MROVER_CC_INIT_LORAWAN:
-    case MROVER_CC_SET_JOIN_EUI:
-    case MROVER_CC_GET_GPS_TIME:
-    case MROVER_CC_LORAWAN_TIME_REQ:
-    case MROVER_CC_SET_DEV_EUI:
-    case MROVER_CC_SET_NW_KEY:
-    case MROVER_CC_GET_DEV_EUI:
-    case MROVER_CC_GET_JOIN_EUI:
-    case MROVER_CC_JOIN_LORAWAN:
-    case MROVER_CC_REQUEST_UPLINK:
-    case MROVER_CC_LEAVE_LORAWAN_NETWORK:
-    case MROVER_CC_STOP_SID_LORAWAN_NETWORK:
-    case MROVER_CC_BLE_LINK_REQUEST:
-    case MROVER_CC_BLE_CONNECTION_REQUEST:
-    case MROVER_CC_FSK_LINK_REQUEST:
-    case MROVER_CC_CSS_LINK_REQUEST:
-    case MROVER_CC_SET_CSS_PWR_PROFILE:
-    case MROVER_CC_SET_FILTERING_DOWNLINK_SIDEWALK:
-    case MROVER_CC_GET_LORAWAN_CLASS:
-    case MROVER_CC_SET_LORAWAN_CLASS:
-    case MROVER_CC_START_FILE_TRANSFER:
-    case MROVER_CC_FILE_STATUS:
-    case MROVER_CC_TRIGGER_FW_UPDATE:
-    case MROVER_CC_GET_LAST_DL_STATS:
-    case MROVER_CC_GET_NEXT_UPLINK_MTU:
-        b_is_valid_command_code = true;
-        
-        break;
-    
-    default:
-        break;
+        return FP_PREFIX_NEED_MORE;
     }
 
-    return b_is_valid_command_code;
+    if (MROVER_RC_NOTIFY_EVENTS == data[0])
+    {
+        // notification: [0x20][len msb][len lsb][pending events][crc]
+        if ((idx > 1 && (LENGTH_IN_NOTIFICATION_PAYLOAD >> 8) != data[1]) ||
+            (idx > 2 && (LENGTH_IN_NOTIFICATION_PAYLOAD & 0xFF) != data[2]) ||
+            (idx > 3 && MAX_PENDING_MESSAGES < data[3]))
+        {
+            return FP_PREFIX_INVALID;
+        }
+        p_decoder->u16_expected_len = MIN_RX_PAYLOAD_LEN;
+    }
+    else
+    {
+        // response: [return code][cmd type][cc msb][cc lsb][len msb][len lsb][payload][crc]
+        if (false == is_valid_response_code(data[0]) ||
+            (idx > 1 && false == is_valid_command_type(data[1])) ||
+            (idx > 3 && false == is_valid_command_code((data[2] << 8) | data[3])))
+        {
+            return FP_PREFIX_INVALID;
+        }
 
+        if (RESPONSE_HEADER_LEN > idx)
+        {
+            return FP_PREFIX_NEED_MORE;
+        }
+
+        uint32_t u32_total_len = RESPONSE_HEADER_LEN + ((data[4] << 8) | data[5]) + 1;
+        if (MAX_SERIAL_RECEIVE_PAYLOAD_SIZE < u32_total_len)
+        {
+            return FP_PREFIX_INVALID;
+        }
+        p_decoder->u16_expected_len = (uint16_t)u32_total_len;
+    }
+
+    if (p_decoder->u16_expected_len > idx)
+    {
+        return FP_PREFIX_NEED_MORE;
+    }
+
+    // after a resync the bytes of the next frame may follow, the CRC is the last byte of this one
+    uint16_t u16_crc_idx = p_decoder->u16_expected_len - 1;
+    if (fp_calculate_crc(p_decoder->u8_frame, u16_crc_idx) != data[u16_crc_idx])
+    {
+        return FP_PREFIX_BAD_CRC;
+    }
+
+    return FP_PREFIX_COMPLETE;
 }
 
+/**
+ * @brief This function drops the first byte of the collected bytes and moves
+ *        the decoder to the next byte that could start a frame
+ *
+ * The bytes after the dropped one may contain the start of the next frame,
+ * so they are kept and checked again by the caller.
+ *
+ * @param[in,out] p_decoder Pointer to the decoder context
+ */
+static void fp_decoder_resync(fp_decoder_t *p_decoder)
+{
+    uint16_t u16_skip = 1;
 
+    while (u16_skip < p_decoder->u16_index &&
+           MROVER_RC_NOTIFY_EVENTS != p_decoder->u8_frame[u16_skip] &&
+           false == is_valid_response_code(p_decoder->u8_frame[u16_skip]))
+    {
+        u16_skip++;
+    }
 
+    p_decoder->u32_discarded_bytes += u16_skip;
+    p_decoder->u16_index -= u16_skip;
+    memmove(p_decoder->u8_frame, &p_decoder->u8_frame[u16_skip], p_decoder->u16_index);
+    p_decoder->u16_expected_len = 0;
+}
 
 /******************************************************************************
  * GLOBAL FUNCTIONS
@@ -230,14 +303,14 @@ fp_api_status_t fp_append_crc(uint8_t *data,uint16_t len)
     {
         if(NULL == data)
         {
-            TRACE_INFO("Data pointer cannot be NULL\n");
+            TRACE_ERROR("Data pointer cannot be NULL\n");
             return_status = FP_INVALID_PARAMETERS;
             break;
         }
 
         if(MIN_TX_PAYLOAD_LEN > len)
         {
-            TRACE_INFO("Minimum payload length is %d\n",MIN_TX_PAYLOAD_LEN);
+            TRACE_ERROR("Minimum payload length is %d\n",MIN_TX_PAYLOAD_LEN);
             return_status = FP_INVALID_PARAMETERS;
             break;
         }
@@ -251,6 +324,12 @@ fp_api_status_t fp_append_crc(uint8_t *data,uint16_t len)
 }
 
 
+uint8_t fp_update_crc(uint8_t u8_crc, const uint8_t *p_data, uint16_t u16_len)
+{
+    return checksum_xor8(u8_crc, p_data, u16_len);
+}
+
+
 fp_api_status_t fp_is_valid_response_frame(uint8_t *data, uint16_t len)
 {
     fp_api_status_t return_status = FP_ERROR;
@@ -259,14 +338,14 @@ fp_api_status_t fp_is_valid_response_frame(uint8_t *data, uint16_t len)
     {
         if (false == is_valid_response_code(data[0]))
         {
-            TRACE_INFO("Invalid response code %d\n", data[0]);
+            TRACE_ERROR("Invalid response code %d\n", data[0]);
             return_status = FP_INVALID_RETURN_CODE;
             break;
         }
 
         if (false == is_valid_command_type(data[1]))
         {
-            TRACE_INFO("Invalid command code %d\n", data[1]);
+            TRACE_ERROR("Invalid command code %d\n", data[1]);
             return_status = FP_INVALID_COMMAND_TYPE;
             break;
         }
@@ -274,7 +353,7 @@ fp_api_status_t fp_is_valid_response_frame(uint8_t *data, uint16_t len)
         uint16_t u16_command_code = (data[2] << 8) | data[3];
         if (false == is_valid_command_code(u16_command_code))
         {
-            TRACE_INFO("Invalid command code %d\n", u16_command_code);
+            TRACE_ERROR("Invalid command code %d\n", u16_command_code);
             return_status = FP_INVALID_COMMAND_TYPE;
             break;
         }
@@ -284,7 +363,7 @@ fp_api_status_t fp_is_valid_response_frame(uint8_t *data, uint16_t len)
         uint8_t crc = fp_calculate_crc(data, len - 1);
         if (crc != data[len - 1])
         {
-            TRACE_INFO("Invalid CRC\n");
+            TRACE_ERROR("Invalid CRC\n");
             return_status = FP_INVALID_CRC;
             break;
         }
@@ -299,6 +378,7 @@ fp_api_status_t fp_is_valid_response_frame(uint8_t *data, uint16_t len)
 
 bool fp_is_frame_notification(uint8_t *data, uint16_t len)
 {
+   (void)len;
    return (MROVER_RC_NOTIFY_EVENTS == data[0]?true:false);
 }
 
@@ -313,7 +393,7 @@ fp_api_status_t fp_is_valid_notify_frame(uint8_t *data, uint16_t len)
         uint8_t crc = fp_calculate_crc(data, len - 1);
         if (crc != data[len - 1])
         {
-            TRACE_INFO("Invalid CRC for the notification frame\n");
+            TRACE_ERROR("Invalid CRC for the notification frame\n");
             return_status = FP_INVALID_CRC;
             break;
         }
@@ -322,14 +402,14 @@ fp_api_status_t fp_is_valid_notify_frame(uint8_t *data, uint16_t len)
 
         if(LENGTH_IN_NOTIFICATION_PAYLOAD != u16_len)
         {
-            TRACE_INFO("Invalid length for notification %d\n", u16_len);
+            TRACE_ERROR("Invalid length for notification %d\n", u16_len);
             break;
         }
 
         uint8_t u8_pending_messages = data[3];
         if(MAX_PENDING_MESSAGES < u8_pending_messages)
         {
-            TRACE_INFO("Invalid pending messages %d\n", u8_pending_messages);
+            TRACE_ERROR("Invalid pending messages %d\n", u8_pending_messages);
             break;
         }
 
@@ -342,6 +422,7 @@ fp_api_status_t fp_is_valid_notify_frame(uint8_t *data, uint16_t len)
 
 uint8_t fp_get_pending_event_count(uint8_t *data, uint16_t len)
 {
+    (void)len;
     return data[3];
 }
 
@@ -382,4 +463,73 @@ bool fp_is_single_frame(uint8_t *p_data,uint16_t u16_len)
     }
 
     return b_return_value;
-}
\ No newline at end of file
+}
+
+
+void fp_decoder_init(fp_decoder_t *p_decoder)
+{
+    if (NULL != p_decoder)
+    {
+        memset(p_decoder, 0, sizeof(fp_decoder_t));
+    }
+}
+
+
+fp_api_status_t fp_decoder_feed(fp_decoder_t *p_decoder, const uint8_t *p_data, uint16_t u16_len,
+                                fp_frame_cb frame_cb, void *user_context)
+{
+    fp_api_status_t return_status = FP_SUCCESS;
+
+    if (NULL == p_decoder || NULL == p_data || NULL == frame_cb)
+    {
+        TRACE_ERROR("Invalid parameters for the frame decoder\n");
+        return FP_INVALID_PARAMETERS;
+    }
+
+    for (uint16_t u16_byte = 0; u16_byte < u16_len; u16_byte++)
+    {
+        p_decoder->u8_frame[p_decoder->u16_index++] = p_data[u16_byte];
+
+        // a resync keeps the remaining bytes, so check them until more data is needed
+        bool b_check_again = true;
+        while (b_check_again && p_decoder->u16_index > 0)
+        {
+            switch (fp_decoder_check_prefix(p_decoder))
+            {
+                case FP_PREFIX_NEED_MORE:
+                    b_check_again = false;
+                    break;
+
+                case FP_PREFIX_COMPLETE:
+                {
+                    uint16_t u16_frame_len = p_decoder->u16_expected_len;
+                    frame_cb(p_decoder->u8_frame, u16_frame_len, user_context);
+                    // bytes kept by a resync may hold the next frame
+                    p_decoder->u16_index -= u16_frame_len;
+                    memmove(p_decoder->u8_frame, &p_decoder->u8_frame[u16_frame_len], p_decoder->u16_index);
+                    p_decoder->u16_expected_len = 0;
+                    break;
+                }
+
+                case FP_PREFIX_BAD_CRC:
+                    TRACE_ERROR("Invalid CRC, resynchronizing the frame decoder\n");
+                    p_decoder->u32_crc_errors++;
+                    return_status = FP_INVALID_CRC;
+                    fp_decoder_resync(p_decoder);
+                    break;
+
+                case FP_PREFIX_INVALID:
+                default:
+                    TRACE_ERROR("Invalid frame header 0x%02x, resynchronizing the frame decoder\n", p_decoder->u8_frame[0]);
+                    if (FP_SUCCESS == return_status)
+                    {
+                        return_status = FP_ERROR;
+                    }
+                    fp_decoder_resync(p_decoder);
+                    break;
+            }
+        }
+    }
+
+    return return_status;
+}
@@ -0,0 +1,193 @@
+/**
+ * @file bench_ble_conn.cpp
+ * @author OXIT embedded firmware team
+ * @brief Uplink latency and connection reuse of the sidewalk ble connection over 24 h of bursts, in virtual time.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_mcm.h"
+#include <map>
+
+/******************************************************************************
+ * MACROS AND DEFINES
+ ******************************************************************************/
+#define BENCH_HOURS                 (24)
+#define BENCH_BURST_PERIOD_MS       (5 * 60000UL)
+#define BENCH_BURST_TIMEOUT_MS      (120000UL)
+#define BENCH_PAYLOAD_LEN           (20)
+
+/**
+ * @brief Latency of the former send path, the connection request and its response, 5 s of delay() and the tx
+ */
+#define BENCH_BLOCKING_PATH_MS      (5000 + 400)
+
+/******************************************************************************
+ * TYPEDEFS
+ ******************************************************************************/
+typedef struct
+{
+    const char *p_name;
+    const char *p_script;
+    uint8_t u8_uplinks;                             // per burst
+    uint32_t u32_spacing_ms;                        // between the uplinks of a burst
+} bench_scenario_t;
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static const bench_scenario_t s_scenarios[] =
+{
+    { "1 per burst",          "ble 1200 60000\nlink 1000\ntxdone noack 400\n", 1, 0 },
+    { "5 per burst, 2 s",     "ble 1200 60000\nlink 1000\ntxdone noack 400\n", 5, 2000 },
+    { "10 per burst, 0.5 s",  "ble 1200 60000\nlink 1000\ntxdone noack 400\n", 10, 500 },
+    { "peer closes at 20 s",  "ble 1200 20000\nlink 1000\ntxdone noack 400\n", 3, 25000 },
+};
+
+static std::map<uint32_t, uint64_t> s_queued_us;
+static uint64_t s_latency_sum_us;
+static uint64_t s_latency_max_us;
+static uint32_t s_delivered;
+static uint32_t s_results;
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static void on_uplink_result(uint32_t msg_id, MCM_TX_STATUS status, uint8_t attempts)
+{
+    (void)attempts;
+    uint64_t u64_latency_us = host_hal_get_time_us() - s_queued_us[msg_id];
+
+    s_results++;
+    if (MCM_TX_STATUS::MCM_TX_NOT_SEND != status)
+    {
+        s_delivered++;
+    }
+    s_latency_sum_us += u64_latency_us;
+    s_latency_max_us = std::max(s_latency_max_us, u64_latency_us);
+}
+
+/**
+ * @brief Queues the uplinks of a burst on time and runs the loop until each has its result.
+ */
+static bool run_burst(TestMcm &t, const bench_scenario_t &scenario)
+{
+    uint8_t payload[BENCH_PAYLOAD_LEN] = {};
+    uint32_t u32_start = millis();
+    uint32_t u32_expected = s_results + scenario.u8_uplinks;
+    uint8_t u8_queued = 0;
+
+    while (s_results < u32_expected)
+    {
+        if ((u8_queued < scenario.u8_uplinks) && ((millis() - u32_start) >= (u8_queued * scenario.u32_spacing_ms)))
+        {
+            uint32_t u32_msg_id = 0;
+            payload[0] = u8_queued;
+            if (MCM_STATUS::MCM_OK != t.mcm.queue_uplink(payload, sizeof(payload), 1, MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF,
+                                                         UPLINK_SCHED_TELEMETRY, &u32_msg_id))
+            {
+                return false;
+            }
+            s_queued_us[u32_msg_id] = host_hal_get_time_us();
+            u8_queued++;
+        }
+        if ((millis() - u32_start) > BENCH_BURST_TIMEOUT_MS)
+        {
+            return false;
+        }
+        t.mcm.handle_rx_events();
+        delay(1);
+    }
+    return true;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    const uint32_t u32_bursts = BENCH_HOURS * 3600000UL / BENCH_BURST_PERIOD_MS;
+
+    printf("%-22s %8s %10s %10s %8s %10s\n", "scenario", "uplinks", "mean ms", "max ms", "per conn", "not sent");
+    for (const bench_scenario_t &scenario : s_scenarios)
+    {
+        TestMcm t(scenario.p_script);
+
+        s_queued_us.clear();
+        s_latency_sum_us = 0;
+        s_latency_max_us = 0;
+        s_delivered = 0;
+        s_results = 0;
+
+        REQUIRE(t.start());
+        t.mcm.set_connect_mode(ConnectionMode::CONNECTION_MODE_SIDEWALK_BLE);
+        REQUIRE(MCM_STATUS::MCM_OK == t.mcm.connect_network());
+        REQUIRE(t.run_until([&]() { return t.mcm.is_connected(); }));
+        t.mcm.set_on_uplink_result_callback(on_uplink_result);
+
+        uint32_t u32_origin = millis() + BENCH_BURST_PERIOD_MS;
+        bool is_ok = true;
+        for (uint32_t u32_burst = 0; is_ok && (u32_burst < u32_bursts); u32_burst++)
+        {
+            // nothing to run between the bursts, the connection times out on the next poll
+            delay(u32_origin + (u32_burst * BENCH_BURST_PERIOD_MS) - millis());
+            is_ok = run_burst(t, scenario);
+        }
+        CHECK(is_ok);
+
+        const ble_conn_stats_t *p_stats = t.mcm.get_ble_connection_stats();
+        uint32_t u32_uplinks = u32_bursts * scenario.u8_uplinks;
+        double mean_ms = (s_results > 0) ? (s_latency_sum_us / 1000.0 / s_results) : 0;
+        double per_connection = (p_stats->u32_connections > 0) ? ((double)s_delivered / p_stats->u32_connections) : 0;
+        uint32_t u32_not_sent = (uint32_t)t.emulator.get_uplinks().size() - s_delivered;
+        printf("%-22s %8lu %10.2f %10.2f %8.1f %10lu\n", scenario.p_name, (unsigned long)u32_uplinks, mean_ms,
+               s_latency_max_us / 1000.0, per_connection, (unsigned long)u32_not_sent);
+
+        CHECK_EQ(s_results, u32_uplinks);
+        CHECK_EQ(s_delivered, u32_uplinks);
+        CHECK(mean_ms < BENCH_BLOCKING_PATH_MS);
+        // a connection per burst while the peer keeps it for the whole burst
+        if (0 == u32_not_sent)
+        {
+            CHECK(p_stats->u32_connections <= u32_bursts + 1);
+        }
+    }
+    printf("former blocking path: at least %d ms per uplink\n", BENCH_BLOCKING_PATH_MS);
+    return test_result("bench_ble_conn");
+}
@@ -0,0 +1,246 @@
+/**
+ * @file bench_checksum.cpp
+ * @author OXIT embedded firmware team
+ * @brief Throughput of the crc16 CCITT and xor checksum variants, against the bitwise and bytewise loops they replaced.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_common.h"
+#include "checksum.h"
+#include <chrono>
+#include <vector>
+
+/******************************************************************************
+ * MACROS AND DEFINES
+ ******************************************************************************/
+#define BENCH_BYTES_PER_RUN         (32 * 1024 * 1024)
+#define BENCH_BLOCK_LEN             (1024)              // ymodem data block
+#define BENCH_FRAME_LEN             (7)                 // GET_EVENT frame without its checksum
+
+/******************************************************************************
+ * TYPEDEFS
+ ******************************************************************************/
+typedef uint32_t (*bench_kernel_t)(const uint8_t *p_data, uint32_t u32_len);
+
+typedef struct
+{
+    const char *p_name;
+    bench_kernel_t kernel;
+} bench_case_t;
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static uint16_t s_crc16_table[8][256];                  // s_crc16_table[k][i], crc of the byte i followed by k zero bytes
+static volatile uint32_t s_sink;
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+/**
+ * @brief The former loop of YModem::calculateCRC() and of the uplink journal
+ */
+static uint32_t crc16_bitwise(const uint8_t *p_data, uint32_t u32_len)
+{
+    uint16_t u16_crc = 0;
+
+    for (uint32_t i = 0; i < u32_len; i++)
+    {
+        u16_crc ^= (uint16_t)p_data[i] << 8;
+        for (uint8_t j = 0; j < 8; j++)
+        {
+            u16_crc = (u16_crc & 0x8000) ? ((u16_crc << 1) ^ 0x1021) : (u16_crc << 1);
+        }
+    }
+    return u16_crc;
+}
+
+static uint32_t crc16_table_by_byte(const uint8_t *p_data, uint32_t u32_len)
+{
+    uint16_t u16_crc = 0;
+
+    while (0 != u32_len--)
+    {
+        u16_crc = (uint16_t)(u16_crc << 8) ^ s_crc16_table[0][(u16_crc >> 8) ^ *p_data++];
+    }
+    return u16_crc;
+}
+
+static uint32_t crc16_slice_by_4(const uint8_t *p_data, uint32_t u32_len)
+{
+    return checksum_crc16_ccitt(CHECKSUM_CRC16_XMODEM_INIT, p_data, u32_len);
+}
+
+/**
+ * @brief Slice by 8, twice the tables of checksum.c
+ */
+static uint32_t crc16_slice_by_8(const uint8_t *p_data, uint32_t u32_len)
+{
+    uint16_t u16_crc = 0;
+
+    while (u32_len >= 8)
+    {
+        u16_crc = s_crc16_table[7][(u16_crc >> 8) ^ p_data[0]] ^ s_crc16_table[6][(u16_crc & 0xFF) ^ p_data[1]] ^
+                  s_crc16_table[5][p_data[2]] ^ s_crc16_table[4][p_data[3]] ^ s_crc16_table[3][p_data[4]] ^
+                  s_crc16_table[2][p_data[5]] ^ s_crc16_table[1][p_data[6]] ^ s_crc16_table[0][p_data[7]];
+        p_data += 8;
+        u32_len -= 8;
+    }
+    while (0 != u32_len--)
+    {
+        u16_crc = (uint16_t)(u16_crc << 8) ^ s_crc16_table[0][(u16_crc >> 8) ^ *p_data++];
+    }
+    return u16_crc;
+}
+
+/**
+ * @brief The former loop of fp_calculate_crc()
+ */
+static uint32_t xor_bytewise(const uint8_t *p_data, uint32_t u32_len)
+{
+    uint8_t u8_xor = 0;
+
+    for (uint32_t i = 0; i < u32_len; i++)
+    {
+        u8_xor ^= p_data[i];
+    }
+    return u8_xor;
+}
+
+static uint32_t xor_word_folded(const uint8_t *p_data, uint32_t u32_len)
+{
+    return checksum_xor8(0, p_data, u32_len);
+}
+
+static void init_tables()
+{
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint8_t u8_byte = (uint8_t)i;
+        s_crc16_table[0][i] = (uint16_t)crc16_bitwise(&u8_byte, 1);
+    }
+    for (uint32_t k = 1; k < 8; k++)
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint16_t u16_prev = s_crc16_table[k - 1][i];
+            s_crc16_table[k][i] = (uint16_t)(u16_prev << 8) ^ s_crc16_table[0][u16_prev >> 8];
+        }
+    }
+}
+
+/**
+ * @brief MB/s over buffers of u32_len bytes, best of three runs. The kernels are called through a
+ * pointer, none of them is inlined into the loop.
+ */
+static double measure(bench_kernel_t kernel, const std::vector<uint8_t> &data, uint32_t u32_len)
+{
+    uint32_t u32_count = (uint32_t)(data.size() / u32_len);
+    uint32_t u32_rounds = BENCH_BYTES_PER_RUN / (u32_count * u32_len);
+    double d_best_s = 1e30;
+
+    for (int run = 0; run < 3; run++)
+    {
+        uint32_t u32_sink = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t u32_round = 0; u32_round < u32_rounds; u32_round++)
+        {
+            for (uint32_t i = 0; i < u32_count; i++)
+            {
+                u32_sink += kernel(data.data() + (size_t)i * u32_len, u32_len);
+            }
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        d_best_s = std::min(d_best_s, elapsed.count());
+        s_sink = u32_sink;
+    }
+    return ((double)u32_rounds * u32_count * u32_len) / d_best_s / 1e6;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    static bench_case_t s_crc_cases[] = {
+        { "crc16 bitwise (before)", crc16_bitwise },
+        { "crc16 table by byte", crc16_table_by_byte },
+        { "crc16 slice by 4", crc16_slice_by_4 },
+        { "crc16 slice by 8", crc16_slice_by_8 },
+    };
+    static bench_case_t s_xor_cases[] = {
+        { "xor bytewise (before)", xor_bytewise },
+        { "xor word folded", xor_word_folded },
+    };
+    std::vector<uint8_t> data(64 * 1024 - 1);           // odd size, the frames start at every alignment
+
+    init_tables();
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = (uint8_t)(i * 131 + (i >> 7));
+    }
+
+    // every variant gives the result of the former loop
+    for (uint32_t u32_len : { (uint32_t)BENCH_FRAME_LEN, (uint32_t)BENCH_BLOCK_LEN, (uint32_t)data.size() })
+    {
+        for (const bench_case_t &c : s_crc_cases)
+        {
+            CHECK_EQ(c.kernel(data.data(), u32_len), crc16_bitwise(data.data(), u32_len));
+        }
+        for (const bench_case_t &c : s_xor_cases)
+        {
+            CHECK_EQ(c.kernel(data.data() + 1, u32_len - 1), xor_bytewise(data.data() + 1, u32_len - 1));
+        }
+    }
+
+    printf("MB/s, %u MB per run, best of 3\n", (unsigned)(BENCH_BYTES_PER_RUN / (1024 * 1024)));
+    printf("%-24s %14s %14s\n", "", "1024 B blocks", "7 B frames");
+    for (bench_case_t *p_cases : { s_crc_cases, s_xor_cases })
+    {
+        size_t count = (p_cases == s_crc_cases) ? (sizeof(s_crc_cases) / sizeof(s_crc_cases[0])) : (sizeof(s_xor_cases) / sizeof(s_xor_cases[0]));
+        for (size_t i = 0; i < count; i++)
+        {
+            printf("%-24s %14.0f %14.0f\n", p_cases[i].p_name, measure(p_cases[i].kernel, data, BENCH_BLOCK_LEN),
+                   measure(p_cases[i].kernel, data, BENCH_FRAME_LEN));
+        }
+    }
+    return test_result("bench_checksum");
+}
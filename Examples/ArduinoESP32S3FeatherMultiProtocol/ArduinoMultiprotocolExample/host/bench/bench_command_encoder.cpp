@@ -0,0 +1,262 @@
+/**
+ * @file bench_command_encoder.cpp
+ * @author OXIT embedded firmware team
+ * @brief Encode cost of a GET_EVENT and a 50 byte uplink, descriptor table against the former hand written builders.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_common.h"
+#include "api_processor.h"
+#include <string.h>
+#include <chrono>
+#include <vector>
+
+/******************************************************************************
+ * MACROS AND DEFINES
+ ******************************************************************************/
+#define BENCH_ROUNDS                (2000000)
+#define BENCH_UPLINK_LEN            (50)
+#define BENCH_LONG_UPLINK_LEN       (LORAWAN_TX_MAX_FRAME_PAYLOAD_SIZE)                     // the largest the former buffer held
+#define BENCH_UPLINK_PORT           (10)
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static mcm_module_hdl_t s_module;
+static mcm_module_hdl_t s_vector_module;
+static uint8_t s_payload[BENCH_UPLINK_LEN];
+static uint8_t s_long_payload[BENCH_LONG_UPLINK_LEN];
+static volatile uint32_t s_sink;
+static std::vector<uint8_t> s_last_frame;
+static bool s_is_recording = false;
+
+/**
+ * @brief Send buffer of the former builders, cleared in full for every command
+ */
+static uint8_t s_reference_buffer[MAX_SERIAL_SEND_PAYLOAD_SIZE];
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static uint16_t on_send(uint8_t *data, uint16_t size, void *user_context)
+{
+    (void)user_context;
+    s_sink = s_sink + data[size - 1];
+    if (s_is_recording)
+    {
+        s_last_frame.assign(data, data + size);
+    }
+    return size;
+}
+
+static uint16_t on_send_vector(const serial_tx_segment_t *p_segments, uint8_t u8_count, void *user_context)
+{
+    (void)user_context;
+    uint16_t u16_size = 0;
+
+    for (uint8_t i = 0; i < u8_count; i++)
+    {
+        u16_size += p_segments[i].u16_len;
+    }
+    s_sink = s_sink + p_segments[u8_count - 1].p_data[p_segments[u8_count - 1].u16_len - 1];
+    return u16_size;
+}
+
+static void on_notification(void *user_context)
+{
+    (void)user_context;
+}
+
+static void on_response(const api_processor_response_t *response, void *user_context)
+{
+    (void)response;
+    (void)user_context;
+}
+
+/**
+ * @brief GET_EVENT the way the former api_processor_cmd_get_event() built it.
+ */
+static api_processor_status_t reference_get_event()
+{
+    const uint16_t u16_frame_len = 6;
+
+    memset(s_reference_buffer, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
+    s_reference_buffer[0] = COMMAND_TYPE_GENERAL;
+    s_reference_buffer[1] = MROVER_CC_GET_EVENT >> 8;
+    s_reference_buffer[2] = MROVER_CC_GET_EVENT & 0xFF;
+    s_reference_buffer[3] = 0;
+    s_reference_buffer[4] = 0;
+    s_reference_buffer[5] = 0;
+    if (FP_SUCCESS != fp_append_crc(s_reference_buffer, u16_frame_len))
+    {
+        return API_PROCESSOR_ERROR;
+    }
+    return (u16_frame_len == on_send(s_reference_buffer, u16_frame_len, NULL)) ? API_PROCESSOR_SUCCESS : API_PROCESSOR_SERIAL_PORT_ERROR;
+}
+
+/**
+ * @brief Lorawan uplink the way the former api_processor_cmd_request_lorawan_uplink() built it, checks included.
+ */
+static api_processor_status_t reference_lorawan_uplink(uint8_t u8_port, uint8_t *p_payload, uint16_t u16_payload_size, mrover_uplink_type_t h_uplink_type)
+{
+    if ((LORAWAN_TX_MAX_PAYLOAD_SIZE < u16_payload_size) || (0 == u8_port) || (225 <= u8_port) ||
+        ((NULL != p_payload) && (0 == u16_payload_size)) || ((NULL == p_payload) && (0 != u16_payload_size)) ||
+        (MROVER_CONFIRMED_UPLINK < h_uplink_type))
+    {
+        return API_PROCESSOR_INVALID_PARAMETERS;
+    }
+
+    uint16_t u16_payload_len = u16_payload_size + 2;
+    memset(s_reference_buffer, 0, MAX_SERIAL_SEND_PAYLOAD_SIZE);
+    s_reference_buffer[0] = COMMAND_TYPE_LORAWAN;
+    s_reference_buffer[1] = MROVER_CC_REQUEST_UPLINK >> 8;
+    s_reference_buffer[2] = MROVER_CC_REQUEST_UPLINK & 0xFF;
+    s_reference_buffer[3] = u16_payload_len >> 8;
+    s_reference_buffer[4] = u16_payload_len & 0xFF;
+    s_reference_buffer[5] = u8_port;
+    s_reference_buffer[6] = h_uplink_type;
+    memcpy(&s_reference_buffer[7], p_payload, u16_payload_size);
+
+    const uint16_t u16_frame_len = MIN_TX_PAYLOAD_LEN + u16_payload_len;
+    if (FP_SUCCESS != fp_append_crc(s_reference_buffer, u16_frame_len))
+    {
+        return API_PROCESSOR_ERROR;
+    }
+    return (u16_frame_len == on_send(s_reference_buffer, u16_frame_len, NULL)) ? API_PROCESSOR_SUCCESS : API_PROCESSOR_SERIAL_PORT_ERROR;
+}
+
+static void encode_reference()
+{
+    reference_get_event();
+    reference_lorawan_uplink(BENCH_UPLINK_PORT, s_payload, sizeof(s_payload), MROVER_UNCONFIRMED_UPLINK);
+}
+
+static void encode_table()
+{
+    api_processor_cmd_get_event(&s_module);
+    api_processor_cmd_request_lorawan_uplink(&s_module, BENCH_UPLINK_PORT, s_payload, sizeof(s_payload), MROVER_UNCONFIRMED_UPLINK);
+}
+
+/**
+ * @brief The table encoder wired the way MCM does it, the frame goes out as header, data and crc segments.
+ */
+static void encode_table_vector()
+{
+    api_processor_cmd_get_event(&s_vector_module);
+    api_processor_cmd_request_lorawan_uplink(&s_vector_module, BENCH_UPLINK_PORT, s_payload, sizeof(s_payload), MROVER_UNCONFIRMED_UPLINK);
+}
+
+/**
+ * @brief ns per call of encode, best of three runs.
+ */
+template <typename T>
+static double measure(T encode)
+{
+    double best_ns = 1e30;
+
+    for (int run = 0; run < 3; run++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < BENCH_ROUNDS; i++)
+        {
+            encode();
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        best_ns = std::min(best_ns, elapsed.count() / BENCH_ROUNDS);
+    }
+    return best_ns;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    for (size_t i = 0; i < sizeof(s_payload); i++)
+    {
+        s_payload[i] = (uint8_t)(i * 13 + 1);
+    }
+    for (size_t i = 0; i < sizeof(s_long_payload); i++)
+    {
+        s_long_payload[i] = (uint8_t)(i * 7 + 3);
+    }
+    REQUIRE(API_PROCESSOR_SUCCESS == api_processor_init(&s_module, on_send, on_notification, on_response));
+    REQUIRE(API_PROCESSOR_SUCCESS == api_processor_init(&s_vector_module, on_send, on_notification, on_response));
+    REQUIRE(API_PROCESSOR_SUCCESS == api_processor_set_send_vector_cb(&s_vector_module, on_send_vector));
+
+    // both encoders send the same frames
+    s_is_recording = true;
+    REQUIRE(API_PROCESSOR_SUCCESS == reference_lorawan_uplink(BENCH_UPLINK_PORT, s_payload, sizeof(s_payload), MROVER_UNCONFIRMED_UPLINK));
+    std::vector<uint8_t> reference_frame = s_last_frame;
+    REQUIRE(API_PROCESSOR_SUCCESS == api_processor_cmd_request_lorawan_uplink(&s_module, BENCH_UPLINK_PORT, s_payload, sizeof(s_payload),
+                                                                               MROVER_UNCONFIRMED_UPLINK));
+    CHECK(reference_frame == s_last_frame);
+    REQUIRE(API_PROCESSOR_SUCCESS == reference_lorawan_uplink(BENCH_UPLINK_PORT, s_long_payload, sizeof(s_long_payload), MROVER_UNCONFIRMED_UPLINK));
+    reference_frame = s_last_frame;
+    REQUIRE(API_PROCESSOR_SUCCESS == api_processor_cmd_request_lorawan_uplink(&s_module, BENCH_UPLINK_PORT, s_long_payload, sizeof(s_long_payload),
+                                                                               MROVER_UNCONFIRMED_UPLINK));
+    CHECK(reference_frame == s_last_frame);
+    REQUIRE(API_PROCESSOR_SUCCESS == reference_get_event());
+    reference_frame = s_last_frame;
+    REQUIRE(API_PROCESSOR_SUCCESS == api_processor_cmd_get_event(&s_module));
+    CHECK(reference_frame == s_last_frame);
+    s_is_recording = false;
+
+    double reference_ns = measure(encode_reference);
+    double table_ns = measure(encode_table);
+    double vector_ns = measure(encode_table_vector);
+    printf("%-28s %10s\n", "GET_EVENT + 50 B uplink", "ns");
+    printf("%-28s %10.1f\n", "former builders", reference_ns);
+    printf("%-28s %10.1f\n", "descriptor table", table_ns);
+    printf("%-28s %10.1f\n", "descriptor table, vector", vector_ns);
+
+    reference_ns = measure([]() { reference_lorawan_uplink(BENCH_UPLINK_PORT, s_long_payload, sizeof(s_long_payload), MROVER_UNCONFIRMED_UPLINK); });
+    table_ns = measure([]() {
+        api_processor_cmd_request_lorawan_uplink(&s_module, BENCH_UPLINK_PORT, s_long_payload, sizeof(s_long_payload), MROVER_UNCONFIRMED_UPLINK);
+    });
+    vector_ns = measure([]() {
+        api_processor_cmd_request_lorawan_uplink(&s_vector_module, BENCH_UPLINK_PORT, s_long_payload, sizeof(s_long_payload), MROVER_UNCONFIRMED_UPLINK);
+    });
+    printf("\n%u B uplink %15s %10s\n", (unsigned)BENCH_LONG_UPLINK_LEN, "", "ns");
+    printf("%-28s %10.1f\n", "former builder", reference_ns);
+    printf("%-28s %10.1f\n", "descriptor table", table_ns);
+    printf("%-28s %10.1f\n", "descriptor table, vector", vector_ns);
+    return test_result("bench_command_encoder");
+}
@@ -0,0 +1,182 @@
+/**
+ * @file bench_event_drain.cpp
+ * @author OXIT embedded firmware team
+ * @brief Events drained per second by MCM::handle_rx_events(), with the get event window and one request at a time.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_mcm.h"
+
+/******************************************************************************
+ * MACROS AND DEFINES
+ ******************************************************************************/
+#define BENCH_BURSTS                (20)
+#define BENCH_BURST_EVENTS          (MAX_PENDING_MESSAGES)
+#define BENCH_BURST_PERIOD_MS       (2000)
+#define BENCH_BAUD_RATE             (MROVER_DEFAULT_BAUD_RATE)
+
+/**
+ * @brief Downlink data, the get event response is 20 bytes: 6 byte header, code, pending count, rssi, snr, port,
+ * the data and the crc
+ */
+#define BENCH_DOWNLINK_LEN          (8)
+#define BENCH_RESPONSE_LEN          (6 + 5 + BENCH_DOWNLINK_LEN + 1)
+
+/******************************************************************************
+ * TYPEDEFS
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t u32_events;
+    uint32_t u32_batches;
+    uint64_t u64_last_us;
+} bench_drain_t;
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static const uint32_t s_processing_us[] = { 500, 2000, 5000 };
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static void on_event_batch(const get_event_code_t *events, uint8_t count, void *user_context)
+{
+    bench_drain_t *p_drain = (bench_drain_t *)user_context;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        CHECK_EQ(events[i], MODEM_EVENT_DOWNDATA);
+    }
+    p_drain->u32_events += count;
+    p_drain->u32_batches++;
+    p_drain->u64_last_us = host_hal_get_time_us();
+}
+
+/**
+ * @brief Drains BENCH_BURSTS bursts of downlinks with u32_processing_us of modem processing per command.
+ * @return events per second, from the notification of each burst to the batch callback of its last event
+ */
+static double measure_drain(uint32_t u32_processing_us)
+{
+    TestMcm t;
+    bench_drain_t drain = {};
+    uint64_t u64_drain_us = 0;
+    std::vector<uint8_t> data(BENCH_DOWNLINK_LEN, 0xA5);
+
+    REQUIRE(t.start());
+    REQUIRE(BENCH_BAUD_RATE == t.emulator.get_baud_rate());
+    t.emulator.config().u64_processing_us = u32_processing_us;
+    t.mcm.set_on_event_batch_callback(on_event_batch, &drain);
+
+    for (uint32_t u32_burst = 0; u32_burst < BENCH_BURSTS; u32_burst++)
+    {
+        uint32_t u32_expected = (u32_burst + 1) * BENCH_BURST_EVENTS;
+        uint64_t u64_start_us = host_hal_get_time_us();
+
+        for (uint8_t i = 0; i < BENCH_BURST_EVENTS; i++)
+        {
+            t.emulator.schedule_downlink(u64_start_us, COMMAND_TYPE_LORAWAN, 1 + i, -60, 7, data);
+        }
+        REQUIRE(t.run_until([&]() { return drain.u32_events >= u32_expected; }));
+        CHECK_EQ(drain.u32_events, u32_expected);
+        CHECK_EQ(t.mcm.get_downlink_count(), BENCH_BURST_EVENTS);
+        u64_drain_us += drain.u64_last_us - u64_start_us;
+
+        for (uint8_t i = 0; i < BENCH_BURST_EVENTS; i++)
+        {
+            const mcm_downlink_t *p_downlink = t.mcm.acquire_downlink();
+            REQUIRE(NULL != p_downlink);
+            CHECK_EQ(p_downlink->seq_port, 1 + i);
+            t.mcm.release_downlink(p_downlink);
+        }
+        t.run_for(BENCH_BURST_PERIOD_MS);
+    }
+    // one batch per burst, the window never ends a burst early
+    CHECK_EQ(drain.u32_batches, BENCH_BURSTS);
+    CHECK_EQ(t.emulator.get_pending_events(), 0);
+    return (double)(BENCH_BURSTS * BENCH_BURST_EVENTS) * 1000000.0 / (double)u64_drain_us;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+/**
+ * Without argument, prints the events per second of this build, one processing time per line.
+ * With the path of the build of MCM_EVENT_DRAIN_WINDOW 1, runs it for the before column.
+ */
+int main(int argc, char **argv)
+{
+    double wire_ev_s = BENCH_BAUD_RATE / (BENCH_RESPONSE_LEN * 10.0);
+    double before_ev_s[sizeof(s_processing_us) / sizeof(s_processing_us[0])] = {};
+
+    if (2 > argc)
+    {
+        for (uint32_t u32_processing_us : s_processing_us)
+        {
+            printf("%lu %.1f\n", (unsigned long)u32_processing_us, measure_drain(u32_processing_us));
+        }
+        return test_result("bench_event_drain");
+    }
+
+    FILE *p_before = popen(argv[1], "r");
+    REQUIRE(NULL != p_before);
+    for (size_t i = 0; i < sizeof(s_processing_us) / sizeof(s_processing_us[0]); i++)
+    {
+        unsigned long processing_us = 0;
+        REQUIRE(2 == fscanf(p_before, "%lu %lf", &processing_us, &before_ev_s[i]));
+        REQUIRE(processing_us == s_processing_us[i]);
+    }
+    REQUIRE(0 == pclose(p_before));
+
+    printf("window %d against 1, %lu baud, %d bursts of %d downlinks, wire floor %.1f ev/s\n", MCM_EVENT_DRAIN_WINDOW,
+           (unsigned long)BENCH_BAUD_RATE, BENCH_BURSTS, BENCH_BURST_EVENTS, wire_ev_s);
+    printf("%-18s %12s %12s\n", "modem processing", "before", "after");
+    for (size_t i = 0; i < sizeof(s_processing_us) / sizeof(s_processing_us[0]); i++)
+    {
+        double after_ev_s = measure_drain(s_processing_us[i]);
+        printf("%6.1f ms %16.1f ev/s %7.1f ev/s\n", s_processing_us[i] / 1000.0, before_ev_s[i], after_ev_s);
+
+        CHECK(after_ev_s > before_ev_s[i]);
+        CHECK(after_ev_s <= wire_ev_s);
+    }
+    return test_result("bench_event_drain");
+}
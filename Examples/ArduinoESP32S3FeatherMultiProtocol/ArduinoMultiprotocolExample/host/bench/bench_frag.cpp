@@ -0,0 +1,146 @@
+/**
+ * @file bench_frag.cpp
+ * @author OXIT embedded firmware team
+ * @brief Header overhead of the fragmentation layer per protocol MTU, for the MTU MCM::send_fragmented_uplink() uses.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_common.h"
+#include "commands_defs.h"
+#include "frag.h"
+#include "mcm_rover.h"
+#include <algorithm>
+#include <vector>
+
+/******************************************************************************
+ * MACROS AND DEFINES
+ ******************************************************************************/
+
+/******************************************************************************
+ * TYPEDEFS
+ ******************************************************************************/
+typedef struct
+{
+    const char *p_name;
+    uint16_t u16_mtu;
+} bench_link_t;
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static const bench_link_t s_links[] = {
+    { "CSS", SIDEWALK_TX_MAX_CSS_PAYLOAD_SIZE },
+    { "FSK", SIDEWALK_TX_MAX_FSK_PAYLOAD_SIZE },
+    { "BLE", SIDEWALK_TX_MAX_BLE_PAYLOAD_SIZE },
+    { "LoRaWAN", LORAWAN_TX_MAX_PAYLOAD_SIZE },
+};
+
+static const uint16_t s_message_lens[] = { 256, MCM_FRAG_MAX_PAYLOAD_SIZE };
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+/**
+ * @brief Splits a message and reassembles it, returns the bytes sent over the air.
+ */
+static uint32_t send_message(uint16_t u16_len, uint16_t u16_mtu, uint8_t *p_fragments)
+{
+    static uint8_t s_message[MCM_FRAG_MAX_PAYLOAD_SIZE];
+    static uint8_t s_storage[MCM_FRAG_MAX_PAYLOAD_SIZE];
+    uint8_t au8_fragment[LORAWAN_TX_MAX_PAYLOAD_SIZE];
+    frag_tx_t tx;
+    frag_rx_t rx;
+    uint32_t u32_air_bytes = 0;
+    bool is_complete = false;
+
+    for (uint16_t i = 0; i < u16_len; i++)
+    {
+        s_message[i] = (uint8_t)(i * 7);
+    }
+    REQUIRE(frag_tx_init(&tx, s_message, u16_len, u16_mtu, 1));
+    REQUIRE(frag_rx_init(&rx, s_storage, sizeof(s_storage), MCM_FRAG_RX_TIMEOUT_MS));
+    for (uint8_t i = 0; i < frag_tx_get_count(&tx); i++)
+    {
+        uint16_t u16_msg_len = 0;
+        uint16_t u16_frag_len = frag_tx_build(&tx, i, au8_fragment);
+        CHECK(u16_frag_len <= u16_mtu);
+        is_complete = (FRAG_RX_COMPLETE == frag_rx_push(&rx, au8_fragment, u16_frag_len, 0, &u16_msg_len));
+        u32_air_bytes += u16_frag_len;
+    }
+    CHECK(is_complete);
+    CHECK(0 == memcmp(s_storage, s_message, u16_len));
+    *p_fragments = frag_tx_get_count(&tx);
+    return u32_air_bytes;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    printf("%-8s %4s %4s", "link", "mtu", "used");
+    for (uint16_t u16_len : s_message_lens)
+    {
+        printf("    %4u B: fragments overhead", (unsigned)u16_len);
+    }
+    printf("\n");
+
+    for (const bench_link_t &link : s_links)
+    {
+        // the mtu is capped to what the command encoder can frame, see MCM::send_fragmented_uplink()
+        uint16_t u16_mtu = std::min<uint16_t>(link.u16_mtu, UPLINK_SCHED_MAX_PAYLOAD_SIZE);
+
+        printf("%-8s %4u %4u", link.p_name, (unsigned)link.u16_mtu, (unsigned)u16_mtu);
+        for (uint16_t u16_len : s_message_lens)
+        {
+            uint8_t u8_fragments = 0;
+            uint32_t u32_air_bytes = send_message(u16_len, u16_mtu, &u8_fragments);
+            double overhead = 100.0 * (u32_air_bytes - u16_len) / u32_air_bytes;
+
+            printf("    %16u %7.1f %%", (unsigned)u8_fragments, overhead);
+            CHECK_EQ(u8_fragments, frag_get_count(u16_len, u16_mtu));
+            CHECK_EQ(u32_air_bytes, u16_len + u8_fragments * FRAG_HEADER_LEN);
+            CHECK(u8_fragments <= FRAG_MAX_FRAGMENTS);
+        }
+        printf("\n");
+    }
+    return test_result("bench_frag");
+}
@@ -0,0 +1,177 @@
+/**
+ * @file bench_fw_resume.cpp
+ * @author OXIT embedded firmware team
+ * @brief Flash and line cost of the retry of a YModem firmware transfer broken at 90 %, resumed from the NVS checkpoint or started over.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_mcm.h"
+#include "oxit_nvs.h"
+#include <memory>
+
+/******************************************************************************
+ * MACROS AND DEFINES
+ ******************************************************************************/
+#define BENCH_IMAGE_SIZE            (1000000)
+#define BENCH_TRANSFER_TIMEOUT_MS   (60 * 60000UL)
+
+/******************************************************************************
+ * TYPEDEFS
+ ******************************************************************************/
+typedef struct
+{
+    const char *p_name;
+    bool b_stream_to_ota;
+    bool b_reboot;                                      // the host reboots between the two transfers
+    bool b_resume;                                      // false: the checkpoint is dropped, as before the resume
+} bench_case_t;
+
+typedef struct
+{
+    uint64_t u64_fs_written;                            // of the retry only
+    uint64_t u64_ota_written;
+    uint32_t u32_sectors_erased;
+    uint32_t u32_nvs_writes;
+    uint32_t u32_line_ms;
+    bool b_image_ok;
+} bench_result_t;
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static std::vector<uint8_t> make_image()
+{
+    std::vector<uint8_t> image(BENCH_IMAGE_SIZE);
+
+    for (size_t i = 0; i < image.size(); i++)
+    {
+        image[i] = (uint8_t)((i * 7) ^ (i >> 8));
+    }
+    image[0] = ESP_IMAGE_HEADER_MAGIC;
+    return image;
+}
+
+static void boot(TestMcm &t, const std::vector<uint8_t> &image, bool b_stream_to_ota)
+{
+    t.emulator.config().file = image;
+    REQUIRE(t.start());
+    t.mcm.ymodem.setStreamToOta(b_stream_to_ota);
+}
+
+/**
+ * @brief The first transfer stops at 90 % of the blocks on repeated crc errors, the second one runs to the reboot.
+ */
+static bench_result_t run(const bench_case_t &c, const std::vector<uint8_t> &image)
+{
+    uint32_t u32_blocks = (uint32_t)((image.size() + 1023) / 1024);
+    std::string script = "corrupt " + std::to_string(u32_blocks * 9 / 10 + 1) + " " + std::to_string(YMODEM_MAX_CRC_ERRORS) + "\n";
+    std::unique_ptr<TestMcm> p_t(new TestMcm(script.c_str()));
+    bench_result_t result = {};
+
+    boot(*p_t, image, c.b_stream_to_ota);
+    REQUIRE(MCM_STATUS::MCM_OK == p_t->mcm.start_file_transfer({ 1, 2, 3 }));
+    REQUIRE(p_t->run_until([&]() { return (YMODEM_IDLE == p_t->mcm.ymodem.getState()) && p_t->emulator.get_stats().b_ymodem_cancelled; },
+                           BENCH_TRANSFER_TIMEOUT_MS));
+    p_t->run_for(100);
+    if (!c.b_resume)
+    {
+        nvs_storage_clear_fw_checkpoint();
+    }
+    if (c.b_reboot)
+    {
+        p_t.reset();
+        p_t.reset(new TestMcm("", true));
+        boot(*p_t, image, c.b_stream_to_ota);
+    }
+
+    host_fs_stats_t fs = host_fs_get_stats();
+    host_update_stats_t ota = Update.host_get_stats();
+    host_nvs_stats_t nvs = host_nvs_get_stats();
+    uint32_t u32_start_ms = millis();
+
+    REQUIRE(MCM_STATUS::MCM_OK == p_t->mcm.start_file_transfer({ 1, 2, 3 }));
+    CHECK(p_t->run_until([]() { return 0 < host_hal_get_restart_count(); }, BENCH_TRANSFER_TIMEOUT_MS));
+
+    result.u32_line_ms = millis() - u32_start_ms;
+    result.u64_fs_written = host_fs_get_stats().u64_bytes_written - fs.u64_bytes_written;
+    result.u64_ota_written = Update.host_get_stats().u64_bytes_written - ota.u64_bytes_written;
+    result.u32_sectors_erased = Update.host_get_stats().u32_sectors_erased - ota.u32_sectors_erased;
+    result.u32_nvs_writes = host_nvs_get_stats().u32_writes - nvs.u32_writes;
+    result.b_image_ok = (image == Update.host_get_image());
+    return result;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    static const bench_case_t s_cases[] = {
+        { "streamed, start over", true, false, false },
+        { "streamed, resume", true, false, true },
+        { "streamed, reboot", true, true, true },
+        { "staged, start over", false, false, false },
+        { "staged, resume", false, false, true },
+        { "staged, reboot", false, true, true },
+    };
+    std::vector<uint8_t> image = make_image();
+
+    printf("%u B image, link broken at 90 %%, %u baud, bytes written by the retry\n", (unsigned)BENCH_IMAGE_SIZE, (unsigned)MROVER_DEFAULT_BAUD_RATE);
+    printf("%-22s %10s %10s %8s %6s %8s\n", "", "SPIFFS", "OTA", "erased", "nvs", "line s");
+    for (const bench_case_t &c : s_cases)
+    {
+        bench_result_t result = run(c, image);
+
+        printf("%-22s %10llu %10llu %8u %6u %8.0f\n", c.p_name, (unsigned long long)result.u64_fs_written,
+               (unsigned long long)result.u64_ota_written, (unsigned)result.u32_sectors_erased, (unsigned)result.u32_nvs_writes,
+               result.u32_line_ms / 1000.0);
+        CHECK(result.b_image_ok);
+        if (c.b_resume && !(c.b_stream_to_ota && c.b_reboot))
+        {
+            // only the last tenth reaches the sink and its checkpoints
+            CHECK((c.b_stream_to_ota ? result.u64_ota_written : result.u64_fs_written) <= BENCH_IMAGE_SIZE / 10);
+            CHECK(result.u32_nvs_writes <= BENCH_IMAGE_SIZE / 10 / YMODEM_CHECKPOINT_INTERVAL);
+        }
+        // the resent blocks cost the line time in every case, the mcm always sends from block 0
+        CHECK(BENCH_IMAGE_SIZE * 10 / MROVER_DEFAULT_BAUD_RATE <= result.u32_line_ms / 1000);
+    }
+    return test_result("bench_fw_resume");
+}
@@ -0,0 +1,274 @@
+/**
+ * @file bench_link_select.cpp
+ * @author OXIT embedded firmware team
+ * @brief Delivery and delivery per joule of a device moving between coverage zones, one link against the automatic failover.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_common.h"
+#include "link_select.h"
+#include "mcm_rover.h"
+#include <random>
+#include <vector>
+
+/******************************************************************************
+ * MACROS AND DEFINES
+ ******************************************************************************/
+#define BENCH_SEEDS                 (10)
+#define BENCH_DAYS                  (7)
+#define BENCH_STEP_MS               (60000UL)           // one uplink per minute
+#define BENCH_STEPS                 (BENCH_DAYS * 24 * 60)
+#define BENCH_ZONE_MEAN_STEPS       (30)
+#define BENCH_JOIN_COST             (3)                 // energy of a join, in uplink attempts
+#define BENCH_DOWNLINK_PCT          (10)                // delivered uplinks followed by a downlink
+
+#define LORAWAN                     ((uint8_t)ConnectionMode::CONNECTION_MODE_LORAWAN)
+#define FSK                         ((uint8_t)ConnectionMode::CONNECTION_MODE_SIDEWALK_FSK)
+#define CSS                         ((uint8_t)ConnectionMode::CONNECTION_MODE_SIDEWALK_CSS)
+
+/******************************************************************************
+ * TYPEDEFS
+ ******************************************************************************/
+typedef enum
+{
+    POLICY_SINGLE,                                      // the first link, never left
+    POLICY_AUTO,                                        // link_select with the thresholds of MCM
+    POLICY_AUTO_NO_HYSTERESIS,                          // link_select without dwell, margin or delivery floor
+    POLICY_ORACLE,                                      // best link of the zone, known when the zone starts
+} bench_policy_t;
+
+typedef struct
+{
+    const char *p_name;
+    bench_policy_t policy;
+    uint8_t au8_links[2];
+    uint8_t u8_link_count;
+} bench_case_t;
+
+typedef struct
+{
+    double ad_delivery[LINK_SELECT_MAX_LINKS];          // chance an uplink attempt is delivered
+    double ad_snr[LINK_SELECT_MAX_LINKS];               // mean downlink snr
+} bench_zone_t;
+
+typedef struct
+{
+    uint64_t u64_uplinks;
+    uint64_t u64_delivered;
+    uint64_t u64_energy_mj;
+    uint64_t u64_switches;
+    uint64_t u64_not_joined;                            // uplinks lost while joining
+} bench_result_t;
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+// thresholds and profiles of MCM, see s_link_select_config and s_link_select_profiles
+static const link_select_config_t s_config = { 6, 60, 50, 70, 25, 50, 30 * 60000UL, 5 * 60000UL, 30 * 60000UL };
+static const link_select_config_t s_config_no_hysteresis = { 6, 60, 50, 0, 0, 50, 0, 5 * 60000UL, 30 * 60000UL };
+static const link_select_profile_t s_profiles[LINK_SELECT_MAX_LINKS] = {
+    { false, 0, LINK_SELECT_NO_SNR_MIN },
+    { false, 30, -10 },
+    { false, 50, LINK_SELECT_NO_SNR_MIN },
+    { false, 8, 3 },
+    { false, 80, -10 },
+};
+
+static const bench_case_t s_cases[] = {
+    { "LoRaWAN only", POLICY_SINGLE, { LORAWAN }, 1 },
+    { "FSK only", POLICY_SINGLE, { FSK }, 1 },
+    { "auto LoRaWAN+FSK", POLICY_AUTO, { LORAWAN, FSK }, 2 },
+    { "auto LoRaWAN+CSS", POLICY_AUTO, { LORAWAN, CSS }, 2 },
+    { "oracle LoRaWAN+FSK", POLICY_ORACLE, { LORAWAN, FSK }, 2 },
+    { "no hysteresis LoRaWAN+FSK", POLICY_AUTO_NO_HYSTERESIS, { LORAWAN, FSK }, 2 },
+};
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+/**
+ * @brief Coverage of a zone: lorawan mostly fair with holes, fsk good near a gateway and absent
+ * otherwise, css of long range. The snr follows the delivery, below the floor of the link when it fails.
+ */
+static bench_zone_t make_zone(std::mt19937 *p_rng)
+{
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    bench_zone_t zone = {};
+    double d_draw = uniform(*p_rng);
+
+    zone.ad_delivery[LORAWAN] = (d_draw < 0.6) ? 0.95 : (d_draw < 0.85) ? 0.7 : 0.2;
+    zone.ad_delivery[FSK] = (uniform(*p_rng) < 0.55) ? 0.97 : 0.05;
+    zone.ad_delivery[CSS] = (uniform(*p_rng) < 0.8) ? 0.95 : 0.3;
+    for (uint8_t link : { LORAWAN, FSK, CSS })
+    {
+        zone.ad_snr[link] = s_profiles[link].i8_snr_min_db + (zone.ad_delivery[link] - 0.6) * 15.0;
+    }
+    return zone;
+}
+
+/**
+ * @brief Candidate of the best delivery per joule reaching 70 %, otherwise of the best delivery
+ */
+static uint8_t oracle_link(const bench_case_t &c, const bench_zone_t &zone)
+{
+    uint8_t u8_best = c.au8_links[0];
+    double d_best = -1.0;
+
+    for (uint8_t i = 0; i < c.u8_link_count; i++)
+    {
+        uint8_t link = c.au8_links[i];
+        double d_delivery = zone.ad_delivery[link];
+        double d_value = (d_delivery >= 0.7) ? (1000.0 + d_delivery / s_profiles[link].u16_energy_mj) : d_delivery;
+        if (d_value > d_best)
+        {
+            u8_best = link;
+            d_best = d_value;
+        }
+    }
+    return u8_best;
+}
+
+static bench_result_t run(const bench_case_t &c, uint32_t u32_seed)
+{
+    std::mt19937 rng(u32_seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::normal_distribution<double> noise(0.0, 2.0);
+    link_select_t select;
+    bench_result_t result = {};
+    bench_zone_t zone = make_zone(&rng);
+    uint8_t u8_link = c.au8_links[0];
+    bool b_joined = false;
+
+    link_select_init(&select, (POLICY_AUTO_NO_HYSTERESIS == c.policy) ? &s_config_no_hysteresis : &s_config, u8_link, 0);
+    for (uint8_t i = 0; i < c.u8_link_count; i++)
+    {
+        link_select_profile_t profile = s_profiles[c.au8_links[i]];
+        profile.b_candidate = true;
+        link_select_set_profile(&select, c.au8_links[i], &profile);
+    }
+
+    for (uint32_t u32_step = 0; u32_step < BENCH_STEPS; u32_step++)
+    {
+        uint32_t u32_now_ms = u32_step * BENCH_STEP_MS;
+        uint16_t u16_energy_mj = s_profiles[u8_link].u16_energy_mj;
+        uint8_t u8_next = u8_link;
+
+        if (0 == (rng() % BENCH_ZONE_MEAN_STEPS))
+        {
+            zone = make_zone(&rng);
+        }
+        result.u64_uplinks++;
+
+        if (!b_joined)
+        {
+            // the uplink of the step waits behind the join and is lost
+            result.u64_not_joined++;
+            result.u64_energy_mj += BENCH_JOIN_COST * u16_energy_mj;
+            b_joined = uniform(rng) < zone.ad_delivery[u8_link];
+            if (!b_joined)
+            {
+                link_select_on_join_failure(&select, u8_link, u32_now_ms);
+            }
+        }
+        else
+        {
+            bool b_delivered = uniform(rng) < zone.ad_delivery[u8_link];
+            result.u64_energy_mj += u16_energy_mj;
+            result.u64_delivered += b_delivered ? 1 : 0;
+            link_select_on_tx(&select, u8_link, b_delivered, u32_now_ms);
+            if (b_delivered && ((rng() % 100) < BENCH_DOWNLINK_PCT))
+            {
+                link_select_on_downlink(&select, u8_link, -100, (int8_t)(zone.ad_snr[u8_link] + noise(rng)), u32_now_ms);
+            }
+        }
+
+        if (POLICY_ORACLE == c.policy)
+        {
+            u8_next = oracle_link(c, zone);
+        }
+        else if (POLICY_SINGLE != c.policy)
+        {
+            u8_next = link_select_evaluate(&select, b_joined, u32_now_ms);
+        }
+        if (u8_next != u8_link)
+        {
+            u8_link = u8_next;
+            b_joined = false;
+            link_select_set_current(&select, u8_link, u32_now_ms);
+            result.u64_switches++;
+        }
+    }
+    return result;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    bench_result_t results[sizeof(s_cases) / sizeof(s_cases[0])] = {};
+
+    printf("%u seeds x %u days, one uplink per minute, zones of %u min on average, a join costs %u attempts\n", (unsigned)BENCH_SEEDS,
+           (unsigned)BENCH_DAYS, (unsigned)BENCH_ZONE_MEAN_STEPS, (unsigned)BENCH_JOIN_COST);
+    printf("%-28s %9s %13s %13s %11s\n", "", "delivered", "delivered/J", "switches/day", "not joined");
+    for (size_t i = 0; i < sizeof(s_cases) / sizeof(s_cases[0]); i++)
+    {
+        bench_result_t *p_total = &results[i];
+        for (uint32_t u32_seed = 1; u32_seed <= BENCH_SEEDS; u32_seed++)
+        {
+            bench_result_t result = run(s_cases[i], u32_seed);
+            p_total->u64_uplinks += result.u64_uplinks;
+            p_total->u64_delivered += result.u64_delivered;
+            p_total->u64_energy_mj += result.u64_energy_mj;
+            p_total->u64_switches += result.u64_switches;
+            p_total->u64_not_joined += result.u64_not_joined;
+        }
+        printf("%-28s %8.1f%% %13.1f %13.1f %10.1f%%\n", s_cases[i].p_name, 100.0 * p_total->u64_delivered / p_total->u64_uplinks,
+               1000.0 * p_total->u64_delivered / p_total->u64_energy_mj, (double)p_total->u64_switches / (BENCH_SEEDS * BENCH_DAYS),
+               100.0 * p_total->u64_not_joined / p_total->u64_uplinks);
+    }
+
+    // the failover delivers more than either link alone, and the hysteresis cuts the switches
+    CHECK(results[2].u64_delivered > results[0].u64_delivered);
+    CHECK(results[2].u64_delivered > results[1].u64_delivered);
+    CHECK(results[5].u64_switches > results[2].u64_switches);
+    return test_result("bench_link_select");
+}
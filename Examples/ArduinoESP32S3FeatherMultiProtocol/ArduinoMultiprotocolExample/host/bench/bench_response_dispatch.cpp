@@ -0,0 +1,264 @@
+/**
+ * @file bench_response_dispatch.cpp
+ * @author OXIT embedded firmware team
+ * @brief Frames per second of the receive path on a stream of a million mixed frames, validation tables against the former switches.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_common.h"
+#include "api_processor.h"
+#include "checksum.h"
+#include <chrono>
+#include <vector>
+
+/******************************************************************************
+ * MACROS AND DEFINES
+ ******************************************************************************/
+#define BENCH_FRAMES                (1000000)
+#define BENCH_CHUNK_LEN             (64)
+
+/******************************************************************************
+ * TYPEDEFS
+ ******************************************************************************/
+typedef std::vector<uint8_t> frame_t;
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static mcm_module_hdl_t s_module;
+static uint32_t s_responses;
+static uint32_t s_notifications;
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static uint16_t on_send(uint8_t *data, uint16_t size, void *user_context)
+{
+    (void)data;
+    (void)user_context;
+    return size;
+}
+
+static void on_notification(void *user_context)
+{
+    (void)user_context;
+    s_notifications++;
+}
+
+static void on_response(const api_processor_response_t *response, void *user_context)
+{
+    (void)response;
+    (void)user_context;
+    s_responses++;
+}
+
+static frame_t make_frame(uint8_t u8_return_code, uint8_t u8_type, uint16_t u16_code, const frame_t &payload)
+{
+    frame_t frame = { u8_return_code, u8_type, (uint8_t)(u16_code >> 8), (uint8_t)u16_code,
+                      (uint8_t)(payload.size() >> 8), (uint8_t)payload.size() };
+    for (uint8_t u8_byte : payload)
+    {
+        frame.push_back(u8_byte);
+    }
+    frame.push_back(checksum_xor8(0, frame.data(), frame.size()));
+    return frame;
+}
+
+/**
+ * @brief The traffic of a busy link: notifications, events, uplink responses and a few other commands.
+ */
+static std::vector<frame_t> make_mix()
+{
+    frame_t notification = { MROVER_RC_NOTIFY_EVENTS, 0x00, 0x01, 0x02 };
+    notification.push_back(checksum_xor8(0, notification.data(), notification.size()));
+    frame_t downlink = { MODEM_EVENT_DOWNDATA, 1, 0xC4, 0x07, 0x0A };
+    downlink.insert(downlink.end(), 20, 0x5A);
+
+    return
+    {
+        notification,
+        make_frame(MROVER_RC_OK, COMMAND_TYPE_LORAWAN, MROVER_CC_GET_EVENT, { MODEM_EVENT_TXDONE, 1, MROVER_TX_DONE_WITH_ACK }),
+        make_frame(MROVER_RC_OK, COMMAND_TYPE_LORAWAN, MROVER_CC_GET_EVENT, downlink),
+        make_frame(MROVER_RC_OK, COMMAND_TYPE_LORAWAN, MROVER_CC_REQUEST_UPLINK, { 0x00, 0x2A }),
+        make_frame(MROVER_RC_OK, COMMAND_TYPE_GENERAL, MROVER_CC_GET_EVENT, { MODEM_EVENT_NONE, 0 }),
+        make_frame(MROVER_RC_OK, COMMAND_TYPE_SIDEWALK, MROVER_CC_BLE_CONNECTION_REQUEST, {}),
+        make_frame(MROVER_RC_OK, COMMAND_TYPE_LORAWAN, MROVER_CC_GET_DEV_EUI, { 1, 2, 3, 4, 5, 6, 7, 8 }),
+        make_frame(MROVER_RC_FAIL, COMMAND_TYPE_LORAWAN, MROVER_CC_JOIN_LORAWAN, {}),
+    };
+}
+
+/**
+ * @brief The former switch based response frame check of frame_parser.c, traces removed.
+ */
+static bool reference_is_valid_response_frame(const uint8_t *data, uint16_t len)
+{
+    switch (data[0])
+    {
+        case MROVER_RC_OK:
+        case MROVER_RC_UNKNOWN:
+        case MROVER_RC_NOT_IMPLEMENTED:
+        case MROVER_RC_FAIL:
+        case MROVER_RC_BAD_CRC:
+        case MROVER_RC_BAD_SIZE:
+        case MROVER_RC_NOTIFY_EVENTS:
+        case MROVER_RC_GPS_TIME_NOT_AVAILABLE:
+            break;
+        default:
+            return false;
+    }
+
+    switch (data[1])
+    {
+        case COMMAND_TYPE_GENERAL:
+        case COMMAND_TYPE_LORAWAN:
+        case COMMAND_TYPE_SIDEWALK:
+            break;
+        default:
+            return false;
+    }
+
+    switch ((data[2] << 8) | data[3])
+    {
+        case MROVER_CC_GET_EVENT:
+        case MROVER_CC_GET_VERSION:
+        case MROVER_CC_RESET:
+        case MROVER_CC_FACTORY_RESET:
+        case MROVER_CC_SWITCH_NETWORK:
+        case MROVER_CC_INIT_LORAWAN:
+        case MROVER_CC_SET_JOIN_EUI:
+        case MROVER_CC_GET_GPS_TIME:
+        case MROVER_CC_LORAWAN_TIME_REQ:
+        case MROVER_CC_SET_DEV_EUI:
+        case MROVER_CC_SET_NW_KEY:
+        case MROVER_CC_GET_DEV_EUI:
+        case MROVER_CC_GET_JOIN_EUI:
+        case MROVER_CC_JOIN_LORAWAN:
+        case MROVER_CC_REQUEST_UPLINK:
+        case MROVER_CC_LEAVE_LORAWAN_NETWORK:
+        case MROVER_CC_STOP_SID_LORAWAN_NETWORK:
+        case MROVER_CC_BLE_LINK_REQUEST:
+        case MROVER_CC_BLE_CONNECTION_REQUEST:
+        case MROVER_CC_FSK_LINK_REQUEST:
+        case MROVER_CC_CSS_LINK_REQUEST:
+        case MROVER_CC_SET_CSS_PWR_PROFILE:
+        case MROVER_CC_SET_FILTERING_DOWNLINK_SIDEWALK:
+        case MROVER_CC_GET_LORAWAN_CLASS:
+        case MROVER_CC_SET_LORAWAN_CLASS:
+        case MROVER_CC_START_FILE_TRANSFER:
+        case MROVER_CC_FILE_STATUS:
+        case MROVER_CC_TRIGGER_FW_UPDATE:
+        case MROVER_CC_GET_LAST_DL_STATS:
+        case MROVER_CC_GET_NEXT_UPLINK_MTU:
+            break;
+        default:
+            return false;
+    }
+
+    return checksum_xor8(0, data, len - 1) == data[len - 1];
+}
+
+/**
+ * @brief Million frames per second of a check over the response frames of the mix, best of three runs.
+ */
+template <typename T>
+static double measure_validation(const std::vector<frame_t> &responses, T is_valid)
+{
+    double best_rate = 0;
+
+    for (int run = 0; run < 3; run++)
+    {
+        uint32_t u32_valid = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < BENCH_FRAMES; i++)
+        {
+            const frame_t &frame = responses[i % responses.size()];
+            u32_valid += is_valid(frame.data(), (uint16_t)frame.size()) ? 1 : 0;
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        CHECK_EQ(u32_valid, BENCH_FRAMES);
+        best_rate = std::max(best_rate, BENCH_FRAMES / elapsed.count() / 1e6);
+    }
+    return best_rate;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    const std::vector<frame_t> mix = make_mix();
+    std::vector<frame_t> responses(mix.begin() + 1, mix.end());
+    frame_t stream;
+
+    REQUIRE(API_PROCESSOR_SUCCESS == api_processor_init(&s_module, on_send, on_notification, on_response));
+    for (uint32_t i = 0; i < BENCH_FRAMES; i++)
+    {
+        const frame_t &frame = mix[i % mix.size()];
+        stream.insert(stream.end(), frame.begin(), frame.end());
+    }
+
+    double reference_rate = measure_validation(responses, reference_is_valid_response_frame);
+    double table_rate = measure_validation(responses, [](const uint8_t *data, uint16_t len)
+                                           { return FP_SUCCESS == fp_is_valid_response_frame((uint8_t *)data, len); });
+
+    // the whole receive path, decoder, validation and dispatch, fed the way the uart hands the bytes over
+    double stream_rate = 0;
+    for (int run = 0; run < 3; run++)
+    {
+        s_responses = 0;
+        s_notifications = 0;
+        api_processor_reset_rx(&s_module);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t offset = 0; offset < stream.size(); offset += BENCH_CHUNK_LEN)
+        {
+            uint16_t u16_len = (uint16_t)std::min<size_t>(BENCH_CHUNK_LEN, stream.size() - offset);
+            api_processor_parse_rx_data(&s_module, &stream[offset], u16_len);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        CHECK_EQ(s_responses + s_notifications, BENCH_FRAMES);
+        stream_rate = std::max(stream_rate, BENCH_FRAMES / elapsed.count() / 1e6);
+    }
+
+    printf("%-34s %12s\n", "1M mixed frames", "Mframes/s");
+    printf("%-34s %12.2f\n", "validation, former switches", reference_rate);
+    printf("%-34s %12.2f\n", "validation, tables", table_rate);
+    printf("%-34s %12.2f\n", "receive path, 64 byte chunks", stream_rate);
+    return test_result("bench_response_dispatch");
+}
@@ -0,0 +1,184 @@
+/**
+ * @file bench_seg_bitmap.cpp
+ * @author OXIT embedded firmware team
+ * @brief Progress and first missing segment of a 10,000 segment package, scanned a segment at a time before and on the seg_bitmap now, and the size of its wire encoding.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_common.h"
+#include "seg_bitmap.h"
+#include <chrono>
+#include <random>
+#include <vector>
+
+/******************************************************************************
+ * MACROS AND DEFINES
+ ******************************************************************************/
+#define BENCH_SEGMENTS              (10000)
+#define BENCH_CALLS                 (20000)
+
+/******************************************************************************
+ * TYPEDEFS
+ ******************************************************************************/
+typedef struct
+{
+    const char *p_name;
+    uint32_t u32_max_len;                               // expected upper bound of the encoding
+} bench_case_t;
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static volatile uint32_t s_sink;
+static uint32_t s_words[SEG_BITMAP_WORDS(BENCH_SEGMENTS)];
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+/**
+ * @brief The former per segment loop over a status per segment, without its printf.
+ */
+static uint8_t legacy_progress(const uint8_t *p_pending, uint32_t u32_count)
+{
+    uint32_t u32_done = 0;
+
+    for (uint32_t i = 0; i < u32_count; i++)
+    {
+        u32_done += p_pending[i] ? 0 : 1;
+    }
+    return (uint8_t)((uint64_t)u32_done * 100 / u32_count);
+}
+
+static uint32_t legacy_first_missing(const uint8_t *p_pending, uint32_t u32_count)
+{
+    for (uint32_t i = 0; i < u32_count; i++)
+    {
+        if (p_pending[i])
+        {
+            return i;
+        }
+    }
+    return SEG_BITMAP_NONE;
+}
+
+/**
+ * @brief ns per call, best of three runs.
+ */
+template <class Fn>
+static double measure(Fn fn)
+{
+    double d_best_s = 1e30;
+
+    for (int run = 0; run < 3; run++)
+    {
+        uint32_t u32_sink = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < BENCH_CALLS; i++)
+        {
+            u32_sink += fn();
+            s_sink = u32_sink;
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        d_best_s = std::min(d_best_s, elapsed.count());
+    }
+    return d_best_s * 1e9 / BENCH_CALLS;
+}
+
+/**
+ * @brief Map with the given segments pending, in the map and in the byte per segment status.
+ */
+static void make_map(seg_bitmap_t *p_map, std::vector<uint8_t> *p_pending, uint32_t u32_case, std::mt19937 *p_rng)
+{
+    seg_bitmap_init(p_map, s_words, SEG_BITMAP_WORDS(BENCH_SEGMENTS), BENCH_SEGMENTS);
+    p_pending->assign(BENCH_SEGMENTS, 0);
+    for (uint32_t i = 0; i < BENCH_SEGMENTS; i++)
+    {
+        bool b_pending = false;
+
+        switch (u32_case)
+        {
+            case 1: b_pending = (i >= BENCH_SEGMENTS - 100); break;
+            case 2: b_pending = (0 == ((*p_rng)() % 100)); break;
+            case 3: b_pending = (0 == ((*p_rng)() % 2)); break;
+            default: break;
+        }
+        seg_bitmap_set_pending(p_map, i, b_pending);
+        (*p_pending)[i] = b_pending ? 1 : 0;
+    }
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    static const bench_case_t s_cases[] = {
+        { "all done", 4 },
+        { "last 100 missing", 7 },
+        { "1% random missing", 300 },
+        { "50% random missing", 1 + 2 + BENCH_SEGMENTS / 8 },
+    };
+    std::mt19937 rng(25);
+    uint8_t au8_buffer[SEG_BITMAP_ENC_MAX_LEN(BENCH_SEGMENTS)];
+    std::vector<uint8_t> pending;
+    seg_bitmap_t map;
+
+    printf("%u segments, ns per call, best of 3, raw bitmap %u B\n", (unsigned)BENCH_SEGMENTS, (unsigned)(1 + 2 + BENCH_SEGMENTS / 8));
+    printf("%-20s %10s %10s %12s %12s %8s\n", "", "progress", "", "first miss.", "", "wire");
+    printf("%-20s %10s %10s %12s %12s %8s\n", "", "per seg.", "bitmap", "per seg.", "bitmap", "B");
+    for (uint32_t u32_case = 0; u32_case < sizeof(s_cases) / sizeof(s_cases[0]); u32_case++)
+    {
+        make_map(&map, &pending, u32_case, &rng);
+        CHECK_EQ(seg_bitmap_get_progress(&map), legacy_progress(pending.data(), BENCH_SEGMENTS));
+        CHECK_EQ(seg_bitmap_find_pending(&map, 0), legacy_first_missing(pending.data(), BENCH_SEGMENTS));
+
+        double d_legacy_progress = measure([&]() { return legacy_progress(pending.data(), BENCH_SEGMENTS); });
+        double d_progress = measure([&]() { return seg_bitmap_get_progress(&map); });
+        double d_legacy_first = measure([&]() { return legacy_first_missing(pending.data(), BENCH_SEGMENTS); });
+        double d_first = measure([&]() { return seg_bitmap_find_pending(&map, 0); });
+        uint32_t u32_len = seg_bitmap_encode(&map, au8_buffer, sizeof(au8_buffer));
+
+        printf("%-20s %10.1f %10.1f %12.1f %12.1f %8u\n", s_cases[u32_case].p_name, d_legacy_progress, d_progress, d_legacy_first, d_first,
+               (unsigned)u32_len);
+        CHECK((0 < u32_len) && (u32_len <= s_cases[u32_case].u32_max_len));
+    }
+    return test_result("bench_seg_bitmap");
+}
@@ -0,0 +1,149 @@
+/**
+ * @file bench_uart_rate.cpp
+ * @author OXIT embedded firmware team
+ * @brief Response time of the largest uplink at the uart rates, on the byte timed uart of the host shim.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_mcm.h"
+
+/******************************************************************************
+ * MACROS AND DEFINES
+ ******************************************************************************/
+/**
+ * @brief Largest lorawan uplink the command frame can carry, 5 byte header, port, type and crc
+ */
+#define BENCH_UPLINK_LEN            (MAX_SERIAL_SEND_PAYLOAD_SIZE - 8)
+
+/******************************************************************************
+ * TYPEDEFS
+ ******************************************************************************/
+typedef struct
+{
+    bool is_done;
+    MCM_STATUS status;
+    uint64_t u64_done_us;
+} bench_command_t;
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static const uint32_t s_rates[] = { 9600, 115200, 921600 };
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static void on_command_complete(MCM_STATUS status, const api_processor_response_t *response, void *user_context)
+{
+    (void)response;
+    bench_command_t *p_command = (bench_command_t *)user_context;
+
+    p_command->is_done     = true;
+    p_command->status      = status;
+    p_command->u64_done_us = host_hal_get_time_us();
+}
+
+/**
+ * @brief Moves both ends of the link to u32_rate. No released firmware has a command for it, the emulated
+ * modem is set directly and the host side follows the way MCM::switch_baud_rate() does.
+ */
+static bool switch_rate(TestMcm &t, uint32_t u32_rate)
+{
+    if (MROVER_DEFAULT_BAUD_RATE == u32_rate)
+    {
+        return true;
+    }
+    t.emulator.set_baud_rate(u32_rate);
+    Serial1.flush();
+    Serial1.updateBaudRate(u32_rate);
+    api_processor_reset_rx(t.mcm.get_module_handle());
+    return t.blocking.print_version().indexOf("0.5.8") >= 0;
+}
+
+/**
+ * @brief Time from send_uplink() to the response of the modem, in us.
+ */
+static uint64_t measure_uplink(TestMcm &t)
+{
+    static uint8_t s_payload[BENCH_UPLINK_LEN];
+    bench_command_t command = {};
+
+    t.mcm.set_next_command_callback(on_command_complete, &command);
+    uint64_t u64_start_us = host_hal_get_time_us();
+    t.mcm.send_uplink(s_payload, sizeof(s_payload), 1, MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF);
+    if (!t.run_until([&]() { return command.is_done; }) || (MCM_STATUS::MCM_OK != command.status))
+    {
+        return 0;
+    }
+    t.run_until([&]() { return !t.mcm.is_last_uplink_pending(); });
+    return command.u64_done_us - u64_start_us;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    uint64_t u64_previous_us = UINT64_MAX;
+
+    printf("%-10s %12s %12s\n", "baud", "response ms", "wire ms");
+    for (uint32_t u32_rate : s_rates)
+    {
+        TestMcm t("join ok 200\n"
+                  "txdone noack 100\n");
+
+        REQUIRE(t.start());
+        REQUIRE(t.join_lorawan());
+        REQUIRE(switch_rate(t, u32_rate));
+
+        uint64_t u64_response_us = measure_uplink(t);
+        // the command frame out and the response frame back, 10 bit times per byte
+        double wire_ms = (MAX_SERIAL_SEND_PAYLOAD_SIZE + 9) * 10 * 1000.0 / u32_rate;
+        printf("%-10lu %12.1f %12.1f\n", (unsigned long)u32_rate, u64_response_us / 1000.0, wire_ms);
+
+        CHECK(0 < u64_response_us);
+        CHECK(u64_response_us < u64_previous_us);
+        CHECK(u64_response_us >= (uint64_t)(wire_ms * 1000));
+        CHECK_EQ(t.emulator.get_uplinks().size(), 1);
+        u64_previous_us = u64_response_us;
+    }
+    return test_result("bench_uart_rate");
+}
@@ -0,0 +1,169 @@
+/**
+ * @file bench_uplink_agg.cpp
+ * @author OXIT embedded firmware team
+ * @brief Uplinks and packing efficiency of the sensor records of the sketch per protocol MTU, over a day of readings.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_common.h"
+#include "ArduinoMultiprotocolExample.h"
+#include "uplink_agg.h"
+#include "uplink_sched.h"
+#include <algorithm>
+
+/******************************************************************************
+ * MACROS AND DEFINES
+ ******************************************************************************/
+#define BENCH_READINGS              (24 * 3600 / UPLINK_INTERVAL_SECONDS)
+#define BENCH_NO_DEADLINE_S         (24 * 3600)
+
+/******************************************************************************
+ * TYPEDEFS
+ ******************************************************************************/
+typedef struct
+{
+    const char *p_name;
+    uint16_t u16_mtu;
+} bench_link_t;
+
+typedef struct
+{
+    uint32_t u32_uplinks;
+    uint32_t u32_records;                       // records sent, the ones still waiting at the end of the day are not
+    uint32_t u32_record_bytes;
+    uint32_t u32_payload_bytes;
+} bench_result_t;
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static const bench_link_t s_links[] = {
+    { "CSS", SIDEWALK_TX_MAX_CSS_PAYLOAD_SIZE },
+    { "FSK", SIDEWALK_TX_MAX_FSK_PAYLOAD_SIZE },
+    { "BLE", SIDEWALK_TX_MAX_BLE_PAYLOAD_SIZE },
+    { "LoRaWAN", LORAWAN_TX_MAX_PAYLOAD_SIZE },
+};
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static void on_record(const uint8_t *p_data, uint8_t u8_len, uint32_t u32_age_s, void *p_context)
+{
+    (void)p_data;
+    (void)u32_age_s;
+    ((bench_result_t *)p_context)->u32_record_bytes += u8_len;
+}
+
+static void flush(uplink_agg_t *p_agg, uint16_t u16_mtu, uint32_t u32_now_ms, bench_result_t *p_result)
+{
+    uint8_t payload[UPLINK_SCHED_MAX_PAYLOAD_SIZE];
+    uint16_t u16_len = uplink_agg_pack(p_agg, payload, u16_mtu, u32_now_ms);
+    int16_t i16_records = uplink_agg_unpack(payload, u16_len, on_record, p_result);
+
+    REQUIRE(0 < i16_records);
+    CHECK(u16_len <= u16_mtu);
+    p_result->u32_uplinks++;
+    p_result->u32_records += (uint32_t)i16_records;
+    p_result->u32_payload_bytes += u16_len;
+}
+
+/**
+ * @brief One reading per UPLINK_INTERVAL_SECONDS for a day, through the flush policy of run_state_machine().
+ * The sketch caps the MTU to what the uplink scheduler takes, see flush_uplink_records().
+ */
+static bench_result_t run_day(uint16_t u16_mtu, uint32_t u32_deadline_s)
+{
+    uplink_agg_t agg;
+    uint8_t au8_storage[LORAWAN_TX_MAX_PAYLOAD_SIZE];
+    uplink_data_t record = {};
+    bench_result_t result = {};
+
+    u16_mtu = std::min<uint16_t>(u16_mtu, UPLINK_SCHED_MAX_PAYLOAD_SIZE);
+    REQUIRE(uplink_agg_init(&agg, au8_storage, sizeof(au8_storage), u32_deadline_s * 1000UL));
+
+    for (uint32_t i = 0; i < BENCH_READINGS; i++)
+    {
+        uint32_t u32_now_ms = i * UPLINK_INTERVAL_SECONDS * 1000UL;
+        bool is_sent = false;
+
+        record.temp = (uint16_t)(2000 + i);
+        if (!uplink_agg_fits(&agg, sizeof(record), u16_mtu, u32_now_ms))
+        {
+            flush(&agg, u16_mtu, u32_now_ms, &result);
+            is_sent = true;
+        }
+        CHECK(uplink_agg_add(&agg, (const uint8_t *)&record, sizeof(record), u32_now_ms));
+        if (!is_sent && (uplink_agg_is_due(&agg, u32_now_ms) || !uplink_agg_fits(&agg, sizeof(record), u16_mtu, u32_now_ms)))
+        {
+            flush(&agg, u16_mtu, u32_now_ms, &result);
+        }
+    }
+    CHECK_EQ(result.u32_records + uplink_agg_get_count(&agg), BENCH_READINGS);
+    CHECK_EQ(uplink_agg_get_dropped_count(&agg), 0);
+    return result;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    printf("%u readings of %u bytes, one every %u s, today %u uplinks\n", (unsigned)BENCH_READINGS, (unsigned)sizeof(uplink_data_t),
+           (unsigned)UPLINK_INTERVAL_SECONDS, (unsigned)BENCH_READINGS);
+    printf("%-8s %4s %4s %28s %28s\n", "link", "mtu", "used", "no deadline", "15 min deadline");
+    for (const bench_link_t &link : s_links)
+    {
+        bench_result_t no_deadline = run_day(link.u16_mtu, BENCH_NO_DEADLINE_S);
+        bench_result_t deadline = run_day(link.u16_mtu, UPLINK_AGG_DEADLINE_SECONDS);
+
+        printf("%-8s %4u %4u %7lu up %5.1f rec %5.1f %% %7lu up %5.1f rec %5.1f %%\n", link.p_name, (unsigned)link.u16_mtu,
+               (unsigned)std::min<uint16_t>(link.u16_mtu, UPLINK_SCHED_MAX_PAYLOAD_SIZE),
+               (unsigned long)no_deadline.u32_uplinks, (double)no_deadline.u32_records / no_deadline.u32_uplinks,
+               100.0 * no_deadline.u32_record_bytes / no_deadline.u32_payload_bytes,
+               (unsigned long)deadline.u32_uplinks, (double)deadline.u32_records / deadline.u32_uplinks,
+               100.0 * deadline.u32_record_bytes / deadline.u32_payload_bytes);
+
+        // every uplink carries more than one reading, the deadline only ever adds uplinks
+        CHECK(no_deadline.u32_uplinks <= BENCH_READINGS / 2);
+        CHECK(no_deadline.u32_uplinks <= deadline.u32_uplinks);
+    }
+    return test_result("bench_uplink_agg");
+}
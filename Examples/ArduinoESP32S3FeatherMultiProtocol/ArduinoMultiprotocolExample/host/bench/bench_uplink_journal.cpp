@@ -0,0 +1,213 @@
+/**
+ * @file bench_uplink_journal.cpp
+ * @author OXIT embedded firmware team
+ * @brief Write amplification of the uplink journal on the SPIFFS shim, with and without resets during the writes.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_common.h"
+#include "test_journal_file.h"
+#include <random>
+#include <set>
+
+/******************************************************************************
+ * MACROS AND DEFINES
+ ******************************************************************************/
+#define BENCH_OFFLINE_RECORDS       (100)               // uplinks journaled per offline period
+#define BENCH_PERIODS               (20)
+#define BENCH_PAGE_SIZE             (256)               // logical page of SPIFFS on the ESP32
+#define BENCH_CRASH_PERCENT         (5)
+
+/******************************************************************************
+ * TYPEDEFS
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t u32_records;                               // uplinks forwarded, each counted once
+    uint32_t u32_lost;                                  // appends cut by a reset, the reading was only in RAM
+    uint32_t u32_replayed;                              // uplinks given again after a reset
+    uint32_t u32_resets;
+    uint64_t u64_payload_bytes;
+    uint64_t u64_bytes_written;
+    uint64_t u64_pages;
+    uint32_t u32_open_calls;
+    uint32_t u32_file_opens;                            // by uplink_journal_open()
+} bench_result_t;
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static const uint16_t s_sizes[] = { 24, 60, 240 };
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+/**
+ * @brief Pages programmed by the writes: every page a write touches, and the object index page
+ * that SPIFFS rewrites with the new file size when the write is flushed.
+ */
+static uint64_t pages_programmed(const TestJournalFile &file)
+{
+    uint64_t u64_pages = 0;
+
+    for (const std::pair<uint32_t, uint16_t> &append : file.appends)
+    {
+        if (0 != append.second)
+        {
+            u64_pages += (append.first + append.second - 1) / BENCH_PAGE_SIZE - append.first / BENCH_PAGE_SIZE + 1;
+        }
+        u64_pages++;
+    }
+    return u64_pages;
+}
+
+static void open_journal(uplink_journal_t *p_journal, TestJournalFile *p_file, bench_result_t *p_result)
+{
+    uint32_t u32_opens = host_fs_get_stats().u32_opens;
+
+    REQUIRE(uplink_journal_open(p_journal, &p_file->storage, UPLINK_JOURNAL_MAX_SIZE));
+    p_result->u32_open_calls++;
+    p_result->u32_file_opens += host_fs_get_stats().u32_opens - u32_opens;
+}
+
+/**
+ * @brief Offline periods of BENCH_OFFLINE_RECORDS uplinks of one size, each replayed once online.
+ * A reset in u32_crash_percent of the writes cuts the write short and reopens the journal.
+ */
+static bench_result_t run(uint16_t u16_size, uint32_t u32_crash_percent)
+{
+    TestJournalFile file;
+    uplink_journal_t journal;
+    bench_result_t result = {};
+    std::set<uint32_t> forwarded;
+    std::mt19937 rng(u16_size);
+    uint8_t data[UPLINK_JOURNAL_MAX_RECORD_SIZE] = { 0 };
+    uint32_t u32_id = 0;
+
+    host_fs_format();
+    open_journal(&journal, &file, &result);
+
+    for (uint32_t u32_period = 0; u32_period < BENCH_PERIODS; u32_period++)
+    {
+        for (uint32_t i = 0; i < BENCH_OFFLINE_RECORDS; i++, u32_id++)
+        {
+            if ((rng() % 100) < u32_crash_percent)
+            {
+                file.crash_after(rng() % (u16_size + UPLINK_JOURNAL_HEADER_LEN + UPLINK_JOURNAL_CRC_LEN));
+            }
+            memcpy(data, &u32_id, sizeof(u32_id));
+            if (!uplink_journal_append(&journal, data, u16_size))
+            {
+                REQUIRE(file.b_crashed);
+                result.u32_lost++;
+                result.u32_resets++;
+                file.reboot();
+                open_journal(&journal, &file, &result);
+            }
+            file.crash_after(-1);
+        }
+
+        while (0 < uplink_journal_get_pending_count(&journal))
+        {
+            uint16_t u16_len = 0;
+            uint32_t u32_peeked = 0;
+
+            REQUIRE(uplink_journal_peek(&journal, data, sizeof(data), &u16_len));
+            memcpy(&u32_peeked, data, sizeof(u32_peeked));
+            if (!forwarded.insert(u32_peeked).second)
+            {
+                result.u32_replayed++;
+            }
+
+            if ((rng() % 100) < u32_crash_percent)
+            {
+                file.crash_after(rng() % (4 + UPLINK_JOURNAL_HEADER_LEN + UPLINK_JOURNAL_CRC_LEN));
+            }
+            if (!uplink_journal_commit(&journal))
+            {
+                REQUIRE(file.b_crashed);
+                result.u32_resets++;
+                file.reboot();
+                open_journal(&journal, &file, &result);
+            }
+            file.crash_after(-1);
+        }
+    }
+
+    result.u32_records = (uint32_t)forwarded.size();
+    result.u64_payload_bytes = (uint64_t)result.u32_records * u16_size;
+    result.u64_bytes_written = host_fs_get_stats().u64_bytes_written;
+    result.u64_pages = pages_programmed(file);
+    CHECK_EQ(result.u32_records + result.u32_lost, BENCH_PERIODS * BENCH_OFFLINE_RECORDS);
+    return result;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    printf("%u offline periods of %u uplinks, each replayed online, %u B pages\n", (unsigned)BENCH_PERIODS,
+           (unsigned)BENCH_OFFLINE_RECORDS, (unsigned)BENCH_PAGE_SIZE);
+    printf("%5s %24s | reset in %u%% of the writes\n", "", "no reset", (unsigned)BENCH_CRASH_PERCENT);
+    printf("%5s %11s %12s | %11s %12s %5s %5s %8s %12s\n", "bytes", "B written/B", "pages/uplink", "B written/B", "pages/uplink",
+           "lost", "again", "resets", "opens/open");
+    for (uint16_t u16_size : s_sizes)
+    {
+        bench_result_t clean = run(u16_size, 0);
+        bench_result_t crash = run(u16_size, BENCH_CRASH_PERCENT);
+
+        printf("%5u %11.2f %12.2f | %11.2f %12.2f %5lu %5lu %8lu %12.2f\n", (unsigned)u16_size,
+               (double)clean.u64_bytes_written / clean.u64_payload_bytes, (double)clean.u64_pages / clean.u32_records,
+               (double)crash.u64_bytes_written / crash.u64_payload_bytes, (double)crash.u64_pages / crash.u32_records,
+               (unsigned long)crash.u32_lost, (unsigned long)crash.u32_replayed, (unsigned long)crash.u32_resets,
+               (double)crash.u32_file_opens / crash.u32_open_calls);
+
+        // one data entry and one checkpoint per uplink, nothing is lost or given twice without a reset
+        CHECK_EQ(clean.u64_bytes_written, (uint64_t)clean.u32_records * (u16_size + 4 + 2 * (UPLINK_JOURNAL_HEADER_LEN + UPLINK_JOURNAL_CRC_LEN)) -
+                                              BENCH_PERIODS * (4 + UPLINK_JOURNAL_HEADER_LEN + UPLINK_JOURNAL_CRC_LEN));
+        CHECK_EQ(clean.u32_lost + clean.u32_replayed, 0);
+        // at most the uplink whose checkpoint was cut is given again
+        CHECK(crash.u32_replayed <= crash.u32_resets - crash.u32_lost);
+        CHECK(crash.u32_file_opens <= 3 * crash.u32_open_calls);
+    }
+    return test_result("bench_uplink_journal");
+}
@@ -0,0 +1,282 @@
+/**
+ * @file bench_uplink_sched.cpp
+ * @author OXIT embedded firmware team
+ * @brief A day of alarms, telemetry and bulk uplinks on the 1% LoRaWAN link, one uplink per interval against the scheduler.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_common.h"
+#include "uplink_sched.h"
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+/******************************************************************************
+ * MACROS AND DEFINES
+ ******************************************************************************/
+#define BENCH_DAY_MS                (24UL * 3600000UL)
+#define BENCH_STEP_MS               (100)
+#define BENCH_INTERVAL_MS           (60000)             // interval of run_state_machine()
+#define BENCH_RX_WINDOWS_MS         (2000)              // txdone follows the airtime and the two receive windows
+#define BENCH_TELEMETRY_SIZE        (20)
+#define BENCH_ALARM_SIZE            (10)
+#define BENCH_BULK_SIZE             (200)
+#define BENCH_BULK_CHUNKS           (50)                // 10 KB log every hour
+#define BENCH_ALARMS_PER_HOUR       (2)
+#define LINK                        (1)
+
+/******************************************************************************
+ * TYPEDEFS
+ ******************************************************************************/
+typedef enum
+{
+    POLICY_INTERVAL,                                    // one uplink per interval, in order of arrival
+    POLICY_FIFO,                                        // next uplink on txdone, in order of arrival, no budget
+    POLICY_SCHED,                                       // next uplink on txdone, through uplink_sched
+} bench_policy_t;
+
+typedef struct
+{
+    uint8_t u8_class;
+    uint16_t u16_len;
+    uint32_t u32_queued_ms;
+} bench_uplink_t;
+
+typedef struct
+{
+    uint32_t u32_sent;
+    uint32_t u32_lost;
+    uint64_t u64_total_delay_ms;
+    uint32_t u32_max_delay_ms;
+} bench_class_t;
+
+typedef struct
+{
+    uint64_t u64_bytes;
+    uint32_t u32_max_hour_airtime_ms;
+    bench_class_t classes[UPLINK_SCHED_CLASS_COUNT];
+} bench_result_t;
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+// default lorawan profile of MCM, SF9 and the 1% of EU868, 36 s per hour
+static const uplink_sched_link_t s_lorawan = { 1760, 13, 60, 10 };
+static const uint8_t s_payload[UPLINK_SCHED_MAX_PAYLOAD_SIZE] = { 0 };
+static const char *s_class_names[UPLINK_SCHED_CLASS_COUNT] = { "alarm", "telemetry", "bulk" };
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static void on_sent(bench_result_t *p_result, std::vector<std::pair<uint32_t, uint32_t>> *p_tx, const bench_uplink_t &uplink, uint32_t u32_now_ms)
+{
+    bench_class_t *p_class = &p_result->classes[uplink.u8_class];
+    uint32_t u32_delay_ms = u32_now_ms - uplink.u32_queued_ms;
+
+    p_class->u32_sent++;
+    p_class->u64_total_delay_ms += u32_delay_ms;
+    p_class->u32_max_delay_ms = std::max(p_class->u32_max_delay_ms, u32_delay_ms);
+    p_result->u64_bytes += uplink.u16_len;
+    p_tx->push_back({ u32_now_ms, uplink_sched_airtime_ms(&s_lorawan, uplink.u16_len) });
+}
+
+/**
+ * @brief Most airtime started within any hour
+ */
+static uint32_t max_hour_airtime_ms(const std::vector<std::pair<uint32_t, uint32_t>> &tx)
+{
+    uint32_t u32_max_ms = 0;
+    uint32_t u32_sum_ms = 0;
+    size_t first = 0;
+
+    for (size_t i = 0; i < tx.size(); i++)
+    {
+        u32_sum_ms += tx[i].second;
+        while (tx[i].first - tx[first].first >= UPLINK_SCHED_DUTY_WINDOW_MS)
+        {
+            u32_sum_ms -= tx[first++].second;
+        }
+        u32_max_ms = std::max(u32_max_ms, u32_sum_ms);
+    }
+    return u32_max_ms;
+}
+
+static bench_result_t run_day(bench_policy_t policy)
+{
+    uplink_sched_t sched;
+    std::deque<bench_uplink_t> fifo;
+    std::vector<std::pair<uint32_t, uint32_t>> tx;
+    bench_result_t result = {};
+    uint32_t u32_busy_until_ms = 0;
+    uint32_t u32_bulk_backlog = 0;
+    uint32_t u32_seed = 12345;
+
+    uplink_sched_init(&sched, 0);
+    REQUIRE(uplink_sched_set_link(&sched, LINK, &s_lorawan, 0));
+
+    for (uint32_t u32_now_ms = 0; u32_now_ms < BENCH_DAY_MS; u32_now_ms += BENCH_STEP_MS)
+    {
+        std::vector<bench_uplink_t> arrivals;
+
+        if (0 == (u32_now_ms % UPLINK_SCHED_DUTY_WINDOW_MS))
+        {
+            // the log of the previous hour is replaced
+            result.classes[UPLINK_SCHED_BULK].u32_lost += u32_bulk_backlog;
+            u32_bulk_backlog = BENCH_BULK_CHUNKS;
+        }
+        u32_seed = u32_seed * 1103515245UL + 12345UL;
+        if (((u32_seed >> 8) % (UPLINK_SCHED_DUTY_WINDOW_MS / BENCH_STEP_MS)) < BENCH_ALARMS_PER_HOUR)
+        {
+            arrivals.push_back({ UPLINK_SCHED_ALARM, BENCH_ALARM_SIZE, u32_now_ms });
+        }
+        if (0 == (u32_now_ms % BENCH_INTERVAL_MS))
+        {
+            arrivals.push_back({ UPLINK_SCHED_TELEMETRY, BENCH_TELEMETRY_SIZE, u32_now_ms });
+        }
+        for (const bench_uplink_t &uplink : arrivals)
+        {
+            if (POLICY_SCHED == policy)
+            {
+                // rejected and evicted uplinks are counted by the scheduler
+                uplink_sched_add(&sched, uplink.u8_class, 1, false, s_payload, uplink.u16_len, u32_now_ms, NULL);
+            }
+            else if (UPLINK_SCHED_QUEUE_SIZE > fifo.size())
+            {
+                fifo.push_back(uplink);
+            }
+            else
+            {
+                result.classes[uplink.u8_class].u32_lost++;
+            }
+        }
+
+        // the log is offered chunk by chunk while the queue has room
+        while (0 < u32_bulk_backlog)
+        {
+            size_t count = (POLICY_SCHED == policy) ? uplink_sched_get_count(&sched) : fifo.size();
+            if (UPLINK_SCHED_QUEUE_SIZE <= count)
+            {
+                break;
+            }
+            if (POLICY_SCHED == policy)
+            {
+                REQUIRE(uplink_sched_add(&sched, UPLINK_SCHED_BULK, 1, false, s_payload, BENCH_BULK_SIZE, u32_now_ms, NULL));
+            }
+            else
+            {
+                fifo.push_back({ UPLINK_SCHED_BULK, BENCH_BULK_SIZE, u32_now_ms });
+            }
+            u32_bulk_backlog--;
+        }
+
+        if (u32_now_ms < u32_busy_until_ms)
+        {
+            continue;
+        }
+        if (POLICY_SCHED == policy)
+        {
+            const uplink_sched_entry_t *p_entry = NULL;
+            if (UPLINK_SCHED_READY == uplink_sched_peek(&sched, LINK, u32_now_ms, &p_entry))
+            {
+                bench_uplink_t uplink = { p_entry->u8_class, p_entry->u16_len, p_entry->u32_queued_ms };
+                uplink_sched_commit(&sched, LINK, p_entry, u32_now_ms);
+                on_sent(&result, &tx, uplink, u32_now_ms);
+                u32_busy_until_ms = u32_now_ms + uplink_sched_airtime_ms(&s_lorawan, uplink.u16_len) + BENCH_RX_WINDOWS_MS;
+            }
+        }
+        else if (!fifo.empty() && ((POLICY_FIFO == policy) || (0 == (u32_now_ms % BENCH_INTERVAL_MS))))
+        {
+            on_sent(&result, &tx, fifo.front(), u32_now_ms);
+            u32_busy_until_ms = u32_now_ms + uplink_sched_airtime_ms(&s_lorawan, fifo.front().u16_len) + BENCH_RX_WINDOWS_MS;
+            fifo.pop_front();
+        }
+    }
+
+    if (POLICY_SCHED == policy)
+    {
+        for (uint8_t i = 0; i < UPLINK_SCHED_CLASS_COUNT; i++)
+        {
+            result.classes[i].u32_lost += uplink_sched_get_stats(&sched, i)->u32_dropped;
+        }
+    }
+    result.u32_max_hour_airtime_ms = max_hour_airtime_ms(tx);
+    return result;
+}
+
+static void print_result(const char *p_name, const bench_result_t &result)
+{
+    printf("%-28s %6.0f B/h, max %5.1f s of airtime in an hour\n", p_name, (double)result.u64_bytes / 24,
+           result.u32_max_hour_airtime_ms / 1000.0);
+    for (uint8_t i = 0; i < UPLINK_SCHED_CLASS_COUNT; i++)
+    {
+        const bench_class_t &c = result.classes[i];
+        printf("    %-10s %5lu sent %5lu lost, delay %7.1f s mean %7.1f s max\n", s_class_names[i], (unsigned long)c.u32_sent,
+               (unsigned long)c.u32_lost, (0 == c.u32_sent) ? 0.0 : c.u64_total_delay_ms / 1000.0 / c.u32_sent, c.u32_max_delay_ms / 1000.0);
+    }
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    const uint32_t u32_limit_ms = (UPLINK_SCHED_DUTY_WINDOW_MS / UPLINK_SCHED_NO_DUTY_LIMIT) * s_lorawan.u16_duty_permille;
+
+    printf("24 h at %lu bit/s, %lu ms of airtime per hour: telemetry %u B every %u s, %u x %u B bulk per hour, ~%u alarms per hour\n",
+           (unsigned long)s_lorawan.u32_bitrate_bps, (unsigned long)u32_limit_ms, (unsigned)BENCH_TELEMETRY_SIZE,
+           (unsigned)(BENCH_INTERVAL_MS / 1000), (unsigned)BENCH_BULK_CHUNKS, (unsigned)BENCH_BULK_SIZE, (unsigned)BENCH_ALARMS_PER_HOUR);
+
+    bench_result_t interval = run_day(POLICY_INTERVAL);
+    bench_result_t fifo = run_day(POLICY_FIFO);
+    bench_result_t sched = run_day(POLICY_SCHED);
+    print_result("one uplink per interval", interval);
+    print_result("fifo on txdone, no budget", fifo);
+    print_result("uplink_sched", sched);
+
+    // the load is more than the link may send, the scheduler keeps within the duty cycle
+    // and loses no alarm or telemetry to the bulk log
+    CHECK(fifo.u32_max_hour_airtime_ms > u32_limit_ms);
+    CHECK(sched.u32_max_hour_airtime_ms <= u32_limit_ms);
+    CHECK_EQ(sched.classes[UPLINK_SCHED_ALARM].u32_lost, 0);
+    CHECK_EQ(sched.classes[UPLINK_SCHED_TELEMETRY].u32_lost, 0);
+    CHECK(sched.classes[UPLINK_SCHED_ALARM].u32_sent > 0);
+    return test_result("bench_uplink_sched");
+}
@@ -0,0 +1,210 @@
+/**
+ * @file bench_ymodem_block.cpp
+ * @author OXIT embedded firmware team
+ * @brief YModem receivers over a line that splits the packets into reads of random size: one packet per read before, the packet assembler now.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_common.h"
+#include "test_ymodem_line.h"
+
+/******************************************************************************
+ * MACROS AND DEFINES
+ ******************************************************************************/
+#define BENCH_IMAGE_SIZE            (256 * 1024)
+#define BENCH_RUNS                  (20)
+
+/******************************************************************************
+ * TYPEDEFS
+ ******************************************************************************/
+typedef struct
+{
+    const char *p_name;
+    test_ymodem_line_t line;
+} bench_case_t;
+
+typedef struct
+{
+    uint32_t u32_complete;                              // runs with the EOT acknowledged
+    uint32_t u32_intact;                                // runs that also wrote the image unchanged
+    uint64_t u64_packets;                               // over the completed runs
+    uint64_t u64_bytes;
+    uint64_t u64_blocks;
+} bench_result_t;
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+/**
+ * @brief The former YModem::receivePacket(): each read is taken as one packet, copied to the start of
+ * the same buffer. The crc is the one of 1024 bytes after the header against the last two bytes of the
+ * read, the block number is not looked at.
+ */
+class BenchLegacyReceiver
+{
+    public:
+    std::vector<uint8_t> image;
+    bool b_aborted = false;
+
+    test_ymodem_reply_t receive(const uint8_t *p_data, uint16_t u16_len)
+    {
+        if (b_aborted)
+        {
+            return TEST_YMODEM_CANCEL;
+        }
+        memcpy(au8_buffer, p_data, u16_len);
+
+        if (!b_receiving)
+        {
+            if ((TEST_YMODEM_SOH == au8_buffer[0]) || (TEST_YMODEM_STX == au8_buffer[0]))
+            {
+                char ac_name[128];
+                unsigned long ul_size = 0;
+                sscanf((const char *)&au8_buffer[2], "%127s", ac_name);
+                sscanf((const char *)&au8_buffer[2 + strlen(ac_name) + 1], "%lu", &ul_size);
+                u32_remaining = (uint32_t)ul_size;
+                u8_crc_errors = 0;
+                b_receiving = true;
+                return TEST_YMODEM_ACK;
+            }
+            return TEST_YMODEM_NONE;
+        }
+
+        if (TEST_YMODEM_EOT == au8_buffer[0])
+        {
+            return TEST_YMODEM_ACK;
+        }
+        if ((TEST_YMODEM_SOH == au8_buffer[0]) || (TEST_YMODEM_STX == au8_buffer[0]))
+        {
+            // a read of a single start byte took its crc from before the buffer, never a match
+            if ((2 <= u16_len) && ((uint16_t)((au8_buffer[u16_len - 2] << 8) | au8_buffer[u16_len - 1]) ==
+                                   checksum_crc16_ccitt(CHECKSUM_CRC16_XMODEM_INIT, au8_buffer + 3, YMODEM_BLOCK_STX_SIZE)))
+            {
+                uint32_t u32_write = std::min((uint32_t)YMODEM_BLOCK_STX_SIZE, u32_remaining);
+                u8_crc_errors = 0;
+                image.insert(image.end(), au8_buffer + 3, au8_buffer + 3 + u32_write);
+                u32_remaining -= u32_write;
+                return TEST_YMODEM_ACK;
+            }
+            if (++u8_crc_errors >= TEST_YMODEM_MAX_CRC_ERRORS)
+            {
+                b_aborted = true;
+                return TEST_YMODEM_CANCEL;
+            }
+            return TEST_YMODEM_NAK;
+        }
+        return TEST_YMODEM_NONE;
+    }
+
+    private:
+    uint8_t au8_buffer[YMODEM_BLOCK_MAX_PACKET_SIZE + 1] = {};   // NUL after the packet for the header scan
+    uint32_t u32_remaining = 0;
+    uint8_t u8_crc_errors = 0;
+    bool b_receiving = false;
+};
+
+template <class Receiver>
+static bench_result_t run(const test_ymodem_line_t &line)
+{
+    std::mt19937 rng(23);
+    bench_result_t result = {};
+
+    for (uint32_t u32_run = 0; u32_run < BENCH_RUNS; u32_run++)
+    {
+        std::vector<uint8_t> image(BENCH_IMAGE_SIZE);
+        Receiver receiver;
+
+        for (uint8_t &u8_byte : image)
+        {
+            u8_byte = (uint8_t)rng();
+        }
+        test_ymodem_transfer_t transfer =
+            test_ymodem_send(image, line, &rng, [&](const uint8_t *p_data, uint16_t u16_len) { return receiver.receive(p_data, u16_len); });
+        if (transfer.b_complete)
+        {
+            result.u32_complete++;
+            result.u32_intact += (receiver.image == image) ? 1 : 0;
+            result.u64_packets += transfer.u32_packets;
+            result.u64_bytes += transfer.u64_bytes;
+            result.u64_blocks += (BENCH_IMAGE_SIZE + line.u16_block_size - 1) / line.u16_block_size;
+        }
+    }
+    return result;
+}
+
+static void print_result(const char *p_name, const char *p_receiver, const bench_result_t &result)
+{
+    if (0 == result.u32_complete)
+    {
+        printf("%-22s %-10s %8u %8u %18s %10s\n", p_name, p_receiver, 0u, 0u, "-", "-");
+        return;
+    }
+    printf("%-22s %-10s %8u %8u %18.0f %9.0f%%\n", p_name, p_receiver, (unsigned)result.u32_complete, (unsigned)result.u32_intact,
+           100.0 * result.u64_packets / result.u64_blocks, 100.0 * BENCH_IMAGE_SIZE * result.u32_complete / result.u64_bytes);
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    static const bench_case_t s_cases[] = {
+        { "reads of 2000 B", { 2000, YMODEM_BLOCK_STX_SIZE, 0, 0 } },
+        { "reads of 256 B", { 256, YMODEM_BLOCK_STX_SIZE, 0, 0 } },
+        { "2000 B, 5% lost acks", { 2000, YMODEM_BLOCK_STX_SIZE, 0, 5 } },
+        { "2000 B, 2% corrupted", { 2000, YMODEM_BLOCK_STX_SIZE, 2, 0 } },
+        { "2000 B, 128 B blocks", { 2000, YMODEM_BLOCK_SOH_SIZE, 0, 0 } },
+    };
+
+    printf("%u runs of a %u KB image, reads of exponential size with the given mean, a read never spans two packets\n",
+           (unsigned)BENCH_RUNS, (unsigned)(BENCH_IMAGE_SIZE / 1024));
+    printf("%-22s %-10s %8s %8s %18s %10s\n", "", "receiver", "complete", "intact", "packets/100 blocks", "line eff.");
+    for (const bench_case_t &c : s_cases)
+    {
+        bench_result_t legacy = run<BenchLegacyReceiver>(c.line);
+        bench_result_t assembler = run<TestYModemReceiver>(c.line);
+
+        print_result(c.p_name, "per read", legacy);
+        print_result(c.p_name, "assembler", assembler);
+        CHECK_EQ(assembler.u32_intact, BENCH_RUNS);
+    }
+    return test_result("bench_ymodem_block");
+}
@@ -0,0 +1,130 @@
+/**
+ * @file bench_ymodem_ota.cpp
+ * @author OXIT embedded firmware team
+ * @brief Flash traffic of a YModem firmware transfer, streamed into the OTA partition or staged in SPIFFS first.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_mcm.h"
+
+/******************************************************************************
+ * MACROS AND DEFINES
+ ******************************************************************************/
+#define BENCH_IMAGE_SIZE            (1024 * 1024)
+#define BENCH_TRANSFER_TIMEOUT_MS   (60 * 60000UL)
+
+/******************************************************************************
+ * TYPEDEFS
+ ******************************************************************************/
+typedef struct
+{
+    uint64_t u64_ota_written;
+    uint64_t u64_fs_written;
+    uint64_t u64_fs_read;
+    uint32_t u32_sectors_erased;
+    uint32_t u32_transfer_ms;                           // START_FILE_TRANSFER to the reboot
+    bool b_image_ok;
+} bench_result_t;
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static bench_result_t run(const std::vector<uint8_t> &image, bool b_stream_to_ota)
+{
+    TestMcm t;
+    ver_type_1_t version = { 1, 2, 3 };
+    bench_result_t result = {};
+    uint32_t u32_start_ms = 0;
+
+    t.emulator.config().file = image;
+    REQUIRE(t.start());
+    t.mcm.ymodem.setStreamToOta(b_stream_to_ota);
+    u32_start_ms = millis();
+    REQUIRE(MCM_STATUS::MCM_OK == t.mcm.start_file_transfer(version));
+    CHECK(t.run_until([]() { return 0 < host_hal_get_restart_count(); }, BENCH_TRANSFER_TIMEOUT_MS));
+
+    result.u64_ota_written = Update.host_get_stats().u64_bytes_written;
+    result.u32_sectors_erased = Update.host_get_stats().u32_sectors_erased;
+    result.u64_fs_written = host_fs_get_stats().u64_bytes_written;
+    result.u64_fs_read = host_fs_get_stats().u64_bytes_read;
+    result.u32_transfer_ms = millis() - u32_start_ms;
+    result.b_image_ok = (image == Update.host_get_image());
+    return result;
+}
+
+static void print_result(const char *p_name, const bench_result_t &result)
+{
+    const double d_mb = 1024.0 * 1024.0;
+
+    printf("%-10s %9.2f %9.2f %9.2f %9.2f %8u %10.1f\n", p_name, result.u64_ota_written / d_mb, result.u64_fs_written / d_mb,
+           (result.u64_ota_written + result.u64_fs_written) / d_mb, result.u64_fs_read / d_mb, (unsigned)result.u32_sectors_erased,
+           result.u32_transfer_ms / 1000.0);
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    std::vector<uint8_t> image(BENCH_IMAGE_SIZE);
+
+    for (size_t i = 0; i < image.size(); i++)
+    {
+        image[i] = (uint8_t)((i * 7) ^ (i >> 8));
+    }
+    image[0] = ESP_IMAGE_HEADER_MAGIC;
+
+    bench_result_t staged = run(image, false);
+    bench_result_t streamed = run(image, true);
+
+    printf("%u KB image, MB of flash, the SPIFFS file only grows so its peak size is what it wrote\n",
+           (unsigned)(BENCH_IMAGE_SIZE / 1024));
+    printf("%-10s %9s %9s %9s %9s %8s %10s\n", "", "OTA", "SPIFFS", "written", "read", "erased", "transfer s");
+    print_result("staged", staged);
+    print_result("streamed", streamed);
+
+    CHECK(staged.b_image_ok);
+    CHECK(streamed.b_image_ok);
+    CHECK_EQ(streamed.u64_ota_written + streamed.u64_fs_written, BENCH_IMAGE_SIZE);
+    CHECK_EQ(staged.u64_ota_written + staged.u64_fs_written, 2 * BENCH_IMAGE_SIZE);
+    CHECK_EQ(streamed.u64_fs_read, 0);
+    return test_result("bench_ymodem_ota");
+}
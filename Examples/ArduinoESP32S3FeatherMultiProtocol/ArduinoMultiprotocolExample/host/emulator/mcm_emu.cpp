@@ -0,0 +1,216 @@
+/**
+ * @file mcm_emu.cpp
+ * @author OXIT embedded firmware team
+ * @brief Emulated MCM served on a pseudo terminal, the sketch or a host test opens the printed tty as its uart.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "mcm_emulator.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static volatile sig_atomic_t s_is_stopping = 0;
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static uint64_t monotonic_us()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000ULL) + ((uint64_t)ts.tv_nsec / 1000ULL);
+}
+
+static void on_signal(int signal)
+{
+    (void)signal;
+    s_is_stopping = 1;
+}
+
+static void usage(const char *p_name)
+{
+    fprintf(stderr, "usage: %s [-s script] [-t seconds] [-q]\n"
+                    "  -s  script of the modem, see McmEmulator::load_script()\n"
+                    "  -t  exits after this many seconds\n"
+                    "  -q  no counters on exit\n"
+                    "The path of the tty is printed on the first line of stdout.\n", p_name);
+}
+
+static void write_all(int fd, const uint8_t *p_data, size_t len)
+{
+    while (0 < len)
+    {
+        ssize_t written = write(fd, p_data, len);
+        if (0 < written)
+        {
+            p_data += written;
+            len -= (size_t)written;
+        }
+        else if ((EAGAIN == errno) || (EINTR == errno))
+        {
+            struct pollfd pfd = { fd, POLLOUT, 0 };
+            (void)poll(&pfd, 1, 10);
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
+/******************************************************************************
+ * MAIN
+ ******************************************************************************/
+int main(int argc, char **argv)
+{
+    McmEmulator emulator;
+    const char *p_script = NULL;
+    uint64_t u64_run_us = 0;
+    bool is_quiet = false;
+    int option;
+
+    while (-1 != (option = getopt(argc, argv, "s:t:qh")))
+    {
+        switch (option)
+        {
+        case 's':
+            p_script = optarg;
+            break;
+        case 't':
+            u64_run_us = (uint64_t)strtoul(optarg, NULL, 0) * 1000000ULL;
+            break;
+        case 'q':
+            is_quiet = true;
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    std::string error;
+    if ((NULL != p_script) && !emulator.load_script_file(p_script, &error))
+    {
+        fprintf(stderr, "mcm_emu: %s\n", error.c_str());
+        return 2;
+    }
+
+    int fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if ((0 > fd) || (0 != grantpt(fd)) || (0 != unlockpt(fd)))
+    {
+        perror("mcm_emu: posix_openpt");
+        return 1;
+    }
+    const char *p_tty = ptsname(fd);
+    // kept open so that the host can close and open the tty again without hanging the line up
+    int fd_slave = open(p_tty, O_RDWR | O_NOCTTY);
+    struct termios tio;
+    if ((0 <= fd_slave) && (0 == tcgetattr(fd_slave, &tio)))
+    {
+        cfmakeraw(&tio);
+        (void)tcsetattr(fd_slave, TCSANOW, &tio);
+    }
+    printf("%s\n", p_tty);
+    fflush(stdout);
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    uint64_t u64_start_us = monotonic_us();
+    emulator.set_transmit([fd](const uint8_t *p_data, size_t len) { write_all(fd, p_data, len); });
+    emulator.power_on(0);
+
+    while (!s_is_stopping)
+    {
+        uint64_t u64_now_us = monotonic_us() - u64_start_us;
+        if ((0 != u64_run_us) && (u64_now_us >= u64_run_us))
+        {
+            break;
+        }
+
+        uint64_t u64_next_us = emulator.poll(u64_now_us);
+        int timeout_ms = 100;
+        if (MCM_EMU_NO_DEADLINE != u64_next_us)
+        {
+            timeout_ms = (u64_next_us > u64_now_us) ? (int)std::min<uint64_t>((u64_next_us - u64_now_us + 999) / 1000, 100) : 0;
+        }
+
+        struct pollfd pfd = { fd, POLLIN, 0 };
+        if (0 < poll(&pfd, 1, timeout_ms))
+        {
+            uint8_t buffer[256];
+            ssize_t len;
+            while (0 < (len = read(fd, buffer, sizeof(buffer))))
+            {
+                u64_now_us = monotonic_us() - u64_start_us;
+                for (ssize_t i = 0; i < len; i++)
+                {
+                    emulator.receive(buffer[i], u64_now_us);
+                }
+            }
+        }
+    }
+
+    if (!is_quiet)
+    {
+        mcm_emu_stats_t stats = emulator.get_stats();
+        fprintf(stderr, "mcm_emu: %u commands, %u bad crc, %u noise bytes, %u responses, %u notifications, %u events, %zu uplinks\n",
+                stats.u32_commands, stats.u32_bad_crc, stats.u32_noise_bytes, stats.u32_responses, stats.u32_notifications,
+                stats.u32_events_sent, emulator.get_uplinks().size());
+    }
+    if (0 <= fd_slave)
+    {
+        close(fd_slave);
+    }
+    close(fd);
+    return 0;
+}
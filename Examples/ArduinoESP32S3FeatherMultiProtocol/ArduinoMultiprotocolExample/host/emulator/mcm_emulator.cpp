@@ -0,0 +1,1299 @@
+/**
+ * @file mcm_emulator.cpp
+ * @author OXIT embedded firmware team
+ * @brief Emulated MCM modem, the frames, the timed outcomes of the commands, the events and the ymodem sender.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "mcm_emulator.h"
+#include "checksum.h"
+#include <fstream>
+#include <sstream>
+#include <string.h>
+
+/******************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ ******************************************************************************/
+#define FRAME_HEADER_LEN            5               // type, code, length
+#define FRAME_MAX_PAYLOAD_LEN       (MAX_SERIAL_SEND_PAYLOAD_SIZE - MIN_TX_PAYLOAD_LEN)
+#define RESET_COMMAND_DELAY_US      ((uint64_t)10 * 1000)  // the response goes out before the modem restarts
+#define CLASS_SWITCH_DELAY_US       ((uint64_t)50 * 1000)
+#define MAC_TIME_DELAY_US           ((uint64_t)1000 * 1000)
+
+#define YMODEM_SOH                  0x01
+#define YMODEM_STX                  0x02
+#define YMODEM_EOT                  0x04
+#define YMODEM_ACK                  0x06
+#define YMODEM_NAK                  0x15
+#define YMODEM_CAN                  0x18
+#define YMODEM_CRC16                0x43
+#define YMODEM_HEADER_SIZE          128
+#define YMODEM_DATA_SIZE            1024
+#define YMODEM_PAD                  0x1A
+
+/******************************************************************************
+ * PRIVATE TYPEDEFS
+ ******************************************************************************/
+typedef struct
+{
+    const char *p_name;
+    uint16_t u16_value;
+} name_t;
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static const name_t s_command_names[] = {
+    { "GET_EVENT", MROVER_CC_GET_EVENT },
+    { "GET_VERSION", MROVER_CC_GET_VERSION },
+    { "RESET", MROVER_CC_RESET },
+    { "FACTORY_RESET", MROVER_CC_FACTORY_RESET },
+    { "GET_GPS_TIME", MROVER_CC_GET_GPS_TIME },
+    { "GET_JOIN_EUI", MROVER_CC_GET_JOIN_EUI },
+    { "SET_JOIN_EUI", MROVER_CC_SET_JOIN_EUI },
+    { "GET_DEV_EUI", MROVER_CC_GET_DEV_EUI },
+    { "SET_DEV_EUI", MROVER_CC_SET_DEV_EUI },
+    { "SET_NW_KEY", MROVER_CC_SET_NW_KEY },
+    { "GET_LORAWAN_CLASS", MROVER_CC_GET_LORAWAN_CLASS },
+    { "SET_LORAWAN_CLASS", MROVER_CC_SET_LORAWAN_CLASS },
+    { "JOIN_LORAWAN", MROVER_CC_JOIN_LORAWAN },
+    { "LEAVE_LORAWAN_NETWORK", MROVER_CC_LEAVE_LORAWAN_NETWORK },
+    { "REQUEST_UPLINK", MROVER_CC_REQUEST_UPLINK },
+    { "LORAWAN_TIME_REQ", MROVER_CC_LORAWAN_TIME_REQ },
+    { "START_FILE_TRANSFER", MROVER_CC_START_FILE_TRANSFER },
+    { "FILE_STATUS", MROVER_CC_FILE_STATUS },
+    { "TRIGGER_FW_UPDATE", MROVER_CC_TRIGGER_FW_UPDATE },
+    { "GET_LAST_DL_STATS", MROVER_CC_GET_LAST_DL_STATS },
+    { "FSK_LINK_REQUEST", MROVER_CC_FSK_LINK_REQUEST },
+    { "CSS_LINK_REQUEST", MROVER_CC_CSS_LINK_REQUEST },
+    { "BLE_LINK_REQUEST", MROVER_CC_BLE_LINK_REQUEST },
+    { "BLE_CONNECTION_REQUEST", MROVER_CC_BLE_CONNECTION_REQUEST },
+    { "SET_FILTERING_DOWNLINK_SIDEWALK", MROVER_CC_SET_FILTERING_DOWNLINK_SIDEWALK },
+    { "SET_CSS_PWR_PROFILE", MROVER_CC_SET_CSS_PWR_PROFILE },
+    { "STOP_SID_LORAWAN_NETWORK", MROVER_CC_STOP_SID_LORAWAN_NETWORK },
+    { "INIT_LORAWAN", MROVER_CC_INIT_LORAWAN },
+    { "SWITCH_NETWORK", MROVER_CC_SWITCH_NETWORK },
+    { "GET_NEXT_UPLINK_MTU", MROVER_CC_GET_NEXT_UPLINK_MTU },
+    { "SET_UART_BAUD", MROVER_CC_SET_UART_BAUD },
+};
+
+static const name_t s_event_names[] = {
+    { "RESET", MODEM_EVENT_RESET },
+    { "ALARM", MODEM_EVENT_ALARM },
+    { "JOINED", MODEM_EVENT_JOINED },
+    { "TXDONE", MODEM_EVENT_TXDONE },
+    { "DOWNDATA", MODEM_EVENT_DOWNDATA },
+    { "JOINFAIL", MODEM_EVENT_JOINFAIL },
+    { "TIME", MODEM_EVENT_TIME },
+    { "LINK_CHECK", MODEM_EVENT_LINK_CHECK },
+    { "LORAWAN_MAC_TIME", MODEM_EVENT_LORAWAN_MAC_TIME },
+    { "SEGMENTED_FILE_DOWNLOAD", MODEM_EVENT_SEGMENTED_FILE_DOWNLOAD },
+    { "CLASS_SWITCHED", MODEM_EVENT_CLASS_SWITCHED },
+};
+
+static const name_t s_type_names[] = {
+    { "general", COMMAND_TYPE_GENERAL },
+    { "lorawan", COMMAND_TYPE_LORAWAN },
+    { "sidewalk", COMMAND_TYPE_SIDEWALK },
+};
+
+static const name_t s_tx_status_names[] = {
+    { "notsent", MROVER_TX_NOT_SEND },
+    { "noack", MROVER_TX_DONE_WITHOUT_ACK },
+    { "ack", MROVER_TX_DONE_WITH_ACK },
+};
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static bool parse_number(const std::string &word, uint32_t *p_value)
+{
+    char *p_end = NULL;
+    unsigned long value = strtoul(word.c_str(), &p_end, 0);
+
+    if (word.empty() || ('\0' != *p_end))
+    {
+        return false;
+    }
+    *p_value = (uint32_t)value;
+    return true;
+}
+
+static bool parse_signed(const std::string &word, int32_t *p_value)
+{
+    char *p_end = NULL;
+    long value = strtol(word.c_str(), &p_end, 0);
+
+    if (word.empty() || ('\0' != *p_end))
+    {
+        return false;
+    }
+    *p_value = (int32_t)value;
+    return true;
+}
+
+/**
+ * @brief A name of the table, case insensitive, or a number.
+ */
+template <size_t N>
+static bool parse_name(const std::string &word, const name_t (&names)[N], uint32_t *p_value)
+{
+    for (const name_t &name : names)
+    {
+        if (0 == strcasecmp(word.c_str(), name.p_name))
+        {
+            *p_value = name.u16_value;
+            return true;
+        }
+    }
+    return parse_number(word, p_value);
+}
+
+static bool parse_hex(const std::string &word, std::vector<uint8_t> *p_data)
+{
+    p_data->clear();
+    if (0 != (word.size() % 2))
+    {
+        return false;
+    }
+    for (size_t i = 0; i < word.size(); i += 2)
+    {
+        uint32_t u32_byte;
+        if (!isxdigit((unsigned char)word[i]) || !isxdigit((unsigned char)word[i + 1]) ||
+            !parse_number("0x" + word.substr(i, 2), &u32_byte))
+        {
+            return false;
+        }
+        p_data->push_back((uint8_t)u32_byte);
+    }
+    return true;
+}
+
+/**
+ * @brief major.minor.patch into p_version, patch on one byte or on two for the 16 bit fields.
+ */
+static bool parse_version(const std::string &word, uint8_t *p_version, bool is_patch16)
+{
+    unsigned major, minor, patch;
+    char c_end;
+
+    if (3 != sscanf(word.c_str(), "%u.%u.%u%c", &major, &minor, &patch, &c_end))
+    {
+        return false;
+    }
+    p_version[0] = (uint8_t)major;
+    p_version[1] = (uint8_t)minor;
+    if (is_patch16)
+    {
+        p_version[2] = (uint8_t)(patch >> 8);
+        p_version[3] = (uint8_t)patch;
+    }
+    else
+    {
+        p_version[2] = (uint8_t)patch;
+    }
+    return true;
+}
+
+static void put_u16(std::vector<uint8_t> &data, uint16_t u16_value)
+{
+    data.push_back((uint8_t)(u16_value >> 8));
+    data.push_back((uint8_t)u16_value);
+}
+
+static void put_u32(std::vector<uint8_t> &data, uint32_t u32_value)
+{
+    put_u16(data, (uint16_t)(u32_value >> 16));
+    put_u16(data, (uint16_t)u32_value);
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+McmEmulator::McmEmulator()
+{
+    // firmware the sketch is shipped against
+    static const uint8_t au8_version[GET_VERSION_RESPONSE_PAYLOAD_LEN] = { 1, 0, 0, 2, 0, 5, 0, 8, 1, 0, 0, 1, 1, 0, 1, 0, 4 };
+
+    memcpy(_config.au8_version, au8_version, sizeof(_config.au8_version));
+    _config.u64_processing_us = 2000;
+    _config.u64_boot_us = 500 * 1000ULL;
+    _config.u64_join_us = 5000 * 1000ULL;
+    _config.b_join_ok = true;
+    _config.u8_join_fail_reason = JOIN_FAIL_REG;
+    _config.u64_link_us = 3000 * 1000ULL;
+    _config.u64_ble_setup_us = 800 * 1000ULL;
+    _config.u64_ble_idle_us = 0;
+    _config.u64_tx_us = 1500 * 1000ULL;
+    _config.u8_tx_status = MROVER_TX_DONE_WITHOUT_ACK;
+    _config.u16_mtu = 242;
+    _config.b_gps_available = true;
+    _config.u32_gps_time = 1400000000;
+    _config.u32_baud_verify_ms = MROVER_BAUD_VERIFY_WINDOW_MS;
+    memset(_config.au8_seg_status, 0, sizeof(_config.au8_seg_status));
+    _config.file_name = "mcm_fw.bin";
+}
+
+bool McmEmulator::load_script_file(const char *p_path, std::string *p_error)
+{
+    std::ifstream file(p_path);
+    std::stringstream text;
+
+    if (!file)
+    {
+        if (NULL != p_error)
+        {
+            *p_error = std::string("cannot open ") + p_path;
+        }
+        return false;
+    }
+    text << file.rdbuf();
+    return load_script(text.str(), p_error);
+}
+
+bool McmEmulator::load_script(const std::string &text, std::string *p_error)
+{
+    std::istringstream lines(text);
+    std::string line;
+    uint32_t u32_line = 0;
+
+    while (std::getline(lines, line))
+    {
+        std::vector<std::string> words;
+        std::string word;
+        std::string error;
+
+        u32_line++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream tokens(line);
+        while (tokens >> word)
+        {
+            words.push_back(word);
+        }
+        if (words.empty())
+        {
+            continue;
+        }
+
+        bool is_ok = true;
+        if ("at" == words[0])
+        {
+            uint32_t u32_ms;
+            if ((3 > words.size()) || !parse_number(words[1], &u32_ms))
+            {
+                is_ok = false;
+            }
+            else
+            {
+                std::vector<std::string> statement(words.begin() + 2, words.end());
+                // checked now, run later
+                McmEmulator check;
+                is_ok = check.run_statement(statement, true, 0, &error);
+                if (is_ok && _is_origin_set)
+                {
+                    schedule(_u64_origin_us + (uint64_t)u32_ms * 1000ULL, [this, statement](uint64_t u64_now_us)
+                             { run_statement(statement, true, u64_now_us, NULL); });
+                }
+                else if (is_ok)
+                {
+                    _timed.push_back(std::make_pair((uint64_t)u32_ms * 1000ULL, statement));
+                }
+            }
+        }
+        else
+        {
+            is_ok = run_statement(words, false, 0, &error);
+        }
+        if (!is_ok)
+        {
+            if (NULL != p_error)
+            {
+                *p_error = "line " + std::to_string(u32_line) + ": " + line + (error.empty() ? "" : (" (" + error + ")"));
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+bool McmEmulator::run_statement(const std::vector<std::string> &words, bool is_timed, uint64_t u64_now_us, std::string *p_error)
+{
+    const std::string &keyword = words[0];
+    size_t count = words.size();
+    uint32_t u32_value = 0;
+    uint32_t u32_value2 = 0;
+
+    if ("version" == keyword)
+    {
+        uint8_t au8_version[GET_VERSION_RESPONSE_PAYLOAD_LEN];
+        if ((6 != count) || !parse_version(words[1], &au8_version[0], true) || !parse_version(words[2], &au8_version[4], true) ||
+            !parse_version(words[3], &au8_version[8], false) || !parse_version(words[4], &au8_version[11], false) ||
+            !parse_version(words[5], &au8_version[14], false))
+        {
+            return false;
+        }
+        memcpy(_config.au8_version, au8_version, sizeof(au8_version));
+    }
+    else if (("processing" == keyword) || ("boot" == keyword) || ("link" == keyword))
+    {
+        if ((2 != count) || !parse_number(words[1], &u32_value))
+        {
+            return false;
+        }
+        uint64_t u64_us = (uint64_t)u32_value * 1000ULL;
+        ("processing" == keyword) ? (_config.u64_processing_us = u64_us) : ("boot" == keyword) ? (_config.u64_boot_us = u64_us) : (_config.u64_link_us = u64_us);
+    }
+    else if ("ble" == keyword)
+    {
+        if ((2 > count) || (3 < count) || !parse_number(words[1], &u32_value) || ((3 == count) && !parse_number(words[2], &u32_value2)))
+        {
+            return false;
+        }
+        _config.u64_ble_setup_us = (uint64_t)u32_value * 1000ULL;
+        _config.u64_ble_idle_us = (uint64_t)u32_value2 * 1000ULL;
+    }
+    else if ("join" == keyword)
+    {
+        size_t next = 2;
+        if ((2 > count) || (("ok" != words[1]) && ("fail" != words[1])))
+        {
+            return false;
+        }
+        _config.b_join_ok = ("ok" == words[1]);
+        if (!_config.b_join_ok && (next < count))
+        {
+            if (!parse_number(words[next++], &u32_value))
+            {
+                return false;
+            }
+            _config.u8_join_fail_reason = (uint8_t)u32_value;
+        }
+        if (next < count)
+        {
+            if (!parse_number(words[next++], &u32_value) || (next != count))
+            {
+                return false;
+            }
+            _config.u64_join_us = (uint64_t)u32_value * 1000ULL;
+        }
+    }
+    else if ("txdone" == keyword)
+    {
+        if ((2 > count) || (3 < count) || !parse_name(words[1], s_tx_status_names, &u32_value))
+        {
+            return false;
+        }
+        _config.u8_tx_status = (uint8_t)u32_value;
+        if (3 == count)
+        {
+            if (!parse_number(words[2], &u32_value))
+            {
+                return false;
+            }
+            _config.u64_tx_us = (uint64_t)u32_value * 1000ULL;
+        }
+    }
+    else if ("txstatus" == keyword)
+    {
+        for (size_t i = 1; i < count; i++)
+        {
+            if (!parse_name(words[i], s_tx_status_names, &u32_value))
+            {
+                return false;
+            }
+            _tx_statuses.push_back((uint8_t)u32_value);
+        }
+    }
+    else if ("mtu" == keyword)
+    {
+        if ((2 != count) || !parse_number(words[1], &u32_value))
+        {
+            return false;
+        }
+        _config.u16_mtu = (uint16_t)u32_value;
+    }
+    else if ("gps" == keyword)
+    {
+        if (2 != count)
+        {
+            return false;
+        }
+        _config.b_gps_available = ("none" != words[1]);
+        if (_config.b_gps_available)
+        {
+            if (!parse_number(words[1], &u32_value))
+            {
+                return false;
+            }
+            _config.u32_gps_time = u32_value;
+        }
+    }
+    else if ("baud" == keyword)
+    {
+        _config.baud_rates.clear();
+        for (size_t i = 1; i < count; i++)
+        {
+            if (!parse_number(words[i], &u32_value))
+            {
+                return false;
+            }
+            _config.baud_rates.push_back(u32_value);
+        }
+    }
+    else if (("rc" == keyword) || ("drop" == keyword))
+    {
+        if ((3 != count) || !parse_name(words[1], s_command_names, &u32_value) || !parse_number(words[2], &u32_value2))
+        {
+            return false;
+        }
+        ("rc" == keyword) ? set_rc((uint16_t)u32_value, (uint8_t)u32_value2) : drop_responses((uint16_t)u32_value, u32_value2);
+    }
+    else if ("file" == keyword)
+    {
+        if ((2 > count) || (3 < count))
+        {
+            return false;
+        }
+        std::ifstream file(words[1], std::ios::binary);
+        if (!file)
+        {
+            if (NULL != p_error)
+            {
+                *p_error = "cannot open " + words[1];
+            }
+            return false;
+        }
+        _config.file.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        _config.file_name = (3 == count) ? words[2] : words[1].substr(words[1].rfind('/') + 1);
+    }
+    else if ("corrupt" == keyword)
+    {
+        u32_value2 = 1;
+        if ((2 > count) || (3 < count) || !parse_number(words[1], &u32_value) || ((3 == count) && !parse_number(words[2], &u32_value2)))
+        {
+            return false;
+        }
+        corrupt_ymodem_block(u32_value, u32_value2);
+    }
+    else if ("segments" == keyword)
+    {
+        uint8_t au8_version[3];
+        uint32_t u32_pkg_size, u32_seg_size, u32_next, u32_status, u32_active;
+        if ((8 != count) || !parse_number(words[1], &u32_value) || !parse_version(words[2], au8_version, false) ||
+            !parse_number(words[3], &u32_pkg_size) || !parse_number(words[4], &u32_seg_size) || !parse_number(words[5], &u32_next) ||
+            !parse_number(words[6], &u32_status) || !parse_number(words[7], &u32_active))
+        {
+            return false;
+        }
+        uint8_t *p_status = _config.au8_seg_status;
+        p_status[0] = (uint8_t)(u32_value & 0x0F);
+        memcpy(&p_status[1], au8_version, sizeof(au8_version));
+        p_status[4] = (uint8_t)(u32_pkg_size >> 16);
+        p_status[5] = (uint8_t)(u32_pkg_size >> 8);
+        p_status[6] = (uint8_t)u32_pkg_size;
+        p_status[7] = (uint8_t)((u32_seg_size & 0x0F) | ((u32_next & 0x0F) << 4));
+        p_status[8] = (uint8_t)u32_status;
+        p_status[9] = (uint8_t)(u32_status >> 8);
+        p_status[10] = (uint8_t)u32_active;
+        if (is_timed)
+        {
+            push_event({ MODEM_EVENT_SEGMENTED_FILE_DOWNLOAD, COMMAND_TYPE_GENERAL,
+                         std::vector<uint8_t>(p_status, p_status + sizeof(_config.au8_seg_status)) });
+        }
+    }
+    else if (!is_timed && (("event" == keyword) || ("downlink" == keyword) || ("raw" == keyword) || ("reset" == keyword)))
+    {
+        if (NULL != p_error)
+        {
+            *p_error = "needs a time, at <ms> " + keyword;
+        }
+        return false;
+    }
+    else if ("event" == keyword)
+    {
+        std::vector<uint8_t> data;
+        u32_value2 = COMMAND_TYPE_GENERAL;
+        if ((2 > count) || (4 < count) || !parse_name(words[1], s_event_names, &u32_value) ||
+            ((3 <= count) && !parse_name(words[2], s_type_names, &u32_value2)) || ((4 == count) && !parse_hex(words[3], &data)))
+        {
+            return false;
+        }
+        push_event({ (uint8_t)u32_value, (uint8_t)u32_value2, data });
+    }
+    else if ("downlink" == keyword)
+    {
+        std::vector<uint8_t> data;
+        int32_t i32_rssi, i32_snr;
+        if ((5 > count) || (6 < count) || !parse_name(words[1], s_type_names, &u32_value) ||
+            !parse_number(words[2], &u32_value2) || !parse_signed(words[3], &i32_rssi) || !parse_signed(words[4], &i32_snr) ||
+            ((6 == count) && !parse_hex(words[5], &data)))
+        {
+            return false;
+        }
+        schedule_downlink(u64_now_us, (uint8_t)u32_value, (uint16_t)u32_value2, (int8_t)i32_rssi, (int8_t)i32_snr, data);
+    }
+    else if ("raw" == keyword)
+    {
+        std::vector<uint8_t> data;
+        if ((2 != count) || !parse_hex(words[1], &data))
+        {
+            return false;
+        }
+        schedule_raw(u64_now_us, data);
+    }
+    else if ("reset" == keyword)
+    {
+        if (1 != count)
+        {
+            return false;
+        }
+        power_on(u64_now_us);
+    }
+    else
+    {
+        if (NULL != p_error)
+        {
+            *p_error = "unknown statement";
+        }
+        return false;
+    }
+    return true;
+}
+
+void McmEmulator::power_on(uint64_t u64_now_us)
+{
+    uint32_t u32_generation;
+
+    if (!_is_origin_set)
+    {
+        _is_origin_set = true;
+        _u64_origin_us = u64_now_us;
+        for (const auto &timed : _timed)
+        {
+            std::vector<std::string> statement = timed.second;
+            schedule(_u64_origin_us + timed.first, [this, statement](uint64_t u64_at_us)
+                     { run_statement(statement, true, u64_at_us, NULL); });
+        }
+        _timed.clear();
+    }
+    reset_state();
+    _is_powered = true;
+    _is_in_reset = false;
+    _stats.u32_resets++;
+    u32_generation = _u32_generation;
+    schedule(u64_now_us + _config.u64_boot_us, [this, u32_generation](uint64_t)
+             {
+                 if (u32_generation == _u32_generation)
+                 {
+                     _u32_reset_count++;
+                     push_event({ MODEM_EVENT_RESET, COMMAND_TYPE_GENERAL,
+                                  { (uint8_t)(_u32_reset_count >> 8), (uint8_t)_u32_reset_count } });
+                 }
+             });
+}
+
+void McmEmulator::set_reset_line(bool is_high, uint64_t u64_now_us)
+{
+    if (!is_high)
+    {
+        reset_state();
+        _is_in_reset = true;
+    }
+    else if (_is_in_reset || !_is_powered)
+    {
+        power_on(u64_now_us);
+    }
+}
+
+void McmEmulator::reset_state()
+{
+    _u32_generation++;
+    _frame.clear();
+    _u64_busy_until_us = 0;
+    _u32_baud_rate = MROVER_DEFAULT_BAUD_RATE;
+    _u32_previous_baud_rate = MROVER_DEFAULT_BAUD_RATE;
+    _is_baud_verified = true;
+    _events.clear();
+    _is_notified = false;
+    _is_joined = false;
+    _is_ble_link = false;
+    _u64_ble_up_us = UINT64_MAX;
+    _ymodem_state = YMODEM_SEND_IDLE;
+}
+
+/**
+ * @brief The ble connection is up and not idle for too long.
+ */
+bool McmEmulator::is_ble_connected(uint64_t u64_now_us)
+{
+    if ((UINT64_MAX == _u64_ble_up_us) || (u64_now_us < _u64_ble_up_us))
+    {
+        return false;
+    }
+    if ((0 != _config.u64_ble_idle_us) && ((u64_now_us - std::max(_u64_ble_up_us, _u64_ble_traffic_us)) >= _config.u64_ble_idle_us))
+    {
+        _u64_ble_up_us = UINT64_MAX;
+        return false;
+    }
+    return true;
+}
+
+void McmEmulator::schedule(uint64_t u64_at_us, std::function<void(uint64_t)> action)
+{
+    _actions.insert(std::make_pair(u64_at_us, action));
+}
+
+void McmEmulator::schedule_event(uint64_t u64_at_us, uint8_t u8_code, uint8_t u8_cmd_type, const std::vector<uint8_t> &data)
+{
+    event_t event = { u8_code, u8_cmd_type, data };
+    schedule(u64_at_us, [this, event](uint64_t) { push_event(event); });
+}
+
+void McmEmulator::schedule_downlink(uint64_t u64_at_us, uint8_t u8_cmd_type, uint16_t u16_port_seq, int8_t i8_rssi, int8_t i8_snr,
+                                    const std::vector<uint8_t> &data)
+{
+    schedule(u64_at_us, [=](uint64_t u64_now_us)
+             {
+                 event_t event = { MODEM_EVENT_DOWNDATA, u8_cmd_type, {} };
+                 if (COMMAND_TYPE_LORAWAN == u8_cmd_type)
+                 {
+                     event.data = { (uint8_t)i8_rssi, (uint8_t)i8_snr, (uint8_t)u16_port_seq };
+                 }
+                 else
+                 {
+                     event.data = { (uint8_t)(u16_port_seq >> 8), (uint8_t)u16_port_seq, (uint8_t)i8_rssi, (uint8_t)i8_snr };
+                 }
+                 event.data.insert(event.data.end(), data.begin(), data.end());
+                 if (_is_powered && !_is_in_reset)
+                 {
+                     std::vector<uint8_t> stats = { u8_cmd_type, (uint8_t)i8_rssi, (uint8_t)i8_snr };
+                     put_u32(stats, _config.u32_gps_time + (uint32_t)((u64_now_us - _u64_origin_us) / 1000000ULL));
+                     memcpy(_au8_last_dl_stats, stats.data(), sizeof(_au8_last_dl_stats));
+                 }
+                 push_event(event);
+             });
+}
+
+void McmEmulator::schedule_raw(uint64_t u64_at_us, const std::vector<uint8_t> &data)
+{
+    schedule(u64_at_us, [this, data](uint64_t)
+             {
+                 if (_is_powered && !_is_in_reset)
+                 {
+                     transmit(data);
+                 }
+             });
+}
+
+uint32_t McmEmulator::get_command_count(uint16_t u16_cmd_code) const
+{
+    uint32_t u32_count = 0;
+
+    for (const mcm_emu_command_t &command : _commands)
+    {
+        u32_count += (u16_cmd_code == command.u16_cmd_code) ? 1 : 0;
+    }
+    return u32_count;
+}
+
+uint64_t McmEmulator::poll(uint64_t u64_now_us)
+{
+    while (!_actions.empty() && (_actions.begin()->first <= u64_now_us))
+    {
+        auto action = _actions.begin()->second;
+        uint64_t u64_at_us = _actions.begin()->first;
+        _actions.erase(_actions.begin());
+        action(u64_at_us);
+    }
+    // a frame the host stopped sending is dropped
+    if (!_frame.empty() && ((u64_now_us - _u64_last_rx_us) >= MCM_EMU_FRAME_GAP_US))
+    {
+        _stats.u32_noise_bytes += (uint32_t)_frame.size();
+        _frame.clear();
+    }
+
+    uint64_t u64_next_us = _actions.empty() ? MCM_EMU_NO_DEADLINE : _actions.begin()->first;
+    if (!_frame.empty())
+    {
+        u64_next_us = std::min(u64_next_us, _u64_last_rx_us + MCM_EMU_FRAME_GAP_US);
+    }
+    return u64_next_us;
+}
+
+void McmEmulator::transmit(const std::vector<uint8_t> &data)
+{
+    if (_transmit && !data.empty())
+    {
+        _transmit(data.data(), data.size());
+    }
+}
+
+void McmEmulator::receive(uint8_t u8_byte, uint64_t u64_now_us)
+{
+    if (!_is_powered || _is_in_reset)
+    {
+        return;
+    }
+    if (_frame.empty() && is_ymodem_byte(u8_byte))
+    {
+        ymodem_receive(u8_byte);
+        return;
+    }
+    if (!_frame.empty() && ((u64_now_us - _u64_last_rx_us) >= MCM_EMU_FRAME_GAP_US))
+    {
+        _stats.u32_noise_bytes += (uint32_t)_frame.size();
+        _frame.clear();
+    }
+    _u64_last_rx_us = u64_now_us;
+    _frame.push_back(u8_byte);
+    receive_frame(u64_now_us);
+}
+
+/**
+ * @brief Drops what cannot start a frame, handles the frame once complete.
+ */
+void McmEmulator::receive_frame(uint64_t u64_now_us)
+{
+    while (!_frame.empty())
+    {
+        if ((COMMAND_TYPE_GENERAL > _frame[0]) || (COMMAND_TYPE_SIDEWALK < _frame[0]))
+        {
+            _stats.u32_noise_bytes++;
+            _frame.erase(_frame.begin());
+            continue;
+        }
+        if (FRAME_HEADER_LEN > _frame.size())
+        {
+            return;
+        }
+        uint16_t u16_len = (uint16_t)((_frame[3] << 8) | _frame[4]);
+        if (FRAME_MAX_PAYLOAD_LEN < u16_len)
+        {
+            _stats.u32_noise_bytes++;
+            _frame.erase(_frame.begin());
+            continue;
+        }
+        size_t frame_len = FRAME_HEADER_LEN + u16_len + 1;
+        if (_frame.size() < frame_len)
+        {
+            return;
+        }
+
+        mcm_emu_command_t command;
+        command.u8_cmd_type = _frame[0];
+        command.u16_cmd_code = (uint16_t)((_frame[1] << 8) | _frame[2]);
+        command.payload.assign(_frame.begin() + FRAME_HEADER_LEN, _frame.begin() + FRAME_HEADER_LEN + u16_len);
+        command.u64_time_us = u64_now_us;
+        bool is_crc_ok = (checksum_xor8(0, _frame.data(), (uint32_t)(frame_len - 1)) == _frame[frame_len - 1]);
+        _frame.erase(_frame.begin(), _frame.begin() + frame_len);
+
+        uint64_t u64_at_us = std::max(u64_now_us, _u64_busy_until_us) + _config.u64_processing_us;
+        uint32_t u32_generation = _u32_generation;
+        _u64_busy_until_us = u64_at_us;
+        if (!is_crc_ok)
+        {
+            _stats.u32_bad_crc++;
+            schedule(u64_at_us, [this, command, u32_generation](uint64_t)
+                     {
+                         if (u32_generation == _u32_generation)
+                         {
+                             send_response(MROVER_RC_BAD_CRC, command.u8_cmd_type, command.u16_cmd_code, {});
+                         }
+                     });
+            continue;
+        }
+        _stats.u32_commands++;
+        _is_baud_verified = true;
+        _commands.push_back(command);
+        schedule(u64_at_us, [this, command, u32_generation](uint64_t u64_at)
+                 {
+                     if (u32_generation == _u32_generation)
+                     {
+                         handle_command(command, u64_at);
+                     }
+                 });
+    }
+}
+
+void McmEmulator::handle_command(const mcm_emu_command_t &command, uint64_t u64_now_us)
+{
+    std::vector<uint8_t> payload;
+    uint8_t u8_rc = MROVER_RC_OK;
+    uint8_t u8_response_type = command.u8_cmd_type;
+    auto it_drop = _drops.find(command.u16_cmd_code);
+    auto it_rc = _rc_overrides.find(command.u16_cmd_code);
+    auto it_handler = _handlers.find(command.u16_cmd_code);
+
+    if ((_drops.end() != it_drop) && (0 < it_drop->second))
+    {
+        it_drop->second--;
+        _stats.u32_responses_dropped++;
+        return;
+    }
+    if (_rc_overrides.end() != it_rc)
+    {
+        u8_rc = it_rc->second;
+    }
+    else if ((_handlers.end() == it_handler) || !it_handler->second(command, u8_rc, payload))
+    {
+        u8_rc = answer_command(command, u8_response_type, payload, u64_now_us);
+    }
+    send_response(u8_rc, u8_response_type, command.u16_cmd_code, payload);
+
+    // applied once the response is sent at the previous rate
+    if ((MROVER_CC_SET_UART_BAUD == command.u16_cmd_code) && (MROVER_RC_OK == u8_rc))
+    {
+        uint32_t u32_generation = _u32_generation;
+        _u32_previous_baud_rate = _u32_baud_rate;
+        _u32_baud_rate = ((uint32_t)command.payload[0] << 24) | ((uint32_t)command.payload[1] << 16) |
+                         ((uint32_t)command.payload[2] << 8) | command.payload[3];
+        _is_baud_verified = false;
+        schedule(u64_now_us + (uint64_t)_config.u32_baud_verify_ms * 1000ULL, [this, u32_generation](uint64_t)
+                 {
+                     if ((u32_generation == _u32_generation) && !_is_baud_verified)
+                     {
+                         _u32_baud_rate = _u32_previous_baud_rate;
+                         _is_baud_verified = true;
+                     }
+                 });
+    }
+}
+
+/**
+ * @brief Does what the command asks and fills its response, the response has the type of the command but for GET_EVENT.
+ * @return return code of the response
+ */
+uint8_t McmEmulator::answer_command(const mcm_emu_command_t &command, uint8_t &u8_response_type, std::vector<uint8_t> &payload,
+                                    uint64_t u64_now_us)
+{
+    const std::vector<uint8_t> &in = command.payload;
+    uint32_t u32_generation = _u32_generation;
+
+    switch (command.u16_cmd_code)
+    {
+    case MROVER_CC_GET_EVENT:
+        _is_notified = false;
+        if (_events.empty())
+        {
+            payload = { MODEM_EVENT_NONE, 0 };
+            break;
+        }
+        payload = { _events.front().u8_code, (uint8_t)std::min<size_t>(_events.size() - 1, UINT8_MAX) };
+        payload.insert(payload.end(), _events.front().data.begin(), _events.front().data.end());
+        // the response carries the type of the event
+        u8_response_type = _events.front().u8_cmd_type;
+        _events.erase(_events.begin());
+        _stats.u32_events_sent++;
+        break;
+
+    case MROVER_CC_GET_VERSION:
+        payload.assign(_config.au8_version, _config.au8_version + sizeof(_config.au8_version));
+        break;
+
+    case MROVER_CC_RESET:
+    case MROVER_CC_FACTORY_RESET:
+        if (MROVER_CC_FACTORY_RESET == command.u16_cmd_code)
+        {
+            memset(_au8_dev_eui, 0, sizeof(_au8_dev_eui));
+            memset(_au8_join_eui, 0, sizeof(_au8_join_eui));
+            memset(_au8_nw_key, 0, sizeof(_au8_nw_key));
+            _u8_class = MROVER_LORAWAN_CLASS_A;
+        }
+        schedule(u64_now_us + RESET_COMMAND_DELAY_US, [this, u32_generation](uint64_t u64_at_us)
+                 {
+                     if (u32_generation == _u32_generation)
+                     {
+                         power_on(u64_at_us);
+                     }
+                 });
+        break;
+
+    case MROVER_CC_GET_GPS_TIME:
+        if (!_config.b_gps_available)
+        {
+            return MROVER_RC_GPS_TIME_NOT_AVAILABLE;
+        }
+        put_u32(payload, _config.u32_gps_time + (uint32_t)((u64_now_us - _u64_origin_us) / 1000000ULL));
+        break;
+
+    case MROVER_CC_GET_JOIN_EUI:
+        payload.assign(_au8_join_eui, _au8_join_eui + sizeof(_au8_join_eui));
+        break;
+
+    case MROVER_CC_GET_DEV_EUI:
+        payload.assign(_au8_dev_eui, _au8_dev_eui + sizeof(_au8_dev_eui));
+        break;
+
+    case MROVER_CC_SET_JOIN_EUI:
+    case MROVER_CC_SET_DEV_EUI:
+    case MROVER_CC_SET_NW_KEY:
+    {
+        uint8_t *p_value = (MROVER_CC_SET_JOIN_EUI == command.u16_cmd_code) ? _au8_join_eui :
+                           (MROVER_CC_SET_DEV_EUI == command.u16_cmd_code) ? _au8_dev_eui : _au8_nw_key;
+        size_t size = (MROVER_CC_SET_NW_KEY == command.u16_cmd_code) ? LORAWAN_NETWORK_KEY_LEN : LORAWAN_DEV_EUI_JOIN_EUI_LEN;
+        if (size != in.size())
+        {
+            return MROVER_RC_BAD_SIZE;
+        }
+        memcpy(p_value, in.data(), size);
+        break;
+    }
+
+    case MROVER_CC_GET_LORAWAN_CLASS:
+        payload = { _u8_class };
+        break;
+
+    case MROVER_CC_SET_LORAWAN_CLASS:
+        if ((1 != in.size()) || (MROVER_LORAWAN_CLASS_C < in[0]))
+        {
+            return MROVER_RC_BAD_SIZE;
+        }
+        _u8_class = in[0];
+        schedule_event(u64_now_us + CLASS_SWITCH_DELAY_US, MODEM_EVENT_CLASS_SWITCHED, COMMAND_TYPE_LORAWAN, { _u8_class });
+        break;
+
+    case MROVER_CC_JOIN_LORAWAN:
+        schedule(u64_now_us + _config.u64_join_us, [this, u32_generation](uint64_t)
+                 {
+                     if (u32_generation != _u32_generation)
+                     {
+                         return;
+                     }
+                     _is_joined = _config.b_join_ok;
+                     if (_config.b_join_ok)
+                     {
+                         push_event({ MODEM_EVENT_JOINED, COMMAND_TYPE_LORAWAN, {} });
+                     }
+                     else
+                     {
+                         push_event({ MODEM_EVENT_JOINFAIL, COMMAND_TYPE_LORAWAN, { _config.u8_join_fail_reason } });
+                     }
+                 });
+        break;
+
+    case MROVER_CC_FSK_LINK_REQUEST:
+    case MROVER_CC_CSS_LINK_REQUEST:
+    case MROVER_CC_BLE_LINK_REQUEST:
+        _is_ble_link = (MROVER_CC_BLE_LINK_REQUEST == command.u16_cmd_code);
+        _u64_ble_up_us = UINT64_MAX;
+        // time synced with the sidewalk network, over a ble connection in ble
+        schedule(u64_now_us + _config.u64_link_us, [this, u32_generation](uint64_t u64_at_us)
+                 {
+                     if (u32_generation == _u32_generation)
+                     {
+                         _is_joined = true;
+                         _u64_ble_up_us = _is_ble_link ? u64_at_us : UINT64_MAX;
+                         _u64_ble_traffic_us = u64_at_us;
+                         push_event({ MODEM_EVENT_JOINED, COMMAND_TYPE_SIDEWALK, {} });
+                     }
+                 });
+        break;
+
+    case MROVER_CC_BLE_CONNECTION_REQUEST:
+        // acknowledged at once, the link comes up later and is not notified
+        if (!is_ble_connected(u64_now_us))
+        {
+            _u64_ble_up_us = u64_now_us + _config.u64_ble_setup_us;
+            _u64_ble_traffic_us = _u64_ble_up_us;
+        }
+        break;
+
+    case MROVER_CC_LEAVE_LORAWAN_NETWORK:
+    case MROVER_CC_STOP_SID_LORAWAN_NETWORK:
+        _is_joined = false;
+        break;
+
+    case MROVER_CC_REQUEST_UPLINK:
+    {
+        mcm_emu_uplink_t uplink = { command.u8_cmd_type, 0, MROVER_UNCONFIRMED_UPLINK, {}, command.u64_time_us };
+        size_t header = (COMMAND_TYPE_LORAWAN == command.u8_cmd_type) ? 2 : 1;
+        if (header > in.size())
+        {
+            return MROVER_RC_BAD_SIZE;
+        }
+        if (!_is_joined)
+        {
+            return MROVER_RC_FAIL;
+        }
+        if (COMMAND_TYPE_LORAWAN == command.u8_cmd_type)
+        {
+            uplink.u8_port = in[0];
+        }
+        uplink.u8_uplink_type = in[header - 1];
+        uplink.data.assign(in.begin() + header, in.end());
+        _uplinks.push_back(uplink);
+
+        uint8_t u8_status = _config.u8_tx_status;
+        if (!_tx_statuses.empty())
+        {
+            u8_status = _tx_statuses.front();
+            _tx_statuses.erase(_tx_statuses.begin());
+        }
+        if ((COMMAND_TYPE_SIDEWALK == command.u8_cmd_type) && _is_ble_link)
+        {
+            // no ble connection, nothing goes on air
+            u8_status = is_ble_connected(u64_now_us) ? u8_status : (uint8_t)MROVER_TX_NOT_SEND;
+            _u64_ble_traffic_us = u64_now_us;
+        }
+        schedule_event(u64_now_us + _config.u64_tx_us, MODEM_EVENT_TXDONE, command.u8_cmd_type, { u8_status });
+        put_u16(payload, _config.u16_mtu);
+        break;
+    }
+
+    case MROVER_CC_LORAWAN_TIME_REQ:
+        schedule_event(u64_now_us + MAC_TIME_DELAY_US, MODEM_EVENT_LORAWAN_MAC_TIME, COMMAND_TYPE_LORAWAN,
+                       { MROVER_LORAWAN_MAC_REQ_ANSWERED });
+        break;
+
+    case MROVER_CC_START_FILE_TRANSFER:
+        if (_config.file.empty())
+        {
+            return MROVER_RC_FAIL;
+        }
+        _ymodem_state = YMODEM_SEND_WAIT_C;
+        _u32_ymodem_block = 0;
+        _stats.b_ymodem_done = false;
+        _stats.b_ymodem_cancelled = false;
+        break;
+
+    case MROVER_CC_FILE_STATUS:
+        payload.assign(_config.au8_seg_status, _config.au8_seg_status + sizeof(_config.au8_seg_status));
+        break;
+
+    case MROVER_CC_GET_LAST_DL_STATS:
+        payload.assign(_au8_last_dl_stats, _au8_last_dl_stats + sizeof(_au8_last_dl_stats));
+        break;
+
+    case MROVER_CC_GET_NEXT_UPLINK_MTU:
+        payload = { command.u8_cmd_type };
+        put_u16(payload, _config.u16_mtu);
+        break;
+
+    case MROVER_CC_SET_UART_BAUD:
+    {
+        if (_config.baud_rates.empty())
+        {
+            // firmware without the command
+            return MROVER_RC_UNKNOWN;
+        }
+        if (SET_UART_BAUD_PAYLOAD_LEN != in.size())
+        {
+            return MROVER_RC_BAD_SIZE;
+        }
+        uint32_t u32_rate = ((uint32_t)in[0] << 24) | ((uint32_t)in[1] << 16) | ((uint32_t)in[2] << 8) | in[3];
+        bool is_supported = false;
+        for (uint32_t u32_supported : _config.baud_rates)
+        {
+            is_supported |= (u32_supported == u32_rate);
+        }
+        return is_supported ? MROVER_RC_OK : MROVER_RC_FAIL;
+    }
+
+    case MROVER_CC_TRIGGER_FW_UPDATE:
+    case MROVER_CC_SET_FILTERING_DOWNLINK_SIDEWALK:
+    case MROVER_CC_SET_CSS_PWR_PROFILE:
+    case MROVER_CC_INIT_LORAWAN:
+    case MROVER_CC_SWITCH_NETWORK:
+        break;
+
+    default:
+        return MROVER_RC_UNKNOWN;
+    }
+    return MROVER_RC_OK;
+}
+
+void McmEmulator::send_response(uint8_t u8_rc, uint8_t u8_cmd_type, uint16_t u16_cmd_code, const std::vector<uint8_t> &payload)
+{
+    std::vector<uint8_t> frame = { u8_rc, u8_cmd_type, (uint8_t)(u16_cmd_code >> 8), (uint8_t)u16_cmd_code };
+    put_u16(frame, (uint16_t)payload.size());
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    frame.push_back(checksum_xor8(0, frame.data(), (uint32_t)frame.size()));
+    _stats.u32_responses++;
+    transmit(frame);
+}
+
+void McmEmulator::push_event(const event_t &event)
+{
+    if (!_is_powered || _is_in_reset)
+    {
+        return;
+    }
+    _events.push_back(event);
+    if (!_is_notified)
+    {
+        send_notification();
+    }
+}
+
+void McmEmulator::send_notification()
+{
+    std::vector<uint8_t> frame = { MROVER_RC_NOTIFY_EVENTS, 0x00, LENGTH_IN_NOTIFICATION_PAYLOAD,
+                                   (uint8_t)std::min<size_t>(_events.size(), UINT8_MAX) };
+    frame.push_back(checksum_xor8(0, frame.data(), (uint32_t)frame.size()));
+    _is_notified = true;
+    _stats.u32_notifications++;
+    transmit(frame);
+}
+
+/******************************************************************************
+ * YMODEM SENDER
+ ******************************************************************************/
+bool McmEmulator::is_ymodem_byte(uint8_t u8_byte) const
+{
+    return (YMODEM_SEND_IDLE != _ymodem_state) &&
+           ((YMODEM_ACK == u8_byte) || (YMODEM_NAK == u8_byte) || (YMODEM_CRC16 == u8_byte) || (YMODEM_CAN == u8_byte));
+}
+
+void McmEmulator::ymodem_send_block(uint32_t u32_block)
+{
+    std::vector<uint8_t> packet;
+    size_t size = (0 == u32_block) ? YMODEM_HEADER_SIZE : YMODEM_DATA_SIZE;
+
+    packet.push_back((0 == u32_block) ? YMODEM_SOH : YMODEM_STX);
+    packet.push_back((uint8_t)u32_block);
+    packet.push_back((uint8_t)~u32_block);
+    if (0 == u32_block)
+    {
+        std::string header = _config.file_name;
+        header.push_back('\0');
+        header += std::to_string(_config.file.size());
+        packet.insert(packet.end(), header.begin(), header.end());
+        packet.resize(3 + size, 0);
+    }
+    else
+    {
+        size_t offset = (size_t)(u32_block - 1) * YMODEM_DATA_SIZE;
+        size_t len = std::min(_config.file.size() - offset, size);
+        packet.insert(packet.end(), _config.file.begin() + offset, _config.file.begin() + offset + len);
+        packet.resize(3 + size, YMODEM_PAD);
+    }
+    uint16_t u16_crc = checksum_crc16_ccitt(CHECKSUM_CRC16_XMODEM_INIT, &packet[3], (uint32_t)size);
+    auto it_corrupt = _ymodem_corrupt.find(u32_block);
+    if ((_ymodem_corrupt.end() != it_corrupt) && (0 < it_corrupt->second))
+    {
+        it_corrupt->second--;
+        u16_crc ^= 0x5A5A;
+    }
+    put_u16(packet, u16_crc);
+    _stats.u32_ymodem_blocks++;
+    transmit(packet);
+}
+
+void McmEmulator::ymodem_receive(uint8_t u8_byte)
+{
+    uint32_t u32_blocks = (uint32_t)((_config.file.size() + YMODEM_DATA_SIZE - 1) / YMODEM_DATA_SIZE);
+
+    if (YMODEM_CAN == u8_byte)
+    {
+        _ymodem_state = YMODEM_SEND_IDLE;
+        _stats.b_ymodem_cancelled = true;
+        return;
+    }
+    if (YMODEM_NAK == u8_byte)
+    {
+        _stats.u32_ymodem_naks++;
+    }
+
+    switch (_ymodem_state)
+    {
+    case YMODEM_SEND_WAIT_C:
+        if (YMODEM_CRC16 == u8_byte)
+        {
+            ymodem_send_block(0);
+            _ymodem_state = YMODEM_SEND_WAIT_HEADER_ACK;
+        }
+        break;
+
+    case YMODEM_SEND_WAIT_HEADER_ACK:
+        if (YMODEM_ACK == u8_byte)
+        {
+            _ymodem_state = YMODEM_SEND_WAIT_DATA_C;
+        }
+        else
+        {
+            ymodem_send_block(0);
+        }
+        break;
+
+    case YMODEM_SEND_WAIT_DATA_C:
+        if (YMODEM_CRC16 == u8_byte)
+        {
+            _u32_ymodem_block = 1;
+            ymodem_send_block(_u32_ymodem_block);
+            _ymodem_state = YMODEM_SEND_WAIT_ACK;
+        }
+        break;
+
+    case YMODEM_SEND_WAIT_ACK:
+        if (YMODEM_NAK == u8_byte)
+        {
+            ymodem_send_block(_u32_ymodem_block);
+        }
+        else if (YMODEM_ACK == u8_byte)
+        {
+            if (_u32_ymodem_block < u32_blocks)
+            {
+                ymodem_send_block(++_u32_ymodem_block);
+            }
+            else
+            {
+                transmit({ YMODEM_EOT });
+                _ymodem_state = YMODEM_SEND_WAIT_EOT_ACK;
+            }
+        }
+        break;
+
+    case YMODEM_SEND_WAIT_EOT_ACK:
+        if (YMODEM_ACK == u8_byte)
+        {
+            _ymodem_state = YMODEM_SEND_IDLE;
+            _stats.b_ymodem_done = true;
+        }
+        else if (YMODEM_NAK == u8_byte)
+        {
+            transmit({ YMODEM_EOT });
+        }
+        break;
+
+    default:
+        break;
+    }
+}
@@ -0,0 +1,349 @@
+/**
+ * @file mcm_emulator.h
+ * @author OXIT embedded firmware team
+ * @brief Emulated MCM modem, answers the serial protocol of the host library and runs a script of events.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+#ifndef __MCM_EMULATOR_H__
+#define __MCM_EMULATOR_H__
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include "commands_defs.h"
+#include <stdint.h>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+
+/**
+ * @brief No deadline, returned by poll() when nothing is scheduled.
+ */
+#define MCM_EMU_NO_DEADLINE             UINT64_MAX
+
+/**
+ * @brief Partial frame dropped when the host stays silent this long in the middle of it.
+ */
+#define MCM_EMU_FRAME_GAP_US            ((uint64_t)100 * 1000)
+
+/**********************************************************************************************************
+ * TYPEDEFS AND CLASSES
+ **********************************************************************************************************/
+
+/**
+ * @brief Command frame received from the host
+ */
+typedef struct
+{
+    uint8_t u8_cmd_type;                            // COMMAND_TYPE_GENERAL, _LORAWAN or _SIDEWALK
+    uint16_t u16_cmd_code;
+    std::vector<uint8_t> payload;
+    uint64_t u64_time_us;                           // end of the frame
+} mcm_emu_command_t;
+
+/**
+ * @brief Uplink requested by the host
+ */
+typedef struct
+{
+    uint8_t u8_cmd_type;
+    uint8_t u8_port;                                // 0 for sidewalk
+    uint8_t u8_uplink_type;                         // MROVER_UNCONFIRMED_UPLINK or MROVER_CONFIRMED_UPLINK
+    std::vector<uint8_t> data;
+    uint64_t u64_time_us;
+} mcm_emu_uplink_t;
+
+/**
+ * @brief Behaviour of the modem, set from code or from a script
+ */
+typedef struct
+{
+    uint8_t au8_version[GET_VERSION_RESPONSE_PAYLOAD_LEN];  // GET_VERSION payload
+    uint64_t u64_processing_us;                     // from the end of a command to its response
+    uint64_t u64_boot_us;                           // from the reset to the MODEM_EVENT_RESET
+    uint64_t u64_join_us;                           // from the join request to its outcome
+    bool b_join_ok;
+    uint8_t u8_join_fail_reason;
+    uint64_t u64_link_us;                           // from a sidewalk link request to the time sync
+    uint64_t u64_ble_setup_us;                      // from the ack of a ble connection request to the link up
+    uint64_t u64_ble_idle_us;                       // the ble link is closed after this time without traffic, 0 never
+    uint64_t u64_tx_us;                             // from the uplink request to MODEM_EVENT_TXDONE
+    uint8_t u8_tx_status;                           // MROVER_TX_NOT_SEND, _DONE_WITHOUT_ACK or _DONE_WITH_ACK
+    uint16_t u16_mtu;                               // next uplink mtu
+    bool b_gps_available;
+    uint32_t u32_gps_time;
+    std::vector<uint32_t> baud_rates;               // accepted by SET_UART_BAUD, none on the 0.5.8 firmware
+    uint32_t u32_baud_verify_ms;                    // back to the previous rate without a valid frame in this window
+    uint8_t au8_seg_status[11];                     // FILE_STATUS payload
+    std::vector<uint8_t> file;                      // image sent by ymodem after START_FILE_TRANSFER
+    std::string file_name;
+} mcm_emu_config_t;
+
+/**
+ * @brief Counters of the modem
+ */
+typedef struct
+{
+    uint32_t u32_commands;                          // valid command frames
+    uint32_t u32_bad_crc;
+    uint32_t u32_noise_bytes;                       // bytes dropped outside a valid frame
+    uint32_t u32_responses;
+    uint32_t u32_responses_dropped;
+    uint32_t u32_notifications;
+    uint32_t u32_events_sent;
+    uint32_t u32_resets;
+    uint32_t u32_ymodem_blocks;                     // blocks sent, repeats included
+    uint32_t u32_ymodem_naks;
+    bool b_ymodem_done;                             // last transfer acknowledged up to the EOT
+    bool b_ymodem_cancelled;
+} mcm_emu_stats_t;
+
+/**
+ * @brief Modem side of the serial protocol.
+ *
+ * The emulator is not tied to a transport: bytes of the host come in through receive(), what the modem
+ * sends goes out through the transmit function and poll() runs what is scheduled. McmEmulatorWire plugs it into
+ * a uart of the host shim, mcm_emu serves it on a pseudo terminal.
+ */
+class McmEmulator
+{
+    public:
+    typedef std::function<void(const uint8_t *p_data, size_t len)> transmit_fn;
+    /**
+     * @brief Answers a command instead of the emulator, return false to let the emulator answer.
+     */
+    typedef std::function<bool(const mcm_emu_command_t &command, uint8_t &u8_rc, std::vector<uint8_t> &payload)> command_fn;
+
+    McmEmulator();
+
+    void set_transmit(transmit_fn transmit) { _transmit = transmit; }
+
+    /**
+     * @brief Reads a script, one statement per line, # starts a comment. Durations are in ms.
+     *
+     *  version <bootloader> <firmware> <hardware> <sidewalk> <lorawan>   each major.minor.patch
+     *  processing <ms> | boot <ms> | link <ms>
+     *  ble <setup ms> [<idle ms>]                   sidewalk ble uplinks are not sent out of a connection
+     *  join ok|fail [reason] [<ms>]
+     *  txdone ack|noack|notsent [<ms>]              status of the uplinks
+     *  txstatus ack|noack|notsent ...               statuses of the next uplinks, before the txdone one
+     *  mtu <bytes> | gps <seconds>|none | baud <rate> ...
+     *  rc <command> <rc> | drop <command> <count>   command by name without MROVER_CC_ or by number
+     *  file <path> [<name>]                         image sent by ymodem after START_FILE_TRANSFER
+     *  corrupt <block> [<count>]                    ymodem block sent corrupted count times
+     *  segments <bin type> <major.minor.patch> <package size> <segment size> <next segment> <status> <active>
+     *  event <code> [general|lorawan|sidewalk] [<hex data>]      code by name without MODEM_EVENT_ or by number
+     *  downlink lorawan|sidewalk <port|sequence> <rssi> <snr> [<hex data>]
+     *  at <ms> <statement>                          run at ms after the first power on, segments then
+     *                                               also sends MODEM_EVENT_SEGMENTED_FILE_DOWNLOAD
+     *  at <ms> event|downlink|raw|reset ...         only timed
+     *  raw <hex data> | reset                       bytes sent as they are, reset of the modem
+     *
+     * @return false with the line in error in p_error
+     */
+    bool load_script(const std::string &text, std::string *p_error);
+    bool load_script_file(const char *p_path, std::string *p_error);
+
+    /**
+     * @brief Boots the modem, the volatile state is lost and MODEM_EVENT_RESET follows after the boot time.
+     * The timed statements of the script are relative to the first power on.
+     */
+    void power_on(uint64_t u64_now_us);
+
+    /**
+     * @brief Level of the reset pin, the modem is held in reset while it is low.
+     */
+    void set_reset_line(bool is_high, uint64_t u64_now_us);
+
+    /**
+     * @brief A byte from the host, received at u64_now_us.
+     */
+    void receive(uint8_t u8_byte, uint64_t u64_now_us);
+
+    /**
+     * @brief Runs what is due.
+     * @return time of the next thing to run, MCM_EMU_NO_DEADLINE if nothing is scheduled
+     */
+    uint64_t poll(uint64_t u64_now_us);
+
+    /**
+     * @brief Rate of the modem uart, changed by SET_UART_BAUD or set_baud_rate().
+     */
+    uint32_t get_baud_rate() const { return _u32_baud_rate; }
+
+    /**
+     * @brief Moves the modem uart to u32_baud_rate at once, without a command. Until the next power on.
+     */
+    void set_baud_rate(uint32_t u32_baud_rate) { _u32_baud_rate = u32_baud_rate; }
+
+    mcm_emu_config_t &config() { return _config; }
+
+    /**
+     * @brief Queues an event at u64_at_us, the host is notified if it has nothing pending.
+     */
+    void schedule_event(uint64_t u64_at_us, uint8_t u8_code, uint8_t u8_cmd_type, const std::vector<uint8_t> &data);
+
+    /**
+     * @brief Queues a downlink, u16_port_seq is the lorawan port or the sidewalk sequence number.
+     */
+    void schedule_downlink(uint64_t u64_at_us, uint8_t u8_cmd_type, uint16_t u16_port_seq, int8_t i8_rssi, int8_t i8_snr,
+                           const std::vector<uint8_t> &data);
+
+    /**
+     * @brief Sends bytes as they are at u64_at_us, for framing faults.
+     */
+    void schedule_raw(uint64_t u64_at_us, const std::vector<uint8_t> &data);
+
+    /**
+     * @brief Answers every next u16_cmd_code with u8_rc and no payload, until clear_rc().
+     */
+    void set_rc(uint16_t u16_cmd_code, uint8_t u8_rc) { _rc_overrides[u16_cmd_code] = u8_rc; }
+    void clear_rc(uint16_t u16_cmd_code) { _rc_overrides.erase(u16_cmd_code); }
+
+    /**
+     * @brief Leaves the next u32_count commands u16_cmd_code without a response.
+     */
+    void drop_responses(uint16_t u16_cmd_code, uint32_t u32_count) { _drops[u16_cmd_code] += u32_count; }
+
+    void on_command(uint16_t u16_cmd_code, command_fn handler) { _handlers[u16_cmd_code] = handler; }
+
+    /**
+     * @brief Sends ymodem block u32_block with a bad crc the next u32_count times.
+     */
+    void corrupt_ymodem_block(uint32_t u32_block, uint32_t u32_count) { _ymodem_corrupt[u32_block] += u32_count; }
+
+    const std::vector<mcm_emu_command_t> &get_commands() const { return _commands; }
+    uint32_t get_command_count(uint16_t u16_cmd_code) const;
+    const std::vector<mcm_emu_uplink_t> &get_uplinks() const { return _uplinks; }
+    void clear_log() { _commands.clear(); _uplinks.clear(); }
+    mcm_emu_stats_t get_stats() const { return _stats; }
+    size_t get_pending_events() const { return _events.size(); }
+    bool is_joined() const { return _is_joined; }
+    bool is_in_reset() const { return _is_in_reset; }
+    uint64_t get_origin_us() const { return _u64_origin_us; }
+
+    private:
+    typedef struct
+    {
+        uint8_t u8_code;
+        uint8_t u8_cmd_type;
+        std::vector<uint8_t> data;
+    } event_t;
+
+    typedef enum
+    {
+        YMODEM_SEND_IDLE,
+        YMODEM_SEND_WAIT_C,                         // for the header block
+        YMODEM_SEND_WAIT_HEADER_ACK,
+        YMODEM_SEND_WAIT_DATA_C,                    // the receiver asks again with 'C' once the header is taken
+        YMODEM_SEND_WAIT_ACK,
+        YMODEM_SEND_WAIT_EOT_ACK
+    } ymodem_send_state_t;
+
+    void schedule(uint64_t u64_at_us, std::function<void(uint64_t)> action);
+    void transmit(const std::vector<uint8_t> &data);
+    void receive_frame(uint64_t u64_now_us);
+    void handle_command(const mcm_emu_command_t &command, uint64_t u64_now_us);
+    uint8_t answer_command(const mcm_emu_command_t &command, uint8_t &u8_response_type, std::vector<uint8_t> &payload, uint64_t u64_now_us);
+    void send_response(uint8_t u8_rc, uint8_t u8_cmd_type, uint16_t u16_cmd_code, const std::vector<uint8_t> &payload);
+    void push_event(const event_t &event);
+    void send_notification();
+    void reset_state();
+    bool is_ble_connected(uint64_t u64_now_us);
+    void ymodem_receive(uint8_t u8_byte);
+    void ymodem_send_block(uint32_t u32_block);
+    bool is_ymodem_byte(uint8_t u8_byte) const;
+    bool run_statement(const std::vector<std::string> &words, bool is_timed, uint64_t u64_now_us, std::string *p_error);
+
+    transmit_fn _transmit;
+    mcm_emu_config_t _config;
+    std::multimap<uint64_t, std::function<void(uint64_t)>> _actions;
+    uint64_t _u64_origin_us = 0;
+    bool _is_powered = false;
+    bool _is_in_reset = false;
+    uint32_t _u32_generation = 0;                   // bumped by a reset, older actions of the modem are void
+    uint32_t _u32_reset_count = 0;
+
+    // frame reception
+    std::vector<uint8_t> _frame;
+    uint64_t _u64_last_rx_us = 0;
+    uint64_t _u64_busy_until_us = 0;                // the modem answers one command at a time
+
+    // state of the modem
+    uint32_t _u32_baud_rate = MROVER_DEFAULT_BAUD_RATE;
+    uint32_t _u32_previous_baud_rate = MROVER_DEFAULT_BAUD_RATE;
+    bool _is_baud_verified = true;
+    std::vector<event_t> _events;
+    bool _is_notified = false;                      // a notification is out and no GET_EVENT came since
+    bool _is_joined = false;
+    bool _is_ble_link = false;                      // sidewalk joined over ble
+    uint64_t _u64_ble_up_us = UINT64_MAX;           // the ble connection is up from this time
+    uint64_t _u64_ble_traffic_us = 0;
+    uint8_t _u8_class = MROVER_LORAWAN_CLASS_A;
+    uint8_t _au8_dev_eui[LORAWAN_DEV_EUI_JOIN_EUI_LEN] = {};
+    uint8_t _au8_join_eui[LORAWAN_DEV_EUI_JOIN_EUI_LEN] = {};
+    uint8_t _au8_nw_key[LORAWAN_NETWORK_KEY_LEN] = {};
+    uint8_t _au8_last_dl_stats[7] = {};
+
+    // overrides and faults
+    std::map<uint16_t, uint8_t> _rc_overrides;
+    std::map<uint16_t, uint32_t> _drops;
+    std::map<uint16_t, command_fn> _handlers;
+    std::vector<uint8_t> _tx_statuses;              // consumed one per uplink before u8_tx_status
+
+    // ymodem sender
+    ymodem_send_state_t _ymodem_state = YMODEM_SEND_IDLE;
+    uint32_t _u32_ymodem_block = 0;
+    std::map<uint32_t, uint32_t> _ymodem_corrupt;
+
+    // timed statements of the script, scheduled on the first power on
+    std::vector<std::pair<uint64_t, std::vector<std::string>>> _timed;
+    bool _is_origin_set = false;
+
+    std::vector<mcm_emu_command_t> _commands;
+    std::vector<mcm_emu_uplink_t> _uplinks;
+    mcm_emu_stats_t _stats = {};
+};
+
+#endif // __MCM_EMULATOR_H__
@@ -0,0 +1,111 @@
+/**
+ * @file mcm_emulator_wire.cpp
+ * @author OXIT embedded firmware team
+ * @brief Plugs the emulated MCM into a uart of the host shim.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "mcm_emulator_wire.h"
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+McmEmulatorWire::McmEmulatorWire(McmEmulator &emulator, HardwareSerial &serial, uint8_t u8_reset_pin)
+    : _emulator(emulator), _serial(serial), _u8_reset_pin(u8_reset_pin)
+{
+}
+
+McmEmulatorWire::~McmEmulatorWire()
+{
+    detach();
+}
+
+void McmEmulatorWire::attach()
+{
+    if (_is_attached)
+    {
+        return;
+    }
+    _is_attached = true;
+    _emulator.set_transmit([this](const uint8_t *p_data, size_t len)
+                           { host_uart_peer_send(_serial, p_data, len, _emulator.get_baud_rate()); });
+    host_uart_attach_peer(_serial, this);
+    host_hal_add_device(this);
+    _emulator.power_on(host_hal_get_time_us());
+}
+
+void McmEmulatorWire::detach()
+{
+    if (!_is_attached)
+    {
+        return;
+    }
+    _is_attached = false;
+    host_hal_remove_device(this);
+    host_uart_attach_peer(_serial, NULL);
+    _emulator.set_transmit(nullptr);
+}
+
+uint64_t McmEmulatorWire::poll(uint64_t u64_now_us)
+{
+    uint64_t u64_next_us = _emulator.poll(u64_now_us);
+
+    return (MCM_EMU_NO_DEADLINE == u64_next_us) ? HOST_HAL_NO_DEADLINE : u64_next_us;
+}
+
+void McmEmulatorWire::on_pin_write(uint8_t u8_pin, uint8_t u8_value)
+{
+    if (u8_pin == _u8_reset_pin)
+    {
+        _emulator.set_reset_line(HIGH == u8_value, host_hal_get_time_us());
+    }
+}
+
+void McmEmulatorWire::on_uart_byte(uint8_t u8_byte, uint32_t u32_baud_rate, uint64_t u64_now_us)
+{
+    if (u32_baud_rate != _emulator.get_baud_rate())
+    {
+        // sampled at the wrong rate, what is received has nothing to do with what was sent
+        u8_byte = (uint8_t)((u8_byte * 0x9D) ^ 0x5A);
+        _u32_framing_errors++;
+    }
+    _emulator.receive(u8_byte, u64_now_us);
+}
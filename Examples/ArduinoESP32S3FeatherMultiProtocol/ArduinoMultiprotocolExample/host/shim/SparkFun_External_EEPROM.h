@@ -0,0 +1,98 @@
+/**
+ * @file SparkFun_External_EEPROM.h
+ * @author OXIT embedded firmware team
+ * @brief Host shim of the SparkFun external EEPROM library, the memory is kept in RAM.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+#ifndef __HOST_SPARKFUN_EXTERNAL_EEPROM_H__
+#define __HOST_SPARKFUN_EXTERNAL_EEPROM_H__
+
+// included from within extern "C" blocks by the library headers
+extern "C++" {
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include <Arduino.h>
+#include <vector>
+
+/**********************************************************************************************************
+ * TYPEDEFS AND CLASSES
+ **********************************************************************************************************/
+
+/**
+ * @brief Same return values as the library, 0 on success for the block read and write.
+ */
+class ExternalEEPROM
+{
+    public:
+    bool begin() { _memory.assign(_size, 0xFF); return true; }
+    void setMemoryType(uint16_t kbits) { _size = ((uint32_t)kbits * 1024) / 8; }
+    uint8_t read(uint32_t location) { return (location < _memory.size()) ? _memory[location] : 0xFF; }
+    int read(uint32_t location, uint8_t *buffer, uint16_t size)
+    {
+        if ((location + size) > _memory.size())
+        {
+            return -1;
+        }
+        memcpy(buffer, &_memory[location], size);
+        return 0;
+    }
+    int write(uint32_t location, uint8_t value) { return write(location, &value, 1); }
+    int write(uint32_t location, const uint8_t *data, uint16_t size)
+    {
+        if ((location + size) > _memory.size())
+        {
+            return -1;
+        }
+        memcpy(&_memory[location], data, size);
+        return 0;
+    }
+    template <typename T> T &get(uint32_t location, T &value) { read(location, (uint8_t *)&value, sizeof(T)); return value; }
+    template <typename T> const T &put(uint32_t location, const T &value) { write(location, (const uint8_t *)&value, sizeof(T)); return value; }
+    void erase(uint8_t value = 0x00) { _memory.assign(_size, value); }
+
+    private:
+    uint32_t _size = 0;
+    std::vector<uint8_t> _memory;
+};
+
+} // extern "C++"
+
+#endif // __HOST_SPARKFUN_EXTERNAL_EEPROM_H__
@@ -0,0 +1,99 @@
+/**
+ * @file WString.h
+ * @author OXIT embedded firmware team
+ * @brief Host shim of the Arduino String class.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+#ifndef __HOST_WSTRING_H__
+#define __HOST_WSTRING_H__
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include <stdint.h>
+#include <string>
+
+/**********************************************************************************************************
+ * TYPEDEFS AND CLASSES
+ **********************************************************************************************************/
+
+/**
+ * @brief Arduino String on top of std::string, only the members used by the sketch modules.
+ */
+class String
+{
+    public:
+    String(const char *str = "") : _str((NULL != str) ? str : "") {}
+    String(const std::string &str) : _str(str) {}
+    explicit String(char c) : _str(1, c) {}
+    explicit String(int value, unsigned char base = 10) : _str(to_base((long)value, base)) {}
+    explicit String(unsigned int value, unsigned char base = 10) : _str(to_base((unsigned long)value, base)) {}
+    explicit String(long value, unsigned char base = 10) : _str(to_base(value, base)) {}
+    explicit String(unsigned long value, unsigned char base = 10) : _str(to_base(value, base)) {}
+
+    const char *c_str() const { return _str.c_str(); }
+    unsigned int length() const { return (unsigned int)_str.length(); }
+    bool isEmpty() const { return _str.empty(); }
+    char charAt(unsigned int index) const { return (index < _str.length()) ? _str[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    bool equals(const String &other) const { return _str == other._str; }
+    bool operator==(const String &other) const { return _str == other._str; }
+    bool operator!=(const String &other) const { return _str != other._str; }
+    bool startsWith(const String &prefix) const { return 0 == _str.compare(0, prefix._str.length(), prefix._str); }
+    int indexOf(const String &str) const { size_t pos = _str.find(str._str); return (std::string::npos == pos) ? -1 : (int)pos; }
+    String substring(unsigned int from) const { return (from < _str.length()) ? String(_str.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const { return (from < to) ? String(_str.substr(from, to - from)) : String(); }
+    long toInt() const { return strtol(_str.c_str(), NULL, 10); }
+    void trim();
+    void toUpperCase();
+    void toLowerCase();
+
+    bool concat(const String &str) { _str += str._str; return true; }
+    String &operator+=(const String &str) { _str += str._str; return *this; }
+    String &operator+=(const char *str) { _str += str; return *this; }
+    String &operator+=(char c) { _str += c; return *this; }
+    friend String operator+(const String &lhs, const String &rhs) { return String(lhs._str + rhs._str); }
+
+    private:
+    static std::string to_base(long value, unsigned char base);
+    static std::string to_base(unsigned long value, unsigned char base);
+    std::string _str;
+};
+
+#endif // __HOST_WSTRING_H__
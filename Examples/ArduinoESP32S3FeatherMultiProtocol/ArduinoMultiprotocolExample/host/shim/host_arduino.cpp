@@ -0,0 +1,221 @@
+/**
+ * @file host_arduino.cpp
+ * @author OXIT embedded firmware team
+ * @brief Print, Stream, String and random() of the host shim.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <Arduino.h>
+#include <ctype.h>
+
+/******************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ ******************************************************************************/
+#define PRINTF_BUFFER_SIZE          512
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static uint32_t s_random_state = 1;
+
+/******************************************************************************
+ * PRINT
+ ******************************************************************************/
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+    size_t n = 0;
+
+    while ((n < size) && (1 == write(buffer[n])))
+    {
+        n++;
+    }
+    return n;
+}
+
+size_t Print::printf(const char *format, ...)
+{
+    char buffer[PRINTF_BUFFER_SIZE];
+    va_list args;
+
+    va_start(args, format);
+    int len = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (0 > len)
+    {
+        return 0;
+    }
+    return write((const uint8_t *)buffer, std::min((size_t)len, sizeof(buffer) - 1));
+}
+
+size_t Print::print(long value, int base)
+{
+    return print(String(value, (unsigned char)base));
+}
+
+size_t Print::print(unsigned long value, int base)
+{
+    return print(String(value, (unsigned char)base));
+}
+
+size_t Print::print(double value, int digits)
+{
+    char buffer[64];
+
+    snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+    return print(buffer);
+}
+
+/******************************************************************************
+ * STREAM
+ ******************************************************************************/
+int Stream::timedRead()
+{
+    unsigned long start = millis();
+
+    do
+    {
+        int c = read();
+        if (0 <= c)
+        {
+            return c;
+        }
+        delay(1);
+    } while ((millis() - start) < _timeout_ms);
+    return -1;
+}
+
+size_t Stream::readBytes(uint8_t *buffer, size_t length)
+{
+    size_t count = 0;
+
+    while (count < length)
+    {
+        int c = timedRead();
+        if (0 > c)
+        {
+            break;
+        }
+        buffer[count++] = (uint8_t)c;
+    }
+    return count;
+}
+
+/******************************************************************************
+ * STRING
+ ******************************************************************************/
+std::string String::to_base(long value, unsigned char base)
+{
+    if ((10 == base) && (0 > value))
+    {
+        return "-" + to_base((unsigned long)(-value), base);
+    }
+    return to_base((unsigned long)value, base);
+}
+
+std::string String::to_base(unsigned long value, unsigned char base)
+{
+    static const char digits[] = "0123456789ABCDEF";
+    std::string str;
+
+    if ((2 > base) || (16 < base))
+    {
+        base = 10;
+    }
+    do
+    {
+        str.insert(str.begin(), digits[value % base]);
+        value /= base;
+    } while (0 != value);
+    return str;
+}
+
+void String::trim()
+{
+    size_t begin = _str.find_first_not_of(" \t\r\n");
+    size_t end = _str.find_last_not_of(" \t\r\n");
+    _str = (std::string::npos == begin) ? std::string() : _str.substr(begin, end - begin + 1);
+}
+
+void String::toUpperCase()
+{
+    for (char &c : _str)
+    {
+        c = (char)toupper((unsigned char)c);
+    }
+}
+
+void String::toLowerCase()
+{
+    for (char &c : _str)
+    {
+        c = (char)tolower((unsigned char)c);
+    }
+}
+
+/******************************************************************************
+ * RANDOM
+ ******************************************************************************/
+void randomSeed(unsigned long seed)
+{
+    s_random_state = (0 != seed) ? (uint32_t)seed : 1;
+}
+
+long random(long max_val)
+{
+    if (0 >= max_val)
+    {
+        return 0;
+    }
+    // xorshift32, reproducible across runs of a test
+    s_random_state ^= s_random_state << 13;
+    s_random_state ^= s_random_state >> 17;
+    s_random_state ^= s_random_state << 5;
+    return (long)(s_random_state % (uint32_t)max_val);
+}
+
+long random(long min_val, long max_val)
+{
+    if (min_val >= max_val)
+    {
+        return min_val;
+    }
+    return min_val + random(max_val - min_val);
+}
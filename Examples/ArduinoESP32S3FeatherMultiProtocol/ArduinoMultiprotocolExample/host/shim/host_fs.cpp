@@ -0,0 +1,382 @@
+/**
+ * @file host_fs.cpp
+ * @author OXIT embedded firmware team
+ * @brief File system shim on top of a directory of the host.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "host_fs.h"
+#include <string>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/******************************************************************************
+ * PRIVATE TYPEDEFS
+ ******************************************************************************/
+namespace fs
+{
+
+struct FileImpl
+{
+    FILE *p_file;
+    std::string path;                               // path on the target
+    bool is_append;
+};
+
+} // namespace fs
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static std::string s_root;
+static size_t s_capacity = HOST_FS_DEFAULT_CAPACITY;
+static host_fs_stats_t s_stats;
+
+/******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+fs::SPIFFSFS SPIFFS;
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static std::string host_path(const char *p_path)
+{
+    std::string path = host_fs_get_root();
+
+    if ('/' != p_path[0])
+    {
+        path += '/';
+    }
+    return path + p_path;
+}
+
+static size_t used_bytes()
+{
+    size_t used = 0;
+    DIR *p_dir = opendir(host_fs_get_root());
+    struct dirent *p_entry;
+
+    while ((NULL != p_dir) && (NULL != (p_entry = readdir(p_dir))))
+    {
+        struct stat st;
+        std::string path = std::string(host_fs_get_root()) + "/" + p_entry->d_name;
+        if ((0 == stat(path.c_str(), &st)) && S_ISREG(st.st_mode))
+        {
+            used += (size_t)st.st_size;
+        }
+    }
+    if (NULL != p_dir)
+    {
+        closedir(p_dir);
+    }
+    return used;
+}
+
+static long file_size(FILE *p_file)
+{
+    long pos = ftell(p_file);
+    fseek(p_file, 0, SEEK_END);
+    long size = ftell(p_file);
+    fseek(p_file, pos, SEEK_SET);
+    return size;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+void host_fs_set_root(const char *p_path)
+{
+    s_root = p_path;
+    mkdir(p_path, 0755);
+}
+
+const char *host_fs_get_root()
+{
+    if (s_root.empty())
+    {
+        const char *p_env = getenv("HOST_FS_ROOT");
+        if (NULL != p_env)
+        {
+            host_fs_set_root(p_env);
+        }
+        else
+        {
+            char path[] = "/tmp/mcm_host_fs.XXXXXX";
+            s_root = (NULL != mkdtemp(path)) ? path : "/tmp";
+        }
+    }
+    return s_root.c_str();
+}
+
+void host_fs_format()
+{
+    DIR *p_dir = opendir(host_fs_get_root());
+    struct dirent *p_entry;
+
+    while ((NULL != p_dir) && (NULL != (p_entry = readdir(p_dir))))
+    {
+        if ('.' != p_entry->d_name[0])
+        {
+            unlink((std::string(host_fs_get_root()) + "/" + p_entry->d_name).c_str());
+        }
+    }
+    if (NULL != p_dir)
+    {
+        closedir(p_dir);
+    }
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+void host_fs_set_capacity(size_t capacity)
+{
+    s_capacity = capacity;
+}
+
+host_fs_stats_t host_fs_get_stats()
+{
+    return s_stats;
+}
+
+/******************************************************************************
+ * FILE
+ ******************************************************************************/
+namespace fs
+{
+
+size_t File::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t File::write(const uint8_t *buffer, size_t size)
+{
+    if (!*this)
+    {
+        return 0;
+    }
+    long size_now = file_size(_p_impl->p_file);
+    long end = _p_impl->is_append ? (size_now + (long)size) : (ftell(_p_impl->p_file) + (long)size);
+    if (end > size_now)
+    {
+        size_t used = used_bytes();
+        size_t room = (s_capacity > used) ? (s_capacity - used) : 0;
+        if ((size_t)(end - size_now) > room)
+        {
+            s_stats.u32_failed_writes++;
+            size -= std::min(size, (size_t)(end - size_now) - room);
+        }
+    }
+    size_t written = fwrite(buffer, 1, size, _p_impl->p_file);
+    s_stats.u64_bytes_written += written;
+    return written;
+}
+
+int File::available()
+{
+    if (!*this)
+    {
+        return 0;
+    }
+    return (int)(size() - position());
+}
+
+int File::read()
+{
+    uint8_t c;
+    return (1 == read(&c, 1)) ? c : -1;
+}
+
+int File::peek()
+{
+    if (!*this)
+    {
+        return -1;
+    }
+    int c = fgetc(_p_impl->p_file);
+    if (EOF != c)
+    {
+        ungetc(c, _p_impl->p_file);
+    }
+    return (EOF == c) ? -1 : c;
+}
+
+size_t File::read(uint8_t *buffer, size_t size)
+{
+    if (!*this)
+    {
+        return 0;
+    }
+    size_t len = fread(buffer, 1, size, _p_impl->p_file);
+    s_stats.u64_bytes_read += len;
+    return len;
+}
+
+void File::flush()
+{
+    if (*this)
+    {
+        fflush(_p_impl->p_file);
+    }
+}
+
+bool File::seek(uint32_t pos, SeekMode mode)
+{
+    static const int whence[] = { SEEK_SET, SEEK_CUR, SEEK_END };
+
+    if (!*this)
+    {
+        return false;
+    }
+    if ((SeekSet == mode) && ((long)pos > file_size(_p_impl->p_file)))
+    {
+        return false;
+    }
+    return 0 == fseek(_p_impl->p_file, (long)pos, whence[mode]);
+}
+
+size_t File::position() const
+{
+    return *this ? (size_t)ftell(_p_impl->p_file) : 0;
+}
+
+size_t File::size() const
+{
+    return *this ? (size_t)file_size(_p_impl->p_file) : 0;
+}
+
+void File::close()
+{
+    if (*this)
+    {
+        fclose(_p_impl->p_file);
+        _p_impl->p_file = NULL;
+    }
+    _p_impl.reset();
+}
+
+File::operator bool() const
+{
+    return (nullptr != _p_impl) && (NULL != _p_impl->p_file);
+}
+
+const char *File::name() const
+{
+    if (!_p_impl)
+    {
+        return "";
+    }
+    size_t pos = _p_impl->path.rfind('/');
+    return _p_impl->path.c_str() + ((std::string::npos == pos) ? 0 : (pos + 1));
+}
+
+const char *File::path() const
+{
+    return _p_impl ? _p_impl->path.c_str() : "";
+}
+
+/******************************************************************************
+ * FS
+ ******************************************************************************/
+File FS::open(const char *path, const char *mode, const bool create)
+{
+    (void)create;
+    std::string file_path = host_path(path);
+    std::string host_mode = std::string(mode) + "b";
+    FILE *p_file = fopen(file_path.c_str(), host_mode.c_str());
+
+    if (NULL == p_file)
+    {
+        return File();
+    }
+    s_stats.u32_opens++;
+    std::shared_ptr<FileImpl> p_impl = std::make_shared<FileImpl>();
+    p_impl->p_file = p_file;
+    p_impl->path = path;
+    p_impl->is_append = ('a' == mode[0]);
+    return File(p_impl);
+}
+
+bool FS::exists(const char *path)
+{
+    return 0 == access(host_path(path).c_str(), F_OK);
+}
+
+bool FS::remove(const char *path)
+{
+    return 0 == unlink(host_path(path).c_str());
+}
+
+bool FS::rename(const char *path_from, const char *path_to)
+{
+    return 0 == ::rename(host_path(path_from).c_str(), host_path(path_to).c_str());
+}
+
+/******************************************************************************
+ * SPIFFS
+ ******************************************************************************/
+bool SPIFFSFS::begin(bool format_on_fail, const char *base_path, uint8_t max_open_files, const char *partition_label)
+{
+    (void)format_on_fail;
+    (void)base_path;
+    (void)max_open_files;
+    (void)partition_label;
+    return NULL != host_fs_get_root();
+}
+
+bool SPIFFSFS::format()
+{
+    host_fs_format();
+    return true;
+}
+
+size_t SPIFFSFS::totalBytes()
+{
+    return s_capacity;
+}
+
+size_t SPIFFSFS::usedBytes()
+{
+    return used_bytes();
+}
+
+} // namespace fs
@@ -0,0 +1,756 @@
+/**
+ * @file host_hal.cpp
+ * @author OXIT embedded firmware team
+ * @brief Virtual time, emulated uart wires, ttys and pins of the host shim.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "host_hal.h"
+#include <deque>
+#include <vector>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/******************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ ******************************************************************************/
+#define UART_BITS_PER_BYTE          10
+#define UART_HW_FIFO_SIZE           128
+#define UART_DEFAULT_RX_BUFFER      256
+#define UART_DEFAULT_RX_TIMEOUT     2
+#define UART_DEFAULT_FIFO_FULL      120
+#define UART_COUNT                  3
+
+// a tty delivers in chunks, the receive timeout is never shorter than that
+#define TTY_MIN_RX_TIMEOUT_US       1000
+
+// a device asking to run again at the same time this often is stuck
+#define MAX_POLLS_SAME_TIME         1000
+
+/******************************************************************************
+ * PRIVATE TYPEDEFS
+ ******************************************************************************/
+typedef struct
+{
+    uint64_t u64_time_us;                           // end of the stop bit
+    uint8_t u8_byte;
+    uint32_t u32_baud_rate;                         // rate of the sender
+} wire_byte_t;
+
+struct host_uart
+{
+    HardwareSerial *p_serial;
+    uint32_t u32_baud_rate;
+    bool is_begun;
+    size_t rx_buffer_size;
+    size_t tx_buffer_size;
+    uint8_t u8_rx_timeout_symbols;
+    uint8_t u8_fifo_full;
+    OnReceiveCb rx_cb;
+    bool is_only_on_timeout;
+
+    // host to peer
+    std::deque<wire_byte_t> tx_wire;
+    uint64_t u64_tx_free_us;
+    // peer to host
+    std::deque<wire_byte_t> rx_wire;
+    uint64_t u64_rx_free_us;
+    std::deque<uint8_t> rx_buffer;
+    uint64_t u64_last_rx_us;
+    uint32_t u32_rx_since_cb;                       // bytes received since the last callback
+
+    HostUartPeer *p_peer;
+    int fd;
+    size_t tx_fail_after;                           // bytes accepted before the writes fail
+    host_uart_stats_t stats;
+};
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static bool s_is_real_time = false;
+static uint64_t s_now_us = 0;
+static uint64_t s_real_start_us = 0;
+static int s_service_depth = 0;
+static std::vector<HostDevice *> s_devices;
+static FILE *s_p_console = (NULL != getenv("HOST_VERBOSE")) ? stdout : NULL;
+static std::function<void(void)> s_restart_hook;
+static uint32_t s_restart_count = 0;
+static uint8_t s_pins[256];
+static host_uart s_uarts[UART_COUNT];
+
+/******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+HardwareSerial Serial(0);
+HardwareSerial Serial1(1);
+HardwareSerial Serial2(2);
+EspClass ESP;
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static uint64_t monotonic_us()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000ULL) + ((uint64_t)ts.tv_nsec / 1000ULL);
+}
+
+static uint64_t now_us()
+{
+    return s_is_real_time ? (monotonic_us() - s_real_start_us) : s_now_us;
+}
+
+/**
+ * @brief Time on the wire of bytes_count bytes at baud_rate.
+ */
+static uint64_t wire_time_us(uint32_t u32_bytes_count, uint32_t u32_baud_rate)
+{
+    return ((uint64_t)u32_bytes_count * UART_BITS_PER_BYTE * 1000000ULL) / ((0 != u32_baud_rate) ? u32_baud_rate : 9600);
+}
+
+static void uart_init(host_uart *p_uart, HardwareSerial *p_serial)
+{
+    if ((NULL != p_uart->p_serial) && (0 <= p_uart->fd))
+    {
+        close(p_uart->fd);
+    }
+    p_uart->p_serial = p_serial;
+    p_uart->u32_baud_rate = 0;
+    p_uart->is_begun = false;
+    p_uart->rx_buffer_size = UART_DEFAULT_RX_BUFFER;
+    p_uart->tx_buffer_size = 0;
+    p_uart->u8_rx_timeout_symbols = UART_DEFAULT_RX_TIMEOUT;
+    p_uart->u8_fifo_full = UART_DEFAULT_FIFO_FULL;
+    p_uart->rx_cb = nullptr;
+    p_uart->is_only_on_timeout = false;
+    p_uart->tx_wire.clear();
+    p_uart->u64_tx_free_us = 0;
+    p_uart->rx_wire.clear();
+    p_uart->u64_rx_free_us = 0;
+    p_uart->rx_buffer.clear();
+    p_uart->u64_last_rx_us = 0;
+    p_uart->u32_rx_since_cb = 0;
+    p_uart->p_peer = NULL;
+    p_uart->fd = -1;
+    p_uart->tx_fail_after = SIZE_MAX;
+    memset(&p_uart->stats, 0, sizeof(p_uart->stats));
+}
+
+static void uart_receive_byte(host_uart *p_uart, uint8_t u8_byte, uint64_t u64_time_us)
+{
+    if (p_uart->rx_buffer.size() >= p_uart->rx_buffer_size)
+    {
+        p_uart->stats.u32_rx_overruns++;
+    }
+    else
+    {
+        p_uart->rx_buffer.push_back(u8_byte);
+        p_uart->stats.u32_rx_bytes++;
+    }
+    p_uart->u64_last_rx_us = u64_time_us;
+    p_uart->u32_rx_since_cb++;
+}
+
+/**
+ * @brief Reads what the tty has, without waiting.
+ */
+static void uart_read_tty(host_uart *p_uart)
+{
+    uint8_t buffer[256];
+    ssize_t len;
+
+    while ((0 <= p_uart->fd) && (0 < (len = read(p_uart->fd, buffer, sizeof(buffer)))))
+    {
+        uint64_t u64_time_us = now_us();
+        for (ssize_t i = 0; i < len; i++)
+        {
+            uart_receive_byte(p_uart, buffer[i], u64_time_us);
+        }
+    }
+}
+
+/**
+ * @brief Calls the receive callback as the ESP32 driver does, once the line is idle or the fifo is full.
+ * @return time the callback is due, HOST_HAL_NO_DEADLINE if there is nothing to report
+ */
+static uint64_t uart_service_callback(host_uart *p_uart, uint64_t u64_now_us)
+{
+    if ((0 == p_uart->u32_rx_since_cb) || !p_uart->rx_cb)
+    {
+        return HOST_HAL_NO_DEADLINE;
+    }
+
+    uint64_t u64_timeout_us = wire_time_us(p_uart->u8_rx_timeout_symbols, p_uart->u32_baud_rate);
+    if ((0 <= p_uart->fd) && (TTY_MIN_RX_TIMEOUT_US > u64_timeout_us))
+    {
+        u64_timeout_us = TTY_MIN_RX_TIMEOUT_US;
+    }
+    uint64_t u64_due_us = p_uart->u64_last_rx_us + u64_timeout_us;
+    bool is_fifo_full = !p_uart->is_only_on_timeout && (p_uart->u32_rx_since_cb >= p_uart->u8_fifo_full);
+
+    if ((u64_now_us < u64_due_us) && !is_fifo_full)
+    {
+        return u64_due_us;
+    }
+    p_uart->u32_rx_since_cb = 0;
+    p_uart->stats.u32_rx_callbacks++;
+    p_uart->rx_cb();
+    return HOST_HAL_NO_DEADLINE;
+}
+
+/**
+ * @brief Runs everything due at the current time.
+ * @return time of the next thing to run
+ */
+static uint64_t service()
+{
+    uint64_t u64_now_us = now_us();
+    uint64_t u64_next_us = HOST_HAL_NO_DEADLINE;
+
+    s_service_depth++;
+    for (host_uart &uart : s_uarts)
+    {
+        while (!uart.tx_wire.empty() && (uart.tx_wire.front().u64_time_us <= u64_now_us))
+        {
+            wire_byte_t byte = uart.tx_wire.front();
+            uart.tx_wire.pop_front();
+            if (NULL != uart.p_peer)
+            {
+                uart.p_peer->on_uart_byte(byte.u8_byte, byte.u32_baud_rate, byte.u64_time_us);
+            }
+        }
+        while (!uart.rx_wire.empty() && (uart.rx_wire.front().u64_time_us <= u64_now_us))
+        {
+            wire_byte_t byte = uart.rx_wire.front();
+            uart.rx_wire.pop_front();
+            if (byte.u32_baud_rate != uart.u32_baud_rate)
+            {
+                // sampled at the wrong rate, what is received has nothing to do with what was sent
+                byte.u8_byte = (uint8_t)((byte.u8_byte * 0x9D) ^ 0x5A);
+                uart.stats.u32_rx_framing_errors++;
+            }
+            if (uart.is_begun)
+            {
+                uart_receive_byte(&uart, byte.u8_byte, byte.u64_time_us);
+            }
+        }
+        uart_read_tty(&uart);
+        u64_next_us = std::min(u64_next_us, uart_service_callback(&uart, u64_now_us));
+    }
+    for (size_t i = 0; i < s_devices.size(); i++)
+    {
+        u64_next_us = std::min(u64_next_us, s_devices[i]->poll(u64_now_us));
+    }
+    for (host_uart &uart : s_uarts)
+    {
+        if (!uart.tx_wire.empty())
+        {
+            u64_next_us = std::min(u64_next_us, uart.tx_wire.front().u64_time_us);
+        }
+        if (!uart.rx_wire.empty())
+        {
+            u64_next_us = std::min(u64_next_us, uart.rx_wire.front().u64_time_us);
+        }
+    }
+    s_service_depth--;
+
+    return u64_next_us;
+}
+
+/**
+ * @brief Waits for the ttys until time_us at the latest.
+ */
+static void wait_real_time(uint64_t u64_time_us)
+{
+    struct pollfd fds[UART_COUNT];
+    nfds_t count = 0;
+    uint64_t u64_now_us = now_us();
+
+    for (host_uart &uart : s_uarts)
+    {
+        if (0 <= uart.fd)
+        {
+            fds[count].fd = uart.fd;
+            fds[count].events = POLLIN;
+            count++;
+        }
+    }
+    if (u64_time_us > u64_now_us)
+    {
+        uint64_t u64_wait_ms = (u64_time_us - u64_now_us + 999) / 1000;
+        (void)poll(fds, count, (int)std::min<uint64_t>(u64_wait_ms, 100));
+    }
+}
+
+static host_uart *get_uart(HardwareSerial &serial)
+{
+    return serial.get_host_uart();
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+void host_hal_reset()
+{
+    s_now_us = 0;
+    s_real_start_us = monotonic_us();
+    s_devices.clear();
+    s_restart_hook = nullptr;
+    s_restart_count = 0;
+    memset(s_pins, 0, sizeof(s_pins));
+    for (host_uart &uart : s_uarts)
+    {
+        uart_init(&uart, uart.p_serial);
+    }
+}
+
+void host_hal_set_real_time(bool is_real_time)
+{
+    s_is_real_time = is_real_time;
+    s_real_start_us = monotonic_us() - s_now_us;
+}
+
+bool host_hal_is_real_time()
+{
+    return s_is_real_time;
+}
+
+uint64_t host_hal_get_time_us()
+{
+    return now_us();
+}
+
+void host_hal_run_until(uint64_t u64_time_us)
+{
+    uint32_t u32_same_time_polls = 0;
+
+    // the callbacks and devices run in their own context on the target, time does not move within them
+    if (0 < s_service_depth)
+    {
+        return;
+    }
+    for (;;)
+    {
+        uint64_t u64_next_us = service();
+        uint64_t u64_now_us = now_us();
+        if (u64_now_us >= u64_time_us)
+        {
+            break;
+        }
+        if (s_is_real_time)
+        {
+            wait_real_time(std::min(u64_next_us, u64_time_us));
+            continue;
+        }
+        if (u64_next_us <= u64_now_us)
+        {
+            if (MAX_POLLS_SAME_TIME > ++u32_same_time_polls)
+            {
+                continue;
+            }
+            u64_next_us = u64_now_us + 1;
+        }
+        u32_same_time_polls = 0;
+        s_now_us = std::min(u64_next_us, u64_time_us);
+    }
+}
+
+void host_hal_add_device(HostDevice *p_device)
+{
+    s_devices.push_back(p_device);
+}
+
+void host_hal_remove_device(HostDevice *p_device)
+{
+    for (size_t i = 0; i < s_devices.size(); i++)
+    {
+        if (s_devices[i] == p_device)
+        {
+            s_devices.erase(s_devices.begin() + i);
+            break;
+        }
+    }
+}
+
+void host_hal_set_console(FILE *p_file)
+{
+    s_p_console = p_file;
+}
+
+void host_hal_on_restart(std::function<void(void)> hook)
+{
+    s_restart_hook = hook;
+}
+
+uint32_t host_hal_get_restart_count()
+{
+    return s_restart_count;
+}
+
+void host_uart_attach_peer(HardwareSerial &serial, HostUartPeer *p_peer)
+{
+    get_uart(serial)->p_peer = p_peer;
+}
+
+void host_uart_peer_send(HardwareSerial &serial, const uint8_t *p_data, size_t len, uint32_t u32_baud_rate)
+{
+    host_uart *p_uart = get_uart(serial);
+    uint64_t u64_start_us = std::max(now_us(), p_uart->u64_rx_free_us);
+
+    for (size_t i = 0; i < len; i++)
+    {
+        wire_byte_t byte = { u64_start_us + wire_time_us((uint32_t)(i + 1), u32_baud_rate), p_data[i], u32_baud_rate };
+        p_uart->rx_wire.push_back(byte);
+    }
+    p_uart->u64_rx_free_us = u64_start_us + wire_time_us((uint32_t)len, u32_baud_rate);
+}
+
+bool host_uart_peer_is_sending(HardwareSerial &serial)
+{
+    return !get_uart(serial)->rx_wire.empty();
+}
+
+bool host_uart_open_tty(HardwareSerial &serial, const char *p_path)
+{
+    host_uart *p_uart = get_uart(serial);
+    struct termios tio;
+    int fd = open(p_path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+
+    if (0 > fd)
+    {
+        return false;
+    }
+    if (0 == tcgetattr(fd, &tio))
+    {
+        cfmakeraw(&tio);
+        (void)tcsetattr(fd, TCSANOW, &tio);
+    }
+    if (0 <= p_uart->fd)
+    {
+        close(p_uart->fd);
+    }
+    p_uart->fd = fd;
+    return true;
+}
+
+void host_uart_fail_write_after(HardwareSerial &serial, size_t bytes)
+{
+    get_uart(serial)->tx_fail_after = bytes;
+}
+
+host_uart_stats_t host_uart_get_stats(HardwareSerial &serial)
+{
+    return get_uart(serial)->stats;
+}
+
+/******************************************************************************
+ * ARDUINO CORE
+ ******************************************************************************/
+unsigned long millis(void)
+{
+    return (unsigned long)(micros() / 1000UL);
+}
+
+unsigned long micros(void)
+{
+    // a polling loop services the uarts and the devices as the interrupts would
+    if (0 == s_service_depth)
+    {
+        host_hal_run_until(s_is_real_time ? now_us() : (s_now_us + HOST_HAL_CALL_COST_US));
+    }
+    return (unsigned long)now_us();
+}
+
+void delay(uint32_t ms)
+{
+    host_hal_run_until(now_us() + ((uint64_t)ms * 1000ULL));
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    host_hal_run_until(now_us() + us);
+}
+
+void yield(void)
+{
+    host_hal_run_until(now_us());
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    s_pins[pin] = val;
+    for (size_t i = 0; i < s_devices.size(); i++)
+    {
+        s_devices[i]->on_pin_write(pin, val);
+    }
+}
+
+int digitalRead(uint8_t pin)
+{
+    return s_pins[pin];
+}
+
+void EspClass::restart()
+{
+    s_restart_count++;
+    if (s_restart_hook)
+    {
+        s_restart_hook();
+    }
+}
+
+/******************************************************************************
+ * HARDWARE SERIAL
+ ******************************************************************************/
+HardwareSerial::HardwareSerial(int uart_nr) : _uart_nr(uart_nr), _p_uart(&s_uarts[uart_nr % UART_COUNT])
+{
+    _p_uart->fd = -1;
+    uart_init(_p_uart, this);
+}
+
+HardwareSerial::~HardwareSerial()
+{
+    if (0 <= _p_uart->fd)
+    {
+        close(_p_uart->fd);
+        _p_uart->fd = -1;
+    }
+}
+
+void HardwareSerial::begin(unsigned long baud, uint32_t config, int8_t rx_pin, int8_t tx_pin,
+                           bool invert, unsigned long timeout_ms, uint8_t rxfifo_full_thrhd)
+{
+    (void)config;
+    (void)rx_pin;
+    (void)tx_pin;
+    (void)invert;
+    (void)timeout_ms;
+    _p_uart->u32_baud_rate = (uint32_t)baud;
+    _p_uart->u8_fifo_full = rxfifo_full_thrhd;
+    _p_uart->is_begun = true;
+}
+
+void HardwareSerial::end()
+{
+    _p_uart->is_begun = false;
+    _p_uart->rx_buffer.clear();
+}
+
+void HardwareSerial::updateBaudRate(unsigned long baud)
+{
+    _p_uart->u32_baud_rate = (uint32_t)baud;
+}
+
+uint32_t HardwareSerial::baudRate()
+{
+    return _p_uart->u32_baud_rate;
+}
+
+size_t HardwareSerial::setRxBufferSize(size_t size)
+{
+    _p_uart->rx_buffer_size = size;
+    return size;
+}
+
+size_t HardwareSerial::setTxBufferSize(size_t size)
+{
+    _p_uart->tx_buffer_size = size;
+    return size;
+}
+
+bool HardwareSerial::setRxTimeout(uint8_t symbols_timeout)
+{
+    _p_uart->u8_rx_timeout_symbols = symbols_timeout;
+    return true;
+}
+
+bool HardwareSerial::setRxFIFOFull(uint8_t fifo_bytes)
+{
+    _p_uart->u8_fifo_full = fifo_bytes;
+    return true;
+}
+
+void HardwareSerial::onReceive(OnReceiveCb function, bool only_on_timeout)
+{
+    _p_uart->rx_cb = function;
+    _p_uart->is_only_on_timeout = only_on_timeout;
+}
+
+int HardwareSerial::available()
+{
+    uart_read_tty(_p_uart);
+    return (int)_p_uart->rx_buffer.size();
+}
+
+int HardwareSerial::peek()
+{
+    uart_read_tty(_p_uart);
+    return _p_uart->rx_buffer.empty() ? -1 : _p_uart->rx_buffer.front();
+}
+
+int HardwareSerial::read()
+{
+    uint8_t u8_byte;
+    return (1 == read(&u8_byte, 1)) ? u8_byte : -1;
+}
+
+size_t HardwareSerial::read(uint8_t *buffer, size_t size)
+{
+    size_t len = 0;
+
+    uart_read_tty(_p_uart);
+    while ((len < size) && !_p_uart->rx_buffer.empty())
+    {
+        buffer[len++] = _p_uart->rx_buffer.front();
+        _p_uart->rx_buffer.pop_front();
+    }
+    return len;
+}
+
+size_t HardwareSerial::readBytes(uint8_t *buffer, size_t length)
+{
+    size_t len = read(buffer, length);
+
+    return (len == length) ? len : (len + Stream::readBytes(buffer + len, length - len));
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size)
+{
+    if (0 == _uart_nr)
+    {
+        if (NULL != s_p_console)
+        {
+            fwrite(buffer, 1, size, s_p_console);
+        }
+        return size;
+    }
+
+    if (size > _p_uart->tx_fail_after)
+    {
+        // a short write, as a driver that gives up on a full tx buffer
+        size = _p_uart->tx_fail_after;
+    }
+    _p_uart->tx_fail_after -= (SIZE_MAX == _p_uart->tx_fail_after) ? 0 : size;
+    _p_uart->stats.u32_tx_bytes += (uint32_t)size;
+    if (0 <= _p_uart->fd)
+    {
+        size_t written = 0;
+        while (written < size)
+        {
+            ssize_t len = ::write(_p_uart->fd, buffer + written, size - written);
+            if (0 < len)
+            {
+                written += (size_t)len;
+            }
+            else if ((EAGAIN == errno) || (EINTR == errno))
+            {
+                struct pollfd pfd = { _p_uart->fd, POLLOUT, 0 };
+                (void)poll(&pfd, 1, 10);
+            }
+            else
+            {
+                break;
+            }
+        }
+        return written;
+    }
+
+    // the write blocks while the tx buffer and the hardware fifo are full
+    while ((_p_uart->tx_wire.size() + size) > (_p_uart->tx_buffer_size + UART_HW_FIFO_SIZE) && !_p_uart->tx_wire.empty() &&
+           (0 == s_service_depth))
+    {
+        host_hal_run_until(_p_uart->tx_wire.front().u64_time_us);
+    }
+    uint64_t u64_start_us = std::max(now_us(), _p_uart->u64_tx_free_us);
+    for (size_t i = 0; i < size; i++)
+    {
+        wire_byte_t byte = { u64_start_us + wire_time_us((uint32_t)(i + 1), _p_uart->u32_baud_rate), buffer[i], _p_uart->u32_baud_rate };
+        _p_uart->tx_wire.push_back(byte);
+    }
+    _p_uart->u64_tx_free_us = u64_start_us + wire_time_us((uint32_t)size, _p_uart->u32_baud_rate);
+    return size;
+}
+
+void HardwareSerial::flush()
+{
+    flush(true);
+}
+
+void HardwareSerial::flush(bool tx_only)
+{
+    if (0 == _uart_nr)
+    {
+        if (NULL != s_p_console)
+        {
+            fflush(s_p_console);
+        }
+        return;
+    }
+    if (0 <= _p_uart->fd)
+    {
+        (void)tcdrain(_p_uart->fd);
+    }
+    else if (!_p_uart->tx_wire.empty())
+    {
+        host_hal_run_until(_p_uart->u64_tx_free_us);
+    }
+    if (!tx_only)
+    {
+        _p_uart->rx_buffer.clear();
+    }
+}
@@ -0,0 +1,198 @@
+/**
+ * @file host_hal.h
+ * @author OXIT embedded firmware team
+ * @brief Control of the host shim: virtual time, emulated uart wires, ttys and pins.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+#ifndef __HOST_HAL_H__
+#define __HOST_HAL_H__
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include <Arduino.h>
+#include <stdio.h>
+#include <functional>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+
+/**
+ * @brief No deadline, returned by a device with nothing scheduled.
+ */
+#define HOST_HAL_NO_DEADLINE        UINT64_MAX
+
+/**
+ * @brief Virtual time spent by every call of millis() and micros(), a polling loop
+ * without delay() still moves the time forward as it does on the target.
+ */
+#define HOST_HAL_CALL_COST_US       1
+
+/**********************************************************************************************************
+ * TYPEDEFS AND CLASSES
+ **********************************************************************************************************/
+
+/**
+ * @brief Anything that runs along the virtual time, the emulated modems in particular.
+ */
+class HostDevice
+{
+    public:
+    virtual ~HostDevice() {}
+
+    /**
+     * @brief Runs what is due at now_us.
+     * @return time of the next thing to run, HOST_HAL_NO_DEADLINE if nothing is scheduled
+     */
+    virtual uint64_t poll(uint64_t now_us) = 0;
+
+    /**
+     * @brief Called for every digitalWrite(), the emulated modems watch their reset pin with it.
+     */
+    virtual void on_pin_write(uint8_t u8_pin, uint8_t u8_value)
+    {
+        (void)u8_pin;
+        (void)u8_value;
+    }
+};
+
+/**
+ * @brief Far end of an emulated uart wire.
+ */
+class HostUartPeer
+{
+    public:
+    virtual ~HostUartPeer() {}
+
+    /**
+     * @brief Called for every byte once its stop bit is received.
+     * u32_baud_rate is the rate the host sent it at, the byte is garbage for a peer at another rate.
+     */
+    virtual void on_uart_byte(uint8_t u8_byte, uint32_t u32_baud_rate, uint64_t now_us) = 0;
+};
+
+/**
+ * @brief Counters of a uart
+ */
+typedef struct
+{
+    uint32_t u32_tx_bytes;                          // bytes written by the host
+    uint32_t u32_rx_bytes;                          // bytes received into the rx buffer
+    uint32_t u32_rx_overruns;                       // bytes lost because the rx buffer was full
+    uint32_t u32_rx_framing_errors;                 // bytes received at another baud rate
+    uint32_t u32_rx_callbacks;                      // calls of the onReceive callback
+} host_uart_stats_t;
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTION PROTOTYPES
+ **********************************************************************************************************/
+
+/**
+ * @brief Brings time back to 0 and disconnects every uart, device and hook.
+ */
+void host_hal_reset();
+
+/**
+ * @brief Uses the monotonic clock instead of the virtual time, needed for the ttys.
+ */
+void host_hal_set_real_time(bool is_real_time);
+bool host_hal_is_real_time();
+
+/**
+ * @brief Current time in microseconds.
+ */
+uint64_t host_hal_get_time_us();
+
+/**
+ * @brief Lets the time pass until time_us, delay() is built on it.
+ */
+void host_hal_run_until(uint64_t time_us);
+
+/**
+ * @brief Devices are polled as the time passes, in the order they were added.
+ * Every device sees every pin write, each modem of a host with several of them watches its own pins.
+ */
+void host_hal_add_device(HostDevice *p_device);
+void host_hal_remove_device(HostDevice *p_device);
+
+/**
+ * @brief Where Serial prints, NULL drops the console output. stdout when HOST_VERBOSE is set.
+ */
+void host_hal_set_console(FILE *p_file);
+
+/**
+ * @brief Called by ESP.restart().
+ */
+void host_hal_on_restart(std::function<void(void)> hook);
+uint32_t host_hal_get_restart_count();
+
+/**
+ * @brief Connects the uart to the far end of an emulated wire.
+ * Bytes take 10 bit times at the baud rate of their sender in both directions.
+ */
+void host_uart_attach_peer(HardwareSerial &serial, HostUartPeer *p_peer);
+
+/**
+ * @brief Sends bytes from the peer to the host at baud_rate, they follow what the peer already sent.
+ */
+void host_uart_peer_send(HardwareSerial &serial, const uint8_t *p_data, size_t len, uint32_t u32_baud_rate);
+
+/**
+ * @brief True while bytes sent by the peer are still on the wire.
+ */
+bool host_uart_peer_is_sending(HardwareSerial &serial);
+
+/**
+ * @brief Connects the uart to a tty, a pseudo terminal of the emulator for instance. Real time only.
+ * @return true if the tty could be opened
+ */
+bool host_uart_open_tty(HardwareSerial &serial, const char *p_path);
+
+/**
+ * @brief The next writes take up to bytes in total, the rest comes back short. SIZE_MAX, as after a reset, never fails.
+ */
+void host_uart_fail_write_after(HardwareSerial &serial, size_t bytes);
+
+/**
+ * @brief Counters of the uart since it was connected.
+ */
+host_uart_stats_t host_uart_get_stats(HardwareSerial &serial);
+
+#endif // __HOST_HAL_H__
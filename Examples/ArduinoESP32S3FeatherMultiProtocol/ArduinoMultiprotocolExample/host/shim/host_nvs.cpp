@@ -0,0 +1,229 @@
+/**
+ * @file host_nvs.cpp
+ * @author OXIT embedded firmware team
+ * @brief nvs shim, the namespaces and entries are kept in memory until nvs_flash_erase().
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "nvs_flash.h"
+#include <map>
+#include <string>
+#include <vector>
+#include <string.h>
+
+/******************************************************************************
+ * PRIVATE TYPEDEFS
+ ******************************************************************************/
+typedef enum
+{
+    ENTRY_TYPE_U16,
+    ENTRY_TYPE_BLOB
+} entry_type_t;
+
+typedef struct
+{
+    entry_type_t type;
+    std::vector<uint8_t> value;
+} entry_t;
+
+typedef struct
+{
+    std::string name;                               // namespace
+    nvs_open_mode_t mode;
+} handle_t;
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static std::map<std::string, std::map<std::string, entry_t>> s_namespaces;
+static std::map<nvs_handle_t, handle_t> s_handles;
+static nvs_handle_t s_next_handle = 1;
+static host_nvs_stats_t s_stats;
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static esp_err_t get_entry(nvs_handle_t handle, const char *key, entry_type_t type, entry_t **pp_entry)
+{
+    auto it_handle = s_handles.find(handle);
+    if (s_handles.end() == it_handle)
+    {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+    auto &entries = s_namespaces[it_handle->second.name];
+    auto it_entry = entries.find(key);
+    if (entries.end() == it_entry)
+    {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    if (type != it_entry->second.type)
+    {
+        return ESP_ERR_NVS_TYPE_MISMATCH;
+    }
+    *pp_entry = &it_entry->second;
+    return ESP_OK;
+}
+
+static esp_err_t set_entry(nvs_handle_t handle, const char *key, entry_type_t type, const void *value, size_t length)
+{
+    auto it_handle = s_handles.find(handle);
+    if (s_handles.end() == it_handle)
+    {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+    if (NVS_READONLY == it_handle->second.mode)
+    {
+        return ESP_ERR_NVS_READ_ONLY;
+    }
+    entry_t &entry = s_namespaces[it_handle->second.name][key];
+    entry.type = type;
+    entry.value.assign((const uint8_t *)value, (const uint8_t *)value + length);
+    s_stats.u32_writes++;
+    return ESP_OK;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+esp_err_t nvs_flash_init(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void)
+{
+    s_namespaces.clear();
+    s_handles.clear();
+    memset(&s_stats, 0, sizeof(s_stats));
+    return ESP_OK;
+}
+
+esp_err_t nvs_open(const char *name, nvs_open_mode_t open_mode, nvs_handle_t *out_handle)
+{
+    if ((NVS_READONLY == open_mode) && (s_namespaces.end() == s_namespaces.find(name)))
+    {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    s_namespaces[name];
+    *out_handle = s_next_handle++;
+    s_handles[*out_handle] = { name, open_mode };
+    return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t handle)
+{
+    s_handles.erase(handle);
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle)
+{
+    if (s_handles.end() == s_handles.find(handle))
+    {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+    s_stats.u32_commits++;
+    return ESP_OK;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length)
+{
+    entry_t *p_entry;
+    esp_err_t err = get_entry(handle, key, ENTRY_TYPE_BLOB, &p_entry);
+
+    if (ESP_OK != err)
+    {
+        return err;
+    }
+    if (NULL == out_value)
+    {
+        *length = p_entry->value.size();
+        return ESP_OK;
+    }
+    if (*length < p_entry->value.size())
+    {
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+    memcpy(out_value, p_entry->value.data(), p_entry->value.size());
+    *length = p_entry->value.size();
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length)
+{
+    return set_entry(handle, key, ENTRY_TYPE_BLOB, value, length);
+}
+
+esp_err_t nvs_get_u16(nvs_handle_t handle, const char *key, uint16_t *out_value)
+{
+    entry_t *p_entry;
+    esp_err_t err = get_entry(handle, key, ENTRY_TYPE_U16, &p_entry);
+
+    if (ESP_OK == err)
+    {
+        memcpy(out_value, p_entry->value.data(), sizeof(*out_value));
+    }
+    return err;
+}
+
+esp_err_t nvs_set_u16(nvs_handle_t handle, const char *key, uint16_t value)
+{
+    return set_entry(handle, key, ENTRY_TYPE_U16, &value, sizeof(value));
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char *key)
+{
+    auto it_handle = s_handles.find(handle);
+    if (s_handles.end() == it_handle)
+    {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+    if (0 == s_namespaces[it_handle->second.name].erase(key))
+    {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    s_stats.u32_erases++;
+    return ESP_OK;
+}
+
+host_nvs_stats_t host_nvs_get_stats(void)
+{
+    return s_stats;
+}
@@ -0,0 +1,193 @@
+/**
+ * @file host_update.cpp
+ * @author OXIT embedded firmware team
+ * @brief Update shim, the OTA partition is a buffer of the host.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <Update.h>
+
+/******************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ ******************************************************************************/
+#define FLASH_SECTOR_SIZE           4096
+#define STREAM_CHUNK_SIZE           4096
+
+/******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+UpdateClass Update;
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+bool UpdateClass::set_error(uint8_t error)
+{
+    _error = error;
+    _size = 0;
+    _progress = 0;
+    return false;
+}
+
+bool UpdateClass::begin(size_t size, int command, int led_pin, uint8_t led_on, const char *label)
+{
+    (void)command;
+    (void)led_pin;
+    (void)led_on;
+    (void)label;
+
+    if (isRunning())
+    {
+        return false;
+    }
+    _error = UPDATE_ERROR_OK;
+    if (UPDATE_SIZE_UNKNOWN == size)
+    {
+        size = HOST_UPDATE_PARTITION_SIZE;
+    }
+    if ((0 == size) || (HOST_UPDATE_PARTITION_SIZE < size))
+    {
+        return set_error(UPDATE_ERROR_SIZE);
+    }
+    _image.clear();
+    _size = size;
+    _progress = 0;
+    _stats.u32_begins++;
+    return true;
+}
+
+size_t UpdateClass::write(uint8_t *data, size_t len)
+{
+    if (hasError() || !isRunning())
+    {
+        return 0;
+    }
+    if (len > remaining())
+    {
+        set_error(UPDATE_ERROR_SPACE);
+        return 0;
+    }
+    if ((0 == _progress) && (0 < len) && (ESP_IMAGE_HEADER_MAGIC != data[0]))
+    {
+        set_error(UPDATE_ERROR_MAGIC_BYTE);
+        return 0;
+    }
+    if ((_progress + len) > _fail_after)
+    {
+        set_error(UPDATE_ERROR_WRITE);
+        return 0;
+    }
+    // sectors are erased as the image reaches them
+    size_t sectors_before = (_progress + FLASH_SECTOR_SIZE - 1) / FLASH_SECTOR_SIZE;
+    size_t sectors_after = (_progress + len + FLASH_SECTOR_SIZE - 1) / FLASH_SECTOR_SIZE;
+    _stats.u32_sectors_erased += (uint32_t)(sectors_after - sectors_before);
+    _image.insert(_image.end(), data, data + len);
+    _progress += len;
+    _stats.u64_bytes_written += len;
+    return len;
+}
+
+size_t UpdateClass::writeStream(Stream &data)
+{
+    uint8_t buffer[STREAM_CHUNK_SIZE];
+    size_t written = 0;
+
+    while (isRunning() && !isFinished())
+    {
+        size_t len = data.readBytes(buffer, std::min(sizeof(buffer), remaining()));
+        if (0 == len)
+        {
+            set_error(UPDATE_ERROR_STREAM);
+            break;
+        }
+        if (write(buffer, len) != len)
+        {
+            break;
+        }
+        written += len;
+    }
+    return written;
+}
+
+bool UpdateClass::end(bool even_if_remaining)
+{
+    if (hasError() || !isRunning())
+    {
+        return false;
+    }
+    if (!isFinished() && !even_if_remaining)
+    {
+        return set_error(UPDATE_ERROR_ABORT);
+    }
+    _stats.u32_completed++;
+    _size = 0;
+    _progress = 0;
+    return true;
+}
+
+void UpdateClass::abort()
+{
+    set_error(UPDATE_ERROR_ABORT);
+}
+
+const char *UpdateClass::errorString()
+{
+    static const char *const errors[] = { "No Error", "Flash Write Failed", "Flash Erase Failed", "Flash Read Failed",
+                                          "Not Enough Space", "Bad Size Given", "Stream Read Timeout", "MD5 Check Failed",
+                                          "Wrong Magic Byte", "Could Not Activate The Firmware", "Partition Could Not be Found",
+                                          "Bad Argument", "Aborted" };
+    return (_error < (sizeof(errors) / sizeof(errors[0]))) ? errors[_error] : "UNKNOWN";
+}
+
+void UpdateClass::printError(Print &out)
+{
+    out.printf("%s\n", errorString());
+}
+
+void UpdateClass::host_reset()
+{
+    _image.clear();
+    _size = 0;
+    _progress = 0;
+    _error = UPDATE_ERROR_OK;
+    _fail_after = SIZE_MAX;
+    _stats = {};
+}
@@ -0,0 +1,224 @@
+/**
+ * @file test_ble_conn.cpp
+ * @author OXIT embedded firmware team
+ * @brief Tests of the sidewalk ble connection, the link is taken as up a setup time after the ack of the request.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_mcm.h"
+#include "ble_conn.h"
+
+/******************************************************************************
+ * MACROS AND DEFINES
+ ******************************************************************************/
+#define TEST_PAYLOAD_LEN            (20)
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static const ble_conn_config_t s_config = { 10000, 1000, 30000, 2000, 60000 };
+static std::vector<MCM_TX_STATUS> s_results;
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static void on_uplink_result(uint32_t msg_id, MCM_TX_STATUS status, uint8_t attempts)
+{
+    (void)msg_id;
+    (void)attempts;
+    s_results.push_back(status);
+}
+
+/**
+ * @brief Sidewalk over ble, joined and left idle until the connection of the join is closed on both sides.
+ */
+static bool start_ble(TestMcm &t)
+{
+    if (!t.start())
+    {
+        return false;
+    }
+    t.mcm.set_connect_mode(ConnectionMode::CONNECTION_MODE_SIDEWALK_BLE);
+    if ((MCM_STATUS::MCM_OK != t.mcm.connect_network()) || !t.run_until([&]() { return t.mcm.is_connected(); }))
+    {
+        return false;
+    }
+    t.run_for(MCM_BLE_CONN_IDLE_TIMEOUT_MS + 1000);
+    t.mcm.set_on_uplink_result_callback(on_uplink_result);
+    s_results.clear();
+    return true;
+}
+
+/**
+ * @brief The ack of the request is not the link up, the state moves on with the setup time or a link event.
+ */
+static void test_ack_waits_for_link_setup()
+{
+    ble_conn_t conn;
+
+    ble_conn_init(&conn, &s_config);
+    CHECK(ble_conn_should_request(&conn, 0));
+    ble_conn_on_request(&conn, 0);
+    ble_conn_on_ack(&conn, 100);
+    CHECK(BLE_CONN_ACKED == ble_conn_get_state(&conn));
+    CHECK(!ble_conn_poll(&conn, 1099));
+    CHECK(!ble_conn_should_request(&conn, 1099));
+    CHECK(ble_conn_poll(&conn, 1100));
+    CHECK_EQ(ble_conn_get_stats(&conn)->u32_connections, 1);
+
+    // a late ack does not bring back a connection already up
+    ble_conn_on_ack(&conn, 1200);
+    CHECK(BLE_CONN_UP == ble_conn_get_state(&conn));
+
+    // an event which needs the link ends the setup early
+    ble_conn_reset(&conn);
+    ble_conn_on_request(&conn, 2000);
+    ble_conn_on_ack(&conn, 2010);
+    ble_conn_on_result(&conn, true, 2020);
+    CHECK(ble_conn_poll(&conn, 2020));
+    CHECK_EQ(ble_conn_get_stats(&conn)->u32_connections, 2);
+
+    // a failure during the setup waits for the backoff
+    ble_conn_reset(&conn);
+    ble_conn_on_request(&conn, 3000);
+    ble_conn_on_ack(&conn, 3010);
+    ble_conn_on_result(&conn, false, 3500);
+    CHECK(BLE_CONN_DOWN == ble_conn_get_state(&conn));
+    CHECK_EQ(ble_conn_get_stats(&conn)->u32_failures, 1);
+    CHECK(!ble_conn_should_request(&conn, 3500 + 1999));
+    CHECK(ble_conn_should_request(&conn, 3500 + 2000));
+}
+
+/**
+ * @brief The modem is given the setup time before the first uplink, which is then sent on air.
+ */
+static void test_first_uplink_after_setup()
+{
+    TestMcm t("ble 800 20000\n"
+              "link 1000\n"
+              "txdone noack 400\n");
+    uint8_t payload[TEST_PAYLOAD_LEN] = {};
+    uint32_t u32_msg_id = 0;
+    uint64_t u64_ack_us = 0;
+
+    REQUIRE(start_ble(t));
+    uint32_t u32_requests = t.emulator.get_command_count(MROVER_CC_BLE_CONNECTION_REQUEST);
+    REQUIRE(MCM_STATUS::MCM_OK == t.mcm.queue_uplink(payload, sizeof(payload), 1, MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF,
+                                                     UPLINK_SCHED_TELEMETRY, &u32_msg_id));
+
+    // the loop keeps running while the link is set up
+    CHECK(t.run_until([&]() { return BLE_CONN_ACKED == t.mcm.get_ble_connection_state(); }, 1000));
+    u64_ack_us = host_hal_get_time_us();
+    CHECK(t.run_until([&]() { return !t.emulator.get_uplinks().empty(); }, 5000));
+    REQUIRE(1 == t.emulator.get_uplinks().size());
+    CHECK(t.emulator.get_uplinks()[0].u64_time_us >= u64_ack_us + MCM_BLE_CONN_LINK_SETUP_MS * 1000ULL);
+
+    CHECK(t.run_until([&]() { return !s_results.empty(); }, 5000));
+    REQUIRE(1 == s_results.size());
+    CHECK(MCM_TX_STATUS::MCM_TX_WO_ACK == s_results[0]);
+    CHECK_EQ(t.emulator.get_command_count(MROVER_CC_BLE_CONNECTION_REQUEST), u32_requests + 1);
+    CHECK_EQ(t.mcm.get_retry_stats()->u32_retries, 0);
+}
+
+/**
+ * @brief A burst shares one connection, the uplinks after the first do not wait for a setup.
+ */
+static void test_burst_shares_connection()
+{
+    TestMcm t("ble 800 20000\n"
+              "link 1000\n"
+              "txdone noack 400\n");
+    uint8_t payload[TEST_PAYLOAD_LEN] = {};
+    uint32_t u32_msg_id = 0;
+
+    REQUIRE(start_ble(t));
+    uint32_t u32_requests = t.emulator.get_command_count(MROVER_CC_BLE_CONNECTION_REQUEST);
+    for (int i = 0; i < 4; i++)
+    {
+        payload[0] = (uint8_t)i;
+        REQUIRE(MCM_STATUS::MCM_OK == t.mcm.queue_uplink(payload, sizeof(payload), 1, MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF,
+                                                         UPLINK_SCHED_TELEMETRY, &u32_msg_id));
+    }
+    CHECK(t.run_until([&]() { return 4 == s_results.size(); }, 20000));
+    for (MCM_TX_STATUS status : s_results)
+    {
+        CHECK(MCM_TX_STATUS::MCM_TX_WO_ACK == status);
+    }
+    CHECK_EQ(t.emulator.get_command_count(MROVER_CC_BLE_CONNECTION_REQUEST), u32_requests + 1);
+    CHECK_EQ(t.mcm.get_ble_connection_stats()->u32_uplinks, 4);
+}
+
+/**
+ * @brief A refused request is asked again after the backoff, nothing is sent meanwhile.
+ */
+static void test_refused_request()
+{
+    TestMcm t("ble 800 20000\n"
+              "link 1000\n"
+              "txdone noack 400\n");
+    uint8_t payload[TEST_PAYLOAD_LEN] = {};
+    uint32_t u32_msg_id = 0;
+
+    REQUIRE(start_ble(t));
+    t.emulator.set_rc(MROVER_CC_BLE_CONNECTION_REQUEST, MROVER_RC_FAIL);
+    REQUIRE(MCM_STATUS::MCM_OK == t.mcm.queue_uplink(payload, sizeof(payload), 1, MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF,
+                                                     UPLINK_SCHED_TELEMETRY, &u32_msg_id));
+    t.run_for(1000);
+    CHECK(BLE_CONN_DOWN == t.mcm.get_ble_connection_state());
+    CHECK_EQ(t.mcm.get_ble_connection_stats()->u32_failures, 1);
+    CHECK(t.emulator.get_uplinks().empty());
+
+    t.emulator.clear_rc(MROVER_CC_BLE_CONNECTION_REQUEST);
+    CHECK(t.run_until([&]() { return !s_results.empty(); }, 10000));
+    CHECK(MCM_TX_STATUS::MCM_TX_WO_ACK == s_results[0]);
+    CHECK_EQ(t.emulator.get_uplinks().size(), 1);
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    test_ack_waits_for_link_setup();
+    test_first_uplink_after_setup();
+    test_burst_shares_connection();
+    test_refused_request();
+    return test_result("test_ble_conn");
+}
@@ -0,0 +1,188 @@
+/**
+ * @file test_checksum.cpp
+ * @author OXIT embedded firmware team
+ * @brief Shared crc16 CCITT and xor checksums against the bitwise and bytewise loops they replaced.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include "test_common.h"
+#include "checksum.h"
+#include "frame_parse.h"
+#include <random>
+#include <vector>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+#define TEST_RANDOM_ROUNDS          (2000)
+#define TEST_MAX_LEN                (2100)              // two ymodem blocks and a bit
+#define TEST_MAX_OFFSET             (16)                // every alignment of a 64 bit word
+
+/**********************************************************************************************************
+ * STATIC FUNCTIONS
+ **********************************************************************************************************/
+/**
+ * @brief crc16 CCITT a bit at a time, the former loop of YModem::calculateCRC() and of the uplink journal
+ */
+static uint16_t reference_crc16(uint16_t u16_crc, const uint8_t *p_data, uint32_t u32_len)
+{
+    for (uint32_t i = 0; i < u32_len; i++)
+    {
+        u16_crc ^= (uint16_t)p_data[i] << 8;
+        for (uint8_t j = 0; j < 8; j++)
+        {
+            u16_crc = (u16_crc & 0x8000) ? ((u16_crc << 1) ^ 0x1021) : (u16_crc << 1);
+        }
+    }
+    return u16_crc;
+}
+
+/**
+ * @brief xor a byte at a time, the former loop of fp_calculate_crc()
+ */
+static uint8_t reference_xor8(uint8_t u8_xor, const uint8_t *p_data, uint32_t u32_len)
+{
+    for (uint32_t i = 0; i < u32_len; i++)
+    {
+        u8_xor ^= p_data[i];
+    }
+    return u8_xor;
+}
+
+static void test_check_values()
+{
+    static const uint8_t au8_check[] = "123456789";
+
+    CHECK_EQ(checksum_crc16_ccitt(CHECKSUM_CRC16_XMODEM_INIT, au8_check, 9), 0x31C3);
+    CHECK_EQ(checksum_crc16_ccitt(CHECKSUM_CRC16_CCITT_INIT, au8_check, 9), 0x29B1);
+    CHECK_EQ(checksum_crc16_ccitt_table(CHECKSUM_CRC16_XMODEM_INIT, au8_check, 9), 0x31C3);
+    CHECK_EQ(checksum_crc16_ccitt(0x1234, au8_check, 0), 0x1234);
+    CHECK_EQ(checksum_xor8(0x5A, au8_check, 0), 0x5A);
+    CHECK_EQ(checksum_xor8(0, au8_check, 9), reference_xor8(0, au8_check, 9));
+    // no ROM on the host
+    CHECK(!checksum_is_rom_crc16());
+}
+
+/**
+ * @brief Random lengths, alignments and split points give the results of the former loops.
+ */
+static void test_random_against_reference()
+{
+    std::mt19937 rng(22);
+    std::vector<uint8_t> buffer(TEST_MAX_LEN + TEST_MAX_OFFSET);
+    uint32_t u32_crc_mismatches = 0;
+    uint32_t u32_xor_mismatches = 0;
+
+    for (uint32_t u32_round = 0; u32_round < TEST_RANDOM_ROUNDS; u32_round++)
+    {
+        uint32_t u32_len = rng() % (TEST_MAX_LEN + 1);
+        uint32_t u32_offset = rng() % TEST_MAX_OFFSET;
+        uint32_t u32_split = (0 == u32_len) ? 0 : (rng() % (u32_len + 1));
+        uint16_t u16_init = (0 == (u32_round & 1)) ? CHECKSUM_CRC16_XMODEM_INIT : CHECKSUM_CRC16_CCITT_INIT;
+        uint8_t u8_init = (uint8_t)rng();
+        const uint8_t *p_data = buffer.data() + u32_offset;
+
+        for (uint8_t &u8_byte : buffer)
+        {
+            u8_byte = (uint8_t)rng();
+        }
+
+        uint16_t u16_expected = reference_crc16(u16_init, p_data, u32_len);
+        uint16_t u16_whole = checksum_crc16_ccitt(u16_init, p_data, u32_len);
+        uint16_t u16_split = checksum_crc16_ccitt(checksum_crc16_ccitt(u16_init, p_data, u32_split), p_data + u32_split, u32_len - u32_split);
+        u32_crc_mismatches += ((u16_whole != u16_expected) || (u16_split != u16_expected)) ? 1 : 0;
+
+        uint8_t u8_expected = reference_xor8(u8_init, p_data, u32_len);
+        uint8_t u8_whole = checksum_xor8(u8_init, p_data, u32_len);
+        uint8_t u8_split = checksum_xor8(checksum_xor8(u8_init, p_data, u32_split), p_data + u32_split, u32_len - u32_split);
+        u32_xor_mismatches += ((u8_whole != u8_expected) || (u8_split != u8_expected)) ? 1 : 0;
+    }
+    CHECK_EQ(u32_crc_mismatches, 0);
+    CHECK_EQ(u32_xor_mismatches, 0);
+}
+
+/**
+ * @brief Every length up to a few words at every alignment, the edges of the slice and of the word loop.
+ */
+static void test_short_lengths()
+{
+    uint8_t au8_buffer[64 + TEST_MAX_OFFSET];
+    uint32_t u32_mismatches = 0;
+
+    for (size_t i = 0; i < sizeof(au8_buffer); i++)
+    {
+        au8_buffer[i] = (uint8_t)(i * 37 + 11);
+    }
+    for (uint32_t u32_offset = 0; u32_offset < TEST_MAX_OFFSET; u32_offset++)
+    {
+        for (uint32_t u32_len = 0; u32_len <= 64; u32_len++)
+        {
+            const uint8_t *p_data = au8_buffer + u32_offset;
+            u32_mismatches += (checksum_crc16_ccitt(0, p_data, u32_len) != reference_crc16(0, p_data, u32_len)) ? 1 : 0;
+            u32_mismatches += (checksum_xor8(0, p_data, u32_len) != reference_xor8(0, p_data, u32_len)) ? 1 : 0;
+        }
+    }
+    CHECK_EQ(u32_mismatches, 0);
+}
+
+/**
+ * @brief The frames keep their checksum, the last byte is the xor of the others.
+ */
+static void test_frame_checksum()
+{
+    uint8_t au8_frame[] = { 0x01, 0x00, 0x12, 0x00, 0x03, 0xAA, 0xBB, 0xCC, 0x00 };
+
+    CHECK(FP_SUCCESS == fp_append_crc(au8_frame, sizeof(au8_frame)));
+    CHECK_EQ(au8_frame[sizeof(au8_frame) - 1], reference_xor8(0, au8_frame, sizeof(au8_frame) - 1));
+    CHECK_EQ(fp_update_crc(fp_update_crc(0, au8_frame, 3), au8_frame + 3, sizeof(au8_frame) - 4), au8_frame[sizeof(au8_frame) - 1]);
+}
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTIONS
+ **********************************************************************************************************/
+int main()
+{
+    test_check_values();
+    test_random_against_reference();
+    test_short_lengths();
+    test_frame_checksum();
+    return test_result("test_checksum");
+}
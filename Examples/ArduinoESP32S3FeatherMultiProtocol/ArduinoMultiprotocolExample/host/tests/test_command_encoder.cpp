@@ -0,0 +1,303 @@
+/**
+ * @file test_command_encoder.cpp
+ * @author OXIT embedded firmware team
+ * @brief Tests of the command encoder, the frames of the descriptor table match the ones of the former builders byte for byte.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_common.h"
+#include "api_processor.h"
+#include "checksum.h"
+#include <functional>
+#include <random>
+#include <vector>
+
+/******************************************************************************
+ * MACROS AND DEFINES
+ ******************************************************************************/
+#define TEST_RANDOM_UPLINKS         (20000)
+#define TEST_MAX_UPLINK_LEN         (350)
+
+/******************************************************************************
+ * TYPEDEFS
+ ******************************************************************************/
+typedef std::vector<uint8_t> frame_t;
+
+typedef struct
+{
+    const char *p_name;
+    std::function<api_processor_status_t(mcm_module_hdl_t *)> build;
+    frame_t expected;
+} golden_frame_t;
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static mcm_module_hdl_t s_module;
+static mcm_module_hdl_t s_vector_module;
+static frame_t s_sent;
+static frame_t s_vector_sent;
+static const uint8_t *s_vector_payload;                 // where the payload segment pointed
+static uint8_t s_eui[LORAWAN_DEV_EUI_JOIN_EUI_LEN] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+static uint8_t s_key[LORAWAN_NETWORK_KEY_LEN];
+static uint8_t s_payload[300];
+static const ver_type_1_t s_version = { 1, 2, 3 };
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static uint16_t on_send(uint8_t *data, uint16_t size, void *user_context)
+{
+    (void)user_context;
+    s_sent.assign(data, data + size);
+    return size;
+}
+
+static uint16_t on_send_vector(const serial_tx_segment_t *p_segments, uint8_t u8_count, void *user_context)
+{
+    (void)user_context;
+    s_vector_sent.clear();
+    for (uint8_t i = 0; i < u8_count; i++)
+    {
+        s_vector_sent.insert(s_vector_sent.end(), p_segments[i].p_data, p_segments[i].p_data + p_segments[i].u16_len);
+    }
+    s_vector_payload = (3 == u8_count) ? p_segments[1].p_data : NULL;
+    return (uint16_t)s_vector_sent.size();
+}
+
+static void on_notification(void *user_context)
+{
+    (void)user_context;
+}
+
+static void on_response(const api_processor_response_t *response, void *user_context)
+{
+    (void)response;
+    (void)user_context;
+}
+
+/**
+ * @brief Header, payload and crc of a frame, for the frames too long to spell out.
+ */
+static frame_t make_frame(uint8_t u8_type, uint16_t u16_code, const frame_t &payload)
+{
+    frame_t frame = { u8_type, (uint8_t)(u16_code >> 8), (uint8_t)u16_code, (uint8_t)(payload.size() >> 8), (uint8_t)payload.size() };
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    frame.push_back(checksum_xor8(0, frame.data(), frame.size()));
+    return frame;
+}
+
+static frame_t with_prefix(frame_t prefix, uint16_t u16_len)
+{
+    prefix.insert(prefix.end(), s_payload, s_payload + u16_len);
+    return prefix;
+}
+
+/**
+ * @brief Every builder with valid parameters, against the frame of the former hand written builder.
+ */
+static void test_golden_frames()
+{
+    const golden_frame_t golden[] =
+    {
+        { "get_event", [](mcm_module_hdl_t *m) { return api_processor_cmd_get_event(m); }, { 0x01, 0x00, 0x00, 0x00, 0x00, 0x01 } },
+        { "get_version", [](mcm_module_hdl_t *m) { return api_processor_cmd_get_version(m); }, { 0x01, 0x00, 0x01, 0x00, 0x00, 0x00 } },
+        { "reset", [](mcm_module_hdl_t *m) { return api_processor_cmd_reset(m); }, { 0x01, 0x00, 0x02, 0x00, 0x00, 0x03 } },
+        { "factory_reset", [](mcm_module_hdl_t *m) { return api_processor_cmd_factory_reset(m); }, { 0x01, 0x00, 0x03, 0x00, 0x00, 0x02 } },
+        { "switch_network", [](mcm_module_hdl_t *m) { return api_processor_cmd_switch_network(m); }, { 0x01, 0x01, 0x00, 0x00, 0x00, 0x00 } },
+        { "init_lorawan", [](mcm_module_hdl_t *m) { return api_processor_cmd_init_lorawan(m); }, { 0x02, 0x00, 0xFF, 0x00, 0x00, 0xFD } },
+        { "set_join_eui", [](mcm_module_hdl_t *m) { return api_processor_cmd_set_join_eui(m, s_eui, sizeof(s_eui)); },
+          { 0x02, 0x00, 0x11, 0x00, 0x08, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x13 } },
+        { "set_dev_eui", [](mcm_module_hdl_t *m) { return api_processor_cmd_set_dev_eui(m, s_eui, sizeof(s_eui)); },
+          { 0x02, 0x00, 0x13, 0x00, 0x08, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x11 } },
+        { "set_nwk_key", [](mcm_module_hdl_t *m) { return api_processor_cmd_set_nwk_key(m, s_key, sizeof(s_key)); },
+          { 0x02, 0x00, 0x14, 0x00, 0x10, 0x00, 0x07, 0x0E, 0x15, 0x1C, 0x23, 0x2A, 0x31, 0x38, 0x3F, 0x46, 0x4D, 0x54, 0x5B, 0x62, 0x69, 0x36 } },
+        { "get_dev_eui", [](mcm_module_hdl_t *m) { return api_processor_cmd_get_dev_eui(m); }, { 0x02, 0x00, 0x12, 0x00, 0x00, 0x10 } },
+        { "get_join_eui", [](mcm_module_hdl_t *m) { return api_processor_cmd_get_join_eui(m); }, { 0x02, 0x00, 0x10, 0x00, 0x00, 0x12 } },
+        { "join_lorawan", [](mcm_module_hdl_t *m) { return api_processor_cmd_join_lorawan(m); }, { 0x02, 0x00, 0x25, 0x00, 0x00, 0x27 } },
+        { "lorawan_uplink 20", [](mcm_module_hdl_t *m) { return api_processor_cmd_request_lorawan_uplink(m, 10, s_payload, 20, MROVER_CONFIRMED_UPLINK); },
+          { 0x02, 0x00, 0x29, 0x00, 0x16, 0x0A, 0x01, 0x01, 0x0E, 0x1B, 0x28, 0x35, 0x42, 0x4F, 0x5C, 0x69, 0x76, 0x83, 0x90, 0x9D,
+            0xAA, 0xB7, 0xC4, 0xD1, 0xDE, 0xEB, 0xF8, 0x3A } },
+        { "lorawan_uplink empty", [](mcm_module_hdl_t *m) { return api_processor_cmd_request_lorawan_uplink(m, 10, NULL, 0, MROVER_UNCONFIRMED_UPLINK); },
+          { 0x02, 0x00, 0x29, 0x00, 0x02, 0x0A, 0x00, 0x23 } },
+        { "lorawan_uplink 290", [](mcm_module_hdl_t *m) { return api_processor_cmd_request_lorawan_uplink(m, 10, s_payload, 290, MROVER_UNCONFIRMED_UPLINK); },
+          make_frame(COMMAND_TYPE_LORAWAN, MROVER_CC_REQUEST_UPLINK, with_prefix({ 10, MROVER_UNCONFIRMED_UPLINK }, 290)) },
+        { "leave_lorawan", [](mcm_module_hdl_t *m) { return api_processor_cmd_leave_lorawan_network(m); }, { 0x02, 0x00, 0x26, 0x00, 0x00, 0x24 } },
+        { "stop_lorawan", [](mcm_module_hdl_t *m) { return api_processor_cmd_stop_lorawan_network(m); }, { 0x02, 0x00, 0xFE, 0x00, 0x01, 0x01, 0xFC } },
+        { "ble_link", [](mcm_module_hdl_t *m) { return api_processor_cmd_sid_ble_link_request(m); }, { 0x03, 0x00, 0xFA, 0x00, 0x00, 0xF9 } },
+        { "ble_conn", [](mcm_module_hdl_t *m) { return api_processor_cmd_sid_ble_conn_request(m); }, { 0x03, 0x00, 0xFB, 0x00, 0x00, 0xF8 } },
+        { "fsk_link", [](mcm_module_hdl_t *m) { return api_processor_cmd_sid_fsk_link_request(m); }, { 0x03, 0x00, 0xF8, 0x00, 0x00, 0xFB } },
+        { "css_link", [](mcm_module_hdl_t *m) { return api_processor_cmd_sid_css_link_request(m); }, { 0x03, 0x00, 0xF9, 0x00, 0x00, 0xFA } },
+        { "css_profile", [](mcm_module_hdl_t *m) { return api_processor_cmd_sid_set_css_profile(m, (mrover_css_pwr_profile_t)1); },
+          { 0x03, 0x00, 0xFD, 0x00, 0x01, 0x01, 0xFE } },
+        { "sid_uplink 19", [](mcm_module_hdl_t *m) { return api_processor_cmd_sid_send_uplink(m, s_payload, 19, MROVER_UNCONFIRMED_UPLINK); },
+          { 0x03, 0x00, 0x29, 0x00, 0x14, 0x00, 0x01, 0x0E, 0x1B, 0x28, 0x35, 0x42, 0x4F, 0x5C, 0x69, 0x76, 0x83, 0x90, 0x9D,
+            0xAA, 0xB7, 0xC4, 0xD1, 0xDE, 0xEB, 0xCA } },
+        { "sid_uplink 255", [](mcm_module_hdl_t *m) { return api_processor_cmd_sid_send_uplink(m, s_payload, 255, MROVER_CONFIRMED_UPLINK); },
+          make_frame(COMMAND_TYPE_SIDEWALK, MROVER_CC_REQUEST_UPLINK, with_prefix({ MROVER_CONFIRMED_UPLINK }, 255)) },
+        { "downlink_filter", [](mcm_module_hdl_t *m) { return api_processor_cmd_set_sid_downlink_filter(m, (mrover_sid_downlink_filter_t)0); },
+          { 0x03, 0x00, 0xFC, 0x00, 0x01, 0x00, 0xFE } },
+        { "sid_stop", [](mcm_module_hdl_t *m) { return api_processor_cmd_sid_stop(m); }, { 0x03, 0x00, 0xFE, 0x00, 0x01, 0x01, 0xFD } },
+        { "set_lorawan_class", [](mcm_module_hdl_t *m) { return api_processor_cmd_set_lorawan_class(m, (mrover_lorawan_class_t)2); },
+          { 0x02, 0x00, 0x16, 0x00, 0x01, 0x02, 0x17 } },
+        { "get_lorawan_class", [](mcm_module_hdl_t *m) { return api_processor_cmd_get_lorawan_class(m); }, { 0x02, 0x00, 0x15, 0x00, 0x00, 0x17 } },
+        { "start_file_transfer", [](mcm_module_hdl_t *m) { return api_processor_cmd_start_file_transfer(m, s_version); },
+          { 0x01, 0x00, 0xD3, 0x00, 0x03, 0x01, 0x02, 0x03, 0xD1 } },
+        { "file_status", [](mcm_module_hdl_t *m) { return api_processor_cmd_get_seg_file_transfer_status(m); }, { 0x01, 0x00, 0xD4, 0x00, 0x00, 0xD5 } },
+        { "trigger_fw_update", [](mcm_module_hdl_t *m) { return api_processor_cmd_trigger_fw_update(m, s_version); },
+          { 0x01, 0x00, 0xD5, 0x00, 0x03, 0x01, 0x02, 0x03, 0xD7 } },
+        { "gps_time", [](mcm_module_hdl_t *m) { return api_processor_cmd_get_gps_time(m); }, { 0x01, 0x00, 0x0A, 0x00, 0x00, 0x0B } },
+        { "lorawan_dev_time", [](mcm_module_hdl_t *m) { return api_processor_cmd_request_lorawan_dev_time(m); }, { 0x02, 0x00, 0x7C, 0x00, 0x00, 0x7E } },
+        { "last_dl_stats", [](mcm_module_hdl_t *m) { return api_processor_cmd_get_last_dl_stats(m); }, { 0x01, 0x00, 0xD6, 0x00, 0x00, 0xD7 } },
+        { "next_uplink_mtu", [](mcm_module_hdl_t *m) { return api_processor_cmd_get_next_uplink_mtu(m); }, { 0x01, 0x01, 0x01, 0x00, 0x00, 0x01 } },
+    };
+
+    for (const golden_frame_t &entry : golden)
+    {
+        s_sent.clear();
+        api_processor_status_t status = entry.build(&s_module);
+        CHECK_EQ(status, API_PROCESSOR_SUCCESS);
+        if (entry.expected != s_sent)
+        {
+            fprintf(stderr, "%s: frame of %zu bytes, %zu expected\n", entry.p_name, s_sent.size(), entry.expected.size());
+            CHECK(entry.expected == s_sent);
+        }
+    }
+}
+
+/**
+ * @brief The bounds and validators of the table refuse what the former builders let through, nothing is sent.
+ */
+static void test_rejected_parameters()
+{
+    s_sent.clear();
+
+    // a lorawan uplink larger than the send buffer used to overflow it
+    CHECK_EQ(api_processor_cmd_request_lorawan_uplink(&s_module, 10, s_payload, 300, MROVER_UNCONFIRMED_UPLINK), API_PROCESSOR_INVALID_PARAMETERS);
+    CHECK_EQ(api_processor_cmd_request_lorawan_uplink(&s_module, 0, s_payload, 10, MROVER_UNCONFIRMED_UPLINK), API_PROCESSOR_INVALID_PARAMETERS);
+    CHECK_EQ(api_processor_cmd_request_lorawan_uplink(&s_module, 225, s_payload, 10, MROVER_UNCONFIRMED_UPLINK), API_PROCESSOR_INVALID_PARAMETERS);
+    CHECK_EQ(api_processor_cmd_request_lorawan_uplink(&s_module, 10, s_payload, 10, (mrover_uplink_type_t)2), API_PROCESSOR_INVALID_PARAMETERS);
+    CHECK_EQ(api_processor_cmd_sid_send_uplink(&s_module, s_payload, 0, MROVER_UNCONFIRMED_UPLINK), API_PROCESSOR_INVALID_PARAMETERS);
+    CHECK_EQ(api_processor_cmd_sid_send_uplink(&s_module, s_payload, SIDEWALK_TX_MAX_BLE_PAYLOAD_SIZE + 1, MROVER_UNCONFIRMED_UPLINK),
+             API_PROCESSOR_INVALID_PARAMETERS);
+    CHECK_EQ(api_processor_cmd_set_join_eui(&s_module, s_eui, sizeof(s_eui) - 1), API_PROCESSOR_INVALID_PARAMETERS);
+
+    // the css profile used to be compared with the command code
+    CHECK_EQ(api_processor_cmd_sid_set_css_profile(&s_module, (mrover_css_pwr_profile_t)(MROVER_CSS_PWR_PROFILE_B + 1)), API_PROCESSOR_INVALID_PARAMETERS);
+    CHECK_EQ(api_processor_cmd_set_lorawan_class(&s_module, (mrover_lorawan_class_t)(MROVER_LORAWAN_CLASS_C + 1)), API_PROCESSOR_INVALID_PARAMETERS);
+    CHECK(s_sent.empty());
+}
+
+/**
+ * @brief Random uplinks, valid or not, give the same status and the same frame through the vectored
+ * callback as through the contiguous one. The vectored payload is the caller buffer itself.
+ */
+static void test_random_vectored_uplinks()
+{
+    std::mt19937 rng(12);
+    std::vector<uint8_t> payload(TEST_MAX_UPLINK_LEN);
+    uint32_t u32_sent = 0;
+
+    for (uint32_t u32_round = 0; u32_round < TEST_RANDOM_UPLINKS; u32_round++)
+    {
+        uint16_t u16_len = (uint16_t)(rng() % (TEST_MAX_UPLINK_LEN + 1));
+        uint8_t u8_port = (uint8_t)(rng() % 256);
+        mrover_uplink_type_t type = (mrover_uplink_type_t)(rng() % 3);
+        bool b_sidewalk = (0 == (rng() % 2));
+        uint8_t *p_payload = ((0 == u16_len) && (0 == (rng() % 2))) ? NULL : payload.data();
+        api_processor_status_t status;
+        api_processor_status_t vector_status;
+
+        for (uint16_t i = 0; i < u16_len; i++)
+        {
+            payload[i] = (uint8_t)rng();
+        }
+        s_sent.clear();
+        s_vector_sent.clear();
+        s_vector_payload = NULL;
+        if (b_sidewalk)
+        {
+            status = api_processor_cmd_sid_send_uplink(&s_module, p_payload, u16_len, type);
+            vector_status = api_processor_cmd_sid_send_uplink(&s_vector_module, p_payload, u16_len, type);
+        }
+        else
+        {
+            status = api_processor_cmd_request_lorawan_uplink(&s_module, u8_port, p_payload, u16_len, type);
+            vector_status = api_processor_cmd_request_lorawan_uplink(&s_vector_module, u8_port, p_payload, u16_len, type);
+        }
+        CHECK_EQ(vector_status, status);
+        CHECK(s_vector_sent == s_sent);
+        if (API_PROCESSOR_SUCCESS == status)
+        {
+            u32_sent++;
+            CHECK_EQ(checksum_xor8(0, s_sent.data(), s_sent.size()), 0);
+            CHECK(s_vector_payload == p_payload);
+        }
+        else
+        {
+            CHECK(s_sent.empty());
+        }
+    }
+    // both the valid and the invalid uplinks are drawn
+    CHECK((TEST_RANDOM_UPLINKS / 10 < u32_sent) && (u32_sent < TEST_RANDOM_UPLINKS));
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    for (size_t i = 0; i < sizeof(s_key); i++)
+    {
+        s_key[i] = (uint8_t)(i * 7);
+    }
+    for (size_t i = 0; i < sizeof(s_payload); i++)
+    {
+        s_payload[i] = (uint8_t)(i * 13 + 1);
+    }
+    REQUIRE(API_PROCESSOR_SUCCESS == api_processor_init(&s_module, on_send, on_notification, on_response));
+    REQUIRE(API_PROCESSOR_SUCCESS == api_processor_init(&s_vector_module, on_send, on_notification, on_response));
+    REQUIRE(API_PROCESSOR_SUCCESS == api_processor_set_send_vector_cb(&s_vector_module, on_send_vector));
+
+    test_golden_frames();
+    test_rejected_parameters();
+    test_random_vectored_uplinks();
+    return test_result("test_command_encoder");
+}
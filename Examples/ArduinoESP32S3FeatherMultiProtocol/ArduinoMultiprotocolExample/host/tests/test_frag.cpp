@@ -0,0 +1,355 @@
+/**
+ * @file test_frag.cpp
+ * @author OXIT embedded firmware team
+ * @brief Fragment layout, the reference reassembler against shuffled, duplicated and lost fragments, and MCM fragmented uplinks and downlinks.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include "test_mcm.h"
+#include "frag.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+#define RANDOM_MESSAGES         (20000)
+#define RX_TIMEOUT_MS           (60000)
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+typedef std::vector<uint8_t> bytes_t;
+
+/**********************************************************************************************************
+ * STATIC VARIABLES
+ **********************************************************************************************************/
+static std::mt19937 s_rng(20261017);
+static bytes_t s_frag_rx_message;
+static command_types_t s_frag_rx_protocol;
+
+/**********************************************************************************************************
+ * STATIC FUNCTIONS
+ **********************************************************************************************************/
+static bytes_t random_bytes(size_t len)
+{
+    bytes_t data(len);
+
+    for (uint8_t &u8_byte : data)
+    {
+        u8_byte = (uint8_t)s_rng();
+    }
+    return data;
+}
+
+static std::vector<bytes_t> split(const bytes_t &message, uint16_t u16_mtu, uint8_t u8_msg_id)
+{
+    frag_tx_t tx;
+    std::vector<bytes_t> fragments;
+    uint8_t au8_fragment[FRAG_HEADER_LEN + MCM_FRAG_MAX_PAYLOAD_SIZE];
+
+    REQUIRE(frag_tx_init(&tx, message.data(), (uint16_t)message.size(), u16_mtu, u8_msg_id));
+    for (uint8_t i = 0; i < frag_tx_get_count(&tx); i++)
+    {
+        uint16_t u16_len = frag_tx_build(&tx, i, au8_fragment);
+        CHECK((FRAG_HEADER_LEN < u16_len) && (u16_len <= u16_mtu));
+        fragments.push_back(bytes_t(au8_fragment, au8_fragment + u16_len));
+    }
+    CHECK_EQ(frag_tx_build(&tx, frag_tx_get_count(&tx), au8_fragment), 0);
+    return fragments;
+}
+
+static void test_layout()
+{
+    const bytes_t message = { 'A', 'B', 'C', 'D', 'E' };
+    std::vector<bytes_t> fragments = split(message, 4, 0x5A);
+
+    REQUIRE(3 == fragments.size());
+    CHECK(bytes_t({ 0x5A, 0x00, 'A', 'B' }) == fragments[0]);
+    CHECK(bytes_t({ 0x5A, 0x01, 'C', 'D' }) == fragments[1]);
+    CHECK(bytes_t({ 0x5A, 0x82, 'E' }) == fragments[2]);
+
+    CHECK_EQ(frag_get_count(0, 19), 0);
+    CHECK_EQ(frag_get_count(1, FRAG_HEADER_LEN), 0);
+    CHECK_EQ(frag_get_count(17, 19), 1);
+    CHECK_EQ(frag_get_count(18, 19), 2);
+    CHECK_EQ(frag_get_count(2048, 19), 121);
+
+    // 129 fragments do not fit the 7 bit index
+    frag_tx_t tx;
+    bytes_t big(FRAG_MAX_FRAGMENTS + 1);
+    CHECK(frag_tx_init(&tx, big.data(), FRAG_MAX_FRAGMENTS, 3, 0));
+    CHECK_EQ(frag_tx_get_count(&tx), FRAG_MAX_FRAGMENTS);
+    CHECK(!frag_tx_init(&tx, big.data(), FRAG_MAX_FRAGMENTS + 1, 3, 0));
+    CHECK(!frag_tx_init(&tx, big.data(), 0, 19, 0));
+}
+
+static void test_reassembly_errors()
+{
+    frag_rx_t rx;
+    uint8_t au8_storage[16];
+    uint16_t u16_len = 0;
+    const bytes_t message = { 'A', 'B', 'C', 'D', 'E' };
+    std::vector<bytes_t> fragments = split(message, 4, 1);
+
+    CHECK(!frag_rx_init(&rx, NULL, sizeof(au8_storage), RX_TIMEOUT_MS));
+    REQUIRE(frag_rx_init(&rx, au8_storage, sizeof(au8_storage), RX_TIMEOUT_MS));
+
+    // last fragment first, its place is known once another fragment gives the size
+    CHECK_EQ(frag_rx_push(&rx, fragments[2].data(), (uint16_t)fragments[2].size(), 0, &u16_len), FRAG_RX_PENDING);
+    CHECK_EQ(frag_rx_push(&rx, fragments[2].data(), (uint16_t)fragments[2].size(), 0, &u16_len), FRAG_RX_DUPLICATE);
+    CHECK_EQ(frag_rx_push(&rx, fragments[1].data(), (uint16_t)fragments[1].size(), 0, &u16_len), FRAG_RX_PENDING);
+    CHECK_EQ(frag_rx_get_received_count(&rx), 2);
+    CHECK_EQ(frag_rx_push(&rx, fragments[0].data(), (uint16_t)fragments[0].size(), 0, &u16_len), FRAG_RX_COMPLETE);
+    CHECK_EQ(u16_len, message.size());
+    CHECK(0 == memcmp(au8_storage, message.data(), message.size()));
+    // a retransmission of the completed message is not a new message
+    CHECK_EQ(frag_rx_push(&rx, fragments[1].data(), (uint16_t)fragments[1].size(), 10, &u16_len), FRAG_RX_DUPLICATE);
+    CHECK_EQ(frag_rx_get_completed_count(&rx), 1);
+
+    // a fragment of another size than the first one drops the message
+    fragments = split(message, 4, 2);
+    const bytes_t wrong_size = { 2, 0x01, 'C', 'D', 'X' };
+    CHECK_EQ(frag_rx_push(&rx, fragments[0].data(), (uint16_t)fragments[0].size(), 20, &u16_len), FRAG_RX_PENDING);
+    CHECK_EQ(frag_rx_push(&rx, wrong_size.data(), (uint16_t)wrong_size.size(), 20, &u16_len), FRAG_RX_ERROR);
+    CHECK_EQ(frag_rx_get_dropped_count(&rx), 1);
+    CHECK_EQ(frag_rx_get_received_count(&rx), 0);
+
+    // a fragment after the last one
+    const bytes_t after_last = { 3, 0x03, 'G', 'H' };
+    fragments = split(message, 4, 3);
+    CHECK_EQ(frag_rx_push(&rx, fragments[2].data(), (uint16_t)fragments[2].size(), 30, &u16_len), FRAG_RX_PENDING);
+    CHECK_EQ(frag_rx_push(&rx, after_last.data(), (uint16_t)after_last.size(), 30, &u16_len), FRAG_RX_ERROR);
+    CHECK_EQ(frag_rx_get_dropped_count(&rx), 2);
+
+    // a new message id drops the partial message
+    fragments = split(message, 4, 4);
+    std::vector<bytes_t> next = split(message, 4, 5);
+    CHECK_EQ(frag_rx_push(&rx, fragments[0].data(), (uint16_t)fragments[0].size(), 40, &u16_len), FRAG_RX_PENDING);
+    CHECK_EQ(frag_rx_push(&rx, next[0].data(), (uint16_t)next[0].size(), 40, &u16_len), FRAG_RX_PENDING);
+    CHECK_EQ(frag_rx_get_dropped_count(&rx), 3);
+    CHECK_EQ(frag_rx_get_received_count(&rx), 1);
+
+    // nothing for the timeout drops it too
+    CHECK(!frag_rx_check_timeout(&rx, 40 + RX_TIMEOUT_MS - 1));
+    CHECK(frag_rx_check_timeout(&rx, 40 + RX_TIMEOUT_MS));
+    CHECK_EQ(frag_rx_get_dropped_count(&rx), 4);
+
+    // larger than the storage, and a fragment with no data
+    bytes_t big = random_bytes(sizeof(au8_storage) + 1);
+    fragments = split(big, 8, 6);
+    bool is_refused = false;
+    for (const bytes_t &fragment : fragments)
+    {
+        is_refused |= (FRAG_RX_ERROR == frag_rx_push(&rx, fragment.data(), (uint16_t)fragment.size(), 50, &u16_len));
+    }
+    CHECK(is_refused);
+    CHECK_EQ(frag_rx_push(&rx, fragments[0].data(), FRAG_HEADER_LEN, 50, &u16_len), FRAG_RX_ERROR);
+}
+
+/**
+ * @brief Random messages and MTUs, the fragments are shuffled, some are repeated and at times one is lost.
+ * Every complete message must match, every partial one must be dropped by the timeout.
+ */
+static void test_random_messages()
+{
+    frag_rx_t rx;
+    static uint8_t s_storage[MCM_FRAG_MAX_PAYLOAD_SIZE];
+    uint32_t u32_now_ms = 0;
+    uint32_t u32_complete = 0;
+    uint32_t u32_lost = 0;
+
+    REQUIRE(frag_rx_init(&rx, s_storage, sizeof(s_storage), RX_TIMEOUT_MS));
+    for (uint32_t u32_msg = 0; u32_msg < RANDOM_MESSAGES; u32_msg++)
+    {
+        bytes_t message = random_bytes(1 + s_rng() % MCM_FRAG_MAX_PAYLOAD_SIZE);
+        uint16_t u16_min_mtu = (uint16_t)(FRAG_HEADER_LEN + (message.size() + FRAG_MAX_FRAGMENTS - 1) / FRAG_MAX_FRAGMENTS);
+        uint16_t u16_mtu = (uint16_t)std::max<uint32_t>(u16_min_mtu, 3 + s_rng() % (LORAWAN_TX_MAX_PAYLOAD_SIZE - 2));
+        std::vector<bytes_t> fragments = split(message, u16_mtu, (uint8_t)u32_msg);
+        bool is_lost = (1 < fragments.size()) && (0 == s_rng() % 4);
+        uint32_t u32_completions = 0;
+
+        for (size_t i = fragments.size(); i-- > 0;)
+        {
+            if (0 == s_rng() % 8)
+            {
+                fragments.push_back(fragments[i]);
+            }
+        }
+        std::shuffle(fragments.begin(), fragments.end(), s_rng);
+        if (is_lost)
+        {
+            // every copy of one fragment
+            bytes_t lost = fragments[s_rng() % fragments.size()];
+            fragments.erase(std::remove(fragments.begin(), fragments.end(), lost), fragments.end());
+        }
+
+        for (const bytes_t &fragment : fragments)
+        {
+            uint16_t u16_len = 0;
+            u32_now_ms += 1 + s_rng() % 1000;
+            frag_rx_status_t status = frag_rx_push(&rx, fragment.data(), (uint16_t)fragment.size(), u32_now_ms, &u16_len);
+            CHECK(FRAG_RX_ERROR != status);
+            if (FRAG_RX_COMPLETE == status)
+            {
+                u32_completions++;
+                CHECK_EQ(u16_len, message.size());
+                CHECK(0 == memcmp(s_storage, message.data(), message.size()));
+            }
+        }
+
+        CHECK_EQ(u32_completions, is_lost ? 0 : 1);
+        if (is_lost)
+        {
+            CHECK(0 < frag_rx_get_received_count(&rx));
+            u32_now_ms += RX_TIMEOUT_MS;
+            CHECK(frag_rx_check_timeout(&rx, u32_now_ms));
+            u32_lost++;
+        }
+        u32_complete += u32_completions;
+    }
+    CHECK_EQ(frag_rx_get_completed_count(&rx), u32_complete);
+    CHECK_EQ(frag_rx_get_dropped_count(&rx), u32_lost);
+    CHECK_EQ(u32_complete + u32_lost, RANDOM_MESSAGES);
+}
+
+static void on_frag_rx(const uint8_t *data, uint16_t len, command_types_t protocol)
+{
+    s_frag_rx_message.assign(data, data + len);
+    s_frag_rx_protocol = protocol;
+}
+
+/**
+ * @brief 600 bytes at a lorawan MTU of 19, the second uplink is reported as not sent and sent again.
+ */
+static void test_mcm_fragmented_uplink()
+{
+    TestMcm t("join ok 200\n"
+              "txdone noack 100\n"
+              "txstatus noack notsent\n"
+              "mtu 19\n");
+    bytes_t message = random_bytes(600);
+    frag_rx_t rx;
+    uint8_t au8_storage[MCM_FRAG_MAX_PAYLOAD_SIZE];
+    uint8_t u8_sent = 0;
+    uint8_t u8_total = 0;
+    uint32_t u32_completions = 0;
+
+    REQUIRE(t.start());
+    REQUIRE(t.join_lorawan());
+    CHECK(MCM_STATUS::MCM_OK == t.mcm.send_fragmented_uplink(message.data(), (uint16_t)message.size(), MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF));
+    CHECK(MCM_STATUS::MCM_ERROR == t.mcm.send_fragmented_uplink(message.data(), (uint16_t)message.size(), MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF));
+    REQUIRE(t.run_until([&]() { return MCM_FRAG_TX_STATE::MCM_FRAG_TX_IN_PROGRESS != t.mcm.get_fragmented_uplink_state(NULL, NULL); }, 60000));
+
+    CHECK(MCM_FRAG_TX_STATE::MCM_FRAG_TX_DONE == t.mcm.get_fragmented_uplink_state(&u8_sent, &u8_total));
+    CHECK_EQ(u8_total, frag_get_count((uint16_t)message.size(), 19));
+    CHECK_EQ(u8_sent, u8_total);
+    for (uint8_t i = 0; i < u8_total; i++)
+    {
+        CHECK(MCM_TX_STATUS::MCM_TX_WO_ACK == t.mcm.get_fragment_tx_status(i));
+    }
+
+    // the cloud side, the fragment reported as not sent is received twice
+    const std::vector<mcm_emu_uplink_t> &uplinks = t.emulator.get_uplinks();
+    CHECK_EQ(uplinks.size(), u8_total + 1);
+    REQUIRE(frag_rx_init(&rx, au8_storage, sizeof(au8_storage), RX_TIMEOUT_MS));
+    for (const mcm_emu_uplink_t &uplink : uplinks)
+    {
+        uint16_t u16_len = 0;
+        CHECK_EQ(uplink.u8_port, MCM_FRAG_LORAWAN_PORT);
+        CHECK(uplink.data.size() <= 19);
+        if (FRAG_RX_COMPLETE == frag_rx_push(&rx, uplink.data.data(), (uint16_t)uplink.data.size(), 0, &u16_len))
+        {
+            u32_completions++;
+            CHECK(bytes_t(au8_storage, au8_storage + u16_len) == message);
+        }
+    }
+    CHECK_EQ(u32_completions, 1);
+    CHECK(bytes_t(uplinks[1].data) == bytes_t(uplinks[2].data));
+}
+
+/**
+ * @brief Fragments of a downlink on the fragment port, last one first, reach the callback as one message.
+ */
+static void test_mcm_fragmented_downlink()
+{
+    TestMcm t("join ok 200\n"
+              "txdone noack 100\n");
+    bytes_t message = random_bytes(300);
+    std::vector<bytes_t> fragments = split(message, 51, 9);
+
+    REQUIRE(t.start());
+    REQUIRE(t.join_lorawan());
+    s_frag_rx_message.clear();
+    t.mcm.set_on_fragmented_rx_callback(on_frag_rx);
+
+    std::reverse(fragments.begin(), fragments.end());
+    uint64_t u64_at_us = host_hal_get_time_us();
+    for (const bytes_t &fragment : fragments)
+    {
+        u64_at_us += 2000000;
+        t.emulator.schedule_downlink(u64_at_us, COMMAND_TYPE_LORAWAN, MCM_FRAG_LORAWAN_PORT, -70, 5, fragment);
+    }
+    // an ordinary downlink in between still goes to the application
+    t.emulator.schedule_downlink(u64_at_us - 1000000, COMMAND_TYPE_LORAWAN, 10, -70, 5, { 0x42 });
+
+    REQUIRE(t.run_until([]() { return !s_frag_rx_message.empty(); }, 60000));
+    CHECK(s_frag_rx_message == message);
+    CHECK_EQ(s_frag_rx_protocol, COMMAND_TYPE_LORAWAN);
+    CHECK_EQ(t.mcm.get_downlink_count(), 1);
+    const mcm_downlink_t *p_downlink = t.mcm.peek_downlink(0);
+    REQUIRE(NULL != p_downlink);
+    CHECK_EQ(p_downlink->seq_port, 10);
+}
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTIONS
+ **********************************************************************************************************/
+int main()
+{
+    test_layout();
+    test_reassembly_errors();
+    test_random_messages();
+    test_mcm_fragmented_uplink();
+    test_mcm_fragmented_downlink();
+    return test_result("test_frag");
+}
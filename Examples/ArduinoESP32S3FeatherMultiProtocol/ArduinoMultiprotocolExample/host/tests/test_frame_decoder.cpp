@@ -0,0 +1,242 @@
+/**
+ * @file test_frame_decoder.cpp
+ * @author OXIT embedded firmware team
+ * @brief Tests of the stream frame decoder, random UART chunkings and resynchronization.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include "test_common.h"
+#include "frame_parse.h"
+#include "checksum.h"
+#include <stdint.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+#define CHUNKING_RUNS           (5000)
+#define MAX_CHUNK_LEN           (64)
+#define RESPONSE_HEADER_LEN     (6)
+#define TRAILING_NOTIFICATIONS  ((MAX_SERIAL_RECEIVE_PAYLOAD_SIZE / MIN_RX_PAYLOAD_LEN) + 1)
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+typedef std::vector<uint8_t> frame_t;
+
+/**********************************************************************************************************
+ * STATIC VARIABLES
+ **********************************************************************************************************/
+static std::mt19937 s_rng(20261017);
+
+/**********************************************************************************************************
+ * STATIC FUNCTIONS
+ **********************************************************************************************************/
+
+static void on_frame(uint8_t *frame, uint16_t len, void *user_context)
+{
+    static_cast<std::vector<frame_t> *>(user_context)->push_back(frame_t(frame, frame + len));
+}
+
+static frame_t make_notification(uint8_t u8_pending)
+{
+    frame_t frame = {MROVER_RC_NOTIFY_EVENTS, 0x00, 0x01, u8_pending, 0};
+    frame[4] = checksum_xor8(0, frame.data(), 4);
+    return frame;
+}
+
+static frame_t make_response(uint16_t u16_command_code, uint16_t u16_payload_len)
+{
+    frame_t frame = {MROVER_RC_OK, COMMAND_TYPE_GENERAL, (uint8_t)(u16_command_code >> 8), (uint8_t)u16_command_code,
+                     (uint8_t)(u16_payload_len >> 8), (uint8_t)u16_payload_len};
+    for (uint16_t i = 0; i < u16_payload_len; i++)
+    {
+        frame.push_back((uint8_t)s_rng());
+    }
+    frame.push_back(checksum_xor8(0, frame.data(), frame.size()));
+    return frame;
+}
+
+static void append(frame_t &stream, const frame_t &bytes)
+{
+    stream.insert(stream.end(), bytes.begin(), bytes.end());
+}
+
+/**
+ * @brief Feeds the stream in chunks of random length, as the UART driver hands them over.
+ */
+static std::vector<frame_t> feed_chunked(fp_decoder_t *p_decoder, const frame_t &stream)
+{
+    std::vector<frame_t> frames;
+    size_t offset = 0;
+    while (offset < stream.size())
+    {
+        size_t chunk = 1 + s_rng() % MAX_CHUNK_LEN;
+        if (chunk > stream.size() - offset)
+        {
+            chunk = stream.size() - offset;
+        }
+        fp_decoder_feed(p_decoder, &stream[offset], (uint16_t)chunk, on_frame, &frames);
+        offset += chunk;
+    }
+    return frames;
+}
+
+/**
+ * @brief Valid frames back to back, with noise and a corrupted frame in between, split at random points.
+ */
+static void test_random_chunking()
+{
+    for (int run = 0; run < CHUNKING_RUNS; run++)
+    {
+        std::vector<frame_t> expected;
+        frame_t stream;
+
+        expected.push_back(make_notification(3));
+        expected.push_back(make_response(MROVER_CC_GET_EVENT, s_rng() % 40));
+        for (const frame_t &frame : expected)
+        {
+            append(stream, frame);
+        }
+
+        if (0 == run % 3)
+        {
+            append(stream, {0xAA, 0x55});
+        }
+        if (0 == run % 5)
+        {
+            frame_t corrupted = make_response(MROVER_CC_GET_VERSION, 10);
+            corrupted[8] ^= 0xFF;
+            append(stream, corrupted);
+        }
+
+        expected.push_back(make_notification(1));
+        append(stream, expected.back());
+        expected.push_back(make_response(MROVER_CC_GET_LAST_DL_STATS, s_rng() % 300));
+        append(stream, expected.back());
+
+        // bytes of a dropped frame can pass as a header claiming a long payload, the frames after it
+        // come out once that many bytes have been received and the false frame fails its CRC
+        for (int i = 0; i < TRAILING_NOTIFICATIONS; i++)
+        {
+            expected.push_back(make_notification(1));
+            append(stream, expected.back());
+        }
+
+        fp_decoder_t decoder;
+        fp_decoder_init(&decoder);
+        std::vector<frame_t> frames = feed_chunked(&decoder, stream);
+
+        CHECK(expected == frames);
+        CHECK_EQ(decoder.u16_index, 0);
+        if (expected != frames)
+        {
+            fprintf(stderr, "run %d: %zu frames decoded, %zu expected\n", run, frames.size(), expected.size());
+            break;
+        }
+    }
+}
+
+/**
+ * @brief A header claiming more bytes than follow must not hide the frames after it.
+ */
+static void test_resync_after_truncated_response()
+{
+    frame_t stream = {MROVER_RC_OK, COMMAND_TYPE_GENERAL, 0x00, MROVER_CC_GET_VERSION, 0x00, 0x10};
+    frame_t notification = make_notification(2);
+    append(stream, notification);
+    while (stream.size() < RESPONSE_HEADER_LEN + 16 + 1)
+    {
+        stream.push_back(0x55);
+    }
+
+    fp_decoder_t decoder;
+    fp_decoder_init(&decoder);
+    std::vector<frame_t> frames;
+    fp_decoder_feed(&decoder, stream.data(), (uint16_t)stream.size(), on_frame, &frames);
+
+    REQUIRE(1 == frames.size());
+    CHECK(notification == frames[0]);
+    CHECK_EQ(decoder.u32_crc_errors, 1);
+    CHECK_EQ(decoder.u16_index, 0);
+
+    // the decoder is back in sync for the next frame
+    frame_t response = make_response(MROVER_CC_GET_EVENT, 3);
+    fp_decoder_feed(&decoder, response.data(), (uint16_t)response.size(), on_frame, &frames);
+    REQUIRE(2 == frames.size());
+    CHECK(response == frames[1]);
+}
+
+/**
+ * @brief The frame after a resync arrives in the same chunk as the bytes that follow it.
+ */
+static void test_resync_keeps_following_frame()
+{
+    frame_t stream = {MROVER_RC_OK, COMMAND_TYPE_GENERAL, 0x00, MROVER_CC_GET_VERSION, 0x00, 0x0C};
+    frame_t notification = make_notification(1);
+    frame_t response = make_response(MROVER_CC_GET_NEXT_UPLINK_MTU, 3);
+    append(stream, notification);
+    append(stream, response);
+
+    fp_decoder_t decoder;
+    fp_decoder_init(&decoder);
+    std::vector<frame_t> frames;
+    fp_decoder_feed(&decoder, stream.data(), (uint16_t)stream.size(), on_frame, &frames);
+
+    REQUIRE(2 == frames.size());
+    CHECK(notification == frames[0]);
+    CHECK(response == frames[1]);
+    CHECK_EQ(decoder.u16_index, 0);
+}
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTIONS
+ **********************************************************************************************************/
+
+int main()
+{
+    test_random_chunking();
+    test_resync_after_truncated_response();
+    test_resync_keeps_following_frame();
+    return test_result("test_frame_decoder");
+}
@@ -0,0 +1,291 @@
+/**
+ * @file test_fw_resume.cpp
+ * @author OXIT embedded firmware team
+ * @brief Interrupted YModem firmware transfers resumed from the NVS checkpoint, in the same boot and after a reboot.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include "test_mcm.h"
+#include "checksum.h"
+#include "oxit_nvs.h"
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+#define TEST_IMAGE_SIZE             (100 * 1024 + 300)  // last block partly padded
+#define TEST_TRANSFER_TIMEOUT_MS    (300000)
+#define TEST_FUOTA_FILE_NAME        "/fota.bin"         // staging file of ymodem.cpp
+
+/**
+ * @brief Block sent corrupted until the receiver gives up, the blocks before it are written
+ */
+#define TEST_BROKEN_BLOCK           (80)
+
+/**********************************************************************************************************
+ * STATIC FUNCTIONS
+ **********************************************************************************************************/
+static std::vector<uint8_t> make_image(size_t size, uint8_t u8_seed = 0)
+{
+    std::vector<uint8_t> image(size);
+
+    for (size_t i = 0; i < image.size(); i++)
+    {
+        image[i] = (uint8_t)((i * 7) ^ (i >> 8) ^ u8_seed);
+    }
+    image[0] = ESP_IMAGE_HEADER_MAGIC;
+    return image;
+}
+
+/**
+ * @brief Script that breaks the transfer at block u32_block with YMODEM_MAX_CRC_ERRORS bad packets in a row
+ */
+static std::string break_at(uint32_t u32_block)
+{
+    return "corrupt " + std::to_string(u32_block) + " " + std::to_string(YMODEM_MAX_CRC_ERRORS) + "\n";
+}
+
+static void boot(TestMcm &t, const std::vector<uint8_t> &image, bool b_stream_to_ota)
+{
+    t.emulator.config().file = image;
+    REQUIRE(t.start());
+    t.mcm.ymodem.setStreamToOta(b_stream_to_ota);
+}
+
+/**
+ * @brief Runs one transfer until the device reboots into the image or the receiver stops it.
+ *
+ * @return true if the image was installed
+ */
+static bool transfer(TestMcm &t, ver_type_1_t version = { 1, 2, 3 })
+{
+    uint32_t u32_restarts = host_hal_get_restart_count();
+
+    REQUIRE(MCM_STATUS::MCM_OK == t.blocking.start_file_transfer(version));
+    REQUIRE(t.run_until(
+        [&]()
+        {
+            return (u32_restarts < host_hal_get_restart_count()) ||
+                   ((YMODEM_IDLE == t.mcm.ymodem.getState()) && t.emulator.get_stats().b_ymodem_cancelled);
+        },
+        TEST_TRANSFER_TIMEOUT_MS));
+    t.run_for(100);
+    return u32_restarts < host_hal_get_restart_count();
+}
+
+static uint32_t get_committed()
+{
+    nvs_fw_checkpoint_t checkpoint;
+
+    return nvs_storage_get_fw_checkpoint(&checkpoint) ? checkpoint.u32_committed : 0;
+}
+
+static uint64_t get_flash_written(bool b_stream_to_ota)
+{
+    return b_stream_to_ota ? Update.host_get_stats().u64_bytes_written : host_fs_get_stats().u64_bytes_written;
+}
+
+/**
+ * @brief Repeated crc errors keep the blocks written so far, the retry writes only the rest.
+ */
+static void test_crc_errors_resume(bool b_stream_to_ota)
+{
+    TestMcm t(break_at(TEST_BROKEN_BLOCK).c_str());
+    std::vector<uint8_t> image = make_image(TEST_IMAGE_SIZE);
+    nvs_fw_checkpoint_t checkpoint;
+
+    boot(t, image, b_stream_to_ota);
+    CHECK(!transfer(t));
+    REQUIRE(nvs_storage_get_fw_checkpoint(&checkpoint));
+    CHECK_EQ(checkpoint.u32_committed, (TEST_BROKEN_BLOCK - 1) * 1024);
+    CHECK_EQ(checkpoint.u32_image_size, TEST_IMAGE_SIZE);
+    CHECK_EQ(checkpoint.u32_tag, 0x010203);
+    CHECK_EQ(checkpoint.u16_crc, checksum_crc16_ccitt(CHECKSUM_CRC16_XMODEM_INIT, image.data(), checkpoint.u32_committed));
+    CHECK_EQ(get_flash_written(b_stream_to_ota), checkpoint.u32_committed);
+    if (b_stream_to_ota)
+    {
+        CHECK(Update.isRunning());
+    }
+    else
+    {
+        File file = SPIFFS.open(TEST_FUOTA_FILE_NAME, "r");
+        CHECK_EQ(file.size(), checkpoint.u32_committed);
+        file.close();
+    }
+
+    uint32_t u32_nvs_writes = host_nvs_get_stats().u32_writes;
+    CHECK(transfer(t));
+    CHECK(image == Update.host_get_image());
+    // every byte reached the flash once, the rest is shorter than a checkpoint interval
+    CHECK_EQ(get_flash_written(b_stream_to_ota), image.size());
+    CHECK_EQ(host_nvs_get_stats().u32_writes - u32_nvs_writes, 0);
+    CHECK_EQ(Update.host_get_stats().u32_begins, 1);
+    CHECK_EQ(get_committed(), 0);
+}
+
+/**
+ * @brief The link goes silent, the device reboots and asks for the same image again. The SPIFFS file
+ * survives the reboot, the OTA session does not.
+ */
+static void test_link_lost_reboot(bool b_stream_to_ota)
+{
+    std::vector<uint8_t> image = make_image(TEST_IMAGE_SIZE);
+    uint32_t u32_committed = 0;
+    uint64_t u64_fs_written = 0;
+
+    {
+        TestMcm t;
+
+        boot(t, image, b_stream_to_ota);
+        REQUIRE(MCM_STATUS::MCM_OK == t.mcm.start_file_transfer({ 1, 2, 3 }));
+        REQUIRE(t.run_until([&]() { return TEST_BROKEN_BLOCK <= t.emulator.get_stats().u32_ymodem_blocks; }, TEST_TRANSFER_TIMEOUT_MS));
+        t.wire.detach();
+        CHECK(t.run_until([&]() { return YMODEM_IDLE == t.mcm.ymodem.getState(); }, YMODEM_TIMEOUT + YMODEM_BLOCK_TIMEOUT + 2000));
+        u32_committed = get_committed();
+        u64_fs_written = host_fs_get_stats().u64_bytes_written;
+        CHECK((TEST_BROKEN_BLOCK - 2) * 1024 <= u32_committed);
+    }
+
+    TestMcm t("", true);
+    boot(t, image, b_stream_to_ota);
+    CHECK(transfer(t));
+    CHECK(image == Update.host_get_image());
+    if (b_stream_to_ota)
+    {
+        // streamed again from the first block
+        CHECK_EQ(Update.host_get_stats().u64_bytes_written, image.size());
+    }
+    else
+    {
+        CHECK_EQ(host_fs_get_stats().u64_bytes_written - u64_fs_written, image.size() - u32_committed);
+    }
+    CHECK_EQ(get_committed(), 0);
+}
+
+/**
+ * @brief Another image under the same version fails the checkpoint crc and is not mixed with the
+ * partial one, the transfer after it starts over.
+ */
+static void test_changed_image(bool b_stream_to_ota)
+{
+    TestMcm t(break_at(TEST_BROKEN_BLOCK).c_str());
+    std::vector<uint8_t> image = make_image(TEST_IMAGE_SIZE);
+    std::vector<uint8_t> changed = make_image(TEST_IMAGE_SIZE, 0x5A);
+
+    boot(t, image, b_stream_to_ota);
+    CHECK(!transfer(t));
+    CHECK(0 < get_committed());
+
+    t.emulator.config().file = changed;
+    CHECK(!transfer(t));
+    CHECK_EQ(get_committed(), 0);
+    CHECK(!Update.isRunning());
+    CHECK(!SPIFFS.exists(TEST_FUOTA_FILE_NAME));
+
+    CHECK(transfer(t));
+    CHECK(changed == Update.host_get_image());
+}
+
+/**
+ * @brief The checkpoint of another version is dropped, the image is written from the start.
+ */
+static void test_other_version()
+{
+    TestMcm t(break_at(TEST_BROKEN_BLOCK).c_str());
+    std::vector<uint8_t> image = make_image(TEST_IMAGE_SIZE);
+
+    boot(t, image, false);
+    CHECK(!transfer(t));
+    uint64_t u64_fs_written = host_fs_get_stats().u64_bytes_written;
+
+    CHECK(transfer(t, { 1, 2, 4 }));
+    CHECK(image == Update.host_get_image());
+    CHECK_EQ(host_fs_get_stats().u64_bytes_written - u64_fs_written, image.size());
+}
+
+static void test_two_interruptions()
+{
+    TestMcm t((break_at(30) + break_at(TEST_BROKEN_BLOCK)).c_str());
+    std::vector<uint8_t> image = make_image(TEST_IMAGE_SIZE);
+
+    boot(t, image, false);
+    CHECK(!transfer(t));
+    CHECK_EQ(get_committed(), 29 * 1024);
+    CHECK(!transfer(t));
+    CHECK_EQ(get_committed(), (TEST_BROKEN_BLOCK - 1) * 1024);
+    CHECK(transfer(t));
+    CHECK(image == Update.host_get_image());
+    CHECK_EQ(host_fs_get_stats().u64_bytes_written, image.size());
+}
+
+/**
+ * @brief Broken again while the resent prefix is verified, the checkpoint is not moved back.
+ */
+static void test_interrupted_while_verifying()
+{
+    TestMcm t(break_at(TEST_BROKEN_BLOCK).c_str());
+    std::vector<uint8_t> image = make_image(TEST_IMAGE_SIZE);
+
+    boot(t, image, false);
+    CHECK(!transfer(t));
+    t.emulator.corrupt_ymodem_block(50, YMODEM_MAX_CRC_ERRORS);
+    CHECK(!transfer(t));
+    CHECK_EQ(get_committed(), (TEST_BROKEN_BLOCK - 1) * 1024);
+    CHECK(transfer(t));
+    CHECK(image == Update.host_get_image());
+    CHECK_EQ(host_fs_get_stats().u64_bytes_written, image.size());
+}
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTIONS
+ **********************************************************************************************************/
+int main()
+{
+    test_crc_errors_resume(true);
+    test_crc_errors_resume(false);
+    test_link_lost_reboot(true);
+    test_link_lost_reboot(false);
+    test_changed_image(true);
+    test_changed_image(false);
+    test_other_version();
+    test_two_interruptions();
+    test_interrupted_while_verifying();
+    return test_result("test_fw_resume");
+}
@@ -0,0 +1,175 @@
+/**
+ * @file test_journal_file.h
+ * @author OXIT embedded firmware team
+ * @brief Uplink journal on the SPIFFS shim, bound as the sketch does, with a reset cutting an append short.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+#ifndef __TEST_JOURNAL_FILE_H__
+#define __TEST_JOURNAL_FILE_H__
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include "ArduinoMultiprotocolExample.h"
+#include "host_fs.h"
+#include "uplink_journal.h"
+#include <vector>
+
+/**********************************************************************************************************
+ * TYPEDEFS AND CLASSES
+ **********************************************************************************************************/
+
+/**
+ * @brief Storage of the journal in UPLINK_JOURNAL_FILE, the callbacks of ArduinoMultiprotocolExample.ino.
+ *
+ * A reset is armed with crash_after(): the append crossing that many bytes writes up to there and fails,
+ * every later call fails until reboot(), which drops the open handle as a reset of the board does.
+ */
+class TestJournalFile
+{
+    public:
+    uplink_journal_storage_t storage;
+    std::vector<std::pair<uint32_t, uint16_t>> appends;     // offset and length of every write to the file
+    bool b_crashed = false;
+
+    TestJournalFile() : storage{ read, append, erase, size, this }
+    {
+    }
+
+    ~TestJournalFile()
+    {
+        read_file.close();
+    }
+
+    void crash_after(int64_t i64_bytes)
+    {
+        i64_crash_after = i64_bytes;
+    }
+
+    void reboot()
+    {
+        read_file.close();
+        b_crashed = false;
+        i64_crash_after = -1;
+    }
+
+    private:
+    File read_file;                                         // kept open between the reads, as in the sketch
+    int64_t i64_crash_after = -1;
+
+    static uint16_t read(void *p_context, uint32_t u32_offset, uint8_t *p_buf, uint16_t u16_len)
+    {
+        TestJournalFile *p_file = (TestJournalFile *)p_context;
+        uint16_t u16_read = 0;
+
+        if (p_file->b_crashed)
+        {
+            return 0;
+        }
+        if (!p_file->read_file)
+        {
+            p_file->read_file = SPIFFS.open(UPLINK_JOURNAL_FILE, FILE_READ);
+        }
+        if (p_file->read_file && p_file->read_file.seek(u32_offset))
+        {
+            u16_read = (uint16_t)p_file->read_file.read(p_buf, u16_len);
+        }
+        return u16_read;
+    }
+
+    static bool append(void *p_context, const uint8_t *p_buf, uint16_t u16_len)
+    {
+        TestJournalFile *p_file = (TestJournalFile *)p_context;
+        uint16_t u16_write = u16_len;
+
+        if (p_file->b_crashed)
+        {
+            return false;
+        }
+        p_file->read_file.close();
+        if ((0 <= p_file->i64_crash_after) && (p_file->i64_crash_after < u16_len))
+        {
+            u16_write = (uint16_t)p_file->i64_crash_after;
+            p_file->b_crashed = true;
+        }
+        if (0 <= p_file->i64_crash_after)
+        {
+            p_file->i64_crash_after -= u16_write;
+        }
+
+        File file = SPIFFS.open(UPLINK_JOURNAL_FILE, FILE_APPEND);
+        if (!file)
+        {
+            return false;
+        }
+        p_file->appends.push_back({ (uint32_t)file.size(), u16_write });
+        size_t written = file.write(p_buf, u16_write);
+        file.flush();
+        file.close();
+        return !p_file->b_crashed && (written == u16_len);
+    }
+
+    static bool erase(void *p_context)
+    {
+        TestJournalFile *p_file = (TestJournalFile *)p_context;
+
+        if (p_file->b_crashed)
+        {
+            return false;
+        }
+        p_file->read_file.close();
+        return (false == SPIFFS.exists(UPLINK_JOURNAL_FILE)) || SPIFFS.remove(UPLINK_JOURNAL_FILE);
+    }
+
+    static uint32_t size(void *p_context)
+    {
+        (void)p_context;
+        uint32_t u32_size = 0;
+
+        if (SPIFFS.exists(UPLINK_JOURNAL_FILE))
+        {
+            File file = SPIFFS.open(UPLINK_JOURNAL_FILE, FILE_READ);
+            u32_size = (uint32_t)file.size();
+            file.close();
+        }
+        return u32_size;
+    }
+};
+
+#endif // __TEST_JOURNAL_FILE_H__
@@ -0,0 +1,266 @@
+/**
+ * @file test_link_select.cpp
+ * @author OXIT embedded firmware team
+ * @brief Delivery estimate, failover and hysteresis of the link selection, and the failover callback of MCM on a failing join.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include "test_mcm.h"
+#include "link_select.h"
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+#define LORAWAN                 ((uint8_t)ConnectionMode::CONNECTION_MODE_LORAWAN)
+#define FSK                     ((uint8_t)ConnectionMode::CONNECTION_MODE_SIDEWALK_FSK)
+#define CSS                     ((uint8_t)ConnectionMode::CONNECTION_MODE_SIDEWALK_CSS)
+#define MINUTE_MS               (60000UL)
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+
+/**********************************************************************************************************
+ * STATIC VARIABLES
+ **********************************************************************************************************/
+// thresholds of MCM, see s_link_select_config
+static const link_select_config_t s_config = { 6, 60, 50, 70, 25, 50, 30 * MINUTE_MS, 5 * MINUTE_MS, 30 * MINUTE_MS };
+static const link_select_profile_t s_lorawan = { true, 30, -10 };
+static const link_select_profile_t s_fsk = { true, 8, 3 };
+static const link_select_profile_t s_css = { false, 80, -10 };
+
+static ConnectionMode s_failover_mode = ConnectionMode::CONNECTION_MODE_NC;
+static uint32_t s_failover_calls = 0;
+
+/**********************************************************************************************************
+ * STATIC FUNCTIONS
+ **********************************************************************************************************/
+static void init(link_select_t *p_select, uint8_t u8_current)
+{
+    link_select_init(p_select, &s_config, u8_current, 0);
+    CHECK(link_select_set_profile(p_select, LORAWAN, &s_lorawan));
+    CHECK(link_select_set_profile(p_select, FSK, &s_fsk));
+    CHECK(link_select_set_profile(p_select, CSS, &s_css));
+    CHECK(!link_select_set_profile(p_select, LINK_SELECT_MAX_LINKS, &s_css));
+}
+
+static void add_tx(link_select_t *p_select, uint8_t u8_link, uint8_t u8_count, bool b_delivered, uint32_t u32_now_ms)
+{
+    for (uint8_t i = 0; i < u8_count; i++)
+    {
+        link_select_on_tx(p_select, u8_link, b_delivered, u32_now_ms);
+    }
+}
+
+static void on_link_failover(ConnectionMode mode)
+{
+    s_failover_mode = mode;
+    s_failover_calls++;
+}
+
+static void test_delivery()
+{
+    link_select_t select;
+    int8_t i8_rssi = 0;
+    int8_t i8_snr = 0;
+
+    init(&select, LORAWAN);
+
+    // the missing outcomes count as the prior
+    CHECK_EQ(link_select_get_delivery_pct(&select, FSK, 0), 60);
+    add_tx(&select, FSK, 3, true, 0);
+    CHECK_EQ(link_select_get_delivery_pct(&select, FSK, 0), (300 + 3 * 60) / 6);
+    add_tx(&select, FSK, 3, false, 0);
+    CHECK_EQ(link_select_get_delivery_pct(&select, FSK, 0), 50);
+
+    // only the last LINK_SELECT_TX_WINDOW outcomes count
+    add_tx(&select, FSK, LINK_SELECT_TX_WINDOW - 1, true, 0);
+    CHECK_EQ(link_select_get_delivery_pct(&select, FSK, 0), 100 * (LINK_SELECT_TX_WINDOW - 1) / LINK_SELECT_TX_WINDOW);
+    add_tx(&select, FSK, 1, true, 0);
+    CHECK_EQ(link_select_get_delivery_pct(&select, FSK, 0), 100);
+
+    // a low snr over the last downlinks halves the estimate, from the third downlink on
+    CHECK(!link_select_get_rf(&select, FSK, &i8_rssi, &i8_snr));
+    link_select_on_downlink(&select, FSK, -100, 0, 0);
+    link_select_on_downlink(&select, FSK, -110, 2, 0);
+    CHECK_EQ(link_select_get_delivery_pct(&select, FSK, 0), 100);
+    link_select_on_downlink(&select, FSK, -120, 1, 0);
+    CHECK(link_select_get_rf(&select, FSK, &i8_rssi, &i8_snr));
+    CHECK_EQ(i8_rssi, -110);
+    CHECK_EQ(i8_snr, 1);
+    CHECK_EQ(link_select_get_delivery_pct(&select, FSK, 0), 50);
+
+    // statistics not updated for u32_stale_ms are forgotten
+    CHECK_EQ(link_select_get_delivery_pct(&select, FSK, s_config.u32_stale_ms - 1), 50);
+    CHECK_EQ(link_select_get_delivery_pct(&select, FSK, s_config.u32_stale_ms), 60);
+    CHECK(!link_select_get_rf(&select, FSK, &i8_rssi, &i8_snr));
+}
+
+/**
+ * @brief A failed link is left at once, for the best other candidate that has not failed
+ */
+static void test_failover()
+{
+    link_select_t select;
+
+    init(&select, LORAWAN);
+    add_tx(&select, LORAWAN, 6, true, 0);
+    CHECK_EQ(link_select_evaluate(&select, true, 1000), LORAWAN);
+
+    add_tx(&select, LORAWAN, 10, false, 2000);
+    CHECK_EQ(link_select_get_delivery_pct(&select, LORAWAN, 2000), 37);
+    CHECK_EQ(link_select_evaluate(&select, true, 2000), FSK);
+
+    // the css link scores lower but is not a candidate either way
+    link_select_set_candidate(&select, FSK, false);
+    CHECK_EQ(link_select_evaluate(&select, true, 2000), LORAWAN);
+    link_select_set_candidate(&select, CSS, true);
+    CHECK_EQ(link_select_evaluate(&select, true, 2000), CSS);
+
+    // no other candidate left, the failed link is kept
+    link_select_set_candidate(&select, CSS, false);
+    CHECK_EQ(link_select_evaluate(&select, true, 2000), LORAWAN);
+    CHECK_EQ(link_select_get_switch_count(&select), 0);
+
+    // a candidate reaching u8_min_delivery_pct comes before the ones below it, whatever their score
+    link_select_set_candidate(&select, FSK, true);
+    link_select_set_candidate(&select, CSS, true);
+    add_tx(&select, FSK, 6, true, 2000);
+    add_tx(&select, FSK, 3, false, 2000);
+    add_tx(&select, CSS, 6, true, 2000);
+    CHECK_EQ(link_select_get_delivery_pct(&select, FSK, 2000), 66);
+    CHECK_EQ(link_select_evaluate(&select, true, 2000), CSS);
+
+    link_select_set_current(&select, FSK, 3000);
+    link_select_set_current(&select, FSK, 3000);
+    CHECK_EQ(link_select_get_switch_count(&select), 1);
+}
+
+/**
+ * @brief Two join failures in a row, or no join within u32_join_timeout_ms, fail a link
+ */
+static void test_join()
+{
+    link_select_t select;
+
+    init(&select, LORAWAN);
+    add_tx(&select, LORAWAN, 6, true, 0);
+    link_select_on_join_failure(&select, LORAWAN, 0);
+    CHECK_EQ(link_select_evaluate(&select, false, 0), LORAWAN);
+    link_select_on_join_failure(&select, LORAWAN, 0);
+    CHECK_EQ(link_select_evaluate(&select, false, 0), FSK);
+
+    // a join clears the failures
+    CHECK_EQ(link_select_evaluate(&select, true, 0), LORAWAN);
+
+    init(&select, LORAWAN);
+    add_tx(&select, LORAWAN, 6, true, 0);
+    CHECK_EQ(link_select_evaluate(&select, false, s_config.u32_join_timeout_ms - 1), LORAWAN);
+    CHECK_EQ(link_select_evaluate(&select, false, s_config.u32_join_timeout_ms), FSK);
+}
+
+/**
+ * @brief A working link is kept for u32_min_dwell_ms, then replaced only by a clearly better one
+ */
+static void test_hysteresis()
+{
+    link_select_t select;
+    link_select_profile_t lorawan_cheap = s_lorawan;
+    const uint32_t u32_dwell_ms = s_config.u32_min_dwell_ms;
+
+    init(&select, LORAWAN);
+    add_tx(&select, LORAWAN, LINK_SELECT_TX_WINDOW, true, u32_dwell_ms - MINUTE_MS);
+    add_tx(&select, FSK, LINK_SELECT_TX_WINDOW, true, u32_dwell_ms - MINUTE_MS);
+    CHECK_EQ(link_select_evaluate(&select, true, u32_dwell_ms - 1), LORAWAN);
+    CHECK_EQ(link_select_evaluate(&select, true, u32_dwell_ms), FSK);
+
+    // within the margin, the current link stays
+    lorawan_cheap.u16_energy_mj = 10;
+    CHECK(link_select_set_profile(&select, LORAWAN, &lorawan_cheap));
+    CHECK_EQ(link_select_evaluate(&select, true, u32_dwell_ms), LORAWAN);
+
+    // a better link below u8_min_delivery_pct is not taken for its score
+    CHECK(link_select_set_profile(&select, LORAWAN, &s_lorawan));
+    add_tx(&select, FSK, 5, false, u32_dwell_ms);
+    CHECK_EQ(link_select_get_delivery_pct(&select, FSK, u32_dwell_ms), 68);
+    CHECK_EQ(link_select_evaluate(&select, true, u32_dwell_ms), LORAWAN);
+}
+
+/**
+ * @brief MCM reports a failover once a lorawan join keeps failing, the sketch makes the switch.
+ */
+static void test_mcm_failover()
+{
+    TestMcm t("join fail 1 200\n");
+    const ConnectionMode candidates[] = { ConnectionMode::CONNECTION_MODE_LORAWAN, ConnectionMode::CONNECTION_MODE_SIDEWALK_FSK };
+
+    REQUIRE(t.start());
+    CHECK(MCM_STATUS::MCM_PARAM_ERROR == t.mcm.set_link_failover(true, NULL, 1));
+    CHECK(MCM_STATUS::MCM_OK == t.mcm.set_link_failover(true, candidates, 2));
+    t.mcm.set_on_link_failover_callback(on_link_failover);
+
+    CHECK(!t.join_lorawan());
+    CHECK(t.mcm.get_link_delivery(ConnectionMode::CONNECTION_MODE_LORAWAN) < 60);
+    REQUIRE(t.run_until([]() { return 0 < s_failover_calls; }, s_config.u32_join_timeout_ms + 2 * MCM_LINK_SELECT_PERIOD_MS));
+    CHECK(ConnectionMode::CONNECTION_MODE_SIDEWALK_FSK == s_failover_mode);
+    CHECK_EQ(t.mcm.get_link_delivery(ConnectionMode::CONNECTION_MODE_SIDEWALK_FSK), 60);
+
+    // asked again every period until the mode changes, never while the failover is off
+    t.run_for(MCM_LINK_SELECT_PERIOD_MS);
+    CHECK(2 <= s_failover_calls);
+    CHECK(MCM_STATUS::MCM_OK == t.mcm.set_link_failover(false, candidates, 2));
+    uint32_t u32_calls = s_failover_calls;
+    t.run_for(2 * MCM_LINK_SELECT_PERIOD_MS);
+    CHECK_EQ(s_failover_calls, u32_calls);
+}
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTIONS
+ **********************************************************************************************************/
+int main()
+{
+    test_delivery();
+    test_failover();
+    test_join();
+    test_hysteresis();
+    test_mcm_failover();
+    return test_result("test_link_select");
+}
@@ -0,0 +1,164 @@
+/**
+ * @file test_mcm.h
+ * @author OXIT embedded firmware team
+ * @brief MCM class on the emulated modem in virtual time, shared by the host tests of the library.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+#ifndef __TEST_MCM_H__
+#define __TEST_MCM_H__
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include "host_fs.h"
+#include "host_hal.h"
+#include "mcm_emulator_wire.h"
+#include "mcm_rover.h"
+#include "mcm_rover_blocking.h"
+#include "nvs_flash.h"
+#include "test_common.h"
+#include <Update.h>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+#define TEST_MCM_TX_PIN             1
+#define TEST_MCM_RX_PIN             2
+#define TEST_MCM_RESET_PIN          3
+
+/**********************************************************************************************************
+ * TYPEDEFS AND CLASSES
+ **********************************************************************************************************/
+
+/**
+ * @brief Fresh host, modem and MCM class for one test. The script is loaded before the modem is powered on.
+ * With b_keep_flash the nvs and SPIFFS of the previous TestMcm are kept, a reboot of the host.
+ */
+class TestMcm
+{
+    public:
+    McmEmulator emulator;
+    McmEmulatorWire wire;
+    MCM mcm;
+    MCMBlocking blocking;
+
+    explicit TestMcm(const char *p_script = "", bool b_keep_flash = false) : wire(emulator, Serial1, TEST_MCM_RESET_PIN),
+                                                                             mcm(Serial1, TEST_MCM_TX_PIN, TEST_MCM_RX_PIN, TEST_MCM_RESET_PIN),
+                                                                             blocking(mcm)
+    {
+        std::string error;
+
+        host_hal_reset();
+        if (!b_keep_flash)
+        {
+            host_fs_format();
+            nvs_flash_erase();
+        }
+        Update.host_reset();
+        if (!emulator.load_script(p_script, &error))
+        {
+            fprintf(stderr, "script: %s\n", error.c_str());
+            exit(1);
+        }
+        wire.attach();
+    }
+
+    ~TestMcm()
+    {
+        // the sketch keeps its MCM for good, the module handle of begin() is never freed by the class
+        delete mcm.get_module_handle();
+    }
+
+    /**
+     * @brief Runs the receive loop of the sketch until condition holds or timeout_ms passes.
+     */
+    template <typename T>
+    bool run_until(T condition, uint32_t u32_timeout_ms = 10000)
+    {
+        uint32_t u32_start = millis();
+
+        while (!condition())
+        {
+            if ((millis() - u32_start) > u32_timeout_ms)
+            {
+                return false;
+            }
+            mcm.handle_rx_events();
+            delay(1);
+        }
+        return true;
+    }
+
+    void run_for(uint32_t u32_ms)
+    {
+        run_until([]() { return false; }, u32_ms);
+    }
+
+    /**
+     * @brief begin() and the boot of the modem.
+     */
+    bool start()
+    {
+        if (MCM_STATUS::MCM_OK != mcm.begin())
+        {
+            return false;
+        }
+        return run_until([this]() { return 0 < mcm.get_sw_reset_event_count(); });
+    }
+
+    /**
+     * @brief Credentials and join.
+     */
+    bool join_lorawan()
+    {
+        uint8_t dev_eui[8] = { 0x70, 0xB3, 0xD5, 0x7E, 0xD0, 0x00, 0x00, 0x01 };
+        uint8_t join_eui[8] = { 0x70, 0xB3, 0xD5, 0x7E, 0xD0, 0x00, 0x00, 0x02 };
+        uint8_t app_key[16] = { 0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C };
+
+        mcm.set_connect_mode(ConnectionMode::CONNECTION_MODE_LORAWAN);
+        if ((MCM_STATUS::MCM_OK != blocking.set_lorawan_credentials(dev_eui, join_eui, app_key)) ||
+            (MCM_STATUS::MCM_OK != mcm.connect_network()))
+        {
+            return false;
+        }
+        return run_until([this]() { return mcm.is_connected(); }, 30000);
+    }
+};
+
+#endif // __TEST_MCM_H__
@@ -0,0 +1,250 @@
+/**
+ * @file test_mcm_commands.cpp
+ * @author OXIT embedded firmware team
+ * @brief Tests of the command queue, each blocking call returns the status of its own command.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_mcm.h"
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static int s_callback_count = 0;
+static MCM_STATUS s_callback_status = MCM_STATUS::MCM_ERROR;
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static void on_command_complete(MCM_STATUS status, const api_processor_response_t *response, void *user_context)
+{
+    (void)response;
+    s_callback_count++;
+    s_callback_status = status;
+
+    // the next command is queued from the callback, the caller of the first one does not wait for it
+    MCM *p_mcm = (MCM *)user_context;
+    api_processor_cmd_get_version(p_mcm->get_module_handle());
+}
+
+static void on_status_command_complete(MCM_STATUS status, const api_processor_response_t *response, void *user_context)
+{
+    (void)response;
+    s_callback_status = status;
+    (*(int *)user_context)++;
+}
+
+static void on_counted_command_complete(MCM_STATUS status, const api_processor_response_t *response, void *user_context)
+{
+    (void)response;
+    CHECK(MCM_STATUS::MCM_OK == status);
+    (*(int *)user_context)++;
+}
+
+/**
+ * @brief A failed command is reported as failed, nothing is taken from its response.
+ */
+static void test_getters_report_the_return_code()
+{
+    TestMcm t("join ok 500\n");
+    uint16_t u16_mtu = 0xFFFF;
+    uint32_t u32_gps_time = 0x12345678;
+
+    REQUIRE(t.start());
+    REQUIRE(t.join_lorawan());
+    REQUIRE(MCM_STATUS::MCM_OK == t.blocking.req_lorawan_dev_time());
+    t.run_for(2000);
+
+    t.emulator.set_rc(MROVER_CC_GET_NEXT_UPLINK_MTU, MROVER_RC_FAIL);
+    CHECK(MCM_STATUS::MCM_ERROR == t.blocking.get_next_uplink_mtu(&u16_mtu));
+    CHECK_EQ(u16_mtu, 0xFFFF);
+
+    // the modem answers at once, no response timeout is waited for
+    t.emulator.set_rc(MROVER_CC_GET_GPS_TIME, MROVER_RC_GPS_TIME_NOT_AVAILABLE);
+    uint32_t u32_start = millis();
+    CHECK(MCM_STATUS::MCM_ERROR == t.blocking.get_gps_time(&u32_gps_time));
+    CHECK(100 > (millis() - u32_start));
+    CHECK_EQ(u32_gps_time, 0x12345678);
+
+    t.emulator.clear_rc(MROVER_CC_GET_NEXT_UPLINK_MTU);
+    t.emulator.clear_rc(MROVER_CC_GET_GPS_TIME);
+    CHECK(MCM_STATUS::MCM_OK == t.blocking.get_next_uplink_mtu(&u16_mtu));
+    CHECK_EQ(u16_mtu, 242);
+    CHECK(MCM_STATUS::MCM_OK == t.blocking.get_gps_time(&u32_gps_time));
+    CHECK(1400000000 <= u32_gps_time);
+}
+
+/**
+ * @brief The blocking setters return once their own command is acknowledged, with its status.
+ */
+static void test_setters_wait_for_the_ack()
+{
+    TestMcm t("join ok 500\n");
+
+    REQUIRE(t.start());
+    REQUIRE(t.join_lorawan());
+
+    CHECK(MCM_STATUS::MCM_OK == t.blocking.set_lorawan_class(MCM_LORAWAN_CLASS_TYPE::MCM_LRWAN_CLASS_C));
+    CHECK_EQ(t.emulator.get_command_count(MROVER_CC_SET_LORAWAN_CLASS), 1);
+
+    t.emulator.set_rc(MROVER_CC_SET_LORAWAN_CLASS, MROVER_RC_FAIL);
+    CHECK(MCM_STATUS::MCM_ERROR == t.blocking.set_lorawan_class(MCM_LORAWAN_CLASS_TYPE::MCM_LRWAN_CLASS_A));
+    t.emulator.clear_rc(MROVER_CC_SET_LORAWAN_CLASS);
+
+    // without a response the setter times out instead of reporting success
+    t.emulator.drop_responses(MROVER_CC_SET_LORAWAN_CLASS, 1);
+    CHECK(MCM_STATUS::MCM_TIMEOUT == t.blocking.set_lorawan_class(MCM_LORAWAN_CLASS_TYPE::MCM_LRWAN_CLASS_A));
+
+    // a refused key fails the credentials
+    uint8_t dev_eui[8] = {};
+    uint8_t join_eui[8] = {};
+    uint8_t app_key[16] = {};
+    t.emulator.set_rc(MROVER_CC_SET_NW_KEY, MROVER_RC_BAD_SIZE);
+    CHECK(MCM_STATUS::MCM_ERROR == t.blocking.set_lorawan_credentials(dev_eui, join_eui, app_key));
+    t.emulator.clear_rc(MROVER_CC_SET_NW_KEY);
+    CHECK(MCM_STATUS::MCM_OK == t.blocking.set_lorawan_credentials(dev_eui, join_eui, app_key));
+}
+
+/**
+ * @brief The commands return once queued, their callback runs from handle_rx_events() and is not kept for the next command.
+ */
+static void test_commands_do_not_block()
+{
+    TestMcm t;
+
+    REQUIRE(t.start());
+
+    // the get version queued by the callback is never answered
+    t.emulator.drop_responses(MROVER_CC_GET_VERSION, 1);
+    t.mcm.nextUplink_mtu = 0;
+    uint32_t u32_start = millis();
+    CHECK(MCM_STATUS::MCM_OK == t.mcm.req_next_uplink_mtu(on_command_complete, &t.mcm));
+    CHECK_EQ(millis(), u32_start);
+    CHECK_EQ(s_callback_count, 0);
+    CHECK(t.mcm.is_command_pending());
+
+    CHECK(t.run_until([&]() { return 1 == s_callback_count; }, 100));
+    CHECK(MCM_STATUS::MCM_OK == s_callback_status);
+    CHECK_EQ(t.mcm.nextUplink_mtu, 242);
+    CHECK(t.mcm.is_command_pending());
+
+    // the callback is not kept for the commands after
+    CHECK(t.run_until([&]() { return !t.mcm.is_command_pending(); }, 5000));
+    CHECK(MCM_STATUS::MCM_OK == t.mcm.req_next_uplink_mtu());
+    CHECK(t.run_until([&]() { return !t.mcm.is_command_pending(); }, 5000));
+    CHECK_EQ(s_callback_count, 1);
+}
+
+/**
+ * @brief The credentials go as one sequence, a refused step drops the steps after it and is reported once.
+ */
+static void test_credentials_failure_drops_the_sequence()
+{
+    TestMcm t;
+    uint8_t dev_eui[8] = {};
+    uint8_t join_eui[8] = {};
+    uint8_t app_key[16] = {};
+    int count = 0;
+
+    REQUIRE(t.start());
+    t.mcm.set_connect_mode(ConnectionMode::CONNECTION_MODE_LORAWAN);
+
+    t.emulator.set_rc(MROVER_CC_SET_DEV_EUI, MROVER_RC_FAIL);
+    CHECK(MCM_STATUS::MCM_OK == t.mcm.set_lorawan_credentials(dev_eui, join_eui, app_key, on_status_command_complete, &count));
+    CHECK(t.run_until([&]() { return !t.mcm.is_command_pending(); }, 5000));
+    CHECK_EQ(count, 1);
+    CHECK(MCM_STATUS::MCM_ERROR == s_callback_status);
+    CHECK_EQ(t.emulator.get_command_count(MROVER_CC_INIT_LORAWAN), 1);
+    CHECK_EQ(t.emulator.get_command_count(MROVER_CC_SET_DEV_EUI), 1);
+    CHECK_EQ(t.emulator.get_command_count(MROVER_CC_SET_JOIN_EUI), 0);
+    CHECK_EQ(t.emulator.get_command_count(MROVER_CC_SET_NW_KEY), 0);
+
+    // a failure after the sequence does not drop the commands queued after it
+    t.emulator.clear_rc(MROVER_CC_SET_DEV_EUI);
+    t.emulator.set_rc(MROVER_CC_SET_NW_KEY, MROVER_RC_FAIL);
+    CHECK(MCM_STATUS::MCM_OK == t.mcm.set_lorawan_credentials(dev_eui, join_eui, app_key, on_status_command_complete, &count));
+    CHECK(MCM_STATUS::MCM_OK == t.mcm.req_next_uplink_mtu(on_status_command_complete, &count));
+    CHECK(t.run_until([&]() { return !t.mcm.is_command_pending(); }, 5000));
+    CHECK_EQ(count, 3);
+    CHECK(MCM_STATUS::MCM_OK == s_callback_status);
+    CHECK_EQ(t.emulator.get_command_count(MROVER_CC_SET_NW_KEY), 1);
+    CHECK_EQ(t.emulator.get_command_count(MROVER_CC_GET_NEXT_UPLINK_MTU), 1);
+}
+
+/**
+ * @brief An uplink the serial port does not take is not queued, the application callback stays for the next command.
+ */
+static void test_failed_uplink_write_keeps_the_callback()
+{
+    TestMcm t;
+    uint8_t au8_payload[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    int count = 0;
+
+    REQUIRE(t.start());
+    REQUIRE(!t.mcm.is_command_pending());
+
+    t.mcm.set_next_command_callback(on_counted_command_complete, &count);
+    host_uart_fail_write_after(Serial1, 0);
+    CHECK(API_PROCESSOR_SUCCESS != api_processor_cmd_request_lorawan_uplink(t.mcm.get_module_handle(), 1, au8_payload, sizeof(au8_payload),
+                                                                           MROVER_UNCONFIRMED_UPLINK));
+    host_uart_fail_write_after(Serial1, SIZE_MAX);
+    CHECK(!t.mcm.is_command_pending());
+    CHECK_EQ(count, 0);
+
+    // the next command takes the callback instead of waiting for the lost uplink, and runs it once
+    CHECK(API_PROCESSOR_SUCCESS == api_processor_cmd_get_next_uplink_mtu(t.mcm.get_module_handle()));
+    CHECK(t.run_until([&]() { return !t.mcm.is_command_pending(); }, 5000));
+    CHECK_EQ(count, 1);
+    CHECK_EQ(t.emulator.get_command_count(MROVER_CC_REQUEST_UPLINK), 0);
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    test_getters_report_the_return_code();
+    test_setters_wait_for_the_ack();
+    test_commands_do_not_block();
+    test_credentials_failure_drops_the_sequence();
+    test_failed_uplink_write_keeps_the_callback();
+    return test_result("test_mcm_commands");
+}
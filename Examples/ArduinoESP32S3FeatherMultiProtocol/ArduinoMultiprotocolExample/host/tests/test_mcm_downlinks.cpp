@@ -0,0 +1,265 @@
+/**
+ * @file test_mcm_downlinks.cpp
+ * @author OXIT embedded firmware team
+ * @brief Downlink queue and lease pool of the MCM class: bursts in one event drain, overflow accounting, leases held past the callback.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_mcm.h"
+#include <string>
+#include <vector>
+
+/******************************************************************************
+ * MACROS AND DEFINES
+ ******************************************************************************/
+#define BURST_AT_MS                 3000
+#define BURST_SIZE                  (MCM_DOWNLINK_QUEUE_SIZE + 2)
+#define LONG_DOWNLINK_LEN           290                     // past the uint8_t length of the former callback
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static std::vector<uint16_t> s_callback_ports;
+static std::vector<uint16_t> s_callback_lens;
+static const mcm_downlink_t *s_retained;
+static MCM *s_mcm;
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static std::string hex(const std::vector<uint8_t> &data)
+{
+    std::string text;
+    char ac_byte[3];
+
+    for (uint8_t u8_byte : data)
+    {
+        snprintf(ac_byte, sizeof(ac_byte), "%02X", u8_byte);
+        text += ac_byte;
+    }
+    return text;
+}
+
+/**
+ * @brief Payload of the downlink on port u16_port, its length tells it apart too.
+ */
+static std::vector<uint8_t> payload_of(uint16_t u16_port)
+{
+    return std::vector<uint8_t>(u16_port, (uint8_t)(0xA0 + u16_port));
+}
+
+static bool has_payload(const mcm_downlink_t *p_downlink, uint16_t u16_port)
+{
+    std::vector<uint8_t> expected = payload_of(u16_port);
+
+    return (NULL != p_downlink) && (p_downlink->seq_port == u16_port) && (p_downlink->len == expected.size()) &&
+           (0 == memcmp(p_downlink->data, expected.data(), expected.size()));
+}
+
+/**
+ * @brief u16_count lorawan downlinks on the ports from u16_first_port, all due at u32_at_ms.
+ */
+static std::string burst_script(uint32_t u32_at_ms, uint16_t u16_first_port, uint16_t u16_count)
+{
+    std::string script;
+
+    for (uint16_t u16_port = u16_first_port; u16_port < u16_first_port + u16_count; u16_port++)
+    {
+        script += "at " + std::to_string(u32_at_ms) + " downlink lorawan " + std::to_string(u16_port) + " -60 4 " + hex(payload_of(u16_port)) + "\n";
+    }
+    return script;
+}
+
+static void on_downlink(const mcm_downlink_t *p_downlink)
+{
+    s_callback_ports.push_back(p_downlink->seq_port);
+    s_callback_lens.push_back(p_downlink->len);
+}
+
+static void on_downlink_retain_first(const mcm_downlink_t *p_downlink)
+{
+    on_downlink(p_downlink);
+    if (NULL == s_retained)
+    {
+        s_retained = p_downlink;
+        s_mcm->retain_downlink(p_downlink);
+    }
+}
+
+/**
+ * @brief A burst larger than the queue: the oldest downlinks are kept in order, the newest are counted as dropped.
+ */
+static void test_burst_overflow()
+{
+    TestMcm t(burst_script(BURST_AT_MS, 1, BURST_SIZE).c_str());
+
+    s_callback_ports.clear();
+    s_callback_lens.clear();
+    REQUIRE(t.start());
+    t.mcm.set_on_rx_callback(on_downlink);
+    CHECK(t.run_until([&]() { return BURST_SIZE == s_callback_ports.size(); }));
+    t.run_for(100);
+
+    // the callback sees every downlink, the queue keeps the first ones
+    CHECK_EQ(s_callback_ports.size(), BURST_SIZE);
+    CHECK_EQ(t.mcm.get_downlink_count(), MCM_DOWNLINK_QUEUE_SIZE);
+    CHECK_EQ(t.mcm.get_downlink_overflow_count(), BURST_SIZE - MCM_DOWNLINK_QUEUE_SIZE);
+    for (uint8_t i = 0; i < MCM_DOWNLINK_QUEUE_SIZE; i++)
+    {
+        const mcm_downlink_t *p_downlink = t.mcm.peek_downlink(i);
+        CHECK(has_payload(p_downlink, i + 1));
+        CHECK((NULL != p_downlink) && (COMMAND_TYPE_LORAWAN == p_downlink->protocol) && (-60 == p_downlink->rssi) && (4 == p_downlink->snr));
+        CHECK((NULL != p_downlink) && (BURST_AT_MS <= p_downlink->timestamp));
+    }
+    CHECK(NULL == t.mcm.peek_downlink(MCM_DOWNLINK_QUEUE_SIZE));
+
+    // drained oldest first, every slot is back in the pool
+    for (uint8_t i = 0; i < MCM_DOWNLINK_QUEUE_SIZE; i++)
+    {
+        const mcm_downlink_t *p_downlink = t.mcm.acquire_downlink();
+        CHECK(has_payload(p_downlink, i + 1));
+        t.mcm.release_downlink(p_downlink);
+        CHECK((NULL != p_downlink) && (0 == p_downlink->ref_count));
+    }
+    CHECK(!t.mcm.is_downlink_available());
+    CHECK(NULL == t.mcm.acquire_downlink());
+}
+
+/**
+ * @brief A downlink retained by the callback and one acquired by the application keep their slots
+ * while later bursts go through the pool.
+ */
+static void test_leases()
+{
+    std::string script = burst_script(BURST_AT_MS, 1, 2) + burst_script(BURST_AT_MS + 2000, 10, MCM_DOWNLINK_QUEUE_SIZE);
+    TestMcm t(script.c_str());
+
+    s_callback_ports.clear();
+    s_callback_lens.clear();
+    s_retained = NULL;
+    s_mcm = &t.mcm;
+    REQUIRE(t.start());
+    t.mcm.set_on_rx_callback(on_downlink_retain_first);
+    CHECK(t.run_until([&]() { return 2 == s_callback_ports.size(); }));
+
+    // port 1 is held by the callback and the queue, the application reads it from the queue and is done with it
+    CHECK(has_payload(s_retained, 1));
+    const mcm_downlink_t *p_first = t.mcm.acquire_downlink();
+    CHECK(p_first == s_retained);
+    t.mcm.release_downlink(p_first);
+    CHECK_EQ(s_retained->ref_count, 1);
+    // port 2 is kept by the application
+    const mcm_downlink_t *p_leased = t.mcm.acquire_downlink();
+    CHECK(has_payload(p_leased, 2));
+
+    // the second burst cannot reuse the slot of the retained downlink nor the one of the leased one
+    CHECK(t.run_until([&]() { return 2 + MCM_DOWNLINK_QUEUE_SIZE == s_callback_ports.size(); }));
+    t.run_for(100);
+    CHECK(has_payload(s_retained, 1));
+    CHECK(has_payload(p_leased, 2));
+    CHECK_EQ(t.mcm.get_downlink_count(), MCM_DOWNLINK_QUEUE_SIZE);
+    CHECK_EQ(t.mcm.get_downlink_overflow_count(), 0);
+    for (uint8_t i = 0; i < MCM_DOWNLINK_QUEUE_SIZE; i++)
+    {
+        CHECK(has_payload(t.mcm.peek_downlink(i), 10 + i));
+    }
+
+    // the whole pool is in use, one more downlink has no slot
+    t.emulator.schedule_downlink((uint64_t)(millis() + 10) * 1000, COMMAND_TYPE_LORAWAN, 30, -60, 4, payload_of(30));
+    CHECK(t.run_until([&]() { return 0 < t.mcm.get_downlink_overflow_count(); }));
+    CHECK_EQ(t.mcm.get_downlink_overflow_count(), 1);
+    CHECK_EQ(t.mcm.get_downlink_count(), MCM_DOWNLINK_QUEUE_SIZE);
+
+    t.mcm.release_downlink(s_retained);
+    t.mcm.release_downlink(p_leased);
+    CHECK_EQ(s_retained->ref_count, 0);
+    CHECK_EQ(p_leased->ref_count, 0);
+}
+
+/**
+ * @brief Long and sidewalk downlinks, through the callback and the former copy out API.
+ */
+static void test_long_downlink()
+{
+    std::vector<uint8_t> payload(LONG_DOWNLINK_LEN);
+    uint8_t au8_data[MCM_DOWNLINK_MAX_PAYLOAD_SIZE];
+    uint16_t u16_len = 0;
+    int8_t i8_rssi = 0;
+    int8_t i8_snr = 0;
+    uint16_t u16_seq = 0;
+
+    for (size_t i = 0; i < payload.size(); i++)
+    {
+        payload[i] = (uint8_t)(i * 31 + 7);
+    }
+    std::string script = "at " + std::to_string(BURST_AT_MS) + " downlink sidewalk 517 -90 -3 " + hex(payload) + "\n";
+    TestMcm t(script.c_str());
+
+    s_callback_ports.clear();
+    s_callback_lens.clear();
+    REQUIRE(t.start());
+    t.mcm.set_on_rx_callback(on_downlink);
+    CHECK(t.run_until([&]() { return t.mcm.is_downlink_available(); }));
+    REQUIRE(1 == s_callback_lens.size());
+    CHECK_EQ(s_callback_lens[0], LONG_DOWNLINK_LEN);
+    CHECK_EQ(t.mcm.peek_downlink(0)->protocol, COMMAND_TYPE_SIDEWALK);
+
+    t.mcm.get_downlink_data(au8_data, &u16_len, &i8_rssi, &i8_snr, &u16_seq);
+    CHECK_EQ(u16_len, LONG_DOWNLINK_LEN);
+    CHECK(0 == memcmp(au8_data, payload.data(), payload.size()));
+    CHECK_EQ(i8_rssi, -90);
+    CHECK_EQ(i8_snr, -3);
+    CHECK_EQ(u16_seq, 517);
+    CHECK(!t.mcm.is_downlink_available());
+    t.mcm.get_downlink_data(au8_data, &u16_len, &i8_rssi, &i8_snr, &u16_seq);
+    CHECK_EQ(u16_len, 0);
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    test_burst_overflow();
+    test_leases();
+    test_long_downlink();
+    return test_result("test_mcm_downlinks");
+}
@@ -0,0 +1,178 @@
+/**
+ * @file test_mcm_emu_pty.cpp
+ * @author OXIT embedded firmware team
+ * @brief Smoke test of the MCM class against the mcm_emu program over a pseudo terminal, in real time.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "host_hal.h"
+#include "mcm_rover.h"
+#include "mcm_rover_blocking.h"
+#include "test_common.h"
+#include <signal.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/******************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ ******************************************************************************/
+#define TEST_TX_PIN                 1
+#define TEST_RX_PIN                 2
+#define TEST_RESET_PIN              3
+#define TEST_TIMEOUT_MS             5000
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static uint8_t s_downlink[32];
+static uint16_t s_downlink_len = 0;
+static uint8_t s_downlink_port = 0;
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static void on_downlink(const mcm_downlink_t *downlink)
+{
+    s_downlink_len = std::min<uint16_t>(downlink->len, sizeof(s_downlink));
+    memcpy(s_downlink, downlink->data, s_downlink_len);
+    s_downlink_port = (uint8_t)downlink->seq_port;
+}
+
+/**
+ * @brief Runs the receive loop of the sketch until condition holds.
+ */
+template <typename T>
+static bool run_until(MCM &mcm, T condition)
+{
+    uint32_t u32_start = millis();
+
+    while (!condition())
+    {
+        if ((millis() - u32_start) > TEST_TIMEOUT_MS)
+        {
+            return false;
+        }
+        mcm.handle_rx_events();
+        delay(5);
+    }
+    return true;
+}
+
+/**
+ * @brief Starts mcm_emu with the script.
+ * @return path of its tty, empty if it did not start
+ */
+static std::string start_emulator(const char *p_emulator, const char *p_script, pid_t *p_pid)
+{
+    int fds[2];
+    char path[128] = {};
+
+    if (0 != pipe(fds))
+    {
+        return "";
+    }
+    *p_pid = fork();
+    if (0 == *p_pid)
+    {
+        dup2(fds[1], STDOUT_FILENO);
+        close(fds[0]);
+        execl(p_emulator, p_emulator, "-s", p_script, "-t", "30", "-q", (char *)NULL);
+        _exit(127);
+    }
+    close(fds[1]);
+    FILE *p_out = fdopen(fds[0], "r");
+    if ((NULL == p_out) || (NULL == fgets(path, sizeof(path), p_out)))
+    {
+        return "";
+    }
+    path[strcspn(path, "\n")] = '\0';
+    return path;
+}
+
+/******************************************************************************
+ * MAIN
+ ******************************************************************************/
+int main(int argc, char **argv)
+{
+    pid_t pid = -1;
+
+    REQUIRE(3 == argc);
+    host_hal_reset();
+    host_hal_set_real_time(true);
+
+    std::string tty = start_emulator(argv[1], argv[2], &pid);
+    REQUIRE(!tty.empty());
+    REQUIRE(host_uart_open_tty(Serial1, tty.c_str()));
+
+    MCM mcm(Serial1, TEST_TX_PIN, TEST_RX_PIN, TEST_RESET_PIN);
+    MCMBlocking blocking(mcm);
+    REQUIRE(MCM_STATUS::MCM_OK == mcm.begin());
+    mcm.set_on_rx_callback(on_downlink);
+
+    // the reset notification of the boot
+    CHECK(run_until(mcm, [&]() { return 0 < mcm.get_sw_reset_event_count(); }));
+    CHECK(blocking.print_version().indexOf("0.5.8") >= 0);
+
+    uint8_t dev_eui[8] = { 0x70, 0xB3, 0xD5, 0x7E, 0xD0, 0x00, 0x00, 0x01 };
+    uint8_t join_eui[8] = { 0x70, 0xB3, 0xD5, 0x7E, 0xD0, 0x00, 0x00, 0x02 };
+    uint8_t app_key[16] = { 0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C };
+    mcm.set_connect_mode(ConnectionMode::CONNECTION_MODE_LORAWAN);
+    CHECK(MCM_STATUS::MCM_OK == blocking.set_lorawan_credentials(dev_eui, join_eui, app_key));
+    CHECK(MCM_STATUS::MCM_OK == mcm.connect_network());
+    CHECK(run_until(mcm, [&]() { return mcm.is_connected(); }));
+
+    uint8_t payload[] = { 0x01, 0x02, 0x03 };
+    mcm.send_uplink(payload, sizeof(payload), 2, MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_CONF);
+    CHECK(run_until(mcm, [&]() { return !mcm.is_last_uplink_pending(); }));
+    CHECK(MCM_TX_STATUS::MCM_TX_ACK == mcm.get_last_tx_status());
+
+    CHECK(run_until(mcm, [&]() { return 0 < s_downlink_len; }));
+    CHECK_EQ(s_downlink_len, 3);
+    CHECK_EQ(s_downlink_port, 10);
+    CHECK((0xCA == s_downlink[0]) && (0xFE == s_downlink[1]) && (0x01 == s_downlink[2]));
+
+    kill(pid, SIGTERM);
+    waitpid(pid, NULL, 0);
+    // the sketch keeps its MCM for good, the module handle of begin() is never freed by the class
+    delete mcm.get_module_handle();
+    return test_result("test_mcm_emu_pty");
+}
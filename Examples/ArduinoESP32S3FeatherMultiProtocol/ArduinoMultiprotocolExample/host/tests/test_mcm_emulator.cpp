@@ -0,0 +1,264 @@
+/**
+ * @file test_mcm_emulator.cpp
+ * @author OXIT embedded firmware team
+ * @brief MCM class against the in process emulated modem: boot, join, uplinks, events, faults and the ymodem transfer.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_mcm.h"
+#include "checksum.h"
+#include <string.h>
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static void test_boot_and_reset_pin()
+{
+    TestMcm t("boot 200\n");
+
+    REQUIRE(t.start());
+    CHECK_EQ(t.mcm.get_sw_reset_event_count(), 1);
+    CHECK(t.blocking.print_version().indexOf("0.5.8") >= 0);
+
+    // the modem restarts on the reset pin and reports it
+    t.mcm.hw_reset();
+    CHECK(t.run_until([&]() { return 2 <= t.mcm.get_sw_reset_event_count(); }));
+    CHECK_EQ(t.emulator.get_stats().u32_resets, 2);
+}
+
+static void test_lorawan_session()
+{
+    TestMcm t("join ok 2000\n"
+              "txstatus notsent\n"
+              "txdone ack 800\n"
+              "mtu 115\n"
+              "gps 1400000000\n"
+              "at 20000 downlink lorawan 3 -70 5 0102\n");
+    uint8_t payload[] = { 0x11, 0x22, 0x33, 0x44 };
+    uint16_t u16_mtu = 0;
+    uint32_t u32_gps_time = 0;
+
+    REQUIRE(t.start());
+    REQUIRE(t.join_lorawan());
+    CHECK(t.emulator.is_joined());
+
+    // the first uplink is not sent by the modem, the second one is acked
+    t.mcm.send_uplink(payload, sizeof(payload), 7, MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF);
+    CHECK(t.run_until([&]() { return !t.mcm.is_last_uplink_pending(); }));
+    CHECK(MCM_TX_STATUS::MCM_TX_NOT_SEND == t.mcm.get_last_tx_status());
+    t.mcm.send_uplink(payload, sizeof(payload), 7, MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_CONF);
+    CHECK(t.run_until([&]() { return !t.mcm.is_last_uplink_pending(); }));
+    CHECK(MCM_TX_STATUS::MCM_TX_ACK == t.mcm.get_last_tx_status());
+
+    REQUIRE(2 == t.emulator.get_uplinks().size());
+    const mcm_emu_uplink_t &uplink = t.emulator.get_uplinks()[1];
+    CHECK_EQ(uplink.u8_cmd_type, COMMAND_TYPE_LORAWAN);
+    CHECK_EQ(uplink.u8_port, 7);
+    CHECK_EQ(uplink.u8_uplink_type, MROVER_CONFIRMED_UPLINK);
+    CHECK((sizeof(payload) == uplink.data.size()) && (0 == memcmp(payload, uplink.data.data(), sizeof(payload))));
+
+    CHECK(MCM_STATUS::MCM_OK == t.blocking.get_next_uplink_mtu(&u16_mtu));
+    CHECK_EQ(u16_mtu, 115);
+    // the gps time is only read once the network time is synced
+    CHECK(MCM_STATUS::MCM_OK != t.blocking.get_gps_time(&u32_gps_time));
+    CHECK(MCM_STATUS::MCM_OK == t.blocking.req_lorawan_dev_time());
+    t.run_for(2000);
+    CHECK(MCM_STATUS::MCM_OK == t.blocking.get_gps_time(&u32_gps_time));
+    CHECK(1400000000 <= u32_gps_time);
+
+    CHECK(t.run_until([&]() { return t.mcm.is_downlink_available(); }, 30000));
+    const mcm_downlink_t *p_downlink = t.mcm.acquire_downlink();
+    REQUIRE(NULL != p_downlink);
+    CHECK_EQ(p_downlink->len, 2);
+    CHECK_EQ(p_downlink->seq_port, 3);
+    CHECK_EQ(p_downlink->rssi, -70);
+    CHECK_EQ(p_downlink->snr, 5);
+    t.mcm.release_downlink(p_downlink);
+
+    get_last_dl_stats_t stats = {};
+    CHECK(MCM_STATUS::MCM_OK == t.blocking.get_last_dl_stats(&stats));
+    CHECK_EQ(stats.rssi, -70);
+}
+
+static void test_join_failure()
+{
+    TestMcm t("join fail 4 1000\n");
+
+    REQUIRE(t.start());
+    CHECK(!t.join_lorawan());
+    CHECK(t.mcm.is_join_failure_available());
+    CHECK_EQ(t.mcm.get_join_failure_data(), 4);
+    CHECK(!t.mcm.is_connected());
+}
+
+static void test_segmented_file_status()
+{
+    TestMcm t("at 1000 segments 1 1.2.3 4096 2 5 0x001F 1\n");
+    get_seg_file_status_t status = {};
+
+    REQUIRE(t.start());
+    t.run_for(2000);
+    CHECK(MCM_STATUS::MCM_OK == t.blocking.get_segmented_file_download_status(&status));
+    CHECK_EQ(status.cmd_type.bin_type, 1);
+    CHECK_EQ(status.fw_ver.major, 1);
+    CHECK_EQ(status.fw_ver.minor, 2);
+    CHECK_EQ(status.fw_ver.patch, 3);
+    CHECK_EQ(status.seg_size, 2);
+    CHECK_EQ(status.nxt_seg_id, 5);
+    CHECK_EQ(status.seg_status, 0x001F);
+    CHECK_EQ(status.fuota_active, 1);
+    CHECK_EQ(t.emulator.get_pending_events(), 0);
+}
+
+static void test_faults()
+{
+    TestMcm t("rc GET_NEXT_UPLINK_MTU 6\n");
+    uint16_t u16_mtu = 0;
+
+    REQUIRE(t.start());
+    // the return code forced by the script reaches the host, no mtu is taken from the failed command
+    CHECK(MCM_STATUS::MCM_ERROR == t.blocking.get_next_uplink_mtu(&u16_mtu));
+    CHECK_EQ(u16_mtu, 0);
+    CHECK_EQ(t.emulator.get_command_count(MROVER_CC_GET_NEXT_UPLINK_MTU), 1);
+
+    // a corrupted command is answered with BAD_CRC, the next one goes through
+    uint8_t frame[] = { COMMAND_TYPE_GENERAL, 0x00, 0x01, 0x00, 0x00, 0x55 };
+    Serial1.write(frame, sizeof(frame));
+    t.run_for(100);
+    CHECK_EQ(t.emulator.get_stats().u32_bad_crc, 1);
+    CHECK(t.blocking.print_version().indexOf("0.5.8") >= 0);
+
+    // noise between the frames is skipped
+    uint8_t noise[] = { 0xFF, 0x00, 0x7E };
+    Serial1.write(noise, sizeof(noise));
+    t.run_for(200);
+    CHECK_EQ(t.emulator.get_stats().u32_noise_bytes, 3);
+    CHECK(t.blocking.print_version().indexOf("0.5.8") >= 0);
+}
+
+static void test_baud_rate()
+{
+    McmEmulator emulator;
+    std::vector<uint8_t> sent;
+    emulator.set_transmit([&](const uint8_t *p_data, size_t len) { sent.insert(sent.end(), p_data, p_data + len); });
+    emulator.power_on(0);
+    emulator.poll(1000000);
+    sent.clear();
+
+    // without the command on the 0.5.8 firmware
+    uint8_t frame[] = { COMMAND_TYPE_GENERAL, 0x01, 0x02, 0x00, 0x04, 0x00, 0x01, 0xC2, 0x00, 0x00 };
+    frame[sizeof(frame) - 1] = checksum_xor8(0, frame, sizeof(frame) - 1);
+    for (uint8_t u8_byte : frame)
+    {
+        emulator.receive(u8_byte, 1000000);
+    }
+    emulator.poll(1100000);
+    REQUIRE(7 <= sent.size());
+    CHECK_EQ(sent[0], MROVER_RC_UNKNOWN);
+    CHECK_EQ(emulator.get_baud_rate(), MROVER_DEFAULT_BAUD_RATE);
+
+    // a firmware with the command switches, and falls back without a valid frame at the new rate
+    emulator.config().baud_rates = { 115200 };
+    sent.clear();
+    for (uint8_t u8_byte : frame)
+    {
+        emulator.receive(u8_byte, 2000000);
+    }
+    emulator.poll(2100000);
+    REQUIRE(7 <= sent.size());
+    CHECK_EQ(sent[0], MROVER_RC_OK);
+    CHECK_EQ(emulator.get_baud_rate(), 115200);
+    emulator.poll(2000000 + 2000 + (MROVER_BAUD_VERIFY_WINDOW_MS * 1000ULL));
+    CHECK_EQ(emulator.get_baud_rate(), MROVER_DEFAULT_BAUD_RATE);
+}
+
+static void test_ymodem_transfer()
+{
+    TestMcm t("corrupt 2\n");
+    std::vector<uint8_t> image(5000);
+    ver_type_1_t version = { 1, 2, 3 };
+
+    for (size_t i = 0; i < image.size(); i++)
+    {
+        image[i] = (uint8_t)(i * 7);
+    }
+    image[0] = ESP_IMAGE_HEADER_MAGIC;
+    t.emulator.config().file = image;
+
+    REQUIRE(t.start());
+    CHECK(MCM_STATUS::MCM_OK == t.mcm.start_file_transfer(version));
+    CHECK(t.run_until([&]() { return t.emulator.get_stats().b_ymodem_done; }, 60000));
+    t.run_for(500);
+    CHECK_EQ(t.emulator.get_stats().u32_ymodem_naks, 1);
+    CHECK(image == Update.host_get_image());
+    CHECK_EQ(host_hal_get_restart_count(), 1);
+}
+
+static void test_script_errors()
+{
+    McmEmulator emulator;
+    std::string error;
+
+    CHECK(!emulator.load_script("join maybe\n", &error));
+    CHECK(std::string::npos != error.find("line 1"));
+    CHECK(!emulator.load_script("event JOINED\n", &error));
+    CHECK(!emulator.load_script("at 10 downlink lorawan 1 -50 7 abc\n", &error));
+    CHECK(!emulator.load_script("mtu 51\nbogus 1\n", &error));
+    CHECK(std::string::npos != error.find("line 2"));
+    CHECK(emulator.load_script("# comment only\n\nversion 1.0.2 0.5.9 1.0.0 1.1.0 1.0.4  # trailing\n", &error));
+    CHECK_EQ(emulator.config().au8_version[7], 9);
+}
+
+/******************************************************************************
+ * MAIN
+ ******************************************************************************/
+int main()
+{
+    test_boot_and_reset_pin();
+    test_lorawan_session();
+    test_join_failure();
+    test_segmented_file_status();
+    test_faults();
+    test_baud_rate();
+    test_ymodem_transfer();
+    test_script_errors();
+    return test_result("test_mcm_emulator");
+}
@@ -0,0 +1,254 @@
+/**
+ * @file test_mcm_two_modems.cpp
+ * @author OXIT embedded firmware team
+ * @brief Two MCM objects serviced from one loop, a LoRaWAN modem on Serial1 and a Sidewalk modem on Serial2.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_mcm.h"
+#include <vector>
+
+/******************************************************************************
+ * MACROS AND DEFINES
+ ******************************************************************************/
+#define SID_TX_PIN                  4
+#define SID_RX_PIN                  5
+#define SID_RESET_PIN               6
+#define UPLINKS_PER_MODEM           6                       // within UPLINK_SCHED_QUEUE_SIZE
+#define LORA_PAYLOAD_TAG            0xA0
+#define SID_PAYLOAD_TAG             0xB0
+
+/******************************************************************************
+ * TYPEDEFS
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t u32_msg_id;
+    MCM_TX_STATUS status;
+} uplink_result_t;
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static std::vector<uplink_result_t> s_lora_results;
+static std::vector<uplink_result_t> s_sid_results;
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static void on_lora_result(uint32_t msg_id, MCM_TX_STATUS status, uint8_t attempts)
+{
+    (void)attempts;
+    s_lora_results.push_back({ msg_id, status });
+}
+
+static void on_sid_result(uint32_t msg_id, MCM_TX_STATUS status, uint8_t attempts)
+{
+    (void)attempts;
+    s_sid_results.push_back({ msg_id, status });
+}
+
+/**
+ * @brief The loop of a sketch with two modules, both serviced on every pass.
+ */
+template <typename T>
+static bool run_both_until(MCM &first, MCM &second, T condition, uint32_t u32_timeout_ms = 60000)
+{
+    uint32_t u32_start = millis();
+
+    while (!condition())
+    {
+        if ((millis() - u32_start) > u32_timeout_ms)
+        {
+            return false;
+        }
+        first.handle_rx_events();
+        second.handle_rx_events();
+        delay(1);
+    }
+    return true;
+}
+
+/**
+ * @brief Queues the uplinks of both modules interleaved, each module has to send its own and report its own results.
+ */
+static void test_interleaved_uplinks(TestMcm &lora, McmEmulator &sid_emulator, MCM &sid)
+{
+    std::vector<uint32_t> lora_ids;
+    std::vector<uint32_t> sid_ids;
+
+    lora.mcm.set_on_uplink_result_callback(on_lora_result);
+    sid.set_on_uplink_result_callback(on_sid_result);
+    for (uint8_t i = 0; i < UPLINKS_PER_MODEM; i++)
+    {
+        uint8_t lora_payload[] = { LORA_PAYLOAD_TAG, i, 0x11, 0x22 };
+        uint8_t sid_payload[] = { SID_PAYLOAD_TAG, i, 0x33 };
+        uint32_t u32_msg_id = 0;
+
+        REQUIRE(MCM_STATUS::MCM_OK == lora.mcm.queue_uplink(lora_payload, sizeof(lora_payload), 1, MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF,
+                                                            UPLINK_SCHED_TELEMETRY, &u32_msg_id));
+        lora_ids.push_back(u32_msg_id);
+        REQUIRE(MCM_STATUS::MCM_OK == sid.queue_uplink(sid_payload, sizeof(sid_payload), 1, MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF,
+                                                       UPLINK_SCHED_TELEMETRY, &u32_msg_id));
+        sid_ids.push_back(u32_msg_id);
+    }
+
+    CHECK(run_both_until(lora.mcm, sid, []()
+                         { return (UPLINKS_PER_MODEM <= s_lora_results.size()) && (UPLINKS_PER_MODEM <= s_sid_results.size()); },
+                         300000));
+
+    // every result went to the callback of its own module, with the ids that module handed out
+    CHECK_EQ(s_lora_results.size(), UPLINKS_PER_MODEM);
+    CHECK_EQ(s_sid_results.size(), UPLINKS_PER_MODEM);
+    for (size_t i = 0; i < s_lora_results.size() && i < lora_ids.size(); i++)
+    {
+        CHECK_EQ(s_lora_results[i].u32_msg_id, lora_ids[i]);
+        CHECK(MCM_TX_STATUS::MCM_TX_NOT_SEND != s_lora_results[i].status);
+    }
+    for (size_t i = 0; i < s_sid_results.size() && i < sid_ids.size(); i++)
+    {
+        CHECK_EQ(s_sid_results[i].u32_msg_id, sid_ids[i]);
+        CHECK(MCM_TX_STATUS::MCM_TX_NOT_SEND != s_sid_results[i].status);
+    }
+
+    // and every payload reached the modem of its module, in order
+    const std::vector<mcm_emu_uplink_t> &lora_uplinks = lora.emulator.get_uplinks();
+    const std::vector<mcm_emu_uplink_t> &sid_uplinks = sid_emulator.get_uplinks();
+    CHECK_EQ(lora_uplinks.size(), UPLINKS_PER_MODEM);
+    CHECK_EQ(sid_uplinks.size(), UPLINKS_PER_MODEM);
+    for (size_t i = 0; i < lora_uplinks.size(); i++)
+    {
+        CHECK_EQ(lora_uplinks[i].u8_cmd_type, COMMAND_TYPE_LORAWAN);
+        CHECK(std::vector<uint8_t>({ LORA_PAYLOAD_TAG, (uint8_t)i, 0x11, 0x22 }) == lora_uplinks[i].data);
+    }
+    for (size_t i = 0; i < sid_uplinks.size(); i++)
+    {
+        CHECK_EQ(sid_uplinks[i].u8_cmd_type, COMMAND_TYPE_SIDEWALK);
+        CHECK(std::vector<uint8_t>({ SID_PAYLOAD_TAG, (uint8_t)i, 0x33 }) == sid_uplinks[i].data);
+    }
+}
+
+/**
+ * @brief A direct sidewalk ble uplink is refused while the connection is down, before the join here,
+ *  nothing reaches the modem.
+ */
+static void test_ble_uplink_before_connection(McmEmulator &sid_emulator, MCM &sid)
+{
+    uint8_t payload[] = { SID_PAYLOAD_TAG, 0xEE };
+    size_t uplinks = sid_emulator.get_uplinks().size();
+
+    REQUIRE(BLE_CONN_UP != sid.get_ble_connection_state());
+    CHECK(MCM_STATUS::MCM_ERROR == sid.send_uplink(payload, sizeof(payload), 1, MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF));
+    CHECK_EQ(sid.is_last_uplink_pending(), false);
+    CHECK_EQ(sid_emulator.get_uplinks().size(), uplinks);
+}
+
+/**
+ * @brief A reset of one module is seen by that module only.
+ */
+static void test_reset_one_module(TestMcm &lora, MCM &sid)
+{
+    uint8_t u8_lora_resets = lora.mcm.get_sw_reset_event_count();
+    uint8_t u8_sid_resets = sid.get_sw_reset_event_count();
+
+    sid.hw_reset();
+    CHECK(run_both_until(lora.mcm, sid, [&]() { return sid.get_sw_reset_event_count() > u8_sid_resets; }));
+    lora.run_for(500);
+    CHECK_EQ(lora.mcm.get_sw_reset_event_count(), u8_lora_resets);
+    CHECK(lora.mcm.is_connected());
+
+    // the lorawan module keeps working while the sidewalk one starts over
+    uint8_t payload[] = { LORA_PAYLOAD_TAG, 0xFF };
+    uint32_t u32_msg_id = 0;
+    size_t uplinks = lora.emulator.get_uplinks().size();
+    REQUIRE(MCM_STATUS::MCM_OK == lora.mcm.queue_uplink(payload, sizeof(payload), 1, MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF,
+                                                        UPLINK_SCHED_TELEMETRY, &u32_msg_id));
+    CHECK(run_both_until(lora.mcm, sid, [&]() { return lora.emulator.get_uplinks().size() > uplinks; }));
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    // the first modem comes with the fixture, it resets the host before the second one is wired
+    TestMcm lora("join ok 200\n"
+                 "txdone noack 100\n");
+    McmEmulator sid_emulator;
+    McmEmulatorWire sid_wire(sid_emulator, Serial2, SID_RESET_PIN);
+    MCM sid(Serial2, SID_TX_PIN, SID_RX_PIN, SID_RESET_PIN);
+    std::string error;
+
+    REQUIRE(sid_emulator.load_script("ble 300 60000\n"
+                                     "link 500\n"
+                                     "txdone noack 200\n", &error));
+    sid_wire.attach();
+
+    REQUIRE(MCM_STATUS::MCM_OK == lora.mcm.begin());
+    REQUIRE(MCM_STATUS::MCM_OK == sid.begin());
+    REQUIRE(run_both_until(lora.mcm, sid, [&]()
+                           { return (0 < lora.mcm.get_sw_reset_event_count()) && (0 < sid.get_sw_reset_event_count()); }));
+    REQUIRE(MCM_STATUS::MCM_OK == lora.mcm.req_version());
+    REQUIRE(MCM_STATUS::MCM_OK == sid.req_version());
+    CHECK(run_both_until(lora.mcm, sid, [&]() { return !lora.mcm.is_command_pending() && !sid.is_command_pending(); }));
+    CHECK(lora.mcm.get_modem_version().indexOf("0.5.8") >= 0);
+    CHECK(sid.get_modem_version().indexOf("0.5.8") >= 0);
+
+    // both modules join at the same time from the same loop
+    uint8_t dev_eui[8] = { 0x70, 0xB3, 0xD5, 0x7E, 0xD0, 0x00, 0x00, 0x01 };
+    uint8_t join_eui[8] = { 0x70, 0xB3, 0xD5, 0x7E, 0xD0, 0x00, 0x00, 0x02 };
+    uint8_t app_key[16] = { 0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C };
+    lora.mcm.set_connect_mode(ConnectionMode::CONNECTION_MODE_LORAWAN);
+    REQUIRE(MCM_STATUS::MCM_OK == lora.blocking.set_lorawan_credentials(dev_eui, join_eui, app_key));
+    sid.set_connect_mode(ConnectionMode::CONNECTION_MODE_SIDEWALK_BLE);
+    test_ble_uplink_before_connection(sid_emulator, sid);
+    REQUIRE(MCM_STATUS::MCM_OK == lora.mcm.connect_network());
+    REQUIRE(MCM_STATUS::MCM_OK == sid.connect_network());
+    REQUIRE(run_both_until(lora.mcm, sid, [&]() { return lora.mcm.is_connected() && sid.is_connected(); }));
+    CHECK_EQ(lora.emulator.get_commands().empty(), false);
+    CHECK(ConnectionMode::CONNECTION_MODE_LORAWAN == lora.mcm.get_connect_mode());
+    CHECK(ConnectionMode::CONNECTION_MODE_SIDEWALK_BLE == sid.get_connect_mode());
+
+    test_interleaved_uplinks(lora, sid_emulator, sid);
+    test_reset_one_module(lora, sid);
+
+    delete sid.get_module_handle();
+    return test_result("test_mcm_two_modems");
+}
@@ -0,0 +1,342 @@
+/**
+ * @file test_response_dispatch.cpp
+ * @author OXIT embedded firmware team
+ * @brief Response and event dispatch of the api processor, every code against the former switch statements.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "test_common.h"
+#include "api_processor.h"
+#include "checksum.h"
+#include <string.h>
+#include <vector>
+
+/******************************************************************************
+ * TYPEDEFS
+ ******************************************************************************/
+typedef std::vector<uint8_t> frame_t;
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static mcm_module_hdl_t s_module;
+static std::vector<api_processor_response_t> s_responses;
+
+/**
+ * @brief Command codes the former switch of api_processor_parse_response_frame() handled
+ */
+static const uint16_t s_former_codes[] =
+{
+    MROVER_CC_GET_EVENT, MROVER_CC_GET_VERSION, MROVER_CC_RESET, MROVER_CC_FACTORY_RESET, MROVER_CC_SWITCH_NETWORK,
+    MROVER_CC_INIT_LORAWAN, MROVER_CC_SET_JOIN_EUI, MROVER_CC_SET_DEV_EUI, MROVER_CC_SET_NW_KEY, MROVER_CC_GET_DEV_EUI,
+    MROVER_CC_GET_JOIN_EUI, MROVER_CC_JOIN_LORAWAN, MROVER_CC_REQUEST_UPLINK, MROVER_CC_LEAVE_LORAWAN_NETWORK,
+    MROVER_CC_STOP_SID_LORAWAN_NETWORK, MROVER_CC_BLE_LINK_REQUEST, MROVER_CC_BLE_CONNECTION_REQUEST,
+    MROVER_CC_FSK_LINK_REQUEST, MROVER_CC_CSS_LINK_REQUEST, MROVER_CC_SET_CSS_PWR_PROFILE,
+    MROVER_CC_SET_FILTERING_DOWNLINK_SIDEWALK, MROVER_CC_SET_LORAWAN_CLASS, MROVER_CC_GET_LORAWAN_CLASS,
+    MROVER_CC_START_FILE_TRANSFER, MROVER_CC_TRIGGER_FW_UPDATE, MROVER_CC_FILE_STATUS, MROVER_CC_GET_GPS_TIME,
+    MROVER_CC_LORAWAN_TIME_REQ, MROVER_CC_GET_LAST_DL_STATS, MROVER_CC_GET_NEXT_UPLINK_MTU,
+};
+
+/**
+ * @brief Commands answered with an empty payload, the former parse_cmd_with_len_zero() cases
+ */
+static const uint16_t s_empty_response_codes[] =
+{
+    MROVER_CC_RESET, MROVER_CC_FACTORY_RESET, MROVER_CC_SWITCH_NETWORK, MROVER_CC_INIT_LORAWAN, MROVER_CC_SET_JOIN_EUI,
+    MROVER_CC_SET_DEV_EUI, MROVER_CC_SET_NW_KEY, MROVER_CC_JOIN_LORAWAN, MROVER_CC_LEAVE_LORAWAN_NETWORK,
+    MROVER_CC_STOP_SID_LORAWAN_NETWORK, MROVER_CC_BLE_LINK_REQUEST, MROVER_CC_BLE_CONNECTION_REQUEST,
+    MROVER_CC_FSK_LINK_REQUEST, MROVER_CC_CSS_LINK_REQUEST, MROVER_CC_SET_CSS_PWR_PROFILE,
+    MROVER_CC_SET_FILTERING_DOWNLINK_SIDEWALK, MROVER_CC_SET_LORAWAN_CLASS, MROVER_CC_START_FILE_TRANSFER,
+    MROVER_CC_TRIGGER_FW_UPDATE, MROVER_CC_LORAWAN_TIME_REQ,
+};
+
+/**
+ * @brief Event codes the former switch of api_processor_parse_get_event() handled
+ */
+static const uint8_t s_former_events[] =
+{
+    MODEM_EVENT_RESET, MODEM_EVENT_ALARM, MODEM_EVENT_JOINED, MODEM_EVENT_TXDONE, MODEM_EVENT_DOWNDATA,
+    MODEM_EVENT_UPLOADDONE, MODEM_EVENT_SETCONF, MODEM_EVENT_MUTE, MODEM_EVENT_STREAMDONE, MODEM_EVENT_JOINFAIL,
+    MODEM_EVENT_TIME, MODEM_EVENT_TIMEOUT_ADR_CHANGED, MODEM_EVENT_NEW_LINK_ADR, MODEM_EVENT_LINK_CHECK,
+    MODEM_EVENT_ALMANAC_UPDATE, MODEM_EVENT_USER_RADIO_ACCESS, MODEM_EVENT_CLASS_B_PING_SLOT_INFO,
+    MODEM_EVENT_CLASS_B_STATUS, MODEM_EVENT_LORAWAN_MAC_TIME, MODEM_EVENT_SEGMENTED_FILE_DOWNLOAD,
+    MODEM_EVENT_CLASS_SWITCHED, MODEM_EVENT_NONE,
+};
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static uint16_t on_send(uint8_t *data, uint16_t size, void *user_context)
+{
+    (void)data;
+    (void)user_context;
+    return size;
+}
+
+static void on_notification(void *user_context)
+{
+    (void)user_context;
+}
+
+static void on_response(const api_processor_response_t *response, void *user_context)
+{
+    (void)user_context;
+    s_responses.push_back(*response);
+}
+
+static bool contains(const uint16_t *p_codes, size_t count, uint16_t u16_code)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (p_codes[i] == u16_code)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static frame_t make_response(uint8_t u8_return_code, uint8_t u8_type, uint16_t u16_code, const frame_t &payload)
+{
+    frame_t frame = { u8_return_code, u8_type, (uint8_t)(u16_code >> 8), (uint8_t)u16_code,
+                      (uint8_t)(payload.size() >> 8), (uint8_t)payload.size() };
+    for (uint8_t u8_byte : payload)
+    {
+        frame.push_back(u8_byte);
+    }
+    frame.push_back(checksum_xor8(0, frame.data(), frame.size()));
+    return frame;
+}
+
+/**
+ * @brief Feeds one frame and returns the number of responses it produced.
+ */
+static size_t feed(frame_t frame)
+{
+    s_responses.clear();
+    api_processor_reset_rx(&s_module);
+    api_processor_parse_rx_data(&s_module, frame.data(), (uint16_t)frame.size());
+    return s_responses.size();
+}
+
+/**
+ * @brief The former switch based return code and command type checks of frame_parser.c, traces removed.
+ */
+static bool reference_is_valid_header(const uint8_t *data)
+{
+    switch (data[0])
+    {
+        case MROVER_RC_OK:
+        case MROVER_RC_UNKNOWN:
+        case MROVER_RC_NOT_IMPLEMENTED:
+        case MROVER_RC_FAIL:
+        case MROVER_RC_BAD_CRC:
+        case MROVER_RC_BAD_SIZE:
+        case MROVER_RC_NOTIFY_EVENTS:
+        case MROVER_RC_GPS_TIME_NOT_AVAILABLE:
+            break;
+        default:
+            return false;
+    }
+
+    switch (data[1])
+    {
+        case COMMAND_TYPE_GENERAL:
+        case COMMAND_TYPE_LORAWAN:
+        case COMMAND_TYPE_SIDEWALK:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief The validation tables accept what the former switches did, for every return code, type and command code.
+ * The provisional MROVER_CC_SET_UART_BAUD is not added, its responses are rejected like any unknown code.
+ */
+static void test_validation_matches_switches()
+{
+    const size_t former_count = sizeof(s_former_codes) / sizeof(s_former_codes[0]);
+    frame_t frame = make_response(MROVER_RC_OK, COMMAND_TYPE_GENERAL, 0, {});
+    uint32_t u32_mismatches = 0;
+
+    for (uint32_t u32_code = 0; u32_code <= UINT16_MAX; u32_code++)
+    {
+        frame[2] = (uint8_t)(u32_code >> 8);
+        frame[3] = (uint8_t)u32_code;
+        for (uint16_t u16_byte = 0; u16_byte <= UINT8_MAX; u16_byte++)
+        {
+            // the return code and the type are swept on the codes of the table range only
+            if ((MROVER_CC_TABLE_SIZE + 0x10 < u32_code) && (0 != u16_byte))
+            {
+                break;
+            }
+            for (uint8_t u8_field = 0; u8_field < 2; u8_field++)
+            {
+                frame[0] = (0 == u8_field) ? (uint8_t)u16_byte : (uint8_t)MROVER_RC_OK;
+                frame[1] = (1 == u8_field) ? (uint8_t)u16_byte : (uint8_t)COMMAND_TYPE_LORAWAN;
+                frame[frame.size() - 1] = checksum_xor8(0, frame.data(), frame.size() - 1);
+
+                bool is_expected = reference_is_valid_header(frame.data()) &&
+                                   contains(s_former_codes, former_count, (uint16_t)u32_code);
+                bool is_valid = (FP_SUCCESS == fp_is_valid_response_frame(frame.data(), (uint16_t)frame.size()));
+                if (is_expected != is_valid)
+                {
+                    u32_mismatches++;
+                }
+            }
+        }
+    }
+    CHECK_EQ(u32_mismatches, 0);
+
+    // a good header with a bad crc is still rejected
+    frame = make_response(MROVER_RC_OK, COMMAND_TYPE_GENERAL, MROVER_CC_RESET, {});
+    frame.back() ^= 0x01;
+    CHECK(FP_INVALID_CRC == fp_is_valid_response_frame(frame.data(), (uint16_t)frame.size()));
+}
+
+/**
+ * @brief Every known command code reaches a parser and completes, the other codes never do.
+ */
+static void test_response_dispatch()
+{
+    const size_t empty_count = sizeof(s_empty_response_codes) / sizeof(s_empty_response_codes[0]);
+
+    for (uint32_t u32_code = 0; u32_code <= MROVER_CC_TABLE_SIZE + 0x10; u32_code++)
+    {
+        bool is_known = contains(s_former_codes, sizeof(s_former_codes) / sizeof(s_former_codes[0]), (uint16_t)u32_code);
+
+        // a failed command completes whatever its payload, the return code is what the caller needs
+        size_t responses = feed(make_response(MROVER_RC_FAIL, COMMAND_TYPE_SIDEWALK, (uint16_t)u32_code, {}));
+        CHECK_EQ(responses, is_known ? 1 : 0);
+        if (1 == responses)
+        {
+            CHECK_EQ(mcm_helper_get_response_code(&s_responses[0]), MROVER_RC_FAIL);
+            CHECK_EQ(mcm_helper_get_command_type(&s_responses[0]), COMMAND_TYPE_SIDEWALK);
+            CHECK_EQ(mcm_helper_get_command_code(&s_responses[0]), u32_code);
+        }
+
+        // the commands without response data accept an empty payload only
+        if (contains(s_empty_response_codes, empty_count, (uint16_t)u32_code))
+        {
+            CHECK_EQ(feed(make_response(MROVER_RC_OK, COMMAND_TYPE_GENERAL, (uint16_t)u32_code, {})), 1);
+            CHECK_EQ(feed(make_response(MROVER_RC_OK, COMMAND_TYPE_GENERAL, (uint16_t)u32_code, { 0x55 })), 0);
+        }
+    }
+
+    // the parsers with data still get the bytes after the header
+    const uint8_t eui[LORAWAN_DEV_EUI_JOIN_EUI_LEN] = { 8, 7, 6, 5, 4, 3, 2, 1 };
+    REQUIRE(1 == feed(make_response(MROVER_RC_OK, COMMAND_TYPE_LORAWAN, MROVER_CC_GET_DEV_EUI, frame_t(eui, eui + sizeof(eui)))));
+    CHECK(0 == memcmp(mcm_helper_get_dev_eui(&s_responses[0]), eui, sizeof(eui)));
+    REQUIRE(1 == feed(make_response(MROVER_RC_OK, COMMAND_TYPE_LORAWAN, MROVER_CC_GET_JOIN_EUI, frame_t(eui, eui + sizeof(eui)))));
+    CHECK(0 == memcmp(mcm_helper_get_join_eui(&s_responses[0]), eui, sizeof(eui)));
+}
+
+/**
+ * @brief Every known event code reaches its parser with the pending count, the other codes are dropped.
+ */
+static void test_event_dispatch()
+{
+    for (uint16_t u16_event = 0; u16_event <= UINT8_MAX; u16_event++)
+    {
+        bool is_known = false;
+        for (uint8_t u8_known : s_former_events)
+        {
+            is_known = is_known || (u8_known == u16_event);
+        }
+
+        // the events with a parser get a payload it accepts, the others ignore it
+        frame_t payload = { (uint8_t)u16_event, 4 };
+        switch (u16_event)
+        {
+            case MODEM_EVENT_RESET:                     payload.insert(payload.end(), { 0x01, 0x02 }); break;
+            case MODEM_EVENT_TXDONE:                    payload.push_back(MROVER_TX_DONE_WITH_ACK); break;
+            case MODEM_EVENT_DOWNDATA:                  payload.insert(payload.end(), { 0xC4, 0x07, 0x0A, 0x11 }); break;
+            case MODEM_EVENT_JOINFAIL:                  payload.push_back(0x01); break;
+            case MODEM_EVENT_LORAWAN_MAC_TIME:          payload.push_back(0x01); break;
+            case MODEM_EVENT_SEGMENTED_FILE_DOWNLOAD:   payload.insert(payload.end(), sizeof(get_seg_file_status_t), 0x01); break;
+            case MODEM_EVENT_CLASS_SWITCHED:            payload.push_back(MROVER_LORAWAN_CLASS_C); break;
+            default:                                    break;
+        }
+
+        size_t responses = feed(make_response(MROVER_RC_OK, COMMAND_TYPE_LORAWAN, MROVER_CC_GET_EVENT, payload));
+        CHECK_EQ(responses, is_known ? 1 : 0);
+        if (1 == responses)
+        {
+            CHECK_EQ(mcm_helper_get_event_code(&s_responses[0]), u16_event);
+            CHECK_EQ(api_processor_get_pending_events(&s_module), 4);
+        }
+    }
+
+    REQUIRE(1 == feed(make_response(MROVER_RC_OK, COMMAND_TYPE_GENERAL, MROVER_CC_GET_EVENT, { MODEM_EVENT_RESET, 0, 0x00, 0x05 })));
+    CHECK_EQ(mcm_helper_get_event_reset_count(&s_responses[0]), 5);
+    REQUIRE(1 == feed(make_response(MROVER_RC_OK, COMMAND_TYPE_LORAWAN, MROVER_CC_GET_EVENT, { MODEM_EVENT_TXDONE, 0, MROVER_TX_DONE_WITHOUT_ACK })));
+    CHECK_EQ(mcm_helper_get_event_tx_status(&s_responses[0]), MROVER_TX_DONE_WITHOUT_ACK);
+    REQUIRE(1 == feed(make_response(MROVER_RC_OK, COMMAND_TYPE_LORAWAN, MROVER_CC_GET_EVENT, { MODEM_EVENT_CLASS_SWITCHED, 0, MROVER_LORAWAN_CLASS_B })));
+    CHECK_EQ(mcm_helper_get_event_new_class(&s_responses[0]), MROVER_LORAWAN_CLASS_B);
+
+    // an event with a payload its parser refuses is dropped
+    CHECK_EQ(feed(make_response(MROVER_RC_OK, COMMAND_TYPE_LORAWAN, MROVER_CC_GET_EVENT, { MODEM_EVENT_TXDONE, 0, 0x07 })), 0);
+    CHECK_EQ(feed(make_response(MROVER_RC_OK, COMMAND_TYPE_LORAWAN, MROVER_CC_GET_EVENT, { MODEM_EVENT_RESET, 0, 0x01 })), 0);
+}
+
+/**
+ * @brief A GET_EVENT response shorter than the event code and the pending count is rejected, the former parser underflowed the length.
+ */
+static void test_short_get_event()
+{
+    CHECK_EQ(feed(make_response(MROVER_RC_OK, COMMAND_TYPE_GENERAL, MROVER_CC_GET_EVENT, {})), 0);
+    CHECK_EQ(feed(make_response(MROVER_RC_OK, COMMAND_TYPE_GENERAL, MROVER_CC_GET_EVENT, { MODEM_EVENT_RESET })), 0);
+    CHECK_EQ(feed(make_response(MROVER_RC_OK, COMMAND_TYPE_GENERAL, MROVER_CC_GET_EVENT, { MODEM_EVENT_NONE, 0 })), 1);
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+int main()
+{
+    REQUIRE(API_PROCESSOR_SUCCESS == api_processor_init(&s_module, on_send, on_notification, on_response));
+
+    test_validation_matches_switches();
+    test_response_dispatch();
+    test_event_dispatch();
+    test_short_get_event();
+    return test_result("test_response_dispatch");
+}
@@ -0,0 +1,304 @@
+/**
+ * @file test_rx_ring.cpp
+ * @author OXIT embedded firmware team
+ * @brief Byte ring between the uart callback and the decoder, alone and hammered from a producer and a consumer thread.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include "test_common.h"
+#include "rx_ring.h"
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <random>
+#include <thread>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+#define RING_SIZE               (256)
+#define STRESS_BYTES            (5UL * 1024UL * 1024UL)
+#define MAX_CHUNK_LEN           (97)
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+typedef struct
+{
+    uint32_t u32_offered;                               // bytes of the producer, STRESS_BYTES and the last chunk
+    uint32_t u32_accepted;                              // bytes the ring took
+    uint32_t u32_dropped;                               // bytes rx_ring_write() refused
+    uint32_t u32_received;                              // bytes read by the consumer
+    uint32_t u32_mismatches;
+} stress_result_t;
+
+/**********************************************************************************************************
+ * STATIC VARIABLES
+ **********************************************************************************************************/
+
+/**********************************************************************************************************
+ * STATIC FUNCTIONS
+ **********************************************************************************************************/
+/**
+ * @brief Byte at position u32_index of the stream, never periodic with the ring size.
+ */
+static uint8_t stream_byte(uint32_t u32_index)
+{
+    return (uint8_t)((u32_index * 131u) ^ (u32_index >> 8) ^ (u32_index >> 17));
+}
+
+static void test_init()
+{
+    rx_ring_t ring;
+    uint8_t au8_buffer[RING_SIZE];
+
+    CHECK(!rx_ring_init(NULL, au8_buffer, sizeof(au8_buffer)));
+    CHECK(!rx_ring_init(&ring, NULL, sizeof(au8_buffer)));
+    CHECK(!rx_ring_init(&ring, au8_buffer, 0));
+    CHECK(!rx_ring_init(&ring, au8_buffer, 200));
+    CHECK(rx_ring_init(&ring, au8_buffer, sizeof(au8_buffer)));
+    CHECK_EQ(rx_ring_get_count(&ring), 0);
+    CHECK_EQ(rx_ring_get_high_water(&ring), 0);
+    CHECK_EQ(rx_ring_get_overrun_count(&ring), 0);
+}
+
+static void test_wrap_and_counters()
+{
+    rx_ring_t ring;
+    uint8_t au8_buffer[16];
+    uint8_t au8_in[24];
+    uint8_t au8_out[24];
+    uint8_t *p_write;
+    const uint8_t *p_read;
+
+    for (uint32_t i = 0; i < sizeof(au8_in); i++)
+    {
+        au8_in[i] = stream_byte(i);
+    }
+    REQUIRE(rx_ring_init(&ring, au8_buffer, sizeof(au8_buffer)));
+
+    // 12 in, 10 out, the next write wraps around the end of the buffer
+    CHECK_EQ(rx_ring_write(&ring, au8_in, 12), 12);
+    CHECK_EQ(rx_ring_read(&ring, au8_out, 10), 10);
+    CHECK(0 == memcmp(au8_out, au8_in, 10));
+    CHECK_EQ(rx_ring_get_write_ptr(&ring, &p_write), 4);
+    CHECK(&au8_buffer[12] == p_write);
+    CHECK_EQ(rx_ring_write(&ring, &au8_in[12], 12), 12);
+    CHECK_EQ(rx_ring_get_count(&ring), 14);
+    CHECK_EQ(rx_ring_get_high_water(&ring), 14);
+
+    // the read pointer stops at the end of the buffer, the rest follows from the start
+    CHECK_EQ(rx_ring_get_read_ptr(&ring, &p_read), 6);
+    CHECK(&au8_buffer[10] == p_read);
+    CHECK(0 == memcmp(p_read, &au8_in[10], 6));
+    rx_ring_consume(&ring, 6);
+    CHECK_EQ(rx_ring_get_read_ptr(&ring, &p_read), 8);
+    CHECK(&au8_buffer[0] == p_read);
+    CHECK(0 == memcmp(p_read, &au8_in[16], 8));
+
+    // 8 more fill the ring, the next 8 are dropped and counted
+    CHECK_EQ(rx_ring_write(&ring, au8_in, 8), 8);
+    CHECK_EQ(rx_ring_write(&ring, au8_in, 8), 0);
+    CHECK_EQ(rx_ring_get_write_ptr(&ring, &p_write), 0);
+    CHECK_EQ(rx_ring_get_count(&ring), 16);
+    CHECK_EQ(rx_ring_get_high_water(&ring), 16);
+    CHECK_EQ(rx_ring_get_overrun_count(&ring), 8);
+    rx_ring_add_overrun(&ring, 3);
+    CHECK_EQ(rx_ring_get_overrun_count(&ring), 11);
+
+    CHECK_EQ(rx_ring_read(&ring, au8_out, sizeof(au8_out)), 16);
+    CHECK(0 == memcmp(au8_out, &au8_in[16], 8));
+    CHECK(0 == memcmp(&au8_out[8], au8_in, 8));
+    CHECK_EQ(rx_ring_get_count(&ring), 0);
+    CHECK_EQ(rx_ring_read(&ring, au8_out, sizeof(au8_out)), 0);
+    CHECK_EQ(rx_ring_get_high_water(&ring), 16);
+}
+
+/**
+ * @brief Moves STRESS_BYTES of the stream through the ring, a producer thread writing chunks of random
+ * length and the consumer reading them back.
+ * Lossless, the producer waits for free space with the zero copy write pointer.
+ * Otherwise it goes through rx_ring_write(), which drops what does not fit as the uart callback does, and
+ * the stream index follows the accepted bytes only.
+ */
+static stress_result_t run_stress(bool is_lossless)
+{
+    rx_ring_t ring;
+    uint8_t au8_buffer[RING_SIZE];
+    stress_result_t result = {};
+    std::atomic<bool> is_done(false);
+    std::atomic<bool> has_dropped(false);
+
+    REQUIRE(rx_ring_init(&ring, au8_buffer, sizeof(au8_buffer)));
+
+    std::thread producer([&]()
+    {
+        std::mt19937 rng(20261017);
+        uint8_t au8_chunk[MAX_CHUNK_LEN];
+        while (result.u32_offered < STRESS_BYTES)
+        {
+            uint16_t u16_len = (uint16_t)(1 + (rng() % MAX_CHUNK_LEN));
+            if (is_lossless)
+            {
+                uint16_t u16_sent = 0;
+                while (u16_sent < u16_len)
+                {
+                    uint8_t *p_dest;
+                    uint16_t u16_free = rx_ring_get_write_ptr(&ring, &p_dest);
+                    if (0 == u16_free)
+                    {
+                        // lets the consumer run on a single core
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    uint16_t u16_chunk = ((u16_len - u16_sent) < u16_free) ? (u16_len - u16_sent) : u16_free;
+                    for (uint16_t i = 0; i < u16_chunk; i++)
+                    {
+                        p_dest[i] = stream_byte(result.u32_accepted + i);
+                    }
+                    rx_ring_commit(&ring, u16_chunk);
+                    result.u32_accepted += u16_chunk;
+                    u16_sent += u16_chunk;
+                }
+            }
+            else
+            {
+                for (uint16_t i = 0; i < u16_len; i++)
+                {
+                    au8_chunk[i] = stream_byte(result.u32_accepted + i);
+                }
+                uint16_t u16_written = rx_ring_write(&ring, au8_chunk, u16_len);
+                result.u32_accepted += u16_written;
+                result.u32_dropped += u16_len - u16_written;
+                if (u16_written < u16_len)
+                {
+                    has_dropped.store(true, std::memory_order_release);
+                }
+            }
+            result.u32_offered += u16_len;
+        }
+        is_done.store(true, std::memory_order_release);
+    });
+
+    std::mt19937 rng(7);
+    uint8_t au8_out[MAX_CHUNK_LEN];
+    bool is_last_pass = false;
+
+    // the consumer starts late in drop mode, the producer overruns the ring at least once
+    while (!is_lossless && !has_dropped.load(std::memory_order_acquire) && !is_done.load(std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+    while (!is_last_pass)
+    {
+        // the last pass reads what was committed before the producer finished
+        is_last_pass = is_done.load(std::memory_order_acquire);
+        for (;;)
+        {
+            const uint8_t *p_src = au8_out;
+            uint16_t u16_len;
+            if (0 == (rng() & 1))
+            {
+                u16_len = rx_ring_get_read_ptr(&ring, &p_src);
+            }
+            else
+            {
+                u16_len = rx_ring_read(&ring, au8_out, (uint16_t)(1 + (rng() % MAX_CHUNK_LEN)));
+            }
+            if (0 == u16_len)
+            {
+                std::this_thread::yield();
+                break;
+            }
+            for (uint16_t i = 0; i < u16_len; i++)
+            {
+                if (stream_byte(result.u32_received + i) != p_src[i])
+                {
+                    result.u32_mismatches++;
+                }
+            }
+            if (au8_out != p_src)
+            {
+                rx_ring_consume(&ring, u16_len);
+            }
+            result.u32_received += u16_len;
+        }
+    }
+    producer.join();
+
+    CHECK_EQ(rx_ring_get_count(&ring), 0);
+    CHECK(rx_ring_get_high_water(&ring) <= RING_SIZE);
+    CHECK_EQ(rx_ring_get_overrun_count(&ring), result.u32_dropped);
+    return result;
+}
+
+static void test_two_threads_lossless()
+{
+    stress_result_t result = run_stress(true);
+
+    CHECK_EQ(result.u32_mismatches, 0);
+    CHECK(STRESS_BYTES <= result.u32_offered);
+    CHECK_EQ(result.u32_accepted, result.u32_offered);
+    CHECK_EQ(result.u32_received, result.u32_offered);
+    CHECK_EQ(result.u32_dropped, 0);
+}
+
+static void test_two_threads_dropping()
+{
+    stress_result_t result = run_stress(false);
+
+    CHECK_EQ(result.u32_mismatches, 0);
+    CHECK(0 < result.u32_dropped);
+    CHECK_EQ(result.u32_accepted + result.u32_dropped, result.u32_offered);
+    CHECK_EQ(result.u32_received, result.u32_accepted);
+}
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTIONS
+ **********************************************************************************************************/
+int main()
+{
+    test_init();
+    test_wrap_and_counters();
+    test_two_threads_lossless();
+    test_two_threads_dropping();
+    return test_result("test_rx_ring");
+}
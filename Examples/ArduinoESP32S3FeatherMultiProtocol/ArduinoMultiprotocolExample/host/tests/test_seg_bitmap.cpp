@@ -0,0 +1,443 @@
+/**
+ * @file test_seg_bitmap.cpp
+ * @author OXIT embedded firmware team
+ * @brief FUOTA segment map against a bool vector, its wire encoding and the decoding of malformed buffers.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include "test_common.h"
+#include "host_fuota.h"
+#include "seg_bitmap.h"
+#include <random>
+#include <vector>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+#define TEST_RANDOM_MAPS            (3000)
+#define TEST_MAX_SEGMENTS           (20000)
+#define TEST_RANDOM_BUFFERS         (200000)
+#define TEST_MAX_BUFFER_LEN         (48)
+#define TEST_DECODE_WORDS           (64)                // storage of the decoded maps, up to 2048 segments
+
+/**********************************************************************************************************
+ * STATIC FUNCTIONS
+ **********************************************************************************************************/
+static uint32_t varint_len(uint32_t u32_value)
+{
+    uint32_t u32_len = 1;
+
+    for (; u32_value >= 0x80; u32_value >>= 7)
+    {
+        u32_len++;
+    }
+    return u32_len;
+}
+
+/**
+ * @brief Map and its reference agree on every segment, the count, the searches and the encoding.
+ *
+ * @return Number of mismatches
+ */
+static uint32_t compare(const seg_bitmap_t *p_map, const std::vector<bool> &reference, std::mt19937 *p_rng)
+{
+    uint32_t u32_count = (uint32_t)reference.size();
+    uint32_t u32_pending = 0;
+    uint32_t u32_mismatches = 0;
+
+    for (uint32_t i = 0; i < u32_count; i++)
+    {
+        u32_pending += reference[i] ? 1 : 0;
+        u32_mismatches += (seg_bitmap_is_pending(p_map, i) != reference[i]) ? 1 : 0;
+    }
+    u32_mismatches += seg_bitmap_is_pending(p_map, u32_count) ? 1 : 0;
+    u32_mismatches += (seg_bitmap_get_count(p_map) != u32_count) ? 1 : 0;
+    u32_mismatches += (seg_bitmap_get_pending_count(p_map) != u32_pending) ? 1 : 0;
+    u32_mismatches += (seg_bitmap_get_progress(p_map) != ((0 == u32_count) ? 100 : ((u32_count - u32_pending) * 100ULL / u32_count))) ? 1 : 0;
+
+    // from the start, from random places and from past the end
+    for (uint32_t u32_try = 0; u32_try < 8; u32_try++)
+    {
+        uint32_t u32_from = (0 == u32_try) ? 0 : (uint32_t)((*p_rng)() % (u32_count + 40));
+        uint32_t u32_expected = SEG_BITMAP_NONE;
+        for (uint32_t i = u32_from; i < u32_count; i++)
+        {
+            if (reference[i])
+            {
+                u32_expected = i;
+                break;
+            }
+        }
+        u32_mismatches += (seg_bitmap_find_pending(p_map, u32_from) != u32_expected) ? 1 : 0;
+    }
+
+    // the encoding is the shorter of the two bodies and decodes to the same map
+    std::vector<uint8_t> buffer(SEG_BITMAP_ENC_MAX_LEN(u32_count));
+    std::vector<uint32_t> words(SEG_BITMAP_WORDS(u32_count) + 1);
+    seg_bitmap_t decoded;
+    uint32_t u32_len = seg_bitmap_encode(p_map, buffer.data(), (uint32_t)buffer.size());
+    uint32_t u32_raw_len = 1 + varint_len(u32_count) + (u32_count + 7) / 8;
+
+    u32_mismatches += ((0 == u32_len) || (u32_len > u32_raw_len)) ? 1 : 0;
+    u32_mismatches += ((SEG_BITMAP_ENC_RAW == buffer[0]) != (u32_len == u32_raw_len)) ? 1 : 0;
+    u32_mismatches += (0 != seg_bitmap_encode(p_map, buffer.data(), u32_len - 1)) ? 1 : 0;
+    if (!seg_bitmap_decode(&decoded, words.data(), (uint32_t)words.size(), buffer.data(), u32_len))
+    {
+        return u32_mismatches + 1;
+    }
+    u32_mismatches += (seg_bitmap_get_count(&decoded) != u32_count) ? 1 : 0;
+    u32_mismatches += (seg_bitmap_get_pending_count(&decoded) != u32_pending) ? 1 : 0;
+    for (uint32_t i = 0; i < u32_count; i++)
+    {
+        u32_mismatches += (seg_bitmap_is_pending(&decoded, i) != reference[i]) ? 1 : 0;
+    }
+    return u32_mismatches;
+}
+
+static void test_init()
+{
+    uint32_t au32_words[3] = { 0xDEADBEEF, 0xDEADBEEF, 0xDEADBEEF };
+    seg_bitmap_t map;
+
+    CHECK(!seg_bitmap_init(&map, au32_words, 2, 65));
+    CHECK(seg_bitmap_init(&map, au32_words, 3, 65));
+    CHECK_EQ(seg_bitmap_get_pending_count(&map), 65);
+    CHECK_EQ(seg_bitmap_get_progress(&map), 0);
+    // the bits past the last segment are cleared
+    CHECK_EQ(au32_words[2], 1);
+    CHECK(!seg_bitmap_is_pending(&map, 65));
+    seg_bitmap_set_pending(&map, 65, false);
+    seg_bitmap_set_pending(&map, 1000, true);
+    CHECK_EQ(seg_bitmap_get_pending_count(&map), 65);
+
+    // setting twice counts once
+    seg_bitmap_set_pending(&map, 64, false);
+    seg_bitmap_set_pending(&map, 64, false);
+    CHECK_EQ(seg_bitmap_get_pending_count(&map), 64);
+    CHECK_EQ(seg_bitmap_find_pending(&map, 64), SEG_BITMAP_NONE);
+
+    CHECK(seg_bitmap_init(&map, NULL, 0, 0));
+    CHECK_EQ(seg_bitmap_get_progress(&map), 100);
+    CHECK_EQ(seg_bitmap_find_pending(&map, 0), SEG_BITMAP_NONE);
+    CHECK_EQ(seg_bitmap_to_status16(&map), 0);
+
+    CHECK_EQ(SEG_BITMAP_WORDS(0), 0);
+    CHECK_EQ(SEG_BITMAP_WORDS(32), 1);
+    CHECK_EQ(SEG_BITMAP_WORDS(33), 2);
+    CHECK_EQ(SEG_BITMAP_WORDS(0xFFFFFFFFUL), 0x8000000UL);
+}
+
+/**
+ * @brief The 16 bit seg_status of the mcm, and its raw encoding which is the status bytes as sent.
+ */
+static void test_status16()
+{
+    uint32_t au32_words[2];
+    seg_bitmap_t map;
+    uint8_t au8_buffer[16];
+
+    CHECK(seg_bitmap_from_status16(&map, au32_words, 2, 0xA5C3, 16));
+    CHECK_EQ(seg_bitmap_get_pending_count(&map), 8);
+    CHECK_EQ(seg_bitmap_to_status16(&map), 0xA5C3);
+    CHECK_EQ(seg_bitmap_find_pending(&map, 2), 6);
+    CHECK_EQ(seg_bitmap_encode(&map, au8_buffer, sizeof(au8_buffer)), 4);
+    CHECK_EQ(au8_buffer[0], SEG_BITMAP_ENC_RAW);
+    CHECK_EQ(au8_buffer[1], 16);
+    CHECK_EQ(au8_buffer[2], 0xC3);
+    CHECK_EQ(au8_buffer[3], 0xA5);
+
+    // status bits past the segments are ignored
+    CHECK(seg_bitmap_from_status16(&map, au32_words, 2, 0xFFFF, 5));
+    CHECK_EQ(seg_bitmap_get_pending_count(&map), 5);
+    CHECK_EQ(seg_bitmap_to_status16(&map), 0x001F);
+
+    // segments past the status stay pending, bit 31 and up included
+    CHECK(seg_bitmap_from_status16(&map, au32_words, 2, 0x0000, 40));
+    CHECK_EQ(seg_bitmap_get_pending_count(&map), 24);
+    CHECK_EQ(seg_bitmap_find_pending(&map, 0), 16);
+    CHECK(seg_bitmap_is_pending(&map, 39));
+}
+
+/**
+ * @brief The package of a GET_SEG_FILE_STATUS response, with the segments its status does not describe.
+ */
+static void test_seg_file_status()
+{
+    uint32_t au32_words[SEG_BITMAP_WORDS(64)];
+    get_seg_file_status_t status = {};
+    seg_bitmap_t map;
+
+    // 1 MB of 64 KB segments, all downloaded
+    status.pkg_size[0] = 0x10;
+    status.seg_size = SEG_SIZE_64;
+    status.seg_status = 0;
+    CHECK(get_seg_bitmap_from_seg_file_status(status, &map, au32_words, SEG_BITMAP_WORDS(64)));
+    CHECK_EQ(seg_bitmap_get_count(&map), 16);
+    CHECK(is_all_segments_downloaded(status));
+
+    status.seg_status = 0x8000;
+    CHECK(!is_all_segments_downloaded(status));
+
+    // 2 MB, 32 segments: the 16 bit status cannot tell that the last ones are done
+    status.pkg_size[0] = 0x20;
+    status.seg_status = 0;
+    CHECK(get_seg_bitmap_from_seg_file_status(status, &map, au32_words, SEG_BITMAP_WORDS(64)));
+    CHECK_EQ(seg_bitmap_get_pending_count(&map), 16);
+    CHECK(!is_all_segments_downloaded(status));
+
+    status.seg_size = 0x0F;
+    CHECK(!get_seg_bitmap_from_seg_file_status(status, &map, au32_words, SEG_BITMAP_WORDS(64)));
+}
+
+static void test_encodings()
+{
+    static uint32_t s_words[SEG_BITMAP_WORDS(10000)];
+    seg_bitmap_t map;
+    uint8_t au8_buffer[SEG_BITMAP_ENC_MAX_LEN(10000)];
+
+    // all downloaded: no run
+    seg_bitmap_init(&map, s_words, SEG_BITMAP_WORDS(10000), 10000);
+    for (uint32_t i = 0; i < 10000; i++)
+    {
+        seg_bitmap_set_pending(&map, i, false);
+    }
+    CHECK_EQ(seg_bitmap_encode(&map, au8_buffer, sizeof(au8_buffer)), 4);
+    CHECK_EQ(au8_buffer[0], SEG_BITMAP_ENC_RUNS);
+
+    // the last 100 missing: one run, gap 9900 and length 99
+    for (uint32_t i = 9900; i < 10000; i++)
+    {
+        seg_bitmap_set_pending(&map, i, true);
+    }
+    CHECK_EQ(seg_bitmap_encode(&map, au8_buffer, sizeof(au8_buffer)), 7);
+
+    // every other one missing: the runs are longer than the raw bitmap
+    for (uint32_t i = 0; i < 10000; i++)
+    {
+        seg_bitmap_set_pending(&map, i, 0 == (i % 2));
+    }
+    CHECK_EQ(seg_bitmap_encode(&map, au8_buffer, sizeof(au8_buffer)), 1 + 2 + 1250);
+    CHECK_EQ(au8_buffer[0], SEG_BITMAP_ENC_RAW);
+    CHECK_EQ(au8_buffer[3], 0x55);
+}
+
+/**
+ * @brief Random maps built by random changes, runs and single segments, against a bool vector.
+ */
+static void test_random_maps()
+{
+    std::mt19937 rng(25);
+    uint32_t u32_mismatches = 0;
+    std::vector<uint32_t> words;
+
+    for (uint32_t u32_round = 0; u32_round < TEST_RANDOM_MAPS; u32_round++)
+    {
+        // mostly small maps around the word edges, some up to TEST_MAX_SEGMENTS
+        uint32_t u32_count = (0 == (u32_round % 10)) ? (rng() % (TEST_MAX_SEGMENTS + 1)) : (rng() % 200);
+        std::vector<bool> reference(u32_count, true);
+        seg_bitmap_t map;
+
+        // storage larger than needed, filled with garbage
+        words.assign(SEG_BITMAP_WORDS(u32_count) + (rng() % 3), 0xA5A5A5A5);
+        REQUIRE(seg_bitmap_init(&map, words.data(), (uint32_t)words.size(), u32_count));
+
+        uint32_t u32_changes = (0 == u32_count) ? 4 : (1 + rng() % (2 * u32_count));
+        uint8_t u8_density = (uint8_t)(rng() % 101);
+        for (uint32_t u32_change = 0; u32_change < u32_changes; u32_change++)
+        {
+            uint32_t u32_index = (uint32_t)(rng() % (u32_count + 8));
+            bool b_pending = (uint8_t)(rng() % 100) < u8_density;
+            uint32_t u32_run = (0 == (rng() % 8)) ? (uint32_t)(rng() % 100) : 1;
+
+            for (uint32_t i = u32_index; i < u32_index + u32_run; i++)
+            {
+                seg_bitmap_set_pending(&map, i, b_pending);
+                if (i < u32_count)
+                {
+                    reference[i] = b_pending;
+                }
+            }
+        }
+        u32_mismatches += compare(&map, reference, &rng);
+    }
+    CHECK_EQ(u32_mismatches, 0);
+}
+
+/**
+ * @brief Random and damaged encodings are refused or give a consistent map, never a read or a write
+ * outside of the buffer or the storage (the sanitizer build checks the accesses).
+ */
+static void test_decode_malformed()
+{
+    std::mt19937 rng(2025);
+    std::vector<uint8_t> buffer;
+    uint32_t au32_words[TEST_DECODE_WORDS];
+    uint32_t u32_accepted = 0;
+    uint32_t u32_inconsistent = 0;
+    seg_bitmap_t map;
+
+    for (uint32_t u32_round = 0; u32_round < TEST_RANDOM_BUFFERS; u32_round++)
+    {
+        buffer.resize(rng() % (TEST_MAX_BUFFER_LEN + 1));
+        for (uint8_t &u8_byte : buffer)
+        {
+            // small values make plausible counts, gaps and runs
+            u8_byte = (0 == (rng() % 2)) ? (uint8_t)(rng() % 0x20) : (uint8_t)rng();
+        }
+        if (!buffer.empty() && (0 != (rng() % 4)))
+        {
+            buffer[0] = (uint8_t)(rng() % 2);
+        }
+        // an exact heap block, a read past the end is caught
+        std::vector<uint8_t> exact(buffer);
+        uint32_t u32_words = (uint32_t)(rng() % (TEST_DECODE_WORDS + 1));
+
+        if (seg_bitmap_decode(&map, au32_words, u32_words, exact.data(), (uint32_t)exact.size()))
+        {
+            uint32_t u32_count = seg_bitmap_get_count(&map);
+            uint32_t u32_pending = 0;
+
+            u32_accepted++;
+            for (uint32_t i = 0; i < u32_count; i++)
+            {
+                u32_pending += seg_bitmap_is_pending(&map, i) ? 1 : 0;
+            }
+            u32_inconsistent += ((u32_pending != seg_bitmap_get_pending_count(&map)) || (SEG_BITMAP_WORDS(u32_count) > u32_words)) ? 1 : 0;
+            // and it can be encoded again
+            std::vector<uint8_t> encoded(SEG_BITMAP_ENC_MAX_LEN(u32_count));
+            uint32_t u32_len = seg_bitmap_encode(&map, encoded.data(), (uint32_t)encoded.size());
+            u32_inconsistent += (0 == u32_len) ? 1 : 0;
+        }
+    }
+    CHECK_EQ(u32_inconsistent, 0);
+    // the generator does reach the valid encodings
+    CHECK(0 < u32_accepted);
+
+    // a count past any storage
+    uint8_t au8_huge[] = { SEG_BITMAP_ENC_RUNS, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0x01, 0x00, 0x00 };
+    CHECK(!seg_bitmap_decode(&map, au32_words, TEST_DECODE_WORDS, au8_huge, sizeof(au8_huge)));
+    au8_huge[0] = SEG_BITMAP_ENC_RAW;
+    CHECK(!seg_bitmap_decode(&map, au32_words, TEST_DECODE_WORDS, au8_huge, sizeof(au8_huge)));
+    // a varint longer than 32 bits
+    uint8_t au8_long[] = { SEG_BITMAP_ENC_RUNS, 0xFF, 0xFF, 0xFF, 0xFF, 0x1F, 0x00 };
+    CHECK(!seg_bitmap_decode(&map, au32_words, TEST_DECODE_WORDS, au8_long, sizeof(au8_long)));
+    // and one whose bits past 32 would wrap to a count of 0
+    uint8_t au8_wrap[] = { SEG_BITMAP_ENC_RUNS, 0x80, 0x80, 0x80, 0x80, 0x10, 0x00 };
+    CHECK(!seg_bitmap_decode(&map, au32_words, TEST_DECODE_WORDS, au8_wrap, sizeof(au8_wrap)));
+
+    // only the shortest form is taken: no empty gap between two runs, no byte after the body
+    uint8_t au8_runs[] = { SEG_BITMAP_ENC_RUNS, 10, 2, 0, 1, 0, 1, 0 };
+    CHECK(!seg_bitmap_decode(&map, au32_words, TEST_DECODE_WORDS, au8_runs, sizeof(au8_runs) - 1));
+    au8_runs[4] = 3;
+    au8_runs[5] = 1;
+    CHECK(seg_bitmap_decode(&map, au32_words, TEST_DECODE_WORDS, au8_runs, sizeof(au8_runs) - 1));
+    CHECK_EQ(seg_bitmap_get_pending_count(&map), 6);
+    CHECK(!seg_bitmap_decode(&map, au32_words, TEST_DECODE_WORDS, au8_runs, sizeof(au8_runs)));
+    uint8_t au8_raw[] = { SEG_BITMAP_ENC_RAW, 10, 0xFF, 0x03, 0x00 };
+    CHECK(seg_bitmap_decode(&map, au32_words, TEST_DECODE_WORDS, au8_raw, sizeof(au8_raw) - 1));
+    CHECK_EQ(seg_bitmap_get_pending_count(&map), 10);
+    CHECK(!seg_bitmap_decode(&map, au32_words, TEST_DECODE_WORDS, au8_raw, sizeof(au8_raw)));
+}
+
+/**
+ * @brief Every truncation and every single byte change of valid encodings.
+ */
+static void test_decode_damaged()
+{
+    std::mt19937 rng(52);
+    uint32_t au32_words[TEST_DECODE_WORDS];
+    uint32_t u32_truncated_accepted = 0;
+    uint32_t u32_inconsistent = 0;
+
+    for (uint32_t u32_round = 0; u32_round < 300; u32_round++)
+    {
+        uint32_t u32_count = (uint32_t)(rng() % (TEST_DECODE_WORDS * 32 + 1));
+        seg_bitmap_t map;
+        seg_bitmap_t decoded;
+
+        seg_bitmap_init(&map, au32_words, TEST_DECODE_WORDS, u32_count);
+        for (uint32_t i = 0; i < u32_count; i++)
+        {
+            seg_bitmap_set_pending(&map, i, (rng() % 100) < (u32_round % 10));
+        }
+        std::vector<uint8_t> encoded(SEG_BITMAP_ENC_MAX_LEN(u32_count));
+        encoded.resize(seg_bitmap_encode(&map, encoded.data(), (uint32_t)encoded.size()));
+
+        std::vector<uint32_t> words(TEST_DECODE_WORDS);
+        for (size_t len = 0; len < encoded.size(); len++)
+        {
+            std::vector<uint8_t> truncated(encoded.begin(), encoded.begin() + len);
+            u32_truncated_accepted += seg_bitmap_decode(&decoded, words.data(), (uint32_t)words.size(), truncated.data(), (uint32_t)len) ? 1 : 0;
+        }
+        for (size_t pos = 0; pos < encoded.size(); pos++)
+        {
+            std::vector<uint8_t> damaged(encoded);
+            damaged[pos] ^= (uint8_t)(1 + (rng() % 255));
+            if (seg_bitmap_decode(&decoded, words.data(), (uint32_t)words.size(), damaged.data(), (uint32_t)damaged.size()))
+            {
+                uint32_t u32_pending = 0;
+                for (uint32_t i = 0; i < seg_bitmap_get_count(&decoded); i++)
+                {
+                    u32_pending += seg_bitmap_is_pending(&decoded, i) ? 1 : 0;
+                }
+                u32_inconsistent += (u32_pending != seg_bitmap_get_pending_count(&decoded)) ? 1 : 0;
+            }
+        }
+    }
+    // a shorter buffer is never taken for a smaller map
+    CHECK_EQ(u32_truncated_accepted, 0);
+    CHECK_EQ(u32_inconsistent, 0);
+}
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTIONS
+ **********************************************************************************************************/
+int main()
+{
+    test_init();
+    test_status16();
+    test_seg_file_status();
+    test_encodings();
+    test_random_maps();
+    test_decode_malformed();
+    test_decode_damaged();
+    return test_result("test_seg_bitmap");
+}
@@ -0,0 +1,292 @@
+/**
+ * @file test_uplink_agg.cpp
+ * @author OXIT embedded firmware team
+ * @brief Container layout of the uplink aggregator, its limits and a randomized pack and unpack round trip.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include "test_common.h"
+#include "uplink_agg.h"
+#include <stdint.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+#define RANDOM_RUNS             (2000)
+#define RECORDS_PER_RUN         (200)
+#define STORAGE_SIZE            (350)
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+typedef std::vector<uint8_t> bytes_t;
+
+typedef struct
+{
+    bytes_t data;
+    uint32_t u32_age_s;
+} unpacked_t;
+
+/**********************************************************************************************************
+ * STATIC VARIABLES
+ **********************************************************************************************************/
+static std::mt19937 s_rng(20261017);
+static const uint16_t s_mtus[] = { 19, 200, 255, 298 };
+
+/**********************************************************************************************************
+ * STATIC FUNCTIONS
+ **********************************************************************************************************/
+static void on_record(const uint8_t *p_data, uint8_t u8_len, uint32_t u32_age_s, void *p_context)
+{
+    std::vector<unpacked_t> *p_records = (std::vector<unpacked_t> *)p_context;
+
+    p_records->push_back({ bytes_t(p_data, p_data + u8_len), u32_age_s });
+}
+
+static std::vector<unpacked_t> unpack(const bytes_t &container)
+{
+    std::vector<unpacked_t> records;
+
+    CHECK_EQ(uplink_agg_unpack(container.data(), (uint16_t)container.size(), on_record, &records), records.size());
+    return records;
+}
+
+static void test_layout()
+{
+    uplink_agg_t agg;
+    uint8_t au8_storage[32];
+    uint8_t au8_out[32];
+    const uint8_t au8_first[] = { 0xAA, 0xBB };
+    const uint8_t au8_second[] = { 0xCC };
+
+    REQUIRE(uplink_agg_init(&agg, au8_storage, sizeof(au8_storage), 900000));
+    CHECK(uplink_agg_add(&agg, au8_first, sizeof(au8_first), 1000));
+    CHECK(uplink_agg_add(&agg, au8_second, sizeof(au8_second), 6500));
+    CHECK_EQ(uplink_agg_get_count(&agg), 2);
+
+    // 5 s to the second record, 195 s from it to the uplink in two LEB128 bytes
+    uint16_t u16_len = uplink_agg_pack(&agg, au8_out, sizeof(au8_out), 201000);
+    const bytes_t expected = { UPLINK_AGG_FORMAT_VERSION, 0x02, 0x05, 0xAA, 0xBB, 0x01, 0xC3, 0x01, 0xCC };
+    CHECK(bytes_t(au8_out, au8_out + u16_len) == expected);
+    CHECK_EQ(uplink_agg_get_count(&agg), 0);
+
+    std::vector<unpacked_t> records = unpack(expected);
+    REQUIRE(2 == records.size());
+    CHECK(bytes_t(au8_first, au8_first + sizeof(au8_first)) == records[0].data);
+    CHECK_EQ(records[0].u32_age_s, 200);
+    CHECK(bytes_t(au8_second, au8_second + sizeof(au8_second)) == records[1].data);
+    CHECK_EQ(records[1].u32_age_s, 195);
+
+    // sent 20000 s later, the last delta grows to three bytes
+    uint8_t au8_aged[32];
+    u16_len = uplink_agg_add_age(expected.data(), (uint16_t)expected.size(), 20000, au8_aged, sizeof(au8_aged));
+    CHECK_EQ(u16_len, expected.size() + 1);
+    records = unpack(bytes_t(au8_aged, au8_aged + u16_len));
+    REQUIRE(2 == records.size());
+    CHECK_EQ(records[0].u32_age_s, 20200);
+    CHECK_EQ(records[1].u32_age_s, 20195);
+    CHECK_EQ(uplink_agg_add_age(expected.data(), (uint16_t)expected.size(), 20000, au8_aged, (uint16_t)expected.size()), 0);
+
+    // longer gaps saturate
+    u16_len = uplink_agg_add_age(expected.data(), (uint16_t)expected.size(), UINT32_MAX, au8_aged, sizeof(au8_aged));
+    records = unpack(bytes_t(au8_aged, au8_aged + u16_len));
+    REQUIRE(2 == records.size());
+    CHECK_EQ(records[1].u32_age_s, UPLINK_AGG_MAX_DELTA_S);
+}
+
+static void test_malformed_containers()
+{
+    const bytes_t valid = { UPLINK_AGG_FORMAT_VERSION, 0x02, 0x05, 0xAA, 0xBB, 0x01, 0xC3, 0x01, 0xCC };
+    uint8_t au8_out[32];
+
+    CHECK_EQ(uplink_agg_unpack(valid.data(), (uint16_t)valid.size(), NULL, NULL), 2);
+    CHECK_EQ(uplink_agg_unpack(valid.data(), 1, NULL, NULL), 0);
+    CHECK_EQ(uplink_agg_unpack(NULL, 1, NULL, NULL), -1);
+    CHECK_EQ(uplink_agg_unpack(valid.data(), 0, NULL, NULL), -1);
+
+    // every truncation of the container is refused, without calling back
+    for (uint16_t u16_len = 2; u16_len < valid.size(); u16_len++)
+    {
+        std::vector<unpacked_t> records;
+        if (5 == u16_len)
+        {
+            continue;       // ends after the first record
+        }
+        CHECK_EQ(uplink_agg_unpack(valid.data(), u16_len, on_record, &records), -1);
+        CHECK(records.empty());
+    }
+
+    bytes_t bad = valid;
+    bad[0] = UPLINK_AGG_FORMAT_VERSION + 1;
+    CHECK_EQ(uplink_agg_unpack(bad.data(), (uint16_t)bad.size(), NULL, NULL), -1);
+    bad = valid;
+    bad[1] = 0;                                         // empty record
+    CHECK_EQ(uplink_agg_unpack(bad.data(), (uint16_t)bad.size(), NULL, NULL), -1);
+    bad = { UPLINK_AGG_FORMAT_VERSION, 0x01, 0x80, 0x80, 0x80, 0x01, 0xCC };
+    CHECK_EQ(uplink_agg_unpack(bad.data(), (uint16_t)bad.size(), NULL, NULL), -1);
+    CHECK_EQ(uplink_agg_add_age(bad.data(), (uint16_t)bad.size(), 1, au8_out, sizeof(au8_out)), 0);
+}
+
+static void test_limits()
+{
+    uplink_agg_t agg;
+    uint8_t au8_storage[16];
+    uint8_t au8_out[32];
+    uint8_t au8_record[6] = { 1, 2, 3, 4, 5, 6 };
+
+    CHECK(!uplink_agg_init(&agg, NULL, sizeof(au8_storage), 0));
+    CHECK(!uplink_agg_init(&agg, au8_storage, 0, 0));
+    REQUIRE(uplink_agg_init(&agg, au8_storage, sizeof(au8_storage), 60000));
+    CHECK(!uplink_agg_add(&agg, au8_record, 0, 0));
+    CHECK(!uplink_agg_pack(&agg, au8_out, sizeof(au8_out), 0));
+
+    // a third record does not fit in 16 bytes, the oldest is dropped
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        au8_record[0] = i;
+        CHECK(uplink_agg_add(&agg, au8_record, sizeof(au8_record), i * 1000));
+    }
+    CHECK_EQ(uplink_agg_get_count(&agg), 2);
+    CHECK_EQ(uplink_agg_get_dropped_count(&agg), 1);
+
+    // 1 + 2 * 8 bytes waiting, a third record reserves the 1 byte delta of the 60 s deadline
+    CHECK(uplink_agg_fits(&agg, 6, 25, 2000));
+    CHECK(!uplink_agg_fits(&agg, 6, 24, 2000));
+    // one record per 10 byte uplink, none in 8 bytes
+    CHECK_EQ(uplink_agg_pack(&agg, au8_out, 8, 2000), 0);
+    CHECK_EQ(uplink_agg_pack(&agg, au8_out, 10, 2000), 9);
+    CHECK_EQ(au8_out[3], 1);
+    CHECK_EQ(uplink_agg_get_count(&agg), 1);
+    CHECK(!uplink_agg_is_due(&agg, 61999));
+    CHECK(uplink_agg_is_due(&agg, 62000));
+    CHECK_EQ(uplink_agg_pack(&agg, au8_out, 10, 2000), 9);
+    CHECK_EQ(au8_out[3], 2);
+    CHECK(!uplink_agg_is_due(&agg, 100000));
+}
+
+/**
+ * @brief Records of random size and gap go through the flush policy of the sketch: a record which does not fit
+ * flushes the waiting ones, the waiting ones are flushed once due or when the next one would not fit.
+ */
+static void test_random_round_trip()
+{
+    uint32_t u32_records = 0;
+    uint32_t u32_uplinks = 0;
+
+    for (uint32_t u32_run = 0; u32_run < RANDOM_RUNS; u32_run++)
+    {
+        uplink_agg_t agg;
+        uint8_t au8_storage[STORAGE_SIZE];
+        uint8_t au8_out[STORAGE_SIZE];
+        uint16_t u16_mtu = s_mtus[s_rng() % (sizeof(s_mtus) / sizeof(s_mtus[0]))];
+        uint8_t u8_max_len = (uint8_t)std::min<uint16_t>(u16_mtu - 5, 40);
+        uint32_t u32_deadline_ms = (1 + s_rng() % 1800) * 1000;
+        uint32_t u32_now_ms = s_rng();
+        std::vector<bytes_t> sent;
+        std::vector<uint32_t> times;
+        size_t next = 0;
+
+        REQUIRE(uplink_agg_init(&agg, au8_storage, sizeof(au8_storage), u32_deadline_ms));
+
+        auto flush = [&]()
+        {
+            uint16_t u16_len = uplink_agg_pack(&agg, au8_out, u16_mtu, u32_now_ms);
+            REQUIRE(0 < u16_len);
+            CHECK(u16_len <= u16_mtu);
+            for (const unpacked_t &record : unpack(bytes_t(au8_out, au8_out + u16_len)))
+            {
+                REQUIRE(next < sent.size());
+                CHECK(record.data == sent[next]);
+                // every record is rebuilt to within one second of its true age
+                uint32_t u32_true_s = (u32_now_ms - times[next]) / 1000;
+                CHECK((record.u32_age_s == u32_true_s) || (record.u32_age_s + 1 == u32_true_s) || (record.u32_age_s == u32_true_s + 1));
+                next++;
+            }
+            u32_uplinks++;
+        };
+
+        for (uint32_t i = 0; i < RECORDS_PER_RUN; i++)
+        {
+            bytes_t record(1 + s_rng() % u8_max_len);
+            for (uint8_t &u8_byte : record)
+            {
+                u8_byte = (uint8_t)s_rng();
+            }
+            u32_now_ms += s_rng() % 120000;
+
+            if (!uplink_agg_fits(&agg, (uint8_t)record.size(), u16_mtu, u32_now_ms))
+            {
+                flush();
+            }
+            CHECK(uplink_agg_add(&agg, record.data(), (uint8_t)record.size(), u32_now_ms));
+            sent.push_back(record);
+            times.push_back(u32_now_ms);
+            if (uplink_agg_is_due(&agg, u32_now_ms) || !uplink_agg_fits(&agg, u8_max_len, u16_mtu, u32_now_ms))
+            {
+                flush();
+            }
+        }
+        while (0 < uplink_agg_get_count(&agg))
+        {
+            flush();
+        }
+        // nothing lost, nothing dropped
+        CHECK_EQ(next, sent.size());
+        CHECK_EQ(uplink_agg_get_dropped_count(&agg), 0);
+        u32_records += (uint32_t)sent.size();
+    }
+    CHECK(u32_uplinks < u32_records);
+}
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTIONS
+ **********************************************************************************************************/
+int main()
+{
+    test_layout();
+    test_malformed_containers();
+    test_limits();
+    test_random_round_trip();
+    return test_result("test_uplink_agg");
+}
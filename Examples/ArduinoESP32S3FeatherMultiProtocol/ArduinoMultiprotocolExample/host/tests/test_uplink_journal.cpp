@@ -0,0 +1,337 @@
+/**
+ * @file test_uplink_journal.cpp
+ * @author OXIT embedded firmware team
+ * @brief Append, replay and checkpoint of the uplink journal on the SPIFFS shim, with resets at random points of the writes.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include "test_common.h"
+#include "test_journal_file.h"
+#include <random>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+#define FUZZ_STEPS              (20000)
+#define FUZZ_CRASH_PERCENT      (5)
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+typedef std::vector<uint8_t> record_t;
+
+/**********************************************************************************************************
+ * STATIC VARIABLES
+ **********************************************************************************************************/
+
+/**********************************************************************************************************
+ * STATIC FUNCTIONS
+ **********************************************************************************************************/
+static record_t make_record(uint32_t u32_id, uint16_t u16_len)
+{
+    record_t record(u16_len);
+
+    for (uint16_t i = 0; i < u16_len; i++)
+    {
+        record[i] = (uint8_t)(u32_id * 31 + i);
+    }
+    return record;
+}
+
+static bool append(uplink_journal_t *p_journal, const record_t &record)
+{
+    return uplink_journal_append(p_journal, record.data(), (uint16_t)record.size());
+}
+
+/**
+ * @brief Peeks the next uplink and checks it against the expected one
+ */
+static bool peek_is(uplink_journal_t *p_journal, const record_t &expected)
+{
+    uint8_t data[UPLINK_JOURNAL_MAX_RECORD_SIZE];
+    uint16_t u16_len = 0;
+
+    if (!uplink_journal_peek(p_journal, data, sizeof(data), &u16_len))
+    {
+        return false;
+    }
+    return record_t(data, data + u16_len) == expected;
+}
+
+static void test_round_trip()
+{
+    TestJournalFile file;
+    uplink_journal_t journal;
+    uint8_t data[UPLINK_JOURNAL_MAX_RECORD_SIZE];
+    uint16_t u16_len = 0;
+    std::vector<record_t> records = { make_record(0, 1), make_record(1, 24), make_record(2, UPLINK_JOURNAL_MAX_RECORD_SIZE) };
+
+    host_fs_format();
+    CHECK(!uplink_journal_open(&journal, NULL, 1024));
+    REQUIRE(uplink_journal_open(&journal, &file.storage, 4096));
+    CHECK_EQ(uplink_journal_get_pending_count(&journal), 0);
+    CHECK(!uplink_journal_peek(&journal, data, sizeof(data), &u16_len));
+    CHECK(!uplink_journal_commit(&journal));
+    CHECK(!uplink_journal_append(&journal, data, 0));
+    CHECK(!uplink_journal_append(&journal, data, UPLINK_JOURNAL_MAX_RECORD_SIZE + 1));
+
+    for (const record_t &record : records)
+    {
+        CHECK(append(&journal, record));
+    }
+    CHECK_EQ(uplink_journal_get_pending_count(&journal), 3);
+    CHECK_EQ(uplink_journal_get_bytes_written(&journal), 1 + 24 + UPLINK_JOURNAL_MAX_RECORD_SIZE + 3 * (UPLINK_JOURNAL_HEADER_LEN + UPLINK_JOURNAL_CRC_LEN));
+
+    // peek gives the same uplink until it is committed
+    CHECK(peek_is(&journal, records[0]));
+    CHECK(peek_is(&journal, records[0]));
+    CHECK(uplink_journal_commit(&journal));
+    CHECK(!uplink_journal_commit(&journal));
+    CHECK(peek_is(&journal, records[1]));
+    CHECK(uplink_journal_commit(&journal));
+
+    // too small a buffer leaves the uplink in the journal
+    CHECK(!uplink_journal_peek(&journal, data, 10, &u16_len));
+    CHECK(peek_is(&journal, records[2]));
+    CHECK(uplink_journal_commit(&journal));
+
+    // the file is removed once every uplink is forwarded
+    CHECK_EQ(uplink_journal_get_pending_count(&journal), 0);
+    CHECK(!SPIFFS.exists(UPLINK_JOURNAL_FILE));
+    CHECK(append(&journal, records[1]));
+    CHECK(peek_is(&journal, records[1]));
+}
+
+/**
+ * @brief The checkpoints tell a new open which uplinks are forwarded
+ */
+static void test_reopen()
+{
+    TestJournalFile file;
+    uplink_journal_t journal;
+
+    host_fs_format();
+    REQUIRE(uplink_journal_open(&journal, &file.storage, 4096));
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        CHECK(append(&journal, make_record(i, 20)));
+    }
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        CHECK(peek_is(&journal, make_record(i, 20)));
+        CHECK(uplink_journal_commit(&journal));
+    }
+    // peeked and not committed, replayed after the reset
+    CHECK(peek_is(&journal, make_record(2, 20)));
+
+    file.reboot();
+    REQUIRE(uplink_journal_open(&journal, &file.storage, 4096));
+    CHECK_EQ(uplink_journal_get_pending_count(&journal), 3);
+    CHECK(peek_is(&journal, make_record(2, 20)));
+    CHECK(uplink_journal_commit(&journal));
+    CHECK(append(&journal, make_record(5, 20)));
+    for (uint32_t i = 3; i < 6; i++)
+    {
+        CHECK(peek_is(&journal, make_record(i, 20)));
+        CHECK(uplink_journal_commit(&journal));
+    }
+    CHECK(!SPIFFS.exists(UPLINK_JOURNAL_FILE));
+}
+
+/**
+ * @brief Entries after a torn one are found again, with the file opened a few times only
+ */
+static void test_torn_entry()
+{
+    TestJournalFile file;
+    uplink_journal_t journal;
+
+    host_fs_format();
+    REQUIRE(uplink_journal_open(&journal, &file.storage, 64 * 1024));
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        CHECK(append(&journal, make_record(i, 200)));
+    }
+    file.crash_after(150);
+    CHECK(!append(&journal, make_record(100, 200)));
+    file.reboot();
+
+    REQUIRE(uplink_journal_open(&journal, &file.storage, 64 * 1024));
+    CHECK_EQ(uplink_journal_get_pending_count(&journal), 100);
+    for (uint32_t i = 101; i < 200; i++)
+    {
+        CHECK(append(&journal, make_record(i, 200)));
+    }
+
+    file.reboot();
+    uint32_t u32_opens = host_fs_get_stats().u32_opens;
+    REQUIRE(uplink_journal_open(&journal, &file.storage, 64 * 1024));
+    CHECK(host_fs_get_stats().u32_opens - u32_opens <= 2);
+    CHECK_EQ(uplink_journal_get_pending_count(&journal), 199);
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        if (100 != i)
+        {
+            CHECK(peek_is(&journal, make_record(i, 200)));
+            CHECK(uplink_journal_commit(&journal));
+        }
+    }
+    CHECK_EQ(uplink_journal_get_pending_count(&journal), 0);
+}
+
+static void test_full()
+{
+    TestJournalFile file;
+    uplink_journal_t journal;
+    const uint16_t u16_entry_len = UPLINK_JOURNAL_HEADER_LEN + 40 + UPLINK_JOURNAL_CRC_LEN;
+
+    host_fs_format();
+    REQUIRE(uplink_journal_open(&journal, &file.storage, 2 * u16_entry_len));
+    CHECK(append(&journal, make_record(0, 40)));
+    CHECK(append(&journal, make_record(1, 40)));
+    CHECK(!append(&journal, make_record(2, 40)));
+    CHECK_EQ(uplink_journal_get_dropped_count(&journal), 1);
+    CHECK_EQ(uplink_journal_get_pending_count(&journal), 2);
+
+    // a full partition cuts the append short, the entry is refused and skipped by the next open
+    host_fs_format();
+    host_fs_set_capacity(u16_entry_len + 20);
+    REQUIRE(uplink_journal_open(&journal, &file.storage, 4096));
+    CHECK(append(&journal, make_record(3, 40)));
+    CHECK(!append(&journal, make_record(4, 40)));
+    CHECK_EQ(uplink_journal_get_dropped_count(&journal), 1);
+
+    // once there is room again the next entry goes after the torn bytes
+    host_fs_set_capacity(HOST_FS_DEFAULT_CAPACITY);
+    CHECK(append(&journal, make_record(5, 40)));
+    CHECK_EQ(uplink_journal_get_pending_count(&journal), 2);
+    CHECK(peek_is(&journal, make_record(3, 40)));
+    CHECK(uplink_journal_commit(&journal));
+    CHECK(peek_is(&journal, make_record(5, 40)));
+    file.reboot();
+    REQUIRE(uplink_journal_open(&journal, &file.storage, 4096));
+    CHECK_EQ(uplink_journal_get_pending_count(&journal), 1);
+    CHECK(peek_is(&journal, make_record(5, 40)));
+}
+
+/**
+ * @brief Random appends and replays with a reset in FUZZ_CRASH_PERCENT of the writes.
+ * After every reset the journal holds exactly the appended uplinks not committed, in order:
+ * no uplink is lost and only the one whose checkpoint was torn is replayed again.
+ */
+static void test_crash_fuzz()
+{
+    TestJournalFile file;
+    uplink_journal_t journal;
+    std::vector<record_t> records;                          // appended, the ones before u32_forwarded are committed
+    uint32_t u32_forwarded = 0;
+    uint32_t u32_crashes = 0;
+    std::mt19937 rng(17);
+
+    host_fs_format();
+    REQUIRE(uplink_journal_open(&journal, &file.storage, UPLINK_JOURNAL_MAX_SIZE));
+    for (uint32_t u32_step = 0; u32_step < FUZZ_STEPS; u32_step++)
+    {
+        // more replays than appends, the journal empties now and then
+        bool b_append = (records.size() == u32_forwarded) || (0 == (rng() % 3));
+        record_t record = make_record((uint32_t)records.size(), (uint16_t)(1 + rng() % 300));
+
+        if ((rng() % 100) < FUZZ_CRASH_PERCENT)
+        {
+            file.crash_after(rng() % (record.size() + UPLINK_JOURNAL_HEADER_LEN + UPLINK_JOURNAL_CRC_LEN));
+        }
+
+        if (b_append)
+        {
+            if (append(&journal, record))
+            {
+                records.push_back(record);
+            }
+            else
+            {
+                CHECK(file.b_crashed);
+            }
+        }
+        else
+        {
+            CHECK(peek_is(&journal, records[u32_forwarded]));
+            if (uplink_journal_commit(&journal))
+            {
+                u32_forwarded++;
+            }
+            else
+            {
+                CHECK(file.b_crashed);
+            }
+        }
+
+        if (file.b_crashed)
+        {
+            u32_crashes++;
+            file.reboot();
+            REQUIRE(uplink_journal_open(&journal, &file.storage, UPLINK_JOURNAL_MAX_SIZE));
+            CHECK_EQ(uplink_journal_get_pending_count(&journal), records.size() - u32_forwarded);
+        }
+        file.crash_after(-1);
+    }
+
+    while (u32_forwarded < records.size())
+    {
+        CHECK(peek_is(&journal, records[u32_forwarded]));
+        CHECK(uplink_journal_commit(&journal));
+        u32_forwarded++;
+    }
+    CHECK(!SPIFFS.exists(UPLINK_JOURNAL_FILE));
+    CHECK(u32_crashes > FUZZ_STEPS * FUZZ_CRASH_PERCENT / 200);
+}
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTIONS
+ **********************************************************************************************************/
+int main()
+{
+    test_round_trip();
+    test_reopen();
+    test_torn_entry();
+    test_full();
+    test_crash_fuzz();
+    return test_result("test_uplink_journal");
+}
@@ -0,0 +1,270 @@
+/**
+ * @file test_uplink_sched.cpp
+ * @author OXIT embedded firmware team
+ * @brief Priority order, eviction and duty cycle budget of the uplink scheduler, and the order MCM sends queued uplinks in.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include "test_mcm.h"
+#include "uplink_sched.h"
+#include <vector>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+#define LINK                    (1)
+#define BIN_MS                  (UPLINK_SCHED_DUTY_WINDOW_MS / UPLINK_SCHED_DUTY_BINS)
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+
+/**********************************************************************************************************
+ * STATIC VARIABLES
+ **********************************************************************************************************/
+// default lorawan profile of MCM, SF9 and the 1% of EU868, 36 s per hour
+static const uplink_sched_link_t s_lorawan = { 1760, 13, 60, 10 };
+static const uint8_t s_payload[UPLINK_SCHED_MAX_PAYLOAD_SIZE] = { 0 };
+
+/**********************************************************************************************************
+ * STATIC FUNCTIONS
+ **********************************************************************************************************/
+static uint32_t add(uplink_sched_t *p_sched, uplink_sched_class_t u8_class, uint16_t u16_len, uint32_t u32_now_ms)
+{
+    uint32_t u32_seq = UINT32_MAX;
+
+    CHECK(uplink_sched_add(p_sched, u8_class, 1, false, s_payload, u16_len, u32_now_ms, &u32_seq));
+    return u32_seq;
+}
+
+/**
+ * @brief Sends the next uplink if it is ready, returns its sequence number or UINT32_MAX.
+ */
+static uint32_t send_next(uplink_sched_t *p_sched, uint32_t u32_now_ms)
+{
+    const uplink_sched_entry_t *p_entry = NULL;
+
+    if (UPLINK_SCHED_READY != uplink_sched_peek(p_sched, LINK, u32_now_ms, &p_entry))
+    {
+        return UINT32_MAX;
+    }
+    uint32_t u32_seq = p_entry->u32_seq;
+    uplink_sched_commit(p_sched, LINK, p_entry, u32_now_ms);
+    return u32_seq;
+}
+
+static void test_airtime()
+{
+    uplink_sched_link_t none = { 0, 0, 0, UPLINK_SCHED_NO_DUTY_LIMIT };
+
+    // 60 ms + 33 bytes at 1760 bit/s, rounded up
+    CHECK_EQ(uplink_sched_airtime_ms(&s_lorawan, 20), 210);
+    CHECK_EQ(uplink_sched_airtime_ms(&s_lorawan, 200), 1029);
+    CHECK_EQ(uplink_sched_airtime_ms(&none, 200), 0);
+}
+
+static void test_priority_order()
+{
+    uplink_sched_t sched;
+    const uplink_sched_entry_t *p_entry = NULL;
+
+    uplink_sched_init(&sched, 0);
+    CHECK_EQ(uplink_sched_peek(&sched, LINK, 0, &p_entry), UPLINK_SCHED_EMPTY);
+    CHECK(!uplink_sched_add(&sched, UPLINK_SCHED_CLASS_COUNT, 1, false, s_payload, 1, 0, NULL));
+    CHECK(!uplink_sched_add(&sched, UPLINK_SCHED_BULK, 1, false, s_payload, 0, 0, NULL));
+    CHECK(!uplink_sched_add(&sched, UPLINK_SCHED_BULK, 1, false, s_payload, UPLINK_SCHED_MAX_PAYLOAD_SIZE + 1, 0, NULL));
+
+    uint32_t u32_bulk = add(&sched, UPLINK_SCHED_BULK, 10, 0);
+    uint32_t u32_telemetry = add(&sched, UPLINK_SCHED_TELEMETRY, 10, 100);
+    uint32_t u32_alarm = add(&sched, UPLINK_SCHED_ALARM, 10, 200);
+    uint32_t u32_telemetry2 = add(&sched, UPLINK_SCHED_TELEMETRY, 10, 300);
+    CHECK_EQ(uplink_sched_get_count(&sched), 4);
+
+    CHECK_EQ(send_next(&sched, 1000), u32_alarm);
+    CHECK_EQ(send_next(&sched, 2000), u32_telemetry);
+    CHECK_EQ(send_next(&sched, 3000), u32_telemetry2);
+    CHECK_EQ(send_next(&sched, 4000), u32_bulk);
+    CHECK_EQ(uplink_sched_get_count(&sched), 0);
+
+    // unlimited link, no airtime is counted against a budget
+    CHECK_EQ(uplink_sched_get_budget_ms(&sched, LINK, 4000), UPLINK_SCHED_DUTY_WINDOW_MS);
+
+    const uplink_sched_stats_t *p_stats = uplink_sched_get_stats(&sched, UPLINK_SCHED_TELEMETRY);
+    REQUIRE(NULL != p_stats);
+    CHECK_EQ(p_stats->u32_sent, 2);
+    CHECK_EQ(p_stats->u32_total_delay_ms, 1900 + 2700);
+    CHECK_EQ(p_stats->u32_max_delay_ms, 2700);
+    CHECK_EQ(uplink_sched_get_stats(&sched, UPLINK_SCHED_BULK)->u32_max_delay_ms, 4000);
+    CHECK(NULL == uplink_sched_get_stats(&sched, UPLINK_SCHED_CLASS_COUNT));
+}
+
+static void test_eviction()
+{
+    uplink_sched_t sched;
+    std::vector<uint32_t> bulk;
+
+    uplink_sched_init(&sched, 0);
+    for (uint8_t i = 0; i < UPLINK_SCHED_QUEUE_SIZE; i++)
+    {
+        bulk.push_back(add(&sched, UPLINK_SCHED_BULK, 10, i));
+    }
+    CHECK(!uplink_sched_add(&sched, UPLINK_SCHED_BULK, 1, false, s_payload, 10, 10, NULL));
+
+    // the newest bulk uplink makes room for the telemetry, then for the alarm
+    uint32_t u32_telemetry = add(&sched, UPLINK_SCHED_TELEMETRY, 10, 20);
+    uint32_t u32_alarm = add(&sched, UPLINK_SCHED_ALARM, 10, 30);
+    CHECK_EQ(uplink_sched_get_count(&sched), UPLINK_SCHED_QUEUE_SIZE);
+    CHECK_EQ(uplink_sched_get_stats(&sched, UPLINK_SCHED_BULK)->u32_dropped, 3);
+
+    CHECK_EQ(send_next(&sched, 100), u32_alarm);
+    CHECK_EQ(send_next(&sched, 100), u32_telemetry);
+    for (uint8_t i = 0; i < UPLINK_SCHED_QUEUE_SIZE - 2; i++)
+    {
+        CHECK_EQ(send_next(&sched, 100), bulk[i]);
+    }
+
+    // a queue full of alarms refuses the next one
+    for (uint8_t i = 0; i < UPLINK_SCHED_QUEUE_SIZE; i++)
+    {
+        add(&sched, UPLINK_SCHED_ALARM, 10, 200);
+    }
+    CHECK(!uplink_sched_add(&sched, UPLINK_SCHED_ALARM, 1, false, s_payload, 10, 200, NULL));
+    CHECK_EQ(uplink_sched_get_stats(&sched, UPLINK_SCHED_ALARM)->u32_dropped, 1);
+}
+
+/**
+ * @brief Budget of the 1% link, the reserves of the classes and the window sliding bin by bin.
+ */
+static void test_duty_cycle()
+{
+    uplink_sched_t sched;
+    const uint32_t u32_limit_ms = 36000;
+    const uplink_sched_entry_t *p_entry = NULL;
+    uint32_t u32_now_ms = 0;
+
+    uplink_sched_init(&sched, 0);
+    CHECK(uplink_sched_set_link(&sched, LINK, &s_lorawan, 0));
+    CHECK(!uplink_sched_set_link(&sched, UPLINK_SCHED_MAX_LINKS, &s_lorawan, 0));
+    CHECK_EQ(uplink_sched_get_budget_ms(&sched, LINK, 0), u32_limit_ms);
+
+    // bulk stops while its 45% reserve is left
+    uint32_t u32_bulk_sent = 0;
+    do
+    {
+        u32_now_ms += 1000;
+        add(&sched, UPLINK_SCHED_BULK, 200, u32_now_ms);
+    } while ((UINT32_MAX != send_next(&sched, u32_now_ms)) && (++u32_bulk_sent < 100));
+    CHECK_EQ(u32_bulk_sent, (u32_limit_ms * (100 - UPLINK_SCHED_BULK_RESERVE_PCT) / 100) / 1029);
+    CHECK_EQ(uplink_sched_get_budget_ms(&sched, LINK, u32_now_ms), u32_limit_ms - u32_bulk_sent * 1029);
+    CHECK_EQ(uplink_sched_peek(&sched, LINK, u32_now_ms, &p_entry), UPLINK_SCHED_WAIT_BUDGET);
+
+    // telemetry and alarms still go out, in front of the waiting bulk
+    uint32_t u32_telemetry = add(&sched, UPLINK_SCHED_TELEMETRY, 20, u32_now_ms);
+    CHECK_EQ(send_next(&sched, u32_now_ms), u32_telemetry);
+    while (UPLINK_SCHED_READY == uplink_sched_check(&sched, LINK, UPLINK_SCHED_TELEMETRY, 20, u32_now_ms))
+    {
+        uplink_sched_charge(&sched, LINK, 20, u32_now_ms);
+    }
+    CHECK(uplink_sched_get_budget_ms(&sched, LINK, u32_now_ms) < (u32_limit_ms * UPLINK_SCHED_TELEMETRY_RESERVE_PCT / 100) + 210);
+    uint32_t u32_alarm = add(&sched, UPLINK_SCHED_ALARM, 20, u32_now_ms);
+    u32_telemetry = add(&sched, UPLINK_SCHED_TELEMETRY, 20, u32_now_ms);
+    CHECK_EQ(send_next(&sched, u32_now_ms), u32_alarm);
+
+    // the telemetry waits and the bulk behind it does not overtake it
+    CHECK_EQ(uplink_sched_peek(&sched, LINK, u32_now_ms, &p_entry), UPLINK_SCHED_WAIT_BUDGET);
+    CHECK_EQ(p_entry->u32_seq, u32_telemetry);
+
+    // the airtime of the first minute leaves the window an hour later
+    CHECK_EQ(uplink_sched_peek(&sched, LINK, UPLINK_SCHED_DUTY_WINDOW_MS + BIN_MS - 1, &p_entry), UPLINK_SCHED_WAIT_BUDGET);
+    CHECK_EQ(send_next(&sched, UPLINK_SCHED_DUTY_WINDOW_MS + BIN_MS), u32_telemetry);
+    CHECK_EQ(uplink_sched_get_budget_ms(&sched, LINK, 3 * UPLINK_SCHED_DUTY_WINDOW_MS), u32_limit_ms);
+}
+
+/**
+ * @brief MCM keeps one uplink in flight, the queued ones follow by class once MODEM_EVENT_TXDONE comes.
+ */
+static void test_mcm_queue_order()
+{
+    TestMcm t("join ok 200\n"
+              "txdone noack 100\n");
+    const uplink_sched_class_t classes[] = { UPLINK_SCHED_BULK, UPLINK_SCHED_BULK, UPLINK_SCHED_TELEMETRY, UPLINK_SCHED_ALARM };
+    const uint8_t expected[] = { 0, 3, 2, 1 };
+    uint32_t u32_msg_id = 0;
+
+    REQUIRE(t.start());
+    REQUIRE(t.join_lorawan());
+    t.emulator.clear_log();
+
+    for (uint8_t i = 0; i < sizeof(classes) / sizeof(classes[0]); i++)
+    {
+        uint8_t payload[] = { i };
+        CHECK(MCM_STATUS::MCM_OK == t.mcm.queue_uplink(payload, sizeof(payload), 10 + i, MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF, classes[i], &u32_msg_id));
+    }
+    // the first bulk uplink is in flight at once
+    CHECK_EQ(t.mcm.get_queued_uplink_count(), 4);
+    CHECK_EQ(t.mcm.get_uplink_stats(UPLINK_SCHED_BULK)->u32_sent, 1);
+    REQUIRE(t.run_until([&]() { return 0 == t.mcm.get_queued_uplink_count(); }));
+
+    const std::vector<mcm_emu_uplink_t> &uplinks = t.emulator.get_uplinks();
+    REQUIRE(sizeof(expected) == uplinks.size());
+    for (uint8_t i = 0; i < sizeof(expected); i++)
+    {
+        CHECK_EQ(uplinks[i].data[0], expected[i]);
+        CHECK_EQ(uplinks[i].u8_port, 10 + expected[i]);
+        // the next uplink follows the txdone of the previous one
+        CHECK((0 == i) || (uplinks[i].u64_time_us - uplinks[i - 1].u64_time_us < 1000000));
+    }
+    CHECK_EQ(t.mcm.get_uplink_stats(UPLINK_SCHED_BULK)->u32_sent, 2);
+    CHECK_EQ(t.mcm.get_uplink_stats(UPLINK_SCHED_ALARM)->u32_sent, 1);
+}
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTIONS
+ **********************************************************************************************************/
+int main()
+{
+    test_airtime();
+    test_priority_order();
+    test_eviction();
+    test_duty_cycle();
+    test_mcm_queue_order();
+    return test_result("test_uplink_sched");
+}
@@ -0,0 +1,334 @@
+/**
+ * @file test_ymodem_block.cpp
+ * @author OXIT embedded firmware team
+ * @brief YModem packet assembler over packets split across reads, several packets in one read, noise and faults.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include "test_common.h"
+#include "test_ymodem_line.h"
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+#define TEST_RANDOM_RUNS            (60)
+#define TEST_MAX_CHUNK              (700)
+#define TEST_IMAGE_MAX_SIZE         (40 * 1024)
+#define TEST_FAULT_PCT              (8)                 // corrupted packets and lost acks
+
+/**********************************************************************************************************
+ * STATIC FUNCTIONS
+ **********************************************************************************************************/
+static std::vector<uint8_t> pattern(size_t len, uint8_t u8_seed)
+{
+    std::vector<uint8_t> data(len);
+
+    for (size_t i = 0; i < len; i++)
+    {
+        data[i] = (uint8_t)(i * 13 + u8_seed);
+    }
+    return data;
+}
+
+/**
+ * @brief Pushes all of the bytes, returns the results other than YMODEM_BLOCK_NEED_MORE in order
+ */
+static std::vector<ymodem_block_result_t> push_all(ymodem_block_t *p_block, const std::vector<uint8_t> &bytes)
+{
+    std::vector<ymodem_block_result_t> results;
+    uint16_t u16_used = 0;
+
+    while (u16_used < bytes.size())
+    {
+        ymodem_block_result_t result = YMODEM_BLOCK_NEED_MORE;
+        u16_used += ymodem_block_push(p_block, bytes.data() + u16_used, (uint16_t)(bytes.size() - u16_used), &result);
+        if (YMODEM_BLOCK_NEED_MORE != result)
+        {
+            results.push_back(result);
+        }
+    }
+    return results;
+}
+
+static void test_soh_and_stx()
+{
+    ymodem_block_t block;
+    std::vector<uint8_t> header = pattern(YMODEM_BLOCK_SOH_SIZE, 1);
+    std::vector<uint8_t> data = pattern(YMODEM_BLOCK_STX_SIZE, 2);
+    uint16_t u16_len = 0;
+    uint8_t u8_number = 0xFF;
+
+    ymodem_block_init(&block);
+    CHECK(!ymodem_block_is_partial(&block));
+    CHECK(std::vector<ymodem_block_result_t>{ YMODEM_BLOCK_DATA } ==
+          push_all(&block, test_ymodem_packet(0, header.data(), header.size(), YMODEM_BLOCK_SOH_SIZE)));
+    const uint8_t *p_data = ymodem_block_get_data(&block, &u16_len, &u8_number);
+    CHECK_EQ(u16_len, YMODEM_BLOCK_SOH_SIZE);
+    CHECK_EQ(u8_number, 0);
+    CHECK(0 == memcmp(p_data, header.data(), header.size()));
+
+    CHECK(std::vector<ymodem_block_result_t>{ YMODEM_BLOCK_DATA } ==
+          push_all(&block, test_ymodem_packet(1, data.data(), data.size(), YMODEM_BLOCK_STX_SIZE)));
+    p_data = ymodem_block_get_data(&block, &u16_len, NULL);
+    CHECK_EQ(u16_len, YMODEM_BLOCK_STX_SIZE);
+    CHECK(0 == memcmp(p_data, data.data(), data.size()));
+    CHECK_EQ(ymodem_block_get_stats(&block)->u32_blocks, 2);
+}
+
+/**
+ * @brief A packet split at every byte completes on its last byte, and only there.
+ */
+static void test_split_at_every_byte()
+{
+    std::vector<uint8_t> data = pattern(YMODEM_BLOCK_STX_SIZE, 3);
+    std::vector<uint8_t> packet = test_ymodem_packet(0, data.data(), data.size(), YMODEM_BLOCK_STX_SIZE);
+    uint32_t u32_failures = 0;
+
+    for (size_t split = 1; split < packet.size(); split++)
+    {
+        ymodem_block_t block;
+        ymodem_block_result_t result = YMODEM_BLOCK_NEED_MORE;
+
+        ymodem_block_init(&block);
+        u32_failures += (split != ymodem_block_push(&block, packet.data(), (uint16_t)split, &result)) ? 1 : 0;
+        u32_failures += ((YMODEM_BLOCK_NEED_MORE != result) || !ymodem_block_is_partial(&block)) ? 1 : 0;
+        ymodem_block_push(&block, packet.data() + split, (uint16_t)(packet.size() - split), &result);
+        u32_failures += ((YMODEM_BLOCK_DATA != result) || ymodem_block_is_partial(&block)) ? 1 : 0;
+    }
+    CHECK_EQ(u32_failures, 0);
+
+    // one byte per read
+    ymodem_block_t block;
+    uint32_t u32_results = 0;
+    ymodem_block_init(&block);
+    for (uint8_t u8_byte : packet)
+    {
+        ymodem_block_result_t result = YMODEM_BLOCK_NEED_MORE;
+        CHECK_EQ(ymodem_block_push(&block, &u8_byte, 1, &result), 1);
+        u32_results += (YMODEM_BLOCK_NEED_MORE != result) ? 1 : 0;
+    }
+    CHECK_EQ(u32_results, 1);
+    CHECK_EQ(ymodem_block_get_stats(&block)->u32_blocks, 1);
+}
+
+/**
+ * @brief A read with the end of a packet and the next packets, the push stops at each packet end.
+ */
+static void test_packets_in_one_read()
+{
+    ymodem_block_t block;
+    std::vector<uint8_t> bytes;
+    std::vector<uint8_t> data = pattern(YMODEM_BLOCK_SOH_SIZE, 4);
+    ymodem_block_result_t result = YMODEM_BLOCK_NEED_MORE;
+
+    for (uint8_t u8_number = 0; u8_number < 3; u8_number++)
+    {
+        std::vector<uint8_t> packet = test_ymodem_packet(u8_number, data.data(), data.size(), YMODEM_BLOCK_SOH_SIZE);
+        bytes.insert(bytes.end(), packet.begin(), packet.end());
+    }
+    bytes.push_back(TEST_YMODEM_EOT);
+
+    ymodem_block_init(&block);
+    CHECK_EQ(ymodem_block_push(&block, bytes.data(), 100, &result), 100);
+    CHECK(YMODEM_BLOCK_NEED_MORE == result);
+    CHECK_EQ(ymodem_block_push(&block, bytes.data() + 100, (uint16_t)(bytes.size() - 100), &result), 133 - 100);
+    CHECK(YMODEM_BLOCK_DATA == result);
+    CHECK((std::vector<ymodem_block_result_t>{ YMODEM_BLOCK_DATA, YMODEM_BLOCK_DATA, YMODEM_BLOCK_EOT }) ==
+          push_all(&block, std::vector<uint8_t>(bytes.begin() + 133, bytes.end())));
+}
+
+static void test_duplicate_and_sequence()
+{
+    ymodem_block_t block;
+    std::vector<uint8_t> data = pattern(YMODEM_BLOCK_SOH_SIZE, 5);
+    uint8_t u8_number = 0;
+    uint16_t u16_len = 0;
+
+    // block 0 again before any block is the header of another transfer
+    ymodem_block_init(&block);
+    CHECK(std::vector<ymodem_block_result_t>{ YMODEM_BLOCK_SEQUENCE_ERROR } ==
+          push_all(&block, test_ymodem_packet(0xFF, data.data(), data.size(), YMODEM_BLOCK_SOH_SIZE)));
+
+    ymodem_block_init(&block);
+    CHECK(std::vector<ymodem_block_result_t>{ YMODEM_BLOCK_DATA } ==
+          push_all(&block, test_ymodem_packet(0, data.data(), data.size(), YMODEM_BLOCK_SOH_SIZE)));
+    CHECK(std::vector<ymodem_block_result_t>{ YMODEM_BLOCK_DATA } ==
+          push_all(&block, test_ymodem_packet(1, data.data(), data.size(), YMODEM_BLOCK_SOH_SIZE)));
+    CHECK(std::vector<ymodem_block_result_t>{ YMODEM_BLOCK_DUPLICATE } ==
+          push_all(&block, test_ymodem_packet(1, data.data(), data.size(), YMODEM_BLOCK_SOH_SIZE)));
+    ymodem_block_get_data(&block, &u16_len, &u8_number);
+    CHECK_EQ(u8_number, 1);
+    CHECK_EQ(ymodem_block_get_stats(&block)->u32_duplicates, 1);
+
+    // a skipped block loses the transfer, an older one too
+    CHECK(std::vector<ymodem_block_result_t>{ YMODEM_BLOCK_SEQUENCE_ERROR } ==
+          push_all(&block, test_ymodem_packet(3, data.data(), data.size(), YMODEM_BLOCK_SOH_SIZE)));
+    CHECK(std::vector<ymodem_block_result_t>{ YMODEM_BLOCK_SEQUENCE_ERROR } ==
+          push_all(&block, test_ymodem_packet(0, data.data(), data.size(), YMODEM_BLOCK_SOH_SIZE)));
+    CHECK(std::vector<ymodem_block_result_t>{ YMODEM_BLOCK_DATA } ==
+          push_all(&block, test_ymodem_packet(2, data.data(), data.size(), YMODEM_BLOCK_SOH_SIZE)));
+
+    // the block number wraps after 255
+    uint32_t u32_failures = 0;
+    for (uint32_t u32_number = 3; u32_number < 260; u32_number++)
+    {
+        std::vector<ymodem_block_result_t> results =
+            push_all(&block, test_ymodem_packet((uint8_t)u32_number, data.data(), data.size(), YMODEM_BLOCK_SOH_SIZE));
+        u32_failures += (std::vector<ymodem_block_result_t>{ YMODEM_BLOCK_DATA } != results) ? 1 : 0;
+    }
+    CHECK_EQ(u32_failures, 0);
+}
+
+static void test_bad_packets()
+{
+    ymodem_block_t block;
+    std::vector<uint8_t> data = pattern(YMODEM_BLOCK_STX_SIZE, 6);
+    std::vector<uint8_t> packet = test_ymodem_packet(0, data.data(), data.size(), YMODEM_BLOCK_STX_SIZE);
+
+    ymodem_block_init(&block);
+    for (size_t index : { (size_t)1, (size_t)2, (size_t)500, packet.size() - 2, packet.size() - 1 })
+    {
+        std::vector<uint8_t> bad = packet;
+        bad[index] ^= 0x10;
+        CHECK(std::vector<ymodem_block_result_t>{ YMODEM_BLOCK_BAD } == push_all(&block, bad));
+    }
+    CHECK_EQ(ymodem_block_get_stats(&block)->u32_bad, 5);
+
+    // the bad packets did not move the expected block
+    CHECK(std::vector<ymodem_block_result_t>{ YMODEM_BLOCK_DATA } == push_all(&block, packet));
+    CHECK_EQ(ymodem_block_get_stats(&block)->u32_blocks, 1);
+}
+
+static void test_eot_can_and_noise()
+{
+    ymodem_block_t block;
+    std::vector<uint8_t> data = pattern(YMODEM_BLOCK_SOH_SIZE, 7);
+    std::vector<uint8_t> bytes = { 0x00, 0xFF, 'C', TEST_YMODEM_CAN, 0x55 };
+    std::vector<uint8_t> packet = test_ymodem_packet(0, data.data(), data.size(), YMODEM_BLOCK_SOH_SIZE);
+
+    // noise and a single CAN before a packet are skipped
+    ymodem_block_init(&block);
+    bytes.insert(bytes.end(), packet.begin(), packet.end());
+    CHECK(std::vector<ymodem_block_result_t>{ YMODEM_BLOCK_DATA } == push_all(&block, bytes));
+    CHECK_EQ(ymodem_block_get_stats(&block)->u32_noise, 4);
+
+    // two CAN in a row cancel, also across reads
+    CHECK(std::vector<ymodem_block_result_t>{ YMODEM_BLOCK_CAN } == push_all(&block, { TEST_YMODEM_CAN, TEST_YMODEM_CAN }));
+    CHECK(push_all(&block, { TEST_YMODEM_CAN }).empty());
+    CHECK(std::vector<ymodem_block_result_t>{ YMODEM_BLOCK_CAN } == push_all(&block, { TEST_YMODEM_CAN }));
+    CHECK(push_all(&block, { TEST_YMODEM_CAN, 0x00, TEST_YMODEM_CAN }).empty());
+
+    // a CAN inside a packet is data
+    std::vector<uint8_t> cans(YMODEM_BLOCK_SOH_SIZE, TEST_YMODEM_CAN);
+    CHECK(std::vector<ymodem_block_result_t>{ YMODEM_BLOCK_DATA } ==
+          push_all(&block, test_ymodem_packet(1, cans.data(), cans.size(), YMODEM_BLOCK_SOH_SIZE)));
+
+    CHECK(std::vector<ymodem_block_result_t>{ YMODEM_BLOCK_EOT } == push_all(&block, { TEST_YMODEM_EOT }));
+}
+
+/**
+ * @brief A packet cut short by a silent line is dropped, the sender repeats it in full.
+ */
+static void test_discard()
+{
+    ymodem_block_t block;
+    std::vector<uint8_t> data = pattern(YMODEM_BLOCK_STX_SIZE, 8);
+    std::vector<uint8_t> packet = test_ymodem_packet(0, data.data(), data.size(), YMODEM_BLOCK_STX_SIZE);
+    ymodem_block_result_t result = YMODEM_BLOCK_NEED_MORE;
+
+    ymodem_block_init(&block);
+    ymodem_block_push(&block, packet.data(), 600, &result);
+    CHECK(ymodem_block_is_partial(&block));
+    ymodem_block_discard(&block);
+    CHECK(!ymodem_block_is_partial(&block));
+    CHECK(std::vector<ymodem_block_result_t>{ YMODEM_BLOCK_DATA } == push_all(&block, packet));
+}
+
+/**
+ * @brief Images sent over a line with random reads, corrupted packets and lost acks arrive intact.
+ */
+static void test_random_fragmented_streams()
+{
+    std::mt19937 rng(23);
+    uint32_t u32_failures = 0;
+    uint32_t u32_duplicates = 0;
+    uint32_t u32_bad = 0;
+
+    for (uint32_t u32_run = 0; u32_run < TEST_RANDOM_RUNS; u32_run++)
+    {
+        test_ymodem_line_t line = { 1.0 + (double)(rng() % TEST_MAX_CHUNK), (0 == (u32_run % 3)) ? (uint16_t)YMODEM_BLOCK_SOH_SIZE
+                                                                                                 : (uint16_t)YMODEM_BLOCK_STX_SIZE,
+                                    TEST_FAULT_PCT, TEST_FAULT_PCT };
+        std::vector<uint8_t> image(1 + (rng() % TEST_IMAGE_MAX_SIZE));
+        TestYModemReceiver receiver;
+
+        for (uint8_t &u8_byte : image)
+        {
+            u8_byte = (uint8_t)rng();
+        }
+        test_ymodem_transfer_t transfer =
+            test_ymodem_send(image, line, &rng, [&](const uint8_t *p_data, uint16_t u16_len) { return receiver.receive(p_data, u16_len); });
+
+        u32_failures += (!transfer.b_complete || receiver.b_cancelled || (receiver.image != image)) ? 1 : 0;
+        u32_duplicates += receiver.get_stats()->u32_duplicates;
+        u32_bad += receiver.get_stats()->u32_bad;
+    }
+    CHECK_EQ(u32_failures, 0);
+    // the runs did go through both faults
+    CHECK(0 < u32_duplicates);
+    CHECK(0 < u32_bad);
+}
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTIONS
+ **********************************************************************************************************/
+int main()
+{
+    test_soh_and_stx();
+    test_split_at_every_byte();
+    test_packets_in_one_read();
+    test_duplicate_and_sequence();
+    test_bad_packets();
+    test_eot_can_and_noise();
+    test_discard();
+    test_random_fragmented_streams();
+    return test_result("test_ymodem_block");
+}
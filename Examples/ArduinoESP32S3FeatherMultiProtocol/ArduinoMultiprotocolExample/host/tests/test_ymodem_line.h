@@ -0,0 +1,275 @@
+/**
+ * @file test_ymodem_line.h
+ * @author OXIT embedded firmware team
+ * @brief YModem sender over a line that splits the packets into random reads, corrupts packets and loses acks.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+#ifndef __TEST_YMODEM_LINE_H__
+#define __TEST_YMODEM_LINE_H__
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include "checksum.h"
+#include "ymodem_block.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+#define TEST_YMODEM_SOH             0x01
+#define TEST_YMODEM_STX             0x02
+#define TEST_YMODEM_EOT             0x04
+#define TEST_YMODEM_CAN             0x18
+#define TEST_YMODEM_PAD             0x1A
+
+/**
+ * @brief Attempts of one packet before the sender gives up
+ */
+#define TEST_YMODEM_MAX_ATTEMPTS    (20)
+
+/**
+ * @brief Bad packets in a row before the receiver cancels, YMODEM_MAX_CRC_ERRORS of ymodem.h
+ */
+#define TEST_YMODEM_MAX_CRC_ERRORS  (10)
+
+/**********************************************************************************************************
+ * TYPEDEFS AND CLASSES
+ **********************************************************************************************************/
+
+/**
+ * @brief Answer of the receiver to the bytes of one read
+ */
+typedef enum
+{
+    TEST_YMODEM_NONE,
+    TEST_YMODEM_ACK,
+    TEST_YMODEM_NAK,
+    TEST_YMODEM_CANCEL
+} test_ymodem_reply_t;
+
+/**
+ * @brief Faults of the line, in percent of the packets
+ */
+typedef struct
+{
+    double d_mean_chunk;                                // mean size of a read, exponential, at least 1 byte
+    uint16_t u16_block_size;                            // YMODEM_BLOCK_SOH_SIZE or YMODEM_BLOCK_STX_SIZE
+    uint32_t u32_corrupt_pct;                           // one byte of the packet flipped
+    uint32_t u32_lost_ack_pct;                          // the ack never reaches the sender, which sends the packet again
+} test_ymodem_line_t;
+
+typedef struct
+{
+    bool b_complete;                                    // the EOT was acknowledged
+    uint32_t u32_packets;                               // packets sent, repeats included
+    uint64_t u64_bytes;                                 // bytes on the line
+    uint32_t u32_naks;
+} test_ymodem_transfer_t;
+
+typedef std::function<test_ymodem_reply_t(const uint8_t *p_data, uint16_t u16_len)> test_ymodem_receiver_fn;
+
+/**
+ * @brief Packet of a block, data padded to the block size
+ */
+static inline std::vector<uint8_t> test_ymodem_packet(uint8_t u8_number, const uint8_t *p_data, size_t len, uint16_t u16_block_size)
+{
+    std::vector<uint8_t> packet = { (YMODEM_BLOCK_SOH_SIZE == u16_block_size) ? (uint8_t)TEST_YMODEM_SOH : (uint8_t)TEST_YMODEM_STX, u8_number,
+                                    (uint8_t)~u8_number };
+
+    packet.insert(packet.end(), p_data, p_data + len);
+    packet.resize(YMODEM_BLOCK_HEADER_LEN + u16_block_size, (0 == u8_number) ? 0 : TEST_YMODEM_PAD);
+    uint16_t u16_crc = checksum_crc16_ccitt(CHECKSUM_CRC16_XMODEM_INIT, packet.data() + YMODEM_BLOCK_HEADER_LEN, u16_block_size);
+    packet.push_back((uint8_t)(u16_crc >> 8));
+    packet.push_back((uint8_t)u16_crc);
+    return packet;
+}
+
+/**
+ * @brief Sends image with the header block first, then the EOT. Each packet goes out in reads of random
+ * size and the sender acts on the first answer, a packet without an answer is sent again.
+ */
+static inline test_ymodem_transfer_t test_ymodem_send(const std::vector<uint8_t> &image, const test_ymodem_line_t &line, std::mt19937 *p_rng,
+                                                      test_ymodem_receiver_fn receiver)
+{
+    std::exponential_distribution<double> chunk(1.0 / line.d_mean_chunk);
+    std::vector<std::vector<uint8_t>> packets;
+    std::string header = std::string("mcm_fw.bin") + '\0' + std::to_string(image.size());
+    test_ymodem_transfer_t result = {};
+
+    packets.push_back(test_ymodem_packet(0, (const uint8_t *)header.data(), header.size() + 1, YMODEM_BLOCK_SOH_SIZE));
+    for (size_t offset = 0; offset < image.size(); offset += line.u16_block_size)
+    {
+        packets.push_back(test_ymodem_packet((uint8_t)(packets.size()), image.data() + offset,
+                                             std::min((size_t)line.u16_block_size, image.size() - offset), line.u16_block_size));
+    }
+    packets.push_back({ TEST_YMODEM_EOT });
+
+    for (const std::vector<uint8_t> &packet : packets)
+    {
+        bool b_acked = false;
+
+        for (uint32_t u32_attempt = 0; !b_acked && (u32_attempt < TEST_YMODEM_MAX_ATTEMPTS); u32_attempt++)
+        {
+            std::vector<uint8_t> sent = packet;
+            test_ymodem_reply_t reply = TEST_YMODEM_NONE;
+
+            if ((1 < sent.size()) && ((*p_rng)() % 100) < line.u32_corrupt_pct)
+            {
+                sent[1 + ((*p_rng)() % (sent.size() - 1))] ^= (uint8_t)(1 + ((*p_rng)() % 255));
+            }
+            result.u32_packets++;
+            result.u64_bytes += sent.size();
+
+            for (size_t offset = 0; offset < sent.size();)
+            {
+                size_t len = std::min(sent.size() - offset, (size_t)1 + (size_t)chunk(*p_rng));
+                test_ymodem_reply_t answer = receiver(sent.data() + offset, (uint16_t)len);
+                offset += len;
+                if (TEST_YMODEM_NONE == reply)
+                {
+                    reply = answer;
+                }
+            }
+
+            if (TEST_YMODEM_CANCEL == reply)
+            {
+                return result;
+            }
+            result.u32_naks += (TEST_YMODEM_NAK == reply) ? 1 : 0;
+            b_acked = (TEST_YMODEM_ACK == reply) && (((*p_rng)() % 100) >= line.u32_lost_ack_pct);
+        }
+        if (!b_acked)
+        {
+            return result;
+        }
+    }
+    result.b_complete = true;
+    return result;
+}
+
+/**
+ * @brief Receiver of ymodem.cpp on the assembler: a block is written once, a duplicate only acknowledged,
+ * TEST_YMODEM_MAX_CRC_ERRORS bad packets in a row or a block out of sequence cancel.
+ */
+class TestYModemReceiver
+{
+    public:
+    std::vector<uint8_t> image;
+    bool b_cancelled = false;
+
+    TestYModemReceiver()
+    {
+        ymodem_block_init(&block);
+    }
+
+    test_ymodem_reply_t receive(const uint8_t *p_data, uint16_t u16_len)
+    {
+        test_ymodem_reply_t reply = TEST_YMODEM_NONE;
+        uint16_t u16_used = 0;
+
+        while ((u16_used < u16_len) && !b_cancelled)
+        {
+            ymodem_block_result_t result = YMODEM_BLOCK_NEED_MORE;
+            u16_used += ymodem_block_push(&block, p_data + u16_used, u16_len - u16_used, &result);
+            if (YMODEM_BLOCK_NEED_MORE != result)
+            {
+                reply = process(result);
+            }
+        }
+        return reply;
+    }
+
+    const ymodem_block_stats_t *get_stats() const { return ymodem_block_get_stats(&block); }
+
+    private:
+    ymodem_block_t block;
+    uint32_t u32_remaining = 0;
+    uint8_t u8_crc_errors = 0;
+    bool b_header = false;                              // the block numbers wrap, block 0 is the header only once
+
+    test_ymodem_reply_t cancel()
+    {
+        b_cancelled = true;
+        return TEST_YMODEM_CANCEL;
+    }
+
+    test_ymodem_reply_t process(ymodem_block_result_t result)
+    {
+        uint16_t u16_data_len = 0;
+        const uint8_t *p_data = NULL;
+
+        switch (result)
+        {
+        case YMODEM_BLOCK_BAD:
+            return (++u8_crc_errors >= TEST_YMODEM_MAX_CRC_ERRORS) ? cancel() : TEST_YMODEM_NAK;
+        case YMODEM_BLOCK_SEQUENCE_ERROR:
+        case YMODEM_BLOCK_CAN:
+            return cancel();
+        case YMODEM_BLOCK_EOT:
+        case YMODEM_BLOCK_DUPLICATE:
+            return TEST_YMODEM_ACK;
+        case YMODEM_BLOCK_DATA:
+            u8_crc_errors = 0;
+            p_data = ymodem_block_get_data(&block, &u16_data_len, NULL);
+            if (!b_header)
+            {
+                b_header = true;
+                u32_remaining = (uint32_t)strtoul((const char *)p_data + strlen((const char *)p_data) + 1, NULL, 10);
+            }
+            else
+            {
+                uint32_t u32_write = std::min((uint32_t)u16_data_len, u32_remaining);
+                image.insert(image.end(), p_data, p_data + u32_write);
+                u32_remaining -= u32_write;
+            }
+            return TEST_YMODEM_ACK;
+        default:
+            return TEST_YMODEM_NONE;
+        }
+    }
+};
+
+#endif // __TEST_YMODEM_LINE_H__
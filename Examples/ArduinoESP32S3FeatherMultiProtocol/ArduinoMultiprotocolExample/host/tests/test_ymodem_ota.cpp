@@ -0,0 +1,233 @@
+/**
+ * @file test_ymodem_ota.cpp
+ * @author OXIT embedded firmware team
+ * @brief YModem receiver writing the blocks straight into the OTA partition or staging them in SPIFFS, and its abort paths.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include "test_mcm.h"
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+#define TEST_IMAGE_SIZE             (100 * 1024 + 300)  // last block partly padded
+#define TEST_TRANSFER_TIMEOUT_MS    (300000)
+#define TEST_FUOTA_FILE_NAME        "/fota.bin"         // staging file of ymodem.cpp
+
+/**********************************************************************************************************
+ * STATIC FUNCTIONS
+ **********************************************************************************************************/
+static std::vector<uint8_t> make_image(size_t size)
+{
+    std::vector<uint8_t> image(size);
+
+    for (size_t i = 0; i < image.size(); i++)
+    {
+        image[i] = (uint8_t)((i * 7) ^ (i >> 8));
+    }
+    image[0] = ESP_IMAGE_HEADER_MAGIC;
+    return image;
+}
+
+/**
+ * @brief Starts the transfer of image, the modem is booted first.
+ */
+static void start_transfer(TestMcm &t, const std::vector<uint8_t> &image, bool b_stream_to_ota)
+{
+    ver_type_1_t version = { 1, 2, 3 };
+
+    t.emulator.config().file = image;
+    REQUIRE(t.start());
+    t.mcm.ymodem.setStreamToOta(b_stream_to_ota);
+    REQUIRE(MCM_STATUS::MCM_OK == t.mcm.start_file_transfer(version));
+}
+
+static bool transfer_ended(TestMcm &t)
+{
+    return (YMODEM_IDLE == t.mcm.ymodem.getState()) && (0 < t.emulator.get_stats().u32_ymodem_blocks);
+}
+
+/**
+ * @brief The partition was left without an image and the device did not reboot.
+ */
+static void check_aborted()
+{
+    CHECK(!Update.isRunning());
+    CHECK_EQ(Update.getError(), UPDATE_ERROR_ABORT);
+    CHECK_EQ(Update.host_get_stats().u32_completed, 0);
+    CHECK_EQ(host_hal_get_restart_count(), 0);
+}
+
+static void test_stream_to_ota()
+{
+    TestMcm t;
+    std::vector<uint8_t> image = make_image(TEST_IMAGE_SIZE);
+
+    start_transfer(t, image, true);
+    CHECK(t.run_until([&]() { return 0 < host_hal_get_restart_count(); }, TEST_TRANSFER_TIMEOUT_MS));
+    CHECK(image == Update.host_get_image());
+    // every byte is programmed once, SPIFFS is not used
+    CHECK_EQ(Update.host_get_stats().u64_bytes_written, image.size());
+    CHECK_EQ(Update.host_get_stats().u32_begins, 1);
+    CHECK_EQ(Update.host_get_stats().u32_completed, 1);
+    CHECK_EQ(host_fs_get_stats().u64_bytes_written, 0);
+    CHECK_EQ(host_fs_get_stats().u64_bytes_read, 0);
+    CHECK(!SPIFFS.exists(TEST_FUOTA_FILE_NAME));
+    CHECK_EQ(host_hal_get_restart_count(), 1);
+}
+
+static void test_staged_in_spiffs()
+{
+    TestMcm t;
+    std::vector<uint8_t> image = make_image(TEST_IMAGE_SIZE);
+
+    start_transfer(t, image, false);
+    CHECK(t.run_until([&]() { return 0 < host_hal_get_restart_count(); }, TEST_TRANSFER_TIMEOUT_MS));
+    CHECK(image == Update.host_get_image());
+    // written to the file, read back and written again into the partition
+    CHECK_EQ(host_fs_get_stats().u64_bytes_written, image.size());
+    CHECK_EQ(host_fs_get_stats().u64_bytes_read, image.size());
+    CHECK_EQ(Update.host_get_stats().u64_bytes_written, image.size());
+    CHECK_EQ(Update.host_get_stats().u32_completed, 1);
+}
+
+/**
+ * @brief The sender goes silent after the header, the destination opened for it is dropped.
+ * Once a block is written the transfer is suspended instead, see test_fw_resume.
+ */
+static void test_timeout(bool b_stream_to_ota)
+{
+    TestMcm t;
+    std::vector<uint8_t> image = make_image(TEST_IMAGE_SIZE);
+
+    start_transfer(t, image, b_stream_to_ota);
+    REQUIRE(t.run_until([&]() { return 1 <= t.emulator.get_stats().u32_ymodem_blocks; }, TEST_TRANSFER_TIMEOUT_MS));
+    t.wire.detach();
+    t.run_for(YMODEM_TIMEOUT - 1000);
+    CHECK(YMODEM_IDLE != t.mcm.ymodem.getState());
+    t.run_for(YMODEM_BLOCK_TIMEOUT + 2000);
+    CHECK(YMODEM_IDLE == t.mcm.ymodem.getState());
+    CHECK(!SPIFFS.exists(TEST_FUOTA_FILE_NAME));
+    CHECK_EQ(host_hal_get_restart_count(), 0);
+    if (b_stream_to_ota)
+    {
+        check_aborted();
+        CHECK_EQ(Update.host_get_stats().u32_begins, 1);
+    }
+    else
+    {
+        CHECK_EQ(Update.host_get_stats().u32_begins, 0);
+    }
+}
+
+static void test_crc_errors()
+{
+    TestMcm t("corrupt 1 20\n");
+    std::vector<uint8_t> image = make_image(TEST_IMAGE_SIZE);
+
+    start_transfer(t, image, true);
+    CHECK(t.run_until([&]() { return transfer_ended(t); }, TEST_TRANSFER_TIMEOUT_MS));
+    t.run_for(100);
+    CHECK_EQ(t.emulator.get_stats().u32_ymodem_naks, YMODEM_MAX_CRC_ERRORS - 1);
+    CHECK(t.emulator.get_stats().b_ymodem_cancelled);
+    CHECK(!t.emulator.get_stats().b_ymodem_done);
+    check_aborted();
+    CHECK_EQ(Update.host_get_stats().u64_bytes_written, 0);
+}
+
+static void test_crc_errors_recovered()
+{
+    // a good block in between clears the count, the limit is on consecutive errors
+    TestMcm t("corrupt 3 9\ncorrupt 5 9\n");
+    std::vector<uint8_t> image = make_image(TEST_IMAGE_SIZE);
+
+    start_transfer(t, image, true);
+    CHECK(t.run_until([&]() { return 0 < host_hal_get_restart_count(); }, TEST_TRANSFER_TIMEOUT_MS));
+    CHECK_EQ(t.emulator.get_stats().u32_ymodem_naks, 2 * (YMODEM_MAX_CRC_ERRORS - 1));
+    CHECK(image == Update.host_get_image());
+}
+
+static void test_write_failure()
+{
+    TestMcm t;
+    std::vector<uint8_t> image = make_image(TEST_IMAGE_SIZE);
+
+    Update.host_fail_write_after(8 * 1024);
+    start_transfer(t, image, true);
+    // cancelled on the failed block, not left to the timeout
+    CHECK(t.run_until([&]() { return transfer_ended(t); }, YMODEM_TIMEOUT / 2));
+    t.run_for(100);
+    CHECK(t.emulator.get_stats().b_ymodem_cancelled);
+    CHECK(!Update.isRunning());
+    CHECK_EQ(Update.host_get_stats().u32_completed, 0);
+    CHECK_EQ(host_hal_get_restart_count(), 0);
+}
+
+static void test_image_too_large()
+{
+    TestMcm t;
+    std::vector<uint8_t> image = make_image(HOST_UPDATE_PARTITION_SIZE + 1);
+
+    start_transfer(t, image, true);
+    CHECK(t.run_until([&]() { return transfer_ended(t); }, TEST_TRANSFER_TIMEOUT_MS));
+    t.run_for(100);
+    // refused on the header, before any data block
+    CHECK(t.emulator.get_stats().b_ymodem_cancelled);
+    CHECK_EQ(t.emulator.get_stats().u32_ymodem_blocks, 1);
+    CHECK_EQ(Update.getError(), UPDATE_ERROR_SIZE);
+    CHECK_EQ(Update.host_get_stats().u64_bytes_written, 0);
+}
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTIONS
+ **********************************************************************************************************/
+int main()
+{
+    test_stream_to_ota();
+    test_staged_in_spiffs();
+    test_timeout(true);
+    test_timeout(false);
+    test_crc_errors();
+    test_crc_errors_recovered();
+    test_write_failure();
+    test_image_too_large();
+    return test_result("test_ymodem_ota");
+}
@@ -117,29 +117,42 @@ uint32_t calculate_no_of_segments(uint8_t *pkg_size, uint32_t seg_size_byte)
     return (pkg_full_size + seg_size_byte - 1) / seg_size_byte;
 }
 
-bool is_all_segments_downloaded(get_seg_file_status_t seg_file_status)
+/**
+ * @brief Builds the segment map of the package from the 16 bit seg_status.
+ *  The status only describes the first SEG_BITMAP_LEGACY_COUNT segments, the others stay pending.
+ */
+bool get_seg_bitmap_from_seg_file_status(get_seg_file_status_t seg_file_status, seg_bitmap_t *p_map, uint32_t *p_words, uint32_t word_count)
 {
-    bool is_downloaded = true;
-    uint32_t pkg_full_size =  seg_file_status.pkg_size[0] << 16 | seg_file_status.pkg_size[1] << 8 | seg_file_status.pkg_size[2];   
     // Determine the segment size based on the segment size type
     uint32_t seg_size = get_seg_size_bytes(seg_file_status.seg_size);
     if(seg_size == 0)
     {
         return false;
     }
-    uint32_t total_segments = (pkg_full_size + seg_size - 1) / seg_size;
-    Serial.printf("Total segments: %d\n", total_segments);
-    for (uint32_t i = 0; i < total_segments; i++)
+    uint32_t total_segments = calculate_no_of_segments(seg_file_status.pkg_size, seg_size);
+    return seg_bitmap_from_status16(p_map, p_words, word_count, seg_file_status.seg_status, total_segments);
+}
+
+bool is_all_segments_downloaded(get_seg_file_status_t seg_file_status)
+{
+    uint32_t seg_words[SEG_BITMAP_WORDS(FUOTA_MAX_SEGMENTS)];
+    seg_bitmap_t seg_map;
+
+    if (!get_seg_bitmap_from_seg_file_status(seg_file_status, &seg_map, seg_words, SEG_BITMAP_WORDS(FUOTA_MAX_SEGMENTS)))
     {
-        if ((seg_file_status.seg_status & (1 << i)) != 0)
-        {
-            is_downloaded = false;
-            Serial.printf("Segment %d is not downloaded\n", i);
-            break;
-        }
+        return false;
+    }
+    Serial.printf("Segments downloaded: %lu of %lu (%u %%)\n",
+                  (unsigned long)(seg_bitmap_get_count(&seg_map) - seg_bitmap_get_pending_count(&seg_map)),
+                  (unsigned long)seg_bitmap_get_count(&seg_map),
+                  seg_bitmap_get_progress(&seg_map));
+    if (0 != seg_bitmap_get_pending_count(&seg_map))
+    {
+        Serial.printf("Segment %lu is not downloaded\n", (unsigned long)seg_bitmap_find_pending(&seg_map, 0));
+        return false;
     }
 
-    return is_downloaded;
+    return true;
 }
 uint8_t get_cmd_type_from_seg_file_status(get_seg_file_status_t seg_file_status)
 {
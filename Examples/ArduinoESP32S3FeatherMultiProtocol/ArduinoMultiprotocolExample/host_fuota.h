@@ -50,6 +50,7 @@ extern "C" {
  **********************************************************************************************************/
 #include <stdint.h>
 #include "api_processor.h"
+#include "seg_bitmap.h"
 
 /**********************************************************************************************************
  * MACROS AND DEFINES
@@ -59,6 +60,9 @@ extern "C" {
 #define FUOTA_SEG_SIZE_BYTES_256             (256*1024)
 #define FUOTA_SEG_SIZE_BYTES_512             (512*1024)
 
+// 24 bit package size over the smallest segment
+#define FUOTA_MAX_SEGMENTS                   ((0xFFFFFF + FUOTA_SEG_SIZE_BYTES_64 - 1) / FUOTA_SEG_SIZE_BYTES_64)
+
 #define FUOTA_BINARY_TYPE_MCM          0x00
 #define FUOTA_BINARY_TYPE_HOST         0x01
 
@@ -87,6 +91,7 @@ typedef enum
 uint32_t get_seg_size_bytes(uint8_t seg_size_type);
 uint32_t calculate_no_of_segments(uint8_t *pkg_size, uint32_t seg_size_byte);
 bool is_all_segments_downloaded(get_seg_file_status_t seg_file_status);
+bool get_seg_bitmap_from_seg_file_status(get_seg_file_status_t seg_file_status, seg_bitmap_t *p_map, uint32_t *p_words, uint32_t word_count);
 uint8_t get_cmd_type_from_seg_file_status(get_seg_file_status_t seg_file_status);
 #ifdef __cplusplus
 }
@@ -0,0 +1,373 @@
+/**
+ * @file link_select.c
+ * @author OXIT embedded firmware team
+ * @brief Link quality statistics per connection mode and the choice of the link to use.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "link_select.h"
+#include <stddef.h>
+#include <string.h>
+
+/******************************************************************************
+ * EXTERN VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ ******************************************************************************/
+/**< Join failures in a row after which a link has failed */
+#define LINK_SELECT_MAX_JOIN_FAILURES       (2)
+
+/**< Downlinks needed before the snr of a link is trusted */
+#define LINK_SELECT_MIN_RF_SAMPLES          (3)
+
+/**< No link found */
+#define LINK_SELECT_NONE                    (0xFF)
+
+/******************************************************************************
+ * PRIVATE TYPEDEFS
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ ******************************************************************************/
+static void link_select_forget_stale(link_select_t *p_select, uint8_t u8_link, uint32_t u32_now_ms);
+static bool link_select_has_failed(link_select_t *p_select, uint8_t u8_link, uint32_t u32_now_ms);
+static uint32_t link_select_score(link_select_t *p_select, uint8_t u8_link, uint32_t u32_now_ms);
+static uint8_t link_select_find_best(link_select_t *p_select, uint32_t u32_now_ms);
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+/**
+ * @brief Clears the statistics of a link not updated for u32_stale_ms, the link is probed again
+ */
+static void link_select_forget_stale(link_select_t *p_select, uint8_t u8_link, uint32_t u32_now_ms)
+{
+    link_select_link_t *p_link = &p_select->links[u8_link];
+
+    if (((0 != p_link->u8_samples) || (0 != p_link->u8_rf_count)) && ((u32_now_ms - p_link->u32_updated_ms) >= p_select->config.u32_stale_ms))
+    {
+        p_link->u32_history = 0;
+        p_link->u8_samples = 0;
+        p_link->u8_join_failures = 0;
+        p_link->u8_rf_count = 0;
+        p_link->u8_rf_next = 0;
+    }
+}
+
+static bool link_select_has_failed(link_select_t *p_select, uint8_t u8_link, uint32_t u32_now_ms)
+{
+    return (link_select_get_delivery_pct(p_select, u8_link, u32_now_ms) < p_select->config.u8_fail_pct) ||
+           (LINK_SELECT_MAX_JOIN_FAILURES <= p_select->links[u8_link].u8_join_failures);
+}
+
+/**
+ * @brief Delivery per millijoule, scaled by 1000
+ */
+static uint32_t link_select_score(link_select_t *p_select, uint8_t u8_link, uint32_t u32_now_ms)
+{
+    uint16_t u16_energy_mj = p_select->links[u8_link].profile.u16_energy_mj;
+
+    return ((uint32_t)link_select_get_delivery_pct(p_select, u8_link, u32_now_ms) * 1000UL) / ((0 != u16_energy_mj) ? u16_energy_mj : 1);
+}
+
+/**
+ * @brief Best candidate other than the current link and not failed: the best score among the links
+ *  reaching u8_min_delivery_pct, otherwise the best delivery. LINK_SELECT_NONE if none.
+ */
+static uint8_t link_select_find_best(link_select_t *p_select, uint32_t u32_now_ms)
+{
+    uint8_t u8_best = LINK_SELECT_NONE;
+    bool b_best_eligible = false;
+    uint32_t u32_best_value = 0;
+
+    for (uint8_t i = 0; i < LINK_SELECT_MAX_LINKS; i++)
+    {
+        if ((i == p_select->u8_current) || (false == p_select->links[i].profile.b_candidate) ||
+            link_select_has_failed(p_select, i, u32_now_ms))
+        {
+            continue;
+        }
+
+        bool b_eligible = (link_select_get_delivery_pct(p_select, i, u32_now_ms) >= p_select->config.u8_min_delivery_pct);
+        uint32_t u32_value = b_eligible ? link_select_score(p_select, i, u32_now_ms) : link_select_get_delivery_pct(p_select, i, u32_now_ms);
+        if ((LINK_SELECT_NONE == u8_best) || (b_eligible && (false == b_best_eligible)) ||
+            ((b_eligible == b_best_eligible) && (u32_value > u32_best_value)))
+        {
+            u8_best = i;
+            b_best_eligible = b_eligible;
+            u32_best_value = u32_value;
+        }
+    }
+    return u8_best;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+void link_select_init(link_select_t *p_select, const link_select_config_t *p_config, uint8_t u8_current, uint32_t u32_now_ms)
+{
+    if ((NULL == p_select) || (NULL == p_config))
+    {
+        return;
+    }
+    memset(p_select, 0, sizeof(link_select_t));
+    p_select->config = *p_config;
+    p_select->u8_current = (LINK_SELECT_MAX_LINKS > u8_current) ? u8_current : 0;
+    p_select->u32_since_ms = u32_now_ms;
+}
+
+bool link_select_set_profile(link_select_t *p_select, uint8_t u8_link, const link_select_profile_t *p_profile)
+{
+    if ((NULL == p_select) || (NULL == p_profile) || (LINK_SELECT_MAX_LINKS <= u8_link))
+    {
+        return false;
+    }
+    p_select->links[u8_link].profile = *p_profile;
+    return true;
+}
+
+void link_select_set_candidate(link_select_t *p_select, uint8_t u8_link, bool b_candidate)
+{
+    if ((NULL == p_select) || (LINK_SELECT_MAX_LINKS <= u8_link))
+    {
+        return;
+    }
+    p_select->links[u8_link].profile.b_candidate = b_candidate;
+}
+
+void link_select_set_current(link_select_t *p_select, uint8_t u8_link, uint32_t u32_now_ms)
+{
+    if ((NULL == p_select) || (LINK_SELECT_MAX_LINKS <= u8_link))
+    {
+        return;
+    }
+    if (u8_link != p_select->u8_current)
+    {
+        p_select->u32_switches++;
+    }
+    // the join timeout restarts on a reconnection to the same link too
+    p_select->u8_current = u8_link;
+    p_select->u32_since_ms = u32_now_ms;
+}
+
+void link_select_on_tx(link_select_t *p_select, uint8_t u8_link, bool b_delivered, uint32_t u32_now_ms)
+{
+    link_select_link_t *p_link = NULL;
+
+    if ((NULL == p_select) || (LINK_SELECT_MAX_LINKS <= u8_link))
+    {
+        return;
+    }
+    link_select_forget_stale(p_select, u8_link, u32_now_ms);
+
+    p_link = &p_select->links[u8_link];
+    p_link->u32_history = (p_link->u32_history << 1) | (b_delivered ? 1 : 0);
+    if (LINK_SELECT_TX_WINDOW > p_link->u8_samples)
+    {
+        p_link->u8_samples++;
+    }
+    if (b_delivered)
+    {
+        p_link->u8_join_failures = 0;
+    }
+    p_link->u32_updated_ms = u32_now_ms;
+}
+
+void link_select_on_downlink(link_select_t *p_select, uint8_t u8_link, int8_t i8_rssi, int8_t i8_snr, uint32_t u32_now_ms)
+{
+    link_select_link_t *p_link = NULL;
+
+    if ((NULL == p_select) || (LINK_SELECT_MAX_LINKS <= u8_link))
+    {
+        return;
+    }
+    link_select_forget_stale(p_select, u8_link, u32_now_ms);
+
+    p_link = &p_select->links[u8_link];
+    p_link->ai8_rssi[p_link->u8_rf_next] = i8_rssi;
+    p_link->ai8_snr[p_link->u8_rf_next] = i8_snr;
+    p_link->u8_rf_next = (p_link->u8_rf_next + 1) % LINK_SELECT_RF_WINDOW;
+    if (LINK_SELECT_RF_WINDOW > p_link->u8_rf_count)
+    {
+        p_link->u8_rf_count++;
+    }
+    p_link->u32_updated_ms = u32_now_ms;
+}
+
+void link_select_on_join_failure(link_select_t *p_select, uint8_t u8_link, uint32_t u32_now_ms)
+{
+    if ((NULL == p_select) || (LINK_SELECT_MAX_LINKS <= u8_link))
+    {
+        return;
+    }
+    link_select_on_tx(p_select, u8_link, false, u32_now_ms);
+    if (UINT8_MAX > p_select->links[u8_link].u8_join_failures)
+    {
+        p_select->links[u8_link].u8_join_failures++;
+    }
+}
+
+uint8_t link_select_evaluate(link_select_t *p_select, bool b_joined, uint32_t u32_now_ms)
+{
+    uint8_t u8_current = 0;
+    uint8_t u8_best = LINK_SELECT_NONE;
+    bool b_failed = false;
+
+    if (NULL == p_select)
+    {
+        return 0;
+    }
+    u8_current = p_select->u8_current;
+
+    if (b_joined)
+    {
+        p_select->links[u8_current].u8_join_failures = 0;
+    }
+    // a join that never completes counts as one failed outcome per timeout
+    else if ((u32_now_ms - p_select->u32_since_ms) >= p_select->config.u32_join_timeout_ms)
+    {
+        link_select_on_tx(p_select, u8_current, false, u32_now_ms);
+        p_select->u32_since_ms = u32_now_ms;
+        b_failed = true;
+    }
+
+    b_failed = b_failed || link_select_has_failed(p_select, u8_current, u32_now_ms);
+    u8_best = link_select_find_best(p_select, u32_now_ms);
+    if (LINK_SELECT_NONE == u8_best)
+    {
+        return u8_current;
+    }
+    if (b_failed)
+    {
+        return u8_best;
+    }
+
+    // hysteresis, a working link is kept unless another one is clearly better
+    if (((u32_now_ms - p_select->u32_since_ms) >= p_select->config.u32_min_dwell_ms) &&
+        (link_select_get_delivery_pct(p_select, u8_best, u32_now_ms) >= p_select->config.u8_min_delivery_pct) &&
+        ((link_select_score(p_select, u8_best, u32_now_ms) * 100) > (link_select_score(p_select, u8_current, u32_now_ms) * (100 + p_select->config.u8_margin_pct))))
+    {
+        return u8_best;
+    }
+    return u8_current;
+}
+
+uint8_t link_select_get_delivery_pct(link_select_t *p_select, uint8_t u8_link, uint32_t u32_now_ms)
+{
+    link_select_link_t *p_link = NULL;
+    uint32_t u32_delivered = 0;
+    uint32_t u32_pct = 0;
+    int8_t i8_snr = 0;
+
+    if ((NULL == p_select) || (LINK_SELECT_MAX_LINKS <= u8_link))
+    {
+        return 0;
+    }
+    link_select_forget_stale(p_select, u8_link, u32_now_ms);
+
+    p_link = &p_select->links[u8_link];
+    for (uint8_t i = 0; i < p_link->u8_samples; i++)
+    {
+        u32_delivered += (p_link->u32_history >> i) & 1;
+    }
+
+    if (p_link->u8_samples < p_select->config.u8_min_samples)
+    {
+        u32_pct = ((u32_delivered * 100) + ((uint32_t)p_select->config.u8_prior_pct * (p_select->config.u8_min_samples - p_link->u8_samples))) /
+                  p_select->config.u8_min_samples;
+    }
+    else
+    {
+        u32_pct = (u32_delivered * 100) / p_link->u8_samples;
+    }
+
+    // a low snr announces losses before the tx outcomes show them
+    if ((LINK_SELECT_MIN_RF_SAMPLES <= p_link->u8_rf_count) && link_select_get_rf(p_select, u8_link, NULL, &i8_snr) &&
+        (i8_snr < p_link->profile.i8_snr_min_db))
+    {
+        u32_pct = (u32_pct * p_select->config.u8_degraded_pct) / 100;
+    }
+    return (uint8_t)u32_pct;
+}
+
+bool link_select_get_rf(const link_select_t *p_select, uint8_t u8_link, int8_t *p_rssi, int8_t *p_snr)
+{
+    const link_select_link_t *p_link = NULL;
+    int32_t i32_rssi = 0;
+    int32_t i32_snr = 0;
+
+    if ((NULL == p_select) || (LINK_SELECT_MAX_LINKS <= u8_link) || (0 == p_select->links[u8_link].u8_rf_count))
+    {
+        return false;
+    }
+
+    p_link = &p_select->links[u8_link];
+    for (uint8_t i = 0; i < p_link->u8_rf_count; i++)
+    {
+        i32_rssi += p_link->ai8_rssi[i];
+        i32_snr += p_link->ai8_snr[i];
+    }
+    if (NULL != p_rssi)
+    {
+        *p_rssi = (int8_t)(i32_rssi / p_link->u8_rf_count);
+    }
+    if (NULL != p_snr)
+    {
+        *p_snr = (int8_t)(i32_snr / p_link->u8_rf_count);
+    }
+    return true;
+}
+
+uint32_t link_select_get_switch_count(const link_select_t *p_select)
+{
+    return p_select->u32_switches;
+}
@@ -0,0 +1,238 @@
+/**
+ * @file link_select.h
+ * @author OXIT embedded firmware team
+ * @brief Link quality statistics per connection mode and the choice of the link to use.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+#ifndef __LINK_SELECT_H__
+#define __LINK_SELECT_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+/**
+ * @brief Number of links, one per connection mode.
+ */
+#define LINK_SELECT_MAX_LINKS               (5)
+
+/**
+ * @brief Number of the last tx outcomes kept per link, up to 32.
+ */
+#define LINK_SELECT_TX_WINDOW               (16)
+
+/**
+ * @brief Number of the last downlink rssi and snr kept per link.
+ */
+#define LINK_SELECT_RF_WINDOW               (8)
+
+/**
+ * @brief Snr threshold of a link reporting no snr.
+ */
+#define LINK_SELECT_NO_SNR_MIN              (INT8_MIN)
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+/**
+ * @brief Properties of a link
+ */
+typedef struct
+{
+    bool b_candidate;                                   // the link can be selected
+    uint16_t u16_energy_mj;                             // energy of one uplink attempt, in millijoules
+    int8_t i8_snr_min_db;                               // mean downlink snr below which the link is degraded
+} link_select_profile_t;
+
+/**
+ * @brief Thresholds of the selection, the same for every link.
+ *
+ * The delivery of a link is the part of its last tx outcomes that were delivered, a join
+ * failure counting as a failed outcome. With fewer than u8_min_samples outcomes the
+ * missing ones count as u8_prior_pct, so an unknown or forgotten link gets probed.
+ * The score of a link is its delivery per millijoule.
+ */
+typedef struct
+{
+    uint8_t u8_min_samples;                             // outcomes needed to judge a link
+    uint8_t u8_prior_pct;                               // delivery assumed for the missing outcomes
+    uint8_t u8_fail_pct;                                // the current link is left below this delivery
+    uint8_t u8_min_delivery_pct;                        // a link is only chosen for its score from this delivery
+    uint8_t u8_margin_pct;                              // another link must score this much more to replace a working one
+    uint8_t u8_degraded_pct;                            // delivery kept by a link with a low snr, in percent
+    uint32_t u32_min_dwell_ms;                          // time on a working link before it is replaced for a better one
+    uint32_t u32_join_timeout_ms;                       // a link not joined for this long has failed
+    uint32_t u32_stale_ms;                              // the statistics of a link not used for this long are forgotten
+} link_select_config_t;
+
+/**
+ * @brief Statistics of a link
+ */
+typedef struct
+{
+    uint32_t u32_history;                               // last tx outcomes, bit set when delivered, newest in bit 0
+    uint8_t u8_samples;                                 // outcomes in u32_history
+    uint8_t u8_join_failures;                           // join failures since the last join
+    int8_t ai8_rssi[LINK_SELECT_RF_WINDOW];
+    int8_t ai8_snr[LINK_SELECT_RF_WINDOW];
+    uint8_t u8_rf_count;
+    uint8_t u8_rf_next;
+    uint32_t u32_updated_ms;                            // time of the last outcome or downlink
+    link_select_profile_t profile;
+} link_select_link_t;
+
+/**
+ * @brief Context of the link selection.
+ *
+ * The members are private, use the link_select_* functions to access them.
+ */
+typedef struct
+{
+    link_select_link_t links[LINK_SELECT_MAX_LINKS];
+    link_select_config_t config;
+    uint8_t u8_current;                                 // link in use
+    uint32_t u32_since_ms;                              // time the current link has been selected
+    uint32_t u32_switches;                              // changes of the current link
+} link_select_t;
+
+/**********************************************************************************************************
+ * EXPORTED VARIABLES
+ **********************************************************************************************************/
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTION PROTOTYPES
+ **********************************************************************************************************/
+/**
+ * @brief Initializes the link selection without statistics, no link is a candidate.
+ *
+ * @param[in,out] p_select Pointer to the link selection context
+ * @param[in] p_config Thresholds, copied
+ * @param[in] u8_current Link in use
+ * @param[in] u32_now_ms Current time
+ */
+void link_select_init(link_select_t *p_select, const link_select_config_t *p_config, uint8_t u8_current, uint32_t u32_now_ms);
+
+/**
+ * @brief Sets the properties of a link, its statistics are kept.
+ *
+ * @retval true The properties are set
+ * @retval false Invalid parameters
+ */
+bool link_select_set_profile(link_select_t *p_select, uint8_t u8_link, const link_select_profile_t *p_profile);
+
+/**
+ * @brief Makes a link a candidate of the selection or not, its other properties are kept.
+ */
+void link_select_set_candidate(link_select_t *p_select, uint8_t u8_link, bool b_candidate);
+
+/**
+ * @brief Gives the link now in use, selected by link_select_evaluate() or by the application.
+ */
+void link_select_set_current(link_select_t *p_select, uint8_t u8_link, uint32_t u32_now_ms);
+
+/**
+ * @brief Adds the outcome of an uplink attempt on a link.
+ *
+ * @param[in,out] p_select Pointer to the link selection context
+ * @param[in] u8_link Index of the link
+ * @param[in] b_delivered The attempt was sent, and acknowledged for a confirmed uplink
+ * @param[in] u32_now_ms Current time
+ */
+void link_select_on_tx(link_select_t *p_select, uint8_t u8_link, bool b_delivered, uint32_t u32_now_ms);
+
+/**
+ * @brief Adds the rssi and snr of a downlink received on a link.
+ */
+void link_select_on_downlink(link_select_t *p_select, uint8_t u8_link, int8_t i8_rssi, int8_t i8_snr, uint32_t u32_now_ms);
+
+/**
+ * @brief Adds a join failure of a link, counted as a failed outcome.
+ */
+void link_select_on_join_failure(link_select_t *p_select, uint8_t u8_link, uint32_t u32_now_ms);
+
+/**
+ * @brief Gives the link to use.
+ *
+ * The current link is left when it has failed: delivery below u8_fail_pct, two join failures
+ * in a row or not joined after u32_join_timeout_ms. It is then replaced by the best other
+ * candidate that has not failed. A working link is only replaced after u32_min_dwell_ms, by a
+ * link with a delivery of at least u8_min_delivery_pct and a score higher by u8_margin_pct.
+ * A link that has been left keeps its statistics until they are stale, so it is not chosen
+ * again right away.
+ *
+ * @param[in,out] p_select Pointer to the link selection context
+ * @param[in] b_joined The current link is joined
+ * @param[in] u32_now_ms Current time
+ *
+ * @return Link to use, the current one when it should be kept
+ */
+uint8_t link_select_evaluate(link_select_t *p_select, bool b_joined, uint32_t u32_now_ms);
+
+/**
+ * @brief Returns the estimated delivery of a link, in percent.
+ */
+uint8_t link_select_get_delivery_pct(link_select_t *p_select, uint8_t u8_link, uint32_t u32_now_ms);
+
+/**
+ * @brief Returns the mean rssi and snr of the last downlinks of a link.
+ *
+ * @retval true The means are set
+ * @retval false No downlink received on the link
+ */
+bool link_select_get_rf(const link_select_t *p_select, uint8_t u8_link, int8_t *p_rssi, int8_t *p_snr);
+
+/**
+ * @brief Returns the number of changes of the current link.
+ */
+uint32_t link_select_get_switch_count(const link_select_t *p_select);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __LINK_SELECT_H__
@@ -78,14 +78,93 @@
 /******************************************************************************
  * STATIC VARIABLES
  ******************************************************************************/
-uint8_t temp_buffer[BUFFER_SIZE];
-String version;
-
-// TODO: remove it after the mcm reset bug fixed
-//  currently there is a bug,due to which
-// mcm gives 2 events for software reset
-//  this is a workaround
-uint16_t reset_event_count = 0;
+/**
+ * @brief Highest baud rate per modem firmware, newest firmware first.
+ * No released modem firmware (0.5.8 at the time of writing) documents the set uart baud command,
+ * so every firmware stays at MROVER_DEFAULT_BAUD_RATE and negotiate_baud_rate() sends nothing.
+ * Add the first firmware with the command in front once its release notes give the rates, together
+ * with MROVER_CC_SET_UART_BAUD in the receive tables of frame_parser.c and api_processor.c.
+ */
+static const mcm_baud_capability_t s_baud_capability_table[] =
+{
+    { { 0, 0, 0 }, MROVER_DEFAULT_BAUD_RATE },
+};
+
+/**
+ * @brief Baud rates tried by the negotiation, fastest first
+ */
+static const uint32_t s_baud_rates[] = { 921600, 460800, 230400, 115200, 57600, 38400, 19200 };
+
+/**
+ * @brief Default airtime model and duty cycle per connection mode, in the order of ConnectionMode.
+ * Lorawan is SF9 125 kHz with the 1% duty cycle of EU868, sidewalk has no regional duty cycle.
+ * Set the values of the deployment region with MCM::set_link_profile().
+ */
+static const uplink_sched_link_t s_link_profiles[] =
+{
+    { 0, 0, 0, UPLINK_SCHED_NO_DUTY_LIMIT },        // CONNECTION_MODE_NC
+    { 1760, 13, 60, 10 },                           // CONNECTION_MODE_LORAWAN
+    { 250000, 20, 2, UPLINK_SCHED_NO_DUTY_LIMIT },  // CONNECTION_MODE_SIDEWALK_BLE
+    { 50000, 20, 5, UPLINK_SCHED_NO_DUTY_LIMIT },   // CONNECTION_MODE_SIDEWALK_FSK
+    { 1760, 20, 60, UPLINK_SCHED_NO_DUTY_LIMIT },   // CONNECTION_MODE_SIDEWALK_CSS
+};
+
+/**
+ * @brief Default retry policy per uplink type, in the order of MCM_UPLINK_TYPE.
+ * A not sent uplink is retried, a confirmed one also when not acknowledged. The backoff
+ * doubles from the base and the worst case stays within UPLINK_NO_RESPONSE_TIMEOUT_SECONDS
+ * of the example. Set other values with MCM::set_retry_policy().
+ */
+static const uplink_retry_policy_t s_retry_policies[] =
+{
+    { 0, false, 0, 0, 0 },                          // MCM_UPLINK_TYPE_NA
+    { 2, true, 8000, 32000, 25 },                   // MCM_UPLINK_TYPE_CONF
+    { 2, false, 5000, 20000, 25 },                  // MCM_UPLINK_TYPE_UNCONF
+};
+
+/**
+ * @brief Default energy of an uplink attempt and snr floor per connection mode, in the order of ConnectionMode.
+ * The energies are estimates for a 20 byte uplink with the receive windows, the snr floors keep
+ * 2.5 dB above the demodulation limit of LoRa SF9 and of FSK. No mode is a failover candidate by default.
+ */
+static const link_select_profile_t s_link_select_profiles[] =
+{
+    { false, 0, LINK_SELECT_NO_SNR_MIN },           // CONNECTION_MODE_NC
+    { false, 30, -10 },                             // CONNECTION_MODE_LORAWAN
+    { false, 50, LINK_SELECT_NO_SNR_MIN },          // CONNECTION_MODE_SIDEWALK_BLE
+    { false, 8, 3 },                                // CONNECTION_MODE_SIDEWALK_FSK
+    { false, 80, -10 },                             // CONNECTION_MODE_SIDEWALK_CSS
+};
+
+/**
+ * @brief Thresholds of the automatic failover, tuned on link traces of a device moving
+ * between coverage zones of 30 minutes on average.
+ */
+static const link_select_config_t s_link_select_config =
+{
+    6,                                              // u8_min_samples
+    60,                                             // u8_prior_pct
+    50,                                             // u8_fail_pct
+    70,                                             // u8_min_delivery_pct
+    25,                                             // u8_margin_pct
+    50,                                             // u8_degraded_pct
+    30 * 60000UL,                                   // u32_min_dwell_ms
+    5 * 60000UL,                                    // u32_join_timeout_ms
+    30 * 60000UL,                                   // u32_stale_ms
+};
+
+/**
+ * @brief Timing of the sidewalk ble connection, failed requests are requested again from 2 s up to 1 min.
+ */
+static const ble_conn_config_t s_ble_conn_config =
+{
+    MCM_BLE_CONN_SETUP_TIMEOUT_MS,                  // u32_setup_timeout_ms
+    MCM_BLE_CONN_LINK_SETUP_MS,                     // u32_link_setup_ms
+    MCM_BLE_CONN_IDLE_TIMEOUT_MS,                   // u32_idle_timeout_ms
+    2000,                                           // u32_retry_base_ms
+    60000,                                          // u32_retry_max_ms
+};
+
 /******************************************************************************
  * GLOBAL VARIABLES
  ******************************************************************************/
@@ -110,18 +189,27 @@ uint16_t reset_event_count = 0;
  * Function Definitions
  *******************************************************************************/
 
+/**
+ * @brief Returns the command code of a queued command frame.
+ */
+static inline uint16_t get_cmd_entry_code(const mcm_cmd_entry_t *cmd)
+{
+    return (cmd->frame[1] << 8) | cmd->frame[2];
+}
+
 static uint16_t on_send_function(uint8_t *data, uint16_t size, void *ctx)
 {
     MCM *curr_instance = (MCM *)ctx;
-    curr_instance->set_received_size(0);
-    curr_instance->set_is_rx_received(0);
-    Serial.printf("HMI TX: (%d Bytes)", size);
-    for (int i = 0; i < size; i++)
-    {
-        Serial.printf(" %02x", data[i]);
-    }
-    Serial.println("");
-    return (uint16_t)curr_instance->get_serial().write(data, size);
+    // commands are not written directly, they are sent by the command queue
+    // one after the other as the responses are received
+    return curr_instance->enqueue_command(data, size);
+}
+
+static uint16_t on_send_vector_function(const serial_tx_segment_t *segments, uint8_t count, void *ctx)
+{
+    MCM *curr_instance = (MCM *)ctx;
+    // the uplink payload is read from the caller buffer, it is not staged by the api processor
+    return curr_instance->enqueue_command_vector(segments, count);
 }
 
 static void handle_notification(void *ctx)
@@ -135,7 +223,7 @@ static void handle_notification(void *ctx)
     }
 }
 
-static void handle_mcm_response(const api_processor_response_t *mcm_response, void *ctx)
+static void process_mcm_response(const api_processor_response_t *mcm_response, void *ctx)
 {
     MCM *curr_instance = (MCM *)ctx;
 
@@ -159,6 +247,10 @@ static void handle_mcm_response(const api_processor_response_t *mcm_response, vo
         {
           Serial.printf("No file found.\n");
         }
+        else if (MROVER_CC_BLE_CONNECTION_REQUEST == cmd_code)
+        {
+            curr_instance->set_ble_connection_result(false);
+        }
         return;
     }
 
@@ -200,14 +292,19 @@ static void handle_mcm_response(const api_processor_response_t *mcm_response, vo
                  */
                 Serial.printf("Reset count %d\n", mcm_helper_get_event_reset_count(mcm_response));
             }
-            reset_event_count++;
-            // Serial.printf("Reset count %d\n", reset_event_count);
-            // if(reset_event_count <= 2)
+            // TODO: remove it after the mcm reset bug fixed
+            //  currently there is a bug,due to which
+            // mcm gives 2 events for software reset
+            //  this is a workaround
+            curr_instance->increment_sw_reset_event_count();
+            // Serial.printf("Reset count %d\n", curr_instance->get_sw_reset_event_count());
+            // if(curr_instance->get_sw_reset_event_count() <= 2)
             //     break;
 
             // reset the module
             // set the joined status to false in case if device is resetted
             curr_instance->set_is_joined_network(false);
+            curr_instance->set_ble_connection_result(false);
 
             if (curr_instance->get_context_mgr_is_joined_cmd_received())
             {
@@ -245,6 +342,12 @@ static void handle_mcm_response(const api_processor_response_t *mcm_response, vo
 
                     /// Resetting Lorawan time sync flag
                     curr_instance->is_lorawan_mac_time_synced = false;
+
+                    // time synced over ble, the connection is up
+                    if (ConnectionMode::CONNECTION_MODE_SIDEWALK_BLE == curr_instance->get_connect_mode())
+                    {
+                        curr_instance->set_ble_connection_result(true);
+                    }
                 }
 
                 curr_instance->set_is_joined_network(true);
@@ -290,6 +393,7 @@ static void handle_mcm_response(const api_processor_response_t *mcm_response, vo
                 }
             }
             curr_instance->set_is_joined_network(false);
+            curr_instance->set_ble_connection_result(false);
         }
         break;
         /**
@@ -333,6 +437,12 @@ static void handle_mcm_response(const api_processor_response_t *mcm_response, vo
                 default:
                     break;
                 }
+
+                // a ble uplink not sent means the connection is gone, a sent one keeps it open
+                if (ConnectionMode::CONNECTION_MODE_SIDEWALK_BLE == curr_instance->get_connect_mode())
+                {
+                    curr_instance->set_ble_connection_result(MCM_TX_STATUS::MCM_TX_NOT_SEND != curr_instance->get_last_tx_status());
+                }
             }
 
             break;
@@ -342,42 +452,64 @@ static void handle_mcm_response(const api_processor_response_t *mcm_response, vo
             Serial.printf("MODEM_EVENT_DOWNDATA\n");
             if (curr_instance->get_is_debug_enabled())
                 Serial.printf("downlink has been received\n");
-            int8_t rssi;
-            int8_t snr;
+            // a ble downlink keeps the connection open like an uplink
+            if (ConnectionMode::CONNECTION_MODE_SIDEWALK_BLE == curr_instance->get_connect_mode())
+            {
+                curr_instance->set_ble_connection_result(true);
+            }
             uint16_t payload_len = mcm_helper_get_downlink_len(mcm_response); // first determine the downlink length of the received data
-            uint16_t seq_port;
-            uint8_t *payload = curr_instance->get_downlink_buffer();
+            mcm_downlink_t *downlink = curr_instance->alloc_downlink();
+            if ((nullptr == downlink) || (payload_len > MCM_DOWNLINK_MAX_PAYLOAD_SIZE))
+            {
+                curr_instance->release_downlink(downlink);
+                curr_instance->count_downlink_overflow();
+                Serial.printf("Downlink dropped, no free downlink buffer\n");
+                break;
+            }
 
-            mcm_helper_get_downlink_data(mcm_response, &rssi, &snr, payload, &seq_port);
+            // single copy out of the frame decoder, the frame buffer is reused for the next frame
+            mcm_helper_get_downlink_data(mcm_response, &downlink->rssi, &downlink->snr, downlink->payload, &downlink->seq_port);
+            downlink->len = payload_len;
+            downlink->protocol = mcm_helper_get_command_type(mcm_response);
+            downlink->timestamp = millis();
 
-            curr_instance->set_downlink_meta_data(payload_len, rssi, snr, seq_port, true);
             if (curr_instance->get_is_debug_enabled())
             {
-                Serial.printf("Rssi: %d\n", rssi);
-                Serial.printf("Snr: %d\n", snr);
+                Serial.printf("Rssi: %d\n", downlink->rssi);
+                Serial.printf("Snr: %d\n", downlink->snr);
                 if (COMMAND_TYPE_LORAWAN == mcm_helper_get_command_type(mcm_response)) // helper function to get the command type
                 {
-                    Serial.printf("Port %d\n", seq_port);
+                    Serial.printf("Port %d\n", downlink->seq_port);
                 }
 
                 else
                 {
-                    Serial.printf("Sequence %d\n", seq_port);
+                    Serial.printf("Sequence %d\n", downlink->seq_port);
                     // since we received the sidewalk downlink, we can stop the sidewalk uplink
                 }
 
                 Serial.printf("Payload: ");
                 for (int i = 0; i < payload_len; i++)
                 {
-                    Serial.printf("0x%02x,", payload[i]);
+                    Serial.printf("0x%02x,", downlink->payload[i]);
                 }
                 Serial.printf("\n");
             }
 
+            // fragments go to the reassembler, the application gets the whole message
+            if (curr_instance->reassemble_downlink(downlink))
+            {
+                curr_instance->release_downlink(downlink);
+                break;
+            }
+
             if (nullptr != curr_instance->get_on_rx_callback_func())
             {
-                curr_instance->get_on_rx_callback_func()(payload, payload_len, rssi, snr, seq_port);
+                curr_instance->get_on_rx_callback_func()(downlink);
             }
+
+            // hand the reference of the allocation over to the downlink queue
+            curr_instance->publish_downlink(downlink);
         }
         break;
         case MODEM_EVENT_CLASS_SWITCHED:
@@ -531,7 +663,7 @@ static void handle_mcm_response(const api_processor_response_t *mcm_response, vo
         ver_type_1_t lorawan;
 
         mcm_helper_get_version(mcm_response, &bootloader, &modem_fw, &modem_hw, &sidewalk, &lorawan);
-        version = "";
+        String version = "";
         char data[100];
         sprintf(data, "Bootloader: %d.%d.%d\n", bootloader.major, bootloader.minor, bootloader.patch);
         version += data;
@@ -543,6 +675,8 @@ static void handle_mcm_response(const api_processor_response_t *mcm_response, vo
         version += data;
         sprintf(data, "Lorawan: %d.%d.%d\n", lorawan.major, lorawan.minor, lorawan.patch);
         version += data;
+        curr_instance->set_modem_version(version);
+        curr_instance->modem_fw_version = modem_fw;
         if (curr_instance->get_is_debug_enabled())
         {
             Serial.printf("Bootloader: %d.%d.%d\n", bootloader.major, bootloader.minor, bootloader.patch);
@@ -717,8 +851,10 @@ static void handle_mcm_response(const api_processor_response_t *mcm_response, vo
         Serial.printf("MROVER_CC_REQUEST_UPLINK\n");
         curr_instance->nextUplink_mtu = mcm_helper_get_next_uplink_mtu(mcm_response);
         if (curr_instance->get_is_debug_enabled())
+        {
             Serial.printf("Uplink has been requested successfully\n");
             Serial.printf("Next uplink MTU: %d\n", curr_instance->nextUplink_mtu);
+        }
         break;
 
     /**
@@ -776,6 +912,8 @@ static void handle_mcm_response(const api_processor_response_t *mcm_response, vo
         Serial.printf("MROVER_CC_BLE_CONNECTION_REQUEST\n");
         if (curr_instance->get_is_debug_enabled())
             Serial.printf("Ble connection has been requested successfully\n");
+        // the request is accepted, not the link up, see MCM_BLE_CONN_LINK_SETUP_MS
+        curr_instance->set_ble_connection_acked();
     }
     break;
 
@@ -963,7 +1101,7 @@ static void handle_mcm_response(const api_processor_response_t *mcm_response, vo
             Serial.printf("  Protocol Type: %d\n", curr_instance->last_downlink_stats.protocol_type);
             Serial.printf("  RSSI: %d\n", curr_instance->last_downlink_stats.rssi);
             Serial.printf("  SNR: %d\n", curr_instance->last_downlink_stats.snr);
-            Serial.printf("  Timestamp: %lu\n", curr_instance->last_downlink_stats.timestamp);
+            Serial.printf("  Timestamp: %lu\n", (unsigned long)curr_instance->last_downlink_stats.timestamp);
         }
     }
     break;
@@ -979,17 +1117,27 @@ static void handle_mcm_response(const api_processor_response_t *mcm_response, vo
     }
 }
 
-MCM::MCM(HardwareSerial &serial, uint8_t tx_pin, uint8_t rx_pin, uint8_t reset_pin) : __mcm_serial(serial),
-                                                                                      _tx_pin(tx_pin),
+static void handle_mcm_response(const api_processor_response_t *mcm_response, void *ctx)
+{
+    MCM *curr_instance = (MCM *)ctx;
+
+    // update the context first, so the completion callback of the command sees the new values
+    process_mcm_response(mcm_response, ctx);
+    curr_instance->record_event(mcm_response);
+    curr_instance->on_command_response(mcm_response);
+}
+
+MCM::MCM(HardwareSerial &serial, uint8_t tx_pin, uint8_t rx_pin, uint8_t reset_pin) : _reset_pin(reset_pin),
                                                                                       _rx_pin(rx_pin),
-                                                                                      _reset_pin(reset_pin),
+                                                                                      _tx_pin(tx_pin),
+                                                                                      __mcm_serial(serial),
                                                                                       ymodem(serial)
 {
 }
 
 MCM_STATUS MCM::begin()
 {
-    _baud_rate = 9600;
+    _baud_rate = MROVER_DEFAULT_BAUD_RATE;
     pinMode(_reset_pin, OUTPUT);
     digitalWrite(_reset_pin, HIGH);
     __mcm_serial.begin(_baud_rate, SERIAL_8N1, _rx_pin, _tx_pin);
@@ -997,16 +1145,25 @@ MCM_STATUS MCM::begin()
     __mcm_serial.setTxBufferSize(BUFFER_SIZE);
     // __mcm_serial.setRxTimeout(2);
     // keep in mind below function is lambda function
+    rx_ring_init(&this->rx_ring, this->rx_ring_buffer, MCM_RX_RING_SIZE);
+    frag_rx_init(&this->frag_rx, this->frag_rx_buffer, MCM_FRAG_MAX_PAYLOAD_SIZE, MCM_FRAG_RX_TIMEOUT_MS);
+    uplink_sched_init(&this->uplink_sched, millis());
+    for (uint8_t i = 0; i < (sizeof(s_link_profiles) / sizeof(s_link_profiles[0])); i++)
+    {
+        uplink_sched_set_link(&this->uplink_sched, i, &s_link_profiles[i], millis());
+    }
+    // the jitter seed comes from the hardware random generator, devices retry at different times
+    uplink_retry_init(&this->uplink_retry, (uint32_t)random(1, INT32_MAX));
+    memcpy(this->retry_policies, s_retry_policies, sizeof(this->retry_policies));
+    link_select_init(&this->link_select, &s_link_select_config, (uint8_t)this->current_mode, millis());
+    for (uint8_t i = 0; i < (sizeof(s_link_select_profiles) / sizeof(s_link_select_profiles[0])); i++)
+    {
+        link_select_set_profile(&this->link_select, i, &s_link_select_profiles[i]);
+    }
+    ble_conn_init(&this->ble_conn, &s_ble_conn_config);
+    // keep in mind below function is lambda function, it runs in the uart callback context
     __mcm_serial.onReceive([this]()
-                           {
-        //  size_t available = this->__mcm_serial.available();
-        this->received_size = this->__mcm_serial.readBytes(temp_buffer, BUFFER_SIZE);
-        if (this->get_is_debug_enabled())
-        {
-            Serial.println("on_receive_callback");
-            Serial.printf("Received %d bytes\n", this->received_size);
-        }
-        this->is_rx_received = 1; }, true);
+                           { this->receive_serial_bytes(); }, true);
     if (this->get_is_debug_enabled())
         Serial.printf("mcm begin\n");
 
@@ -1021,336 +1178,1564 @@ MCM_STATUS MCM::begin()
 
     if (API_PROCESSOR_SUCCESS == status)
     {
+        api_processor_set_send_vector_cb(module, on_send_vector_function);
         return MCM_STATUS::MCM_OK;
     }
 
     return MCM_STATUS::MCM_ERROR;
 }
 
-String MCM::print_version()
+/**
+ * @brief Asks the versions of the mcm, get_modem_version() returns them once the command is completed.
+ */
+MCM_STATUS MCM::req_version(on_cmd_complete_callback callback, void *user_context)
 {
-    // send the request to get the version
-    api_processor_cmd_get_version(this->module);
-
-    this->process_received_data();
-    return version;
+    this->set_next_command_callback(callback, user_context);
+    return this->queue_command(api_processor_cmd_get_version(this->module));
 }
 
-void MCM::process_received_data()
+String MCM::get_modem_version()
 {
+    return this->modem_version;
+}
 
-    // wait until the response is received
-    uint32_t timeout = millis();
-    while ((this->is_rx_received == 0) &&
-           ((millis() - timeout) < this->serial_rx_timeout))
-    {
-        delay(100);
-    }
-    if (this->is_rx_received == 0)
-    {
-        Serial.println("MCM: Response not received, Please check the connection");
-    }
-    this->is_rx_received = 0;
-    if (this->get_is_debug_enabled())
+/**
+ * @brief Switches the uart to the fastest rate both the mcm firmware and max_baud_rate allow.
+ *  The steps are run by handle_rx_events(), other commands should wait until
+ *  is_baud_negotiation_pending() is false as they would be sent while the rate changes.
+ *
+ * @param max_baud_rate Fastest rate the host uart supports
+ * @param callback Called once with MCM_OK when the link works at the new rate or no faster rate is available,
+ *  MCM_ERROR if no faster rate has been accepted, MCM_TIMEOUT if the link is lost and the mcm must be reset
+ * @return MCM_STATUS MCM_OK if the negotiation has started
+ */
+MCM_STATUS MCM::negotiate_baud_rate(uint32_t max_baud_rate, on_cmd_complete_callback callback, void *user_context)
+{
+    if ((MCM_BAUD_NEG_STATE::MCM_BAUD_NEG_IDLE != this->baud_neg_state) || (MCM_RESET_STATE::MCM_RESET_IDLE != this->reset_state))
     {
-        Serial.println("---------------------------------Received debug info-------------------------------------");
+        Serial.println("negotiate_baud_rate: Negotiation or reset already in progress");
+        return MCM_STATUS::MCM_ERROR;
     }
-    
-    //  if y-modem is enabled then send the data to the ymodem protocol only
-    if (this->ymodem.getState() != YMODEM_IDLE) 
-    {
-      Serial.printf("YMODEM RX :(%d bytes) ", this->received_size);
-      // for (int i = 0; i < this->received_size; i++) 
-      // {
-      //   Serial.printf("%02x ", temp_buffer[i]);
-      // }
-      Serial.println("");
-      this->ymodem.receivePacket(temp_buffer, this->received_size);
-      this->set_received_size(0);
-      this->set_is_rx_received(0);
-    } 
-    else 
+
+    // the modem firmware version tells up to which rate the mcm can go
+    this->baud_neg_op.complete_cb  = callback;
+    this->baud_neg_op.user_context = user_context;
+    this->baud_neg_target = max_baud_rate;
+    this->baud_neg_index = 0;
+    this->baud_neg_status = MCM_STATUS::MCM_OK;
+    this->baud_neg_state = MCM_BAUD_NEG_STATE::MCM_BAUD_NEG_GET_VERSION;
+    this->set_next_command_callback(on_baud_neg_command_complete, this);
+    MCM_STATUS status = this->queue_command(api_processor_cmd_get_version(this->module));
+    if (MCM_STATUS::MCM_OK != status)
     {
-      Serial.printf("HMI RX :(%d bytes) ", this->received_size);
-      for (int i = 0; i < this->received_size; i++) 
-      {
-        Serial.printf("%02x ", temp_buffer[i]);
-      }
-      Serial.println("");
-      api_processor_parse_rx_data(this->module, temp_buffer, this->received_size);  // TODO Oxit: Check if this can print just nothing
+        Serial.println("negotiate_baud_rate: Failed to send get version command");
+        this->baud_neg_state = MCM_BAUD_NEG_STATE::MCM_BAUD_NEG_IDLE;
+        this->baud_neg_op = {};
     }
-
-    if (this->get_is_debug_enabled())
-        Serial.println("-----------------------------------------------------------------------------------------");
+    return status;
 }
 
-void MCM::sw_reset()
+bool MCM::is_baud_negotiation_pending()
 {
-    // send the request to reset the module
-    api_processor_cmd_reset(this->module);
-
-    this->process_received_data();
-
-    // device would not be reset until we get all the event for the device
-    while (api_processor_get_pending_events(this->module) > 0)
-    {
-        api_processor_cmd_get_event(this->module); // send the get event command
+    return (MCM_BAUD_NEG_STATE::MCM_BAUD_NEG_IDLE != this->baud_neg_state);
+}
 
-        this->process_received_data();
-    }
+uint32_t MCM::get_baud_rate()
+{
+    return this->_baud_rate;
+}
 
-    delay(1000);
+uint32_t MCM::get_link_throughput()
+{
+    // 8N1, every byte takes a start bit, 8 data bits and a stop bit on the wire
+    return this->_baud_rate / 10;
 }
 
-void MCM::set_connect_mode(ConnectionMode mode)
+uint32_t MCM::get_max_supported_baud_rate()
 {
-    this->current_mode = mode;
+    for (uint8_t i = 0; i < (sizeof(s_baud_capability_table) / sizeof(s_baud_capability_table[0])); i++)
+    {
+        const ver_type_2_t *min_fw = &s_baud_capability_table[i].min_modem_fw;
+        if ((this->modem_fw_version.major != min_fw->major) ? (this->modem_fw_version.major > min_fw->major) :
+            (this->modem_fw_version.minor != min_fw->minor) ? (this->modem_fw_version.minor > min_fw->minor) :
+            (this->modem_fw_version.patch >= min_fw->patch))
+        {
+            return s_baud_capability_table[i].max_baud_rate;
+        }
+    }
+    return MROVER_DEFAULT_BAUD_RATE;
 }
 
-ConnectionMode MCM::get_connect_mode()
+void MCM::apply_baud_rate(uint32_t baud_rate)
 {
-    return this->current_mode;
+    // the bytes already written still go out at the previous rate
+    this->__mcm_serial.flush();
+    this->__mcm_serial.updateBaudRate(baud_rate);
+    this->_baud_rate = baud_rate;
+    // whatever was received around the switch cannot be trusted
+    rx_ring_consume(&this->rx_ring, rx_ring_get_count(&this->rx_ring));
+    api_processor_reset_rx(this->module);
 }
 
-MCM_STATUS MCM::set_lorawan_credentials(uint8_t *dev_eui, uint8_t *join_eui, uint8_t *app_key)
+bool MCM::switch_next_baud_rate()
 {
-    MCM_STATUS status = MCM_STATUS::MCM_ERROR;
-    api_processor_status_t api_status = API_PROCESSOR_ERROR;
-    do
+    for (; this->baud_neg_index < (sizeof(s_baud_rates) / sizeof(s_baud_rates[0])); this->baud_neg_index++)
     {
-        if (ConnectionMode::CONNECTION_MODE_LORAWAN != this->current_mode)
+        uint32_t baud_rate = s_baud_rates[this->baud_neg_index];
+        if ((baud_rate > this->baud_neg_target) || (baud_rate <= this->_baud_rate))
         {
-            break;
+            continue;
         }
 
-        // initiating the lorawan connection
-        api_status = api_processor_cmd_init_lorawan(this->module);
-        if (API_PROCESSOR_SUCCESS != api_status)
+        this->baud_neg_previous_rate = this->_baud_rate;
+        this->baud_neg_state = MCM_BAUD_NEG_STATE::MCM_BAUD_NEG_SWITCH;
+        this->set_next_command_callback(on_baud_neg_command_complete, this);
+        if (MCM_STATUS::MCM_OK == this->queue_command(api_processor_cmd_set_uart_baud(this->module, baud_rate)))
         {
-            break;
+            return true;
         }
-        // wait for the response
-        this->process_received_data();
+        Serial.println("negotiate_baud_rate: Failed to send set uart baud command");
+        this->baud_neg_status = MCM_STATUS::MCM_ERROR;
+    }
+    return false;
+}
 
-        // set dev eui
-        api_status = api_processor_cmd_set_dev_eui(this->module, dev_eui, LORAWAN_DEV_EUI_JOIN_EUI_LEN);
+bool MCM::verify_link()
+{
+    uint32_t timeout = this->serial_rx_timeout;
 
-        if (API_PROCESSOR_SUCCESS != api_status)
-        {
-            break;
-        }
-        // wait for the response
-        this->process_received_data();
-        // set join eui
-        api_status = api_processor_cmd_set_join_eui(this->module, join_eui, LORAWAN_DEV_EUI_JOIN_EUI_LEN);
-        if (API_PROCESSOR_SUCCESS != api_status)
-        {
-            break;
-        }
-        // wait for the response
-        this->process_received_data();
-        // set app key
-        api_status = api_processor_cmd_set_nwk_key(this->module, app_key, LORAWAN_NETWORK_KEY_LEN);
-        if (API_PROCESSOR_SUCCESS != api_status)
-        {
-            break;
-        }
-        // wait for the response
-        this->process_received_data();
-        status = MCM_STATUS::MCM_OK;
+    // short timeout, the mcm falls back on its own if it does not hear from the host in time
+    this->serial_rx_timeout = MCM_BAUD_VERIFY_TIMEOUT_MS;
+    this->set_next_command_callback(on_baud_neg_command_complete, this);
+    MCM_STATUS status = this->queue_command(api_processor_cmd_get_version(this->module));
+    this->serial_rx_timeout = timeout;
+    return (MCM_STATUS::MCM_OK == status);
+}
 
-    } while (0);
-    return status;
+void MCM::finish_baud_negotiation(MCM_STATUS status)
+{
+    this->baud_neg_state = MCM_BAUD_NEG_STATE::MCM_BAUD_NEG_IDLE;
+    Serial.printf("negotiate_baud_rate: %lu baud, %lu bytes/s\n", (unsigned long)this->_baud_rate, (unsigned long)this->get_link_throughput());
+    complete_op(&this->baud_neg_op, status, NULL);
 }
 
-MCM_STATUS MCM::connect_network()
+void MCM::on_baud_neg_command_complete(MCM_STATUS status, const api_processor_response_t *response, void *user_context)
 {
-    MCM_STATUS status = MCM_STATUS::MCM_ERROR;
-    api_processor_status_t api_status = API_PROCESSOR_ERROR;
-    do
+    (void)response;
+    MCM *mcm = (MCM *)user_context;
+
+    switch (mcm->baud_neg_state)
     {
-        if (ConnectionMode::CONNECTION_MODE_NC == this->current_mode)
+    case MCM_BAUD_NEG_STATE::MCM_BAUD_NEG_GET_VERSION:
+        if (MCM_STATUS::MCM_OK != status)
         {
+            Serial.println("negotiate_baud_rate: Modem version not received");
+            mcm->finish_baud_negotiation(status);
             break;
         }
-        else if (ConnectionMode::CONNECTION_MODE_LORAWAN == this->current_mode)
+        if (mcm->get_max_supported_baud_rate() < mcm->baud_neg_target)
         {
-            Serial.println("Initiating the lorawan connection");
-            // initiating the lorawan connection
-            api_status = api_processor_cmd_join_lorawan(this->module);
-            if (API_PROCESSOR_SUCCESS != api_status)
-            {
-                break;
-            }
-            // wait for the response
-            this->process_received_data();
-            status = MCM_STATUS::MCM_OK;
+            mcm->baud_neg_target = mcm->get_max_supported_baud_rate();
         }
-
-        else if (ConnectionMode::CONNECTION_MODE_SIDEWALK_BLE == this->current_mode)
+        Serial.printf("negotiate_baud_rate: current=%lu target=%lu\n", (unsigned long)mcm->_baud_rate, (unsigned long)mcm->baud_neg_target);
+        if (false == mcm->switch_next_baud_rate())
         {
-            // TODO: connect with sidwalk ble
-            // connect with css
-            api_status = api_processor_cmd_sid_ble_link_request(this->module);
-            if (API_PROCESSOR_SUCCESS != api_status)
-            {
-                break;
-            }
-            // wait for the response
-            this->process_received_data();
-            status = MCM_STATUS::MCM_OK;
+            mcm->finish_baud_negotiation(mcm->baud_neg_status);
         }
+        break;
 
-        else if (ConnectionMode::CONNECTION_MODE_SIDEWALK_FSK == this->current_mode)
+    case MCM_BAUD_NEG_STATE::MCM_BAUD_NEG_SWITCH:
+        if (MCM_STATUS::MCM_OK != status)
         {
-            // connect with fsk
-            api_status = api_processor_cmd_sid_fsk_link_request(this->module);
-            if (API_PROCESSOR_SUCCESS != api_status)
+            // the mcm refused the rate, it keeps the current one and the next slower rate is tried
+            Serial.println("negotiate_baud_rate: Baud rate not accepted by the mcm");
+            mcm->baud_neg_status = MCM_STATUS::MCM_ERROR;
+            mcm->baud_neg_index++;
+            if (false == mcm->switch_next_baud_rate())
             {
-                break;
+                mcm->finish_baud_negotiation(mcm->baud_neg_status);
             }
-            // wait for the response
-            this->process_received_data();
-            status = MCM_STATUS::MCM_OK;
+            break;
         }
+        // the response was the last frame at the previous rate
+        mcm->apply_baud_rate(s_baud_rates[mcm->baud_neg_index]);
+        mcm->baud_neg_time = millis();
+        mcm->baud_neg_state = MCM_BAUD_NEG_STATE::MCM_BAUD_NEG_SETTLE;
+        break;
 
-        else if (ConnectionMode::CONNECTION_MODE_SIDEWALK_CSS == this->current_mode)
+    case MCM_BAUD_NEG_STATE::MCM_BAUD_NEG_VERIFY:
+        if (MCM_STATUS::MCM_OK == status)
         {
-            // connect with css
-            api_status = api_processor_cmd_sid_css_link_request(this->module);
-            if (API_PROCESSOR_SUCCESS != api_status)
-            {
-                break;
-            }
-            // wait for the response
-            this->process_received_data();
-            status = MCM_STATUS::MCM_OK;
+            Serial.printf("negotiate_baud_rate: link verified at %lu baud\n", (unsigned long)mcm->_baud_rate);
+            mcm->finish_baud_negotiation(MCM_STATUS::MCM_OK);
+            break;
         }
+        // the mcm goes back to the previous rate once the verify window is over
+        Serial.printf("negotiate_baud_rate: no response at %lu baud, falling back to %lu\n", (unsigned long)mcm->_baud_rate, (unsigned long)mcm->baud_neg_previous_rate);
+        mcm->apply_baud_rate(mcm->baud_neg_previous_rate);
+        mcm->baud_neg_time = millis();
+        mcm->baud_neg_state = MCM_BAUD_NEG_STATE::MCM_BAUD_NEG_FALLBACK;
+        break;
 
-        // set context manager that joined received
-        this->set_context_mgr_is_joined_cmd_received(true);
-    } while (0);
-    return status;
-}
-
-void MCM::handle_rx_events()
-{
-    // check if any data to process
-    // TODO: add the timeout here
-    if (this->is_rx_received)
-    {
-        //Serial.println("handle_rx_events: RX data received");
-        this->process_received_data();
-        //Serial.println("handle_rx_events: Data processed");
-        this->is_rx_received = 0;
-    }
-    // TODO: Oxit: process ymodem loop
-    //  device would not be reset until we get all the event for the device
-    if (this->ymodem.getState() != YMODEM_IDLE)
-    {
-        this->ymodem.process_timeout();
-        while (this->__mcm_serial.available())
+    case MCM_BAUD_NEG_STATE::MCM_BAUD_NEG_VERIFY_FALLBACK:
+        if (MCM_STATUS::MCM_OK != status)
         {
-            this->received_size = this->__mcm_serial.readBytes(temp_buffer, BUFFER_SIZE);
-            Serial.printf("handle_rx_events: Read %d bytes from serial\n", this->received_size);
-            this->is_rx_received = 1;
+            Serial.println("MCM: Link lost after the baud rate fallback, reset the mcm");
+            mcm->finish_baud_negotiation(MCM_STATUS::MCM_TIMEOUT);
+            break;
         }
+        mcm->baud_neg_status = MCM_STATUS::MCM_ERROR;
+        mcm->baud_neg_index++;
+        if (false == mcm->switch_next_baud_rate())
+        {
+            mcm->finish_baud_negotiation(mcm->baud_neg_status);
+        }
+        break;
 
-        return;
-    }
-    
-    while (api_processor_get_pending_events(this->module) > 0)
-    {
-        Serial.println("handle_rx_events: Pending events detected");
-        api_processor_cmd_get_event(this->module); // send the get event command
-        Serial.println("handle_rx_events: Get event command sent");
-
-        this->process_received_data();
-        Serial.println("handle_rx_events: Event data processed");
+    default:
+        break;
     }
 }
 
-bool MCM::is_connected()
-{
-    return this->is_joined_network;
-}
-
-bool MCM::is_last_uplink_pending()
-{
-    return this->is_last_uplink_pend;
-}
-
-MCM_TX_STATUS MCM::get_last_tx_status()
-{
-    return this->last_tx_status;
-}
-
-void MCM::send_uplink(uint8_t *data, uint16_t len, uint8_t port, MCM_UPLINK_TYPE send_uplink)
+void MCM::pump_baud_negotiation()
 {
-    this->is_last_uplink_pend = true;
-    api_processor_status_t api_status = API_PROCESSOR_ERROR;
+    MCM_BAUD_NEG_STATE next_state;
 
-    /// Uplink Type conversion
-    mrover_uplink_type_t uplink_type = MROVER_UNCONFIRMED_UPLINK;
-    if (MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF == send_uplink)
-    {
-        uplink_type = MROVER_UNCONFIRMED_UPLINK;
-    }
-    else
+    if ((MCM_BAUD_NEG_STATE::MCM_BAUD_NEG_SETTLE == this->baud_neg_state) && ((millis() - this->baud_neg_time) >= MCM_BAUD_SETTLE_MS))
     {
-        uplink_type = MROVER_CONFIRMED_UPLINK;
+        next_state = MCM_BAUD_NEG_STATE::MCM_BAUD_NEG_VERIFY;
     }
-
-    /// Uplink will be done on the currently active network
-    if (ConnectionMode::CONNECTION_MODE_LORAWAN == this->current_mode)
+    else if ((MCM_BAUD_NEG_STATE::MCM_BAUD_NEG_FALLBACK == this->baud_neg_state) && ((millis() - this->baud_neg_time) >= MROVER_BAUD_VERIFY_WINDOW_MS))
     {
-        api_status = api_processor_cmd_request_lorawan_uplink(this->module, port, data, len, uplink_type);
+        next_state = MCM_BAUD_NEG_STATE::MCM_BAUD_NEG_VERIFY_FALLBACK;
     }
     else
     {
-        /// BLE connection will be established before attempting an uplink for sidewalk BLE mode
-        if (ConnectionMode::CONNECTION_MODE_SIDEWALK_BLE == this->current_mode)
-        {
-            api_status = api_processor_cmd_sid_ble_conn_request(this->module);
-            delay(5000);
-        }
-        api_status = api_processor_cmd_sid_send_uplink(this->module, data, len, uplink_type);
+        return;
     }
 
-    if (API_PROCESSOR_SUCCESS == api_status)
+    this->baud_neg_state = next_state;
+    if (false == this->verify_link())
     {
-        this->process_received_data();
+        on_baud_neg_command_complete(MCM_STATUS::MCM_ERROR, NULL, this);
     }
 }
 
-void MCM::set_on_rx_callback(on_rx_callback callback)
-{
-    this->on_rx_callback_func = callback;
-}
-
-void MCM::stop_network()
+void MCM::receive_serial_bytes()
 {
-    this->is_joined_network = false;
-    do
+    // only producer of the rx ring, bytes go straight from the uart driver into the ring
+    int available;
+    while ((available = this->__mcm_serial.available()) > 0)
     {
-        if (ConnectionMode::CONNECTION_MODE_NC == this->current_mode)
+        uint8_t *p_data;
+        uint16_t free_len = rx_ring_get_write_ptr(&this->rx_ring, &p_data);
+        size_t read_len;
+        if (0 == free_len)
         {
-            break;
+            // ring is full, the bytes are dropped and accounted so the uart driver does not stall
+            uint8_t discard[32];
+            read_len = this->__mcm_serial.readBytes(discard, ((size_t)available < sizeof(discard)) ? available : sizeof(discard));
+            rx_ring_add_overrun(&this->rx_ring, read_len);
+        }
+        else
+        {
+            read_len = this->__mcm_serial.readBytes(p_data, ((uint16_t)available < free_len) ? available : free_len);
+            rx_ring_commit(&this->rx_ring, read_len);
+        }
+        if (0 == read_len)
+        {
+            break;
+        }
+    }
+}
+
+void MCM::process_received_data()
+{
+    if (0 == rx_ring_get_count(&this->rx_ring))
+    {
+        return;
+    }
+    if (this->get_is_debug_enabled())
+    {
+        Serial.println("---------------------------------Received debug info-------------------------------------");
+    }
+    
+    //  if y-modem is enabled then send the data to the ymodem protocol only
+    if (this->ymodem.getState() != YMODEM_IDLE) 
+    {
+      // the ymodem receiver reassembles its packets, the bytes can be split anywhere
+      uint16_t received_size = rx_ring_read(&this->rx_ring, this->rx_buffer, BUFFER_SIZE);
+      Serial.printf("YMODEM RX :(%d bytes) ", received_size);
+      Serial.println("");
+      this->ymodem.receivePacket(this->rx_buffer, received_size);
+    } 
+    else 
+    {
+      // the decoder reassembles the frames, the bytes are parsed in place from the ring
+      const uint8_t *p_data;
+      uint16_t received_size;
+      while ((received_size = rx_ring_get_read_ptr(&this->rx_ring, &p_data)) > 0)
+      {
+        if (this->get_is_debug_enabled())
+        {
+          Serial.printf("HMI RX :(%d bytes) ", received_size);
+          for (int i = 0; i < received_size; i++) 
+          {
+            Serial.printf("%02x ", p_data[i]);
+          }
+          Serial.println("");
+        }
+        api_processor_parse_rx_data(this->module, (uint8_t *)p_data, received_size);
+        rx_ring_consume(&this->rx_ring, received_size);
+      }
+    }
+
+    if (this->get_is_debug_enabled())
+        Serial.println("-----------------------------------------------------------------------------------------");
+}
+
+bool MCM::send_command(mcm_cmd_entry_t *cmd)
+{
+    if (this->get_is_debug_enabled())
+    {
+        Serial.printf("HMI TX: (%d Bytes)", cmd->frame_len);
+        for (int i = 0; i < cmd->frame_len; i++)
+        {
+            Serial.printf(" %02x", cmd->frame[i]);
+        }
+        Serial.println("");
+    }
+
+    if (cmd->frame_len != this->__mcm_serial.write(cmd->frame, cmd->frame_len))
+    {
+        Serial.println("MCM: Failed to write the command to the serial port");
+        return false;
+    }
+    cmd->is_sent   = true;
+    cmd->sent_time = millis();
+    return true;
+}
+
+void MCM::pump_command_queue()
+{
+    while (this->cmd_queue_count > 0)
+    {
+        mcm_cmd_entry_t *cmd = &this->cmd_queue[this->cmd_queue_head];
+
+        if (false == cmd->is_sent)
+        {
+            if (false == this->send_command(cmd))
+            {
+                this->complete_command(MCM_STATUS::MCM_ERROR, NULL);
+                continue;
+            }
+            this->pump_event_window();
+            break;
+        }
+
+        if ((millis() - cmd->sent_time) < cmd->timeout)
+        {
+            // still waiting for the response
+            this->pump_event_window();
+            break;
+        }
+
+        Serial.println("MCM: Response not received, Please check the connection");
+        this->complete_command(MCM_STATUS::MCM_TIMEOUT, NULL);
+    }
+}
+
+void MCM::pump_event_window()
+{
+    // get event commands following the one in progress are sent without waiting,
+    // the mcm answers them in order so the responses still complete the queue head
+    if (MROVER_CC_GET_EVENT != get_cmd_entry_code(&this->cmd_queue[this->cmd_queue_head]))
+    {
+        return;
+    }
+
+    for (uint8_t i = 1; (i < this->cmd_queue_count) && (i < MCM_EVENT_DRAIN_WINDOW); i++)
+    {
+        mcm_cmd_entry_t *cmd = &this->cmd_queue[(this->cmd_queue_head + i) % MCM_CMD_QUEUE_SIZE];
+        if (MROVER_CC_GET_EVENT != get_cmd_entry_code(cmd))
+        {
+            break;
+        }
+        if ((false == cmd->is_sent) && (false == this->send_command(cmd)))
+        {
+            // retried on the next pump, once it becomes the queue head at the latest
+            break;
+        }
+    }
+}
+
+void MCM::complete_command(MCM_STATUS status, const api_processor_response_t *response)
+{
+    mcm_cmd_entry_t *cmd = &this->cmd_queue[this->cmd_queue_head];
+    on_cmd_complete_callback complete_cb = cmd->complete_cb;
+    void *user_context = cmd->user_context;
+    bool is_chained = cmd->is_chained;
+
+    // remove the command before calling the callback, callback can queue the next command
+    this->cmd_queue_head = (this->cmd_queue_head + 1) % MCM_CMD_QUEUE_SIZE;
+    this->cmd_queue_count--;
+
+    // a failed step drops the rest of its sequence, the callback of the last step reports the failure
+    while (is_chained && (MCM_STATUS::MCM_OK != status) && (this->cmd_queue_count > 0))
+    {
+        cmd = &this->cmd_queue[this->cmd_queue_head];
+        complete_cb  = cmd->complete_cb;
+        user_context = cmd->user_context;
+        is_chained   = cmd->is_chained;
+        this->cmd_queue_head = (this->cmd_queue_head + 1) % MCM_CMD_QUEUE_SIZE;
+        this->cmd_queue_count--;
+    }
+
+    if (nullptr != complete_cb)
+    {
+        complete_cb(status, response, user_context);
+    }
+}
+
+bool MCM::is_command_queued(mrover_cc_codes_t cmd_code)
+{
+    return (this->count_queued_commands(cmd_code) > 0);
+}
+
+uint8_t MCM::count_queued_commands(mrover_cc_codes_t cmd_code)
+{
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < this->cmd_queue_count; i++)
+    {
+        if (cmd_code == get_cmd_entry_code(&this->cmd_queue[(this->cmd_queue_head + i) % MCM_CMD_QUEUE_SIZE]))
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+void MCM::queue_event_requests()
+{
+    // every get event response carries the number of events still pending in the mcm,
+    // the requests already queued are answered from those
+    uint8_t pending = api_processor_get_pending_events(this->module);
+    uint8_t target = (pending < MCM_EVENT_DRAIN_WINDOW) ? pending : MCM_EVENT_DRAIN_WINDOW;
+    uint8_t queued = this->count_queued_commands(MROVER_CC_GET_EVENT);
+
+    while (queued < target)
+    {
+        if (API_PROCESSOR_SUCCESS != api_processor_cmd_get_event(this->module))
+        {
+            break;
+        }
+        queued++;
+    }
+}
+
+void MCM::record_event(const api_processor_response_t *response)
+{
+    if ((MROVER_CC_GET_EVENT != response->cmd_code) || (MROVER_RC_OK != response->return_code))
+    {
+        return;
+    }
+    if (MAX_PENDING_MESSAGES == this->event_batch_count)
+    {
+        this->flush_event_batch();
+    }
+    this->event_batch[this->event_batch_count++] = mcm_helper_get_event_code(response);
+}
+
+void MCM::flush_event_batch()
+{
+    uint8_t count = this->event_batch_count;
+    this->event_batch_count = 0;
+    if ((count > 0) && (nullptr != this->event_batch_cb))
+    {
+        this->event_batch_cb(this->event_batch, count, this->event_batch_user_context);
+    }
+}
+
+void MCM::set_on_event_batch_callback(on_event_batch_callback callback, void *user_context)
+{
+    this->event_batch_cb = callback;
+    this->event_batch_user_context = user_context;
+}
+
+void MCM::take_next_command_callback(mcm_cmd_entry_t *cmd)
+{
+    cmd->complete_cb  = this->next_cmd_complete_cb;
+    cmd->user_context = this->next_cmd_user_context;
+    cmd->is_chained   = this->next_cmd_is_chained;
+    this->next_cmd_complete_cb  = nullptr;
+    this->next_cmd_user_context = nullptr;
+    this->next_cmd_is_chained   = false;
+}
+
+void MCM::cut_command_sequence()
+{
+    // the last queued step ends the sequence, a later failure does not drop unrelated commands
+    if (this->cmd_queue_count > 0)
+    {
+        this->cmd_queue[(this->cmd_queue_head + this->cmd_queue_count - 1) % MCM_CMD_QUEUE_SIZE].is_chained = false;
+    }
+}
+
+/**
+ * @brief Result of an api processor command sent after set_next_command_callback(). A command which
+ *  is not queued does not keep the callback for the next one.
+ *
+ * @param api_status Status returned by the api processor command
+ * @return MCM_STATUS MCM_OK if queued, the callback is then called once the command is completed
+ */
+MCM_STATUS MCM::queue_command(api_processor_status_t api_status)
+{
+    if (API_PROCESSOR_SUCCESS == api_status)
+    {
+        return MCM_STATUS::MCM_OK;
+    }
+    this->next_cmd_complete_cb  = nullptr;
+    this->next_cmd_user_context = nullptr;
+    this->next_cmd_is_chained   = false;
+    return (API_PROCESSOR_INVALID_PARAMETERS == api_status) ? MCM_STATUS::MCM_PARAM_ERROR : MCM_STATUS::MCM_ERROR;
+}
+
+void MCM::complete_op(mcm_op_callback_t *op, MCM_STATUS status, const api_processor_response_t *response)
+{
+    on_cmd_complete_callback complete_cb = op->complete_cb;
+    void *user_context = op->user_context;
+
+    // cleared first, the callback can start the operation again
+    op->complete_cb  = nullptr;
+    op->user_context = nullptr;
+    if (nullptr != complete_cb)
+    {
+        complete_cb(status, response, user_context);
+    }
+}
+
+uint16_t MCM::enqueue_command(const uint8_t *frame, uint16_t len)
+{
+    if (MAX_SERIAL_SEND_PAYLOAD_SIZE < len)
+    {
+        Serial.printf("MCM: Command of %u Bytes is too long\n", len);
+        return 0;
+    }
+    if (MCM_CMD_QUEUE_SIZE <= this->cmd_queue_count)
+    {
+        Serial.println("MCM: Command queue is full");
+        return 0;
+    }
+
+    mcm_cmd_entry_t *cmd = &this->cmd_queue[(this->cmd_queue_head + this->cmd_queue_count) % MCM_CMD_QUEUE_SIZE];
+    memcpy(cmd->frame, frame, len);
+    cmd->frame_len    = len;
+    cmd->timeout      = this->serial_rx_timeout;
+    cmd->is_sent      = false;
+    this->take_next_command_callback(cmd);
+    this->cmd_queue_count++;
+
+    // send right away if the mcm is not busy with another command
+    this->pump_command_queue();
+    return len;
+}
+
+uint16_t MCM::enqueue_command_vector(const serial_tx_segment_t *segments, uint8_t count)
+{
+    uint16_t len = 0;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        len += segments[i].u16_len;
+    }
+    if ((0 == count) || (MCM_CMD_HEADER_LEN > segments[0].u16_len))
+    {
+        Serial.println("MCM: Command header is missing");
+        return 0;
+    }
+    if (MAX_SERIAL_SEND_PAYLOAD_SIZE < len)
+    {
+        Serial.printf("MCM: Command of %u Bytes is too long\n", len);
+        return 0;
+    }
+    if (MCM_CMD_QUEUE_SIZE <= this->cmd_queue_count)
+    {
+        Serial.println("MCM: Command queue is full");
+        return 0;
+    }
+
+    // the application callback is taken over only once the command is sent or queued,
+    // a rejected command leaves it for the next one as enqueue_command() does
+    mcm_cmd_entry_t *cmd = &this->cmd_queue[(this->cmd_queue_head + this->cmd_queue_count) % MCM_CMD_QUEUE_SIZE];
+    cmd->frame_len    = len;
+    cmd->timeout      = this->serial_rx_timeout;
+    cmd->is_sent      = false;
+
+    if (0 == this->cmd_queue_count)
+    {
+        // the mcm is idle, the segments go straight to the serial port and only the
+        // header is kept to match the response
+        memcpy(cmd->frame, segments[0].p_data, MCM_CMD_HEADER_LEN);
+        if (this->get_is_debug_enabled())
+        {
+            Serial.printf("HMI TX: (%d Bytes)", len);
+        }
+        uint16_t written = 0;
+        for (uint8_t i = 0; i < count; i++)
+        {
+            if (this->get_is_debug_enabled())
+            {
+                for (uint16_t j = 0; j < segments[i].u16_len; j++)
+                {
+                    Serial.printf(" %02x", segments[i].p_data[j]);
+                }
+            }
+            if (0 != segments[i].u16_len)
+            {
+                written += this->__mcm_serial.write(segments[i].p_data, segments[i].u16_len);
+            }
+        }
+        if (this->get_is_debug_enabled())
+        {
+            Serial.println("");
+        }
+        if (len != written)
+        {
+            Serial.println("MCM: Failed to write the command to the serial port");
+            return 0;
+        }
+        cmd->is_sent   = true;
+        cmd->sent_time = millis();
+        this->take_next_command_callback(cmd);
+        this->cmd_queue_count++;
+        return len;
+    }
+
+    // the command waits in the queue, the segments are gathered into the entry
+    uint16_t offset = 0;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (0 != segments[i].u16_len)
+        {
+            memcpy(&cmd->frame[offset], segments[i].p_data, segments[i].u16_len);
+            offset += segments[i].u16_len;
+        }
+    }
+    this->take_next_command_callback(cmd);
+    this->cmd_queue_count++;
+    this->pump_command_queue();
+    return len;
+}
+
+void MCM::on_command_response(const api_processor_response_t *response)
+{
+    if (0 == this->cmd_queue_count || false == this->cmd_queue[this->cmd_queue_head].is_sent)
+    {
+        return;
+    }
+
+    const mcm_cmd_entry_t *cmd = &this->cmd_queue[this->cmd_queue_head];
+    uint16_t cmd_code = get_cmd_entry_code(cmd);
+    if (cmd_code != response->cmd_code)
+    {
+        // response of an older command which has already timed out
+        return;
+    }
+
+    // get event response carries the command type of the event, not the one sent
+    if (MROVER_CC_GET_EVENT != cmd_code && cmd->frame[0] != response->cmd_type)
+    {
+        return;
+    }
+
+    this->complete_command((MROVER_RC_OK == response->return_code) ? MCM_STATUS::MCM_OK : MCM_STATUS::MCM_ERROR, response);
+    if (MROVER_CC_GET_EVENT == cmd_code)
+    {
+        // refill the window right away, without waiting for the next loop
+        this->queue_event_requests();
+    }
+    this->pump_command_queue();
+}
+
+/**
+ * @brief Callback of the next command sent with an api_processor_cmd_*() function. The commands of
+ *  this class take their callback as a parameter and replace the one set here.
+ */
+void MCM::set_next_command_callback(on_cmd_complete_callback callback, void *user_context)
+{
+    this->next_cmd_complete_cb  = callback;
+    this->next_cmd_user_context = user_context;
+}
+
+bool MCM::is_command_pending()
+{
+    return (this->cmd_queue_count > 0);
+}
+
+/**
+ * @brief Resets the mcm with the reset command, its reset event is then drained by handle_rx_events().
+ *
+ * @return MCM_STATUS MCM_OK if the command has been queued, the callback gets its response
+ */
+MCM_STATUS MCM::sw_reset(on_cmd_complete_callback callback, void *user_context)
+{
+    if (MCM_RESET_STATE::MCM_RESET_IDLE != this->reset_state)
+    {
+        Serial.println("MCM: Reset already in progress");
+        return MCM_STATUS::MCM_ERROR;
+    }
+
+    this->reset_op.complete_cb  = callback;
+    this->reset_op.user_context = user_context;
+    this->reset_state = MCM_RESET_STATE::MCM_RESET_COMMAND;
+    this->set_next_command_callback(on_reset_command_complete, this);
+    MCM_STATUS status = this->queue_command(api_processor_cmd_reset(this->module));
+    if (MCM_STATUS::MCM_OK != status)
+    {
+        this->reset_state = MCM_RESET_STATE::MCM_RESET_IDLE;
+        this->reset_op = {};
+    }
+    return status;
+}
+
+void MCM::on_reset_command_complete(MCM_STATUS status, const api_processor_response_t *response, void *user_context)
+{
+    MCM *mcm = (MCM *)user_context;
+
+    // the mcm restarts at the default rate once the response is sent, its reset event comes at that rate
+    if ((MCM_STATUS::MCM_OK == status) && (MROVER_DEFAULT_BAUD_RATE != mcm->_baud_rate))
+    {
+        mcm->apply_baud_rate(MROVER_DEFAULT_BAUD_RATE);
+    }
+    mcm->reset_state = MCM_RESET_STATE::MCM_RESET_IDLE;
+    complete_op(&mcm->reset_op, status, response);
+}
+
+bool MCM::is_reset_pending()
+{
+    return (MCM_RESET_STATE::MCM_RESET_IDLE != this->reset_state);
+}
+
+void MCM::set_connect_mode(ConnectionMode mode)
+{
+    this->current_mode = mode;
+    // the statistics of the link restart from its join
+    link_select_set_current(&this->link_select, (uint8_t)mode, millis());
+    ble_conn_reset(&this->ble_conn);
+}
+
+ConnectionMode MCM::get_connect_mode()
+{
+    return this->current_mode;
+}
+
+/**
+ * @brief Queues the lorawan init, dev eui, join eui and network key commands as one sequence.
+ *  A failed step drops the steps after it.
+ *
+ * @return MCM_STATUS MCM_OK if the sequence has been queued, the callback gets the result of the
+ *  failed step or of the last one
+ */
+MCM_STATUS MCM::set_lorawan_credentials(uint8_t *dev_eui, uint8_t *join_eui, uint8_t *app_key,
+                                        on_cmd_complete_callback callback, void *user_context)
+{
+    MCM_STATUS status = MCM_STATUS::MCM_ERROR;
+    do
+    {
+        if (ConnectionMode::CONNECTION_MODE_LORAWAN != this->current_mode)
+        {
+            break;
+        }
+        status = MCM_STATUS::MCM_PARAM_ERROR;
+        _ASSERT_PRINT((dev_eui != NULL) && (join_eui != NULL) && (app_key != NULL), "Null pointer provided for the lorawan credentials");
+        status = MCM_STATUS::MCM_ERROR;
+        _ASSERT_PRINT(4 <= (MCM_CMD_QUEUE_SIZE - this->cmd_queue_count), "MCM: Command queue is full");
+
+        // initiating the lorawan connection
+        this->next_cmd_is_chained = true;
+        status = this->queue_command(api_processor_cmd_init_lorawan(this->module));
+        if (MCM_STATUS::MCM_OK != status)
+        {
+            break;
+        }
+
+        // set dev eui
+        this->next_cmd_is_chained = true;
+        status = this->queue_command(api_processor_cmd_set_dev_eui(this->module, dev_eui, LORAWAN_DEV_EUI_JOIN_EUI_LEN));
+        if (MCM_STATUS::MCM_OK != status)
+        {
+            this->cut_command_sequence();
+            break;
+        }
+        // set join eui
+        this->next_cmd_is_chained = true;
+        status = this->queue_command(api_processor_cmd_set_join_eui(this->module, join_eui, LORAWAN_DEV_EUI_JOIN_EUI_LEN));
+        if (MCM_STATUS::MCM_OK != status)
+        {
+            this->cut_command_sequence();
+            break;
+        }
+        // set app key, last step of the sequence
+        this->set_next_command_callback(callback, user_context);
+        status = this->queue_command(api_processor_cmd_set_nwk_key(this->module, app_key, LORAWAN_NETWORK_KEY_LEN));
+        if (MCM_STATUS::MCM_OK != status)
+        {
+            this->cut_command_sequence();
+            break;
+        }
+
+    } while (0);
+    return status;
+}
+
+MCM_STATUS MCM::connect_network(on_cmd_complete_callback callback, void *user_context)
+{
+    MCM_STATUS status = MCM_STATUS::MCM_ERROR;
+    api_processor_status_t api_status = API_PROCESSOR_ERROR;
+    do
+    {
+        if (ConnectionMode::CONNECTION_MODE_NC == this->current_mode)
+        {
+            break;
+        }
+
+        this->set_next_command_callback(callback, user_context);
+        if (ConnectionMode::CONNECTION_MODE_LORAWAN == this->current_mode)
+        {
+            Serial.println("Initiating the lorawan connection");
+            // initiating the lorawan connection
+            api_status = api_processor_cmd_join_lorawan(this->module);
+        }
+
+        else if (ConnectionMode::CONNECTION_MODE_SIDEWALK_BLE == this->current_mode)
+        {
+            // TODO: connect with sidwalk ble
+            api_status = api_processor_cmd_sid_ble_link_request(this->module);
+        }
+
+        else if (ConnectionMode::CONNECTION_MODE_SIDEWALK_FSK == this->current_mode)
+        {
+            // connect with fsk
+            api_status = api_processor_cmd_sid_fsk_link_request(this->module);
+        }
+
+        else if (ConnectionMode::CONNECTION_MODE_SIDEWALK_CSS == this->current_mode)
+        {
+            // connect with css
+            api_status = api_processor_cmd_sid_css_link_request(this->module);
+        }
+
+        status = this->queue_command(api_status);
+        if (MCM_STATUS::MCM_OK != status)
+        {
+            break;
+        }
+
+        // set context manager that joined received
+        this->set_context_mgr_is_joined_cmd_received(true);
+    } while (0);
+    return status;
+}
+
+void MCM::handle_rx_events()
+{
+    // check if any data to process
+    this->process_received_data();
+
+    // TODO: Oxit: process ymodem loop
+    //  device would not be reset until we get all the event for the device
+    if (this->ymodem.getState() != YMODEM_IDLE)
+    {
+        this->ymodem.process_timeout();
+        return;
+    }
+
+    // timed steps of the resets and of the baud rate negotiation
+    this->pump_reset();
+    this->pump_baud_negotiation();
+
+    // send the next queued command or time out the one in progress
+    this->pump_command_queue();
+
+    // send the next fragment or scheduled uplink once the previous one is reported by MODEM_EVENT_TXDONE
+    this->pump_fragmented_uplink();
+    this->pump_uplink_scheduler();
+    frag_rx_check_timeout(&this->frag_rx, millis());
+    this->pump_link_selection();
+
+    // drain the pending events with a window of get event commands in flight
+    this->queue_event_requests();
+
+    // the burst is over once nothing is pending nor requested
+    if ((0 == api_processor_get_pending_events(this->module)) && (false == this->is_command_queued(MROVER_CC_GET_EVENT)))
+    {
+        this->flush_event_batch();
+    }
+}
+
+bool MCM::is_connected()
+{
+    return this->is_joined_network;
+}
+
+bool MCM::is_last_uplink_pending()
+{
+    return this->is_last_uplink_pend;
+}
+
+MCM_TX_STATUS MCM::get_last_tx_status()
+{
+    return this->last_tx_status;
+}
+
+/**
+ * @brief Sends an uplink on the current connection mode right away, see queue_uplink() for the
+ *  scheduled form. A sidewalk ble uplink is refused while the connection is down, the connection
+ *  is requested and the uplink has to be sent again once it is up.
+ *
+ * @return MCM_OK if the uplink is requested to the modem
+ */
+MCM_STATUS MCM::send_uplink(uint8_t *data, uint16_t len, uint8_t port, MCM_UPLINK_TYPE send_uplink)
+{
+    if (false == this->pump_ble_connection())
+    {
+        if (this->is_debug_enabled)
+        {
+            Serial.printf("MCM: ble connection not up, uplink not sent\n");
+        }
+        return MCM_STATUS::MCM_ERROR;
+    }
+
+    this->is_last_uplink_pend = true;
+    this->uplink_sent_time = millis();
+    api_processor_status_t api_status = API_PROCESSOR_ERROR;
+
+    /// Uplink Type conversion
+    mrover_uplink_type_t uplink_type = MROVER_UNCONFIRMED_UPLINK;
+    if (MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF == send_uplink)
+    {
+        uplink_type = MROVER_UNCONFIRMED_UPLINK;
+    }
+    else
+    {
+        uplink_type = MROVER_CONFIRMED_UPLINK;
+    }
+
+    /// Uplink will be done on the currently active network
+    if (ConnectionMode::CONNECTION_MODE_LORAWAN == this->current_mode)
+    {
+        api_status = api_processor_cmd_request_lorawan_uplink(this->module, port, data, len, uplink_type);
+    }
+    else
+    {
+        /// Sidewalk BLE uplinks go on the connection opened by pump_ble_connection(), see queue_uplink()
+        if (ConnectionMode::CONNECTION_MODE_SIDEWALK_BLE == this->current_mode)
+        {
+            ble_conn_on_uplink(&this->ble_conn, millis());
+        }
+        api_status = api_processor_cmd_sid_send_uplink(this->module, data, len, uplink_type);
+    }
+
+    if (API_PROCESSOR_SUCCESS != api_status)
+    {
+        Serial.println("MCM: Failed to queue the uplink");
+        return MCM_STATUS::MCM_ERROR;
+    }
+    return MCM_STATUS::MCM_OK;
+}
+
+/**
+ * @brief Sends a payload larger than the uplink MTU in fragments, see frag.h for the layout.
+ *  The payload is copied and the next uplink MTU is asked, the payload is split with it once
+ *  received. The fragments are then sent one by one from handle_rx_events(), each once the
+ *  MODEM_EVENT_TXDONE of the previous one is received.
+ *  Other uplinks should wait until get_fragmented_uplink_state() is no longer in progress.
+ *  Lorawan fragments are sent on MCM_FRAG_LORAWAN_PORT.
+ *
+ * @param data Payload, up to MCM_FRAG_MAX_PAYLOAD_SIZE bytes
+ * @param len Length of the payload
+ * @param uplink_type Confirmed fragments are sent again until acknowledged
+ * @return MCM_STATUS MCM_OK if the next uplink MTU request has been queued
+ */
+MCM_STATUS MCM::send_fragmented_uplink(const uint8_t *data, uint16_t len, MCM_UPLINK_TYPE uplink_type)
+{
+    MCM_STATUS status = MCM_STATUS::MCM_PARAM_ERROR;
+    do
+    {
+        _ASSERT_PRINT((data != NULL) && (0 < len) && (MCM_FRAG_MAX_PAYLOAD_SIZE >= len), "Invalid fragmented uplink payload");
+
+        status = MCM_STATUS::MCM_ERROR;
+        _ASSERT_PRINT(MCM_FRAG_TX_STATE::MCM_FRAG_TX_IN_PROGRESS != this->frag_tx_state, "Fragmented uplink already in progress");
+        _ASSERT_PRINT(ConnectionMode::CONNECTION_MODE_NC != this->current_mode, "No network selected for the fragmented uplink");
+        _ASSERT_PRINT(false == this->is_last_uplink_pend, "Previous uplink still pending");
+        _ASSERT_PRINT(UPLINK_RETRY_IDLE == uplink_retry_get_state(&this->uplink_retry), "Previous uplink still retried");
+
+        memcpy(this->frag_tx_buffer, data, len);
+        this->frag_tx_len = len;
+        this->frag_tx_type = uplink_type;
+        this->frag_tx_index = 0;
+        this->frag_tx_retries = 0;
+        this->is_frag_tx_waiting_link = false;
+        this->is_frag_tx_waiting_mtu = true;
+        this->frag_tx_state = MCM_FRAG_TX_STATE::MCM_FRAG_TX_IN_PROGRESS;
+
+        status = this->req_next_uplink_mtu(on_frag_mtu_complete, this);
+        if (MCM_STATUS::MCM_OK != status)
+        {
+            this->is_frag_tx_waiting_mtu = false;
+            this->frag_tx_state = MCM_FRAG_TX_STATE::MCM_FRAG_TX_IDLE;
+        }
+    } while (0);
+
+    return status;
+}
+
+void MCM::on_frag_mtu_complete(MCM_STATUS status, const api_processor_response_t *response, void *user_context)
+{
+    (void)response;
+    MCM *mcm = (MCM *)user_context;
+    uint16_t mtu = mcm->nextUplink_mtu;
+
+    mcm->is_frag_tx_waiting_mtu = false;
+    // given up unless the fragments can be built at this MTU
+    mcm->frag_tx_state = MCM_FRAG_TX_STATE::MCM_FRAG_TX_FAILED;
+    do
+    {
+        _ASSERT_PRINT(MCM_STATUS::MCM_OK == status, "Next uplink MTU not received");
+        if (UPLINK_SCHED_MAX_PAYLOAD_SIZE < mtu)
+        {
+            mtu = UPLINK_SCHED_MAX_PAYLOAD_SIZE;
+        }
+        _ASSERT_PRINT(frag_tx_init(&mcm->frag_tx, mcm->frag_tx_buffer, mcm->frag_tx_len, mtu, mcm->frag_tx_msg_id), "Payload does not fit in the fragments at this MTU");
+        mcm->frag_tx_msg_id++;
+
+        for (uint8_t i = 0; i < frag_tx_get_count(&mcm->frag_tx); i++)
+        {
+            mcm->frag_tx_status[i] = MCM_TX_STATUS::MCM_TX_NOT_SEND;
+        }
+        Serial.printf("MCM: sending %d bytes in %d fragments, MTU %d\n", mcm->frag_tx_len, frag_tx_get_count(&mcm->frag_tx), mtu);
+
+        mcm->frag_tx_state = MCM_FRAG_TX_STATE::MCM_FRAG_TX_IN_PROGRESS;
+        mcm->send_fragment();
+    } while (0);
+}
+
+void MCM::send_fragment()
+{
+    uint8_t fragment[LORAWAN_TX_MAX_PAYLOAD_SIZE];
+    uint16_t len = frag_tx_build(&this->frag_tx, this->frag_tx_index, fragment);
+
+    // the fragment size is fixed for the message, a lorawan data rate change can lower the mtu meanwhile
+    if ((0 != this->nextUplink_mtu) && (len > this->nextUplink_mtu))
+    {
+        Serial.printf("MCM: fragment %d of %d bytes exceeds the uplink MTU %d\n", this->frag_tx_index, len, this->nextUplink_mtu);
+        this->frag_tx_state = MCM_FRAG_TX_STATE::MCM_FRAG_TX_FAILED;
+        return;
+    }
+
+    // sent by pump_fragmented_uplink() once the ble connection is up
+    if (false == this->pump_ble_connection())
+    {
+        this->is_frag_tx_waiting_link = true;
+        return;
+    }
+
+    this->send_uplink(fragment, len, MCM_FRAG_LORAWAN_PORT, this->frag_tx_type);
+}
+
+void MCM::pump_fragmented_uplink()
+{
+    if ((MCM_FRAG_TX_STATE::MCM_FRAG_TX_IN_PROGRESS != this->frag_tx_state) || this->is_frag_tx_waiting_mtu)
+    {
+        return;
+    }
+
+    if (this->is_frag_tx_waiting_link)
+    {
+        if (this->pump_ble_connection())
+        {
+            this->is_frag_tx_waiting_link = false;
+            this->send_fragment();
+        }
+        return;
+    }
+
+    MCM_TX_STATUS tx_status = this->last_tx_status;
+    if (this->is_last_uplink_pend)
+    {
+        if ((millis() - this->uplink_sent_time) < MCM_TXDONE_TIMEOUT_MS)
+        {
+            return;
+        }
+        // no MODEM_EVENT_TXDONE, the uplink request may have been rejected
+        this->is_last_uplink_pend = false;
+        tx_status = MCM_TX_STATUS::MCM_TX_NOT_SEND;
+    }
+    this->frag_tx_status[this->frag_tx_index] = tx_status;
+
+    bool is_sent = (MCM_TX_STATUS::MCM_TX_ACK == tx_status) ||
+                   ((MCM_TX_STATUS::MCM_TX_WO_ACK == tx_status) && (MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_CONF != this->frag_tx_type));
+    link_select_on_tx(&this->link_select, (uint8_t)this->current_mode, is_sent, millis());
+    if (is_sent)
+    {
+        this->frag_tx_index++;
+        this->frag_tx_retries = 0;
+        if (frag_tx_get_count(&this->frag_tx) == this->frag_tx_index)
+        {
+            Serial.printf("MCM: fragmented uplink sent\n");
+            this->frag_tx_state = MCM_FRAG_TX_STATE::MCM_FRAG_TX_DONE;
+            return;
+        }
+    }
+    else if (MCM_FRAG_TX_RETRIES > this->frag_tx_retries)
+    {
+        this->frag_tx_retries++;
+    }
+    else
+    {
+        Serial.printf("MCM: fragment %d not sent, fragmented uplink given up\n", this->frag_tx_index);
+        this->frag_tx_state = MCM_FRAG_TX_STATE::MCM_FRAG_TX_FAILED;
+        return;
+    }
+
+    this->send_fragment();
+}
+
+MCM_FRAG_TX_STATE MCM::get_fragmented_uplink_state(uint8_t *sent, uint8_t *total)
+{
+    if (nullptr != sent)
+    {
+        *sent = this->frag_tx_index;
+    }
+    if (nullptr != total)
+    {
+        // the fragments are counted once the uplink MTU is received
+        *total = ((MCM_FRAG_TX_STATE::MCM_FRAG_TX_IDLE == this->frag_tx_state) || this->is_frag_tx_waiting_mtu) ? 0 : frag_tx_get_count(&this->frag_tx);
+    }
+    return this->frag_tx_state;
+}
+
+/**
+ * @brief Tx status reported by MODEM_EVENT_TXDONE for a fragment of the last fragmented uplink,
+ *  MCM_TX_NOT_SEND until it is reported.
+ */
+MCM_TX_STATUS MCM::get_fragment_tx_status(uint8_t index)
+{
+    if ((MCM_FRAG_TX_STATE::MCM_FRAG_TX_IDLE == this->frag_tx_state) || this->is_frag_tx_waiting_mtu || (index >= frag_tx_get_count(&this->frag_tx)))
+    {
+        return MCM_TX_STATUS::MCM_TX_NOT_SEND;
+    }
+    return this->frag_tx_status[index];
+}
+
+/**
+ * @brief Sidewalk downlinks have no port, when enabled all of them are handled as fragments.
+ */
+void MCM::set_sidewalk_fragment_rx(bool enabled)
+{
+    this->is_sidewalk_frag_rx = enabled;
+}
+
+void MCM::set_on_fragmented_rx_callback(on_frag_rx_callback callback)
+{
+    this->on_frag_rx_callback_func = callback;
+}
+
+/**
+ * @brief Passes a downlink fragment to the reassembler, the callback set by
+ *  set_on_fragmented_rx_callback() is called once the message is complete.
+ *
+ * @param downlink Received downlink
+ * @return true if the downlink is a fragment, it is then not published to the application
+ */
+bool MCM::reassemble_downlink(const mcm_downlink_t *downlink)
+{
+    uint16_t msg_len = 0;
+    bool is_fragment = (COMMAND_TYPE_LORAWAN == downlink->protocol) ? (MCM_FRAG_LORAWAN_PORT == downlink->seq_port) : this->is_sidewalk_frag_rx;
+
+    if (false == is_fragment)
+    {
+        return false;
+    }
+
+    switch (frag_rx_push(&this->frag_rx, downlink->data, downlink->len, millis(), &msg_len))
+    {
+    case FRAG_RX_COMPLETE:
+        Serial.printf("MCM: downlink message of %d bytes reassembled\n", msg_len);
+        if (nullptr != this->on_frag_rx_callback_func)
+        {
+            this->on_frag_rx_callback_func(this->frag_rx_buffer, msg_len, downlink->protocol);
+        }
+        break;
+
+    case FRAG_RX_ERROR:
+        Serial.printf("MCM: invalid downlink fragment dropped\n");
+        break;
+
+    default:
+        break;
+    }
+    return true;
+}
+
+/**
+ * @brief Queues an uplink in the scheduler, see uplink_sched.h.
+ *  The uplinks are sent one at a time from handle_rx_events(), the next one as soon as the
+ *  MODEM_EVENT_TXDONE of the previous one is received and the airtime budget of the
+ *  current connection mode allows it. Alarms go before telemetry, telemetry before bulk.
+ *
+ * @param data Payload, copied
+ * @param len Length of the payload, up to UPLINK_SCHED_MAX_PAYLOAD_SIZE
+ * @param port Lorawan port
+ * @param uplink_type Confirmed or unconfirmed uplink
+ * Once sent, the uplink is retried according to the policy of its type, see set_retry_policy(),
+ *  and its final tx status is given to the on_uplink_result callback with its msg_id.
+ *
+ * @param priority Priority class of the uplink
+ * @param msg_id Identifier of the uplink in the result callback, may be NULL
+ * @return MCM_STATUS MCM_OK if the uplink is queued, it may already be sent
+ */
+MCM_STATUS MCM::queue_uplink(const uint8_t *data, uint16_t len, uint8_t port, MCM_UPLINK_TYPE uplink_type, uplink_sched_class_t priority, uint32_t *msg_id)
+{
+    bool is_confirmed = (MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_CONF == uplink_type);
+
+    if (false == uplink_sched_add(&this->uplink_sched, priority, port, is_confirmed, data, len, millis(), msg_id))
+    {
+        Serial.printf("MCM: uplink not queued, invalid or scheduler full\n");
+        return MCM_STATUS::MCM_ERROR;
+    }
+
+    // sent right away when the link is idle and within its budget
+    this->pump_uplink_scheduler();
+    return MCM_STATUS::MCM_OK;
+}
+
+void MCM::pump_uplink_scheduler()
+{
+    const uplink_sched_entry_t *entry = NULL;
+    uint8_t link = (uint8_t)this->current_mode;
+
+    // sidewalk ble connects on demand, the other links have to be joined
+    if ((ConnectionMode::CONNECTION_MODE_NC == this->current_mode) ||
+        ((false == this->is_joined_network) && (ConnectionMode::CONNECTION_MODE_SIDEWALK_BLE != this->current_mode)) ||
+        (MCM_FRAG_TX_STATE::MCM_FRAG_TX_IN_PROGRESS == this->frag_tx_state))
+    {
+        return;
+    }
+
+    if (this->is_last_uplink_pend)
+    {
+        if ((millis() - this->uplink_sent_time) < MCM_TXDONE_TIMEOUT_MS)
+        {
+            return;
+        }
+        // no MODEM_EVENT_TXDONE, the uplink request may have been rejected
+        this->is_last_uplink_pend = false;
+        this->last_tx_status = MCM_TX_STATUS::MCM_TX_NOT_SEND;
+    }
+
+    // the uplink in flight keeps the link until its final result
+    if (false == this->pump_uplink_retry())
+    {
+        return;
+    }
+
+    if ((UPLINK_SCHED_READY != uplink_sched_peek(&this->uplink_sched, link, millis(), &entry)) ||
+        (false == this->pump_ble_connection()))
+    {
+        return;
+    }
+
+    MCM_UPLINK_TYPE uplink_type = entry->b_confirmed ? MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_CONF : MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF;
+    this->send_uplink((uint8_t *)entry->data, entry->u16_len, entry->u8_port, uplink_type);
+    uplink_retry_start(&this->uplink_retry, &this->retry_policies[(uint8_t)uplink_type], entry->u32_seq, entry->u8_class,
+                       entry->u8_port, entry->b_confirmed, entry->data, entry->u16_len);
+    uplink_sched_commit(&this->uplink_sched, link, entry, millis());
+}
+
+/**
+ * @brief Gives the tx status of the last attempt to the retry engine and sends the next
+ *  attempt once its backoff is over and the airtime budget allows it.
+ *  The MODEM_EVENT_TXDONE belongs to the uplink in flight, only one uplink is sent at a time.
+ *
+ * @return true if no uplink is in flight, the next one of the scheduler can be sent
+ */
+bool MCM::pump_uplink_retry()
+{
+    uint8_t link = (uint8_t)this->current_mode;
+
+    if (UPLINK_RETRY_WAIT_TXDONE == uplink_retry_get_state(&this->uplink_retry))
+    {
+        uplink_retry_tx_t tx_status = UPLINK_RETRY_TX_NOT_SENT;
+        if (MCM_TX_STATUS::MCM_TX_ACK == this->last_tx_status)
+        {
+            tx_status = UPLINK_RETRY_TX_ACK;
+        }
+        else if (MCM_TX_STATUS::MCM_TX_WO_ACK == this->last_tx_status)
+        {
+            tx_status = UPLINK_RETRY_TX_NO_ACK;
+        }
+
+        // every attempt counts for the quality of the link, a confirmed uplink needs its ack
+        uint16_t len = 0;
+        uint8_t port = 0;
+        bool is_confirmed = false;
+        uplink_retry_get_data(&this->uplink_retry, &len, &port, &is_confirmed);
+        link_select_on_tx(&this->link_select, link, (UPLINK_RETRY_TX_ACK == tx_status) || ((UPLINK_RETRY_TX_NO_ACK == tx_status) && (false == is_confirmed)),
+                          millis());
+
+        if (uplink_retry_on_tx_done(&this->uplink_retry, tx_status, millis()))
+        {
+            if (this->is_debug_enabled)
+            {
+                Serial.printf("MCM: uplink %lu final status %d after %d attempts\n", (unsigned long)uplink_retry_get_msg_id(&this->uplink_retry),
+                              (int)this->last_tx_status, uplink_retry_get_attempts(&this->uplink_retry));
+            }
+            if (nullptr != this->on_uplink_result_callback_func)
+            {
+                this->on_uplink_result_callback_func(uplink_retry_get_msg_id(&this->uplink_retry), this->last_tx_status,
+                                                     uplink_retry_get_attempts(&this->uplink_retry));
+            }
+            return true;
+        }
+    }
+
+    if (UPLINK_RETRY_BACKOFF != uplink_retry_get_state(&this->uplink_retry))
+    {
+        return true;
+    }
+
+    uint16_t len = 0;
+    uint8_t port = 0;
+    bool is_confirmed = false;
+    const uint8_t *data = uplink_retry_get_data(&this->uplink_retry, &len, &port, &is_confirmed);
+
+    // the retries take their airtime from the budget of the class of the uplink
+    if ((false == uplink_retry_is_due(&this->uplink_retry, millis())) ||
+        (UPLINK_SCHED_READY != uplink_sched_check(&this->uplink_sched, link, uplink_retry_get_class(&this->uplink_retry), len, millis())) ||
+        (false == this->pump_ble_connection()))
+    {
+        return false;
+    }
+
+    if (this->is_debug_enabled)
+    {
+        Serial.printf("MCM: retrying uplink %lu, attempt %d\n", (unsigned long)uplink_retry_get_msg_id(&this->uplink_retry),
+                      uplink_retry_get_attempts(&this->uplink_retry) + 1);
+    }
+    this->send_uplink((uint8_t *)data, len, port, is_confirmed ? MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_CONF : MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF);
+    uplink_sched_charge(&this->uplink_sched, link, len, millis());
+    uplink_retry_sent(&this->uplink_retry);
+    return false;
+}
+
+/**
+ * @brief Sets the retry policy of a type of uplink sent through the scheduler, see uplink_retry.h.
+ *  It applies to the uplinks sent afterwards.
+ */
+MCM_STATUS MCM::set_retry_policy(MCM_UPLINK_TYPE uplink_type, const uplink_retry_policy_t *policy)
+{
+    if ((NULL == policy) || (MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_NA == uplink_type))
+    {
+        return MCM_STATUS::MCM_PARAM_ERROR;
+    }
+    this->retry_policies[(uint8_t)uplink_type] = *policy;
+    return MCM_STATUS::MCM_OK;
+}
+
+void MCM::set_on_uplink_result_callback(on_uplink_result_callback callback)
+{
+    this->on_uplink_result_callback_func = callback;
+}
+
+const uplink_retry_stats_t *MCM::get_retry_stats()
+{
+    return uplink_retry_get_stats(&this->uplink_retry);
+}
+
+void MCM::pump_link_selection()
+{
+    if ((false == this->is_link_failover_enabled) || (ConnectionMode::CONNECTION_MODE_NC == this->current_mode) ||
+        ((millis() - this->link_select_time) < MCM_LINK_SELECT_PERIOD_MS))
+    {
+        return;
+    }
+    this->link_select_time = millis();
+
+    ConnectionMode mode = (ConnectionMode)link_select_evaluate(&this->link_select, this->is_joined_network, millis());
+    if (mode == this->current_mode)
+    {
+        return;
+    }
+
+    Serial.printf("MCM: link quality failover from mode %d (%d%% delivered) to mode %d (%d%%)\n", (int)this->current_mode,
+                  this->get_link_delivery(this->current_mode), (int)mode, this->get_link_delivery(mode));
+    if (nullptr != this->on_link_failover_callback_func)
+    {
+        this->on_link_failover_callback_func(mode);
+    }
+}
+
+/**
+ * @brief Enables the automatic failover between the given connection modes, see link_select.h.
+ *  The statistics are kept whether the failover is enabled or not.
+ *
+ * @param enabled Enables the failover
+ * @param candidates Connection modes the failover may select, the current one need not be one of them
+ * @param count Number of candidates
+ * @return MCM_STATUS MCM_OK, MCM_PARAM_ERROR for an invalid candidate
+ */
+MCM_STATUS MCM::set_link_failover(bool enabled, const ConnectionMode *candidates, uint8_t count)
+{
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if ((NULL == candidates) || (ConnectionMode::CONNECTION_MODE_NC == candidates[i]) || (LINK_SELECT_MAX_LINKS <= (uint8_t)candidates[i]))
+        {
+            return MCM_STATUS::MCM_PARAM_ERROR;
+        }
+    }
+
+    for (uint8_t link = 0; link < LINK_SELECT_MAX_LINKS; link++)
+    {
+        bool is_candidate = false;
+        for (uint8_t i = 0; i < count; i++)
+        {
+            is_candidate = is_candidate || ((uint8_t)candidates[i] == link);
+        }
+        link_select_set_candidate(&this->link_select, link, is_candidate);
+    }
+    this->is_link_failover_enabled = enabled;
+    return MCM_STATUS::MCM_OK;
+}
+
+/**
+ * @brief Sets the energy of an uplink attempt and the snr floor of a connection mode, for the hardware in use.
+ *  The candidate flag of the profile replaces the one given by set_link_failover().
+ */
+MCM_STATUS MCM::set_link_select_profile(ConnectionMode mode, const link_select_profile_t *profile)
+{
+    if (false == link_select_set_profile(&this->link_select, (uint8_t)mode, profile))
+    {
+        return MCM_STATUS::MCM_PARAM_ERROR;
+    }
+    return MCM_STATUS::MCM_OK;
+}
+
+void MCM::set_on_link_failover_callback(on_link_failover_callback callback)
+{
+    this->on_link_failover_callback_func = callback;
+}
+
+/**
+ * @brief Estimated part of the uplink attempts delivered on a connection mode, in percent
+ */
+uint8_t MCM::get_link_delivery(ConnectionMode mode)
+{
+    return link_select_get_delivery_pct(&this->link_select, (uint8_t)mode, millis());
+}
+
+/**
+ * @brief Opens the sidewalk ble connection for an uplink waiting to be sent, without blocking.
+ *  The connection is requested when down and stays open while uplinks or downlinks keep it busy,
+ *  see MCM_BLE_CONN_IDLE_TIMEOUT_MS. The other connection modes need no connection.
+ *
+ * @return true if the uplink can be sent now
+ */
+bool MCM::pump_ble_connection()
+{
+    if (ConnectionMode::CONNECTION_MODE_SIDEWALK_BLE != this->current_mode)
+    {
+        return true;
+    }
+
+    if (ble_conn_poll(&this->ble_conn, millis()))
+    {
+        return true;
+    }
+
+    if (ble_conn_should_request(&this->ble_conn, millis()))
+    {
+        ble_conn_on_request(&this->ble_conn, millis());
+        if (API_PROCESSOR_SUCCESS != api_processor_cmd_sid_ble_conn_request(this->module))
+        {
+            // not queued, requested again after the backoff
+            ble_conn_on_result(&this->ble_conn, false, millis());
+        }
+        else if (this->is_debug_enabled)
+        {
+            Serial.printf("MCM: ble connection requested\n");
+        }
+    }
+    return false;
+}
+
+ble_conn_state_t MCM::get_ble_connection_state()
+{
+    return ble_conn_get_state(&this->ble_conn);
+}
+
+const ble_conn_stats_t *MCM::get_ble_connection_stats()
+{
+    return ble_conn_get_stats(&this->ble_conn);
+}
+
+/**
+ * @brief Sets the airtime model and duty cycle of a connection mode, for the deployment region.
+ */
+MCM_STATUS MCM::set_link_profile(ConnectionMode mode, const uplink_sched_link_t *profile)
+{
+    if (false == uplink_sched_set_link(&this->uplink_sched, (uint8_t)mode, profile, millis()))
+    {
+        return MCM_STATUS::MCM_PARAM_ERROR;
+    }
+    return MCM_STATUS::MCM_OK;
+}
+
+/**
+ * @brief Airtime left to the current connection mode over the duty cycle window
+ */
+uint32_t MCM::get_airtime_budget_ms()
+{
+    return uplink_sched_get_budget_ms(&this->uplink_sched, (uint8_t)this->current_mode, millis());
+}
+
+/**
+ * @brief Number of uplinks waiting in the scheduler queue or in flight with their retries
+ */
+uint8_t MCM::get_queued_uplink_count()
+{
+    return uplink_sched_get_count(&this->uplink_sched) + ((UPLINK_RETRY_IDLE != uplink_retry_get_state(&this->uplink_retry)) ? 1 : 0);
+}
+
+const uplink_sched_stats_t *MCM::get_uplink_stats(uplink_sched_class_t priority)
+{
+    return uplink_sched_get_stats(&this->uplink_sched, priority);
+}
+
+void MCM::set_on_rx_callback(on_rx_callback callback)
+{
+    this->on_rx_callback_func = callback;
+}
+
+void MCM::stop_network()
+{
+    this->is_joined_network = false;
+    ble_conn_reset(&this->ble_conn);
+    do
+    {
+        if (ConnectionMode::CONNECTION_MODE_NC == this->current_mode)
+        {
+            break;
         }
         else if (ConnectionMode::CONNECTION_MODE_LORAWAN == this->current_mode)
         {
             // stoppping the lorawan connection
             api_processor_cmd_stop_lorawan_network(this->module);
-            // wait for the response
-            this->process_received_data();
             break;
         }
         else
         {
             // disconnecting with sidewalk
             api_processor_cmd_sid_stop(this->module);
-            // wait for the response
-            this->process_received_data();
             break;
         }
     } while (0);
@@ -1367,14 +2752,14 @@ HardwareSerial &MCM::get_serial()
     return __mcm_serial;
 }
 
-void MCM::set_is_rx_received(uint8_t val)
+uint16_t MCM::get_rx_high_water()
 {
-    is_rx_received = val;
+    return rx_ring_get_high_water(&this->rx_ring);
 }
 
-void MCM::set_received_size(uint16_t val)
+uint32_t MCM::get_rx_overrun_count()
 {
-    received_size = val;
+    return rx_ring_get_overrun_count(&this->rx_ring);
 }
 
 void MCM::set_is_joined_network(bool val)
@@ -1382,14 +2767,78 @@ void MCM::set_is_joined_network(bool val)
     is_joined_network = val;
 }
 
+/**
+ * @brief Gives the result of the sidewalk ble connection, see ble_conn_on_result().
+ */
+void MCM::set_ble_connection_result(bool is_connected)
+{
+    ble_conn_on_result(&this->ble_conn, is_connected, millis());
+}
+
+/**
+ * @brief The modem has accepted the sidewalk ble connection request, see ble_conn_on_ack().
+ */
+void MCM::set_ble_connection_acked()
+{
+    ble_conn_on_ack(&this->ble_conn, millis());
+}
+
 void MCM::set_is_last_uplink_pending(bool val)
 {
     is_last_uplink_pend = val;
 }
 
-uint8_t *MCM::get_downlink_buffer()
+uint8_t MCM::get_sw_reset_event_count()
+{
+    return sw_reset_event_count;
+}
+
+void MCM::increment_sw_reset_event_count()
+{
+    sw_reset_event_count++;
+}
+
+void MCM::set_modem_version(const String &ver)
+{
+    modem_version = ver;
+}
+
+mcm_downlink_t *MCM::alloc_downlink()
+{
+    for (uint8_t i = 0; i < MCM_DOWNLINK_POOL_SIZE; i++)
+    {
+        mcm_downlink_t *downlink = &this->downlink_pool[i];
+        if (0 == downlink->ref_count)
+        {
+            downlink->data = downlink->payload;
+            downlink->len = 0;
+            downlink->ref_count = 1;
+            return downlink;
+        }
+    }
+    // every slot is still leased by the application
+    return nullptr;
+}
+
+void MCM::publish_downlink(mcm_downlink_t *downlink)
+{
+    if (MCM_DOWNLINK_QUEUE_SIZE == this->downlink_queue_count)
+    {
+        // the queued downlinks are kept, the newest one is dropped and accounted
+        this->release_downlink(downlink);
+        this->downlink_overflow_count++;
+        Serial.printf("Downlink dropped, downlink queue is full\n");
+        return;
+    }
+    link_select_on_downlink(&this->link_select, (uint8_t)this->current_mode, downlink->rssi, downlink->snr, millis());
+    uint8_t tail = (this->downlink_queue_head + this->downlink_queue_count) % MCM_DOWNLINK_QUEUE_SIZE;
+    this->downlink_queue[tail] = downlink;
+    this->downlink_queue_count++;
+}
+
+void MCM::count_downlink_overflow()
 {
-    return downlink_buffer;
+    this->downlink_overflow_count++;
 }
 
 on_rx_callback MCM::get_on_rx_callback_func()
@@ -1409,26 +2858,72 @@ void MCM::set_serial_rx_timeout(uint32_t timeout)
 
 bool MCM::is_downlink_available()
 {
-    return this->is_downlink_avail;
+    return (this->downlink_queue_count > 0);
+}
+
+void MCM::get_downlink_data(uint8_t *data, uint16_t *len, int8_t *rssi, int8_t *snr, uint16_t *seq_port)
+{
+    const mcm_downlink_t *downlink = this->acquire_downlink();
+    if (nullptr == downlink)
+    {
+        *len = 0;
+        return;
+    }
+    *len = downlink->len;
+    memcpy(data, downlink->data, downlink->len);
+    *rssi = downlink->rssi;
+    *snr = downlink->snr;
+    *seq_port = downlink->seq_port;
+    this->release_downlink(downlink);
 }
 
-void MCM::set_downlink_meta_data(uint16_t len, int8_t rssi, int8_t snr, uint16_t seq_port, bool val)
+const mcm_downlink_t *MCM::acquire_downlink()
 {
-    this->downlink_buffer_size = len;
-    this->rssi = rssi;
-    this->snr = snr;
-    this->seq_port = seq_port;
-    this->is_downlink_avail = val;
+    if (0 == this->downlink_queue_count)
+    {
+        return nullptr;
+    }
+    // the reference held by the queue moves to the caller
+    const mcm_downlink_t *downlink = this->downlink_queue[this->downlink_queue_head];
+    this->downlink_queue_head = (this->downlink_queue_head + 1) % MCM_DOWNLINK_QUEUE_SIZE;
+    this->downlink_queue_count--;
+    return downlink;
 }
 
-void MCM::get_downlink_data(uint8_t *data, uint16_t *len, int8_t *rssi, int8_t *snr, uint16_t *seq_port)
+void MCM::retain_downlink(const mcm_downlink_t *downlink)
+{
+    if (nullptr != downlink)
+    {
+        ((mcm_downlink_t *)downlink)->ref_count++;
+    }
+}
+
+void MCM::release_downlink(const mcm_downlink_t *downlink)
+{
+    if ((nullptr != downlink) && (downlink->ref_count > 0))
+    {
+        ((mcm_downlink_t *)downlink)->ref_count--;
+    }
+}
+
+uint8_t MCM::get_downlink_count()
+{
+    return this->downlink_queue_count;
+}
+
+const mcm_downlink_t *MCM::peek_downlink(uint8_t index)
+{
+    // index 0 is the oldest queued downlink, the downlink stays in the queue
+    if (index >= this->downlink_queue_count)
+    {
+        return nullptr;
+    }
+    return this->downlink_queue[(this->downlink_queue_head + index) % MCM_DOWNLINK_QUEUE_SIZE];
+}
+
+uint32_t MCM::get_downlink_overflow_count()
 {
-    *len = this->downlink_buffer_size;
-    memcpy(data, this->downlink_buffer, *len);
-    *rssi = this->rssi;
-    *snr = this->snr;
-    *seq_port = this->seq_port;
-    this->is_downlink_avail = false;
+    return this->downlink_overflow_count;
 }
 
 bool MCM::get_is_debug_enabled()
@@ -1483,30 +2978,75 @@ void MCM::set_join_failure_data(uint8_t failure_reason, bool available)
 {
     this->join_failure_reason = failure_reason;
     this->is_join_failure = available;
+    if (available)
+    {
+        link_select_on_join_failure(&this->link_select, (uint8_t)this->current_mode, millis());
+    }
 }
 
-void MCM::hw_reset()
+/**
+ * @brief Resets the mcm with its reset pin. The pin is released and the reset event of the mcm
+ *  awaited by handle_rx_events().
+ *
+ * @param callback Called once with MCM_OK when the reset event is received, MCM_TIMEOUT if the
+ *  mcm does not report it within MCM_RESET_BOOT_TIMEOUT_MS
+ * @return MCM_STATUS MCM_OK if the reset has started
+ */
+MCM_STATUS MCM::hw_reset(on_cmd_complete_callback callback, void *user_context)
 {
     Serial.printf("hw_reset\n");
+    if (MCM_RESET_STATE::MCM_RESET_IDLE != this->reset_state)
+    {
+        Serial.println("MCM: Reset already in progress");
+        return MCM_STATUS::MCM_ERROR;
+    }
+
+    // the mcm restarts at the default rate
+    if (MROVER_DEFAULT_BAUD_RATE != this->_baud_rate)
+    {
+        this->apply_baud_rate(MROVER_DEFAULT_BAUD_RATE);
+    }
     digitalWrite(this->_reset_pin, LOW);
-    delay(100);
-    digitalWrite(this->_reset_pin, HIGH);
-    delay(100);
+    this->reset_op.complete_cb  = callback;
+    this->reset_op.user_context = user_context;
+    this->reset_time = millis();
+    this->reset_state = MCM_RESET_STATE::MCM_RESET_PULSE;
+    return MCM_STATUS::MCM_OK;
+}
 
-    delay(1000);
-    this->process_received_data();
-    while (api_processor_get_pending_events(this->module) > 0)
+void MCM::pump_reset()
+{
+    if (MCM_RESET_STATE::MCM_RESET_PULSE == this->reset_state)
+    {
+        if ((millis() - this->reset_time) < MCM_RESET_PULSE_MS)
+        {
+            return;
+        }
+        digitalWrite(this->_reset_pin, HIGH);
+        this->reset_event_count = this->get_sw_reset_event_count();
+        this->reset_time = millis();
+        this->reset_state = MCM_RESET_STATE::MCM_RESET_BOOT;
+    }
+    else if (MCM_RESET_STATE::MCM_RESET_BOOT == this->reset_state)
     {
-        api_processor_cmd_get_event(this->module); // send the get event command
-        this->process_received_data();
+        if (this->reset_event_count != this->get_sw_reset_event_count())
+        {
+            this->reset_state = MCM_RESET_STATE::MCM_RESET_IDLE;
+            complete_op(&this->reset_op, MCM_STATUS::MCM_OK, NULL);
+        }
+        else if ((millis() - this->reset_time) >= MCM_RESET_BOOT_TIMEOUT_MS)
+        {
+            Serial.println("MCM: Response not received, Please check the connection");
+            this->reset_state = MCM_RESET_STATE::MCM_RESET_IDLE;
+            complete_op(&this->reset_op, MCM_STATUS::MCM_TIMEOUT, NULL);
+        }
     }
 }
 
-MCM_STATUS MCM::set_lorawan_class(MCM_LORAWAN_CLASS_TYPE dev_class)
+MCM_STATUS MCM::set_lorawan_class(MCM_LORAWAN_CLASS_TYPE dev_class, on_cmd_complete_callback callback, void *user_context)
 {
     Serial.printf("set_lorawan_class: dev_class=%d\n", (int)dev_class);
     MCM_STATUS status = MCM_STATUS::MCM_ERROR;
-    api_processor_status_t api_status = API_PROCESSOR_ERROR;
     do
     {
         if (ConnectionMode::CONNECTION_MODE_LORAWAN != this->current_mode)
@@ -1531,17 +3071,16 @@ MCM_STATUS MCM::set_lorawan_class(MCM_LORAWAN_CLASS_TYPE dev_class)
             break;
 
         default:
+            status = MCM_STATUS::MCM_PARAM_ERROR;
             break;
         }
-
-        api_status = api_processor_cmd_set_lorawan_class(this->module, change_class);
-        if (API_PROCESSOR_SUCCESS != api_status)
+        if (MCM_STATUS::MCM_PARAM_ERROR == status)
         {
             break;
         }
-        // wait for the response
-        this->process_received_data();
-        status = MCM_STATUS::MCM_OK;
+
+        this->set_next_command_callback(callback, user_context);
+        status = this->queue_command(api_processor_cmd_set_lorawan_class(this->module, change_class));
 
     } while (0);
 
@@ -1560,87 +3099,56 @@ bool MCM::get_context_mgr_is_class_change()
     return return_value;
 }
 
+/**
+ * @brief Asks the lorawan class of the mcm, get_lorawan_class() returns it once the command is completed.
+ */
+MCM_STATUS MCM::req_lorawan_class(on_cmd_complete_callback callback, void *user_context)
+{
+    Serial.printf("req_lorawan_class\n");
+    this->set_next_command_callback(callback, user_context);
+    return this->queue_command(api_processor_cmd_get_lorawan_class(this->module));
+}
+
 MCM_LORAWAN_CLASS_TYPE MCM::get_lorawan_class()
 {
-    Serial.printf("get_lorawan_class\n");
-    api_processor_cmd_get_lorawan_class(this->module);
-    this->process_received_data();
     return this->_dev_class;
 }
 
 /**
- * @brief Retrieves the last downlink statistics from the MCM module
+ * @brief Requests the last downlink statistics from the MCM module
  *
- * This function sends a command to the MCM module to request the last downlink statistics,
- * waits for the response, and stores the received data in the provided pointer.
+ * The statistics are stored in last_downlink_stats once the response is received.
  *
- * @param[out] p_last_dl_stats Pointer to store the retrieved downlink statistics
- * @return MCM_STATUS Returns MCM_STATUS::MCM_OK on success, MCM_STATUS::MCM_ERROR on failure
+ * @return MCM_STATUS Returns MCM_STATUS::MCM_OK once the request is queued, MCM_STATUS::MCM_ERROR on failure
  */
-MCM_STATUS MCM::get_last_dl_stats(get_last_dl_stats_t *p_last_dl_stats)
+MCM_STATUS MCM::req_last_dl_stats(on_cmd_complete_callback callback, void *user_context)
 {
-    Serial.printf("Starting last downlink stats retrieval process\n");
-    MCM_STATUS status                 = MCM_STATUS::MCM_ERROR;
-    api_processor_status_t api_status = API_PROCESSOR_ERROR;
-
-    do
-    {
-        _ASSERT_PRINT(p_last_dl_stats != NULL, "Null pointer provided for last downlink stats");
-
-        api_status = api_processor_cmd_get_last_dl_stats(this->module);
-        _ERROR_BREAK(api_status, "Failed to send last downlink stats command");
-
-        this->process_received_data();
-
-        memcpy(p_last_dl_stats, &this->last_downlink_stats, sizeof(get_last_dl_stats_t));
-        status           = MCM_STATUS::MCM_OK;
-
-        Serial.printf("Successfully retrieved last downlink stats:\n");
-        Serial.printf("  Protocol Type: %d\n", p_last_dl_stats->protocol_type);
-        Serial.printf("  RSSI: %d\n", p_last_dl_stats->rssi);
-        Serial.printf("  SNR: %d\n", p_last_dl_stats->snr);
-        Serial.printf("  Timestamp: %lu\n", p_last_dl_stats->timestamp);
-
-    } while (0);
-
-    return status;
+    Serial.printf("Requesting the last downlink stats\n");
+    this->set_next_command_callback(callback, user_context);
+    return this->queue_command(api_processor_cmd_get_last_dl_stats(this->module));
 }
 
 /**
- * @brief Retrieves the GPS timestamp from the MCM module
+ * @brief Requests the GPS timestamp from the MCM module
  *
- * This function sends a command to the MCM module to request the current GPS time,
- * waits for the response, and stores the received timestamp in the provided pointer.
+ * The timestamp is stored in gps_timestamp once the response is received, 0 if the mcm has no time.
  *
- * @param[out] p_gps_timestamp Pointer to store the retrieved GPS timestamp
- * @return MCM_STATUS Returns MCM_STATUS::MCM_OK on success, MCM_STATUS::MCM_ERROR on failure
+ * @return MCM_STATUS Returns MCM_STATUS::MCM_OK once the request is queued, MCM_STATUS::MCM_ERROR on failure
  */
-MCM_STATUS MCM::get_gps_time(uint32_t *p_gps_timestamp)
+MCM_STATUS MCM::req_gps_time(on_cmd_complete_callback callback, void *user_context)
 {
-    Serial.printf("Starting GPS time retrieval process\n");
-    MCM_STATUS status                 = MCM_STATUS::MCM_ERROR;
-    api_processor_status_t api_status = API_PROCESSOR_ERROR;
+    Serial.printf("Requesting the GPS time\n");
+    MCM_STATUS status = MCM_STATUS::MCM_ERROR;
 
     do
     {
-        _ASSERT_PRINT(p_gps_timestamp != NULL, "Null pointer provided for GPS timestamp");
-
         if (ConnectionMode::CONNECTION_MODE_LORAWAN == this->current_mode)
         {
             _ASSERT_PRINT(this->is_lorawan_mac_time_synced, "LoRaWAN MAC Time is not Synced");
         }
 
-        api_status = api_processor_cmd_get_gps_time(this->module);
-        _ERROR_BREAK(api_status, "Failed to send GPS time command");
-
-        this->process_received_data();
-
-        _ASSERT_PRINT(this->gps_timestamp != 0, "Received invalid GPS timestamp (0)");
-
-        *p_gps_timestamp = this->gps_timestamp;
-        status           = MCM_STATUS::MCM_OK;
-
-        Serial.printf("Successfully retrieved GPS time: %lu\n", *p_gps_timestamp);
+        this->set_next_command_callback(callback, user_context);
+        status = this->queue_command(api_processor_cmd_get_gps_time(this->module));
 
     } while (0);
 
@@ -1650,125 +3158,67 @@ MCM_STATUS MCM::get_gps_time(uint32_t *p_gps_timestamp)
 /**
  * @brief Requests the LoRaWAN device time from the MCM module
  *
- * This function sends a command to the MCM module to request the current LoRaWAN device time,
- * waits for the response, and validates the received timestamp.
- *
- * @return MCM_STATUS Returns MCM_STATUS::MCM_OK on success, MCM_STATUS::MCM_ERROR on failure
+ * @return MCM_STATUS Returns MCM_STATUS::MCM_OK once the request is queued, MCM_STATUS::MCM_ERROR on failure
  */
-MCM_STATUS MCM::req_lorawan_dev_time(void)
+MCM_STATUS MCM::req_lorawan_dev_time(on_cmd_complete_callback callback, void *user_context)
 {
-    MCM_STATUS status                 = MCM_STATUS::MCM_ERROR;
-    api_processor_status_t api_status = API_PROCESSOR_ERROR;
-
-    do
-    {
-        Serial.printf("Sending LoRaWAN device time request to module\n");
-
-        api_status = api_processor_cmd_request_lorawan_dev_time(this->module);
-        _ERROR_BREAK(api_status, "Failed to send LoRaWAN device time command");
-
-        this->process_received_data();
-
-        status = MCM_STATUS::MCM_OK;
-
-    } while (0);
-
-    return status;
+    Serial.printf("Sending LoRaWAN device time request to module\n");
+    this->set_next_command_callback(callback, user_context);
+    return this->queue_command(api_processor_cmd_request_lorawan_dev_time(this->module));
 }
 
 // TODO: Oxit: at the time of writing this code, the file transfer is only for
 // fw update for host side
 //  in future we will use this function for other file transfer
 //  In that case, just use the callback function to get the file data
-MCM_STATUS MCM::start_file_transfer(ver_type_1_t version)
+MCM_STATUS MCM::start_file_transfer(ver_type_1_t version, on_cmd_complete_callback callback, void *user_context)
 {
     Serial.printf("start_file_transfer: version=%d.%d.%d\n", version.major, version.minor, version.patch);
-    MCM_STATUS status = MCM_STATUS::MCM_ERROR;
-    api_processor_status_t api_status = API_PROCESSOR_ERROR;
 
-    do
-    {
-        // Send the start file transfer command
-        api_status = api_processor_cmd_start_file_transfer(this->module, version);
-        if (API_PROCESSOR_SUCCESS != api_status)
-        {
-            break;
-        }
-
-        // Wait for the response
-        this->process_received_data();
-        status = MCM_STATUS::MCM_OK;
-
-    } while (0);
+    // an interrupted transfer of the same image continues from its checkpoint
+    this->ymodem.setTransferTag(((uint32_t)version.major << 16) | ((uint32_t)version.minor << 8) | version.patch);
 
-    return status;
+    // Send the start file transfer command, its response starts the ymodem transfer
+    this->set_next_command_callback(callback, user_context);
+    return this->queue_command(api_processor_cmd_start_file_transfer(this->module, version));
 }
 
-MCM_STATUS MCM::get_segmented_file_download_status(get_seg_file_status_t *seg_status)
+/**
+ * @brief Asks the status of the segmented file download, stored in seg_file_status once received.
+ */
+MCM_STATUS MCM::req_segmented_file_download_status(on_cmd_complete_callback callback, void *user_context)
 {
-    Serial.printf("get_segmented_file_download_status: seg_status=%p\n", seg_status);
-    MCM_STATUS status = MCM_STATUS::MCM_ERROR;
-    api_processor_status_t api_status = API_PROCESSOR_ERROR;
-    memset(seg_status, 0, sizeof(get_seg_file_status_t));
-    do
-    {
-        api_status = api_processor_cmd_get_seg_file_transfer_status(this->module);
-        if (API_PROCESSOR_SUCCESS != api_status)
-        {
-            break;
-        }
-
-        // Wait for the response
-        this->process_received_data();
-        status = MCM_STATUS::MCM_OK;
-
-    } while (0);
-
-    memcpy(seg_status, &this->seg_file_status, sizeof(get_seg_file_status_t));
-    return status;
+    Serial.printf("req_segmented_file_download_status\n");
+    this->set_next_command_callback(callback, user_context);
+    return this->queue_command(api_processor_cmd_get_seg_file_transfer_status(this->module));
 }
 
-MCM_STATUS MCM::trigger_firmware_update(ver_type_1_t version)
+MCM_STATUS MCM::trigger_firmware_update(ver_type_1_t version, on_cmd_complete_callback callback, void *user_context)
 {
     Serial.printf("trigger_firmware_update: version=%d.%d.%d\n", version.major, version.minor, version.patch);
-    MCM_STATUS status = MCM_STATUS::MCM_ERROR;
-    api_processor_status_t api_status = API_PROCESSOR_ERROR;
-    do
-    {
-        api_status = api_processor_cmd_trigger_fw_update(this->module, version);
-        if (API_PROCESSOR_SUCCESS != api_status)
-        {
-            break;
-        }
-
-        // Wait for the response
-        this->process_received_data();
-        status = MCM_STATUS::MCM_OK;
-
-    } while (0);
-
-    return status;
+    this->set_next_command_callback(callback, user_context);
+    return this->queue_command(api_processor_cmd_trigger_fw_update(this->module, version));
 }
 
-MCM_STATUS MCM::factory_reset()
+MCM_STATUS MCM::factory_reset(on_cmd_complete_callback callback, void *user_context)
 {
     Serial.printf("factory_reset\n");
-    MCM_STATUS status = MCM_STATUS::MCM_ERROR;
-    api_processor_status_t api_status = API_PROCESSOR_ERROR;
-    do
+    if (MCM_RESET_STATE::MCM_RESET_IDLE != this->reset_state)
     {
-        api_status = api_processor_cmd_factory_reset(this->module);
-        if (API_PROCESSOR_SUCCESS != api_status)
-        {
-            break;
-        }
-
-        // Wait for the response
-        this->process_received_data();
-        status = MCM_STATUS::MCM_OK;
-
-    } while (0);
+        Serial.println("MCM: Reset already in progress");
+        return MCM_STATUS::MCM_ERROR;
+    }
 
+    this->reset_op.complete_cb  = callback;
+    this->reset_op.user_context = user_context;
+    this->reset_state = MCM_RESET_STATE::MCM_RESET_COMMAND;
+    this->set_next_command_callback(on_reset_command_complete, this);
+    MCM_STATUS status = this->queue_command(api_processor_cmd_factory_reset(this->module));
+    if (MCM_STATUS::MCM_OK != status)
+    {
+        this->reset_state = MCM_RESET_STATE::MCM_RESET_IDLE;
+        this->reset_op = {};
+    }
     return status;
 }
 
@@ -1798,18 +3248,18 @@ void MCM::retrieveLibraryVersions(ver_type_1_t *mcm_rover_lib_ver, ver_type_1_t
     api_processor_get_lib_ver(c_lib_ver);
 }
 
-MCM_STATUS MCM::process_fw_update()
+MCM_STATUS MCM::process_fw_update(on_cmd_complete_callback callback, void *user_context)
 {
     Serial.printf("process_fw_update\n");
     if(this->seg_file_status.cmd_type.bin_type == FUOTA_BINARY_TYPE_MCM)
     {
          Serial.println("MCM firmware present - triggering MCM firmware update");
-         return this->trigger_firmware_update(seg_file_status.fw_ver);
+         return this->trigger_firmware_update(seg_file_status.fw_ver, callback, user_context);
     }
     else
     {
         Serial.println("Host firmware present - triggering host firmware update");
-        return this->start_file_transfer(seg_file_status.fw_ver);
+        return this->start_file_transfer(seg_file_status.fw_ver, callback, user_context);
     }
 }
 
@@ -1818,45 +3268,18 @@ void MCM::get_join_failure_info(uint8_t *failure_reason)
     *failure_reason = this->get_join_failure_data();
 }
 
-MCM_STATUS MCM::get_next_uplink_mtu(uint16_t *mtu)
+/**
+ * @brief Asks the MTU of the next uplink, stored in nextUplink_mtu once received.
+ */
+MCM_STATUS MCM::req_next_uplink_mtu(on_cmd_complete_callback callback, void *user_context)
 {
-    Serial.printf("Starting next uplink MTU retrieval process\n");
-    MCM_STATUS status                 = MCM_STATUS::MCM_ERROR;
-    api_processor_status_t api_status = API_PROCESSOR_ERROR;
-    this->nextUplink_mtu = 0;        // Reset MTU
-    do
-    {
-        _ASSERT_PRINT(mtu != NULL, "Null pointer provided for next uplink MTU");
-
-        api_status = api_processor_cmd_get_next_uplink_mtu(this->module);
-        _ERROR_BREAK(api_status, "Failed to send last downlink stats command");
-
-        this->process_received_data();
-        *mtu             = this->nextUplink_mtu;
-        status           = MCM_STATUS::MCM_OK;
-
-        Serial.printf("Successfully retrieved next uplink MTU: %d\n", *mtu);
-
-    } while (0);
-
-    return status;
+    Serial.printf("Requesting the next uplink MTU\n");
+    this->set_next_command_callback(callback, user_context);
+    return this->queue_command(api_processor_cmd_get_next_uplink_mtu(this->module));
 }
 
-MCM_STATUS MCM::app_SWSetCSSPwrProfile(mrover_css_pwr_profile_t prof) {
+MCM_STATUS MCM::app_SWSetCSSPwrProfile(mrover_css_pwr_profile_t prof, on_cmd_complete_callback callback, void *user_context) {
   Serial.printf("Setting sidwalk css power profile\n");
-  MCM_STATUS status = MCM_STATUS::MCM_ERROR;
-  api_processor_status_t api_status = API_PROCESSOR_ERROR;
-  do {
-    api_status = api_processor_cmd_sid_set_css_profile(this->module, prof);
-    _ERROR_BREAK(api_status,
-                 "Failed to send sidewalk set css power profile command");
-
-    this->process_received_data();
-
-    status = MCM_STATUS::MCM_OK;
-    Serial.printf(
-        "Successfully requested change of sidewalk css power profile\n");
-  } while (0);
-
-  return status;
-}
\ No newline at end of file
+  this->set_next_command_callback(callback, user_context);
+  return this->queue_command(api_processor_cmd_sid_set_css_profile(this->module, prof));
+}
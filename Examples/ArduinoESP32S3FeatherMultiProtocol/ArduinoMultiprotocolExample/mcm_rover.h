@@ -54,6 +54,12 @@ extern "C" {
 #include "api_processor.h" 
 #include "ymodem.h"
 #include "host_fuota.h"
+#include "rx_ring.h"
+#include "frag.h"
+#include "uplink_sched.h"
+#include "uplink_retry.h"
+#include "link_select.h"
+#include "ble_conn.h"
 
 /**********************************************************************************************************
  * MACROS AND DEFINES
@@ -67,6 +73,124 @@ extern "C" {
  */
 #define BUFFER_SIZE (1036)
 
+/**
+ * @brief Size of the ring between the uart receive callback and the decoder, power of two.
+ * Holds a full y modem packet plus the frames received while the loop is busy.
+ */
+#define MCM_RX_RING_SIZE (2048)
+
+/**
+ * @brief Number of commands that can wait in the command queue.
+ * Commands are sent to the mcm one after the other, the next command is sent
+ * as soon as the response of the previous one is received.
+ */
+#define MCM_CMD_QUEUE_SIZE (8)
+
+/**
+ * @brief Bytes of a command frame kept once the command is sent: type and command code.
+ */
+#define MCM_CMD_HEADER_LEN (3)
+
+/**
+ * @brief Number of get event commands kept in flight while draining the pending events.
+ * The mcm answers them in order, the next request is already received while the
+ * previous response is on the wire. 1 restores the one by one drain.
+ * Can be overridden from the compiler flags (-DMCM_EVENT_DRAIN_WINDOW=1)
+ */
+#ifndef MCM_EVENT_DRAIN_WINDOW
+#define MCM_EVENT_DRAIN_WINDOW (3)
+#endif
+
+/**
+ * @brief Number of received downlinks that can wait for the application.
+ * The mcm queues up to 10 events, so a single event drain can deliver that many downlinks.
+ */
+#define MCM_DOWNLINK_QUEUE_SIZE (10)
+
+/**
+ * @brief Number of downlinks that can be held at the same time, by the downlink
+ * queue and by the application leases together.
+ */
+#define MCM_DOWNLINK_POOL_SIZE (MCM_DOWNLINK_QUEUE_SIZE + 2)
+
+/**
+ * @brief Largest downlink payload, a downlink never exceeds the received frame.
+ */
+#define MCM_DOWNLINK_MAX_PAYLOAD_SIZE (MAX_SERIAL_RECEIVE_PAYLOAD_SIZE)
+
+/**
+ * @brief Time left to the uart of the mcm to settle on a new baud rate before the link is verified.
+ */
+#define MCM_BAUD_SETTLE_MS (20)
+
+/**
+ * @brief Response timeout of the get version command verifying a new baud rate,
+ * the mcm must see it within MROVER_BAUD_VERIFY_WINDOW_MS.
+ */
+#define MCM_BAUD_VERIFY_TIMEOUT_MS (300)
+
+/**
+ * @brief Time the reset pin is held low by MCM::hw_reset().
+ */
+#define MCM_RESET_PULSE_MS (100)
+
+/**
+ * @brief Time the mcm takes at most to boot and report its reset event once the reset pin is released.
+ */
+#define MCM_RESET_BOOT_TIMEOUT_MS (3000)
+
+/**
+ * @brief Largest message sent or received through the fragmentation layer.
+ * A message takes up to FRAG_MAX_FRAGMENTS fragments, 2176 bytes over sidewalk css.
+ */
+#define MCM_FRAG_MAX_PAYLOAD_SIZE (2048)
+
+/**
+ * @brief Lorawan port of the fragments, in both directions.
+ * Sidewalk has no port, see MCM::set_sidewalk_fragment_rx().
+ */
+#define MCM_FRAG_LORAWAN_PORT (200)
+
+/**
+ * @brief Number of times a fragment is sent again when the mcm reports it as not sent,
+ * or not acknowledged for a confirmed uplink, before the message is given up.
+ */
+#define MCM_FRAG_TX_RETRIES (2)
+
+/**
+ * @brief Time to wait for the MODEM_EVENT_TXDONE of an uplink sent by the fragmentation layer
+ * or the scheduler, it counts as not sent afterwards.
+ */
+#define MCM_TXDONE_TIMEOUT_MS (60000)
+
+/**
+ * @brief A partially received downlink message is dropped when no fragment is received for this long.
+ * Class A downlinks only come after uplinks, so it spans several uplink periods.
+ */
+#define MCM_FRAG_RX_TIMEOUT_MS (600000)
+
+/**
+ * @brief Period of the evaluation of the link quality for the automatic failover.
+ */
+#define MCM_LINK_SELECT_PERIOD_MS (10000)
+
+/**
+ * @brief A sidewalk ble connection request without response has failed after this time.
+ */
+#define MCM_BLE_CONN_SETUP_TIMEOUT_MS (10000)
+
+/**
+ * @brief The modem acks the sidewalk ble connection request before the link is set up and tells no link up,
+ * uplinks are held this long after the ack.
+ */
+#define MCM_BLE_CONN_LINK_SETUP_MS (1500)
+
+/**
+ * @brief The sidewalk ble connection is taken as closed after this time without uplink nor downlink,
+ * a burst of uplinks within it shares one connection.
+ */
+#define MCM_BLE_CONN_IDLE_TIMEOUT_MS (30000)
+
 #define MCM_ROVER_LIB_VER_MAJOR 0
 #define MCM_ROVER_LIB_VER_MINOR 6
 #define MCM_ROVER_LIB_VER_PATCH 0
@@ -109,6 +233,13 @@ enum class MCM_UPLINK_TYPE{
     MCM_UPLINK_TYPE_UNCONF
 };
 
+enum class MCM_FRAG_TX_STATE {
+    MCM_FRAG_TX_IDLE,
+    MCM_FRAG_TX_IN_PROGRESS,
+    MCM_FRAG_TX_DONE,
+    MCM_FRAG_TX_FAILED
+};
+
 enum class MCM_LORAWAN_CLASS_TYPE
 {
     MCM_LRWAN_CLASS_A = 0x00,
@@ -116,9 +247,125 @@ enum class MCM_LORAWAN_CLASS_TYPE
     MCM_LRWAN_CLASS_C = 0X02
 };
 
-typedef void(*on_rx_callback)(uint8_t *data, uint8_t len,int8_t rssi,uint8_t snr,uint16_t seq_port);
+/**
+ * @brief Downlink held in the downlink pool.
+ * The payload is copied once out of the frame decoder, after that the
+ * callback and the application read it in place. The slot is returned to
+ * the pool when its last reference is released.
+ * ref_count and payload are private, the other members are meant to be read by the application.
+ */
+typedef struct {
+    const uint8_t *data;                            // points to payload
+    uint16_t len;
+    int8_t rssi;
+    int8_t snr;
+    uint16_t seq_port;                              // lorawan port or sidewalk sequence
+    command_types_t protocol;                       // COMMAND_TYPE_LORAWAN or COMMAND_TYPE_SIDEWALK
+    uint32_t timestamp;                             // millis() when the downlink has been received
+    uint8_t ref_count;                              // 0 when the slot is free
+    uint8_t payload[MCM_DOWNLINK_MAX_PAYLOAD_SIZE];
+} mcm_downlink_t;
+
+/**
+ * @brief Callback called for every received downlink.
+ * The downlink is valid until the callback returns, call MCM::retain_downlink()
+ * to keep it longer and MCM::release_downlink() once done with it.
+ */
+typedef void(*on_rx_callback)(const mcm_downlink_t *downlink);
+
+/**
+ * @brief Callback called for every downlink message reassembled from fragments.
+ * data is valid until the callback returns, protocol is COMMAND_TYPE_LORAWAN or COMMAND_TYPE_SIDEWALK.
+ */
+typedef void(*on_frag_rx_callback)(const uint8_t *data, uint16_t len, command_types_t protocol);
+
+/**
+ * @brief Callback called once per uplink sent from MCM::queue_uplink(), with its final tx status
+ * after the retries of its policy. An uplink evicted from the full queue gets no result.
+ */
+typedef void(*on_uplink_result_callback)(uint32_t msg_id, MCM_TX_STATUS status, uint8_t attempts);
+
+/**
+ * @brief Callback called when the link quality calls for another connection mode, see link_select.h.
+ * The application switches with stop_network() and set_connect_mode() then joins again. Called
+ * every MCM_LINK_SELECT_PERIOD_MS until the connection mode changes.
+ */
+typedef void(*on_link_failover_callback)(ConnectionMode mode);
+
+/**
+ * @brief Callback called when a queued command is completed.
+ * status is MCM_OK if the mcm responded with MROVER_RC_OK, MCM_ERROR for any other return code
+ * and MCM_TIMEOUT if no response was received. response is NULL in case of timeout.
+ */
+typedef void(*on_cmd_complete_callback)(MCM_STATUS status, const api_processor_response_t *response, void *user_context);
+
+/**
+ * @brief Callback called once a burst of pending events has been drained.
+ * events holds the event codes in the order of reception, the event data has
+ * already been handled by the mcm object (downlink queue, tx status, ...).
+ */
+typedef void(*on_event_batch_callback)(const get_event_code_t *events, uint8_t count, void *user_context);
+
+/**
+ * @brief Highest uart baud rate supported from a modem firmware version onwards
+ */
+typedef struct {
+    ver_type_2_t min_modem_fw;
+    uint32_t max_baud_rate;
+} mcm_baud_capability_t;
+
+/**
+ * @brief Command waiting in the command queue, or waiting for its response
+ */
+typedef struct {
+    uint8_t frame[MAX_SERIAL_SEND_PAYLOAD_SIZE];    // encoded command including crc, only the header once sent
+    uint16_t frame_len;
+    on_cmd_complete_callback complete_cb;
+    void *user_context;
+    uint32_t sent_time;                             // millis() when the command has been written to the serial
+    uint32_t timeout;                               // response timeout in ms
+    bool is_sent;
+    bool is_chained;                                // the next queued command continues the same sequence
+} mcm_cmd_entry_t;
+
+/**
+ * @brief Application callback of an operation of several steps, called once by its last step.
+ */
+typedef struct {
+    on_cmd_complete_callback complete_cb;
+    void *user_context;
+} mcm_op_callback_t;
+
+/**
+ * @brief Steps of MCM::negotiate_baud_rate(), run by handle_rx_events().
+ */
+enum class MCM_BAUD_NEG_STATE {
+    MCM_BAUD_NEG_IDLE,
+    MCM_BAUD_NEG_GET_VERSION,                       // firmware version asked
+    MCM_BAUD_NEG_SWITCH,                            // set uart baud sent at the current rate
+    MCM_BAUD_NEG_SETTLE,                            // both ends at the new rate, the uart of the mcm settles
+    MCM_BAUD_NEG_VERIFY,                            // get version sent at the new rate
+    MCM_BAUD_NEG_FALLBACK,                          // back at the previous rate, the mcm falls back at the end of its verify window
+    MCM_BAUD_NEG_VERIFY_FALLBACK                    // get version sent at the previous rate
+};
+
+/**
+ * @brief Steps of the resets of the mcm, run by handle_rx_events().
+ */
+enum class MCM_RESET_STATE {
+    MCM_RESET_IDLE,
+    MCM_RESET_COMMAND,                              // reset or factory reset command sent
+    MCM_RESET_PULSE,                                // reset pin held low
+    MCM_RESET_BOOT                                  // reset pin released, waiting for the reset event
+};
 
 
+/**
+ * @brief Host side of the mcm. The commands never block: they are queued and return MCM_OK once queued,
+ * their callback is then called once with the result from handle_rx_events(), which loop() must call.
+ * The results are also kept in the public members until the next command of the same kind.
+ * MCMBlocking in mcm_rover_blocking.h waits for them instead, for setup() and the tests.
+ */
 class MCM {
 
     private:
@@ -130,31 +377,108 @@ class MCM {
     uint8_t _tx_pin;
     HardwareSerial& __mcm_serial;
     mcm_module_hdl_t *module = NULL;
-    uint8_t is_rx_received;
-    uint16_t received_size;
-    uint8_t sw_reset_evnet_count;
-    bool is_joined_network;
+    uint8_t rx_ring_buffer[MCM_RX_RING_SIZE];
+    rx_ring_t rx_ring;                              // filled by the uart receive callback, drained by the loop
+    uint8_t rx_buffer[BUFFER_SIZE];                 // y modem packets are passed in one piece
+    uint8_t sw_reset_event_count = 0;
+    String modem_version;
+    bool is_joined_network = false;
     MCM_TX_STATUS last_tx_status;
-    bool is_downlink_avail =  false;
-    bool is_last_uplink_pend;
-    uint8_t downlink_buffer[BUFFER_SIZE];
-    uint16_t downlink_buffer_size;
+    bool is_last_uplink_pend = false;
+    mcm_downlink_t downlink_pool[MCM_DOWNLINK_POOL_SIZE] = {};
+    mcm_downlink_t *downlink_queue[MCM_DOWNLINK_QUEUE_SIZE];   // downlinks not yet acquired by the application, oldest first
+    uint8_t downlink_queue_head = 0;
+    uint8_t downlink_queue_count = 0;
+    uint32_t downlink_overflow_count = 0;
     on_rx_callback on_rx_callback_func = nullptr;
     uint32_t serial_rx_timeout = 2000;
-    int8_t rssi;
-    uint8_t snr;
-    uint16_t seq_port;
     uint8_t join_failure_reason = 0;
     bool is_join_failure = false;
     bool is_debug_enabled = false;
     bool _context_mgr_is_joined_cmd_received = false;
-    bool _context_mgr_is_mcm_reset;
+    bool _context_mgr_is_mcm_reset = false;
+    mcm_cmd_entry_t cmd_queue[MCM_CMD_QUEUE_SIZE];
+    uint8_t cmd_queue_head = 0;
+    uint8_t cmd_queue_count = 0;
+    on_cmd_complete_callback next_cmd_complete_cb = nullptr;
+    void *next_cmd_user_context = nullptr;
+    bool next_cmd_is_chained = false;
+    MCM_BAUD_NEG_STATE baud_neg_state = MCM_BAUD_NEG_STATE::MCM_BAUD_NEG_IDLE;
+    mcm_op_callback_t baud_neg_op = {};
+    uint32_t baud_neg_target = 0;                         // fastest rate the negotiation may try
+    uint8_t baud_neg_index = 0;                           // entry of s_baud_rates being tried
+    uint32_t baud_neg_previous_rate = 0;
+    MCM_STATUS baud_neg_status = MCM_STATUS::MCM_OK;      // result so far, reported once no rate is left to try
+    uint32_t baud_neg_time = 0;                           // millis() when the current wait started
+    MCM_RESET_STATE reset_state = MCM_RESET_STATE::MCM_RESET_IDLE;
+    mcm_op_callback_t reset_op = {};
+    uint32_t reset_time = 0;                              // millis() when the current step started
+    uint8_t reset_event_count = 0;                        // reset events received before the reset
+    get_event_code_t event_batch[MAX_PENDING_MESSAGES];
+    uint8_t event_batch_count = 0;
+    on_event_batch_callback event_batch_cb = nullptr;
+    void *event_batch_user_context = nullptr;
+    uint8_t frag_tx_buffer[MCM_FRAG_MAX_PAYLOAD_SIZE];    // message being sent, fragments are built from it
+    uint16_t frag_tx_len = 0;
+    frag_tx_t frag_tx;
+    MCM_FRAG_TX_STATE frag_tx_state = MCM_FRAG_TX_STATE::MCM_FRAG_TX_IDLE;
+    MCM_TX_STATUS frag_tx_status[FRAG_MAX_FRAGMENTS];    // tx status reported for every fragment
+    MCM_UPLINK_TYPE frag_tx_type = MCM_UPLINK_TYPE::MCM_UPLINK_TYPE_UNCONF;
+    uint8_t frag_tx_index = 0;                            // fragment waiting for its MODEM_EVENT_TXDONE
+    uint8_t frag_tx_retries = 0;
+    uint8_t frag_tx_msg_id = 0;
+    uint32_t uplink_sent_time = 0;                        // millis() of the last send_uplink()
+    uint8_t frag_rx_buffer[MCM_FRAG_MAX_PAYLOAD_SIZE];
+    frag_rx_t frag_rx;
+    bool is_sidewalk_frag_rx = false;
+    on_frag_rx_callback on_frag_rx_callback_func = nullptr;
+    uplink_sched_t uplink_sched;
+    uplink_retry_t uplink_retry;                          // uplink of the scheduler in flight
+    uplink_retry_policy_t retry_policies[3];              // indexed by MCM_UPLINK_TYPE
+    on_uplink_result_callback on_uplink_result_callback_func = nullptr;
+    link_select_t link_select;
+    bool is_link_failover_enabled = false;
+    uint32_t link_select_time = 0;                        // millis() of the last evaluation
+    on_link_failover_callback on_link_failover_callback_func = nullptr;
+    ble_conn_t ble_conn;                                  // sidewalk ble connection, requested on demand
+    bool is_frag_tx_waiting_link = false;                 // next fragment waits for the ble connection
+    bool is_frag_tx_waiting_mtu = false;                  // the fragments are built once the uplink MTU is received
+    void receive_serial_bytes();
     void process_received_data();
+    bool send_command(mcm_cmd_entry_t *cmd);
+    void pump_command_queue();
+    void pump_event_window();
+    uint8_t count_queued_commands(mrover_cc_codes_t cmd_code);
+    void queue_event_requests();
+    void flush_event_batch();
+    void complete_command(MCM_STATUS status, const api_processor_response_t *response);
+    bool is_command_queued(mrover_cc_codes_t cmd_code);
+    void take_next_command_callback(mcm_cmd_entry_t *cmd);
+    void cut_command_sequence();
+    MCM_STATUS queue_command(api_processor_status_t api_status);
+    static void complete_op(mcm_op_callback_t *op, MCM_STATUS status, const api_processor_response_t *response);
+    uint32_t get_max_supported_baud_rate();
+    void apply_baud_rate(uint32_t baud_rate);
+    bool switch_next_baud_rate();
+    bool verify_link();
+    void finish_baud_negotiation(MCM_STATUS status);
+    void pump_baud_negotiation();
+    static void on_baud_neg_command_complete(MCM_STATUS status, const api_processor_response_t *response, void *user_context);
+    static void on_reset_command_complete(MCM_STATUS status, const api_processor_response_t *response, void *user_context);
+    void pump_reset();
+    static void on_frag_mtu_complete(MCM_STATUS status, const api_processor_response_t *response, void *user_context);
+    void send_fragment();
+    void pump_fragmented_uplink();
+    void pump_uplink_scheduler();
+    bool pump_uplink_retry();
+    void pump_link_selection();
+    bool pump_ble_connection();
 public:
     uint16_t nextUplink_mtu;
     uint32_t gps_timestamp;
-    bool is_lorawan_mac_time_synced;
+    bool is_lorawan_mac_time_synced = false;
     ver_type_1_t host_version;
+    ver_type_2_t modem_fw_version = {};
     get_last_dl_stats_t last_downlink_stats;
     YModem ymodem;
     bool is_new_firmware_downloaded = false;
@@ -163,14 +487,41 @@ public:
     bool _change_class = false;
     MCM(HardwareSerial& serial,uint8_t tx_pin, uint8_t rx_pin, uint8_t reset_pin);
     MCM_STATUS begin();
-    String print_version();
-    void sw_reset();
-    void hw_reset();
+    MCM_STATUS req_version(on_cmd_complete_callback callback = nullptr, void *user_context = nullptr);
+    String get_modem_version();
+    MCM_STATUS negotiate_baud_rate(uint32_t max_baud_rate, on_cmd_complete_callback callback = nullptr, void *user_context = nullptr);
+    bool is_baud_negotiation_pending();
+    uint32_t get_baud_rate();
+    uint32_t get_link_throughput();
+    MCM_STATUS sw_reset(on_cmd_complete_callback callback = nullptr, void *user_context = nullptr);
+    MCM_STATUS hw_reset(on_cmd_complete_callback callback = nullptr, void *user_context = nullptr);
+    bool is_reset_pending();
     void set_connect_mode(ConnectionMode mode);
     ConnectionMode get_connect_mode();
-    MCM_STATUS set_lorawan_credentials(uint8_t *dev_eui, uint8_t *join_eui,uint8_t *app_key);
-    MCM_STATUS connect_network();
-    void send_uplink(uint8_t *data, uint16_t len,uint8_t port,MCM_UPLINK_TYPE send_uplink);
+    MCM_STATUS set_lorawan_credentials(uint8_t *dev_eui, uint8_t *join_eui,uint8_t *app_key,
+                                       on_cmd_complete_callback callback = nullptr, void *user_context = nullptr);
+    MCM_STATUS connect_network(on_cmd_complete_callback callback = nullptr, void *user_context = nullptr);
+    MCM_STATUS send_uplink(uint8_t *data, uint16_t len,uint8_t port,MCM_UPLINK_TYPE send_uplink);
+    MCM_STATUS send_fragmented_uplink(const uint8_t *data, uint16_t len, MCM_UPLINK_TYPE uplink_type);
+    MCM_FRAG_TX_STATE get_fragmented_uplink_state(uint8_t *sent, uint8_t *total);
+    MCM_TX_STATUS get_fragment_tx_status(uint8_t index);
+    void set_sidewalk_fragment_rx(bool enabled);
+    void set_on_fragmented_rx_callback(on_frag_rx_callback callback);
+    bool reassemble_downlink(const mcm_downlink_t *downlink);
+    MCM_STATUS queue_uplink(const uint8_t *data, uint16_t len, uint8_t port, MCM_UPLINK_TYPE uplink_type, uplink_sched_class_t priority, uint32_t *msg_id);
+    MCM_STATUS set_retry_policy(MCM_UPLINK_TYPE uplink_type, const uplink_retry_policy_t *policy);
+    void set_on_uplink_result_callback(on_uplink_result_callback callback);
+    const uplink_retry_stats_t* get_retry_stats();
+    MCM_STATUS set_link_failover(bool enabled, const ConnectionMode *candidates, uint8_t count);
+    MCM_STATUS set_link_select_profile(ConnectionMode mode, const link_select_profile_t *profile);
+    void set_on_link_failover_callback(on_link_failover_callback callback);
+    uint8_t get_link_delivery(ConnectionMode mode);
+    ble_conn_state_t get_ble_connection_state();
+    const ble_conn_stats_t* get_ble_connection_stats();
+    MCM_STATUS set_link_profile(ConnectionMode mode, const uplink_sched_link_t *profile);
+    uint32_t get_airtime_budget_ms();
+    uint8_t get_queued_uplink_count();
+    const uplink_sched_stats_t* get_uplink_stats(uplink_sched_class_t priority);
     void handle_rx_events();
     bool is_connected();
     MCM_TX_STATUS get_last_tx_status();
@@ -180,43 +531,62 @@ public:
     void set_serial_rx_timeout(uint32_t timeout);
     bool is_downlink_available();
     void get_downlink_data(uint8_t *data, uint16_t* len,int8_t* rssi,int8_t* snr,uint16_t* seq_port);
+    const mcm_downlink_t* acquire_downlink();
+    void retain_downlink(const mcm_downlink_t *downlink);
+    void release_downlink(const mcm_downlink_t *downlink);
+    uint8_t get_downlink_count();
+    const mcm_downlink_t* peek_downlink(uint8_t index);
+    uint32_t get_downlink_overflow_count();
     void set_debug_enabled(bool val);
-    MCM_STATUS set_lorawan_class(MCM_LORAWAN_CLASS_TYPE dev_class);
+    MCM_STATUS set_lorawan_class(MCM_LORAWAN_CLASS_TYPE dev_class, on_cmd_complete_callback callback = nullptr, void *user_context = nullptr);
+    MCM_STATUS req_lorawan_class(on_cmd_complete_callback callback = nullptr, void *user_context = nullptr);
     MCM_LORAWAN_CLASS_TYPE get_lorawan_class();
-    MCM_STATUS factory_reset();
+    MCM_STATUS factory_reset(on_cmd_complete_callback callback = nullptr, void *user_context = nullptr);
     mcm_module_hdl_t* get_module_handle();
     HardwareSerial& get_serial();
-    void set_is_rx_received(uint8_t val);
-    void set_received_size(uint16_t val);
+    uint16_t get_rx_high_water();
+    uint32_t get_rx_overrun_count();
     uint8_t get_sw_reset_event_count();
+    void increment_sw_reset_event_count();
+    void set_modem_version(const String &ver);
     void set_is_joined_network(bool val);
+    void set_ble_connection_result(bool is_connected);
+    void set_ble_connection_acked();
     void set_is_last_uplink_pending(bool val);
-    uint8_t* get_downlink_buffer();
+    mcm_downlink_t* alloc_downlink();
+    void publish_downlink(mcm_downlink_t *downlink);
+    void count_downlink_overflow();
     on_rx_callback get_on_rx_callback_func();
     void set_last_tx_status(MCM_TX_STATUS status);
-    void set_downlink_meta_data(uint16_t len,int8_t rssi,int8_t snr,uint16_t seq_port,bool val);
     bool get_is_debug_enabled();
     void set_context_mgr_is_joined_cmd_received(bool val);
     bool get_context_mgr_is_joined_cmd_received();
     void set_context_mgr_is_mcm_reset(bool val);
     bool get_context_mgr_is_mcm_reset();
     bool get_context_mgr_is_class_change();
-    MCM_STATUS start_file_transfer(ver_type_1_t version);
-    MCM_STATUS get_segmented_file_download_status(get_seg_file_status_t *status);
-    MCM_STATUS trigger_firmware_update(ver_type_1_t version);
+    MCM_STATUS start_file_transfer(ver_type_1_t version, on_cmd_complete_callback callback = nullptr, void *user_context = nullptr);
+    MCM_STATUS req_segmented_file_download_status(on_cmd_complete_callback callback = nullptr, void *user_context = nullptr);
+    MCM_STATUS trigger_firmware_update(ver_type_1_t version, on_cmd_complete_callback callback = nullptr, void *user_context = nullptr);
     bool is_new_firmware();
     void set_host_app_version(ver_type_1_t version);
     void retrieveLibraryVersions(ver_type_1_t *mcm_rover_lib_ver, ver_type_1_t *c_lib_ver);
-    MCM_STATUS process_fw_update();
-    MCM_STATUS req_lorawan_dev_time(void);
-    MCM_STATUS get_gps_time(uint32_t *p_gps_time); 
-    MCM_STATUS get_last_dl_stats(get_last_dl_stats_t *p_last_dl_stats);
+    MCM_STATUS process_fw_update(on_cmd_complete_callback callback = nullptr, void *user_context = nullptr);
+    MCM_STATUS req_lorawan_dev_time(on_cmd_complete_callback callback = nullptr, void *user_context = nullptr);
+    MCM_STATUS req_gps_time(on_cmd_complete_callback callback = nullptr, void *user_context = nullptr);
+    MCM_STATUS req_last_dl_stats(on_cmd_complete_callback callback = nullptr, void *user_context = nullptr);
     bool is_join_failure_available();
     uint8_t get_join_failure_data();
     void set_join_failure_data(uint8_t failure_reason, bool available);
     void get_join_failure_info(uint8_t *failure_reason);
-    MCM_STATUS get_next_uplink_mtu(uint16_t *mtu);
-    MCM_STATUS app_SWSetCSSPwrProfile(mrover_css_pwr_profile_t prof);
+    MCM_STATUS req_next_uplink_mtu(on_cmd_complete_callback callback = nullptr, void *user_context = nullptr);
+    MCM_STATUS app_SWSetCSSPwrProfile(mrover_css_pwr_profile_t prof, on_cmd_complete_callback callback = nullptr, void *user_context = nullptr);
+    uint16_t enqueue_command(const uint8_t *frame, uint16_t len);
+    uint16_t enqueue_command_vector(const serial_tx_segment_t *segments, uint8_t count);
+    void on_command_response(const api_processor_response_t *response);
+    void set_next_command_callback(on_cmd_complete_callback callback, void *user_context);
+    bool is_command_pending();
+    void set_on_event_batch_callback(on_event_batch_callback callback, void *user_context);
+    void record_event(const api_processor_response_t *response);
 };
 
 /**********************************************************************************************************
@@ -0,0 +1,260 @@
+/**
+ * @file mcm_rover_blocking.cpp
+ * @author OXIT embedded firmware team
+ * @brief Blocking forms of the mcm rover commands, for setup() and the tests
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <Arduino.h>
+#include "mcm_rover_blocking.h"
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static void on_waited_command_complete(MCM_STATUS status, const api_processor_response_t *response, void *user_context)
+{
+    (void)response;
+    mcm_cmd_waiter_t *waiter = (mcm_cmd_waiter_t *)user_context;
+
+    waiter->status  = status;
+    waiter->is_done = true;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+MCMBlocking::MCMBlocking(MCM &mcm) : mcm(mcm)
+{
+}
+
+MCM_STATUS MCMBlocking::wait(MCM_STATUS queue_status, mcm_cmd_waiter_t *waiter)
+{
+    if (MCM_STATUS::MCM_OK != queue_status)
+    {
+        return queue_status;
+    }
+
+    // the other queued commands, uplinks and events go on meanwhile
+    while (false == waiter->is_done)
+    {
+        this->mcm.handle_rx_events();
+        if (false == waiter->is_done)
+        {
+            delay(1);
+        }
+    }
+    return waiter->status;
+}
+
+void MCMBlocking::drain_events()
+{
+    // each get event response refills the window until nothing is pending
+    while ((api_processor_get_pending_events(this->mcm.get_module_handle()) > 0) || this->mcm.is_command_pending())
+    {
+        this->mcm.handle_rx_events();
+        delay(1);
+    }
+}
+
+String MCMBlocking::print_version()
+{
+    mcm_cmd_waiter_t waiter = { false, MCM_STATUS::MCM_ERROR };
+    this->wait(this->mcm.req_version(on_waited_command_complete, &waiter), &waiter);
+    return this->mcm.get_modem_version();
+}
+
+MCM_STATUS MCMBlocking::negotiate_baud_rate(uint32_t max_baud_rate)
+{
+    mcm_cmd_waiter_t waiter = { false, MCM_STATUS::MCM_ERROR };
+    return this->wait(this->mcm.negotiate_baud_rate(max_baud_rate, on_waited_command_complete, &waiter), &waiter);
+}
+
+void MCMBlocking::sw_reset()
+{
+    mcm_cmd_waiter_t waiter = { false, MCM_STATUS::MCM_ERROR };
+    this->wait(this->mcm.sw_reset(on_waited_command_complete, &waiter), &waiter);
+
+    // device would not be reset until we get all the event for the device
+    this->drain_events();
+    delay(1000);
+}
+
+void MCMBlocking::hw_reset()
+{
+    mcm_cmd_waiter_t waiter = { false, MCM_STATUS::MCM_ERROR };
+    this->wait(this->mcm.hw_reset(on_waited_command_complete, &waiter), &waiter);
+    this->drain_events();
+}
+
+MCM_STATUS MCMBlocking::set_lorawan_credentials(uint8_t *dev_eui, uint8_t *join_eui, uint8_t *app_key)
+{
+    mcm_cmd_waiter_t waiter = { false, MCM_STATUS::MCM_ERROR };
+    return this->wait(this->mcm.set_lorawan_credentials(dev_eui, join_eui, app_key, on_waited_command_complete, &waiter), &waiter);
+}
+
+MCM_STATUS MCMBlocking::connect_network()
+{
+    mcm_cmd_waiter_t waiter = { false, MCM_STATUS::MCM_ERROR };
+    return this->wait(this->mcm.connect_network(on_waited_command_complete, &waiter), &waiter);
+}
+
+MCM_STATUS MCMBlocking::set_lorawan_class(MCM_LORAWAN_CLASS_TYPE dev_class)
+{
+    mcm_cmd_waiter_t waiter = { false, MCM_STATUS::MCM_ERROR };
+    return this->wait(this->mcm.set_lorawan_class(dev_class, on_waited_command_complete, &waiter), &waiter);
+}
+
+MCM_LORAWAN_CLASS_TYPE MCMBlocking::get_lorawan_class()
+{
+    mcm_cmd_waiter_t waiter = { false, MCM_STATUS::MCM_ERROR };
+    this->wait(this->mcm.req_lorawan_class(on_waited_command_complete, &waiter), &waiter);
+    return this->mcm.get_lorawan_class();
+}
+
+MCM_STATUS MCMBlocking::factory_reset()
+{
+    mcm_cmd_waiter_t waiter = { false, MCM_STATUS::MCM_ERROR };
+    return this->wait(this->mcm.factory_reset(on_waited_command_complete, &waiter), &waiter);
+}
+
+MCM_STATUS MCMBlocking::start_file_transfer(ver_type_1_t version)
+{
+    mcm_cmd_waiter_t waiter = { false, MCM_STATUS::MCM_ERROR };
+    return this->wait(this->mcm.start_file_transfer(version, on_waited_command_complete, &waiter), &waiter);
+}
+
+MCM_STATUS MCMBlocking::get_segmented_file_download_status(get_seg_file_status_t *status)
+{
+    mcm_cmd_waiter_t waiter = { false, MCM_STATUS::MCM_ERROR };
+    MCM_STATUS cmd_status = this->wait(this->mcm.req_segmented_file_download_status(on_waited_command_complete, &waiter), &waiter);
+    memcpy(status, &this->mcm.seg_file_status, sizeof(get_seg_file_status_t));
+    return cmd_status;
+}
+
+MCM_STATUS MCMBlocking::trigger_firmware_update(ver_type_1_t version)
+{
+    mcm_cmd_waiter_t waiter = { false, MCM_STATUS::MCM_ERROR };
+    return this->wait(this->mcm.trigger_firmware_update(version, on_waited_command_complete, &waiter), &waiter);
+}
+
+MCM_STATUS MCMBlocking::process_fw_update()
+{
+    mcm_cmd_waiter_t waiter = { false, MCM_STATUS::MCM_ERROR };
+    return this->wait(this->mcm.process_fw_update(on_waited_command_complete, &waiter), &waiter);
+}
+
+MCM_STATUS MCMBlocking::req_lorawan_dev_time()
+{
+    mcm_cmd_waiter_t waiter = { false, MCM_STATUS::MCM_ERROR };
+    return this->wait(this->mcm.req_lorawan_dev_time(on_waited_command_complete, &waiter), &waiter);
+}
+
+MCM_STATUS MCMBlocking::get_gps_time(uint32_t *p_gps_time)
+{
+    if (p_gps_time == NULL)
+    {
+        Serial.println("Null pointer provided for GPS timestamp");
+        return MCM_STATUS::MCM_ERROR;
+    }
+
+    mcm_cmd_waiter_t waiter = { false, MCM_STATUS::MCM_ERROR };
+    MCM_STATUS status = this->wait(this->mcm.req_gps_time(on_waited_command_complete, &waiter), &waiter);
+    if (MCM_STATUS::MCM_OK != status)
+    {
+        Serial.println("GPS time not available");
+        return status;
+    }
+    if (0 == this->mcm.gps_timestamp)
+    {
+        Serial.println("Received invalid GPS timestamp (0)");
+        return MCM_STATUS::MCM_ERROR;
+    }
+
+    *p_gps_time = this->mcm.gps_timestamp;
+    Serial.printf("Successfully retrieved GPS time: %lu\n", (unsigned long)*p_gps_time);
+    return MCM_STATUS::MCM_OK;
+}
+
+MCM_STATUS MCMBlocking::get_last_dl_stats(get_last_dl_stats_t *p_last_dl_stats)
+{
+    if (p_last_dl_stats == NULL)
+    {
+        Serial.println("Null pointer provided for last downlink stats");
+        return MCM_STATUS::MCM_ERROR;
+    }
+
+    mcm_cmd_waiter_t waiter = { false, MCM_STATUS::MCM_ERROR };
+    MCM_STATUS status = this->wait(this->mcm.req_last_dl_stats(on_waited_command_complete, &waiter), &waiter);
+    if (MCM_STATUS::MCM_OK != status)
+    {
+        Serial.println("Last downlink stats not received");
+        return status;
+    }
+
+    memcpy(p_last_dl_stats, &this->mcm.last_downlink_stats, sizeof(get_last_dl_stats_t));
+    return MCM_STATUS::MCM_OK;
+}
+
+MCM_STATUS MCMBlocking::get_next_uplink_mtu(uint16_t *mtu)
+{
+    if (mtu == NULL)
+    {
+        Serial.println("Null pointer provided for next uplink MTU");
+        return MCM_STATUS::MCM_ERROR;
+    }
+
+    mcm_cmd_waiter_t waiter = { false, MCM_STATUS::MCM_ERROR };
+    this->mcm.nextUplink_mtu = 0;
+    MCM_STATUS status = this->wait(this->mcm.req_next_uplink_mtu(on_waited_command_complete, &waiter), &waiter);
+    if (MCM_STATUS::MCM_OK != status)
+    {
+        Serial.println("Next uplink MTU not received");
+        return status;
+    }
+
+    *mtu = this->mcm.nextUplink_mtu;
+    return MCM_STATUS::MCM_OK;
+}
+
+MCM_STATUS MCMBlocking::app_SWSetCSSPwrProfile(mrover_css_pwr_profile_t prof)
+{
+    mcm_cmd_waiter_t waiter = { false, MCM_STATUS::MCM_ERROR };
+    return this->wait(this->mcm.app_SWSetCSSPwrProfile(prof, on_waited_command_complete, &waiter), &waiter);
+}
@@ -0,0 +1,94 @@
+/**
+ * @file mcm_rover_blocking.h
+ * @author OXIT embedded firmware team
+ * @brief Blocking forms of the mcm rover commands, for setup() and the tests
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+#ifndef __MCM_ROVER_BLOCKING_H__
+#define __MCM_ROVER_BLOCKING_H__
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include <Arduino.h>
+#include "mcm_rover.h"
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+/**
+ * @brief Completion of one command waited for by MCMBlocking
+ */
+typedef struct {
+    bool is_done;
+    MCM_STATUS status;
+} mcm_cmd_waiter_t;
+
+/**
+ * @brief Runs the commands of an MCM to completion before returning. Each call runs
+ * MCM::handle_rx_events() until its own command is completed, the loop() of the
+ * application does not run meanwhile. Opt in where waiting is fine, MCM itself never blocks.
+ */
+class MCMBlocking {
+private:
+    MCM &mcm;
+    MCM_STATUS wait(MCM_STATUS queue_status, mcm_cmd_waiter_t *waiter);
+    void drain_events();
+
+public:
+    explicit MCMBlocking(MCM &mcm);
+    String print_version();
+    MCM_STATUS negotiate_baud_rate(uint32_t max_baud_rate);
+    void sw_reset();
+    void hw_reset();
+    MCM_STATUS set_lorawan_credentials(uint8_t *dev_eui, uint8_t *join_eui, uint8_t *app_key);
+    MCM_STATUS connect_network();
+    MCM_STATUS set_lorawan_class(MCM_LORAWAN_CLASS_TYPE dev_class);
+    MCM_LORAWAN_CLASS_TYPE get_lorawan_class();
+    MCM_STATUS factory_reset();
+    MCM_STATUS start_file_transfer(ver_type_1_t version);
+    MCM_STATUS get_segmented_file_download_status(get_seg_file_status_t *status);
+    MCM_STATUS trigger_firmware_update(ver_type_1_t version);
+    MCM_STATUS process_fw_update();
+    MCM_STATUS req_lorawan_dev_time();
+    MCM_STATUS get_gps_time(uint32_t *p_gps_time);
+    MCM_STATUS get_last_dl_stats(get_last_dl_stats_t *p_last_dl_stats);
+    MCM_STATUS get_next_uplink_mtu(uint16_t *mtu);
+    MCM_STATUS app_SWSetCSSPwrProfile(mrover_css_pwr_profile_t prof);
+};
+
+#endif /* __MCM_ROVER_BLOCKING_H__ */
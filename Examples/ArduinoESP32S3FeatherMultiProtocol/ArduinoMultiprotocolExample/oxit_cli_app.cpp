@@ -54,6 +54,7 @@
 #include "oxit_cli_app.h"
 #include <oxit_nvs.h>
 #include "ArduinoMultiprotocolExample.h"
+#include "trace_log.h"
 
 
 #define CLI_APP_NAME "oxit_cli"
@@ -207,6 +208,15 @@ static int get_next_uplink_mtu_callback(const char *pu8_input_value, cli_send_by
  */
 static int sw_set_css_pwr_profile_callback(const char *pu8_input_value, cli_send_bytes_t pfun_uart_tx);
 
+/**
+ * @brief Dumps or clears the trace ring and switches the MCM frame dump on or off.
+ * 
+ * @param pu8_input_value input value (dump, clear, frames_on or frames_off)
+ * @param pfun_uart_tx Function to send bytes over UART.
+ * @return int Return status code.
+ */
+static int trace_callback(const char *pu8_input_value, cli_send_bytes_t pfun_uart_tx);
+
 /******************************************************************************/
 /* Global Variable Definition */
 /******************************************************************************/
@@ -317,6 +327,12 @@ cli_command_t cli_commands[] = {{
                                                 "To set the sidewalk css profile",
                                                 sw_set_css_pwr_profile_callback,
                                             },
+                                            {
+                                                "trace",
+                                                CLI_APP_NAME" trace <dump|clear|frames_on|frames_off>",
+                                                "To dump or clear the trace log, or print the MCM frames",
+                                                trace_callback,
+                                            },
                                             };
 
 cli_app_t register_app = {  CLI_APP_NAME, 
@@ -637,19 +653,14 @@ static int protocol_switch_callback(const char *pu8_input_value, cli_send_bytes_
 
 static int get_gps_time_callback(const char *pu8_input_value, cli_send_bytes_t pfun_uart_tx)
 {
-    // Call the GPS time retrieval function
-    uint32_t gps_time = 0;
-    int status = get_gps_timestamp(&gps_time);
+    // the GPS time is printed once the modem answers
+    int status = request_gps_time();
     
     if (status != 0) {
         Serial.println("Error: Failed to get GPS time");
         return 1;
     }
     
-    // Print the GPS time in Unix timestamp format
-    Serial.print("Current GPS time: ");
-    Serial.println(gps_time);
-    
     return 0;
 }
 
@@ -685,21 +696,13 @@ static int lorawan_time_sync_callback(const char *pu8_input_value, cli_send_byte
  */
 static int get_dl_stats_callback(const char *pu8_input_value, cli_send_bytes_t pfun_uart_tx)
 {
-    get_last_dl_stats_t dl_stats;
-    int status = app_get_dl_stats(&dl_stats);
+    // the detailed downlink statistics are printed once the modem answers
+    int status = app_request_dl_stats();
     
     if (status != 0) {
         Serial.println("Error: Failed to retrieve downlink statistics");
         return 1;
     }
-
-    // Print the detailed downlink statistics
-    Serial.printf("Last Downlink Statistics:\n"
-                  "\tProtocol Type: %d\n"
-                  "\tRSSI: %d\n"
-                  "\tSNR: %d\n"
-                  "\tTimestamp: %lu\n",
-                  dl_stats.protocol_type, dl_stats.rssi, dl_stats.snr, dl_stats.timestamp);
     
     return 0;
 }
@@ -713,15 +716,12 @@ static int get_dl_stats_callback(const char *pu8_input_value, cli_send_bytes_t p
  */
 static int get_next_uplink_mtu_callback(const char *pu8_input_value, cli_send_bytes_t pfun_uart_tx)
 {
-    uint16_t mtu = 0;
-    
-    int status = app_queryNextUplink_mtu(&mtu);
+    // the MTU is printed once the modem answers
+    int status = app_requestNextUplink_mtu();
     if (status != 0) {
         Serial.println("Error: Failed to get next uplink MTU");
         return 1;
     }
-    Serial.print("Next Uplink MTU: ");
-    Serial.println(mtu);
     return 0;
 }
 
@@ -757,4 +757,30 @@ static int sw_set_css_pwr_profile_callback(const char *pu8_input_value,
   app_SwSetCssPwrProfile(prof);
 
   return 0;
-}
\ No newline at end of file
+}
+
+static void trace_print_line(const char *line)
+{
+  Serial.println(line);
+}
+
+static int trace_callback(const char *pu8_input_value, cli_send_bytes_t pfun_uart_tx)
+{
+  if (pu8_input_value == NULL || strlen(pu8_input_value) == 0 || strcmp(pu8_input_value, "dump") == 0) {
+    uint32_t dumped = trace_log_dump(trace_print_line);
+    Serial.printf("%lu traces dumped, %lu logged since boot\n", (unsigned long)dumped,
+                  (unsigned long)trace_log_get_count());
+  } else if (strcmp(pu8_input_value, "clear") == 0) {
+    trace_log_clear();
+    Serial.println("Trace log cleared");
+  } else if (strcmp(pu8_input_value, "frames_on") == 0) {
+    app_set_mcm_frame_dump(true);
+  } else if (strcmp(pu8_input_value, "frames_off") == 0) {
+    app_set_mcm_frame_dump(false);
+  } else {
+    Serial.println("Usage: trace <dump|clear|frames_on|frames_off>");
+    return 1;
+  }
+
+  return 0;
+}
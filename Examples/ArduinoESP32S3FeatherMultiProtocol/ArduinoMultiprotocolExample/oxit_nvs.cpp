@@ -70,11 +70,13 @@
 #define JOIN_EUI_KEY "join_eui"
 #define APP_KEY_KEY "app_key"
 #define REBOOT_COUNT_KEY "reboot_count" 
+#define FW_CHECKPOINT_KEY "fw_ckpt"
 
 #define REBOOT_LOC 0
 #define DEVEUI_LOC 8
 #define JOIN_EUI_LOC 24
 #define APP_KEY_LOC 40
+#define FW_CHECKPOINT_LOC 56
 
 /******************************************************************************
  * PRIVATE TYPEDEFS
@@ -84,7 +86,9 @@
  * STATIC VARIABLES
  ******************************************************************************/
 ExternalEEPROM myMem;
+#if !USE_INTERNAL_FLASH
 static bool is_nvs_init = false;
+#endif
 /******************************************************************************
  * GLOBAL VARIABLES
  ******************************************************************************/
@@ -486,6 +490,141 @@ bool nvs_storage_set_app_key(uint8_t *app_key)
     return return_value;
 }
 
+bool nvs_storage_get_fw_checkpoint(nvs_fw_checkpoint_t *p_checkpoint)
+{
+    bool return_value = false;
+#if USE_INTERNAL_FLASH
+    nvs_handle_t storage_handle;
+    esp_err_t err;
+
+    err = nvs_open(STORAGE_NAMESPACE, NVS_READONLY, &storage_handle);
+    do
+    {
+        if (err != ESP_OK)
+        {
+            Serial.println("Failed to open NVS");
+            break;
+        }
+        size_t required_size = sizeof(nvs_fw_checkpoint_t);
+        err = nvs_get_blob(storage_handle, FW_CHECKPOINT_KEY, p_checkpoint, &required_size);
+
+        // A missing key just means no transfer was interrupted
+        if (err != ESP_OK || required_size != sizeof(nvs_fw_checkpoint_t))
+        {
+            break;
+        }
+        return_value = true;
+    } while (0);
+
+    nvs_close(storage_handle);
+#else
+    if(false == is_nvs_init)
+    {
+        return false;
+    }
+    if (0 == myMem.read(FW_CHECKPOINT_LOC, (uint8_t *)p_checkpoint, sizeof(nvs_fw_checkpoint_t)))
+    {
+        return_value = !is_all_ff((uint8_t *)p_checkpoint, sizeof(nvs_fw_checkpoint_t));
+    }
+#endif
+    return return_value;
+}
+
+bool nvs_storage_set_fw_checkpoint(const nvs_fw_checkpoint_t *p_checkpoint)
+{
+    bool return_value = false;
+#if USE_INTERNAL_FLASH
+    nvs_handle_t storage_handle;
+    esp_err_t err;
+    err = nvs_open(STORAGE_NAMESPACE, NVS_READWRITE, &storage_handle);
+    do
+    {
+        if (err != ESP_OK)
+        {
+            Serial.println("Failed to open NVS");
+            break;
+        }
+        err = nvs_set_blob(storage_handle, FW_CHECKPOINT_KEY, p_checkpoint, sizeof(nvs_fw_checkpoint_t));
+        if (err != ESP_OK)
+        {
+            Serial.println("Failed to write fw checkpoint");
+            break;
+        }
+
+        err = nvs_commit(storage_handle);
+        if (err != ESP_OK)
+        {
+            Serial.println("Failed to commit fw checkpoint");
+            break;
+        }
+        return_value = true;
+    } while (0);
+    nvs_close(storage_handle);
+#else
+    if(false == is_nvs_init)
+    {
+        return false;
+    }
+
+    if (0 == myMem.write(FW_CHECKPOINT_LOC, (uint8_t *)p_checkpoint, sizeof(nvs_fw_checkpoint_t)))
+    {
+        return_value = true;
+    }
+#endif
+    return return_value;
+}
+
+bool nvs_storage_clear_fw_checkpoint()
+{
+    bool return_value = false;
+#if USE_INTERNAL_FLASH
+    nvs_handle_t storage_handle;
+    esp_err_t err;
+    err = nvs_open(STORAGE_NAMESPACE, NVS_READWRITE, &storage_handle);
+    do
+    {
+        if (err != ESP_OK)
+        {
+            Serial.println("Failed to open NVS");
+            break;
+        }
+        err = nvs_erase_key(storage_handle, FW_CHECKPOINT_KEY);
+        if (err == ESP_ERR_NVS_NOT_FOUND)
+        {
+            return_value = true;
+            break;
+        }
+        if (err != ESP_OK)
+        {
+            Serial.println("Failed to erase fw checkpoint");
+            break;
+        }
+
+        err = nvs_commit(storage_handle);
+        if (err != ESP_OK)
+        {
+            Serial.println("Failed to commit fw checkpoint erase");
+            break;
+        }
+        return_value = true;
+    } while (0);
+    nvs_close(storage_handle);
+#else
+    if(false == is_nvs_init)
+    {
+        return false;
+    }
+
+    uint8_t blank[sizeof(nvs_fw_checkpoint_t)];
+    memset(blank, 0xFF, sizeof(blank));
+    if (0 == myMem.write(FW_CHECKPOINT_LOC, blank, sizeof(blank)))
+    {
+        return_value = true;
+    }
+#endif
+    return return_value;
+}
+
 bool nvs_storage_erase()
 {
 #if USE_INTERNAL_FLASH
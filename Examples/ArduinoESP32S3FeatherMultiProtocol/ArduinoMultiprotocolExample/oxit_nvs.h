@@ -55,6 +55,21 @@ extern "C" {
  * TYPEDEFS
  **********************************************************************************************************/
 
+/**
+ * @brief Progress of an interrupted host firmware transfer.
+ *
+ * Written by the YModem receiver while an image is streamed in, so the next
+ * transfer of the same image can pick up where the last one stopped.
+ */
+typedef struct
+{
+    uint32_t u32_tag;               ///< Image identity (packed firmware version)
+    uint32_t u32_image_size;        ///< Image size announced in the YModem header
+    uint32_t u32_committed;         ///< Bytes of the image already written to the sink
+    uint16_t u16_crc;               ///< CRC16 (XMODEM) over the committed bytes
+    uint16_t u16_reserved;
+} nvs_fw_checkpoint_t;
+
 /**********************************************************************************************************
  * EXPORTED VARIABLES
  **********************************************************************************************************/
@@ -117,6 +132,31 @@ bool nvs_storage_set_join_eui(uint8_t *join_eui);
  */
 bool nvs_storage_set_dev_eui(uint8_t *dev_eui);
 
+/**
+ * @brief Retrieves the firmware transfer checkpoint from the NVS (Non-Volatile Storage) module.
+ *
+ * @param p_checkpoint Pointer to the structure to fill.
+ *
+ * @return true if a checkpoint is stored, false otherwise.
+ */
+bool nvs_storage_get_fw_checkpoint(nvs_fw_checkpoint_t *p_checkpoint);
+
+/**
+ * @brief Stores the firmware transfer checkpoint in the NVS (Non-Volatile Storage) module.
+ *
+ * @param p_checkpoint Pointer to the checkpoint to store.
+ *
+ * @return true if the checkpoint is successfully stored, false otherwise.
+ */
+bool nvs_storage_set_fw_checkpoint(const nvs_fw_checkpoint_t *p_checkpoint);
+
+/**
+ * @brief Removes the firmware transfer checkpoint from the NVS (Non-Volatile Storage) module.
+ *
+ * @return true if no checkpoint remains stored, false otherwise.
+ */
+bool nvs_storage_clear_fw_checkpoint();
+
 /**
  * @brief Erases all data stored in the NVS (Non-Volatile Storage) module.
  *
@@ -0,0 +1,212 @@
+/**
+ * @file rx_ring.c
+ * @author OXIT embedded firmware team
+ * @brief Lock-free single producer / single consumer byte ring between the UART callback and the decoder.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "rx_ring.h"
+#include <stddef.h>
+#include <string.h>
+
+/******************************************************************************
+ * EXTERN VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ ******************************************************************************/
+
+/******************************************************************************
+ * PRIVATE TYPEDEFS
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+bool rx_ring_init(rx_ring_t *p_ring, uint8_t *p_buffer, uint16_t u16_size)
+{
+    bool b_return_value = false;
+
+    do
+    {
+        if ((NULL == p_ring) || (NULL == p_buffer) || (0 == u16_size) || (0 != (u16_size & (u16_size - 1))))
+        {
+            break;
+        }
+
+        p_ring->p_buffer          = p_buffer;
+        p_ring->u16_size          = u16_size;
+        p_ring->u16_high_water    = 0;
+        p_ring->u32_head          = 0;
+        p_ring->u32_tail          = 0;
+        p_ring->u32_overrun_bytes = 0;
+        b_return_value = true;
+
+    } while (0);
+
+    return b_return_value;
+}
+
+uint16_t rx_ring_get_write_ptr(rx_ring_t *p_ring, uint8_t **pp_data)
+{
+    uint32_t u32_head = p_ring->u32_head;
+    // acquire: the consumer is done with the bytes before their space is reused
+    uint32_t u32_tail = __atomic_load_n(&p_ring->u32_tail, __ATOMIC_ACQUIRE);
+    uint16_t u16_free = p_ring->u16_size - (uint16_t)(u32_head - u32_tail);
+    uint16_t u16_offset = u32_head & (p_ring->u16_size - 1);
+    uint16_t u16_to_end = p_ring->u16_size - u16_offset;
+
+    *pp_data = &p_ring->p_buffer[u16_offset];
+    return (u16_free < u16_to_end) ? u16_free : u16_to_end;
+}
+
+void rx_ring_commit(rx_ring_t *p_ring, uint16_t u16_len)
+{
+    uint32_t u32_head = p_ring->u32_head + u16_len;
+    uint16_t u16_count = (uint16_t)(u32_head - __atomic_load_n(&p_ring->u32_tail, __ATOMIC_RELAXED));
+
+    if (u16_count > p_ring->u16_high_water)
+    {
+        p_ring->u16_high_water = u16_count;
+    }
+    // release: the bytes are in the buffer before the consumer sees the new head
+    __atomic_store_n(&p_ring->u32_head, u32_head, __ATOMIC_RELEASE);
+}
+
+uint16_t rx_ring_write(rx_ring_t *p_ring, const uint8_t *p_data, uint16_t u16_len)
+{
+    uint16_t u16_written = 0;
+
+    // at most two chunks, before and after the end of the buffer
+    while (u16_written < u16_len)
+    {
+        uint8_t *p_dest;
+        uint16_t u16_free = rx_ring_get_write_ptr(p_ring, &p_dest);
+        if (0 == u16_free)
+        {
+            break;
+        }
+        uint16_t u16_chunk = ((u16_len - u16_written) < u16_free) ? (u16_len - u16_written) : u16_free;
+        memcpy(p_dest, &p_data[u16_written], u16_chunk);
+        rx_ring_commit(p_ring, u16_chunk);
+        u16_written += u16_chunk;
+    }
+
+    rx_ring_add_overrun(p_ring, u16_len - u16_written);
+    return u16_written;
+}
+
+void rx_ring_add_overrun(rx_ring_t *p_ring, uint16_t u16_len)
+{
+    p_ring->u32_overrun_bytes += u16_len;
+}
+
+uint16_t rx_ring_get_read_ptr(rx_ring_t *p_ring, const uint8_t **pp_data)
+{
+    uint32_t u32_tail = p_ring->u32_tail;
+    // acquire: the bytes written by the producer are visible before they are read
+    uint32_t u32_head = __atomic_load_n(&p_ring->u32_head, __ATOMIC_ACQUIRE);
+    uint16_t u16_count = (uint16_t)(u32_head - u32_tail);
+    uint16_t u16_offset = u32_tail & (p_ring->u16_size - 1);
+    uint16_t u16_to_end = p_ring->u16_size - u16_offset;
+
+    *pp_data = &p_ring->p_buffer[u16_offset];
+    return (u16_count < u16_to_end) ? u16_count : u16_to_end;
+}
+
+void rx_ring_consume(rx_ring_t *p_ring, uint16_t u16_len)
+{
+    // release: the bytes have been read before the producer can overwrite them
+    __atomic_store_n(&p_ring->u32_tail, p_ring->u32_tail + u16_len, __ATOMIC_RELEASE);
+}
+
+uint16_t rx_ring_read(rx_ring_t *p_ring, uint8_t *p_data, uint16_t u16_len)
+{
+    uint16_t u16_read = 0;
+
+    while (u16_read < u16_len)
+    {
+        const uint8_t *p_src;
+        uint16_t u16_avail = rx_ring_get_read_ptr(p_ring, &p_src);
+        if (0 == u16_avail)
+        {
+            break;
+        }
+        uint16_t u16_chunk = ((u16_len - u16_read) < u16_avail) ? (u16_len - u16_read) : u16_avail;
+        memcpy(&p_data[u16_read], p_src, u16_chunk);
+        rx_ring_consume(p_ring, u16_chunk);
+        u16_read += u16_chunk;
+    }
+
+    return u16_read;
+}
+
+uint16_t rx_ring_get_count(rx_ring_t *p_ring)
+{
+    return (uint16_t)(__atomic_load_n(&p_ring->u32_head, __ATOMIC_ACQUIRE) - __atomic_load_n(&p_ring->u32_tail, __ATOMIC_ACQUIRE));
+}
+
+uint16_t rx_ring_get_high_water(rx_ring_t *p_ring)
+{
+    return p_ring->u16_high_water;
+}
+
+uint32_t rx_ring_get_overrun_count(rx_ring_t *p_ring)
+{
+    return p_ring->u32_overrun_bytes;
+}
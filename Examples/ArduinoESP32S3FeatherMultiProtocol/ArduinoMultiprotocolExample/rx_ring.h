@@ -0,0 +1,189 @@
+/**
+ * @file rx_ring.h
+ * @author OXIT embedded firmware team
+ * @brief Lock-free single producer / single consumer byte ring between the UART callback and the decoder.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+#ifndef __RX_RING_H__
+#define __RX_RING_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+/**
+ * @brief Context of the byte ring.
+ *
+ * One producer (the UART receive callback) writes and one consumer (the loop
+ * feeding the decoder) reads, no lock is needed between them. The indexes run
+ * freely and are masked with the size, which must be a power of two.
+ * The members are private, use the rx_ring_* functions to access them.
+ */
+typedef struct
+{
+    uint8_t *p_buffer;                                  // storage of the ring, u16_size bytes
+    uint16_t u16_size;                                  // size of p_buffer, power of two
+    uint16_t u16_high_water;                            // highest number of bytes waiting in the ring
+    uint32_t u32_head;                                  // bytes written, only changed by the producer
+    uint32_t u32_tail;                                  // bytes read, only changed by the consumer
+    uint32_t u32_overrun_bytes;                         // bytes dropped because the ring was full
+} rx_ring_t;
+
+/**********************************************************************************************************
+ * EXPORTED VARIABLES
+ **********************************************************************************************************/
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTION PROTOTYPES
+ **********************************************************************************************************/
+/**
+ * @brief Initializes the ring on the given storage, the ring is empty afterwards.
+ *  Must not be called while the producer or the consumer is running.
+ *
+ * @param[in,out] p_ring Pointer to the ring context
+ * @param[in] p_buffer Storage of the ring
+ * @param[in] u16_size Size of the storage, must be a power of two
+ *
+ * @retval true The ring is initialized
+ * @retval false Invalid parameters
+ */
+bool rx_ring_init(rx_ring_t *p_ring, uint8_t *p_buffer, uint16_t u16_size);
+
+/**
+ * @brief Producer side, returns the contiguous free space where the next bytes can be written.
+ *  The bytes become visible to the consumer once rx_ring_commit() is called.
+ *
+ * @param[in] p_ring Pointer to the ring context
+ * @param[out] pp_data Start of the free space
+ *
+ * @return Number of contiguous free bytes, 0 if the ring is full
+ */
+uint16_t rx_ring_get_write_ptr(rx_ring_t *p_ring, uint8_t **pp_data);
+
+/**
+ * @brief Producer side, publishes bytes written at the pointer returned by rx_ring_get_write_ptr().
+ *
+ * @param[in,out] p_ring Pointer to the ring context
+ * @param[in] u16_len Number of bytes written, at most the returned free space
+ */
+void rx_ring_commit(rx_ring_t *p_ring, uint16_t u16_len);
+
+/**
+ * @brief Producer side, copies bytes into the ring. Bytes that do not fit are
+ *  dropped and added to the overrun counter.
+ *
+ * @param[in,out] p_ring Pointer to the ring context
+ * @param[in] p_data Bytes to write
+ * @param[in] u16_len Number of bytes to write
+ *
+ * @return Number of bytes written
+ */
+uint16_t rx_ring_write(rx_ring_t *p_ring, const uint8_t *p_data, uint16_t u16_len);
+
+/**
+ * @brief Producer side, accounts bytes which were received but could not be stored.
+ *
+ * @param[in,out] p_ring Pointer to the ring context
+ * @param[in] u16_len Number of dropped bytes
+ */
+void rx_ring_add_overrun(rx_ring_t *p_ring, uint16_t u16_len);
+
+/**
+ * @brief Consumer side, returns the contiguous bytes available for reading, without copying them.
+ *  The bytes stay in the ring until rx_ring_consume() is called.
+ *
+ * @param[in] p_ring Pointer to the ring context
+ * @param[out] pp_data Start of the available bytes
+ *
+ * @return Number of contiguous bytes, 0 if the ring is empty
+ */
+uint16_t rx_ring_get_read_ptr(rx_ring_t *p_ring, const uint8_t **pp_data);
+
+/**
+ * @brief Consumer side, releases bytes returned by rx_ring_get_read_ptr().
+ *
+ * @param[in,out] p_ring Pointer to the ring context
+ * @param[in] u16_len Number of bytes to release, at most the returned length
+ */
+void rx_ring_consume(rx_ring_t *p_ring, uint16_t u16_len);
+
+/**
+ * @brief Consumer side, copies and removes bytes from the ring.
+ *
+ * @param[in,out] p_ring Pointer to the ring context
+ * @param[out] p_data Destination of the bytes
+ * @param[in] u16_len Size of the destination
+ *
+ * @return Number of bytes copied
+ */
+uint16_t rx_ring_read(rx_ring_t *p_ring, uint8_t *p_data, uint16_t u16_len);
+
+/**
+ * @brief Returns the number of bytes waiting in the ring.
+ */
+uint16_t rx_ring_get_count(rx_ring_t *p_ring);
+
+/**
+ * @brief Returns the highest number of bytes that waited in the ring since the init.
+ */
+uint16_t rx_ring_get_high_water(rx_ring_t *p_ring);
+
+/**
+ * @brief Returns the number of bytes dropped because the ring was full.
+ */
+uint32_t rx_ring_get_overrun_count(rx_ring_t *p_ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __RX_RING_H__
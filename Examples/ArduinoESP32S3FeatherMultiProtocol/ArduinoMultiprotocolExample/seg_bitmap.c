@@ -0,0 +1,472 @@
+/**
+ * @file seg_bitmap.h
+ * @author OXIT embedded firmware team
+ * @brief Tracks the pending segments of a segmented FUOTA package of any length.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "seg_bitmap.h"
+#include <stddef.h>
+#include <string.h>
+
+/******************************************************************************
+ * EXTERN VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ ******************************************************************************/
+#define SEG_BITMAP_VARINT_MAX_LEN       (5)
+
+/******************************************************************************
+ * PRIVATE TYPEDEFS
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ ******************************************************************************/
+static bool seg_bitmap_attach(seg_bitmap_t *p_map, uint32_t *p_words, uint32_t u32_word_count, uint32_t u32_count);
+static void seg_bitmap_recount(seg_bitmap_t *p_map);
+static void seg_bitmap_fill(seg_bitmap_t *p_map, uint32_t u32_start, uint32_t u32_len);
+static uint32_t seg_bitmap_find(const seg_bitmap_t *p_map, uint32_t u32_from, bool b_pending);
+static uint32_t seg_bitmap_varint_len(uint32_t u32_value);
+static uint32_t seg_bitmap_varint_put(uint8_t *p_buf, uint32_t u32_value);
+static bool seg_bitmap_varint_get(const uint8_t *p_buf, uint32_t u32_len, uint32_t *p_pos, uint32_t *p_value);
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+/**
+ * @brief Takes the storage and clears it, every segment downloaded
+ */
+static bool seg_bitmap_attach(seg_bitmap_t *p_map, uint32_t *p_words, uint32_t u32_word_count, uint32_t u32_count)
+{
+    if ((NULL == p_map) || ((NULL == p_words) && (0 != u32_count)) || (u32_word_count < SEG_BITMAP_WORDS(u32_count)))
+    {
+        return false;
+    }
+    p_map->p_words = p_words;
+    p_map->u32_word_count = u32_word_count;
+    p_map->u32_count = u32_count;
+    p_map->u32_pending = 0;
+    if (0 != u32_word_count)
+    {
+        memset(p_words, 0, u32_word_count * sizeof(uint32_t));
+    }
+    return true;
+}
+
+static void seg_bitmap_recount(seg_bitmap_t *p_map)
+{
+    uint32_t u32_pending = 0;
+
+    for (uint32_t i = 0; i < SEG_BITMAP_WORDS(p_map->u32_count); i++)
+    {
+        u32_pending += (uint32_t)__builtin_popcount(p_map->p_words[i]);
+    }
+    p_map->u32_pending = u32_pending;
+}
+
+/**
+ * @brief Marks a range of segments pending a word at a time, the range must be inside the map
+ *        and the pending count is left to the caller
+ */
+static void seg_bitmap_fill(seg_bitmap_t *p_map, uint32_t u32_start, uint32_t u32_len)
+{
+    while (0 != u32_len)
+    {
+        uint32_t u32_bit = u32_start % 32;
+        uint32_t u32_bits = 32 - u32_bit;
+        uint32_t u32_mask;
+
+        if (u32_bits > u32_len)
+        {
+            u32_bits = u32_len;
+        }
+        u32_mask = (32 == u32_bits) ? 0xFFFFFFFFUL : ((((uint32_t)1 << u32_bits) - 1) << u32_bit);
+        p_map->p_words[u32_start / 32] |= u32_mask;
+        u32_start += u32_bits;
+        u32_len -= u32_bits;
+    }
+}
+
+/**
+ * @brief First segment at or after u32_from in the given state, SEG_BITMAP_NONE if there is none
+ */
+static uint32_t seg_bitmap_find(const seg_bitmap_t *p_map, uint32_t u32_from, bool b_pending)
+{
+    uint32_t u32_invert = b_pending ? 0 : 0xFFFFFFFFUL;
+    uint32_t u32_words = SEG_BITMAP_WORDS(p_map->u32_count);
+    uint32_t u32_word_index;
+    uint32_t u32_word;
+
+    if (u32_from >= p_map->u32_count)
+    {
+        return SEG_BITMAP_NONE;
+    }
+    u32_word_index = u32_from / 32;
+    u32_word = (p_map->p_words[u32_word_index] ^ u32_invert) & (uint32_t)(0xFFFFFFFFUL << (u32_from % 32));
+    while (0 == u32_word)
+    {
+        if (++u32_word_index >= u32_words)
+        {
+            return SEG_BITMAP_NONE;
+        }
+        u32_word = p_map->p_words[u32_word_index] ^ u32_invert;
+    }
+
+    // the inverted tail past the last segment reads as downloaded segments
+    u32_from = (u32_word_index * 32) + (uint32_t)__builtin_ctz(u32_word);
+    return (u32_from < p_map->u32_count) ? u32_from : SEG_BITMAP_NONE;
+}
+
+static uint32_t seg_bitmap_varint_len(uint32_t u32_value)
+{
+    uint32_t u32_len = 1;
+
+    while (u32_value >= 0x80)
+    {
+        u32_value >>= 7;
+        u32_len++;
+    }
+    return u32_len;
+}
+
+static uint32_t seg_bitmap_varint_put(uint8_t *p_buf, uint32_t u32_value)
+{
+    uint32_t u32_len = 0;
+
+    while (u32_value >= 0x80)
+    {
+        p_buf[u32_len++] = (uint8_t)(u32_value | 0x80);
+        u32_value >>= 7;
+    }
+    p_buf[u32_len++] = (uint8_t)u32_value;
+    return u32_len;
+}
+
+static bool seg_bitmap_varint_get(const uint8_t *p_buf, uint32_t u32_len, uint32_t *p_pos, uint32_t *p_value)
+{
+    uint32_t u32_value = 0;
+
+    for (uint32_t i = 0; i < SEG_BITMAP_VARINT_MAX_LEN; i++)
+    {
+        if (*p_pos >= u32_len)
+        {
+            return false;
+        }
+        uint8_t u8_byte = p_buf[(*p_pos)++];
+        // the fifth group only has room for the top 4 bits
+        if ((SEG_BITMAP_VARINT_MAX_LEN - 1 == i) && (u8_byte > 0x0F))
+        {
+            return false;
+        }
+        u32_value |= (uint32_t)(u8_byte & 0x7F) << (7 * i);
+        if (0 == (u8_byte & 0x80))
+        {
+            *p_value = u32_value;
+            return true;
+        }
+    }
+    return false;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+/******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+bool seg_bitmap_init(seg_bitmap_t *p_map, uint32_t *p_words, uint32_t u32_word_count, uint32_t u32_count)
+{
+    if (!seg_bitmap_attach(p_map, p_words, u32_word_count, u32_count))
+    {
+        return false;
+    }
+    seg_bitmap_fill(p_map, 0, u32_count);
+    p_map->u32_pending = u32_count;
+    return true;
+}
+
+bool seg_bitmap_from_status16(seg_bitmap_t *p_map, uint32_t *p_words, uint32_t u32_word_count, uint16_t u16_status, uint32_t u32_count)
+{
+    uint32_t u32_legacy = (u32_count < SEG_BITMAP_LEGACY_COUNT) ? u32_count : SEG_BITMAP_LEGACY_COUNT;
+    uint32_t u32_mask = ((uint32_t)1 << u32_legacy) - 1;
+
+    if (!seg_bitmap_init(p_map, p_words, u32_word_count, u32_count))
+    {
+        return false;
+    }
+    if (0 != u32_count)
+    {
+        p_words[0] = (p_words[0] & ~u32_mask) | (u16_status & u32_mask);
+        seg_bitmap_recount(p_map);
+    }
+    return true;
+}
+
+uint16_t seg_bitmap_to_status16(const seg_bitmap_t *p_map)
+{
+    if (0 == p_map->u32_count)
+    {
+        return 0;
+    }
+    return (uint16_t)(p_map->p_words[0] & 0xFFFF);
+}
+
+void seg_bitmap_set_pending(seg_bitmap_t *p_map, uint32_t u32_index, bool b_pending)
+{
+    uint32_t u32_mask;
+    uint32_t *p_word;
+
+    if (u32_index >= p_map->u32_count)
+    {
+        return;
+    }
+    p_word = &p_map->p_words[u32_index / 32];
+    u32_mask = (uint32_t)1 << (u32_index % 32);
+    if (b_pending == (0 != (*p_word & u32_mask)))
+    {
+        return;
+    }
+    if (b_pending)
+    {
+        *p_word |= u32_mask;
+        p_map->u32_pending++;
+    }
+    else
+    {
+        *p_word &= ~u32_mask;
+        p_map->u32_pending--;
+    }
+}
+
+bool seg_bitmap_is_pending(const seg_bitmap_t *p_map, uint32_t u32_index)
+{
+    if (u32_index >= p_map->u32_count)
+    {
+        return false;
+    }
+    return 0 != (p_map->p_words[u32_index / 32] & ((uint32_t)1 << (u32_index % 32)));
+}
+
+uint32_t seg_bitmap_get_count(const seg_bitmap_t *p_map)
+{
+    return p_map->u32_count;
+}
+
+uint32_t seg_bitmap_get_pending_count(const seg_bitmap_t *p_map)
+{
+    return p_map->u32_pending;
+}
+
+uint8_t seg_bitmap_get_progress(const seg_bitmap_t *p_map)
+{
+    if (0 == p_map->u32_count)
+    {
+        return 100;
+    }
+    return (uint8_t)(((uint64_t)(p_map->u32_count - p_map->u32_pending) * 100) / p_map->u32_count);
+}
+
+uint32_t seg_bitmap_find_pending(const seg_bitmap_t *p_map, uint32_t u32_from)
+{
+    return seg_bitmap_find(p_map, u32_from, true);
+}
+
+uint32_t seg_bitmap_encode(const seg_bitmap_t *p_map, uint8_t *p_buf, uint32_t u32_size)
+{
+    uint32_t u32_raw_len = (p_map->u32_count / 8) + ((0 != (p_map->u32_count % 8)) ? 1 : 0);
+    uint32_t u32_runs_len = 0;
+    uint32_t u32_runs = 0;
+    uint32_t u32_pos = 0;
+    uint32_t u32_len;
+    uint32_t u32_start;
+    bool b_use_runs = true;
+
+    // size of the runs body, given up as soon as it is not shorter than the raw body
+    u32_start = seg_bitmap_find(p_map, 0, true);
+    while (SEG_BITMAP_NONE != u32_start)
+    {
+        uint32_t u32_end = seg_bitmap_find(p_map, u32_start, false);
+
+        if (SEG_BITMAP_NONE == u32_end)
+        {
+            u32_end = p_map->u32_count;
+        }
+        u32_runs++;
+        u32_runs_len += seg_bitmap_varint_len(u32_start - u32_pos) + seg_bitmap_varint_len(u32_end - u32_start - 1);
+        if (u32_runs_len >= u32_raw_len)
+        {
+            b_use_runs = false;
+            break;
+        }
+        u32_pos = u32_end;
+        u32_start = seg_bitmap_find(p_map, u32_pos, true);
+    }
+    if (b_use_runs)
+    {
+        u32_runs_len += seg_bitmap_varint_len(u32_runs);
+        b_use_runs = (u32_runs_len < u32_raw_len);
+    }
+
+    u32_len = 1 + seg_bitmap_varint_len(p_map->u32_count) + (b_use_runs ? u32_runs_len : u32_raw_len);
+    if ((NULL == p_buf) || (u32_size < u32_len))
+    {
+        return 0;
+    }
+
+    p_buf[0] = b_use_runs ? SEG_BITMAP_ENC_RUNS : SEG_BITMAP_ENC_RAW;
+    u32_len = 1 + seg_bitmap_varint_put(&p_buf[1], p_map->u32_count);
+    if (!b_use_runs)
+    {
+        for (uint32_t i = 0; i < u32_raw_len; i++)
+        {
+            p_buf[u32_len++] = (uint8_t)(p_map->p_words[i / 4] >> (8 * (i % 4)));
+        }
+        return u32_len;
+    }
+
+    u32_len += seg_bitmap_varint_put(&p_buf[u32_len], u32_runs);
+    u32_pos = 0;
+    u32_start = seg_bitmap_find(p_map, 0, true);
+    while (SEG_BITMAP_NONE != u32_start)
+    {
+        uint32_t u32_end = seg_bitmap_find(p_map, u32_start, false);
+
+        if (SEG_BITMAP_NONE == u32_end)
+        {
+            u32_end = p_map->u32_count;
+        }
+        u32_len += seg_bitmap_varint_put(&p_buf[u32_len], u32_start - u32_pos);
+        u32_len += seg_bitmap_varint_put(&p_buf[u32_len], u32_end - u32_start - 1);
+        u32_pos = u32_end;
+        u32_start = seg_bitmap_find(p_map, u32_pos, true);
+    }
+    return u32_len;
+}
+
+bool seg_bitmap_decode(seg_bitmap_t *p_map, uint32_t *p_words, uint32_t u32_word_count, const uint8_t *p_buf, uint32_t u32_len)
+{
+    uint32_t u32_pos = 1;
+    uint32_t u32_count = 0;
+
+    if ((NULL == p_buf) || (0 == u32_len) || !seg_bitmap_varint_get(p_buf, u32_len, &u32_pos, &u32_count))
+    {
+        return false;
+    }
+    if (!seg_bitmap_attach(p_map, p_words, u32_word_count, u32_count))
+    {
+        return false;
+    }
+
+    if (SEG_BITMAP_ENC_RAW == p_buf[0])
+    {
+        uint32_t u32_raw_len = (u32_count / 8) + ((0 != (u32_count % 8)) ? 1 : 0);
+
+        if ((u32_len - u32_pos) != u32_raw_len)
+        {
+            return false;
+        }
+        for (uint32_t i = 0; i < u32_raw_len; i++)
+        {
+            p_words[i / 4] |= (uint32_t)p_buf[u32_pos + i] << (8 * (i % 4));
+        }
+        // bits past the last segment must stay clear for the pending count and the searches
+        if ((0 != (u32_count % 32)) && (0 != (p_words[u32_count / 32] >> (u32_count % 32))))
+        {
+            return false;
+        }
+        seg_bitmap_recount(p_map);
+        return true;
+    }
+
+    if (SEG_BITMAP_ENC_RUNS == p_buf[0])
+    {
+        uint32_t u32_runs = 0;
+        uint32_t u32_index = 0;
+
+        if (!seg_bitmap_varint_get(p_buf, u32_len, &u32_pos, &u32_runs))
+        {
+            return false;
+        }
+        for (uint32_t i = 0; i < u32_runs; i++)
+        {
+            uint32_t u32_gap = 0;
+            uint32_t u32_run = 0;
+
+            if (!seg_bitmap_varint_get(p_buf, u32_len, &u32_pos, &u32_gap) ||
+                !seg_bitmap_varint_get(p_buf, u32_len, &u32_pos, &u32_run))
+            {
+                return false;
+            }
+            // a run must start past the previous one and end inside the map
+            if ((0 != i) && (0 == u32_gap))
+            {
+                return false;
+            }
+            if ((u32_gap > u32_count - u32_index) || (u32_run >= u32_count - u32_index - u32_gap))
+            {
+                return false;
+            }
+            u32_index += u32_gap;
+            seg_bitmap_fill(p_map, u32_index, u32_run + 1);
+            p_map->u32_pending += u32_run + 1;
+            u32_index += u32_run + 1;
+        }
+        return (u32_pos == u32_len);
+    }
+
+    return false;
+}
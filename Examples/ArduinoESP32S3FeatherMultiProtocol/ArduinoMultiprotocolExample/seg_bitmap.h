@@ -0,0 +1,217 @@
+/**
+ * @file seg_bitmap.h
+ * @author OXIT embedded firmware team
+ * @brief Tracks the pending segments of a segmented FUOTA package of any length.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+#ifndef __SEG_BITMAP_H__
+#define __SEG_BITMAP_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+/**
+ * @brief Words of storage needed for a map of u32_count segments.
+ *  Rounded up without an addition that could wrap, the count of a decoded map comes from the wire and
+ *  unsigned long has 32 bits on the target.
+ */
+#define SEG_BITMAP_WORDS(count)         (((count) / 32UL) + ((0UL != ((count) % 32UL)) ? 1UL : 0UL))
+
+/**
+ * @brief Returned by seg_bitmap_find_pending() when no segment is pending
+ */
+#define SEG_BITMAP_NONE                 (0xFFFFFFFFUL)
+
+/**
+ * @brief Segments described by the 16 bit seg_status of get_seg_file_status_t
+ */
+#define SEG_BITMAP_LEGACY_COUNT         (16)
+
+/**
+ * @brief Wire encoding, first byte of the encoded map.
+ *
+ * Encoded map layout:
+ *  [format][segment count, varint][body]
+ *  RAW body: one bit per segment, bit i in byte i / 8 at position i % 8, set when pending.
+ *  For 16 segments or less it is the seg_status field of the mcm as sent on the serial line.
+ *  RUNS body: [run count, varint] then per run of pending segments [gap, varint][length - 1, varint],
+ *  the gap counting the downloaded segments since the end of the previous run.
+ *  seg_bitmap_encode() picks the shorter of the two.
+ *  Varints are 7 bits per byte, low group first, bit 7 set when another byte follows.
+ */
+#define SEG_BITMAP_ENC_RAW              (0x00)
+#define SEG_BITMAP_ENC_RUNS             (0x01)
+
+/**
+ * @brief Longest encoding of a map of u32_count segments, enough for seg_bitmap_encode()
+ */
+#define SEG_BITMAP_ENC_MAX_LEN(count)   (1UL + 5UL + ((count) / 8UL) + ((0UL != ((count) % 8UL)) ? 1UL : 0UL))
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+/**
+ * @brief Map of the segments of a package, one bit per segment set while the segment is pending
+ *        (SEG_PENDING in host_fuota.h).
+ *
+ * The storage is given at init. The bits past the last segment are kept clear and the number
+ * of pending segments is maintained on every change, so progress is read without a scan.
+ * The members are private, use the seg_bitmap_* functions to access them.
+ */
+typedef struct
+{
+    uint32_t *p_words;                                  // storage, u32_word_count words
+    uint32_t u32_word_count;
+    uint32_t u32_count;                                 // number of segments of the package
+    uint32_t u32_pending;                               // number of bits set in p_words
+} seg_bitmap_t;
+
+/**********************************************************************************************************
+ * EXPORTED VARIABLES
+ **********************************************************************************************************/
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTION PROTOTYPES
+ **********************************************************************************************************/
+/**
+ * @brief Prepares a map with every segment pending.
+ *
+ * @param[out] p_map Pointer to the map
+ * @param[in] p_words Storage of the map, kept by the caller while the map is used
+ * @param[in] u32_word_count Words of storage, at least SEG_BITMAP_WORDS(u32_count)
+ * @param[in] u32_count Number of segments
+ *
+ * @retval true The map is ready
+ * @retval false The storage is too small
+ */
+bool seg_bitmap_init(seg_bitmap_t *p_map, uint32_t *p_words, uint32_t u32_word_count, uint32_t u32_count);
+
+/**
+ * @brief Prepares a map from the 16 bit seg_status reported by the mcm.
+ *
+ * Segments past the first SEG_BITMAP_LEGACY_COUNT are not described by the status, they stay pending.
+ *
+ * @param[out] p_map Pointer to the map
+ * @param[in] p_words Storage of the map, kept by the caller while the map is used
+ * @param[in] u32_word_count Words of storage, at least SEG_BITMAP_WORDS(u32_count)
+ * @param[in] u16_status Bit i set while segment i is pending
+ * @param[in] u32_count Number of segments
+ *
+ * @retval true The map is ready
+ * @retval false The storage is too small
+ */
+bool seg_bitmap_from_status16(seg_bitmap_t *p_map, uint32_t *p_words, uint32_t u32_word_count, uint16_t u16_status, uint32_t u32_count);
+
+/**
+ * @brief State of the first SEG_BITMAP_LEGACY_COUNT segments in the 16 bit seg_status form
+ */
+uint16_t seg_bitmap_to_status16(const seg_bitmap_t *p_map);
+
+/**
+ * @brief Marks a segment pending or downloaded, out of range segments are ignored.
+ */
+void seg_bitmap_set_pending(seg_bitmap_t *p_map, uint32_t u32_index, bool b_pending);
+
+/**
+ * @brief true if the segment is pending, false if downloaded or out of range
+ */
+bool seg_bitmap_is_pending(const seg_bitmap_t *p_map, uint32_t u32_index);
+
+/**
+ * @brief Number of segments of the map
+ */
+uint32_t seg_bitmap_get_count(const seg_bitmap_t *p_map);
+
+/**
+ * @brief Number of pending segments, kept up to date by the map
+ */
+uint32_t seg_bitmap_get_pending_count(const seg_bitmap_t *p_map);
+
+/**
+ * @brief Percentage of the segments downloaded, 100 for an empty map
+ */
+uint8_t seg_bitmap_get_progress(const seg_bitmap_t *p_map);
+
+/**
+ * @brief First pending segment at or after u32_from.
+ *
+ * @return Index of the segment, SEG_BITMAP_NONE if every segment from u32_from is downloaded
+ */
+uint32_t seg_bitmap_find_pending(const seg_bitmap_t *p_map, uint32_t u32_from);
+
+/**
+ * @brief Encodes the map for the wire, see SEG_BITMAP_ENC_RAW.
+ *
+ * @param[in] p_map Pointer to the map
+ * @param[out] p_buf Encoded map
+ * @param[in] u32_size Size of p_buf, SEG_BITMAP_ENC_MAX_LEN(count) is always enough
+ *
+ * @return Length of the encoded map, 0 if p_buf is too small
+ */
+uint32_t seg_bitmap_encode(const seg_bitmap_t *p_map, uint8_t *p_buf, uint32_t u32_size);
+
+/**
+ * @brief Rebuilds a map from its wire encoding.
+ *
+ * @param[out] p_map Pointer to the map
+ * @param[in] p_words Storage of the map, kept by the caller while the map is used
+ * @param[in] u32_word_count Words of storage
+ * @param[in] p_buf Encoded map
+ * @param[in] u32_len Length of the encoded map
+ *
+ * @retval true The map is rebuilt
+ * @retval false Malformed encoding or storage too small, the map is not usable
+ */
+bool seg_bitmap_decode(seg_bitmap_t *p_map, uint32_t *p_words, uint32_t u32_word_count, const uint8_t *p_buf, uint32_t u32_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SEG_BITMAP_H__
@@ -0,0 +1,179 @@
+/**
+ * @file trace_log.c
+ * @author OXIT embedded firmware team
+ * @brief Binary trace ring buffer. The traces are stored as a format string
+ *  pointer and raw arguments, they are only formatted when the ring is dumped.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "trace_log.h"
+#include <stdio.h>
+#include <string.h>
+
+/******************************************************************************
+ * EXTERN VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ ******************************************************************************/
+#if (0 != (TRACE_LOG_SIZE & (TRACE_LOG_SIZE - 1)))
+#error "TRACE_LOG_SIZE must be a power of two"
+#endif
+
+/**
+ * @brief Size of a formatted line of the dump
+ */
+#define TRACE_LOG_LINE_SIZE                         160
+
+/******************************************************************************
+ * PRIVATE TYPEDEFS
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+static trace_log_entry_t s_trace_ring[TRACE_LOG_SIZE];
+
+/**
+ * @brief Number of traces logged, the next trace goes to s_trace_ring[s_u32_trace_head % TRACE_LOG_SIZE]
+ */
+static uint32_t s_u32_trace_head = 0;
+
+static const char *const s_level_names[] = { "", "E", "W", "I", "D" };
+
+/******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+void trace_log_write(uint8_t u8_level, const char *p_fmt, const uintptr_t *p_args, uint8_t u8_nargs)
+{
+    // reserving the slot is the only shared step, it is a single atomic increment
+    uint32_t u32_seq = __atomic_fetch_add(&s_u32_trace_head, 1, __ATOMIC_RELAXED);
+    trace_log_entry_t *p_entry = &s_trace_ring[u32_seq & (TRACE_LOG_SIZE - 1)];
+
+    __atomic_store_n(&p_entry->u32_seq, 0, __ATOMIC_RELAXED);
+    p_entry->p_fmt    = p_fmt;
+    p_entry->u8_level = u8_level;
+    p_entry->u8_nargs = (TRACE_LOG_MAX_ARGS < u8_nargs) ? TRACE_LOG_MAX_ARGS : u8_nargs;
+    for (uint8_t u8_index = 0; u8_index < p_entry->u8_nargs; u8_index++)
+    {
+        p_entry->args[u8_index] = p_args[u8_index];
+    }
+    // publish the entry once it is complete
+    __atomic_store_n(&p_entry->u32_seq, u32_seq + 1, __ATOMIC_RELEASE);
+
+#if TRACE_LOG_ECHO
+    printf(p_fmt, p_entry->args[0], p_entry->args[1], p_entry->args[2],
+           p_entry->args[3], p_entry->args[4], p_entry->args[5]);
+#endif
+}
+
+uint32_t trace_log_dump(trace_log_print_cb print_cb)
+{
+    uint32_t u32_dumped = 0;
+
+    do
+    {
+        if (NULL == print_cb)
+        {
+            break;
+        }
+
+        uint32_t u32_head  = __atomic_load_n(&s_u32_trace_head, __ATOMIC_ACQUIRE);
+        uint32_t u32_first = (TRACE_LOG_SIZE < u32_head) ? (u32_head - TRACE_LOG_SIZE) : 0;
+        char line[TRACE_LOG_LINE_SIZE];
+
+        for (uint32_t u32_seq = u32_first; u32_seq < u32_head; u32_seq++)
+        {
+            const trace_log_entry_t *p_entry = &s_trace_ring[u32_seq & (TRACE_LOG_SIZE - 1)];
+            trace_log_entry_t h_copy = *p_entry;
+
+            // skip the entries being written or already overwritten by a newer trace
+            if ((u32_seq + 1) != __atomic_load_n(&p_entry->u32_seq, __ATOMIC_ACQUIRE) ||
+                (u32_seq + 1) != h_copy.u32_seq || NULL == h_copy.p_fmt)
+            {
+                continue;
+            }
+
+            int prefix_len = snprintf(line, sizeof(line), "[%lu][%s] ", (unsigned long)u32_seq,
+                                      (TRACE_LEVEL_DEBUG >= h_copy.u8_level) ? s_level_names[h_copy.u8_level] : "?");
+            snprintf(&line[prefix_len], sizeof(line) - prefix_len, h_copy.p_fmt,
+                     h_copy.args[0], h_copy.args[1], h_copy.args[2],
+                     h_copy.args[3], h_copy.args[4], h_copy.args[5]);
+
+            // the traces keep their own line endings, the callback adds one
+            size_t len = strlen(line);
+            while (len > 0 && ('\n' == line[len - 1] || '\r' == line[len - 1]))
+            {
+                line[--len] = '\0';
+            }
+            print_cb(line);
+            u32_dumped++;
+        }
+    } while (0);
+
+    return u32_dumped;
+}
+
+void trace_log_clear(void)
+{
+    for (uint32_t u32_index = 0; u32_index < TRACE_LOG_SIZE; u32_index++)
+    {
+        __atomic_store_n(&s_trace_ring[u32_index].u32_seq, 0, __ATOMIC_RELAXED);
+    }
+}
+
+uint32_t trace_log_get_count(void)
+{
+    return __atomic_load_n(&s_u32_trace_head, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,201 @@
+/**
+ * @file trace_log.h
+ * @author OXIT embedded firmware team
+ * @brief Leveled trace macros logging into a binary ring buffer.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+#ifndef __TRACE_LOG_H__
+#define __TRACE_LOG_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+#define TRACE_LEVEL_NONE                            0
+#define TRACE_LEVEL_ERROR                           1
+#define TRACE_LEVEL_WARN                            2
+#define TRACE_LEVEL_INFO                            3
+#define TRACE_LEVEL_DEBUG                           4
+
+/**
+ * @brief Highest level compiled in, the traces above it generate no code.
+ *  Can be overridden from the compiler flags (-DTRACE_LEVEL=TRACE_LEVEL_DEBUG)
+ */
+#ifndef TRACE_LEVEL
+#define TRACE_LEVEL                                 TRACE_LEVEL_INFO
+#endif
+
+/**
+ * @brief Number of entries of the trace ring, must be a power of two
+ */
+#ifndef TRACE_LOG_SIZE
+#define TRACE_LOG_SIZE                              64
+#endif
+
+/**
+ * @brief Maximum number of arguments of a trace
+ */
+#define TRACE_LOG_MAX_ARGS                          6
+
+/**
+ * @brief set the value
+ *  0 to only store the traces in the ring and 1 to also print them when they are logged
+ */
+#ifndef TRACE_LOG_ECHO
+#define TRACE_LOG_ECHO                              0
+#endif
+
+// count the arguments after the format string, 0 to TRACE_LOG_MAX_ARGS
+#define _TRACE_NARGS(...)                           _TRACE_NARGS_(__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0, _)
+#define _TRACE_NARGS_(fmt, a1, a2, a3, a4, a5, a6, n, ...) n
+#define _TRACE_CAT(a, b)                            _TRACE_CAT_(a, b)
+#define _TRACE_CAT_(a, b)                           a##b
+
+#define _TRACE_LOG_0(lvl, fmt)                      trace_log_write(lvl, fmt, NULL, 0)
+#define _TRACE_LOG_1(lvl, fmt, a1)                  do { const uintptr_t _a[] = { (uintptr_t)(a1) }; \
+                                                         trace_log_write(lvl, fmt, _a, 1); } while (0)
+#define _TRACE_LOG_2(lvl, fmt, a1, a2)              do { const uintptr_t _a[] = { (uintptr_t)(a1), (uintptr_t)(a2) }; \
+                                                         trace_log_write(lvl, fmt, _a, 2); } while (0)
+#define _TRACE_LOG_3(lvl, fmt, a1, a2, a3)          do { const uintptr_t _a[] = { (uintptr_t)(a1), (uintptr_t)(a2), (uintptr_t)(a3) }; \
+                                                         trace_log_write(lvl, fmt, _a, 3); } while (0)
+#define _TRACE_LOG_4(lvl, fmt, a1, a2, a3, a4)      do { const uintptr_t _a[] = { (uintptr_t)(a1), (uintptr_t)(a2), (uintptr_t)(a3), \
+                                                                                  (uintptr_t)(a4) }; \
+                                                         trace_log_write(lvl, fmt, _a, 4); } while (0)
+#define _TRACE_LOG_5(lvl, fmt, a1, a2, a3, a4, a5)  do { const uintptr_t _a[] = { (uintptr_t)(a1), (uintptr_t)(a2), (uintptr_t)(a3), \
+                                                                                  (uintptr_t)(a4), (uintptr_t)(a5) }; \
+                                                         trace_log_write(lvl, fmt, _a, 5); } while (0)
+#define _TRACE_LOG_6(lvl, fmt, a1, a2, a3, a4, a5, a6) do { const uintptr_t _a[] = { (uintptr_t)(a1), (uintptr_t)(a2), (uintptr_t)(a3), \
+                                                                                     (uintptr_t)(a4), (uintptr_t)(a5), (uintptr_t)(a6) }; \
+                                                            trace_log_write(lvl, fmt, _a, 6); } while (0)
+
+/**
+ * @brief Logs a trace if its level is compiled in. The format string must be a
+ *  string literal and the arguments must fit in a pointer (integers, pointers to
+ *  constant strings), they are formatted only when the ring is dumped.
+ */
+#define TRACE_LOG(lvl, ...)                         do                                                          \
+                                                    {                                                           \
+                                                        if ((lvl) <= TRACE_LEVEL)                               \
+                                                        {                                                       \
+                                                            _TRACE_CAT(_TRACE_LOG_, _TRACE_NARGS(__VA_ARGS__))  \
+                                                                ((lvl), __VA_ARGS__);                           \
+                                                        }                                                       \
+                                                    } while (0)
+
+#define TRACE_ERROR(...)                            TRACE_LOG(TRACE_LEVEL_ERROR, __VA_ARGS__)
+#define TRACE_WARN(...)                             TRACE_LOG(TRACE_LEVEL_WARN, __VA_ARGS__)
+#define TRACE_INFO(...)                             TRACE_LOG(TRACE_LEVEL_INFO, __VA_ARGS__)
+#define TRACE_DEBUG(...)                            TRACE_LOG(TRACE_LEVEL_DEBUG, __VA_ARGS__)
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+/**
+ * @brief Callback receiving one formatted line of the trace dump
+ *
+ * @param[in] line Null terminated line, without the line ending
+ */
+typedef void (*trace_log_print_cb)(const char *line);
+
+/**
+ * @brief One trace in the ring. Only the format string pointer and the raw
+ *  arguments are stored, nothing is formatted when the trace is logged.
+ */
+typedef struct
+{
+    uint32_t u32_seq;                               // sequence number + 1 of the trace, 0 while empty or being written
+    const char *p_fmt;                              // format string, in flash
+    uint8_t u8_level;                               // TRACE_LEVEL_*
+    uint8_t u8_nargs;                               // number of valid arguments
+    uintptr_t args[TRACE_LOG_MAX_ARGS];             // raw arguments
+} trace_log_entry_t;
+
+/**********************************************************************************************************
+ * EXPORTED VARIABLES
+ **********************************************************************************************************/
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTION PROTOTYPES
+ **********************************************************************************************************/
+/**
+ * @brief Stores a trace in the ring, the oldest trace is overwritten when the ring is full.
+ *  Safe to call from several tasks, use the TRACE_* macros instead of calling it directly.
+ *
+ * @param[in] u8_level Level of the trace
+ * @param[in] p_fmt printf format string of the trace
+ * @param[in] p_args Arguments of the trace, NULL if there are none
+ * @param[in] u8_nargs Number of arguments
+ */
+void trace_log_write(uint8_t u8_level, const char *p_fmt, const uintptr_t *p_args, uint8_t u8_nargs);
+
+/**
+ * @brief Formats the traces of the ring, oldest first, and passes every line to print_cb.
+ *  The ring is left unchanged.
+ *
+ * @param[in] print_cb Callback receiving the formatted lines
+ *
+ * @return Number of traces dumped
+ */
+uint32_t trace_log_dump(trace_log_print_cb print_cb);
+
+/**
+ * @brief Drops all the traces of the ring.
+ */
+void trace_log_clear(void);
+
+/**
+ * @brief Returns the number of traces logged since the start, including the overwritten ones.
+ */
+uint32_t trace_log_get_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __TRACE_LOG_H__
@@ -0,0 +1,402 @@
+/**
+ * @file uplink_agg.c
+ * @author OXIT embedded firmware team
+ * @brief Packs several application records into one uplink, within the next uplink MTU.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "uplink_agg.h"
+#include <stddef.h>
+#include <string.h>
+
+/******************************************************************************
+ * EXTERN VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ ******************************************************************************/
+/**< Record length byte in front of the record data */
+#define UPLINK_AGG_LEN_FIELD_SIZE       1
+
+/**< Longest LEB128 delta */
+#define UPLINK_AGG_MAX_DELTA_LEN        3
+
+/******************************************************************************
+ * PRIVATE TYPEDEFS
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ ******************************************************************************/
+static uint32_t uplink_agg_delta_s(const uplink_agg_t *p_agg, uint32_t u32_from_ms, uint32_t u32_to_ms);
+static uint8_t uplink_agg_delta_len(uint32_t u32_delta_s);
+static uint8_t uplink_agg_write_delta(uint8_t *p_out, uint32_t u32_delta_s);
+static void uplink_agg_remove_oldest(uplink_agg_t *p_agg, uint8_t u8_count);
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+/**
+ * @brief Seconds between two record times.
+ *
+ * Both times are rounded down to the second relative to the oldest record, so the
+ * deltas of a container add up to the age of every record without drifting.
+ */
+static uint32_t uplink_agg_delta_s(const uplink_agg_t *p_agg, uint32_t u32_from_ms, uint32_t u32_to_ms)
+{
+    uint32_t u32_base_ms = p_agg->records[0].u32_time_ms;
+    uint32_t u32_delta_s = ((u32_to_ms - u32_base_ms) / 1000) - ((u32_from_ms - u32_base_ms) / 1000);
+
+    return (UPLINK_AGG_MAX_DELTA_S < u32_delta_s) ? UPLINK_AGG_MAX_DELTA_S : u32_delta_s;
+}
+
+/**
+ * @brief Number of LEB128 bytes of a delta
+ */
+static uint8_t uplink_agg_delta_len(uint32_t u32_delta_s)
+{
+    if (u32_delta_s < 0x80)
+    {
+        return 1;
+    }
+    return (u32_delta_s < 0x4000) ? 2 : 3;
+}
+
+/**
+ * @brief Writes a delta in LEB128, returns the number of bytes written
+ */
+static uint8_t uplink_agg_write_delta(uint8_t *p_out, uint32_t u32_delta_s)
+{
+    uint8_t u8_len = 0;
+
+    while (u32_delta_s >= 0x80)
+    {
+        p_out[u8_len++] = (uint8_t)(u32_delta_s | 0x80);
+        u32_delta_s >>= 7;
+    }
+    p_out[u8_len++] = (uint8_t)u32_delta_s;
+    return u8_len;
+}
+
+/**
+ * @brief Removes the oldest records and moves the remaining data to the start of the storage
+ */
+static void uplink_agg_remove_oldest(uplink_agg_t *p_agg, uint8_t u8_count)
+{
+    uint16_t u16_removed = 0;
+
+    if (u8_count < p_agg->u8_count)
+    {
+        u16_removed = p_agg->records[u8_count].u16_offset;
+        memmove(p_agg->p_buffer, &p_agg->p_buffer[u16_removed], p_agg->u16_used - u16_removed);
+        memmove(&p_agg->records[0], &p_agg->records[u8_count], (p_agg->u8_count - u8_count) * sizeof(uplink_agg_record_t));
+    }
+    else
+    {
+        u8_count = p_agg->u8_count;
+        u16_removed = p_agg->u16_used;
+    }
+
+    p_agg->u8_count -= u8_count;
+    p_agg->u16_used -= u16_removed;
+    for (uint8_t i = 0; i < p_agg->u8_count; i++)
+    {
+        p_agg->records[i].u16_offset -= u16_removed;
+    }
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+bool uplink_agg_init(uplink_agg_t *p_agg, uint8_t *p_buffer, uint16_t u16_size, uint32_t u32_deadline_ms)
+{
+    bool b_return_value = false;
+
+    do
+    {
+        if ((NULL == p_agg) || (NULL == p_buffer) || (0 == u16_size))
+        {
+            break;
+        }
+
+        p_agg->p_buffer        = p_buffer;
+        p_agg->u16_size        = u16_size;
+        p_agg->u16_used        = 0;
+        p_agg->u8_count        = 0;
+        p_agg->u32_deadline_ms = u32_deadline_ms;
+        p_agg->u32_dropped     = 0;
+        b_return_value = true;
+
+    } while (0);
+
+    return b_return_value;
+}
+
+bool uplink_agg_add(uplink_agg_t *p_agg, const uint8_t *p_data, uint8_t u8_len, uint32_t u32_now_ms)
+{
+    bool b_return_value = false;
+
+    do
+    {
+        if ((NULL == p_agg) || (NULL == p_data) || (0 == u8_len) || (p_agg->u16_size < u8_len))
+        {
+            break;
+        }
+
+        // the newest records are kept, the oldest ones are dropped to make room
+        while ((UPLINK_AGG_MAX_RECORDS <= p_agg->u8_count) || ((p_agg->u16_size - p_agg->u16_used) < u8_len))
+        {
+            uplink_agg_remove_oldest(p_agg, 1);
+            p_agg->u32_dropped++;
+        }
+
+        uplink_agg_record_t *p_record = &p_agg->records[p_agg->u8_count++];
+        p_record->u16_offset  = p_agg->u16_used;
+        p_record->u8_len      = u8_len;
+        p_record->u32_time_ms = u32_now_ms;
+        memcpy(&p_agg->p_buffer[p_agg->u16_used], p_data, u8_len);
+        p_agg->u16_used += u8_len;
+        b_return_value = true;
+
+    } while (0);
+
+    return b_return_value;
+}
+
+bool uplink_agg_fits(uplink_agg_t *p_agg, uint8_t u8_len, uint16_t u16_mtu, uint32_t u32_now_ms)
+{
+    uint32_t u32_size = UPLINK_AGG_HEADER_LEN;
+
+    for (uint8_t i = 0; i < p_agg->u8_count; i++)
+    {
+        uint32_t u32_next_ms = ((i + 1) < p_agg->u8_count) ? p_agg->records[i + 1].u32_time_ms : u32_now_ms;
+        u32_size += UPLINK_AGG_LEN_FIELD_SIZE + p_agg->records[i].u8_len +
+                    uplink_agg_delta_len(uplink_agg_delta_s(p_agg, p_agg->records[i].u32_time_ms, u32_next_ms));
+    }
+
+    // the next record is the last one of the uplink, it may wait until the deadline
+    u32_size += UPLINK_AGG_LEN_FIELD_SIZE + u8_len + uplink_agg_delta_len(p_agg->u32_deadline_ms / 1000);
+    return (u32_size <= u16_mtu) && ((UPLINK_AGG_MAX_RECORDS > p_agg->u8_count));
+}
+
+bool uplink_agg_is_due(uplink_agg_t *p_agg, uint32_t u32_now_ms)
+{
+    return (0 < p_agg->u8_count) && ((u32_now_ms - p_agg->records[0].u32_time_ms) >= p_agg->u32_deadline_ms);
+}
+
+uint16_t uplink_agg_pack(uplink_agg_t *p_agg, uint8_t *p_out, uint16_t u16_mtu, uint32_t u32_now_ms)
+{
+    uint32_t u32_size = UPLINK_AGG_HEADER_LEN;
+    uint8_t u8_packed = 0;
+    uint16_t u16_pos = 0;
+
+    if ((NULL == p_agg) || (NULL == p_out) || (0 == p_agg->u8_count))
+    {
+        return 0;
+    }
+
+    // the last packed record takes its delta up to now, the others up to the next record
+    for (uint8_t i = 0; i < p_agg->u8_count; i++)
+    {
+        const uplink_agg_record_t *p_record = &p_agg->records[i];
+        uint32_t u32_fixed = UPLINK_AGG_LEN_FIELD_SIZE + p_record->u8_len;
+
+        if ((u32_size + u32_fixed + uplink_agg_delta_len(uplink_agg_delta_s(p_agg, p_record->u32_time_ms, u32_now_ms))) > u16_mtu)
+        {
+            break;
+        }
+        u8_packed = i + 1;
+        if (u8_packed < p_agg->u8_count)
+        {
+            u32_size += u32_fixed + uplink_agg_delta_len(uplink_agg_delta_s(p_agg, p_record->u32_time_ms, p_agg->records[i + 1].u32_time_ms));
+        }
+    }
+
+    if (0 == u8_packed)
+    {
+        return 0;
+    }
+
+    p_out[u16_pos++] = UPLINK_AGG_FORMAT_VERSION;
+    for (uint8_t i = 0; i < u8_packed; i++)
+    {
+        const uplink_agg_record_t *p_record = &p_agg->records[i];
+        uint32_t u32_next_ms = ((i + 1) < u8_packed) ? p_agg->records[i + 1].u32_time_ms : u32_now_ms;
+
+        p_out[u16_pos++] = p_record->u8_len;
+        u16_pos += uplink_agg_write_delta(&p_out[u16_pos], uplink_agg_delta_s(p_agg, p_record->u32_time_ms, u32_next_ms));
+        memcpy(&p_out[u16_pos], &p_agg->p_buffer[p_record->u16_offset], p_record->u8_len);
+        u16_pos += p_record->u8_len;
+    }
+
+    uplink_agg_remove_oldest(p_agg, u8_packed);
+    return u16_pos;
+}
+
+int16_t uplink_agg_unpack(const uint8_t *p_data, uint16_t u16_len, uplink_agg_record_cb record_cb, void *p_context)
+{
+    uint32_t u32_total_s = 0;
+    int16_t i16_count = 0;
+    uint16_t u16_pos = UPLINK_AGG_HEADER_LEN;
+
+    if ((NULL == p_data) || (UPLINK_AGG_HEADER_LEN > u16_len) || (UPLINK_AGG_FORMAT_VERSION != p_data[0]))
+    {
+        return -1;
+    }
+
+    // first pass validates the container and adds up the deltas
+    while (u16_pos < u16_len)
+    {
+        uint8_t u8_len = p_data[u16_pos++];
+        uint32_t u32_delta_s = 0;
+        uint8_t u8_shift = 0;
+
+        if (0 == u8_len)
+        {
+            return -1;
+        }
+        do
+        {
+            if ((u16_pos >= u16_len) || ((UPLINK_AGG_MAX_DELTA_LEN * 7) <= u8_shift))
+            {
+                return -1;
+            }
+            u32_delta_s |= (uint32_t)(p_data[u16_pos] & 0x7F) << u8_shift;
+            u8_shift += 7;
+        } while (p_data[u16_pos++] & 0x80);
+
+        if ((u16_len - u16_pos) < u8_len)
+        {
+            return -1;
+        }
+        u16_pos += u8_len;
+        u32_total_s += u32_delta_s;
+        i16_count++;
+    }
+
+    if (NULL == record_cb)
+    {
+        return i16_count;
+    }
+
+    // second pass hands the records over with their age
+    u16_pos = UPLINK_AGG_HEADER_LEN;
+    while (u16_pos < u16_len)
+    {
+        uint8_t u8_len = p_data[u16_pos++];
+        uint32_t u32_delta_s = 0;
+        uint8_t u8_shift = 0;
+
+        do
+        {
+            u32_delta_s |= (uint32_t)(p_data[u16_pos] & 0x7F) << u8_shift;
+            u8_shift += 7;
+        } while (p_data[u16_pos++] & 0x80);
+
+        record_cb(&p_data[u16_pos], u8_len, u32_total_s, p_context);
+        u32_total_s -= u32_delta_s;
+        u16_pos += u8_len;
+    }
+
+    return i16_count;
+}
+
+uint16_t uplink_agg_add_age(const uint8_t *p_in, uint16_t u16_len, uint32_t u32_extra_s, uint8_t *p_out, uint16_t u16_size)
+{
+    uint16_t u16_pos = UPLINK_AGG_HEADER_LEN;
+    uint16_t u16_out = UPLINK_AGG_HEADER_LEN;
+
+    if ((NULL == p_out) || (UPLINK_AGG_HEADER_LEN > u16_size) || (0 >= uplink_agg_unpack(p_in, u16_len, NULL, NULL)))
+    {
+        return 0;
+    }
+
+    p_out[0] = p_in[0];
+    while (u16_pos < u16_len)
+    {
+        uint8_t u8_len = p_in[u16_pos++];
+        uint32_t u32_delta_s = 0;
+        uint8_t u8_shift = 0;
+
+        do
+        {
+            u32_delta_s |= (uint32_t)(p_in[u16_pos] & 0x7F) << u8_shift;
+            u8_shift += 7;
+        } while (p_in[u16_pos++] & 0x80);
+
+        // only the delta of the last record runs up to the uplink
+        if ((u16_pos + u8_len) == u16_len)
+        {
+            u32_delta_s = ((UPLINK_AGG_MAX_DELTA_S - u32_delta_s) < u32_extra_s) ? UPLINK_AGG_MAX_DELTA_S : (u32_delta_s + u32_extra_s);
+        }
+
+        if ((u16_size - u16_out) < (UPLINK_AGG_LEN_FIELD_SIZE + uplink_agg_delta_len(u32_delta_s) + u8_len))
+        {
+            return 0;
+        }
+        p_out[u16_out++] = u8_len;
+        u16_out += uplink_agg_write_delta(&p_out[u16_out], u32_delta_s);
+        memcpy(&p_out[u16_out], &p_in[u16_pos], u8_len);
+        u16_out += u8_len;
+        u16_pos += u8_len;
+    }
+
+    return u16_out;
+}
+
+uint8_t uplink_agg_get_count(uplink_agg_t *p_agg)
+{
+    return p_agg->u8_count;
+}
+
+uint32_t uplink_agg_get_dropped_count(uplink_agg_t *p_agg)
+{
+    return p_agg->u32_dropped;
+}
@@ -0,0 +1,237 @@
+/**
+ * @file uplink_agg.h
+ * @author OXIT embedded firmware team
+ * @brief Packs several application records into one uplink, within the next uplink MTU.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+#ifndef __UPLINK_AGG_H__
+#define __UPLINK_AGG_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+/**
+ * @brief First byte of every container, changes when the layout changes.
+ *
+ * Container layout:
+ *  [version] then for every record, oldest first: [len][delta][data, len bytes]
+ *  delta is the number of seconds between the record and the next one, for the last
+ *  record between the record and the uplink. It is an unsigned LEB128 value, 7 bits
+ *  per byte, bit 7 set when another byte follows. The age of a record is the sum of
+ *  its delta and of the deltas of the records after it.
+ */
+#define UPLINK_AGG_FORMAT_VERSION       (0x01)
+
+/**
+ * @brief Size of the container header
+ */
+#define UPLINK_AGG_HEADER_LEN           (1)
+
+/**
+ * @brief Number of records that can wait for the next uplink.
+ */
+#define UPLINK_AGG_MAX_RECORDS          (64)
+
+/**
+ * @brief Largest delta, longer gaps are saturated. Fits in 3 LEB128 bytes, about 24 days.
+ */
+#define UPLINK_AGG_MAX_DELTA_S          (0x1FFFFF)
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+/**
+ * @brief Record waiting in the aggregator
+ */
+typedef struct
+{
+    uint16_t u16_offset;                                // position of the data in p_buffer
+    uint8_t u8_len;
+    uint32_t u32_time_ms;                               // time of the record, in the clock passed to the functions
+} uplink_agg_record_t;
+
+/**
+ * @brief Context of the aggregator.
+ *
+ * The record data is kept back to back in the storage given at init, oldest first.
+ * The members are private, use the uplink_agg_* functions to access them.
+ */
+typedef struct
+{
+    uint8_t *p_buffer;                                  // record data, u16_size bytes
+    uint16_t u16_size;
+    uint16_t u16_used;                                  // bytes of p_buffer holding records
+    uint8_t u8_count;                                   // records waiting
+    uint32_t u32_deadline_ms;                           // longest time a record waits for an uplink
+    uint32_t u32_dropped;                               // oldest records dropped to make room
+    uplink_agg_record_t records[UPLINK_AGG_MAX_RECORDS];
+} uplink_agg_t;
+
+/**
+ * @brief Called by uplink_agg_unpack() for every record of a container, oldest first.
+ *
+ * @param[in] p_data Record data
+ * @param[in] u8_len Length of the record data
+ * @param[in] u32_age_s Seconds between the record and the uplink
+ * @param[in] p_context Context given to uplink_agg_unpack()
+ */
+typedef void (*uplink_agg_record_cb)(const uint8_t *p_data, uint8_t u8_len, uint32_t u32_age_s, void *p_context);
+
+/**********************************************************************************************************
+ * EXPORTED VARIABLES
+ **********************************************************************************************************/
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTION PROTOTYPES
+ **********************************************************************************************************/
+/**
+ * @brief Initializes the aggregator on the given storage, no record is waiting afterwards.
+ *
+ * @param[in,out] p_agg Pointer to the aggregator context
+ * @param[in] p_buffer Storage of the record data
+ * @param[in] u16_size Size of the storage
+ * @param[in] u32_deadline_ms Longest time a record should wait for an uplink
+ *
+ * @retval true The aggregator is initialized
+ * @retval false Invalid parameters
+ */
+bool uplink_agg_init(uplink_agg_t *p_agg, uint8_t *p_buffer, uint16_t u16_size, uint32_t u32_deadline_ms);
+
+/**
+ * @brief Adds a record. When the storage is full the oldest records are dropped
+ *  to make room, see uplink_agg_get_dropped_count().
+ *
+ * @param[in,out] p_agg Pointer to the aggregator context
+ * @param[in] p_data Record data, copied
+ * @param[in] u8_len Length of the record data, 1 to 255
+ * @param[in] u32_now_ms Current time
+ *
+ * @retval true The record is waiting for the next uplink
+ * @retval false Invalid parameters or record larger than the storage
+ */
+bool uplink_agg_add(uplink_agg_t *p_agg, const uint8_t *p_data, uint8_t u8_len, uint32_t u32_now_ms);
+
+/**
+ * @brief Tells whether one more record still fits in a single uplink with the waiting ones.
+ *  The delta of the last record is counted for a flush at the deadline.
+ *
+ * @param[in] p_agg Pointer to the aggregator context
+ * @param[in] u8_len Length of the next record
+ * @param[in] u16_mtu Next uplink MTU
+ * @param[in] u32_now_ms Current time
+ *
+ * @return true if the waiting records and the next one can be sent in one uplink
+ */
+bool uplink_agg_fits(uplink_agg_t *p_agg, uint8_t u8_len, uint16_t u16_mtu, uint32_t u32_now_ms);
+
+/**
+ * @brief Tells whether the oldest waiting record reached the deadline.
+ *
+ * @param[in] p_agg Pointer to the aggregator context
+ * @param[in] u32_now_ms Current time
+ *
+ * @return true if an uplink should be sent now
+ */
+bool uplink_agg_is_due(uplink_agg_t *p_agg, uint32_t u32_now_ms);
+
+/**
+ * @brief Packs the oldest waiting records into a container and removes them from the aggregator.
+ *  The records which do not fit in the MTU stay for the next uplink.
+ *
+ * @param[in,out] p_agg Pointer to the aggregator context
+ * @param[out] p_out Destination of the container, at least u16_mtu bytes
+ * @param[in] u16_mtu Next uplink MTU
+ * @param[in] u32_now_ms Current time, used for the delta of the last packed record
+ *
+ * @return Length of the container, 0 if no record is waiting or the oldest does not fit
+ */
+uint16_t uplink_agg_pack(uplink_agg_t *p_agg, uint8_t *p_out, uint16_t u16_mtu, uint32_t u32_now_ms);
+
+/**
+ * @brief Decodes a container, for the receiving side and for checks on the host.
+ *
+ * @param[in] p_data Container
+ * @param[in] u16_len Length of the container
+ * @param[in] record_cb Called for every record, oldest first, NULL to only validate
+ * @param[in] p_context Passed to record_cb
+ *
+ * @return Number of records, -1 if the container is malformed. record_cb is only
+ *  called once the whole container has been validated.
+ */
+int16_t uplink_agg_unpack(const uint8_t *p_data, uint16_t u16_len, uplink_agg_record_cb record_cb, void *p_context);
+
+/**
+ * @brief Copies a container adding time to the age of every record, for a container sent
+ *  later than packed. The last delta grows, the container may get up to 2 bytes longer.
+ *
+ * @param[in] p_in Container
+ * @param[in] u16_len Length of the container
+ * @param[in] u32_extra_s Seconds between the pack and the uplink
+ * @param[out] p_out Destination of the new container, not overlapping p_in
+ * @param[in] u16_size Size of the destination
+ *
+ * @return Length of the new container, 0 if the container is malformed or the destination too small
+ */
+uint16_t uplink_agg_add_age(const uint8_t *p_in, uint16_t u16_len, uint32_t u32_extra_s, uint8_t *p_out, uint16_t u16_size);
+
+/**
+ * @brief Returns the number of records waiting for an uplink.
+ */
+uint8_t uplink_agg_get_count(uplink_agg_t *p_agg);
+
+/**
+ * @brief Returns the number of records dropped because the storage was full.
+ */
+uint32_t uplink_agg_get_dropped_count(uplink_agg_t *p_agg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __UPLINK_AGG_H__
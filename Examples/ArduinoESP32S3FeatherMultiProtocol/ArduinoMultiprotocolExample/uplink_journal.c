@@ -0,0 +1,430 @@
+/**
+ * @file uplink_journal.c
+ * @author OXIT embedded firmware team
+ * @brief Append only journal of the uplinks that could not be sent, replayed once the link is back.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "uplink_journal.h"
+#include "checksum.h"
+#include <stddef.h>
+#include <string.h>
+
+/******************************************************************************
+ * EXTERN VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ ******************************************************************************/
+/**< Bytes read at once while checking the crc of an entry */
+#define UPLINK_JOURNAL_READ_CHUNK           64
+
+/**< Payload of a checkpoint entry */
+#define UPLINK_JOURNAL_CHECKPOINT_LEN       4
+
+/******************************************************************************
+ * PRIVATE TYPEDEFS
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ ******************************************************************************/
+static bool uplink_journal_read_entry(uplink_journal_t *p_journal, uint32_t u32_offset, uint8_t *p_type, uint16_t *p_len,
+                                      uint8_t *p_payload, uint16_t u16_size);
+static bool uplink_journal_find_entry(uplink_journal_t *p_journal, uint32_t u32_offset, uint32_t *p_found, uint8_t *p_type,
+                                      uint16_t *p_len, uint8_t *p_payload, uint16_t u16_size);
+static bool uplink_journal_write_entry(uplink_journal_t *p_journal, uint8_t u8_type, const uint8_t *p_payload, uint16_t u16_len);
+static bool uplink_journal_write_checkpoint(uplink_journal_t *p_journal);
+static void uplink_journal_reset(uplink_journal_t *p_journal);
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+/**
+ * @brief Checks the entry at an offset, the payload is copied when it fits in u16_size
+ *
+ * @return true if a complete entry is at the offset
+ */
+static bool uplink_journal_read_entry(uplink_journal_t *p_journal, uint32_t u32_offset, uint8_t *p_type, uint16_t *p_len,
+                                      uint8_t *p_payload, uint16_t u16_size)
+{
+    const uplink_journal_storage_t *p_storage = p_journal->p_storage;
+    uint8_t au8_chunk[UPLINK_JOURNAL_READ_CHUNK];
+    uint16_t u16_crc = CHECKSUM_CRC16_CCITT_INIT;
+    uint16_t u16_len = 0;
+    uint16_t u16_done = 0;
+
+    if ((u32_offset + UPLINK_JOURNAL_HEADER_LEN + UPLINK_JOURNAL_CRC_LEN) > p_journal->u32_size)
+    {
+        return false;
+    }
+    if (UPLINK_JOURNAL_HEADER_LEN != p_storage->read(p_storage->p_context, u32_offset, au8_chunk, UPLINK_JOURNAL_HEADER_LEN))
+    {
+        return false;
+    }
+
+    u16_len = ((uint16_t)au8_chunk[2] << 8) | au8_chunk[3];
+    if ((UPLINK_JOURNAL_MAGIC != au8_chunk[0]) ||
+        ((UPLINK_JOURNAL_TYPE_DATA != au8_chunk[1]) && (UPLINK_JOURNAL_TYPE_CHECKPOINT != au8_chunk[1])) ||
+        (0 == u16_len) || (UPLINK_JOURNAL_MAX_RECORD_SIZE < u16_len) ||
+        ((u32_offset + UPLINK_JOURNAL_HEADER_LEN + u16_len + UPLINK_JOURNAL_CRC_LEN) > p_journal->u32_size))
+    {
+        return false;
+    }
+    *p_type = au8_chunk[1];
+    u16_crc = checksum_crc16_ccitt(u16_crc, &au8_chunk[1], UPLINK_JOURNAL_HEADER_LEN - 1);
+    u32_offset += UPLINK_JOURNAL_HEADER_LEN;
+
+    while (u16_done < u16_len)
+    {
+        uint16_t u16_chunk = u16_len - u16_done;
+        if (u16_chunk > sizeof(au8_chunk))
+        {
+            u16_chunk = sizeof(au8_chunk);
+        }
+        if (u16_chunk != p_storage->read(p_storage->p_context, u32_offset + u16_done, au8_chunk, u16_chunk))
+        {
+            return false;
+        }
+        u16_crc = checksum_crc16_ccitt(u16_crc, au8_chunk, u16_chunk);
+        if ((NULL != p_payload) && (u16_len <= u16_size))
+        {
+            memcpy(&p_payload[u16_done], au8_chunk, u16_chunk);
+        }
+        u16_done += u16_chunk;
+    }
+
+    if (UPLINK_JOURNAL_CRC_LEN != p_storage->read(p_storage->p_context, u32_offset + u16_len, au8_chunk, UPLINK_JOURNAL_CRC_LEN))
+    {
+        return false;
+    }
+    if (u16_crc != (((uint16_t)au8_chunk[0] << 8) | au8_chunk[1]))
+    {
+        return false;
+    }
+
+    *p_len = u16_len;
+    return true;
+}
+
+/**
+ * @brief Finds the first complete entry at or after an offset.
+ *  Past a torn entry the scan resyncs on the next magic byte, read a chunk at a time.
+ */
+static bool uplink_journal_find_entry(uplink_journal_t *p_journal, uint32_t u32_offset, uint32_t *p_found, uint8_t *p_type,
+                                      uint16_t *p_len, uint8_t *p_payload, uint16_t u16_size)
+{
+    const uplink_journal_storage_t *p_storage = p_journal->p_storage;
+    uint8_t au8_chunk[UPLINK_JOURNAL_READ_CHUNK];
+
+    while ((u32_offset + UPLINK_JOURNAL_HEADER_LEN + UPLINK_JOURNAL_CRC_LEN) <= p_journal->u32_size)
+    {
+        const uint8_t *p_magic = NULL;
+        uint16_t u16_chunk = sizeof(au8_chunk);
+
+        if (uplink_journal_read_entry(p_journal, u32_offset, p_type, p_len, p_payload, u16_size))
+        {
+            *p_found = u32_offset;
+            return true;
+        }
+
+        u32_offset++;
+        while (NULL == p_magic)
+        {
+            if ((u32_offset + UPLINK_JOURNAL_HEADER_LEN + UPLINK_JOURNAL_CRC_LEN) > p_journal->u32_size)
+            {
+                return false;
+            }
+            if ((p_journal->u32_size - u32_offset) < u16_chunk)
+            {
+                u16_chunk = (uint16_t)(p_journal->u32_size - u32_offset);
+            }
+            u16_chunk = p_storage->read(p_storage->p_context, u32_offset, au8_chunk, u16_chunk);
+            if (0 == u16_chunk)
+            {
+                return false;
+            }
+            p_magic = (const uint8_t *)memchr(au8_chunk, UPLINK_JOURNAL_MAGIC, u16_chunk);
+            u32_offset += (NULL == p_magic) ? u16_chunk : (uint32_t)(p_magic - au8_chunk);
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Appends an entry in a single write
+ */
+static bool uplink_journal_write_entry(uplink_journal_t *p_journal, uint8_t u8_type, const uint8_t *p_payload, uint16_t u16_len)
+{
+    const uplink_journal_storage_t *p_storage = p_journal->p_storage;
+    uint8_t au8_entry[UPLINK_JOURNAL_HEADER_LEN + UPLINK_JOURNAL_MAX_RECORD_SIZE + UPLINK_JOURNAL_CRC_LEN];
+    uint16_t u16_entry_len = UPLINK_JOURNAL_HEADER_LEN + u16_len + UPLINK_JOURNAL_CRC_LEN;
+    uint16_t u16_crc = 0;
+
+    if ((p_journal->u32_size + u16_entry_len) > p_journal->u32_max_size)
+    {
+        return false;
+    }
+
+    au8_entry[0] = UPLINK_JOURNAL_MAGIC;
+    au8_entry[1] = u8_type;
+    au8_entry[2] = (uint8_t)(u16_len >> 8);
+    au8_entry[3] = (uint8_t)u16_len;
+    memcpy(&au8_entry[UPLINK_JOURNAL_HEADER_LEN], p_payload, u16_len);
+    u16_crc = checksum_crc16_ccitt(CHECKSUM_CRC16_CCITT_INIT, &au8_entry[1], UPLINK_JOURNAL_HEADER_LEN - 1 + u16_len);
+    au8_entry[UPLINK_JOURNAL_HEADER_LEN + u16_len] = (uint8_t)(u16_crc >> 8);
+    au8_entry[UPLINK_JOURNAL_HEADER_LEN + u16_len + 1] = (uint8_t)u16_crc;
+
+    if (false == p_storage->append(p_storage->p_context, au8_entry, u16_entry_len))
+    {
+        // part of the entry may have been written, the scan skips it
+        p_journal->u32_size = p_storage->size(p_storage->p_context);
+        return false;
+    }
+    p_journal->u32_size += u16_entry_len;
+    p_journal->u32_bytes_written += u16_entry_len;
+    return true;
+}
+
+static bool uplink_journal_write_checkpoint(uplink_journal_t *p_journal)
+{
+    uint8_t au8_checkpoint[UPLINK_JOURNAL_CHECKPOINT_LEN];
+
+    au8_checkpoint[0] = (uint8_t)(p_journal->u32_forwarded >> 24);
+    au8_checkpoint[1] = (uint8_t)(p_journal->u32_forwarded >> 16);
+    au8_checkpoint[2] = (uint8_t)(p_journal->u32_forwarded >> 8);
+    au8_checkpoint[3] = (uint8_t)p_journal->u32_forwarded;
+    if (false == uplink_journal_write_entry(p_journal, UPLINK_JOURNAL_TYPE_CHECKPOINT, au8_checkpoint, sizeof(au8_checkpoint)))
+    {
+        return false;
+    }
+    p_journal->u32_checkpointed = p_journal->u32_forwarded;
+    return true;
+}
+
+/**
+ * @brief Empties the journal once every entry is forwarded
+ */
+static void uplink_journal_reset(uplink_journal_t *p_journal)
+{
+    p_journal->u32_size = 0;
+    p_journal->u32_record_count = 0;
+    p_journal->u32_forwarded = 0;
+    p_journal->u32_checkpointed = 0;
+    p_journal->u32_read_offset = 0;
+    p_journal->u32_next_offset = 0;
+    p_journal->b_peeked = false;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+bool uplink_journal_open(uplink_journal_t *p_journal, const uplink_journal_storage_t *p_storage, uint32_t u32_max_size)
+{
+    uint8_t au8_checkpoint[UPLINK_JOURNAL_CHECKPOINT_LEN];
+    uint32_t u32_offset = 0;
+    uint32_t u32_found = 0;
+    uint32_t u32_index = 0;
+    uint8_t u8_type = 0;
+    uint16_t u16_len = 0;
+
+    if ((NULL == p_journal) || (NULL == p_storage) || (NULL == p_storage->read) || (NULL == p_storage->append) ||
+        (NULL == p_storage->erase) || (NULL == p_storage->size))
+    {
+        return false;
+    }
+
+    memset(p_journal, 0, sizeof(uplink_journal_t));
+    p_journal->p_storage = p_storage;
+    p_journal->u32_max_size = u32_max_size;
+    p_journal->u32_size = p_storage->size(p_storage->p_context);
+
+    // count the data entries, the last checkpoint tells how many are forwarded
+    while (uplink_journal_find_entry(p_journal, u32_offset, &u32_found, &u8_type, &u16_len, au8_checkpoint, sizeof(au8_checkpoint)))
+    {
+        if (UPLINK_JOURNAL_TYPE_DATA == u8_type)
+        {
+            p_journal->u32_record_count++;
+        }
+        else if (UPLINK_JOURNAL_CHECKPOINT_LEN == u16_len)
+        {
+            p_journal->u32_forwarded = ((uint32_t)au8_checkpoint[0] << 24) | ((uint32_t)au8_checkpoint[1] << 16) |
+                                       ((uint32_t)au8_checkpoint[2] << 8) | au8_checkpoint[3];
+        }
+        u32_offset = u32_found + UPLINK_JOURNAL_HEADER_LEN + u16_len + UPLINK_JOURNAL_CRC_LEN;
+    }
+
+    if (p_journal->u32_forwarded > p_journal->u32_record_count)
+    {
+        p_journal->u32_forwarded = p_journal->u32_record_count;
+    }
+    p_journal->u32_checkpointed = p_journal->u32_forwarded;
+
+    if ((0 != p_journal->u32_size) && (p_journal->u32_forwarded == p_journal->u32_record_count))
+    {
+        p_storage->erase(p_storage->p_context);
+        uplink_journal_reset(p_journal);
+        p_journal->u32_size = p_storage->size(p_storage->p_context);
+        return true;
+    }
+
+    // the replay starts after the forwarded data entries
+    u32_offset = 0;
+    while ((u32_index < p_journal->u32_forwarded) &&
+           uplink_journal_find_entry(p_journal, u32_offset, &u32_found, &u8_type, &u16_len, NULL, 0))
+    {
+        u32_offset = u32_found + UPLINK_JOURNAL_HEADER_LEN + u16_len + UPLINK_JOURNAL_CRC_LEN;
+        if (UPLINK_JOURNAL_TYPE_DATA == u8_type)
+        {
+            u32_index++;
+        }
+    }
+    p_journal->u32_read_offset = u32_offset;
+    return true;
+}
+
+bool uplink_journal_append(uplink_journal_t *p_journal, const uint8_t *p_data, uint16_t u16_len)
+{
+    if ((NULL == p_journal) || (NULL == p_journal->p_storage) || (NULL == p_data) ||
+        (0 == u16_len) || (UPLINK_JOURNAL_MAX_RECORD_SIZE < u16_len))
+    {
+        return false;
+    }
+
+    if (false == uplink_journal_write_entry(p_journal, UPLINK_JOURNAL_TYPE_DATA, p_data, u16_len))
+    {
+        p_journal->u32_dropped++;
+        return false;
+    }
+    p_journal->u32_record_count++;
+    return true;
+}
+
+bool uplink_journal_peek(uplink_journal_t *p_journal, uint8_t *p_data, uint16_t u16_size, uint16_t *p_len)
+{
+    uint32_t u32_offset = 0;
+    uint32_t u32_found = 0;
+    uint8_t u8_type = 0;
+    uint16_t u16_len = 0;
+
+    if ((NULL == p_journal) || (NULL == p_journal->p_storage) || (NULL == p_data) || (NULL == p_len) ||
+        (p_journal->u32_forwarded >= p_journal->u32_record_count))
+    {
+        return false;
+    }
+
+    u32_offset = p_journal->u32_read_offset;
+    while (uplink_journal_find_entry(p_journal, u32_offset, &u32_found, &u8_type, &u16_len, p_data, u16_size))
+    {
+        u32_offset = u32_found + UPLINK_JOURNAL_HEADER_LEN + u16_len + UPLINK_JOURNAL_CRC_LEN;
+        if (UPLINK_JOURNAL_TYPE_DATA != u8_type)
+        {
+            continue;
+        }
+        if (u16_len > u16_size)
+        {
+            return false;
+        }
+
+        p_journal->u32_read_offset = u32_found;
+        p_journal->u32_next_offset = u32_offset;
+        p_journal->b_peeked = true;
+        *p_len = u16_len;
+        return true;
+    }
+    return false;
+}
+
+bool uplink_journal_commit(uplink_journal_t *p_journal)
+{
+    const uplink_journal_storage_t *p_storage = NULL;
+
+    if ((NULL == p_journal) || (false == p_journal->b_peeked))
+    {
+        return false;
+    }
+
+    p_storage = p_journal->p_storage;
+    p_journal->b_peeked = false;
+    p_journal->u32_forwarded++;
+    p_journal->u32_read_offset = p_journal->u32_next_offset;
+
+    if (p_journal->u32_forwarded == p_journal->u32_record_count)
+    {
+        if (p_storage->erase(p_storage->p_context))
+        {
+            uplink_journal_reset(p_journal);
+            return true;
+        }
+        // the journal stays, the checkpoint tells that everything is forwarded
+        return uplink_journal_write_checkpoint(p_journal);
+    }
+
+    if ((p_journal->u32_forwarded - p_journal->u32_checkpointed) >= UPLINK_JOURNAL_CHECKPOINT_INTERVAL)
+    {
+        return uplink_journal_write_checkpoint(p_journal);
+    }
+    return true;
+}
+
+uint32_t uplink_journal_get_pending_count(const uplink_journal_t *p_journal)
+{
+    return p_journal->u32_record_count - p_journal->u32_forwarded;
+}
+
+uint32_t uplink_journal_get_dropped_count(const uplink_journal_t *p_journal)
+{
+    return p_journal->u32_dropped;
+}
+
+uint32_t uplink_journal_get_bytes_written(const uplink_journal_t *p_journal)
+{
+    return p_journal->u32_bytes_written;
+}
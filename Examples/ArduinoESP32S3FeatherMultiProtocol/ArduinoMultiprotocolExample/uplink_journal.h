@@ -0,0 +1,204 @@
+/**
+ * @file uplink_journal.h
+ * @author OXIT embedded firmware team
+ * @brief Append only journal of the uplinks that could not be sent, replayed once the link is back.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+#ifndef __UPLINK_JOURNAL_H__
+#define __UPLINK_JOURNAL_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+/**
+ * @brief First byte of every journal entry.
+ *
+ * Entry layout:
+ *  [magic][type][len msb][len lsb][payload, len bytes][crc16 msb][crc16 lsb]
+ *  The crc16 (CCITT) covers the type, the length and the payload. A data entry holds an
+ *  uplink, a checkpoint entry the number of data entries forwarded so far, 4 bytes msb first.
+ *  An entry only counts once it is completely written, the entries torn by a reset are
+ *  skipped by the scan at open.
+ */
+#define UPLINK_JOURNAL_MAGIC                (0xA5)
+
+/**
+ * @brief Entry types
+ */
+#define UPLINK_JOURNAL_TYPE_DATA            (0x01)
+#define UPLINK_JOURNAL_TYPE_CHECKPOINT      (0x02)
+
+/**
+ * @brief Bytes added to the payload of an entry
+ */
+#define UPLINK_JOURNAL_HEADER_LEN           (4)
+#define UPLINK_JOURNAL_CRC_LEN              (2)
+
+/**
+ * @brief Largest payload of a data entry
+ */
+#define UPLINK_JOURNAL_MAX_RECORD_SIZE      (384)
+
+/**
+ * @brief Number of forwarded data entries between two checkpoints.
+ * After a reset at most this number minus one entries are replayed twice.
+ */
+#define UPLINK_JOURNAL_CHECKPOINT_INTERVAL  (1)
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+/**
+ * @brief Access to the file holding the journal
+ */
+typedef struct
+{
+    uint16_t (*read)(void *p_context, uint32_t u32_offset, uint8_t *p_buf, uint16_t u16_len);  // bytes read
+    bool (*append)(void *p_context, const uint8_t *p_buf, uint16_t u16_len);                 // written and flushed once it returns
+    bool (*erase)(void *p_context);                                                          // removes the whole journal
+    uint32_t (*size)(void *p_context);
+    void *p_context;
+} uplink_journal_storage_t;
+
+/**
+ * @brief Context of the journal.
+ *
+ * The members are private, use the uplink_journal_* functions to access them.
+ */
+typedef struct
+{
+    const uplink_journal_storage_t *p_storage;
+    uint32_t u32_max_size;                              // appends beyond are refused
+    uint32_t u32_size;                                  // size of the file
+    uint32_t u32_record_count;                          // data entries in the journal
+    uint32_t u32_forwarded;                             // data entries forwarded, the oldest first
+    uint32_t u32_checkpointed;                          // u32_forwarded at the last checkpoint
+    uint32_t u32_read_offset;                           // where to look for the next data entry to replay
+    uint32_t u32_next_offset;                           // after the entry given by the last peek
+    bool b_peeked;                                      // an entry has been given by peek and not committed
+    uint32_t u32_dropped;                               // appends refused, journal full or storage error
+    uint32_t u32_bytes_written;                         // bytes appended since open
+} uplink_journal_t;
+
+/**********************************************************************************************************
+ * EXPORTED VARIABLES
+ **********************************************************************************************************/
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTION PROTOTYPES
+ **********************************************************************************************************/
+/**
+ * @brief Opens the journal: scans the file for the complete entries and the last checkpoint.
+ *  A journal with every entry forwarded is erased.
+ *
+ * @param[in,out] p_journal Pointer to the journal context
+ * @param[in] p_storage Access to the file, kept by the journal
+ * @param[in] u32_max_size Largest size of the file
+ *
+ * @retval true The journal is open
+ * @retval false Invalid parameters
+ */
+bool uplink_journal_open(uplink_journal_t *p_journal, const uplink_journal_storage_t *p_storage, uint32_t u32_max_size);
+
+/**
+ * @brief Appends an uplink to the journal.
+ *
+ * @param[in,out] p_journal Pointer to the journal context
+ * @param[in] p_data Uplink
+ * @param[in] u16_len Length of the uplink, 1 to UPLINK_JOURNAL_MAX_RECORD_SIZE
+ *
+ * @retval true The uplink is in the journal
+ * @retval false Invalid parameters, journal full or storage error
+ */
+bool uplink_journal_append(uplink_journal_t *p_journal, const uint8_t *p_data, uint16_t u16_len);
+
+/**
+ * @brief Reads the oldest uplink not yet forwarded, it stays in the journal until uplink_journal_commit().
+ *
+ * @param[in,out] p_journal Pointer to the journal context
+ * @param[out] p_data Destination of the uplink
+ * @param[in] u16_size Size of the destination
+ * @param[out] p_len Length of the uplink
+ *
+ * @retval true An uplink has been read
+ * @retval false No uplink left or destination too small
+ */
+bool uplink_journal_peek(uplink_journal_t *p_journal, uint8_t *p_data, uint16_t u16_size, uint16_t *p_len);
+
+/**
+ * @brief Marks the uplink given by the last uplink_journal_peek() as forwarded.
+ *  The journal is erased once every uplink is forwarded.
+ *
+ * @param[in,out] p_journal Pointer to the journal context
+ *
+ * @retval true The uplink will not be replayed
+ * @retval false No uplink peeked or storage error, the uplink will be replayed
+ */
+bool uplink_journal_commit(uplink_journal_t *p_journal);
+
+/**
+ * @brief Number of uplinks not yet forwarded
+ */
+uint32_t uplink_journal_get_pending_count(const uplink_journal_t *p_journal);
+
+/**
+ * @brief Number of uplinks refused since open
+ */
+uint32_t uplink_journal_get_dropped_count(const uplink_journal_t *p_journal);
+
+/**
+ * @brief Number of bytes written to the storage since open
+ */
+uint32_t uplink_journal_get_bytes_written(const uplink_journal_t *p_journal);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __UPLINK_JOURNAL_H__
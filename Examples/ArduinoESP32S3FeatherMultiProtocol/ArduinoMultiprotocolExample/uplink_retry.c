@@ -0,0 +1,242 @@
+/**
+ * @file uplink_retry.c
+ * @author OXIT embedded firmware team
+ * @brief Retries of the uplink in flight with exponential backoff and jitter, until a final result.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "uplink_retry.h"
+#include <stddef.h>
+#include <string.h>
+
+/******************************************************************************
+ * EXTERN VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ ******************************************************************************/
+
+/******************************************************************************
+ * PRIVATE TYPEDEFS
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ ******************************************************************************/
+static uint32_t uplink_retry_random(uplink_retry_t *p_retry);
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+/**
+ * @brief xorshift32, enough to spread the retries of several devices
+ */
+static uint32_t uplink_retry_random(uplink_retry_t *p_retry)
+{
+    uint32_t u32_x = p_retry->u32_random;
+
+    u32_x ^= u32_x << 13;
+    u32_x ^= u32_x >> 17;
+    u32_x ^= u32_x << 5;
+    p_retry->u32_random = u32_x;
+    return u32_x;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+void uplink_retry_init(uplink_retry_t *p_retry, uint32_t u32_seed)
+{
+    if (NULL == p_retry)
+    {
+        return;
+    }
+    memset(p_retry, 0, sizeof(uplink_retry_t));
+    p_retry->state = UPLINK_RETRY_IDLE;
+    // xorshift stays at 0 from a 0 seed
+    p_retry->u32_random = (0 != u32_seed) ? u32_seed : 0x9E3779B9UL;
+}
+
+bool uplink_retry_start(uplink_retry_t *p_retry, const uplink_retry_policy_t *p_policy, uint32_t u32_msg_id, uint8_t u8_class,
+                        uint8_t u8_port, bool b_confirmed, const uint8_t *p_data, uint16_t u16_len)
+{
+    if ((NULL == p_retry) || (NULL == p_policy) || (NULL == p_data) || (0 == u16_len) ||
+        (UPLINK_RETRY_MAX_PAYLOAD_SIZE < u16_len) || (UPLINK_RETRY_IDLE != p_retry->state))
+    {
+        return false;
+    }
+
+    memcpy(p_retry->data, p_data, u16_len);
+    p_retry->u16_len = u16_len;
+    p_retry->u8_port = u8_port;
+    p_retry->b_confirmed = b_confirmed;
+    p_retry->u8_class = u8_class;
+    p_retry->u32_msg_id = u32_msg_id;
+    p_retry->u8_attempts = 1;
+    p_retry->policy = *p_policy;
+    if (UPLINK_RETRY_MAX_JITTER_PCT < p_retry->policy.u8_jitter_pct)
+    {
+        p_retry->policy.u8_jitter_pct = UPLINK_RETRY_MAX_JITTER_PCT;
+    }
+    p_retry->state = UPLINK_RETRY_WAIT_TXDONE;
+    return true;
+}
+
+bool uplink_retry_on_tx_done(uplink_retry_t *p_retry, uplink_retry_tx_t tx_status, uint32_t u32_now_ms)
+{
+    bool b_accepted = false;
+
+    if ((NULL == p_retry) || (UPLINK_RETRY_WAIT_TXDONE != p_retry->state))
+    {
+        return false;
+    }
+
+    b_accepted = (UPLINK_RETRY_TX_ACK == tx_status) ||
+                 ((UPLINK_RETRY_TX_NO_ACK == tx_status) && (false == p_retry->policy.b_retry_no_ack));
+
+    if ((false == b_accepted) && (p_retry->u8_attempts <= p_retry->policy.u8_max_retries))
+    {
+        p_retry->u32_due_ms = u32_now_ms + uplink_retry_backoff_ms(p_retry, &p_retry->policy, p_retry->u8_attempts);
+        p_retry->state = UPLINK_RETRY_BACKOFF;
+        return false;
+    }
+
+    p_retry->stats.u32_messages++;
+    if (b_accepted)
+    {
+        p_retry->stats.u32_delivered++;
+    }
+    p_retry->state = UPLINK_RETRY_IDLE;
+    return true;
+}
+
+bool uplink_retry_is_due(const uplink_retry_t *p_retry, uint32_t u32_now_ms)
+{
+    return (NULL != p_retry) && (UPLINK_RETRY_BACKOFF == p_retry->state) && ((int32_t)(u32_now_ms - p_retry->u32_due_ms) >= 0);
+}
+
+const uint8_t *uplink_retry_get_data(const uplink_retry_t *p_retry, uint16_t *p_len, uint8_t *p_port, bool *p_confirmed)
+{
+    if ((NULL == p_retry) || (NULL == p_len) || (NULL == p_port) || (NULL == p_confirmed))
+    {
+        return NULL;
+    }
+    *p_len = p_retry->u16_len;
+    *p_port = p_retry->u8_port;
+    *p_confirmed = p_retry->b_confirmed;
+    return p_retry->data;
+}
+
+void uplink_retry_sent(uplink_retry_t *p_retry)
+{
+    if ((NULL == p_retry) || (UPLINK_RETRY_BACKOFF != p_retry->state))
+    {
+        return;
+    }
+    p_retry->u8_attempts++;
+    p_retry->stats.u32_retries++;
+    p_retry->state = UPLINK_RETRY_WAIT_TXDONE;
+}
+
+uint32_t uplink_retry_backoff_ms(uplink_retry_t *p_retry, const uplink_retry_policy_t *p_policy, uint8_t u8_retry)
+{
+    uint32_t u32_backoff_ms = 0;
+    uint32_t u32_jitter_ms = 0;
+    uint8_t u8_jitter_pct = 0;
+
+    if ((NULL == p_retry) || (NULL == p_policy) || (0 == u8_retry))
+    {
+        return 0;
+    }
+
+    u32_backoff_ms = p_policy->u32_base_ms;
+    for (uint8_t i = 1; (i < u8_retry) && (u32_backoff_ms < p_policy->u32_max_ms); i++)
+    {
+        u32_backoff_ms = (u32_backoff_ms > (UINT32_MAX / 2)) ? UINT32_MAX : (u32_backoff_ms * 2);
+    }
+    if (u32_backoff_ms > p_policy->u32_max_ms)
+    {
+        u32_backoff_ms = p_policy->u32_max_ms;
+    }
+
+    // uniform in [backoff - jitter, backoff + jitter]
+    u8_jitter_pct = (UPLINK_RETRY_MAX_JITTER_PCT < p_policy->u8_jitter_pct) ? UPLINK_RETRY_MAX_JITTER_PCT : p_policy->u8_jitter_pct;
+    u32_jitter_ms = (u32_backoff_ms / 100) * u8_jitter_pct;
+    if (0 != u32_jitter_ms)
+    {
+        u32_backoff_ms = u32_backoff_ms - u32_jitter_ms + (uplink_retry_random(p_retry) % ((2 * u32_jitter_ms) + 1));
+    }
+    return u32_backoff_ms;
+}
+
+uplink_retry_state_t uplink_retry_get_state(const uplink_retry_t *p_retry)
+{
+    return p_retry->state;
+}
+
+uint32_t uplink_retry_get_msg_id(const uplink_retry_t *p_retry)
+{
+    return p_retry->u32_msg_id;
+}
+
+uint8_t uplink_retry_get_class(const uplink_retry_t *p_retry)
+{
+    return p_retry->u8_class;
+}
+
+uint8_t uplink_retry_get_attempts(const uplink_retry_t *p_retry)
+{
+    return p_retry->u8_attempts;
+}
+
+const uplink_retry_stats_t *uplink_retry_get_stats(const uplink_retry_t *p_retry)
+{
+    return &p_retry->stats;
+}
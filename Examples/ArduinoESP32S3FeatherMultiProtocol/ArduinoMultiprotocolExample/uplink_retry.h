@@ -0,0 +1,233 @@
+/**
+ * @file uplink_retry.h
+ * @author OXIT embedded firmware team
+ * @brief Retries of the uplink in flight with exponential backoff and jitter, until a final result.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+#ifndef __UPLINK_RETRY_H__
+#define __UPLINK_RETRY_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "commands_defs.h"
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+/**
+ * @brief Largest uplink payload kept for the retries, the largest lorawan uplink the command encoder can frame.
+ */
+#define UPLINK_RETRY_MAX_PAYLOAD_SIZE       (LORAWAN_TX_MAX_FRAME_PAYLOAD_SIZE)
+
+/**
+ * @brief Largest jitter, in percent of the backoff.
+ */
+#define UPLINK_RETRY_MAX_JITTER_PCT         (100)
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+/**
+ * @brief Tx status of an attempt, as reported by MODEM_EVENT_TXDONE
+ */
+typedef enum
+{
+    UPLINK_RETRY_TX_NOT_SENT,
+    UPLINK_RETRY_TX_NO_ACK,
+    UPLINK_RETRY_TX_ACK
+} uplink_retry_tx_t;
+
+/**
+ * @brief State of the uplink in flight
+ */
+typedef enum
+{
+    UPLINK_RETRY_IDLE,                                  // no uplink in flight
+    UPLINK_RETRY_WAIT_TXDONE,                           // an attempt is sent, its tx status is awaited
+    UPLINK_RETRY_BACKOFF                                // the next attempt waits for its time
+} uplink_retry_state_t;
+
+/**
+ * @brief Retry policy of a type of uplink.
+ *  The backoff before retry n is u32_base_ms * 2^(n-1), at most u32_max_ms, changed by
+ *  a random amount of up to u8_jitter_pct percent either way so devices do not retry together.
+ */
+typedef struct
+{
+    uint8_t u8_max_retries;                             // attempts after the first one, 0 disables the retries
+    bool b_retry_no_ack;                                // a tx without ack is retried, for confirmed uplinks
+    uint32_t u32_base_ms;
+    uint32_t u32_max_ms;
+    uint8_t u8_jitter_pct;                              // up to UPLINK_RETRY_MAX_JITTER_PCT
+} uplink_retry_policy_t;
+
+/**
+ * @brief Counters of the retry engine
+ */
+typedef struct
+{
+    uint32_t u32_messages;                              // uplinks with a final result
+    uint32_t u32_delivered;                             // final result accepted by the policy
+    uint32_t u32_retries;                               // attempts after the first ones
+} uplink_retry_stats_t;
+
+/**
+ * @brief Context of the retry engine, one uplink in flight at a time.
+ *
+ * The members are private, use the uplink_retry_* functions to access them.
+ */
+typedef struct
+{
+    uint8_t data[UPLINK_RETRY_MAX_PAYLOAD_SIZE];
+    uint16_t u16_len;
+    uint8_t u8_port;
+    bool b_confirmed;
+    uint8_t u8_class;                                   // priority class, for the budget of the retries
+    uint32_t u32_msg_id;                                // given by the caller, reported with the final result
+    uint8_t u8_attempts;                                // attempts sent so far
+    uplink_retry_policy_t policy;
+    uplink_retry_state_t state;
+    uint32_t u32_due_ms;                                // time of the next attempt in UPLINK_RETRY_BACKOFF
+    uint32_t u32_random;                                // jitter generator state
+    uplink_retry_stats_t stats;
+} uplink_retry_t;
+
+/**********************************************************************************************************
+ * EXPORTED VARIABLES
+ **********************************************************************************************************/
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTION PROTOTYPES
+ **********************************************************************************************************/
+/**
+ * @brief Initializes the retry engine, no uplink is in flight afterwards.
+ *
+ * @param[in,out] p_retry Pointer to the retry engine context
+ * @param[in] u32_seed Seed of the jitter, should differ between devices
+ */
+void uplink_retry_init(uplink_retry_t *p_retry, uint32_t u32_seed);
+
+/**
+ * @brief Takes an uplink whose first attempt has just been sent.
+ *
+ * @param[in,out] p_retry Pointer to the retry engine context
+ * @param[in] p_policy Retry policy of the uplink, copied
+ * @param[in] u32_msg_id Identifier reported with the final result
+ * @param[in] u8_class Priority class of the uplink
+ * @param[in] u8_port Lorawan port
+ * @param[in] b_confirmed Confirmed uplink
+ * @param[in] p_data Payload, copied for the retries
+ * @param[in] u16_len Length of the payload, 1 to UPLINK_RETRY_MAX_PAYLOAD_SIZE
+ *
+ * @retval true The uplink is in flight
+ * @retval false Invalid parameters or another uplink still in flight
+ */
+bool uplink_retry_start(uplink_retry_t *p_retry, const uplink_retry_policy_t *p_policy, uint32_t u32_msg_id, uint8_t u8_class,
+                        uint8_t u8_port, bool b_confirmed, const uint8_t *p_data, uint16_t u16_len);
+
+/**
+ * @brief Gives the tx status of the attempt in flight. Either the next attempt is scheduled
+ *  or the uplink gets its final result and the engine becomes idle.
+ *
+ * @param[in,out] p_retry Pointer to the retry engine context
+ * @param[in] tx_status Tx status of the attempt
+ * @param[in] u32_now_ms Current time
+ *
+ * @retval true Final result, the uplink is no longer in flight
+ * @retval false The uplink is retried, or no attempt was awaited
+ */
+bool uplink_retry_on_tx_done(uplink_retry_t *p_retry, uplink_retry_tx_t tx_status, uint32_t u32_now_ms);
+
+/**
+ * @brief Tells whether the next attempt can be sent, the backoff being over.
+ */
+bool uplink_retry_is_due(const uplink_retry_t *p_retry, uint32_t u32_now_ms);
+
+/**
+ * @brief Gives the uplink to send again, once uplink_retry_is_due().
+ *  Call uplink_retry_sent() once it is sent.
+ */
+const uint8_t *uplink_retry_get_data(const uplink_retry_t *p_retry, uint16_t *p_len, uint8_t *p_port, bool *p_confirmed);
+
+/**
+ * @brief Marks the next attempt as sent, its tx status is awaited.
+ */
+void uplink_retry_sent(uplink_retry_t *p_retry);
+
+/**
+ * @brief Backoff before a retry, jitter included.
+ *
+ * @param[in,out] p_retry Pointer to the retry engine context, for the jitter generator
+ * @param[in] p_policy Retry policy
+ * @param[in] u8_retry Number of the retry, from 1
+ *
+ * @return Backoff in milliseconds
+ */
+uint32_t uplink_retry_backoff_ms(uplink_retry_t *p_retry, const uplink_retry_policy_t *p_policy, uint8_t u8_retry);
+
+/**
+ * @brief Returns the state of the uplink in flight.
+ */
+uplink_retry_state_t uplink_retry_get_state(const uplink_retry_t *p_retry);
+
+/**
+ * @brief Returns the identifier, the priority class and the number of attempts of the uplink in flight,
+ *  or of the last one after its final result.
+ */
+uint32_t uplink_retry_get_msg_id(const uplink_retry_t *p_retry);
+uint8_t uplink_retry_get_class(const uplink_retry_t *p_retry);
+uint8_t uplink_retry_get_attempts(const uplink_retry_t *p_retry);
+
+/**
+ * @brief Returns the counters of the retry engine.
+ */
+const uplink_retry_stats_t *uplink_retry_get_stats(const uplink_retry_t *p_retry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __UPLINK_RETRY_H__
@@ -0,0 +1,372 @@
+/**
+ * @file uplink_sched.c
+ * @author OXIT embedded firmware team
+ * @brief Priority queue of uplinks, released within the airtime budget of the link.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "uplink_sched.h"
+#include <stddef.h>
+#include <string.h>
+
+/******************************************************************************
+ * EXTERN VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ ******************************************************************************/
+
+/******************************************************************************
+ * PRIVATE TYPEDEFS
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+/**< Part of the budget left to the classes above, in percent */
+static const uint8_t s_reserve_pct[UPLINK_SCHED_CLASS_COUNT] = {
+    0,
+    UPLINK_SCHED_TELEMETRY_RESERVE_PCT,
+    UPLINK_SCHED_BULK_RESERVE_PCT,
+};
+
+/******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ ******************************************************************************/
+static bool uplink_sched_is_limited(const uplink_sched_t *p_sched, uint8_t u8_link);
+static uint32_t uplink_sched_limit_ms(const uplink_sched_t *p_sched, uint8_t u8_link);
+static uint32_t uplink_sched_used_ms(uplink_sched_t *p_sched, uint8_t u8_link, uint32_t u32_now_ms);
+static uplink_sched_entry_t *uplink_sched_find_next(uplink_sched_t *p_sched);
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+static bool uplink_sched_is_limited(const uplink_sched_t *p_sched, uint8_t u8_link)
+{
+    return p_sched->links[u8_link].u16_duty_permille < UPLINK_SCHED_NO_DUTY_LIMIT;
+}
+
+/**
+ * @brief Airtime allowed over a window
+ */
+static uint32_t uplink_sched_limit_ms(const uplink_sched_t *p_sched, uint8_t u8_link)
+{
+    return (UPLINK_SCHED_DUTY_WINDOW_MS / UPLINK_SCHED_NO_DUTY_LIMIT) * p_sched->links[u8_link].u16_duty_permille;
+}
+
+/**
+ * @brief Moves the current bin up to now and gives the airtime of the bins
+ */
+static uint32_t uplink_sched_used_ms(uplink_sched_t *p_sched, uint8_t u8_link, uint32_t u32_now_ms)
+{
+    const uint32_t u32_bin_len_ms = UPLINK_SCHED_DUTY_WINDOW_MS / UPLINK_SCHED_DUTY_BINS;
+    uint16_t *p_bins = p_sched->au16_bin_ms[u8_link];
+    uint32_t u32_used_ms = 0;
+
+    // airtime of the current bin may be charged up to its end, so it only leaves the window one bin later
+    if ((u32_now_ms - p_sched->au32_bin_start_ms[u8_link]) >= (UPLINK_SCHED_DUTY_WINDOW_MS + u32_bin_len_ms))
+    {
+        memset(p_bins, 0, sizeof(p_sched->au16_bin_ms[u8_link]));
+        p_sched->au32_bin_start_ms[u8_link] = u32_now_ms;
+    }
+    while ((u32_now_ms - p_sched->au32_bin_start_ms[u8_link]) >= u32_bin_len_ms)
+    {
+        p_sched->au8_bin[u8_link] = (p_sched->au8_bin[u8_link] + 1) % (UPLINK_SCHED_DUTY_BINS + 1);
+        p_bins[p_sched->au8_bin[u8_link]] = 0;
+        p_sched->au32_bin_start_ms[u8_link] += u32_bin_len_ms;
+    }
+
+    for (uint8_t i = 0; i <= UPLINK_SCHED_DUTY_BINS; i++)
+    {
+        u32_used_ms += p_bins[i];
+    }
+    return u32_used_ms;
+}
+
+/**
+ * @brief Oldest uplink of the highest class, NULL if none
+ */
+static uplink_sched_entry_t *uplink_sched_find_next(uplink_sched_t *p_sched)
+{
+    uplink_sched_entry_t *p_next = NULL;
+
+    for (uint8_t i = 0; i < UPLINK_SCHED_QUEUE_SIZE; i++)
+    {
+        uplink_sched_entry_t *p_entry = &p_sched->entries[i];
+        if (false == p_entry->b_used)
+        {
+            continue;
+        }
+        if ((NULL == p_next) || (p_entry->u8_class < p_next->u8_class) ||
+            ((p_entry->u8_class == p_next->u8_class) && ((int32_t)(p_entry->u32_seq - p_next->u32_seq) < 0)))
+        {
+            p_next = p_entry;
+        }
+    }
+    return p_next;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+void uplink_sched_init(uplink_sched_t *p_sched, uint32_t u32_now_ms)
+{
+    memset(p_sched, 0, sizeof(uplink_sched_t));
+    for (uint8_t i = 0; i < UPLINK_SCHED_MAX_LINKS; i++)
+    {
+        p_sched->links[i].u16_duty_permille = UPLINK_SCHED_NO_DUTY_LIMIT;
+        p_sched->au32_bin_start_ms[i] = u32_now_ms;
+    }
+}
+
+bool uplink_sched_set_link(uplink_sched_t *p_sched, uint8_t u8_link, const uplink_sched_link_t *p_link, uint32_t u32_now_ms)
+{
+    if ((NULL == p_sched) || (NULL == p_link) || (UPLINK_SCHED_MAX_LINKS <= u8_link) ||
+        (UPLINK_SCHED_NO_DUTY_LIMIT < p_link->u16_duty_permille))
+    {
+        return false;
+    }
+
+    p_sched->links[u8_link] = *p_link;
+    memset(p_sched->au16_bin_ms[u8_link], 0, sizeof(p_sched->au16_bin_ms[u8_link]));
+    p_sched->au8_bin[u8_link] = 0;
+    p_sched->au32_bin_start_ms[u8_link] = u32_now_ms;
+    return true;
+}
+
+uint32_t uplink_sched_airtime_ms(const uplink_sched_link_t *p_link, uint16_t u16_len)
+{
+    if (0 == p_link->u32_bitrate_bps)
+    {
+        return 0;
+    }
+    return p_link->u16_fixed_ms + ((((uint32_t)u16_len + p_link->u16_overhead_bytes) * 8000UL) + p_link->u32_bitrate_bps - 1) / p_link->u32_bitrate_bps;
+}
+
+bool uplink_sched_add(uplink_sched_t *p_sched, uint8_t u8_class, uint8_t u8_port, bool b_confirmed,
+                      const uint8_t *p_data, uint16_t u16_len, uint32_t u32_now_ms, uint32_t *p_seq)
+{
+    uplink_sched_entry_t *p_free = NULL;
+    uplink_sched_entry_t *p_victim = NULL;
+
+    if ((NULL == p_sched) || (NULL == p_data) || (UPLINK_SCHED_CLASS_COUNT <= u8_class) ||
+        (0 == u16_len) || (UPLINK_SCHED_MAX_PAYLOAD_SIZE < u16_len))
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; (i < UPLINK_SCHED_QUEUE_SIZE) && (NULL == p_free); i++)
+    {
+        uplink_sched_entry_t *p_entry = &p_sched->entries[i];
+        if (false == p_entry->b_used)
+        {
+            p_free = p_entry;
+        }
+        // newest uplink of the lowest class, in case the queue is full
+        else if ((p_entry->u8_class > u8_class) &&
+                 ((NULL == p_victim) || (p_entry->u8_class > p_victim->u8_class) ||
+                  ((p_entry->u8_class == p_victim->u8_class) && ((int32_t)(p_entry->u32_seq - p_victim->u32_seq) > 0))))
+        {
+            p_victim = p_entry;
+        }
+    }
+
+    if (NULL == p_free)
+    {
+        if (NULL == p_victim)
+        {
+            p_sched->stats[u8_class].u32_dropped++;
+            return false;
+        }
+        p_sched->stats[p_victim->u8_class].u32_dropped++;
+        p_free = p_victim;
+    }
+
+    memcpy(p_free->data, p_data, u16_len);
+    p_free->u16_len = u16_len;
+    p_free->u8_port = u8_port;
+    p_free->b_confirmed = b_confirmed;
+    p_free->u8_class = u8_class;
+    p_free->b_used = true;
+    p_free->u32_seq = p_sched->u32_next_seq++;
+    p_free->u32_queued_ms = u32_now_ms;
+    if (NULL != p_seq)
+    {
+        *p_seq = p_free->u32_seq;
+    }
+    return true;
+}
+
+uplink_sched_status_t uplink_sched_peek(uplink_sched_t *p_sched, uint8_t u8_link, uint32_t u32_now_ms, const uplink_sched_entry_t **pp_entry)
+{
+    uplink_sched_entry_t *p_next = NULL;
+
+    if ((NULL == p_sched) || (NULL == pp_entry) || (UPLINK_SCHED_MAX_LINKS <= u8_link))
+    {
+        return UPLINK_SCHED_EMPTY;
+    }
+
+    p_next = uplink_sched_find_next(p_sched);
+    if (NULL == p_next)
+    {
+        return UPLINK_SCHED_EMPTY;
+    }
+    *pp_entry = p_next;
+
+    return uplink_sched_check(p_sched, u8_link, p_next->u8_class, p_next->u16_len, u32_now_ms);
+}
+
+uplink_sched_status_t uplink_sched_check(uplink_sched_t *p_sched, uint8_t u8_link, uint8_t u8_class, uint16_t u16_len, uint32_t u32_now_ms)
+{
+    uint32_t u32_limit_ms = 0;
+    uint32_t u32_used_ms = 0;
+    uint32_t u32_needed_ms = 0;
+
+    if ((NULL == p_sched) || (UPLINK_SCHED_MAX_LINKS <= u8_link) || (UPLINK_SCHED_CLASS_COUNT <= u8_class))
+    {
+        return UPLINK_SCHED_EMPTY;
+    }
+
+    if (false == uplink_sched_is_limited(p_sched, u8_link))
+    {
+        return UPLINK_SCHED_READY;
+    }
+
+    u32_limit_ms = uplink_sched_limit_ms(p_sched, u8_link);
+    u32_used_ms = uplink_sched_used_ms(p_sched, u8_link, u32_now_ms);
+    u32_needed_ms = uplink_sched_airtime_ms(&p_sched->links[u8_link], u16_len) +
+                    ((u32_limit_ms / 100) * s_reserve_pct[u8_class]);
+
+    // an uplink larger than the whole budget waits for an empty window
+    if (((u32_used_ms + u32_needed_ms) <= u32_limit_ms) || (0 == u32_used_ms))
+    {
+        return UPLINK_SCHED_READY;
+    }
+    return UPLINK_SCHED_WAIT_BUDGET;
+}
+
+void uplink_sched_commit(uplink_sched_t *p_sched, uint8_t u8_link, const uplink_sched_entry_t *p_entry, uint32_t u32_now_ms)
+{
+    uplink_sched_entry_t *p_sent = (uplink_sched_entry_t *)p_entry;
+    uplink_sched_stats_t *p_stats = NULL;
+    uint32_t u32_delay_ms = 0;
+
+    if ((NULL == p_sched) || (NULL == p_sent) || (UPLINK_SCHED_MAX_LINKS <= u8_link) || (false == p_sent->b_used))
+    {
+        return;
+    }
+
+    uplink_sched_charge(p_sched, u8_link, p_sent->u16_len, u32_now_ms);
+
+    u32_delay_ms = u32_now_ms - p_sent->u32_queued_ms;
+    p_stats = &p_sched->stats[p_sent->u8_class];
+    p_stats->u32_sent++;
+    p_stats->u32_total_delay_ms += u32_delay_ms;
+    if (u32_delay_ms > p_stats->u32_max_delay_ms)
+    {
+        p_stats->u32_max_delay_ms = u32_delay_ms;
+    }
+    p_sent->b_used = false;
+}
+
+void uplink_sched_charge(uplink_sched_t *p_sched, uint8_t u8_link, uint16_t u16_len, uint32_t u32_now_ms)
+{
+    uint32_t u32_airtime_ms = 0;
+
+    if ((NULL == p_sched) || (UPLINK_SCHED_MAX_LINKS <= u8_link))
+    {
+        return;
+    }
+
+    u32_airtime_ms = uplink_sched_airtime_ms(&p_sched->links[u8_link], u16_len);
+    p_sched->au32_airtime_ms[u8_link] += u32_airtime_ms;
+    if (uplink_sched_is_limited(p_sched, u8_link))
+    {
+        uint16_t *p_bin = NULL;
+        uplink_sched_used_ms(p_sched, u8_link, u32_now_ms);    // moves the current bin up to now
+        p_bin = &p_sched->au16_bin_ms[u8_link][p_sched->au8_bin[u8_link]];
+        *p_bin = ((uint32_t)(UINT16_MAX - *p_bin) < u32_airtime_ms) ? UINT16_MAX : (uint16_t)(*p_bin + u32_airtime_ms);
+    }
+}
+
+uint32_t uplink_sched_get_budget_ms(uplink_sched_t *p_sched, uint8_t u8_link, uint32_t u32_now_ms)
+{
+    uint32_t u32_used_ms = 0;
+    uint32_t u32_limit_ms = 0;
+
+    if (UPLINK_SCHED_MAX_LINKS <= u8_link)
+    {
+        return 0;
+    }
+    if (false == uplink_sched_is_limited(p_sched, u8_link))
+    {
+        return UPLINK_SCHED_DUTY_WINDOW_MS;
+    }
+    u32_used_ms = uplink_sched_used_ms(p_sched, u8_link, u32_now_ms);
+    u32_limit_ms = uplink_sched_limit_ms(p_sched, u8_link);
+    return (u32_used_ms < u32_limit_ms) ? (u32_limit_ms - u32_used_ms) : 0;
+}
+
+uint32_t uplink_sched_get_airtime_ms(const uplink_sched_t *p_sched, uint8_t u8_link)
+{
+    return (UPLINK_SCHED_MAX_LINKS > u8_link) ? p_sched->au32_airtime_ms[u8_link] : 0;
+}
+
+uint8_t uplink_sched_get_count(const uplink_sched_t *p_sched)
+{
+    uint8_t u8_count = 0;
+
+    for (uint8_t i = 0; i < UPLINK_SCHED_QUEUE_SIZE; i++)
+    {
+        u8_count += p_sched->entries[i].b_used ? 1 : 0;
+    }
+    return u8_count;
+}
+
+const uplink_sched_stats_t *uplink_sched_get_stats(const uplink_sched_t *p_sched, uint8_t u8_class)
+{
+    return (UPLINK_SCHED_CLASS_COUNT > u8_class) ? &p_sched->stats[u8_class] : NULL;
+}
@@ -0,0 +1,306 @@
+/**
+ * @file uplink_sched.h
+ * @author OXIT embedded firmware team
+ * @brief Priority queue of uplinks, released within the airtime budget of the link.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+#ifndef __UPLINK_SCHED_H__
+#define __UPLINK_SCHED_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "commands_defs.h"
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+/**
+ * @brief Number of uplinks that can wait in the scheduler, all classes together.
+ */
+#define UPLINK_SCHED_QUEUE_SIZE             (8)
+
+/**
+ * @brief Largest uplink payload, the largest lorawan uplink the command encoder can frame.
+ */
+#define UPLINK_SCHED_MAX_PAYLOAD_SIZE       (LORAWAN_TX_MAX_FRAME_PAYLOAD_SIZE)
+
+/**
+ * @brief Number of links with their own budget, one per connection mode.
+ */
+#define UPLINK_SCHED_MAX_LINKS              (5)
+
+/**
+ * @brief Window over which the duty cycle is measured, 1 hour as in ETSI EN 300 220.
+ * A link can burst up to its duty cycle times the window, as long as no window holds more.
+ */
+#define UPLINK_SCHED_DUTY_WINDOW_MS         (3600000UL)
+
+/**
+ * @brief Number of bins the airtime of the window is kept in, one per minute.
+ */
+#define UPLINK_SCHED_DUTY_BINS              (60)
+
+/**
+ * @brief Duty cycle of a link without regional limit, in per mille.
+ */
+#define UPLINK_SCHED_NO_DUTY_LIMIT          (1000)
+
+/**
+ * @brief Part of the budget, in percent, that telemetry and bulk uplinks leave for the classes above them.
+ */
+#define UPLINK_SCHED_TELEMETRY_RESERVE_PCT  (10)
+#define UPLINK_SCHED_BULK_RESERVE_PCT       (45)
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+/**
+ * @brief Priority class of an uplink, the lower value is sent first.
+ */
+typedef enum
+{
+    UPLINK_SCHED_ALARM,
+    UPLINK_SCHED_TELEMETRY,
+    UPLINK_SCHED_BULK,
+    UPLINK_SCHED_CLASS_COUNT
+} uplink_sched_class_t;
+
+/**
+ * @brief Result of uplink_sched_peek()
+ */
+typedef enum
+{
+    UPLINK_SCHED_EMPTY,                                 // no uplink waiting
+    UPLINK_SCHED_WAIT_BUDGET,                           // the next uplink exceeds the budget left
+    UPLINK_SCHED_READY                                  // the next uplink can be sent now
+} uplink_sched_status_t;
+
+/**
+ * @brief Airtime model and duty cycle of a link.
+ *  airtime = u16_fixed_ms + (payload + u16_overhead_bytes) * 8 / u32_bitrate_bps
+ */
+typedef struct
+{
+    uint32_t u32_bitrate_bps;                           // effective bitrate on air
+    uint16_t u16_overhead_bytes;                        // protocol bytes added to the payload
+    uint16_t u16_fixed_ms;                              // preamble and physical header
+    uint16_t u16_duty_permille;                         // UPLINK_SCHED_NO_DUTY_LIMIT when the region has none
+} uplink_sched_link_t;
+
+/**
+ * @brief Uplink waiting in the scheduler
+ */
+typedef struct
+{
+    uint8_t data[UPLINK_SCHED_MAX_PAYLOAD_SIZE];
+    uint16_t u16_len;
+    uint8_t u8_port;
+    bool b_confirmed;
+    uint8_t u8_class;                                   // uplink_sched_class_t
+    bool b_used;
+    uint32_t u32_seq;                                   // order of arrival
+    uint32_t u32_queued_ms;
+} uplink_sched_entry_t;
+
+/**
+ * @brief Counters of a priority class
+ */
+typedef struct
+{
+    uint32_t u32_sent;
+    uint32_t u32_dropped;                               // rejected or evicted by a higher class, queue full
+    uint32_t u32_total_delay_ms;                        // sum of the time spent in the queue by the sent uplinks
+    uint32_t u32_max_delay_ms;
+} uplink_sched_stats_t;
+
+/**
+ * @brief Context of the scheduler.
+ *
+ * The airtime of every link is counted in bins, the current one and the UPLINK_SCHED_DUTY_BINS
+ * before it, so they cover any window ending now. The budget of a link is the duty cycle
+ * times UPLINK_SCHED_DUTY_WINDOW_MS minus the airtime in the bins.
+ * The members are private, use the uplink_sched_* functions to access them.
+ */
+typedef struct
+{
+    uplink_sched_link_t links[UPLINK_SCHED_MAX_LINKS];
+    uint16_t au16_bin_ms[UPLINK_SCHED_MAX_LINKS][UPLINK_SCHED_DUTY_BINS + 1];
+    uint8_t au8_bin[UPLINK_SCHED_MAX_LINKS];            // current bin
+    uint32_t au32_bin_start_ms[UPLINK_SCHED_MAX_LINKS];
+    uint32_t au32_airtime_ms[UPLINK_SCHED_MAX_LINKS];   // airtime used since init
+    uplink_sched_entry_t entries[UPLINK_SCHED_QUEUE_SIZE];
+    uint32_t u32_next_seq;
+    uplink_sched_stats_t stats[UPLINK_SCHED_CLASS_COUNT];
+} uplink_sched_t;
+
+/**********************************************************************************************************
+ * EXPORTED VARIABLES
+ **********************************************************************************************************/
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTION PROTOTYPES
+ **********************************************************************************************************/
+/**
+ * @brief Initializes the scheduler, no uplink waiting and no link limited afterwards.
+ *
+ * @param[in,out] p_sched Pointer to the scheduler context
+ * @param[in] u32_now_ms Current time
+ */
+void uplink_sched_init(uplink_sched_t *p_sched, uint32_t u32_now_ms);
+
+/**
+ * @brief Sets the airtime model and duty cycle of a link, its airtime count starts from 0.
+ *
+ * @param[in,out] p_sched Pointer to the scheduler context
+ * @param[in] u8_link Index of the link, below UPLINK_SCHED_MAX_LINKS
+ * @param[in] p_link Airtime model and duty cycle, copied
+ * @param[in] u32_now_ms Current time
+ *
+ * @retval true The link is set
+ * @retval false Invalid parameters
+ */
+bool uplink_sched_set_link(uplink_sched_t *p_sched, uint8_t u8_link, const uplink_sched_link_t *p_link, uint32_t u32_now_ms);
+
+/**
+ * @brief Airtime of an uplink on a link, in milliseconds.
+ *
+ * @param[in] p_link Airtime model of the link
+ * @param[in] u16_len Length of the payload
+ *
+ * @return Estimated time on air, 0 for a link without bitrate
+ */
+uint32_t uplink_sched_airtime_ms(const uplink_sched_link_t *p_link, uint16_t u16_len);
+
+/**
+ * @brief Queues an uplink. When the queue is full the newest uplink of the lowest
+ *  class below u8_class is evicted to make room.
+ *
+ * @param[in,out] p_sched Pointer to the scheduler context
+ * @param[in] u8_class Priority class, see uplink_sched_class_t
+ * @param[in] u8_port Lorawan port
+ * @param[in] b_confirmed Confirmed uplink
+ * @param[in] p_data Payload, copied
+ * @param[in] u16_len Length of the payload, 1 to UPLINK_SCHED_MAX_PAYLOAD_SIZE
+ * @param[in] u32_now_ms Current time
+ * @param[out] p_seq Sequence number given to the uplink, kept in its entry, may be NULL
+ *
+ * @retval true The uplink is queued
+ * @retval false Invalid parameters or queue full of uplinks of the same or higher class
+ */
+bool uplink_sched_add(uplink_sched_t *p_sched, uint8_t u8_class, uint8_t u8_port, bool b_confirmed,
+                      const uint8_t *p_data, uint16_t u16_len, uint32_t u32_now_ms, uint32_t *p_seq);
+
+/**
+ * @brief Gives the next uplink to send on a link: the oldest of the highest class.
+ *  Lower classes do not overtake it while it waits for budget.
+ *
+ * @param[in,out] p_sched Pointer to the scheduler context
+ * @param[in] u8_link Index of the link
+ * @param[in] u32_now_ms Current time
+ * @param[out] pp_entry Next uplink, set unless UPLINK_SCHED_EMPTY is returned
+ *
+ * @return Whether the next uplink can be sent now, see uplink_sched_status_t
+ */
+uplink_sched_status_t uplink_sched_peek(uplink_sched_t *p_sched, uint8_t u8_link, uint32_t u32_now_ms, const uplink_sched_entry_t **pp_entry);
+
+/**
+ * @brief Removes an uplink given by uplink_sched_peek() once sent, its airtime is taken from the budget.
+ *
+ * @param[in,out] p_sched Pointer to the scheduler context
+ * @param[in] u8_link Index of the link the uplink has been sent on
+ * @param[in] p_entry Uplink sent
+ * @param[in] u32_now_ms Current time
+ */
+void uplink_sched_commit(uplink_sched_t *p_sched, uint8_t u8_link, const uplink_sched_entry_t *p_entry, uint32_t u32_now_ms);
+
+/**
+ * @brief Tells whether an uplink sent outside of the queue, a retry, fits in the budget of its class.
+ *
+ * @param[in,out] p_sched Pointer to the scheduler context
+ * @param[in] u8_link Index of the link
+ * @param[in] u8_class Priority class of the uplink
+ * @param[in] u16_len Length of the payload
+ * @param[in] u32_now_ms Current time
+ *
+ * @return UPLINK_SCHED_READY or UPLINK_SCHED_WAIT_BUDGET, UPLINK_SCHED_EMPTY for invalid parameters
+ */
+uplink_sched_status_t uplink_sched_check(uplink_sched_t *p_sched, uint8_t u8_link, uint8_t u8_class, uint16_t u16_len, uint32_t u32_now_ms);
+
+/**
+ * @brief Takes the airtime of an uplink sent outside of the queue from the budget of the link.
+ *
+ * @param[in,out] p_sched Pointer to the scheduler context
+ * @param[in] u8_link Index of the link the uplink has been sent on
+ * @param[in] u16_len Length of the payload
+ * @param[in] u32_now_ms Current time
+ */
+void uplink_sched_charge(uplink_sched_t *p_sched, uint8_t u8_link, uint16_t u16_len, uint32_t u32_now_ms);
+
+/**
+ * @brief Airtime left to a link, in milliseconds.
+ */
+uint32_t uplink_sched_get_budget_ms(uplink_sched_t *p_sched, uint8_t u8_link, uint32_t u32_now_ms);
+
+/**
+ * @brief Airtime used by a link since init, in milliseconds.
+ */
+uint32_t uplink_sched_get_airtime_ms(const uplink_sched_t *p_sched, uint8_t u8_link);
+
+/**
+ * @brief Number of uplinks waiting, all classes together.
+ */
+uint8_t uplink_sched_get_count(const uplink_sched_t *p_sched);
+
+/**
+ * @brief Counters of a priority class, NULL for an invalid class.
+ */
+const uplink_sched_stats_t *uplink_sched_get_stats(const uplink_sched_t *p_sched, uint8_t u8_class);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __UPLINK_SCHED_H__
@@ -46,6 +46,8 @@
 #include "ymodem.h"
 #include <SPIFFS.h>
 #include <Update.h>
+#include "checksum.h"
+#include "oxit_nvs.h"
 
 /******************************************************************************
  * EXTERN VARIABLES
@@ -62,8 +64,6 @@
 /******************************************************************************
  * STATIC VARIABLES
  ******************************************************************************/
-uint8_t ymodem_buffer[1030] = {0};
-uint16_t ymodem_buffer_size = 0;
 /******************************************************************************
  * GLOBAL VARIABLES
  ******************************************************************************/
@@ -87,7 +87,7 @@ bool YModem::update_esp32_firmware()
     }
 
     size_t fileSize = file.size();
-    Serial.printf("[YMODEM FW] File Size: %d bytes\n", fileSize);
+    Serial.printf("[YMODEM FW] File Size: %lu bytes\n", (unsigned long)fileSize);
 
     Serial.printf("[YMODEM FW] Starting OTA update...\n");
     if (!Update.begin(fileSize))
@@ -97,12 +97,12 @@ bool YModem::update_esp32_firmware()
         return false;
     }
 
-    Serial.printf("[YMODEM FW] Writing firmware (%d bytes)...\n", fileSize);
+    Serial.printf("[YMODEM FW] Writing firmware (%lu bytes)...\n", (unsigned long)fileSize);
     size_t written = Update.writeStream(file);
 
     if (written != fileSize)
     {
-        Serial.printf("[YMODEM FW] ERR: Write error (wrote %d of %d bytes).\n", written, fileSize);
+        Serial.printf("[YMODEM FW] ERR: Write error (wrote %lu of %lu bytes).\n", (unsigned long)written, (unsigned long)fileSize);
         file.close();
         return false;
     }
@@ -136,6 +136,192 @@ bool YModem::update_esp32_firmware()
     return true;
 }
 
+/**
+ * @brief Prepares the destination of the blocks, the OTA partition or the SPIFFS file.
+ *
+ * @param size Size of the image announced in the header
+ * @return true if the blocks can be written
+ */
+bool YModem::openSink(uint32_t size)
+{
+    if (this->_is_stream_to_ota)
+    {
+        // the partition is erased as it is written, no SPIFFS space is needed
+        if (!Update.begin(size))
+        {
+            Serial.printf("[YMODEM FW] ERR: Not enough space for OTA (error %d).\n", Update.getError());
+            return false;
+        }
+        this->_is_ota_open = true;
+        return true;
+    }
+
+    this->_file = SPIFFS.open(FUOTA_FILE_NAME, FILE_WRITE, true);
+    if (!this->_file)
+    {
+        Serial.printf("[YMODEM] ERR: Cannot open file for writing\n");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Reopens the partial image of an interrupted transfer of the same image.
+ *
+ * The OTA session survives only until a reboot, the SPIFFS file survives a reboot.
+ * A partial image that cannot be resumed is discarded with its checkpoint.
+ *
+ * @param size Size of the image announced in the header
+ * @return true if the transfer continues from the checkpoint, false if it starts from zero
+ */
+bool YModem::resumeSink(uint32_t size)
+{
+    nvs_fw_checkpoint_t checkpoint;
+    bool is_resumable = false;
+
+    if (nvs_storage_get_fw_checkpoint(&checkpoint) &&
+        (checkpoint.u32_tag == this->_tag) &&
+        (checkpoint.u32_image_size == size) &&
+        (checkpoint.u32_committed < size))
+    {
+        if (this->_is_stream_to_ota)
+        {
+            is_resumable = this->_is_ota_open && (Update.progress() == checkpoint.u32_committed);
+        }
+        else
+        {
+            this->_file = SPIFFS.open(FUOTA_FILE_NAME, "r+");
+            if (this->_file && (this->_file.size() >= checkpoint.u32_committed) && this->_file.seek(checkpoint.u32_committed))
+            {
+                is_resumable = true;
+            }
+            else if (this->_file)
+            {
+                this->_file.close();
+            }
+        }
+    }
+
+    if (this->_is_ota_open && !(is_resumable && this->_is_stream_to_ota))
+    {
+        Update.abort();
+        this->_is_ota_open = false;
+    }
+    if (!is_resumable)
+    {
+        nvs_storage_clear_fw_checkpoint();
+        return false;
+    }
+
+    this->_resume_offset = checkpoint.u32_committed;
+    this->_resume_crc = checkpoint.u16_crc;
+    Serial.printf("[YMODEM] Resuming at %lu of %lu bytes, the blocks before are verified but not written\n",
+                  (unsigned long)checkpoint.u32_committed, (unsigned long)size);
+    return true;
+}
+
+/**
+ * @brief Writes a CRC verified block to the destination.
+ */
+bool YModem::writeSink(const uint8_t *data, uint32_t size)
+{
+    if (0 == size)
+    {
+        return true;
+    }
+    if (this->_is_stream_to_ota)
+    {
+        return (Update.write((uint8_t *)data, size) == size);
+    }
+    return (this->_file.write(data, size) == size);
+}
+
+/**
+ * @brief Takes the image bytes of a data block in order.
+ *
+ * Bytes below the resume offset are already in the sink, they only extend the running crc which must
+ * match the checkpoint once the offset is reached. The bytes after it are written and checkpointed.
+ *
+ * @return false if the transfer was aborted
+ */
+bool YModem::commitBlock(const uint8_t *data, uint32_t size)
+{
+    uint32_t skip = 0;
+
+    if (this->_offset < this->_resume_offset)
+    {
+        skip = this->_resume_offset - this->_offset;
+        if (skip > size)
+        {
+            skip = size;
+        }
+        this->_crc = checksum_crc16_ccitt(this->_crc, data, skip);
+        this->_offset += skip;
+        if ((this->_offset == this->_resume_offset) && (this->_crc != this->_resume_crc))
+        {
+            abort("image differs from the checkpoint");
+            return false;
+        }
+    }
+
+    if (!writeSink(data + skip, size - skip))
+    {
+        abort("firmware write failed");
+        return false;
+    }
+    this->_crc = checksum_crc16_ccitt(this->_crc, data + skip, size - skip);
+    this->_offset += size - skip;
+
+    // below the checkpoint while the resent prefix is verified, the checkpoint already covers it
+    if ((this->_offset > this->_checkpoint_offset) && ((this->_offset - this->_checkpoint_offset) >= YMODEM_CHECKPOINT_INTERVAL))
+    {
+        saveCheckpoint();
+    }
+    return true;
+}
+
+/**
+ * @brief Records in NVS how much of the image is in the sink, the SPIFFS file is flushed first.
+ */
+void YModem::saveCheckpoint()
+{
+    nvs_fw_checkpoint_t checkpoint;
+
+    if (this->_file)
+    {
+        this->_file.flush();
+    }
+    checkpoint.u32_tag = this->_tag;
+    checkpoint.u32_image_size = this->_initial_file_size;
+    checkpoint.u32_committed = this->_offset;
+    checkpoint.u16_crc = this->_crc;
+    checkpoint.u16_reserved = 0;
+    if (nvs_storage_set_fw_checkpoint(&checkpoint))
+    {
+        this->_checkpoint_offset = this->_offset;
+    }
+}
+
+/**
+ * @brief Verifies the image streamed to the OTA partition and reboots into it.
+ */
+bool YModem::finishOtaUpdate()
+{
+    this->_is_ota_open = false;
+
+    Serial.printf("[YMODEM FW] Finalizing update...\n");
+    if (!Update.end())
+    {
+        Serial.printf("[YMODEM FW] ERR: Update error code %d.\n", Update.getError());
+        return false;
+    }
+
+    Serial.printf("[YMODEM FW] Update successful. Rebooting in 5s...\n");
+    delay(5000);
+    ESP.restart();
+    return true;
+}
+
 /******************************************************************************
  * GLOBAL FUNCTIONS
  ******************************************************************************/
@@ -164,6 +350,13 @@ void YModem::sendNAK()
     this->__ymodem_serial.write(&nak, 1);
 }
 
+void YModem::sendCAN()
+{
+    Serial.printf("[YMODEM TX] CAN sent\n");
+    uint8_t can[2] = {CAN, CAN};
+    this->__ymodem_serial.write(can, sizeof(can));
+}
+
 void YModem::sendCRCRequest()
 {
     this->_timeout = millis();
@@ -172,27 +365,58 @@ void YModem::sendCRCRequest()
     this->__ymodem_serial.write(&crc16, 1);
 }
 
-// Calculates the CRC for a given data buffer
-uint16_t YModem::calculateCRC(const uint8_t *data, uint16_t length)
+/**
+ * @brief Takes the bytes received from the mcm while a transfer is in progress.
+ *  A read can hold part of a packet or several packets, each packet is acknowledged as soon as it completes.
+ */
+void YModem::receivePacket(uint8_t *buffer, uint16_t &size)
 {
-    uint16_t crc = 0;
-    for (uint16_t i = 0; i < length; i++)
+    uint16_t offset = 0;
+
+    this->_rx_time = millis();
+    while ((offset < size) && (YMODEM_IDLE != this->_state))
     {
-        crc ^= data[i] << 8;
-        for (uint8_t j = 0; j < 8; j++)
+        ymodem_block_result_t result = YMODEM_BLOCK_NEED_MORE;
+        offset += ymodem_block_push(&this->_block, buffer + offset, size - offset, &result);
+        if (YMODEM_BLOCK_NEED_MORE != result)
         {
-            crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+            processBlock(result);
         }
     }
-    return crc;
 }
 
-void YModem::receivePacket(uint8_t *buffer, uint16_t &size)
+void YModem::processBlock(ymodem_block_result_t result)
 {
-    // static variables to keep track of the file transfer progress
-    static int32_t fileSize = 0;
-    static int32_t initialFileSize = 0;
-    static File file;
+    uint16_t block_len = 0;
+    uint8_t block_number = 0;
+    const uint8_t *data = NULL;
+
+    if (YMODEM_BLOCK_CAN == result)
+    {
+        suspend("cancelled by the sender");
+        return;
+    }
+    if (YMODEM_BLOCK_BAD == result)
+    {
+        Serial.printf("[YMODEM RX] ERR: CRC mismatch\n");
+        // a flash written block by block cannot wait for a line that keeps failing
+        if (++this->_crc_errors >= YMODEM_MAX_CRC_ERRORS)
+        {
+            suspend("too many CRC errors");
+            return;
+        }
+        sendNAK();
+        return;
+    }
+    if (YMODEM_BLOCK_SEQUENCE_ERROR == result)
+    {
+        abort("block out of sequence");
+        return;
+    }
+    if ((YMODEM_BLOCK_DATA == result) || (YMODEM_BLOCK_DUPLICATE == result))
+    {
+        data = ymodem_block_get_data(&this->_block, &block_len, &block_number);
+    }
 
     switch (this->_state)
     {
@@ -202,24 +426,29 @@ void YModem::receivePacket(uint8_t *buffer, uint16_t &size)
 
     case WAIT_FOR_HEADER:
     {
-        if (buffer[0] == SOH || buffer[0] == STX)
+        if (YMODEM_BLOCK_DATA == result)
         {
             this->_timeout = millis();
+            // header block: file name, NUL, size in decimal
             char fileName[128];
-            sscanf((char *)&buffer[2], "%127s", fileName);
-            sscanf((char *)&buffer[2 + strlen(fileName) + 1], "%lu", &fileSize);
-            initialFileSize = fileSize;
-
-            Serial.printf("[YMODEM RX] HDR: '%s' (%ld B)\n", fileName, fileSize);
-
-            file = SPIFFS.open(FUOTA_FILE_NAME, FILE_WRITE, true);
-            if (!file)
+            sscanf((const char *)data, "%127s", fileName);
+            unsigned long fileSize = 0;
+            sscanf((const char *)&data[strlen(fileName) + 1], "%lu", &fileSize);
+            this->_file_size = (int32_t)fileSize;
+            this->_initial_file_size = this->_file_size;
+
+            Serial.printf("[YMODEM RX] HDR: '%s' (%ld B)\n", fileName, (long)this->_file_size);
+
+            this->_offset = 0;
+            this->_resume_offset = 0;
+            this->_crc = CHECKSUM_CRC16_XMODEM_INIT;
+            if (!resumeSink(this->_file_size) && !openSink(this->_file_size))
             {
-                Serial.printf("[YMODEM] ERR: Cannot open file for writing\n");
+                abort("cannot open the firmware destination");
                 return;
             }
-            memset(ymodem_buffer, 0, sizeof(ymodem_buffer));
-            ymodem_buffer_size = 0;
+            this->_checkpoint_offset = this->_resume_offset;
+            this->_crc_errors = 0;
             setState(RECEIVE_DATA);
             sendACK();
             delay(10);
@@ -230,46 +459,52 @@ void YModem::receivePacket(uint8_t *buffer, uint16_t &size)
 
     case RECEIVE_DATA:
     {
-        if (buffer[0] == EOT)
+        if (YMODEM_BLOCK_EOT == result)
         {
             this->_timeout = millis();
             Serial.printf("[YMODEM RX] EOT received. Finalizing...\n");
             sendACK();
-            file.close();
             Serial.printf("[YMODEM] FW update initiated.\n");
-            update_esp32_firmware();
+            nvs_storage_clear_fw_checkpoint();
+            if (this->_is_stream_to_ota)
+            {
+                finishOtaUpdate();
+            }
+            else
+            {
+                this->_file.close();
+                update_esp32_firmware();
+            }
             setState(YMODEM_IDLE);
         }
-        else if (buffer[0] == SOH || buffer[0] == STX)
+        else if (YMODEM_BLOCK_DUPLICATE == result)
         {
-            this->_timeout = millis();
-            uint16_t received_crc = (buffer[size - 2] << 8) | buffer[size - 1];
-            uint16_t calculated_crc = calculateCRC(buffer + 3, 1024);
-
-            if (received_crc == calculated_crc)
+            // already written, the sender only missed the ack, or the 'C' after a repeated header
+            sendACK();
+            if (0 == block_number)
             {
-                uint32_t size_to_write = (fileSize > 1024) ? 1024 : fileSize;
-                if (file)
-                {
-                    file.write(buffer + 3, size_to_write);
-                }
-                fileSize -= size_to_write;
-                int progress = (int)(((initialFileSize - fileSize) * 100) / initialFileSize);
-                Serial.printf("File Transfer Progress:\t\t %d %% Completed \n",progress);
-                sendACK();
+                sendCRCRequest();
             }
-            else
+        }
+        else if (YMODEM_BLOCK_DATA == result)
+        {
+            this->_crc_errors = 0;
+            uint32_t size_to_write = (this->_file_size > block_len) ? block_len : this->_file_size;
+            if (!commitBlock(data, size_to_write))
             {
-                Serial.printf("[YMODEM RX] ERR: CRC mismatch (rec=0x%04X, calc=0x%04X)\n", received_crc, calculated_crc);
-                sendNAK();
+                return;
             }
+            this->_file_size -= size_to_write;
+            int progress = (int)(((this->_initial_file_size - this->_file_size) * 100) / this->_initial_file_size);
+            Serial.printf("File Transfer Progress:\t\t %d %% Completed \n",progress);
+            sendACK();
         }
     }
     break;
 
     case WAIT_EOT:
     {
-        if (buffer[0] == EOT)
+        if (YMODEM_BLOCK_EOT == result)
         {
             Serial.printf("[YMODEM RX] EOT confirmed.\n");
             sendACK();
@@ -282,16 +517,107 @@ void YModem::receivePacket(uint8_t *buffer, uint16_t &size)
         Serial.printf("[YMODEM] Transfer complete. Resetting.\n");
         setState(YMODEM_IDLE);
         break;
+
+    default:
+        break;
     }
 }
 
 void YModem::setState(ymodem_state_t state)
 {
-    const char* stateNames[] = {"Idle", "Header", "Data", "Wait EOT", "Complete"};
-    //Serial.printf("[YMODEM] State changed to: %s\n", stateNames[state]);
+    // a transfer starts from idle with the header block
+    if ((YMODEM_IDLE == this->_state) && (YMODEM_IDLE != state))
+    {
+        ymodem_block_init(&this->_block);
+        this->_crc_errors = 0;
+        this->_rx_time = millis();
+    }
     this->_state = state;
 }
 
+/**
+ * @brief Selects where the blocks are written, for the next transfers.
+ *
+ * @param enabled true to stream the blocks to the OTA partition as they arrive,
+ *                false to stage the image in SPIFFS and flash it after the transfer
+ */
+void YModem::setStreamToOta(bool enabled)
+{
+    this->_is_stream_to_ota = enabled;
+}
+
+/**
+ * @brief Cancels the transfer in progress, the partial image is discarded and the sender is told with CAN.
+ *
+ * @param reason Printed with the abort
+ */
+void YModem::abort(const char *reason)
+{
+    Serial.printf("[YMODEM] Transfer aborted: %s\n", reason);
+    nvs_storage_clear_fw_checkpoint();
+    if (this->_is_ota_open)
+    {
+        Update.abort();
+        this->_is_ota_open = false;
+    }
+    if (this->_file)
+    {
+        this->_file.close();
+        SPIFFS.remove(FUOTA_FILE_NAME);
+    }
+    if (YMODEM_IDLE != this->_state)
+    {
+        sendCAN();
+    }
+    setState(YMODEM_IDLE);
+}
+
+/**
+ * @brief Stops the transfer in progress but keeps the partial image and its checkpoint,
+ *  the next transfer of the same image continues from the checkpoint.
+ *
+ * @param reason Printed with the suspend
+ */
+void YModem::suspend(const char *reason)
+{
+    if (!this->_is_ota_open && !this->_file)
+    {
+        abort(reason);
+        return;
+    }
+    // the offset is below the checkpoint while the resent prefix is still being verified
+    if ((this->_offset > this->_checkpoint_offset) && (this->_offset >= this->_resume_offset))
+    {
+        saveCheckpoint();
+    }
+    if (0 == this->_checkpoint_offset)
+    {
+        abort(reason);
+        return;
+    }
+
+    Serial.printf("[YMODEM] Transfer suspended: %s, %lu bytes kept\n", reason, (unsigned long)this->_checkpoint_offset);
+    if (this->_file)
+    {
+        this->_file.close();
+    }
+    if (YMODEM_IDLE != this->_state)
+    {
+        sendCAN();
+    }
+    setState(YMODEM_IDLE);
+}
+
+/**
+ * @brief Identifies the image of the next transfer, a checkpoint is only resumed for the same image.
+ *
+ * @param tag Firmware version of the image packed into one word
+ */
+void YModem::setTransferTag(uint32_t tag)
+{
+    this->_tag = tag;
+}
+
 ymodem_state_t YModem::getState()
 {
     // Optionally, you can add a user-friendly log here if needed.
@@ -306,6 +632,12 @@ void YModem::process_timeout()
     if ((millis() - this->_timeout) > YMODEM_TIMEOUT)
     {
         Serial.printf("[YMODEM] Timeout (%lu ms elapsed) in state %d. Resetting.\n", millis() - this->_timeout, this->_state);
-        setState(YMODEM_IDLE);
+        suspend("timeout");
+    }
+    else if (ymodem_block_is_partial(&this->_block) && ((millis() - this->_rx_time) > YMODEM_BLOCK_TIMEOUT))
+    {
+        // the rest of the packet is lost, the sender repeats it on the NAK
+        ymodem_block_discard(&this->_block);
+        sendNAK();
     }
 }
\ No newline at end of file
@@ -46,6 +46,8 @@
  **********************************************************************************************************/
 #include <stdint.h>
 #include <Arduino.h>
+#include <FS.h>
+#include "ymodem_block.h"
 
 /**********************************************************************************************************
  * MACROS AND DEFINES
@@ -57,9 +59,19 @@
 #define ACK 0x06   // Acknowledge
 #define NAK 0x15   // Negative Acknowledge
 #define CRC16 0x43 // 'C' byte to request CRC16
+#define CAN 0x18   // Cancel transmission, sent twice
 
 #define YMODEM_TIMEOUT (30*1000)
 
+// Silence in the middle of a packet after which the partial packet is dropped and NAKed
+#define YMODEM_BLOCK_TIMEOUT (1000)
+
+// Consecutive CRC mismatches on a block before the transfer is aborted
+#define YMODEM_MAX_CRC_ERRORS (10)
+
+// Image bytes written between two progress checkpoints saved to NVS
+#define YMODEM_CHECKPOINT_INTERVAL (32*1024)
+
 /**********************************************************************************************************
  * TYPEDEFS
  **********************************************************************************************************/
@@ -90,16 +102,41 @@ public:
     void sendCRCRequest();
     bool update_esp32_firmware();
     void process_timeout();
+    void setStreamToOta(bool enabled);
+    void abort(const char *reason);
+    void suspend(const char *reason);
+    void setTransferTag(uint32_t tag);
     
 private:
     ymodem_state_t _state = YMODEM_IDLE;
     HardwareSerial& __ymodem_serial;
     uint64_t _timeout;
+    // blocks go straight to the OTA partition, otherwise they are staged in a SPIFFS file first
+    bool _is_stream_to_ota = true;
+    bool _is_ota_open = false;
+    File _file;
+    int32_t _file_size = 0;
+    int32_t _initial_file_size = 0;
+    uint8_t _crc_errors = 0;
+    ymodem_block_t _block;
+    uint32_t _rx_time = 0;                 // millis() of the last received bytes
+    // resume of an interrupted transfer, see nvs_fw_checkpoint_t
+    uint32_t _tag = 0;                     // identity of the image the mcm is about to send
+    uint32_t _offset = 0;                  // image bytes received so far, skipped or written
+    uint32_t _resume_offset = 0;           // bytes already in the sink when the transfer started
+    uint32_t _checkpoint_offset = 0;       // bytes covered by the last saved checkpoint
+    uint16_t _crc = 0;                     // running crc over the first _offset bytes
+    uint16_t _resume_crc = 0;              // running crc saved with the checkpoint
     void sendACK();
     void sendNAK();
-
-    // Calculates the CRC for a given data buffer
-    uint16_t calculateCRC(const uint8_t *data, uint16_t length);
+    void sendCAN();
+    void processBlock(ymodem_block_result_t result);
+    bool openSink(uint32_t size);
+    bool resumeSink(uint32_t size);
+    bool writeSink(const uint8_t *data, uint32_t size);
+    bool commitBlock(const uint8_t *data, uint32_t size);
+    void saveCheckpoint();
+    bool finishOtaUpdate();
 };
 
 /**********************************************************************************************************
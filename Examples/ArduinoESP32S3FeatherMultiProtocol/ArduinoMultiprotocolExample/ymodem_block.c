@@ -0,0 +1,227 @@
+/**
+ * @file ymodem_block.c
+ * @author OXIT embedded firmware team
+ * @brief Assembles ymodem packets from the received bytes, whatever the way they are split between the reads.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include "ymodem_block.h"
+#include "checksum.h"
+#include <stddef.h>
+#include <string.h>
+
+/******************************************************************************
+ * EXTERN VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * PRIVATE MACROS AND DEFINES
+ ******************************************************************************/
+/**
+ * @brief Start bytes, see ymodem.h
+ */
+#define YMODEM_BLOCK_BYTE_SOH               (0x01)
+#define YMODEM_BLOCK_BYTE_STX               (0x02)
+#define YMODEM_BLOCK_BYTE_EOT               (0x04)
+#define YMODEM_BLOCK_BYTE_CAN               (0x18)
+
+/******************************************************************************
+ * PRIVATE TYPEDEFS
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/******************************************************************************
+ * STATIC FUNCTION PROTOTYPES
+ ******************************************************************************/
+static ymodem_block_result_t ymodem_block_check(ymodem_block_t *p_block);
+
+/******************************************************************************
+ * STATIC FUNCTIONS
+ ******************************************************************************/
+/**
+ * @brief Checks the complete packet against its crc and the block sequence
+ */
+static ymodem_block_result_t ymodem_block_check(ymodem_block_t *p_block)
+{
+    const uint8_t *p_packet = p_block->au8_packet;
+    uint16_t u16_data_len = p_block->u16_packet_len - YMODEM_BLOCK_HEADER_LEN - YMODEM_BLOCK_CRC_LEN;
+    uint16_t u16_crc = ((uint16_t)p_packet[p_block->u16_packet_len - 2] << 8) | p_packet[p_block->u16_packet_len - 1];
+    uint8_t u8_number = p_packet[1];
+
+    if (((uint8_t)(u8_number ^ p_packet[2]) != 0xFF) ||
+        (checksum_crc16_ccitt(CHECKSUM_CRC16_XMODEM_INIT, &p_packet[YMODEM_BLOCK_HEADER_LEN], u16_data_len) != u16_crc))
+    {
+        p_block->stats.u32_bad++;
+        return YMODEM_BLOCK_BAD;
+    }
+
+    if (u8_number == p_block->u8_expected)
+    {
+        p_block->u8_expected++;
+        p_block->stats.u32_blocks++;
+        return YMODEM_BLOCK_DATA;
+    }
+
+    // the sender did not get the ack of the previous block
+    if ((0 != p_block->stats.u32_blocks) && (u8_number == (uint8_t)(p_block->u8_expected - 1)))
+    {
+        p_block->stats.u32_duplicates++;
+        return YMODEM_BLOCK_DUPLICATE;
+    }
+    return YMODEM_BLOCK_SEQUENCE_ERROR;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************/
+void ymodem_block_init(ymodem_block_t *p_block)
+{
+    if (NULL == p_block)
+    {
+        return;
+    }
+    memset(p_block, 0, sizeof(ymodem_block_t));
+}
+
+uint16_t ymodem_block_push(ymodem_block_t *p_block, const uint8_t *p_data, uint16_t u16_len, ymodem_block_result_t *p_result)
+{
+    uint16_t u16_used = 0;
+
+    *p_result = YMODEM_BLOCK_NEED_MORE;
+    while (u16_used < u16_len)
+    {
+        // between the packets, look for a start byte
+        if (0 == p_block->u16_packet_len)
+        {
+            uint8_t u8_byte = p_data[u16_used++];
+
+            if (YMODEM_BLOCK_BYTE_CAN == u8_byte)
+            {
+                // two CAN in a row cancel, a single one is line noise
+                if (p_block->b_can)
+                {
+                    p_block->b_can = false;
+                    *p_result = YMODEM_BLOCK_CAN;
+                    return u16_used;
+                }
+                p_block->b_can = true;
+                continue;
+            }
+            p_block->b_can = false;
+
+            if (YMODEM_BLOCK_BYTE_EOT == u8_byte)
+            {
+                *p_result = YMODEM_BLOCK_EOT;
+                return u16_used;
+            }
+            else if (YMODEM_BLOCK_BYTE_SOH == u8_byte)
+            {
+                p_block->u16_packet_len = YMODEM_BLOCK_HEADER_LEN + YMODEM_BLOCK_SOH_SIZE + YMODEM_BLOCK_CRC_LEN;
+            }
+            else if (YMODEM_BLOCK_BYTE_STX == u8_byte)
+            {
+                p_block->u16_packet_len = YMODEM_BLOCK_MAX_PACKET_SIZE;
+            }
+            else
+            {
+                p_block->stats.u32_noise++;
+                continue;
+            }
+            p_block->au8_packet[0] = u8_byte;
+            p_block->u16_fill = 1;
+            continue;
+        }
+
+        // copy as much of the packet as the read holds
+        uint16_t u16_copy = p_block->u16_packet_len - p_block->u16_fill;
+        if (u16_copy > (u16_len - u16_used))
+        {
+            u16_copy = u16_len - u16_used;
+        }
+        memcpy(&p_block->au8_packet[p_block->u16_fill], &p_data[u16_used], u16_copy);
+        p_block->u16_fill += u16_copy;
+        u16_used += u16_copy;
+
+        if (p_block->u16_fill == p_block->u16_packet_len)
+        {
+            *p_result = ymodem_block_check(p_block);
+            // the data stays readable until the next push
+            p_block->u16_fill = 0;
+            p_block->u16_packet_len = 0;
+            return u16_used;
+        }
+    }
+    return u16_used;
+}
+
+const uint8_t *ymodem_block_get_data(const ymodem_block_t *p_block, uint16_t *p_len, uint8_t *p_number)
+{
+    *p_len = (YMODEM_BLOCK_BYTE_STX == p_block->au8_packet[0]) ? YMODEM_BLOCK_STX_SIZE : YMODEM_BLOCK_SOH_SIZE;
+    if (NULL != p_number)
+    {
+        *p_number = p_block->au8_packet[1];
+    }
+    return &p_block->au8_packet[YMODEM_BLOCK_HEADER_LEN];
+}
+
+void ymodem_block_discard(ymodem_block_t *p_block)
+{
+    p_block->u16_fill = 0;
+    p_block->u16_packet_len = 0;
+    p_block->b_can = false;
+}
+
+bool ymodem_block_is_partial(const ymodem_block_t *p_block)
+{
+    return (0 != p_block->u16_packet_len);
+}
+
+const ymodem_block_stats_t *ymodem_block_get_stats(const ymodem_block_t *p_block)
+{
+    return &p_block->stats;
+}
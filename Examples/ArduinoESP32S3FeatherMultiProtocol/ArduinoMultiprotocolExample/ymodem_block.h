@@ -0,0 +1,170 @@
+/**
+ * @file ymodem_block.h
+ * @author OXIT embedded firmware team
+ * @brief Assembles ymodem packets from the received bytes, whatever the way they are split between the reads.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *
+ * Copyright (c) 2026 Oxit.
+ * All rights reserved.
+ * 
+ * THE OPEN SOURCE SOFTWARE LICENSE AGREEMENT ("AGREEMENT") IS A BINDING LEGAL CONTRACT BETWEEN YOU ("YOU") AND OXIT, A COMPANY INCORPORATED UNDER THE LAWS OF THE UNITED STATES OF AMERICA ACTING FOR THE PURPOSE OF THIS AGREEMENT THROUGH ITS REGISTERED OFFICE AT OXIT, LLC, 3131 WESTINGHOUSE BLVD, CHARLOTTE, NC 28273.
+ * 
+ * THIS SOFTWARE LICENSE AGREEMENT ("AGREEMENT") GOVERNS YOUR USE OF THE MCM PLAYGROUND SOFTWARE. INSTALLING, COPYING OR OTHERWISE USING THE SOFTWARE INDICATES YOUR ACCEPTANCE OF THE TERMS OF THIS AGREEMENT REGARDLESS OF WHETHER YOU CLICK THE "ACCEPT" BUTTON.
+ * 
+ * The Licensee is permitted to use this Software, provided the following conditions are met:
+ * 1. Oxit hereby grants to Licensee a perpetual, no-charge, royalty free, copyright license to use, copy, modify  the software,  to prepare a Derivative Works based on the software and Utilize the software for personal, commercial, or industrial purposes.
+ * 
+ * 2.  Neither the name of Oxit or the name of its contributors to be used in order to promote the product developed out of this software without prior written permission.
+ * 
+ * 3. If the Licensee makes any bug fixes, workarounds, improvements, or corrections to the Software, the Licensee agrees to  provide Oxit with the necessary source code and documentation at no cost, allowing Oxit to incorporate these changes into the Oxit Software.
+ * 
+ * 4. Oxit has no obligation to provide any maintenance, support or updates for the software package
+ * 
+ * 5. If the software contains any Third Party Software, all use of such Third Party Software shall be subject to the terms of  the license from such third party. You agree to comply with all terms and conditions for use of Third Party Software.
+ * 
+ * 6.  Oxit does not make any endorsements or representations concerning Third Party Software and disclaims all implied warranties concerning Third Party Software. Third Party Software is offered "AS IS."
+ * 
+ * 7. Oxit does not claim for meeting any specific functional requirement of the Licensee. Oxit does not take any responsibility for the uninterrupted or the error free operation of Software.
+ * 
+ * 8. Oxit makes no guarantee that the Software is free from bugs, viruses, or other defects.
+ * 
+ * 9. The Software is provided to kick start development on the Oxit MCM DevKit. By using this Software, the Licensee agrees to take full responsibility for any damages that may occur to their product.
+ * 
+ * 10. This software with or without modifications to be used only with Oxtech MCM DevKit
+ * 
+ * WARRANTY DISCLAIMER
+ * 
+ * THIS SOFTWARE IS PROVIDED BY OXIT "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL OXIT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES SUCH AS (BUT NOT LIMITED TO) LOSS OF BUSINESS REVENUES, PROFITS OR SAVINGS OR LOSS OF DATA RESULTING  FROM THE USE OR INABILITY TO USE THE SOFTWARE. THE OXIT DOES NOT WARRANT FOR ANY NON-INFRINGEMENT REGARDING THIRD-PARTY INTELLECTUAL  PROPERTY RIGHTS. OXIT DISCLAIMS ALL LIABILITY FOR DAMAGES CAUSED BY THIRD PARTIES, INCLUDING MACILICOUS USE OF, OR INTEFERENCE WITH TRANSMISSION OF LICENSEE'S DATA.
+ */
+
+
+#ifndef __YMODEM_BLOCK_H__
+#define __YMODEM_BLOCK_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************
+ * INCLUDES
+ **********************************************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/**********************************************************************************************************
+ * MACROS AND DEFINES
+ **********************************************************************************************************/
+/**
+ * @brief Data size of the SOH and STX packets
+ */
+#define YMODEM_BLOCK_SOH_SIZE               (128)
+#define YMODEM_BLOCK_STX_SIZE               (1024)
+
+/**
+ * @brief Start byte, block number and its complement before the data, crc16 after it
+ */
+#define YMODEM_BLOCK_HEADER_LEN             (3)
+#define YMODEM_BLOCK_CRC_LEN                (2)
+#define YMODEM_BLOCK_MAX_PACKET_SIZE        (YMODEM_BLOCK_HEADER_LEN + YMODEM_BLOCK_STX_SIZE + YMODEM_BLOCK_CRC_LEN)
+
+/**********************************************************************************************************
+ * TYPEDEFS
+ **********************************************************************************************************/
+/**
+ * @brief What the received bytes completed
+ */
+typedef enum
+{
+    YMODEM_BLOCK_NEED_MORE,                             // no complete packet yet
+    YMODEM_BLOCK_DATA,                                  // the expected block, see ymodem_block_get_data()
+    YMODEM_BLOCK_DUPLICATE,                             // the previous block again, its ack was lost
+    YMODEM_BLOCK_BAD,                                   // crc or block number complement mismatch, to NAK
+    YMODEM_BLOCK_SEQUENCE_ERROR,                        // a block neither expected nor repeated, the transfer is lost
+    YMODEM_BLOCK_EOT,                                   // end of the file
+    YMODEM_BLOCK_CAN                                    // the sender cancelled the transfer
+} ymodem_block_result_t;
+
+/**
+ * @brief Counters of the assembler
+ */
+typedef struct
+{
+    uint32_t u32_blocks;                                // blocks accepted
+    uint32_t u32_duplicates;
+    uint32_t u32_bad;
+    uint32_t u32_noise;                                 // bytes skipped between the packets
+} ymodem_block_stats_t;
+
+/**
+ * @brief Context of the assembler.
+ *
+ * The members are private, use the ymodem_block_* functions to access them.
+ */
+typedef struct
+{
+    uint8_t au8_packet[YMODEM_BLOCK_MAX_PACKET_SIZE];
+    uint16_t u16_fill;                                  // bytes of the packet received so far
+    uint16_t u16_packet_len;                            // length of the packet being received, 0 before its start byte
+    uint8_t u8_expected;                                // block number expected next, the header is block 0
+    bool b_can;                                         // a first CAN has been received
+    ymodem_block_stats_t stats;
+} ymodem_block_t;
+
+/**********************************************************************************************************
+ * EXPORTED VARIABLES
+ **********************************************************************************************************/
+
+/**********************************************************************************************************
+ * GLOBAL FUNCTION PROTOTYPES
+ **********************************************************************************************************/
+/**
+ * @brief Initializes the assembler for a new transfer, the header block is expected first.
+ */
+void ymodem_block_init(ymodem_block_t *p_block);
+
+/**
+ * @brief Takes received bytes until a packet completes.
+ *  Call it again with the bytes left over, a read can hold the end of a packet and the start of the next one.
+ *
+ * @param[in,out] p_block Pointer to the assembler context
+ * @param[in] p_data Received bytes
+ * @param[in] u16_len Number of received bytes
+ * @param[out] p_result What the bytes completed, YMODEM_BLOCK_NEED_MORE when all of them are taken without a packet
+ *
+ * @return Number of bytes taken
+ */
+uint16_t ymodem_block_push(ymodem_block_t *p_block, const uint8_t *p_data, uint16_t u16_len, ymodem_block_result_t *p_result);
+
+/**
+ * @brief Gives the data of the last complete packet, YMODEM_BLOCK_DATA or YMODEM_BLOCK_DUPLICATE.
+ *
+ * @param[in] p_block Pointer to the assembler context
+ * @param[out] p_len Data size, YMODEM_BLOCK_SOH_SIZE or YMODEM_BLOCK_STX_SIZE
+ * @param[out] p_number Block number, can be NULL
+ *
+ * @return The data, valid until the next ymodem_block_push()
+ */
+const uint8_t *ymodem_block_get_data(const ymodem_block_t *p_block, uint16_t *p_len, uint8_t *p_number);
+
+/**
+ * @brief Drops a partially received packet, when the line stays silent in the middle of it.
+ */
+void ymodem_block_discard(ymodem_block_t *p_block);
+
+/**
+ * @brief Tells whether a packet is partially received.
+ */
+bool ymodem_block_is_partial(const ymodem_block_t *p_block);
+
+/**
+ * @brief Returns the counters of the assembler.
+ */
+const ymodem_block_stats_t *ymodem_block_get_stats(const ymodem_block_t *p_block);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __YMODEM_BLOCK_H__